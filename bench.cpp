@@ -0,0 +1,570 @@
+#include "include/gui/AnimatedImage.h"
+#include "include/gui/MeshImage.h"
+#include "include/gui/SlideDeck.h"
+#include "include/gui/Canvas.h"
+#include "include/animation/DimmingAnimation.h"
+#include "include/animation/AlfaAnimation.h"
+#include "include/animation/ByBrightnessAnimation.h"
+#include "include/animation/SlideAnimation.h"
+#include "include/animation/ScaleAnimation.h"
+#include "include/animation/RingAnimation.h"
+#include "include/animation/FlyAnimation.h"
+#include "include/animation/AnimationRegistry.h"
+#include "include/util/ThreadPool.h"
+#include "include/util/BenchmarkReport.h"
+#include "include/util/Resources.h"
+#include "include/export/ImageEncoder.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <filesystem>
+
+/**
+ * Benchmarks of the animation kernels and the matrix math behind object animations
+ *
+ * Every case is repeated until it ran for the given time, so the results are
+ *   averages over many frames. Build with optimizations (CMAKE_BUILD_TYPE=Release)
+ *   before comparing results, debug builds say little about the real speed.
+ *   Results are also written as JSON or CSV and compared with a baseline (a CSV
+ *   report of an earlier run), exiting with 1 if any case got slower.
+ */
+namespace
+{
+    struct Options
+    {
+        double seconds = 0.25;//minimal time every case runs for
+        int threads = -1;//taken from BCG_THREADS when not given
+        std::string report;//file the results are written to, .json or .csv
+        std::string baseline;//CSV report the results are compared with
+        float threshold = BenchmarkReport::DEFAULT_THRESHOLD;//share a case may get slower by
+    };
+
+    struct Resolution
+    {
+        const char *name;
+        sf::Vector2u size;
+    };
+
+    const Resolution RESOLUTIONS[] = {
+        { "360p", sf::Vector2u(640u, 360u) },
+        { "720p", sf::Vector2u(1280u, 720u) },
+        { "1080p", sf::Vector2u(1920u, 1080u) },
+        { "2160p", sf::Vector2u(3840u, 2160u) } };
+
+    const unsigned TIME_STEPS = 64u;//times of the animation the frames are sampled at
+    const unsigned EXPORT_FRAMES = 30u;//frames of every transition of the exported deck
+
+    volatile float g_sink = 0.f;//results are written here so the compiler cannot drop the work
+
+    BenchmarkReport g_report;//every measured case, written by --report and compared by --baseline
+    std::string g_group;//group of the cases measured now
+
+    void printUsage(const char *name)
+    {
+        std::cerr
+            << "Usage: " << name << " [options]\n"
+            << "Options:\n"
+            << "  --time <seconds>   minimal time every case runs for (default 0.25)\n"
+            << "  --threads <count>  threads computing pixel animations, 0 for all cores (default BCG_THREADS or 0)\n"
+            << "  --report <file>    writes the results to a .json or .csv file\n"
+            << "  --baseline <file>  compares the results with a .csv report, exits with 1 if any case got slower\n"
+            << "  --threshold <%>    percent a case may get slower by before it fails the comparison (default 10)" << std::endl;
+    }
+
+    bool parseOptions(int argc, char **argv, Options &options)
+    {
+        for(int i = 1; i < argc; i++)
+        {
+            const std::string arg = argv[i];
+            if(i + 1 >= argc)
+            {
+                return false;
+            }
+            if(arg == "--time")
+            {
+                options.seconds = std::stod(argv[++i]);
+                if(!(options.seconds > 0.0))
+                {
+                    throw std::runtime_error("bench: time has to be positive");
+                }
+            }
+            else if(arg == "--threads")
+            {
+                options.threads = std::max(std::stoi(argv[++i]), 0);
+            }
+            else if(arg == "--report")
+            {
+                options.report = argv[++i];
+            }
+            else if(arg == "--baseline")
+            {
+                options.baseline = argv[++i];
+            }
+            else if(arg == "--threshold")
+            {
+                options.threshold = std::stof(argv[++i]) / 100.f;
+                if(!(options.threshold >= 0.f))
+                {
+                    throw std::runtime_error("bench: threshold must not be negative");
+                }
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Runs the body with increasing iteration counts until it takes the given time
+     *
+     * Returns average nanoseconds of one iteration, the index of the iteration is
+     *   given to the body so that it can vary its input.
+     */
+    double measure(const double seconds, const std::function<void(unsigned)> &body)
+    {
+        body(0u);//warm up caches and lazy allocations
+        unsigned iterations = 1u;
+        while(true)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            for(unsigned i = 0; i < iterations; i++)
+            {
+                body(i);
+            }
+            const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if(elapsed >= seconds || iterations >= (1u << 30))
+            {
+                return elapsed * 1e9 / iterations;
+            }
+            iterations = elapsed > 0.0
+                ? std::max(iterations * 2u, static_cast<unsigned>(iterations * seconds / elapsed * 1.1))
+                : iterations * 16u;
+        }
+    }
+
+    std::vector<unsigned char> makePixels(const sf::Vector2u &size, const unsigned seed)
+    {
+        std::vector<unsigned char> pixels(static_cast<std::size_t>(size.x) * size.y * 4u);
+        std::uint32_t state = 2463534242u + seed;
+        for(std::size_t i = 0; i < pixels.size(); i++)
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            pixels[i] = static_cast<unsigned char>(state);
+        }
+        return pixels;
+    }
+
+    void record(const std::string &name, const std::string &size, const double ns, const double pixels = 0.0)
+    {
+        g_report.add(BenchmarkReport::Result{g_group, name, size, ns, pixels});
+    }
+
+    void printRow(const std::string &name, const std::string &resolution, const double ns, const double pixels)
+    {
+        record(name, resolution, ns, pixels);
+        std::printf("%-22s %-7s %14.1f %12.3f %12.1f\n", name.c_str(), resolution.c_str(), ns, ns / pixels, 1e9 / ns);
+    }
+
+    template <typename Anim>
+    void benchPixel(const std::string &name, const Options &options)
+    {
+        for(const Resolution &resolution : RESOLUTIONS)
+        {
+            Anim animation(1.f, 1.f, makePixels(resolution.size, 1u), makePixels(resolution.size, 2u));
+            std::vector<unsigned char> frame1, frame2;
+
+            //one frame of the animation computes the pixels of both images
+            const double ns = measure(options.seconds, [&](const unsigned i)
+            {
+                const float time = static_cast<float>(i % TIME_STEPS) / TIME_STEPS;
+                animation.writeTexture1Frame(time, frame1);
+                animation.writeTexture2Frame(time, frame2);
+                g_sink = g_sink + frame1[i % frame1.size()] + frame2[i % frame2.size()];
+            });
+            printRow(name, resolution.name, ns, static_cast<double>(resolution.size.x) * resolution.size.y);
+        }
+    }
+
+    template <typename Anim>
+    void benchPlan(const std::string &name, const Options &options)
+    {
+        for(const Resolution &resolution : RESOLUTIONS)
+        {
+            Anim animation(1.f, 1.f, makePixels(resolution.size, 1u), makePixels(resolution.size, 2u));
+            std::vector<unsigned char> mask1, mask2;
+            const double pixels = static_cast<double>(resolution.size.x) * resolution.size.y;
+
+            //the plan runs once per change of the pixels, the masks once per frame executing it
+            const double plan = measure(options.seconds, [&](const unsigned)
+            {
+                animation.plan();
+            });
+            printRow(name + " plan", resolution.name, plan, pixels);
+            const double execute = measure(options.seconds, [&](const unsigned i)
+            {
+                const float time = static_cast<float>(i % TIME_STEPS) / TIME_STEPS;
+                animation.writeAlpha1Mask(time, mask1);
+                animation.writeAlpha2Mask(time, mask2);
+                g_sink = g_sink + mask1[i % mask1.size()] + mask2[i % mask2.size()];
+            });
+            printRow(name + " masks", resolution.name, execute, pixels);
+        }
+    }
+
+    template <typename Anim>
+    void benchObject(const std::string &name, const Options &options)
+    {
+        for(const Resolution &resolution : RESOLUTIONS)
+        {
+            Anim animation;
+            animation.setAnimationLength(1.f);
+            const sf::Vector2f size(resolution.size);
+            AnimatedImage image1(sf::Vector3f(), std::make_unique<sf::Texture>(), size);
+            AnimatedImage image2(sf::Vector3f(), std::make_unique<sf::Texture>(), size);
+
+            //one frame of the animation transforms both images
+            const double ns = measure(options.seconds, [&](const unsigned i)
+            {
+                const float time = static_cast<float>(i % TIME_STEPS) / TIME_STEPS;
+                image1.transformUpdate(animation.getImage1Frame(time));
+                image2.transformUpdate(animation.getImage2Frame(time));
+                g_sink = g_sink + image1.getVertexDepth(i & 3u) + image2.getVertexDepth(i & 3u);
+            });
+            printRow(name, resolution.name, ns, static_cast<double>(resolution.size.x) * resolution.size.y);
+        }
+    }
+
+    std::vector<em::Matrix4f> makeMatrices()
+    {
+        std::vector<em::Matrix4f> matrices;
+        for(unsigned i = 0; i < TIME_STEPS; i++)
+        {
+            em::Matrix4f matrix;
+            matrix.translate(sf::Vector3f(i * 3.f, i * 2.f, i * 0.01f));
+            matrix.rotateZ(i * 5.f);
+            matrix.scale(sf::Vector3f(1.f + i * 0.01f, 1.f - i * 0.005f, 1.f));
+            matrices.push_back(matrix);
+        }
+        return matrices;
+    }
+
+    void benchMatrix(const Options &options)
+    {
+        const std::vector<em::Matrix4f> matrices = makeMatrices();
+        auto print = [](const char *name, const double ns)
+        {
+            record(name, "", ns);
+            std::printf("%-22s %14.2f\n", name, ns);
+        };
+
+        print("multiply", measure(options.seconds, [&](const unsigned i)
+        {
+            const em::Matrix4f result = matrices[i % TIME_STEPS] * matrices[(i + 1u) % TIME_STEPS];
+            g_sink = g_sink + result[i & 3u][0];
+        }));
+        print("inverse", measure(options.seconds, [&](const unsigned i)
+        {
+            const em::Matrix4f result = -matrices[i % TIME_STEPS];
+            g_sink = g_sink + result[i & 3u][0];
+        }));
+        print("vector transform", measure(options.seconds, [&](const unsigned i)
+        {
+            const sf::Vector3f result = matrices[i % TIME_STEPS] * sf::Vector3f(i * 1.f, i * 2.f, 0.f);
+            g_sink = g_sink + result.x;
+        }));
+    }
+
+    /**
+     * Straightforward transformation of the four corners of an image, as it was
+     *   first written: positions are pivoted around the top-left corner and the
+     *   composite matrix is rebuilt for every corner
+     */
+    void baselineTransform(const sf::Vector2f &position, const sf::Vector2f &size, const em::Matrix4f &transform, std::array<sf::Vector3f, 4> &corners)
+    {
+        const sf::Vector3f initial[4] = {
+            sf::Vector3f(position.x, position.y, 0.f),
+            sf::Vector3f(position.x + size.x, position.y, 0.f),
+            sf::Vector3f(position.x + size.x, position.y + size.y, 0.f),
+            sf::Vector3f(position.x, position.y + size.y, 0.f) };
+        const em::Matrix4f current = em::Matrix4f().translate(sf::Vector3f(position.x, position.y, 0.f));
+        for(unsigned i = 0; i < 4; i++)
+        {
+            corners[i] = (current * transform * (-current)) * initial[i];
+        }
+    }
+
+    void benchTransformUpdate(const Options &options)
+    {
+        const std::vector<em::Matrix4f> matrices = makeMatrices();
+        const sf::Vector2f position(16.f, 16.f), size(948.f, 595.f);
+        AnimatedImage image(sf::Vector3f(position.x, position.y, 0.f), std::make_unique<sf::Texture>(), size);
+        std::array<sf::Vector3f, 4> corners;
+
+        const double baseline = measure(options.seconds, [&](const unsigned i)
+        {
+            baselineTransform(position, size, matrices[i % TIME_STEPS], corners);
+            g_sink = g_sink + corners[i & 3u].z;
+        });
+        const double current = measure(options.seconds, [&](const unsigned i)
+        {
+            image.transformUpdate(matrices[i % TIME_STEPS]);
+            g_sink = g_sink + image.getVertexDepth(i & 3u);
+        });
+        record("baseline", "", baseline);
+        record("AnimatedImage", "", current);
+        std::printf("%-22s %14.2f\n", "baseline", baseline);
+        std::printf("%-22s %14.2f %9.2fx\n", "AnimatedImage", current, baseline / current);
+    }
+
+    void ripple(MeshPoints &points, const float time)
+    {
+        for(std::size_t i = 0; i < points.count; i++)
+        {
+            points.z[i] = 8.f * std::sin(0.05f * (points.restX[i] + points.restY[i]) + time);
+        }
+    }
+
+    void benchMeshUpdate(const Options &options)
+    {
+        const std::vector<em::Matrix4f> matrices = makeMatrices();
+        const sf::Vector2f position(16.f, 16.f), size(948.f, 595.f);
+        const sf::Vector2u cells(64u, 64u);
+        MeshImage mesh(position, std::make_unique<sf::Texture>(), size, cells);
+
+        //per vertex of every triangle like a vertex array, the points shared by cells are transformed again
+        std::vector<sf::Vector3f> initial, placed(6u * cells.x * cells.y);
+        for(unsigned row = 0; row < cells.y; row++)
+        {
+            for(unsigned column = 0; column < cells.x; column++)
+            {
+                const float left = size.x * column / cells.x, right = size.x * (column + 1u) / cells.x;
+                const float top = size.y * row / cells.y, bottom = size.y * (row + 1u) / cells.y;
+                for(const sf::Vector2f corner : { sf::Vector2f(left, top), sf::Vector2f(right, top), sf::Vector2f(right, bottom),
+                    sf::Vector2f(left, top), sf::Vector2f(right, bottom), sf::Vector2f(left, bottom) })
+                {
+                    initial.push_back(sf::Vector3f(position.x + corner.x, position.y + corner.y, 0.f));
+                }
+            }
+        }
+        const em::Matrix4f current = em::Matrix4f().translate(sf::Vector3f(position.x, position.y, 0.f));
+
+        const double baseline = measure(options.seconds, [&](const unsigned i)
+        {
+            const float time = 0.01f * i;
+            const em::Matrix4f placement = current * matrices[i % TIME_STEPS] * (-current);
+            for(std::size_t v = 0; v < initial.size(); v++)
+            {
+                sf::Vector3f point = initial[v];
+                point.z = 8.f * std::sin(0.05f * (point.x - position.x + point.y - position.y) + time);
+                placed[v] = placement * point;
+            }
+            g_sink = g_sink + placed[i % placed.size()].z;
+        });
+        const double batched = measure(options.seconds, [&](const unsigned i)
+        {
+            const float time = 0.01f * i;
+            mesh.update(matrices[i % TIME_STEPS], [time](MeshPoints &points) { ripple(points, time); });
+            g_sink = g_sink + mesh.getPoint(i % mesh.getPointCount()).z;
+        });
+        record("baseline", "", baseline);
+        record("MeshImage", "", batched);
+        std::printf("%-22s %14.2f\n", "baseline", baseline);
+        std::printf("%-22s %14.2f %9.2fx\n", "MeshImage", batched, baseline / batched);
+    }
+
+    template <typename Channel>
+    void benchChannel(const std::string &name, const Options &options)
+    {
+        //a fade of a 1080p image stored in the channel type, single threaded
+        const sf::Vector2u size = RESOLUTIONS[2].size;
+        const std::vector<unsigned char> bytes = makePixels(size, 3u);
+        std::vector<Channel> pixels(bytes.size()), frame(bytes.size());
+        pk::convertChannels(pk::PixelView<const unsigned char>(bytes.data(), size), pk::PixelView<Channel>(pixels, size));
+        const double ns = measure(options.seconds, [&](const unsigned i)
+        {
+            const std::uint16_t factor = pk::toFactor(static_cast<float>(i % TIME_STEPS) / TIME_STEPS);
+            pk::scaleChannels(pk::PixelView<Channel>(pixels, size), pk::PixelView<Channel>(frame, size), { 256u, 256u, 256u, factor });
+            g_sink = g_sink + pk::ChannelTraits<Channel>::toFloat(frame[i % frame.size()]);
+        });
+        printRow(name, RESOLUTIONS[2].name, ns, static_cast<double>(size.x) * size.y);
+    }
+
+    void benchEncoders(const Options &options)
+    {
+        //a frame halfway through a dimming: smooth gradients with some noise, like photos
+        const sf::Vector2u size = RESOLUTIONS[2].size;
+        std::vector<sf::Uint8> pixels(4u * size.x * size.y);
+        unsigned noise = 1u;
+        for(unsigned y = 0; y < size.y; y++)
+        {
+            for(unsigned x = 0; x < size.x; x++)
+            {
+                noise = noise * 1103515245u + 12345u;
+                sf::Uint8 *pixel = &pixels[4u * (y * size.x + x)];
+                pixel[0] = static_cast<sf::Uint8>(x * 255u / size.x + (noise >> 29u));
+                pixel[1] = static_cast<sf::Uint8>(y * 255u / size.y);
+                pixel[2] = static_cast<sf::Uint8>(128u + (noise >> 30u));
+                pixel[3] = 255u;
+            }
+        }
+        sf::Image image;
+        image.create(size.x, size.y, pixels.data());
+
+        const std::string base = (std::filesystem::temp_directory_path() / "bcg-bench-frame").string();
+        const double sfml = measure(options.seconds, [&](const unsigned)
+        {
+            image.saveToFile(base + ".png");
+        });
+        const double png = measure(options.seconds, [&](const unsigned)
+        {
+            ImageEncoder::save(pixels.data(), size, base + ".png");
+        });
+        const double qoi = measure(options.seconds, [&](const unsigned)
+        {
+            ImageEncoder::save(pixels.data(), size, base + ".qoi");
+        });
+        const double frame_pixels = static_cast<double>(size.x) * size.y;
+        record("sf::Image PNG", RESOLUTIONS[2].name, sfml, frame_pixels);
+        record("ImageEncoder PNG", RESOLUTIONS[2].name, png, frame_pixels);
+        record("ImageEncoder QOI", RESOLUTIONS[2].name, qoi, frame_pixels);
+        std::printf("%-22s %14.0f %9.2fx\n", "sf::Image PNG", sfml, 1.0);
+        std::printf("%-22s %14.0f %9.2fx\n", "ImageEncoder PNG", png, sfml / png);
+        std::printf("%-22s %14.0f %9.2fx\n", "ImageEncoder QOI", qoi, sfml / qoi);
+        std::filesystem::remove(base + ".png");
+        std::filesystem::remove(base + ".qoi");
+    }
+
+    void benchExport(const Options &options)
+    {
+        //the deck of the example images as the headless renderer exports it, the frames are not encoded
+        const sf::Vector2u size = RESOLUTIONS[2].size;
+        Canvas canvas(sf::Vector2f(), static_cast<sf::Vector2f>(size));
+        canvas.getFrameCache().setBudget(0u);
+        for(const char *name : { "dimming", "alfa", "brightness", "slide" })
+        {
+            const SlideTransition transition{findAnimation(name), 1.f};
+            SlideDeck deck;
+            deck.addSlide(Resources::pathOf("images/example1.jpg"));
+            deck.addSlide(Resources::pathOf("images/example2.jpg"), transition);
+            deck.addSlide(Resources::pathOf("images/example3.jpg"), transition);
+
+            std::size_t frames = 0u;
+            const double ns = measure(options.seconds, [&](const unsigned)
+            {
+                frames = 0u;
+                deck.render(canvas, EXPORT_FRAMES, [&frames](ExportFrame frame)
+                {
+                    g_sink = g_sink + frame.data()[frames % 4u];
+                    frames++;
+                });
+            });
+            const double frame_ns = ns / std::max<std::size_t>(frames, 1u);
+            record(name, RESOLUTIONS[2].name, frame_ns, static_cast<double>(size.x) * size.y);
+            std::printf("%-22s %-7s %14.1f %12.1f\n", name, RESOLUTIONS[2].name, frame_ns, 1e9 / frame_ns);
+        }
+    }
+}//anonymous namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    try
+    {
+        if(!parseOptions(argc, argv, options))
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+        if(options.threads >= 0)
+        {
+            ThreadPool::shared().setThreadCount(static_cast<unsigned>(options.threads));
+        }
+        //a missing baseline is reported before anything is measured
+        const BenchmarkReport baseline = options.baseline.empty() ? BenchmarkReport() : BenchmarkReport::loadCsv(options.baseline);
+        g_report.setProperty("threads", std::to_string(ThreadPool::shared().getThreadCount()));
+        g_report.setProperty("isa", pk::isaName(pk::activeIsa()));
+
+        g_group = "pixel";
+        std::printf("Pixel animations, %u threads\n", ThreadPool::shared().getThreadCount());
+        std::printf("%-22s %-7s %14s %12s %12s\n", "animation", "size", "ns/frame", "ns/pixel", "frames/s");
+        benchPixel<DimmingAnimation>("dimming", options);
+        benchPixel<AlfaAnimation>("alfa", options);
+        benchPixel<ByBrightnessAnimation>("brightness", options);
+
+        g_group = "plan";
+        std::printf("\nPlans of pixel animations and the masks executing them\n");
+        std::printf("%-22s %-7s %14s %12s %12s\n", "animation", "size", "ns/call", "ns/pixel", "calls/s");
+        benchPlan<AlfaAnimation>("alfa", options);
+        benchPlan<ByBrightnessAnimation>("brightness", options);
+
+        g_group = "channel";
+        std::printf("\nFade by channel type, %s\n", pk::isaName(pk::activeIsa()));
+        std::printf("%-22s %-7s %14s %12s %12s\n", "channel", "size", "ns/frame", "ns/pixel", "frames/s");
+        benchChannel<std::uint8_t>("8-bit", options);
+        benchChannel<std::uint16_t>("16-bit", options);
+        benchChannel<pk::Half>("half", options);
+        benchChannel<float>("float", options);
+
+        g_group = "isa";
+        std::printf("\nFade of 8-bit channels by instruction set\n");
+        std::printf("%-22s %-7s %14s %12s %12s\n", "instruction set", "size", "ns/frame", "ns/pixel", "frames/s");
+        const pk::Isa active = pk::activeIsa();
+        for(const pk::Isa isa : { pk::Isa::SCALAR, pk::Isa::SSE2, pk::Isa::AVX2, pk::Isa::NEON })
+        {
+            if(pk::setIsa(isa))
+            {
+                benchChannel<std::uint8_t>(pk::isaName(isa), options);
+            }
+        }
+        pk::setIsa(active);
+
+        g_group = "object";
+        std::printf("\nObject animations\n");
+        std::printf("%-22s %-7s %14s %12s %12s\n", "animation", "size", "ns/frame", "ns/pixel", "frames/s");
+        benchObject<SlideAnimation>("slide", options);
+        benchObject<ScaleAnimation>("scale", options);
+        benchObject<RingAnimation>("ring", options);
+        benchObject<FlyAnimation>("fly", options);
+
+        g_group = "matrix";
+        std::printf("\nMatrix4f\n%-22s %14s\n", "operation", "ns/op");
+        benchMatrix(options);
+
+        g_group = "transform";
+        std::printf("\nTransform of an image\n%-22s %14s\n", "implementation", "ns/update");
+        benchTransformUpdate(options);
+
+        g_group = "mesh";
+        std::printf("\nWarp of a 64x64 mesh\n%-22s %14s\n", "implementation", "ns/update");
+        benchMeshUpdate(options);
+
+        g_group = "encoder";
+        std::printf("\nEncoding of a 1080p frame\n%-22s %14s\n", "encoder", "ns/frame");
+        benchEncoders(options);
+
+        g_group = "export";
+        std::printf("\nExport of a deck of 2 transitions, %u frames each\n", EXPORT_FRAMES);
+        std::printf("%-22s %-7s %14s %12s\n", "animation", "size", "ns/frame", "frames/s");
+        benchExport(options);
+
+        if(!options.report.empty())
+        {
+            g_report.write(options.report);
+        }
+        if(!options.baseline.empty() && !g_report.check(baseline, options.threshold, std::cout))
+        {
+            return 1;
+        }
+    }
+    catch(const std::exception &error)
+    {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,28 @@
+# Writes a source file holding the contents of every resource, run as a script:
+#   cmake -DRESOURCE_DIR=<res> -DHEADER=<Resources.h> -DOUTPUT=<file.cpp> -P EmbedResources.cmake
+# The resources are named by their path relative to RESOURCE_DIR, see Resources.h
+
+file(GLOB_RECURSE files RELATIVE "${RESOURCE_DIR}" "${RESOURCE_DIR}/*.png" "${RESOURCE_DIR}/*.jpg" "${RESOURCE_DIR}/*.otf")
+list(SORT files)
+
+set(arrays "")
+set(entries "")
+set(index 0)
+foreach(file ${files})
+	file(READ "${RESOURCE_DIR}/${file}" hex HEX)
+	string(LENGTH "${hex}" length)
+	math(EXPR size "${length} / 2")
+	if(size GREATER 0)
+		string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," bytes "${hex}")
+		string(APPEND arrays "\tconst unsigned char resource_${index}[${size}] = {${bytes}};\n")
+		string(APPEND entries "\t{ \"${file}\", resource_${index}, ${size}u },\n")
+		math(EXPR index "${index} + 1")
+	endif()
+endforeach()
+
+file(WRITE "${OUTPUT}"
+	"// generated by cmake/EmbedResources.cmake from ${RESOURCE_DIR}, do not edit\n"
+	"#include \"${HEADER}\"\n\n"
+	"namespace\n{\n${arrays}}//anonymous namespace\n\n"
+	"const Resource Resources::ENTRIES[] = {\n${entries}\t{ nullptr, nullptr, 0u } };\n\n"
+	"const std::size_t Resources::ENTRY_COUNT = ${index};\n")
@@ -0,0 +1,565 @@
+#include "include/gui/Canvas.h"
+#include "include/gui/SlideDeck.h"
+#include "include/gui/ExportScheduler.h"
+#include "include/export/ImageSequenceSink.h"
+#include "include/export/GifSink.h"
+#include "include/export/FfmpegSink.h"
+#include "include/export/RawSequenceSink.h"
+#include "include/util/BenchmarkReport.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <iostream>
+
+/**
+ * Batch renderer exporting animations of image pairs without opening any window
+ *
+ * Every pair is rendered through Canvas into its offscreen plane and the frames
+ *   are written to the same sinks as the save button uses, so the output matches
+ *   animations exported from the application.
+ */
+namespace
+{
+    struct Options
+    {
+        std::vector<std::pair<std::string, std::string>> pairs;
+        std::string deck;//file of a slide deck rendered as one animation
+        std::string plugins = AnimationPlugins::DEFAULT_DIRECTORY;//directory of the manifests of animation plugins
+        std::string golden;//directory of golden frames every animation is compared to
+        bool updateGolden = false;//golden frames are rendered again instead of compared
+        unsigned tolerance = 2u;//difference of a channel still matching the golden frame
+        std::vector<std::string> animations;//every pair is rendered with every animation and frame count
+        std::vector<unsigned> frames;
+        float length = 1.f;
+        float fps = 0.f;//frames per second replacing the frame counts when positive
+        unsigned subframes = 1u;//instants averaged into every frame for motion blur
+        std::string easing = "linear";//curve of the progress of pair animations
+        std::string output = ".";
+        std::string extension = "bmp";
+        sf::Vector2u size = sf::Vector2u(948u, 595u);//size of the canvas in the application
+        bool shaders = true;
+        bool linearLight = false;//dimming in linear light
+        bool premultiplied = false;//pixel animations on the CPU work on premultiplied alpha
+        int threads = -1;//taken from BCG_THREADS when not given
+        unsigned workers = 0u;//animations rendered at once, 0 for the amount of cores
+        std::string cache;//directory of rendered sequences reused by later runs, empty to render every pair
+        std::string report;//file the export throughput is written to, .json or .csv
+        std::string baseline;//CSV report the throughput is compared with
+        float threshold = BenchmarkReport::DEFAULT_THRESHOLD;//share the export may get slower by
+    };
+
+    std::vector<std::string> splitList(const std::string &list)
+    {
+        std::vector<std::string> items;
+        std::istringstream stream(list);
+        std::string item;
+        while(std::getline(stream, item, ','))
+        {
+            if(!item.empty())
+            {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+
+    void printUsage(const char *name)
+    {
+        std::cerr
+            << "Usage: " << name << " --pair <start image> <end image> [--pair ...] [options]\n"
+            << "       " << name << " --list <file with pairs, one per line> [options]\n"
+            << "       " << name << " --deck <file with slides, one per line> [options]\n"
+            << "       " << name << " --golden <directory> [--update-golden] [--tolerance <0-255>] [options]\n"
+            << "Options:\n"
+            << "  --animation <name|1-7>  dimming, alfa, brightness, slide, scale, ring, fly (default dimming)\n"
+            << "                          or the name of a plugin, combined with + to play together and > to play one after another, e.g. slide+alfa\n"
+            << "  --frames <10-500>       amount of rendered frames (default 15)\n"
+            << "                          both may be comma separated lists, every pair is rendered with all of them\n"
+            << "  --length <seconds>      length of the animation (default 1)\n"
+            << "  --fps <rate>            frames per second of any rate, replaces --frames with the frames of --length\n"
+            << "  --motion-blur <1-64>    instants averaged on the GPU into every frame, spread since the previous one (default 1)\n"
+            << "  --easing <curve>        linear, ease-in, ease-out, ease-in-out, spring or bezier:x1,y1,x2,y2 (default linear)\n"
+            << "  --size <W>x<H>          size of rendered frames (default 948x595)\n"
+            << "  --output <directory>    directory the frames are saved to (default .)\n"
+            << "  --format <extension>    bmp, png, qoi, jpg, tga for frame files, gif, mp4 or bcgraw for one animation file (default bmp)\n"
+            << "  --cpu                   compute pixel animations on the CPU and sort object animations instead of shaders\n"
+            << "  --linear-light          dim colors in linear light instead of their sRGB values\n"
+            << "  --premultiplied         compute pixel animations on the CPU with premultiplied alpha\n"
+            << "  --threads <count>       threads computing pixel animations, 0 for all cores (default BCG_THREADS or 0)\n"
+            << "  --workers <count>       animations rendered at once, 0 for all cores (default 0)\n"
+            << "  --plugins <directory>   directory of the manifests of animation plugins (default plugins)\n"
+            << "  --cache <directory>     replays pairs rendered before with the same settings, stores the others\n"
+            << "  --golden <directory>    compares frames of every animation of the example images to the golden ones\n"
+            << "  --update-golden         saves the golden frames instead of comparing them\n"
+            << "  --tolerance <0-255>     difference of a channel still matching the golden frame (default 2)\n"
+            << "  --report <file>         writes the export time and frames per second to a .json or .csv file\n"
+            << "  --baseline <file>       compares the export time with a .csv report, exits with 1 if it got slower\n"
+            << "  --threshold <%>         percent the export may get slower by before it fails the comparison (default 10)\n"
+            << "With more than one animation every one is saved to its own numbered subdirectory.\n"
+            << "A deck line is \"<image>\" [animation] [length], the animation and the length of\n"
+            << "  the transition leading to the image default to --animation and --length;\n"
+            << "  all transitions of a deck are saved one after another, --frames per transition." << std::endl;
+    }
+
+    bool parseOptions(int argc, char **argv, Options &options)
+    {
+        for(int i = 1; i < argc; i++)
+        {
+            const std::string arg = argv[i];
+            auto value = [&](const int count) -> bool
+            {
+                if(i + count >= argc)
+                {
+                    throw std::runtime_error("headless: missing value of " + arg);
+                }
+                return true;
+            };
+
+            if(arg == "--pair" && value(2))
+            {
+                options.pairs.emplace_back(argv[i + 1], argv[i + 2]);
+                i += 2;
+            }
+            else if(arg == "--list" && value(1))
+            {
+                std::ifstream list(argv[++i]);
+                if(!list)
+                {
+                    throw std::runtime_error(std::string("headless: cannot open list ") + argv[i]);
+                }
+                std::string start, end;
+                while(list >> start >> end)
+                {
+                    options.pairs.emplace_back(start, end);
+                }
+            }
+            else if(arg == "--plugins" && value(1))
+            {
+                options.plugins = argv[++i];
+            }
+            else if(arg == "--deck" && value(1))
+            {
+                options.deck = argv[++i];
+            }
+            else if(arg == "--golden" && value(1))
+            {
+                options.golden = argv[++i];
+            }
+            else if(arg == "--update-golden")
+            {
+                options.updateGolden = true;
+            }
+            else if(arg == "--tolerance" && value(1))
+            {
+                options.tolerance = static_cast<unsigned>(std::clamp(std::stoi(argv[++i]), 0, 255));
+            }
+            else if(arg == "--animation" && value(1))
+            {
+                options.animations = splitList(argv[++i]);
+            }
+            else if(arg == "--frames" && value(1))
+            {
+                options.frames.clear();
+                for(const std::string &frames : splitList(argv[++i]))
+                {
+                    options.frames.push_back(std::clamp(std::stoi(frames), 10, 500));
+                }
+            }
+            else if(arg == "--length" && value(1))
+            {
+                options.length = std::stof(argv[++i]);
+                if(!(options.length > 0.f))
+                {
+                    throw std::runtime_error("headless: length has to be positive");
+                }
+            }
+            else if(arg == "--easing" && value(1))
+            {
+                options.easing = argv[++i];
+                SampledCurve::fromName(options.easing);//unknown curves are reported before anything is rendered
+            }
+            else if(arg == "--size" && value(1))
+            {
+                unsigned width = 0u, height = 0u;
+                if(std::sscanf(argv[++i], "%ux%u", &width, &height) != 2 || width == 0u || height == 0u)
+                {
+                    throw std::runtime_error(std::string("headless: invalid size ") + argv[i]);
+                }
+                options.size = sf::Vector2u(width, height);
+            }
+            else if(arg == "--output" && value(1))
+            {
+                options.output = argv[++i];
+            }
+            else if(arg == "--format" && value(1))
+            {
+                options.extension = argv[++i];
+            }
+            else if(arg == "--threads" && value(1))
+            {
+                options.threads = std::max(std::stoi(argv[++i]), 0);
+            }
+            else if(arg == "--workers" && value(1))
+            {
+                options.workers = static_cast<unsigned>(std::max(std::stoi(argv[++i]), 0));
+            }
+            else if(arg == "--cache" && value(1))
+            {
+                options.cache = argv[++i];
+            }
+            else if(arg == "--cpu")
+            {
+                options.shaders = false;
+            }
+            else if(arg == "--fps" && value(1))
+            {
+                options.fps = std::stof(argv[++i]);
+                if(!(options.fps > 0.f))
+                {
+                    throw std::runtime_error("headless: fps have to be positive");
+                }
+            }
+            else if(arg == "--motion-blur" && value(1))
+            {
+                options.subframes = static_cast<unsigned>(std::clamp(std::stoi(argv[++i]), 1, 64));
+            }
+            else if(arg == "--linear-light")
+            {
+                options.linearLight = true;
+            }
+            else if(arg == "--premultiplied")
+            {
+                options.premultiplied = true;
+            }
+            else if(arg == "--report" && value(1))
+            {
+                options.report = argv[++i];
+            }
+            else if(arg == "--baseline" && value(1))
+            {
+                options.baseline = argv[++i];
+            }
+            else if(arg == "--threshold" && value(1))
+            {
+                options.threshold = std::stof(argv[++i]) / 100.f;
+                if(!(options.threshold >= 0.f))
+                {
+                    throw std::runtime_error("headless: threshold must not be negative");
+                }
+            }
+            else
+            {
+                return false;
+            }
+        }
+        if(options.animations.empty())
+        {
+            options.animations.push_back("dimming");
+        }
+        if(options.fps > 0.f)
+        {
+            options.frames = { FrameGrid::atRate(options.fps, options.length).getFrames() };
+        }
+        else if(options.frames.empty())
+        {
+            options.frames.push_back(15u);
+        }
+        //exactly one of the pairs, a deck and the golden frames is rendered
+        const int modes = !options.pairs.empty() + !options.deck.empty() + !options.golden.empty();
+        return modes == 1;
+    }
+
+    std::size_t animationIndex(const std::string &name)
+    {
+        const std::size_t index = findAnimation(name);
+        if(index == animationCount())
+        {
+            throw std::runtime_error("headless: unknown animation " + name);
+        }
+        return index;
+    }
+
+    std::unique_ptr<FrameSink> createSink(const Options &options, const std::string &directory, const unsigned frames)
+    {
+        std::filesystem::create_directories(directory);
+        if(options.extension == "gif")
+        {
+            return std::make_unique<GifSink>(directory + "/animation.gif", (frames - 1u) / options.length);
+        }
+        if(options.extension == "mp4")
+        {
+            return std::make_unique<FfmpegSink>(directory + "/animation.mp4", (frames - 1u) / options.length);
+        }
+        if(options.extension == "bcgraw")
+        {
+            return std::make_unique<RawSequenceSink>(directory + "/animation" + RawSequence::EXTENSION, (frames - 1u) / options.length);
+        }
+        return std::make_unique<ImageSequenceSink>(directory, options.extension);
+    }
+
+    void checkImage(const std::string &path)
+    {
+        if(!Resources::isResourcePath(path) && !std::filesystem::is_regular_file(path))
+        {
+            throw std::runtime_error("headless: cannot find image " + path);
+        }
+    }
+
+    std::size_t renderPairs(const Options &options)
+    {
+        ExportScheduler scheduler(options.size);
+        scheduler.setWorkerCount(options.workers);
+        scheduler.setUseShaders(options.shaders);
+        scheduler.setPremultipliedAlpha(options.premultiplied);
+        std::unique_ptr<SequenceCache> cache;
+        if(!options.cache.empty())
+        {
+            cache = std::make_unique<SequenceCache>(options.cache);
+            scheduler.setCache(cache.get());
+        }
+
+        const bool linear_light = options.linearLight;
+        const SampledCurve easing = SampledCurve::fromName(options.easing);
+        std::vector<std::string> directories;
+        const std::size_t count = options.pairs.size() * options.animations.size() * options.frames.size();
+        for(const auto &pair : options.pairs)
+        {
+            checkImage(pair.first);
+            checkImage(pair.second);
+            for(const std::string &name : options.animations)
+            {
+                for(const unsigned frames : options.frames)
+                {
+                    const std::string directory = count == 1u
+                        ? options.output
+                        : options.output + "/" + ImageSequenceSink::frameName(static_cast<unsigned>(directories.size() + 1u));
+                    ExportJob job;
+                    job.start = pair.first;
+                    job.end = pair.second;
+                    if(TransitionGraph::isDescription(name))
+                    {
+                        TransitionGraph::parse(name);//unknown animations are reported before anything is rendered
+                        job.graph = name;
+                    }
+                    else
+                    {
+                        job.animation = animationIndex(name);
+                    }
+                    job.frames = frames;
+                    job.length = options.length;
+                    job.subframes = options.subframes;
+                    job.setup = [linear_light, easing](AnyAnimation &animation)
+                    {
+                        baseAnimation(animation).setEasing(easing);
+                        if(DimmingAnimation *dimming = std::get_if<DimmingAnimation>(&animation))
+                        {
+                            dimming->setLinearLight(linear_light);
+                        }
+                    };
+                    job.sink = [&options, directory, frames]() { return createSink(options, directory, frames); };
+                    scheduler.addJob(std::move(job));
+                    directories.push_back(directory);
+                }
+            }
+        }
+
+        //frames are placed exactly as Timeline places them for the save button
+        std::size_t rendered = 0u;
+        scheduler.run([&options, &directories, &rendered](const ExportProgress &progress)
+        {
+            rendered = progress.renderedFrames;
+            if(progress.jobFinished)
+            {
+                const std::size_t pair = progress.job / (options.animations.size() * options.frames.size());
+                std::cout << "[" << progress.finishedJobs << "/" << progress.jobCount << "] Rendered "
+                    << options.pairs[pair].first << " -> " << options.pairs[pair].second
+                    << " to " << directories[progress.job] << std::endl;
+            }
+        });
+        return rendered;
+    }
+
+    std::size_t renderDeck(const Options &options)
+    {
+        Canvas canvas(sf::Vector2f(), sf::Vector2f(options.size));
+        canvas.setPremultipliedAlpha(options.premultiplied);
+        canvas.getFrameCache().setBudget(0u);//every frame is rendered only once
+        canvas.setMotionBlur(options.subframes);
+
+        SlideDeck deck = SlideDeck::fromFile(options.deck, SlideTransition{animationIndex(options.animations.front()), options.length});
+        if(deck.getTransitionCount() == 0u)
+        {
+            throw std::runtime_error("headless: deck " + options.deck + " needs at least two slides");
+        }
+        for(std::size_t i = 0; i < deck.getSlideCount(); i++)
+        {
+            checkImage(deck.getPath(i));
+        }
+
+        std::unique_ptr<FrameSink> sink = createSink(options, options.output, options.frames.front());
+        std::size_t rendered = 0u;
+        deck.render(canvas, options.frames.front(), [&sink, &rendered](ExportFrame frame)
+        {
+            sink->write(std::move(frame));
+            rendered++;
+        }, options.shaders);
+        sink->close();
+        std::cout << "Rendered " << deck.getTransitionCount() << " transitions of " << options.deck
+            << " to " << options.output << std::endl;
+        return rendered;
+    }
+
+    double millisecondsSince(const std::chrono::steady_clock::time_point &start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /**
+     * Prints the throughput of the export, writes it to the report and compares it with the baseline
+     *
+     * The case is named by the input and the format, so a baseline is compared only
+     *   with the same export. Returns false if the export got slower than the baseline allows.
+     */
+    bool reportExport(const Options &options, const BenchmarkReport &baseline, const std::size_t frames, const double milliseconds)
+    {
+        BenchmarkReport report;
+        const std::string input = options.deck.empty() ? "pairs" : std::filesystem::path(options.deck).filename().string();
+        const std::string size = std::to_string(options.size.x) + "x" + std::to_string(options.size.y);
+        const BenchmarkReport::Result result{"export", input + " " + options.extension, size,
+            milliseconds * 1e6 / std::max<std::size_t>(frames, 1u), static_cast<double>(options.size.x) * options.size.y};
+        report.add(result);
+        report.setProperty("frames", std::to_string(frames));
+        report.setProperty("threads", std::to_string(ThreadPool::shared().getThreadCount()));
+        report.setProperty("shaders", options.shaders ? "on" : "off");
+        std::cout << "Exported " << frames << " frames in " << std::fixed << std::setprecision(2) << milliseconds / 1e3
+            << " s, " << result.perSecond() << " frames/s" << std::endl;
+
+        if(!options.report.empty())
+        {
+            report.write(options.report);
+        }
+        return options.baseline.empty() || report.check(baseline, options.threshold, std::cout);
+    }
+
+    bool compareGolden(const Options &options)
+    {
+        //fixed frames of every animation of the example images, including both ends
+        const unsigned frames = 5u;
+        const std::vector<float> times = FrameGrid(frames, 1.f).times();
+        if(options.updateGolden)
+        {
+            std::filesystem::create_directories(options.golden);
+        }
+        else if(!std::filesystem::is_directory(options.golden))
+        {
+            throw std::runtime_error("headless: no golden frames in " + options.golden + ", save them with --update-golden on a known good build");
+        }
+
+        Canvas canvas(sf::Vector2f(), sf::Vector2f(options.size));
+        canvas.setPremultipliedAlpha(options.premultiplied);
+        canvas.getFrameCache().setBudget(0u);
+        canvas.setStartingImage(Resources::pathOf("images/example1.jpg"));
+        canvas.setEndingImage(Resources::pathOf("images/example2.jpg"));
+
+        std::cout << std::left << std::setw(12) << "animation" << std::right
+            << std::setw(12) << "render ms" << std::setw(12) << "diff ms" << std::setw(12) << "max diff"
+            << std::setw(14) << "over tol." << "  result (" << pk::isaName(pk::activeIsa()) << ", tolerance "
+            << options.tolerance << ")" << std::endl;
+        bool passed = true;
+        for(std::size_t i = 0; i < ANIMATIONS.size(); i++)
+        {
+            canvas.setAnimation(createAnimation(i), options.shaders);
+            canvas.setTotalAnimationTime(1.f);
+
+            std::vector<ExportFrame> rendered;
+            const auto render_start = std::chrono::steady_clock::now();
+            canvas.renderSequence(times, [&rendered](ExportFrame frame) { rendered.push_back(std::move(frame)); });
+            const double render_ms = millisecondsSince(render_start);
+
+            double diff_ms = 0.0;
+            pk::DiffStats total;
+            std::string result = options.updateGolden ? "saved" : "ok";
+            for(std::size_t k = 0; k < rendered.size(); k++)
+            {
+                const ExportFrame &frame = rendered[k];
+                const std::string path = options.golden + "/" + ANIMATIONS[i].name + "_"
+                    + ImageSequenceSink::frameName(static_cast<unsigned>(k + 1u)) + ".png";
+                if(options.updateGolden)
+                {
+                    sf::Image image;
+                    image.create(frame.size.x, frame.size.y, frame.data());
+                    if(!image.saveToFile(path))
+                    {
+                        throw std::runtime_error("headless: cannot save golden frame " + path);
+                    }
+                    continue;
+                }
+
+                sf::Image golden;
+                if(!golden.loadFromFile(path) || golden.getSize() != frame.size)
+                {
+                    result = "missing or resized " + path;
+                    passed = false;
+                    break;
+                }
+                const auto diff_start = std::chrono::steady_clock::now();
+                const pk::DiffStats stats = pk::diffImages(golden.getPixelsPtr(), frame.data(),
+                    static_cast<std::size_t>(frame.size.x) * frame.size.y, options.tolerance);
+                diff_ms += millisecondsSince(diff_start);
+                total.maxDifference = std::max(total.maxDifference, stats.maxDifference);
+                total.differingPixels += stats.differingPixels;
+            }
+            if(!options.updateGolden && total.differingPixels > 0u && result == "ok")
+            {
+                result = "FAILED";
+                passed = false;
+            }
+
+            std::cout << std::left << std::setw(12) << ANIMATIONS[i].name << std::right << std::fixed << std::setprecision(2)
+                << std::setw(12) << render_ms << std::setw(12) << diff_ms
+                << std::setw(12) << static_cast<unsigned>(total.maxDifference)
+                << std::setw(14) << total.differingPixels << "  " << result << std::endl;
+        }
+        return passed;
+    }
+}//anonymous namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    try
+    {
+        if(!parseOptions(argc, argv, options))
+        {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        if(options.threads >= 0)
+        {
+            ThreadPool::shared().setThreadCount(static_cast<unsigned>(options.threads));
+        }
+        AnimationPlugins::shared().discover(options.plugins);
+
+        if(!options.golden.empty())
+        {
+            return compareGolden(options) ? 0 : 1;
+        }
+        //a missing baseline is reported before anything is rendered
+        const BenchmarkReport baseline = options.baseline.empty() ? BenchmarkReport() : BenchmarkReport::loadCsv(options.baseline);
+        const auto start = std::chrono::steady_clock::now();
+        const std::size_t frames = options.deck.empty() ? renderPairs(options) : renderDeck(options);
+        if(!reportExport(options, baseline, frames, millisecondsSince(start)))
+        {
+            return 1;
+        }
+    }
+    catch(const std::exception &error)
+    {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "PixelAnimation.h"
+#include "../util/PixelKernels.h"
 
 
 /**
@@ -46,6 +47,20 @@ class AlfaAnimation : public PixelAnimation
 		const sf::Texture &texture1,
 		const sf::Texture &texture2);
 
+	/**
+	 * @brief      The constructor with settings of animation
+	 *
+	 * @param      animation_length  The animation length
+	 * @param      animation_speed   The animation speed
+	 * @param      image1            The decoded start image
+	 * @param      image2            The decoded end image
+	 */
+	explicit AlfaAnimation(
+		const float &animation_length,
+		const float &animation_speed,
+		const sf::Image &image1,
+		const sf::Image &image2);
+
 	/**
 	 * @brief      Destructor
 	 */
@@ -54,44 +69,133 @@ class AlfaAnimation : public PixelAnimation
 
 
 	/**
-	 * @brief      Returns how texture of start image should look.
+	 * @brief      Getter of the GLSL fragment shader performing the animation on the GPU
 	 *
-	 * @param      current_time  The current time
+	 * @return     Source code of the shader
+	 */
+	const std::string &getShaderSource() const override;
+
+	/**
+	 * @brief      Writes how texture of start image should look.
 	 *
-	 * @return     The first image look in specific time.
+	 * @param      current_time  The current time
+	 * @param      output        The buffer the frame is written to
 	 * 
 	 * Reducing alpha value from orginal value to 0
 	 */
-	inline const std::vector<unsigned char> getTexture1Frame(const float &current_time) const override
+	inline void writeTexture1Frame(const float &current_time, std::vector<unsigned char> &output) const override
 	{
-		std::vector<unsigned char> temp = m_pixels1;
-		for(unsigned i=3; i<temp.size(); i+=4)
+		output.resize(m_pixels1.size());
+		const pk::ChannelFactors factors = this->factors1(current_time);
+		const std::uint8_t *src = m_pixels1.data();
+		std::uint8_t *dst = output.data();
+		forEachPixelRange(m_pixels1.size() / 4, [src, dst, &factors](std::size_t begin, std::size_t end)
 		{
-			temp[i] = static_cast<unsigned char>( static_cast<float>(temp[i]) - (static_cast<float>(temp[i]) * (current_time/m_totalTime)) );
-		}
-			
-		return temp;
+			pk::scaleChannels(src + begin * 4, dst + begin * 4, end - begin, factors);
+		});
 	}
 
 
 	/**
-	 * @brief      Returns how texture of end image should look.
+	 * @brief      Writes how texture of end image should look.
 	 *
 	 * @param      current_time  The current time
-	 *
-	 * @return     The end image look in specific time.
+	 * @param      output        The buffer the frame is written to
 	 * 
 	 * Increasing alpha value from 0 to orginal value
 	 */
-	inline const std::vector<unsigned char> getTexture2Frame(const float &current_time) const override
+	inline void writeTexture2Frame(const float &current_time, std::vector<unsigned char> &output) const override
 	{
-		std::vector<unsigned char> temp = m_pixels2;
-		for(unsigned i=3; i<temp.size(); i+=4)
+		output.resize(m_pixels2.size());
+		const pk::ChannelFactors factors = this->factors2(current_time);
+		const std::uint8_t *src = m_pixels2.data();
+		std::uint8_t *dst = output.data();
+		forEachPixelRange(m_pixels2.size() / 4, [src, dst, &factors](std::size_t begin, std::size_t end)
 		{
-			temp[i] = static_cast<unsigned char>( (static_cast<float>(temp[i]) * (current_time/m_totalTime)) ) ;
-		}
-			
-		return temp;
+			pk::scaleChannels(src + begin * 4, dst + begin * 4, end - begin, factors);
+		});
 	} 
  
+
+	/**
+	 * @brief      Gets the frame of the first image as an operation on any pixels
+	 *
+	 * @param      current_time  The current time
+	 *
+	 * @return     Operation scaling the channels like writeTexture1Frame
+	 */
+	PixelOperation frameOperation1(const float &current_time) const override;
+
+	/**
+	 * @brief      Gets the frame of the second image as an operation on any pixels
+	 *
+	 * @param      current_time  The current time
+	 *
+	 * @return     Operation scaling the channels like writeTexture2Frame
+	 */
+	PixelOperation frameOperation2(const float &current_time) const override;
+
+	/**
+	 * @brief      Finds the pixels of the first image which differ between frames at two times
+	 *
+	 * @param      from_time  Time of the frame already written
+	 * @param      to_time    Time of the next frame
+	 *
+	 * @return     The whole image if the alpha factor differs, nothing otherwise
+	 */
+	PixelSpan changedPixels1(const float &from_time, const float &to_time) const override;
+
+	/**
+	 * @brief      Finds the pixels of the second image which differ between frames at two times
+	 *
+	 * @param      from_time  Time of the frame already written
+	 * @param      to_time    Time of the next frame
+	 *
+	 * @return     The whole image if the alpha factor differs, nothing otherwise
+	 */
+	PixelSpan changedPixels2(const float &from_time, const float &to_time) const override;
+
+	/**
+	 * @brief      Tells whether frames differ from the images only in alpha
+	 *
+	 * @return     True, fading never changes the colors
+	 */
+	bool hasAlphaMasks() const override;
+
+	/**
+	 * @brief      Writes alpha of the start image, reduced from orginal value to 0
+	 *
+	 * @param      current_time  The current time
+	 * @param      output        The buffer the mask is written to
+	 */
+	void writeAlpha1Mask(const float &current_time, std::vector<unsigned char> &output) const override;
+
+	/**
+	 * @brief      Writes alpha of the end image, increased from 0 to orginal value
+	 *
+	 * @param      current_time  The current time
+	 * @param      output        The buffer the mask is written to
+	 */
+	void writeAlpha2Mask(const float &current_time, std::vector<unsigned char> &output) const override;
+
+	/**
+	 * @brief      Getter to the memory of the plan
+	 *
+	 * @return     Bytes of the alpha planes of both images
+	 */
+	std::size_t getPlanBytes() const override;
+
+	protected:
+	/**
+	 * @brief      Extracts the alpha planes the masks are scaled from
+	 */
+	void pixelsChanged(const unsigned changed) override;
+
+	private:
+	static void writeMask(const std::vector<std::uint8_t> &alpha, const unsigned factor, std::vector<unsigned char> &output);///> Scales the alpha plane into the mask
+	pk::ChannelFactors factors1(const float &current_time) const;///> Scaling of the channels of the first image at the time
+	pk::ChannelFactors factors2(const float &current_time) const;///> Scaling of the channels of the second image at the time
+
+	std::vector<std::uint8_t> m_alpha1;///> Alpha of every pixel of the first image
+	std::vector<std::uint8_t> m_alpha2;///> Alpha of every pixel of the second image
 };
\ No newline at end of file
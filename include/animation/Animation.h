@@ -1,7 +1,28 @@
 #pragma once
 
-#include "../root/Root.h"
+#include "../util/ExtendedMath.h"
+#include "../util/ContentHash.h"
+#include "SampledCurve.h"
 
+/**
+ * @brief Frame of an animation computed by Animation::sample
+ *
+ * Object animations fill the transforms of both images, pixel animations
+ *   the pixels of both images, the other members are left untouched.
+ */
+struct AnimationFrame
+{
+	float time = 0.f;						///> Time of the animation the frame is taken at
+	em::Matrix4f transform1;				///> Transform of the first image
+	em::Matrix4f transform2;				///> Transform of the second image
+	std::vector<unsigned char> pixels1;		///> RGBA pixels of the first image
+	std::vector<unsigned char> pixels2;		///> RGBA pixels of the second image
+};
+
+/**
+ * @brief Function receiving frames computed by Animation::sample, along with their index
+ */
+using FrameConsumer = std::function<void(const std::size_t index, const AnimationFrame &frame)>;
 
 /**
  * @brief Base class of all animation
@@ -55,9 +76,64 @@ public:
 	 */
 	virtual void setAnimationSpeed(const float &speed_factor);
 
+	/**
+	 * @brief Setter of the easing of the progress of the animation.
+	 *
+	 * @param easing The curve, resampled for the length of the animation
+	 */
+	void setEasing(const SampledCurve &easing);
+
+	/**
+	 * @brief Getter of the easing of the progress of the animation.
+	 *
+	 * @return The curve, linear by default
+	 */
+	const SampledCurve &getEasing() const;
+
+	/**
+	 * @brief Getter to the progress the frame at a time is computed from
+	 *
+	 * @param current_time Time of the animation
+	 *
+	 * @return Progress eased by the curve of the animation
+	 */
+	float progressAt(const float &current_time) const;
+
+	/**
+	 * @brief Hash of everything the frames of the animation depend on besides the images
+	 *
+	 * @return The hash, the same for animations of the same type and parameters
+	 *
+	 * Derived animations with parameters of their own add them to the hash of their base.
+	 */
+	virtual std::uint64_t getParameterHash() const;
+
+	/**
+	 * @brief Computes frames of the animation at many times in one call
+	 *
+	 * @param times Times of the animation the frames are taken at
+	 * @param consumer Function receiving the frames, in order of the times, on the calling thread
+	 *
+	 * The frame given to the consumer is valid only during its call, its buffers
+	 *   are reused for the following frames.
+	 */
+	virtual void sample(const std::vector<float> &times, const FrameConsumer &consumer) const = 0;
+
 protected:
+	/**
+	 * @brief Converts time of the animation into its progress
+	 *
+	 * @param current_time The current time
+	 *
+	 * @return Progress of the animation eased by its curve, 0 at its start and 1 at its end
+	 */
+	inline float toProgress(const float &current_time) const
+	{
+		return m_easing(m_totalTime > 0.f ? current_time / m_totalTime : 0.f);
+	}
+
 	float m_totalTime; 
-	float m_currentTime; 
 	float m_speedFactor; 
+	SampledCurve m_easing;	///> easing of the progress, sampled for the length
 	
 };
@@ -0,0 +1,207 @@
+#pragma once
+
+#include "ObjectAnimation.h"
+#include "PixelAnimation.h"
+
+#include <deque>
+#include <mutex>
+#include <variant>
+
+/**
+ * @brief Version of the interface between the application and its plugins
+ *
+ * Plugins derive from the animation classes of the application, so they have to be
+ *   built against the same headers by the same compiler. The version is raised with
+ *   every change of those headers which breaks plugins built before.
+ */
+#define BCG_PLUGIN_ABI 2u
+
+#if defined(_WIN32)
+	#define BCG_PLUGIN_EXPORT extern "C" __declspec(dllexport)
+#else
+	#define BCG_PLUGIN_EXPORT extern "C" __attribute__((visibility("default")))
+#endif
+
+/**
+ * @brief Description of a plugin, returned by the bcgAnimationPlugin function every plugin exports
+ *
+ * Exactly one of the factories is set. Shader based transitions are pixel animations
+ *   returning their source from PixelAnimation::getShaderSource.
+ */
+struct AnimationPluginEntry
+{
+	unsigned abi;///> BCG_PLUGIN_ABI the plugin was built with
+	const char *name;///> Name of the animation, has to match the manifest
+	ObjectAnimation *(*createObject)();///> Creates the animation with default parameters, nullptr for pixel animations
+	PixelAnimation *(*createPixel)();///> Creates the animation with default parameters, nullptr for object animations
+};
+
+namespace detail
+{
+	template <typename Type>
+	ObjectAnimation *createPluginObject()
+	{
+		if constexpr(std::is_base_of_v<PixelAnimation, Type>)
+		{
+			return nullptr;
+		}
+		else
+		{
+			return new Type();
+		}
+	}
+
+	template <typename Type>
+	PixelAnimation *createPluginPixel()
+	{
+		if constexpr(std::is_base_of_v<PixelAnimation, Type>)
+		{
+			return new Type();
+		}
+		else
+		{
+			return nullptr;
+		}
+	}
+}//namespace detail
+
+/**
+ * @brief Defines the entry point of a plugin holding one animation
+ *
+ * Used once in a source file of the plugin, with the name of the animation and its
+ *   class, which has to be default constructible.
+ */
+#define BCG_ANIMATION_PLUGIN(NAME, TYPE) \
+	BCG_PLUGIN_EXPORT const AnimationPluginEntry *bcgAnimationPlugin() \
+	{ \
+		static const AnimationPluginEntry entry = { BCG_PLUGIN_ABI, NAME, \
+			std::is_base_of_v<PixelAnimation, TYPE> ? nullptr : &detail::createPluginObject<TYPE>, \
+			std::is_base_of_v<PixelAnimation, TYPE> ? &detail::createPluginPixel<TYPE> : nullptr }; \
+		return &entry; \
+	}
+
+/**
+ * @brief Animation created by a factory, moving the images or changing their pixels
+ */
+using AnimationPointer = std::variant<std::unique_ptr<ObjectAnimation>, std::unique_ptr<PixelAnimation>>;
+
+/**
+ * @brief Animations loaded at runtime from shared libraries
+ *
+ * Plugins are found by their manifests, text files ending with MANIFEST_EXTENSION
+ *   of "key = value" lines:
+ *
+ *   name = swirl				name used on the command line and in deck files
+ *   label = Swirl				name shown in the animation list, the name if missing
+ *   library = libswirl.so		shared library relative to the manifest
+ *   requires = avx2 shaders		capabilities the kernels need: sse2, avx2, neon, shaders
+ *
+ * Discovery reads only the manifests and skips plugins whose requirements are not met,
+ *   a library is opened by the first animation created from it and kept open until
+ *   the application ends, since the animations run its code.
+ *
+ * Plugins are discovered before anything uses the registry, afterwards they may be
+ *   created from any thread.
+ */
+class AnimationPlugins
+{
+public:
+	static constexpr const char *MANIFEST_EXTENSION = ".bcgplugin";///> Extension of the manifests
+	static constexpr const char *DEFAULT_DIRECTORY = "plugins";///> Directory searched by the applications
+
+	/**
+	 * @brief Getter to the plugins of the applications
+	 *
+	 * @return The plugins
+	 */
+	static AnimationPlugins &shared();
+
+	AnimationPlugins() = default;
+	AnimationPlugins(const AnimationPlugins &) = delete;
+	AnimationPlugins &operator=(const AnimationPlugins &) = delete;
+
+	/**
+	 * @brief Registers the plugins of all manifests in a directory
+	 *
+	 * @param directory The directory, a missing one holds no plugins
+	 *
+	 * @return Amount of plugins registered
+	 *
+	 * Manifests which cannot be read are reported on the standard error output and
+	 *   skipped, so one broken plugin does not keep the application from starting.
+	 */
+	std::size_t discover(const std::string &directory);
+
+	/**
+	 * @brief Registers the plugin of a manifest
+	 *
+	 * @param manifest Path to the manifest
+	 *
+	 * @return True if it was registered, false if its requirements are not met
+	 *
+	 * Throws std::runtime_error if the manifest cannot be read or misses the name
+	 *   or the library, or names an animation which already exists.
+	 */
+	bool add(const std::string &manifest);
+
+	/**
+	 * @brief Getter to the amount of registered plugins
+	 *
+	 * @return The amount
+	 */
+	std::size_t getCount() const;
+
+	/**
+	 * @brief Getter to the name of a plugin
+	 *
+	 * @param index Index of the plugin
+	 *
+	 * @return Name used on the command line
+	 */
+	const char *getName(const std::size_t index) const;
+
+	/**
+	 * @brief Getter to the label of a plugin
+	 *
+	 * @param index Index of the plugin
+	 *
+	 * @return Name shown in the animation list
+	 */
+	const char *getLabel(const std::size_t index) const;
+
+	/**
+	 * @brief Creates the animation of a plugin, opening its library by the first call
+	 *
+	 * @param index Index of the plugin
+	 *
+	 * @return The animation with default parameters
+	 *
+	 * Throws std::out_of_range for indices past the plugins and std::runtime_error
+	 *   if the library cannot be opened or does not fit the application.
+	 */
+	AnimationPointer create(const std::size_t index);
+
+	/**
+	 * @brief Checks whether the application is able to run kernels of given capability
+	 *
+	 * @param capability One of the capabilities of the manifests
+	 *
+	 * @return True if it is supported, false for unknown capabilities
+	 */
+	static bool isCapable(const std::string &capability);
+
+private:
+	struct Plugin
+	{
+		std::string name;///> Name used on the command line
+		std::string label;///> Name shown in the animation list
+		std::string library;///> Path to the shared library
+		void *handle = nullptr;///> Opened library, nullptr until the first animation is created
+		const AnimationPluginEntry *entry = nullptr;///> Entry point of the opened library
+	};
+
+	void open(Plugin &plugin);///> Opens the library of the plugin and checks its entry point
+
+	std::deque<Plugin> m_plugins;///> Registered plugins, in order of registration
+	std::mutex m_mutex;///> Guards the opening of libraries
+};
@@ -0,0 +1,193 @@
+#pragma once
+
+#include "DimmingAnimation.h"
+#include "AlfaAnimation.h"
+#include "ByBrightnessAnimation.h"
+#include "SlideAnimation.h"
+#include "ScaleAnimation.h"
+#include "RingAnimation.h"
+#include "FlyAnimation.h"
+#include "AnimationPlugins.h"
+
+#include <array>
+#include <variant>
+
+/**
+ * @brief Any animation of the application, alternatives are in order of the animation list
+ *
+ * Adding an animation means adding its type here and its names to ANIMATIONS,
+ *   the list, the headless renderer and the settings pick it up from both.
+ *   Animations of plugins follow the built-in ones and are held by the last two
+ *   alternatives, which have to stay last.
+ */
+using AnyAnimation = std::variant<
+	DimmingAnimation,
+	AlfaAnimation,
+	ByBrightnessAnimation,
+	SlideAnimation,
+	ScaleAnimation,
+	RingAnimation,
+	FlyAnimation,
+	std::unique_ptr<ObjectAnimation>,
+	std::unique_ptr<PixelAnimation>>;
+
+/**
+ * @brief Amount of animations built into the application
+ */
+constexpr std::size_t BUILTIN_ANIMATIONS = std::variant_size_v<AnyAnimation> - std::variant_size_v<AnimationPointer>;
+
+/**
+ * @brief Names of an animation
+ */
+struct AnimationInfo
+{
+	const char *name;	///> Name used on the command line
+	const char *label;	///> Name shown in the animation list
+};
+
+/**
+ * @brief Names of the built-in animations, in order of the alternatives of AnyAnimation
+ */
+constexpr std::array<AnimationInfo, BUILTIN_ANIMATIONS> ANIMATIONS = {{
+	{ "dimming", "Dimming" },
+	{ "alfa", "Fading" },
+	{ "brightness", "Pixels Brightness" },
+	{ "slide", "Slide Left to Right" },
+	{ "scale", "Scale From Point" },
+	{ "ring", "Ring Animation" },
+	{ "fly", "Fly Away Animation" } }};
+
+namespace detail
+{
+	using AnimationFactory = AnyAnimation (*)();
+
+	template <std::size_t... I>
+	constexpr std::array<AnimationFactory, sizeof...(I)> makeAnimationFactories(std::index_sequence<I...>)
+	{
+		return {{ []() { return AnyAnimation(std::in_place_index<I>); }... }};
+	}
+
+	constexpr std::array<AnimationFactory, BUILTIN_ANIMATIONS> ANIMATION_FACTORIES =
+		makeAnimationFactories(std::make_index_sequence<BUILTIN_ANIMATIONS>());
+}//namespace detail
+
+/**
+ * @brief Getter to the amount of animations, the built-in ones followed by the ones of plugins
+ *
+ * @return The amount
+ */
+inline std::size_t animationCount()
+{
+	return BUILTIN_ANIMATIONS + AnimationPlugins::shared().getCount();
+}
+
+/**
+ * @brief Getter to the names of an animation
+ *
+ * @param index Index of the animation, below animationCount
+ *
+ * @return The names
+ */
+inline AnimationInfo animationInfo(const std::size_t index)
+{
+	if(index < BUILTIN_ANIMATIONS)
+	{
+		return ANIMATIONS[index];
+	}
+	const AnimationPlugins &plugins = AnimationPlugins::shared();
+	if(index - BUILTIN_ANIMATIONS >= plugins.getCount())
+	{
+		throw std::out_of_range("animationInfo(): there is no animation of index " + std::to_string(index));
+	}
+	return AnimationInfo{ plugins.getName(index - BUILTIN_ANIMATIONS), plugins.getLabel(index - BUILTIN_ANIMATIONS) };
+}
+
+/**
+ * @brief Creates the animation of given index with default parameters
+ *
+ * @param index Index of the animation, below animationCount
+ *
+ * @return The animation
+ */
+inline AnyAnimation createAnimation(const std::size_t index)
+{
+	if(index < BUILTIN_ANIMATIONS)
+	{
+		return detail::ANIMATION_FACTORIES[index]();
+	}
+	if(index - BUILTIN_ANIMATIONS >= AnimationPlugins::shared().getCount())
+	{
+		throw std::out_of_range("createAnimation(): there is no animation of index " + std::to_string(index));
+	}
+	return std::visit([](auto &&created) { return AnyAnimation(std::move(created)); }, AnimationPlugins::shared().create(index - BUILTIN_ANIMATIONS));
+}
+
+/**
+ * @brief Moves any animation onto the heap, as the Canvas and the transitions keep them
+ *
+ * @param animation The animation
+ *
+ * @return The animation behind a pointer to its base class
+ */
+inline AnimationPointer releaseAnimation(AnyAnimation animation)
+{
+	return std::visit([](auto &chosen) -> AnimationPointer
+	{
+		using Type = std::decay_t<decltype(chosen)>;
+		if constexpr(std::is_same_v<Type, std::unique_ptr<ObjectAnimation>> || std::is_same_v<Type, std::unique_ptr<PixelAnimation>>)
+		{
+			return std::move(chosen);
+		}
+		else if constexpr(std::is_base_of_v<PixelAnimation, Type>)
+		{
+			return std::unique_ptr<PixelAnimation>(std::make_unique<Type>(std::move(chosen)));
+		}
+		else
+		{
+			return std::unique_ptr<ObjectAnimation>(std::make_unique<Type>(std::move(chosen)));
+		}
+	}, animation);
+}
+
+/**
+ * @brief Getter to the parameters all animations share
+ *
+ * @param animation Any animation
+ *
+ * @return The animation as its base class
+ */
+inline Animation &baseAnimation(AnyAnimation &animation)
+{
+	return std::visit([](auto &chosen) -> Animation &
+	{
+		using Type = std::decay_t<decltype(chosen)>;
+		if constexpr(std::is_same_v<Type, std::unique_ptr<ObjectAnimation>> || std::is_same_v<Type, std::unique_ptr<PixelAnimation>>)
+		{
+			return *chosen;
+		}
+		else
+		{
+			return chosen;
+		}
+	}, animation);
+}
+
+/**
+ * @brief Finds the animation by its name or its number on the animation list
+ *
+ * @param name Name of an animation or number counted from 1
+ *
+ * @return Index of the animation, animationCount if there is no such animation
+ */
+inline std::size_t findAnimation(const std::string &name)
+{
+	const std::size_t count = animationCount();
+	for(std::size_t i = 0; i < count; i++)
+	{
+		if(name == animationInfo(i).name || name == std::to_string(i + 1u))
+		{
+			return i;
+		}
+	}
+	return count;
+}
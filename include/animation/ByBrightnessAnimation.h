@@ -1,6 +1,7 @@
 #pragma once
 
 #include "PixelAnimation.h"
+#include "../util/PixelKernels.h"
 
 
 /**
@@ -46,6 +47,20 @@ class ByBrightnessAnimation : public PixelAnimation
 		const sf::Texture &texture1,
 		const sf::Texture &texture2);
 
+	/**
+	 * @brief      The constructor with settings of animation
+	 *
+	 * @param      animation_length  The animation length
+	 * @param      animation_speed   The animation speed
+	 * @param      image1            The decoded start image
+	 * @param      image2            The decoded end image
+	 */
+	explicit ByBrightnessAnimation(
+		const float &animation_length,
+		const float &animation_speed,
+		const sf::Image &image1,
+		const sf::Image &image2);
+
 	/**
 	 * @brief      Dectructor
 	 */
@@ -53,78 +68,214 @@ class ByBrightnessAnimation : public PixelAnimation
 
 
 	/**
-	 * @brief      Returns how texture of start image should look.
+	 * @brief      Getter of the GLSL fragment shader performing the animation on the GPU
 	 *
+	 * @return     Source code of the shader
+	 */
+	const std::string &getShaderSource() const override;
+
+	/**
+	 * @brief      Sets the brightness range of the second image on top of the base uniforms
+	 *
+	 * @param      shader        The compiled shader
 	 * @param      current_time  The current time
+	 */
+	void setShaderParameters(sf::Shader &shader, const float &current_time) const override;
+
+	/**
+	 * @brief      Writes how texture of start image should look.
 	 *
-	 * @return     The first image look in specific time.
+	 * @param      current_time  The current time
+	 * @param      output        The buffer the frame is written to
 	 * 
 	 * 
-	 * searching darkest and brightness pixel, (avrage of (r,g,b)) and after that:
+	 * darkest and brightness pixel (avrage of (r,g,b)) are precomputed and after that:
 	 *  key = (1 - progres) * (brightness - darkest + 1) + darkest
 	 *  if pixel brightness > key then we hidding that one. 
 	 * 
+	 * If the images differ in size, the frame has the size of the bigger one
+	 *   and missing pixels are treated as transparent black.
 	 */
-	inline const std::vector<unsigned char> getTexture1Frame(const float &current_time) const override
+	inline void writeTexture1Frame(const float &current_time, std::vector<unsigned char> &output) const override
 	{
-		std::vector<unsigned char> out = m_pixels1;
-		std::vector<unsigned char> temp = m_pixels2;
-		unsigned char brightness = 0 , darkest = 255;
-		float key = (m_totalTime-current_time)/m_totalTime;
+		const std::vector<unsigned char> &in = m_pixels1;
 
 		//making sure that vectors are equal in size
-		unsigned bigger = out.size() > temp.size() ? out.size() : temp.size();
-		if(bigger != temp.size())
-		{
-			temp.resize(bigger);
-		}
-		if(bigger != out.size())
-		{
-			out.resize(bigger);
-		}
+		const std::size_t bigger = std::max(in.size(), m_pixels2.size());
+		const std::size_t common = std::min(in.size(), m_pixels2.size());
+		output.resize(bigger);
 
-		// searching brightest pixel
-		for(unsigned i=0; i<temp.size(); i+=4)
+		const unsigned threshold = this->threshold(current_time);
+		const std::uint8_t *src = in.data();
+		const std::uint8_t *luminance = m_luminance.data();
+		std::uint8_t *dst = output.data();
+		const bool premultiplied = m_premultiplied;
+		forEachPixelRange(common / 4, [src, luminance, dst, threshold, premultiplied](std::size_t begin, std::size_t end)
 		{
-			if( (temp[i] + temp[i+1] + temp[i+2])/3 > brightness )
+			if(premultiplied)//hidden pixels lose their color as well
 			{
-				brightness = (temp[i] + temp[i+1] + temp[i+2])/3;
+				pk::clearByLuminance(src + begin * 4, luminance + begin, dst + begin * 4, end - begin, threshold);
 			}
-		}
-		// searching darkest pixel
-		for(unsigned i=0; i<temp.size(); i+=4)
-		{
-			if( (temp[i] + temp[i+1] + temp[i+2])/3 < darkest )
+			else
 			{
-				darkest = (temp[i] + temp[i+1] + temp[i+2])/3;
+				pk::maskAlphaByLuminance(src + begin * 4, luminance + begin, dst + begin * 4, end - begin, threshold);
 			}
-		}
+		});
 
-		key = ( key * (brightness - darkest + 1) + darkest ) ;
-		for(unsigned i=0; i<temp.size(); i+=4)
+		if(in.size() > common)//the rest of the first image is not covered by the second one
 		{
-			if(	 (temp[i] + temp[i+1] + temp[i+2])/3 >= static_cast<unsigned char>(key))
+			std::copy(in.begin() + common, in.end(), output.begin() + common);
+			if(threshold == 0 && m_premultiplied)
+			{
+				std::fill(output.begin() + common, output.end(), 0);
+			}
+			else if(threshold == 0)
 			{
-				out[i+3] = 0;
-			}   	
-		}	
-		return out;
+				for(std::size_t i = common + 3; i < bigger; i += 4)
+				{
+					output[i] = 0;
+				}
+			}
+		}
+		else//the first image is missing, its pixels are transparent anyway
+		{
+			std::fill(output.begin() + common, output.end(), 0);
+		}
 	}
 
 
 	/**
-	 * @brief      Returns how texture of ending image should look.
+	 * @brief      Writes how texture of ending image should look.
 	 *
 	 * @param      current_time  The current time
-	 *
-	 * @return     The first image look in specific time.
+	 * @param      output        The buffer the frame is written to
 	 * 
 	 * 
 	 * No changes - same image whole aniamtion time
 	 */
-	inline const std::vector<unsigned char> getTexture2Frame(const float &current_time) const override
+	inline void writeTexture2Frame(const float &current_time, std::vector<unsigned char> &output) const override
 	{
-		return m_pixels2;
+		output.assign(m_pixels2.begin(), m_pixels2.end());
 	} 
- 
+
+	/**
+	 * @brief      Gets the frame of the first image as an operation on any pixels
+	 *
+	 * @param      current_time  The current time
+	 *
+	 * @return     Operation hiding pixels by the brightness of the second image like writeTexture1Frame,
+	 *             the frame has the size of the pixels it is given
+	 */
+	PixelOperation frameOperation1(const float &current_time) const override;
+
+	/**
+	 * @brief      Gets the frame of the second image as an operation on any pixels
+	 *
+	 * @param      current_time  The current time
+	 *
+	 * @return     Operation copying the pixels
+	 */
+	PixelOperation frameOperation2(const float &current_time) const override;
+
+	/**
+	 * @brief      Finds the pixels of the first image which differ between frames at two times
+	 *
+	 * @param      from_time  Time of the frame already written
+	 * @param      to_time    Time of the next frame
+	 *
+	 * @return     Range from the first to the last pixel whose brightness lies between
+	 *             the thresholds of both times, only those toggle their alpha
+	 */
+	PixelSpan changedPixels1(const float &from_time, const float &to_time) const override;
+
+	/**
+	 * @brief      Finds the pixels of the second image which differ between frames at two times
+	 *
+	 * @param      from_time  Time of the frame already written
+	 * @param      to_time    Time of the next frame
+	 *
+	 * @return     Always empty, the second image does not change
+	 */
+	PixelSpan changedPixels2(const float &from_time, const float &to_time) const override;
+
+	/**
+	 * @brief      Tells whether frames differ from the images only in alpha
+	 *
+	 * @return     True, pixels are only hidden, their colors are kept
+	 */
+	bool hasAlphaMasks() const override;
+
+	/**
+	 * @brief      Writes alpha of the start image, cleared for pixels brighter than the key
+	 *
+	 * @param      current_time  The current time
+	 * @param      output        The buffer the mask is written to
+	 *
+	 * @see writeTexture1Frame
+	 */
+	void writeAlpha1Mask(const float &current_time, std::vector<unsigned char> &output) const override;
+
+	/**
+	 * @brief      Writes alpha of the end image, which is never changed
+	 *
+	 * @param      current_time  The current time
+	 * @param      output        The buffer the mask is written to
+	 */
+	void writeAlpha2Mask(const float &current_time, std::vector<unsigned char> &output) const override;
+
+	/**
+	 * @brief      Brings a frame of the start image to another time, hiding or showing only the pixels which change
+	 *
+	 * @param      from_time  Time the frame in the buffer was written at
+	 * @param      to_time    Time of the next frame
+	 * @param      frame      Buffer holding the frame written at from_time
+	 *
+	 * @return     True unless the buffer does not have the size of a frame
+	 *
+	 * Pixels are visited in the order of their brightness, so a frame costs the
+	 *   pixels whose brightness lies between both keys, in either direction.
+	 */
+	bool updateTexture1Frame(const float &from_time, const float &to_time, std::vector<unsigned char> &frame) const override;
+
+	/**
+	 * @brief      Brings a mask of the start image to another time, clearing or restoring only the pixels which change
+	 *
+	 * @param      from_time  Time the mask in the buffer was written at
+	 * @param      to_time    Time of the next mask
+	 * @param      mask       Buffer holding the mask written at from_time
+	 *
+	 * @return     True unless the buffer does not have the size of a mask
+	 *
+	 * @see updateTexture1Frame
+	 */
+	bool updateAlpha1Mask(const float &from_time, const float &to_time, std::vector<unsigned char> &mask) const override;
+
+	/**
+	 * @brief      Getter to the memory of the plan
+	 *
+	 * @return     Bytes of the luminance of the second image, the pixels sorted by it and the alpha plane of the first one
+	 */
+	std::size_t getPlanBytes() const override;
+
+	protected:
+	/**
+	 * @brief      Recomputes the luminance of the second image, the pixels sorted by it and the alpha plane of the first one
+	 *
+	 * Replacing only the first image by one of the same size keeps the luminance and the order.
+	 */
+	void pixelsChanged(const unsigned changed) override;
+
+	private:
+	unsigned threshold(const float &current_time) const; ///> Brightness from which the pixels of the first image are hidden at the time
+	template <typename Write>
+	void updateChanged(const unsigned from, const unsigned to, const Write &write) const; ///> Calls write(pixel, hidden) for every pixel of the first image changing between the thresholds
+
+	std::vector<std::uint8_t> m_luminance; ///> Brightness of every pixel of the second image
+	std::vector<std::uint8_t> m_alpha1; ///> Alpha of every pixel of the first image
+	std::vector<std::uint32_t> m_order; ///> Pixels covered by both images, sorted by brightness
+	std::array<std::size_t, 257> m_levelBegin; ///> First entry of the order of every brightness, the amount of entries at 256
+	std::array<std::size_t, 256> m_firstOfLevel; ///> First pixel of every brightness, the amount of pixels if there is none
+	std::array<std::size_t, 256> m_endOfLevel; ///> Pixel after the last one of every brightness, 0 if there is none
+	std::uint8_t m_darkest; ///> Brightness of the darkest pixel of the second image
+	std::uint8_t m_brightest; ///> Brightness of the brightest pixel of the second image
 };
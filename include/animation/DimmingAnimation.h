@@ -1,6 +1,7 @@
 #pragma once
 
 #include "PixelAnimation.h"
+#include "../util/PixelKernels.h"
 
 
 /**
@@ -46,6 +47,20 @@ class DimmingAnimation : public PixelAnimation
 		const sf::Texture &texture1,
 		const sf::Texture &texture2);
 
+	/**
+	 * @brief      The constructor with settings of animation
+	 *
+	 * @param      animation_length  The animation length
+	 * @param      animation_speed   The animation speed
+	 * @param      image1            The decoded start image
+	 * @param      image2            The decoded end image
+	 */
+	explicit DimmingAnimation(
+		const float &animation_length,
+		const float &animation_speed,
+		const sf::Image &image1,
+		const sf::Image &image2);
+
 	/**
 	 * @brief Destructor
 	 */
@@ -53,78 +68,123 @@ class DimmingAnimation : public PixelAnimation
 
 
 	/**
-	 * @brief Gets the texture 1 frame.
+	 * @brief      Getter of the GLSL fragment shader performing the animation on the GPU
 	 *
-	 * @param current_time The current time
+	 * @return     Source code of the shader
+	 */
+	const std::string &getShaderSource() const override;
+
+	/**
+	 * @brief      Sets uniforms of the shader, the linear light switch included
+	 *
+	 * @param      shader        The compiled shader
+	 * @param      current_time  The current time
+	 */
+	void setShaderParameters(sf::Shader &shader, const float &current_time) const override;
+
+	/**
+	 * @brief      Chooses whether colors are dimmed in linear light
+	 *
+	 * @param      linear_light  True to dim decoded sRGB values, false to dim the stored ones
+	 * 
+	 * Dimming in linear light keeps the shadows from turning black long before
+	 *   the midtones do. Stored values are dimmed by the SIMD kernels, linear light
+	 *   by a lookup table built once per frame. Premultiplied colors are decoded as
+	 *   they are stored, which is exact for opaque pixels.
+	 */
+	void setLinearLight(const bool linear_light);
+
+	/**
+	 * @brief      Tells whether colors are dimmed in linear light
+	 *
+	 * @return     True if they are
+	 */
+	bool isLinearLight() const;
+
+	/**
+	 * @brief Hash of the parameters of PixelAnimation and the light mode
+	 *
+	 * @return The hash
+	 */
+	std::uint64_t getParameterHash() const override;
+
+	/**
+	 * @brief Writes the texture 1 frame.
 	 *
-	 * @return The texture 1 frame.
+	 * @param current_time The current time
+	 * @param output The buffer the frame is written to
 	 * 
 	 * All r,g,b values are reduce to 0 (until 1/2*TotalTime)
 	 * After that we set alpha value on 0 - image is transparent 
 	 * 
 	 */
-	inline const std::vector<unsigned char> getTexture1Frame(const float &current_time) const override
+	inline void writeTexture1Frame(const float &current_time, std::vector<unsigned char> &output) const override
 	{
-		std::vector<unsigned char> temp = m_pixels1;
-
-		if( current_time <= m_totalTime/2.f )
-		{
-			for(unsigned i=0; i<temp.size(); i+=4)
-			{
-				temp[i] -= static_cast<unsigned char>( static_cast<float>(temp[i]) * (current_time/(m_totalTime/2.f)) );
-				temp[i+1] -= static_cast<unsigned char>( static_cast<float>(temp[i+1]) * (current_time/(m_totalTime/2.f)) );
-				temp[i+2] -= static_cast<unsigned char>( static_cast<float>(temp[i+2]) * (current_time/(m_totalTime/2.f)) );
-			}
-		}
-		else 
-		{
-			for(unsigned i=0; i<temp.size(); i+=4)
-			{
-				temp[i+3] = 0;  
-			}
-		}
-
-		return temp;
+		this->writeScaled(m_pixels1, this->factors1(current_time), output);
 	}
 
 
 
 	/**
-	 * @brief Gets the texture 2 frame.
+	 * @brief Writes the texture 2 frame.
 	 *
 	 * @param current_time The current time
-	 *
-	 * @return The texture 2 frame.
+	 * @param output The buffer the frame is written to
 	 * 
 	 * Until 1/2*TotalTime that we set alpha value on 0 - image is transparent  
 	 * Atter that all r,g,b values are increasing from 0 
 	 */
-	inline const std::vector<unsigned char> getTexture2Frame(const float &current_time) const override
+	inline void writeTexture2Frame(const float &current_time, std::vector<unsigned char> &output) const override
 	{
-		std::vector<unsigned char> temp = m_pixels2;
-
-		if( current_time <= m_totalTime/2.f )
-		{
-			for(unsigned i=0; i<temp.size(); i+=4)
-			{
-				temp[i] = 0; 
-				temp[i+1] = 0;
-				temp[i+2] = 0;
-			}
-			
-		}
-		else 
-		{
-			for(unsigned i=0; i<temp.size(); i+=4)
-			{
-				temp[i] = static_cast<unsigned char> ( static_cast<float>(temp[i]) * ((current_time-m_totalTime/2.f) / (m_totalTime/2.f))  ) ;
-				temp[i+1] = static_cast<unsigned char> ( static_cast<float>(temp[i+1]) * ((current_time-m_totalTime/2.f) / (m_totalTime/2.f)) );
-				temp[i+2] = static_cast<unsigned char> ( static_cast<float>(temp[i+2]) * ((current_time-m_totalTime/2.f) / (m_totalTime/2.f)) );
-				temp[i+3] = static_cast<unsigned char>( static_cast<float>(temp[i+3]) * ((current_time-m_totalTime/2.f) / (m_totalTime/2.f)) );  
-			}
-		}
-		return temp;
-
+		this->writeScaled(m_pixels2, this->factors2(current_time), output);
 	} 
  
+
+	/**
+	 * @brief Gets the frame of the first image as an operation on any pixels
+	 *
+	 * @param current_time The current time
+	 *
+	 * @return Operation dimming the colors like writeTexture1Frame
+	 */
+	PixelOperation frameOperation1(const float &current_time) const override;
+
+	/**
+	 * @brief Gets the frame of the second image as an operation on any pixels
+	 *
+	 * @param current_time The current time
+	 *
+	 * @return Operation brightening the colors like writeTexture2Frame
+	 */
+	PixelOperation frameOperation2(const float &current_time) const override;
+
+	/**
+	 * @brief Finds the pixels of the first image which differ between frames at two times
+	 *
+	 * @param from_time Time of the frame already written
+	 * @param to_time Time of the next frame
+	 *
+	 * @return The whole image if the scaling of the channels differs, nothing otherwise,
+	 *   so the transparent second half uploads nothing
+	 */
+	PixelSpan changedPixels1(const float &from_time, const float &to_time) const override;
+
+	/**
+	 * @brief Finds the pixels of the second image which differ between frames at two times
+	 *
+	 * @param from_time Time of the frame already written
+	 * @param to_time Time of the next frame
+	 *
+	 * @return The whole image if the scaling of the channels differs, nothing otherwise,
+	 *   so the black first half uploads nothing
+	 */
+	PixelSpan changedPixels2(const float &from_time, const float &to_time) const override;
+
+	private:
+	void writeScaled(const std::vector<unsigned char> &pixels, const pk::ChannelFactors &factors, std::vector<unsigned char> &output) const;///> Scales channels of the pixels into the frame
+	PixelOperation scaling(const pk::ChannelFactors &factors) const;///> Operation scaling channels of any pixels, in linear light if it is chosen
+	pk::ChannelFactors factors1(const float &current_time) const;///> Scaling of the channels of the first image at the time
+	pk::ChannelFactors factors2(const float &current_time) const;///> Scaling of the channels of the second image at the time
+
+	bool m_linearLight;///> Whether colors are dimmed in linear light
 };
\ No newline at end of file
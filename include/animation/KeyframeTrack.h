@@ -0,0 +1,204 @@
+#pragma once
+
+#include "../util/ExtendedMath.h"
+#include "../util/ContentHash.h"
+
+/**
+ * @brief Curves changing the pace of the interpolation between two keyframes
+ */
+enum class Easing
+{
+	LINEAR = 0,		///> Constant pace
+	STEP = 1,		///> Value of the keyframe is held until the next one
+	EASE_IN = 2,	///> Starts slowly and accelerates
+	EASE_OUT = 3,	///> Starts fast and decelerates
+	EASE_IN_OUT = 4	///> Accelerates and decelerates
+};
+
+/**
+ * @brief Components of a transform, composed in order translation, rotation, scale
+ */
+struct TransformComponents
+{
+	sf::Vector3f translation = sf::Vector3f(0.f, 0.f, 0.f);	///> Translation in pixels
+	sf::Vector3f rotation = sf::Vector3f(0.f, 0.f, 0.f);	///> Rotation around X, Y and Z axes in degrees
+	sf::Vector3f scale = sf::Vector3f(1.f, 1.f, 1.f);		///> Scale in X, Y and Z axes
+};
+
+/**
+ * @brief Range [begin, end] of progress of an animation
+ */
+struct ProgressRange
+{
+	float begin = 0.f;	///> First progress of the range
+	float end = -1.f;	///> Last progress of the range
+
+	/**
+	 * @brief Checks whether the range holds no progress
+	 *
+	 * @return True if empty
+	 */
+	bool isEmpty() const { return end < begin; }
+
+	/**
+	 * @brief Checks whether the range holds a progress
+	 *
+	 * @param progress The progress
+	 *
+	 * @return True if it is inside
+	 */
+	bool contains(const float &progress) const { return progress >= begin && progress <= end; }
+};
+
+/**
+ * @brief Sequence of keyframes describing how a transform changes during an animation
+ *
+ * Keyframes are placed at progress of the animation, from 0 at its start to 1 at its
+ *   end, so a track does not depend on the length of the animation. Components are
+ *   interpolated between neighbouring keyframes and composed straight into the
+ *   final matrix, without multiplying separate translation and scaling matrices.
+ *
+ * Two keyframes at the same progress make a jump: the first one is the value at
+ *   that progress, the second one is the start of the following segment.
+ */
+class KeyframeTrack
+{
+public:
+	/**
+	 * @brief Transform of the track at a progress of the animation
+	 */
+	struct Keyframe
+	{
+		float progress;					///> Progress the keyframe is placed at, from 0 to 1
+		TransformComponents components;	///> Components of the transform at the keyframe
+		Easing easing;					///> Easing of the segment from this keyframe to the next one
+	};
+
+	/**
+	 * @brief Default constructor creating a track without keyframes
+	 */
+	KeyframeTrack();
+
+	/**
+	 * @brief Adds a keyframe to the track
+	 *
+	 * @param progress Progress of the animation the keyframe is placed at, from 0 to 1
+	 * @param components Components of the transform at the keyframe
+	 * @param easing Easing of the segment from this keyframe to the next one
+	 *
+	 * Keyframes do not have to be added in order, ones at the same progress keep
+	 *   the order they were added in.
+	 */
+	void addKeyframe(const float &progress, const TransformComponents &components, const Easing easing = Easing::LINEAR);
+
+	/**
+	 * @brief Replaces a keyframe, moving it to its place if its progress changed
+	 *
+	 * @param index Index of the keyframe, in order of progress
+	 * @param keyframe The new keyframe
+	 *
+	 * @return Index of the keyframe after the change
+	 *
+	 * Throws std::out_of_range if there is no keyframe of the index.
+	 */
+	std::size_t setKeyframe(const std::size_t index, const Keyframe &keyframe);
+
+	/**
+	 * @brief Removes a keyframe
+	 *
+	 * @param index Index of the keyframe, in order of progress
+	 *
+	 * Throws std::out_of_range if there is no keyframe of the index.
+	 */
+	void removeKeyframe(const std::size_t index);
+
+	/**
+	 * @brief Getter to a keyframe
+	 *
+	 * @param index Index of the keyframe, in order of progress
+	 *
+	 * @return The keyframe
+	 *
+	 * Throws std::out_of_range if there is no keyframe of the index.
+	 */
+	const Keyframe &getKeyframe(const std::size_t index) const;
+
+	/**
+	 * @brief Removes all keyframes
+	 */
+	void clear();
+
+	/**
+	 * @brief Getter to the amount of keyframes
+	 *
+	 * @return The amount of keyframes
+	 */
+	std::size_t getKeyframeCount() const;
+
+	/**
+	 * @brief Hash of the keyframes
+	 *
+	 * @return The hash, the same for tracks of the same keyframes
+	 */
+	std::uint64_t getHash() const;
+
+	/**
+	 * @brief Finds the progress at which two tracks may evaluate differently
+	 *
+	 * @param other The other track, usually this one before an edit
+	 *
+	 * @return Range from the last keyframe both tracks share before their differences
+	 *   to the first one they share after, empty if the tracks are the same
+	 *
+	 * Differences reaching the first or the last keyframe spread over all progress
+	 *   before or after it, which the ends of the range are infinite for.
+	 */
+	ProgressRange changedRange(const KeyframeTrack &other) const;
+
+	/**
+	 * @brief Interpolates components of the transform
+	 *
+	 * @param progress Progress of the animation, from 0 to 1
+	 *
+	 * @return The interpolated components, components of identity transform if there are no keyframes
+	 *
+	 * Progress before the first or after the last keyframe takes its components.
+	 */
+	TransformComponents evaluate(const float &progress) const;
+
+	/**
+	 * @brief Interpolates the transform and composes it into a matrix
+	 *
+	 * @param progress Progress of the animation, from 0 to 1
+	 * @param base Transform the track is applied on
+	 *
+	 * @return The transform matrix
+	 */
+	em::Matrix4f evaluateMatrix(const float &progress, const em::Matrix4f &base = em::Matrix4f()) const;
+
+	/**
+	 * @brief Composes components of a transform into a matrix
+	 *
+	 * @param components The components
+	 * @param base Affine transform the components are applied on
+	 *
+	 * @return The same matrix as base.translate(translation).rotateX(x).rotateY(y).rotateZ(z).scale(scale),
+	 *   built in closed form
+	 */
+	static em::Matrix4f compose(const TransformComponents &components, const em::Matrix4f &base = em::Matrix4f());
+
+	/**
+	 * @brief Applies the easing curve on linear progress of a segment
+	 *
+	 * @param easing The easing curve
+	 * @param progress Linear progress of the segment, from 0 to 1
+	 *
+	 * @return Eased progress, 0 at the start and 1 at the end of the segment
+	 */
+	static float ease(const Easing easing, const float &progress);
+
+private:
+	static bool isSame(const Keyframe &left, const Keyframe &right);///> Whether two keyframes are equal in every field
+
+	std::vector<Keyframe> m_keyframes;///> Keyframes sorted by progress
+};
@@ -1,10 +1,14 @@
 #pragma once
 
 #include "Animation.h"
-#include "../util/ExtendedMath.h"
+#include "KeyframeTrack.h"
 
 /**
  * @brief Base class of every animation, based on transformations of textures 
+ *
+ * Transforms of both images are described by keyframe tracks applied on the
+ *   starting transforms. Animations which cannot be expressed as keyframes
+ *   override the frame getters instead.
  */
 class ObjectAnimation : public Animation
 {
@@ -39,22 +43,69 @@ public:
 
 
 	/**
-	 * @brief      pure virtual method responisble for animations on first image
+	 * @brief      Method responisble for animations on first image
 	 *
 	 * @param[in]  current_time  The current time
 	 *
-	 * @return     Frame of first image.
+	 * @return     Frame of first image, evaluated from the first track by default.
 	 */
-	inline virtual const em::Matrix4f getImage1Frame(const float &current_time) const = 0;
+	virtual const em::Matrix4f getImage1Frame(const float &current_time) const;
 	
 	/**
-	 * @brief 	    pure virtual method responsible for animations on second image
+	 * @brief 	    Method responsible for animations on second image
 	 *
 	 * @param 		current_time The current time
 	 *
-	 * @return 		Frame of second image.
+	 * @return 		Frame of second image, evaluated from the second track by default.
 	 */
-	inline virtual const em::Matrix4f getImage2Frame(const float &current_time) const = 0;
+	virtual const em::Matrix4f getImage2Frame(const float &current_time) const;
+
+	/**
+	 * @brief Computes transforms of both images at many times in one call
+	 *
+	 * @param times Times of the animation the frames are taken at
+	 * @param consumer Function receiving the frames with filled transforms
+	 */
+	void sample(const std::vector<float> &times, const FrameConsumer &consumer) const override;
+
+	/**
+	 * @brief Getter to the keyframes of the first image
+	 *
+	 * @return The track of the first image
+	 */
+	const KeyframeTrack &getTrack1() const;
+
+	/**
+	 * @brief Getter to the keyframes of the second image
+	 *
+	 * @return The track of the second image
+	 */
+	const KeyframeTrack &getTrack2() const;
+
+	/**
+	 * @brief Getter to the keyframes of an image, to edit them
+	 *
+	 * @param image 1 for the first image, 2 for the second one
+	 *
+	 * @return The track
+	 *
+	 * Throws std::out_of_range for other images.
+	 */
+	KeyframeTrack &editTrack(const unsigned image);
+
+	/**
+	 * @brief Checks whether the frames are evaluated from the tracks
+	 *
+	 * @return True by default, false for animations overriding the frame getters
+	 */
+	virtual bool isKeyframed() const;
+
+	/**
+	 * @brief Hash of the length, the speed, the transforms and the tracks
+	 *
+	 * @return The hash
+	 */
+	std::uint64_t getParameterHash() const override;
 
 	/**
 	 * @brief Getter for the starting transform for image 1.
@@ -117,5 +168,7 @@ protected:
 	em::Matrix4f m_image2Start;	///> starting position of image2
 	em::Matrix4f m_image1End;	///> finishing position of image1
 	em::Matrix4f m_image2End;	///> finishing position of image2
+	KeyframeTrack m_track1;		///> keyframes of image1
+	KeyframeTrack m_track2;		///> keyframes of image2
 	
 };
\ No newline at end of file
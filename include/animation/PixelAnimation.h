@@ -1,14 +1,46 @@
 #pragma once
 
+#include "../root/Graphics.h"
 #include "Animation.h"
+#include "../util/ThreadPool.h"
+#include "../util/MemoryBudget.h"
+#include "../util/PixelKernels.h"
 
 
+/**
+ * @brief Range [begin, end) of pixels, counted row by row from the top-left one
+ */
+struct PixelSpan
+{
+	std::size_t begin = 0u;	///> First pixel of the range
+	std::size_t end = 0u;	///> Pixel after the last one of the range
+
+	/**
+	 * @brief Checks whether the range holds no pixel
+	 *
+	 * @return True if empty
+	 */
+	bool isEmpty() const { return begin >= end; }
+};
+
+/**
+ * @brief Frame of an image computed on a range of pixels given by the caller
+ *
+ * Called with the source pixels, the destination (which may be the source), the
+ *   index of the first pixel of the range in the image and the amount of pixels.
+ */
+using PixelOperation = std::function<void(const std::uint8_t *src, std::uint8_t *dst, std::size_t first, std::size_t pixels)>;
+
 /**
  * @brief Base class of every animation based on transformations on pixels
  */
 class PixelAnimation : public Animation
 {
 public:
+	static constexpr unsigned PIXELS1 = 1u;///> Input of the plan: pixels of the first image
+	static constexpr unsigned PIXELS2 = 2u;///> Input of the plan: pixels of the second image
+	static constexpr unsigned ALL_PIXELS = PIXELS1 | PIXELS2;///> Every input of the plan, also given when the alpha mode changes
+
 	/**
 	 * Default constructor
 	 */
@@ -35,6 +67,9 @@ public:
 	 * @param animation_length 	Speed of animation
 	 * @param texture1_pixels 	Texture of first image
 	 * @param texture2_pixels 	Texture of second image
+	 *
+	 * The pixels are read back from the GPU, which stalls it. Prefer the constructor
+	 *   taking the decoded images whenever they are at hand.
 	 */
 	  explicit PixelAnimation(
         const float &animation_length,
@@ -42,19 +77,210 @@ public:
         const sf::Texture &texture1,
         const sf::Texture &texture2);
 
+	/**
+	 * @brief Constructor settings parameters of animation
+	 *
+	 * @param animation_length 	Length of animation
+	 * @param animation_speed 	Speed of animation
+	 * @param image1 			Decoded first image
+	 * @param image2 			Decoded second image
+	 */
+	explicit PixelAnimation(
+		const float &animation_length,
+		const float &animation_speed,
+		const sf::Image &image1,
+		const sf::Image &image2);
+
 	/**
 	 * @brief Destructor.
 	 */
 	virtual ~PixelAnimation() = default;
 
+	/**
+	 * @brief 		Calculations of proper pixel sequnces depending from given time
+	 *
+	 * @param 		current_time The current time
+	 * @param 		output Caller-owned buffer the frame of the first image is written to
+	 *
+	 * The buffer is resized to the size of the frame, so passing the same buffer
+	 *   every frame makes steady-state playback free of allocations. Every pixel
+	 *   of the source is read once and written once.
+	 */
+	virtual void writeTexture1Frame(const float &current_time, std::vector<unsigned char> &output) const = 0;
+
+	/**
+	 * @brief 		Calculations of proper pixel sequnces depending from given time
+	 *
+	 * @param 		current_time The current time
+	 * @param 		output Caller-owned buffer the frame of the second image is written to
+	 *
+	 * @see writeTexture1Frame
+	 */
+	virtual void writeTexture2Frame(const float &current_time, std::vector<unsigned char> &output) const = 0;
+
+	/**
+	 * @brief 		Finds the pixels of the first image which differ between frames at two times
+	 *
+	 * @param 		from_time Time of the frame already written
+	 * @param 		to_time Time of the next frame
+	 *
+	 * @return 		Range holding every changed pixel, empty if the frames are the same
+	 *
+	 * Lets the caller skip writing an unchanged frame and upload only the rows
+	 *   which changed. The base implementation reports the whole frame.
+	 */
+	virtual PixelSpan changedPixels1(const float &from_time, const float &to_time) const;
+
+	/**
+	 * @brief 		Finds the pixels of the second image which differ between frames at two times
+	 *
+	 * @param 		from_time Time of the frame already written
+	 * @param 		to_time Time of the next frame
+	 *
+	 * @return 		Range holding every changed pixel, empty if the frames are the same
+	 *
+	 * @see changedPixels1
+	 */
+	virtual PixelSpan changedPixels2(const float &from_time, const float &to_time) const;
+
+	/**
+	 * @brief 		Tells whether frames of both images differ from the images only in alpha
+	 *
+	 * @return 		True if the frames can be drawn as the original colors with alpha masks
+	 * 
+	 * Such animations are computed by writeAlpha1Mask and writeAlpha2Mask, which write
+	 *   and let the caller upload a quarter of the bytes of whole frames. The base
+	 *   implementation returns false.
+	 */
+	virtual bool hasAlphaMasks() const;
+
+	/**
+	 * @brief 		Writes alpha of the frame of the first image, one byte per pixel
+	 *
+	 * @param 		current_time The current time
+	 * @param 		output Caller-owned buffer, resized to the amount of pixels of the first image
+	 * 
+	 * The base implementation takes alpha of the frame written by writeTexture1Frame.
+	 */
+	virtual void writeAlpha1Mask(const float &current_time, std::vector<unsigned char> &output) const;
+
+	/**
+	 * @brief 		Writes alpha of the frame of the second image, one byte per pixel
+	 *
+	 * @param 		current_time The current time
+	 * @param 		output Caller-owned buffer, resized to the amount of pixels of the second image
+	 *
+	 * @see writeAlpha1Mask
+	 */
+	virtual void writeAlpha2Mask(const float &current_time, std::vector<unsigned char> &output) const;
+
+	/**
+	 * @brief 		Brings a frame of the first image written at one time to another time
+	 *
+	 * @param 		from_time Time the frame in the buffer was written at
+	 * @param 		to_time Time of the next frame
+	 * @param 		frame Buffer holding the frame written by writeTexture1Frame at from_time
+	 *
+	 * @return 		True if the frame was updated, false if it has to be written again
+	 *
+	 * Writes only the pixels reported by changedPixels1, or fewer, so frames changing
+	 *   a small part of the image cost the pixels they change instead of the whole
+	 *   image. Works both forward and backward in time. The base implementation
+	 *   returns false.
+	 */
+	virtual bool updateTexture1Frame(const float &from_time, const float &to_time, std::vector<unsigned char> &frame) const;
+
+	/**
+	 * @brief 		Brings a mask of the first image written at one time to another time
+	 *
+	 * @param 		from_time Time the mask in the buffer was written at
+	 * @param 		to_time Time of the next mask
+	 * @param 		mask Buffer holding the mask written by writeAlpha1Mask at from_time
+	 *
+	 * @return 		True if the mask was updated, false if it has to be written again
+	 *
+	 * @see updateTexture1Frame
+	 */
+	virtual bool updateAlpha1Mask(const float &from_time, const float &to_time, std::vector<unsigned char> &mask) const;
+
+	/**
+	 * @brief 		Writes the frames of both images in one sweep
+	 *
+	 * @param 		current_time The current time
+	 * @param 		output1 Caller-owned buffer the frame of the first image is written to
+	 * @param 		output2 Caller-owned buffer the frame of the second image is written to
+	 *
+	 * Writes the same frames as writeTexture1Frame and writeTexture2Frame. When the
+	 *   images have the same size and the animation has frame operations, every task
+	 *   of the pool takes a tile of both images at once, so the matching pixels of
+	 *   both sources, their frames and any per-pixel data share the cache instead of
+	 *   each image being streamed through it on its own. Otherwise both frames are
+	 *   written one after another.
+	 */
+	virtual void writeFrames(const float &current_time, std::vector<unsigned char> &output1, std::vector<unsigned char> &output2) const;
+
+	/**
+	 * @brief 		Gets the frame of the first image as an operation on any pixels
+	 *
+	 * @param 		current_time The current time
+	 *
+	 * @return 		Operation writing the frame from the pixels it is given, empty if the
+	 *   			animation can only compute frames of its own pixels
+	 *
+	 * Lets TransitionGraph run several animations over a range of pixels at once.
+	 *   Given the pixels of the first image, the operation writes the same frame as
+	 *   writeTexture1Frame. It is valid until the pixels of the animation change.
+	 *   The base implementation returns an empty operation.
+	 */
+	virtual PixelOperation frameOperation1(const float &current_time) const;
+
+	/**
+	 * @brief 		Gets the frame of the second image as an operation on any pixels
+	 *
+	 * @param 		current_time The current time
+	 *
+	 * @return 		Operation writing the frame from the pixels it is given, empty if there is none
+	 *
+	 * @see frameOperation1
+	 */
+	virtual PixelOperation frameOperation2(const float &current_time) const;
+
+	/**
+	 * @brief 		Tells whether the images are moved as well
+	 *
+	 * @return 		True if the images are placed by getImage1Transform and getImage2Transform,
+	 *   			the base implementation returns false
+	 */
+	virtual bool hasTransforms() const;
+
+	/**
+	 * @brief 		Transform the frame of the first image is drawn with
+	 *
+	 * @param 		current_time The current time
+	 *
+	 * @return 		The transform, identity in the base implementation
+	 */
+	virtual em::Matrix4f getImage1Transform(const float &current_time) const;
+
+	/**
+	 * @brief 		Transform the frame of the second image is drawn with
+	 *
+	 * @param 		current_time The current time
+	 *
+	 * @return 		The transform, identity in the base implementation
+	 */
+	virtual em::Matrix4f getImage2Transform(const float &current_time) const;
+
 	/**
 	 * @brief 		Calculations of proper pixel sequnces depending from given time
 	 *
 	 * @param 		current_time The current time
 	 *
 	 * @return 		frame that first image adopts
+	 * 
+	 * Convenience wrapper of writeTexture1Frame allocating a new buffer on every call.
 	 */
-	inline virtual const std::vector<unsigned char> getTexture1Frame(const float &current_time) const = 0;
+	const std::vector<unsigned char> getTexture1Frame(const float &current_time) const;
 	
 	/**
 	 * @brief 		Calculations of proper pixel sequnces depending from given time
@@ -62,39 +288,187 @@ public:
 	 * @param 		current_time The current time
 	 *
 	 * @return 		frame that second image adopts
+	 * 
+	 * Convenience wrapper of writeTexture2Frame allocating a new buffer on every call.
 	 */
-	inline virtual const std::vector<unsigned char> getTexture2Frame(const float &current_time) const = 0;
+	const std::vector<unsigned char> getTexture2Frame(const float &current_time) const;
 	
+	/**
+	 * @brief 		Computes pixels of both images at many times in one call
+	 *
+	 * @param 		times Times of the animation the frames are taken at
+	 * @param 		consumer Function receiving the frames with filled pixels
+	 * 
+	 * Several frames are computed at once on the shared thread pool, every one by
+	 *   writeFrames, so threads work on whole frames instead of meeting after every
+	 *   part of a frame. The frames are the same as the ones written by
+	 *   writeTexture1Frame and writeTexture2Frame.
+	 */
+	void sample(const std::vector<float> &times, const FrameConsumer &consumer) const override;
+
+	/**
+	 * @brief 		Getter of the GLSL fragment shader performing the animation on the GPU
+	 *
+	 * @return 		Source code of the shader, empty if the animation can only be computed on the CPU
+	 * 
+	 * The shader is run separately for both images and receives following uniforms:
+	 * - source   - texture of the image being drawn,
+	 * - other    - texture of the other image,
+	 * - layer    - 1 when the first image is drawn, 2 when the second one,
+	 * - progress - current time divided by total time of the animation, eased by its curve,
+	 *   and any uniforms set by setShaderParameters.
+	 */
+	virtual const std::string &getShaderSource() const;
+
+	/**
+	 * @brief 		Sets uniforms of the shader returned by getShaderSource
+	 *
+	 * @param 		shader The compiled shader
+	 * @param 		current_time The current time
+	 * 
+	 * Base implementation sets the progress uniform, textures and layer are set by the caller.
+	 */
+	virtual void setShaderParameters(sf::Shader &shader, const float &current_time) const;
+
 	/**
 	 * @brief 		Getter of the pixels of first image.
 	 *
 	 * @return 		vector of pixels of first image.
 	 */
-	std::vector<unsigned char> getPixels1() const;
+	const std::vector<unsigned char> &getPixels1() const;
 	
 	/**
 	 * @brief 		Getter of the pixels of second image.
 	 *
 	 * @return 		vector of pixels of second image.
 	 */
-	std::vector<unsigned char> getPixels2() const;
+	const std::vector<unsigned char> &getPixels2() const;
+
+	/**
+	 * @brief 		Copies pixels of the decoded image in the layout animations work on
+	 *
+	 * @param image 	The image
+	 *
+	 * @return 		RGBA values of the image, row by row
+	 */
+	static std::vector<unsigned char> toPixels(const sf::Image &image);
 
 	/**
 	 * @brief 		Setter of the first image.
 	 *
-	 * @param texture1_pixels 	vector of pixels
+	 * @param texture1_pixels 	vector of pixels, moved into the animation
 	 */
 	void setPixels1(std::vector<unsigned char> texture1_pixels);
 	
 	/**
 	 * @brief 		Setter of the second image.
 	 *
-	 * @param texture1_pixels 	vector of pixels
+	 * @param texture2_pixels 	vector of pixels, moved into the animation
 	 */
 	void setPixels2(std::vector<unsigned char> texture2_pixels);
 
+	/**
+	 * @brief 		Moves the pixels and the alpha mode of another animation into this one
+	 *
+	 * @param source 	Animation left without pixels
+	 *
+	 * Plans once for both images, instead of once for every setter, and copies no pixel.
+	 *   Lets the canvas change the animation of images it already holds.
+	 */
+	void takePixels(PixelAnimation &source);
+
+	/**
+	 * @brief 		Tells the animation whether its pixels have premultiplied alpha
+	 *
+	 * @param premultiplied 	True if r, g and b of the pixels are already multiplied by alpha
+	 * 
+	 * Frames are then written premultiplied as well, showing the same picture when
+	 *   blended as premultiplied. Pixels are not converted, set them in the matching layout.
+	 *   Shaders returned by getShaderSource always work on straight alpha.
+	 */
+	void setPremultiplied(const bool premultiplied);
+
+	/**
+	 * @brief 		Tells whether the pixels have premultiplied alpha
+	 *
+	 * @return 		True if they have
+	 */
+	bool isPremultiplied() const;
+
+	/**
+	 * @brief 		Precomputes whatever the frames of the animation read besides the pixels
+	 * 
+	 * Run by the setters of the pixels and the alpha mode, so frames only execute the
+	 *   plan: the luminance order of ByBrightnessAnimation, the alpha planes of
+	 *   AlfaAnimation. Public so the plan can be rebuilt and measured on its own.
+	 *
+	 * @param changed 	Inputs replaced since the last plan, PIXELS1, PIXELS2 or both
+	 */
+	void plan(const unsigned changed = PixelAnimation::ALL_PIXELS);
+
+	/**
+	 * @brief 		Getter to the memory of the plan
+	 *
+	 * @return 		Bytes precomputed from the pixels, 0 in the base implementation
+	 */
+	virtual std::size_t getPlanBytes() const;
+
+	/**
+	 * @brief Hash of the length, the speed and the alpha mode
+	 *
+	 * @return The hash
+	 */
+	std::uint64_t getParameterHash() const override;
+
 	protected:
+	/**
+	 * @brief 		Builds the plan, called by plan after pixels of any of the images are replaced
+	 * 
+	 * Lets the derived animations refresh whatever they precompute from the pixels.
+	 *   Only what depends on the changed inputs has to be rebuilt, the rest of the
+	 *   plan was built for the same pixels. Constructors of derived classes have to
+	 *   call plan themselves.
+	 *
+	 * @param 		changed Inputs replaced since the last plan, ALL_PIXELS when the alpha mode changed
+	 */
+	virtual void pixelsChanged(const unsigned changed);
+
+	/**
+	 * @brief 		Runs the body over ranges of pixels on the shared thread pool
+	 *
+	 * @param 		pixels Amount of pixels
+	 * @param 		body Function called with [begin, end) range of pixels
+	 * 
+	 * Ranges have fixed size independent of the amount of threads, so as long as
+	 *   the body writes only pixels of its own range, the frame is always the same.
+	 */
+	static void forEachPixelRange(const std::size_t pixels, const std::function<void(std::size_t, std::size_t)> &body);
+
+	/**
+	 * @brief 		Operation copying the pixels unchanged
+	 *
+	 * @return 		The operation, for images the animation does not change
+	 */
+	static PixelOperation copyOperation();
+
+	/**
+	 * @brief 		Adapts factors meant for straight alpha to the layout of the pixels
+	 *
+	 * @param 		factors Factors scaling straight-alpha pixels
+	 *
+	 * @return 		The same factors, or their premultiplied counterpart for premultiplied pixels
+	 */
+	pk::ChannelFactors frameFactors(const pk::ChannelFactors &factors) const;
+
+	static constexpr std::size_t PIXEL_RANGE = 16384u;///> Pixels processed by one task, multiple of the widest SIMD step
+	static constexpr std::size_t SAMPLE_BUDGET = 64u * 1024u * 1024u;///> Bytes of frames sample computes at once at most
+
 	std::vector<unsigned char> m_pixels1;
 	std::vector<unsigned char> m_pixels2;
-	
+	MemoryCharge m_pixelsCharge;///> Memory of both pixel vectors and the plan accounted to the animations
+	bool m_premultiplied;///> Whether the pixels and so the frames have premultiplied alpha
+
+	private:
+	void accountPixels();///> Brings the charge to the current capacity of the pixel vectors and the plan
+
 };
\ No newline at end of file
@@ -44,13 +44,15 @@ class RingAnimation : public ObjectAnimation
 	 */
 	inline const em::Matrix4f getImage1Frame(const float &current_time) const override
 	{	
-		em::Matrix4f temp = m_image1Start;
-		temp.translate(sf::Vector3f(
-			1150.f*cos(current_time/m_totalTime)*(1.14*current_time/m_totalTime),
-			340.f*cos(current_time/m_totalTime)*(current_time/m_totalTime),
-			((current_time < m_totalTime/2) ? -1.f : 1.f * (current_time/m_totalTime))));
-		temp.scale(sf::Vector3f(1.f *(1 - current_time/m_totalTime), 1.f*(1 - current_time/m_totalTime), 1.f));
-		return temp;
+		//paths along cosines are not keyframes, components are computed and composed directly
+		const float progress = this->toProgress(current_time);
+		TransformComponents components;
+		components.translation = sf::Vector3f(
+			1150.f*1.14f*COSINE_PATH(progress),
+			340.f*COSINE_PATH(progress),
+			((progress < 0.5f) ? -1.f : 1.f * progress));
+		components.scale = sf::Vector3f(1.f - progress, 1.f - progress, 1.f);
+		return KeyframeTrack::compose(components, m_image1Start);
 	}
 	/**
 	 * @brief      Performs transformations on the second image
@@ -61,12 +63,29 @@ class RingAnimation : public ObjectAnimation
 	 */
 	inline const em::Matrix4f getImage2Frame(const float &current_time) const override
 	{
-		em::Matrix4f temp = m_image2Start;
-		temp.translate(sf::Vector3<float>(480.f-1150.f*current_time/m_totalTime*cos(1.14*current_time/m_totalTime), 340.f-630.f*current_time/m_totalTime*cos(current_time/m_totalTime), 0.f));
-		temp.scale(sf::Vector3<float>(1.f * current_time/m_totalTime, 1.f* current_time/m_totalTime, 0.5f));
-		return temp;
+		const float progress = this->toProgress(current_time);
+		TransformComponents components;
+		components.translation = sf::Vector3f(
+			480.f-1150.f*WIDE_COSINE_PATH(progress),
+			340.f-630.f*COSINE_PATH(progress),
+			0.f);
+		components.scale = sf::Vector3f(progress, progress, 0.5f);
+		return KeyframeTrack::compose(components, m_image2Start);
+	}
+
+	/**
+	 * @brief      Paths of the images are not keyframes
+	 *
+	 * @return     False
+	 */
+	inline bool isKeyframed() const override
+	{
+		return false;
 	}
 
 	protected:
 
+	private:
+	static const SampledCurve COSINE_PATH;		///> progress*cos(progress), sampled instead of computed every frame
+	static const SampledCurve WIDE_COSINE_PATH;	///> progress*cos(1.14*progress)
 };
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "KeyframeTrack.h"
+
+/**
+ * @brief Function of the progress of an animation, sampled into a table once
+ *
+ * The function is evaluated at evenly spaced progress when the curve is built
+ *   or resampled, frames only interpolate between neighboring samples, so curves
+ *   of trigonometric or iterative functions cost the same per frame as linear
+ *   ones. Animations ease their progress by such a curve and resample it for
+ *   their length, so even long animations place every frame precisely.
+ *
+ * Values of easing curves start at 0 and end at 1 but may leave that range in
+ *   between, like springs shooting over their end. Keyframe tracks hold their
+ *   first and last keyframe outside it.
+ */
+class SampledCurve
+{
+public:
+	using Function = std::function<float(const float &)>;
+
+	static constexpr std::size_t MIN_SAMPLES = 256u;			///> Samples of the curves of the shortest animations
+	static constexpr std::size_t MAX_SAMPLES = 16384u;			///> Samples of the curves of the longest animations
+	static constexpr float SAMPLES_PER_SECOND = 960.f;			///> Samples per second of an animation, several for every frame of a 240 Hz display
+
+	/**
+	 * @brief Default constructor of the linear curve, progress is left unchanged
+	 */
+	SampledCurve();
+
+	/**
+	 * @brief Constructor sampling a function
+	 *
+	 * @param function Function of the progress from 0 to 1
+	 * @param samples Amount of samples, at least 2
+	 */
+	explicit SampledCurve(Function function, const std::size_t samples = MIN_SAMPLES);
+
+	/**
+	 * @brief Curve following an easing of keyframes
+	 *
+	 * @param easing The easing
+	 *
+	 * @return The curve
+	 */
+	static SampledCurve fromEasing(const Easing easing);
+
+	/**
+	 * @brief Cubic Bezier curve from (0, 0) to (1, 1), like the timing functions of CSS
+	 *
+	 * @param x1 Progress of the first control point, from 0 to 1
+	 * @param y1 Value of the first control point
+	 * @param x2 Progress of the second control point, from 0 to 1
+	 * @param y2 Value of the second control point
+	 *
+	 * @return The curve
+	 *
+	 * Throws std::invalid_argument if the progress of a control point is outside of 0 to 1.
+	 */
+	static SampledCurve cubicBezier(const float &x1, const float &y1, const float &x2, const float &y2);
+
+	/**
+	 * @brief Damped spring released towards 1, shooting over it and settling at the end
+	 *
+	 * @param damping Damping ratio, from 0 exclusive (swinging long) to 1 exclusive (hardly any overshoot)
+	 * @param oscillations Amount of swings during the animation
+	 *
+	 * @return The curve
+	 *
+	 * Throws std::invalid_argument if the damping or the oscillations are out of range.
+	 */
+	static SampledCurve spring(const float &damping = 0.4f, const float &oscillations = 2.f);
+
+	/**
+	 * @brief Parses a curve by its name
+	 *
+	 * @param name linear, ease-in, ease-out, ease-in-out, spring, or bezier:x1,y1,x2,y2
+	 *
+	 * @return The curve
+	 *
+	 * Throws std::invalid_argument for unknown names.
+	 */
+	static SampledCurve fromName(const std::string &name);
+
+	/**
+	 * @brief Amount of samples of the curve of an animation
+	 *
+	 * @param seconds Length of the animation
+	 *
+	 * @return SAMPLES_PER_SECOND of the length, clamped from MIN_SAMPLES to MAX_SAMPLES
+	 */
+	static std::size_t samplesFor(const float &seconds);
+
+	/**
+	 * @brief Evaluates the function again into a table of another amount of samples
+	 *
+	 * @param samples Amount of samples, at least 2
+	 */
+	void resample(const std::size_t samples);
+
+	/**
+	 * @brief Getter to the amount of samples
+	 *
+	 * @return The amount of samples
+	 */
+	std::size_t getSampleCount() const;
+
+	/**
+	 * @brief Value of the curve interpolated from its samples
+	 *
+	 * @param progress Progress from 0 to 1, clamped
+	 *
+	 * @return The value
+	 */
+	inline float operator()(const float &progress) const
+	{
+		const float position = std::clamp(progress, 0.f, 1.f) * m_scale;
+		const std::size_t index = std::min(static_cast<std::size_t>(position), m_samples.size() - 2u);
+		const float fraction = position - static_cast<float>(index);
+		return m_samples[index] + (m_samples[index + 1u] - m_samples[index]) * fraction;
+	}
+
+	/**
+	 * @brief Hash of the samples
+	 *
+	 * @return The hash, the same for curves of the same samples
+	 */
+	std::uint64_t getHash() const;
+
+private:
+	Function m_function;			///> Function the samples are taken from
+	std::vector<float> m_samples;	///> Values at evenly spaced progress, the first at 0 and the last at 1
+	float m_scale;					///> Samples per unit of progress, one less than their amount
+};
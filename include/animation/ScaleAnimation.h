@@ -33,38 +33,10 @@ class ScaleAnimation : public ObjectAnimation
 	 * @brief      Default destructor
 	 */
 	~ScaleAnimation() = default;
+	private:
 	/**
-	 * @brief      Performs transformations on the first image
-	 *
-	 * @param[in]  current_time  The current time animation
-	 *
-	 * @return     The image 1 frame.
-	 */
-	inline const em::Matrix4f getImage1Frame(const float &current_time) const override
-	{	
-		em::Matrix4f temp = m_image1Start;
-		temp.translate(sf::Vector3<float>(0.f, 0.f, 1.f*(current_time/m_totalTime) ));
-		return temp;
-	}
-
-	/**
-	 * @brief      Performs transformations on the second image
-	 *
-	 * @param[in]  current_time  The current time of animation
-	 *
-	 * @return     The image 2 frame.
+	 * @brief      Fills keyframe tracks of both images
 	 */
-	inline const em::Matrix4f getImage2Frame(const float &current_time) const override
-	{
-		em::Matrix4f temp = m_image2Start;
-		temp.translate(sf::Vector3<float>
-			(480.f-480.f*current_time/m_totalTime,
-			340.f-340.f*current_time/m_totalTime,
-			0.f));
-		temp.scale(sf::Vector3<float>(1.f * current_time/m_totalTime, 1.f* current_time/m_totalTime, 1.f*current_time));
-		return temp;
-	}
-
-	protected:
+	void buildTracks();
 
 };
\ No newline at end of file
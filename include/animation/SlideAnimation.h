@@ -34,31 +34,10 @@ class SlideAnimation : public ObjectAnimation
      * @brief      default destructor
      */
     ~SlideAnimation() = default;
+    private:
     /**
-     * @brief      Performs transformations on the first image
-     *
-     * @param[in]  current_time  The current time animation
-     *
-     * @return     The image 1 frame.
-     */
-    inline const em::Matrix4f getImage1Frame(const float &current_time) const override
-    {
-        em::Matrix4f temp = m_image1Start;
-        temp.translate( sf::Vector3f( 960.f*(current_time/m_totalTime) , 0.f, 0.f) );
-        return temp;
-    }
-    /**
-     * @brief      Performs transformations on the second image
-     *
-     * @param[in]  current_time  The current time of animation
-     *
-     * @return     The image 2 frame.
+     * @brief      Fills keyframe tracks of both images
      */
-    inline const em::Matrix4f getImage2Frame(const float &current_time) const override
-    {
-        em::Matrix4f temp = m_image1Start;
-        temp.translate( sf::Vector3f( - 960.f*(1 - current_time/m_totalTime), 0, 0) );
-        return temp;
-    }
+    void buildTracks();
 
 };
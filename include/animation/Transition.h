@@ -0,0 +1,166 @@
+#pragma once
+
+#include "TransitionGraph.h"
+#include "../gui/AnimatedImage.h"
+
+/**
+ * @brief Transition between two images rendered frame by frame, without any window or GUI
+ *
+ * Entry point of the transitions library, which holds the animations, the images
+ *   they are drawn on and the matrix math, but no widgets, dialogs or settings of
+ *   the application. Frames are evenly spaced over the length of the animation,
+ *   the first one shows the start of the transition and the last one its end.
+ *
+ * Frames look like the ones the application draws without shaders: both images
+ *   cover the whole frame over opaque black, object animations draw the deeper image
+ *   first and pixel animations the second image first. Transforms are in pixels of
+ *   the frame and projected orthographically.
+ *
+ * Rendering never changes the transition and every call keeps its working state to
+ *   itself, so any amount of threads may render frames of one transition at once.
+ */
+class Transition
+{
+public:
+	/**
+	 * @brief Constructor of a transition moving the images
+	 *
+	 * @param animation The animation
+	 * @param image1 The starting image
+	 * @param image2 The ending image, of the same size
+	 * @param frames Amount of frames, at least 1
+	 * @param seconds Length the animation is set to
+	 *
+	 * Throws std::invalid_argument if the images are empty or differ in size, or if there are no frames.
+	 */
+	Transition(std::unique_ptr<ObjectAnimation> animation, const sf::Image &image1, const sf::Image &image2, const unsigned frames, const float &seconds = 1.f);
+
+	/**
+	 * @brief Constructor of a transition changing the pixels of the images
+	 *
+	 * @param animation The animation, its pixels are replaced by the ones of the images
+	 * @param image1 The starting image
+	 * @param image2 The ending image, of the same size
+	 * @param frames Amount of frames, at least 1
+	 * @param seconds Length the animation is set to
+	 *
+	 * Throws std::invalid_argument if the images are empty or differ in size, or if there are no frames.
+	 */
+	Transition(std::unique_ptr<PixelAnimation> animation, const sf::Image &image1, const sf::Image &image2, const unsigned frames, const float &seconds = 1.f);
+
+	/**
+	 * @brief Constructor of a transition by any animation of the application
+	 *
+	 * @param animation The animation
+	 * @param image1 The starting image
+	 * @param image2 The ending image, of the same size
+	 * @param frames Amount of frames, at least 1
+	 * @param seconds Length the animation is set to
+	 */
+	Transition(AnyAnimation animation, const sf::Image &image1, const sf::Image &image2, const unsigned frames, const float &seconds = 1.f);
+
+	Transition(const Transition &) = delete;
+	Transition &operator=(const Transition &) = delete;
+
+	/**
+	 * @brief Creates a transition by the name of its animation
+	 *
+	 * @param name Name of an animation, or animations combined by '+' and '>' like in TransitionGraph::parse
+	 * @param image1 The starting image
+	 * @param image2 The ending image, of the same size
+	 * @param frames Amount of frames, at least 1
+	 * @param seconds Length the animation is set to
+	 *
+	 * @return The transition
+	 *
+	 * Throws std::invalid_argument for unknown names.
+	 */
+	static std::unique_ptr<Transition> fromName(const std::string &name, const sf::Image &image1, const sf::Image &image2, const unsigned frames, const float &seconds = 1.f);
+
+	/**
+	 * @brief Getter to the amount of frames
+	 *
+	 * @return The amount of frames
+	 */
+	unsigned getFrameCount() const;
+
+	/**
+	 * @brief Getter to the size of the frames
+	 *
+	 * @return The size of the images
+	 */
+	const sf::Vector2u &getSize() const;
+
+	/**
+	 * @brief Getter to the size of the buffer a frame is rendered into
+	 *
+	 * @return Bytes of a frame of RGBA pixels
+	 */
+	std::size_t getFrameBytes() const;
+
+	/**
+	 * @brief Time of the animation shown by a frame
+	 *
+	 * @param index Index of the frame
+	 *
+	 * @return Time in seconds
+	 *
+	 * Throws std::out_of_range if there is no frame of the index.
+	 */
+	float timeOf(const unsigned index) const;
+
+	/**
+	 * @brief Getter to the animation
+	 *
+	 * @return The animation
+	 */
+	const Animation &getAnimation() const;
+
+	/**
+	 * @brief Getter to the animation, to change its easing or speed
+	 *
+	 * @return The animation
+	 *
+	 * The animation must not be changed while frames are rendered.
+	 */
+	Animation &getAnimation();
+
+	/**
+	 * @brief Renders a frame on the CPU
+	 *
+	 * @param index Index of the frame
+	 * @param output Caller-owned buffer of getFrameBytes bytes the RGBA pixels are written to, row by row
+	 *
+	 * Needs no graphics context. Throws std::out_of_range if there is no frame of the index.
+	 */
+	void renderFrame(const unsigned index, std::uint8_t *output) const;
+
+	/**
+	 * @brief Draws a frame onto a render target
+	 *
+	 * @param index Index of the frame
+	 * @param target The target, the frame is drawn at its origin over what it holds
+	 *
+	 * The target has to be active on the calling thread. Textures of the images are
+	 *   uploaded by the first call and shared by all following ones, frames of pixel
+	 *   animations are computed on the CPU and uploaded by every call.
+	 *   Throws std::out_of_range if there is no frame of the index.
+	 */
+	void renderFrame(const unsigned index, sf::RenderTarget &target) const;
+
+private:
+	Transition(const sf::Image &image1, const sf::Image &image2, const unsigned frames);///> Checks and keeps the images
+	void setAnimation(std::unique_ptr<ObjectAnimation> animation, const float &seconds);///> Keeps the animation and sets its length
+	void setAnimation(std::unique_ptr<PixelAnimation> animation, const float &seconds);///> Keeps the animation, sets its length and gives it the pixels of the images
+	void createTextures() const;///> Uploads the images for object animations, once
+
+	std::unique_ptr<ObjectAnimation> m_objectAnimation;///> The animation moving the images, nullptr for pixel animations
+	std::unique_ptr<PixelAnimation> m_pixelAnimation;///> The animation changing the pixels, nullptr for object animations
+	sf::Image m_image1;///> The starting image
+	sf::Image m_image2;///> The ending image
+	sf::Vector2u m_size;///> Size of the images and the frames
+	unsigned m_frames;///> Amount of frames
+	mutable std::once_flag m_texturesCreated;///> Guards the upload of the images by the first thread drawing onto a target
+	mutable ImageStore::Handle m_stored1;///> Texture of the starting image, shared by the images drawn by all threads
+	mutable ImageStore::Handle m_stored2;///> Texture of the ending image
+};
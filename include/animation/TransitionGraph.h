@@ -0,0 +1,193 @@
+#pragma once
+
+#include "AnimationRegistry.h"
+
+/**
+ * @brief Transition combining several animations, like a slide with a fade
+ *
+ * Every stage is an animation playing during its own part of the transition,
+ *   given as progress of the transition from 0 to 1. Before its part a stage
+ *   shows its first frame, after it its last one, so stages placed one after
+ *   another chain and stages sharing a part are layered.
+ *
+ * Pixel stages change the pixels of the images, in the order they were added:
+ *   every range of pixels goes through all of them while it stays in the cache,
+ *   so the frame is written in one pass over memory however many stages there
+ *   are. Object stages move the images, their transforms are multiplied in the
+ *   order they were added and the Canvas draws the pixel frames with them.
+ *
+ * The graph is computed on the CPU, shaders of its stages are not used.
+ */
+class TransitionGraph : public PixelAnimation
+{
+public:
+	/**
+	 * @brief Default constructor of a graph without stages
+	 */
+	TransitionGraph();
+
+	/**
+	 * @brief Constructor setting the length of a graph without stages
+	 *
+	 * @param animation_length Length of the whole transition
+	 */
+	explicit TransitionGraph(const float &animation_length);
+
+	/**
+	 * @brief Adds an animation moving the images
+	 *
+	 * @param stage The animation, its length is fitted to its part
+	 * @param begin Progress of the transition the stage starts at
+	 * @param end Progress of the transition the stage ends at
+	 *
+	 * Throws std::invalid_argument if the part is not within 0 to 1 or is empty.
+	 */
+	void addStage(std::unique_ptr<ObjectAnimation> stage, const float &begin = 0.f, const float &end = 1.f);
+
+	/**
+	 * @brief Adds an animation changing the pixels of the images
+	 *
+	 * @param stage The animation, its length is fitted to its part
+	 * @param begin Progress of the transition the stage starts at
+	 * @param end Progress of the transition the stage ends at
+	 *
+	 * Throws std::invalid_argument if the part is not within 0 to 1 or is empty,
+	 *   or if the animation has no frame operations for both images.
+	 */
+	void addStage(std::unique_ptr<PixelAnimation> stage, const float &begin = 0.f, const float &end = 1.f);
+
+	/**
+	 * @brief Adds any animation of the application
+	 *
+	 * @param stage The animation
+	 * @param begin Progress of the transition the stage starts at
+	 * @param end Progress of the transition the stage ends at
+	 */
+	void addStage(AnyAnimation stage, const float &begin = 0.f, const float &end = 1.f);
+
+	/**
+	 * @brief Builds a graph from names of animations
+	 *
+	 * @param description Groups of names separated by '>', which follow each other with an equal part
+	 *   of the transition each; names within a group are separated by '+' and layered, e.g. "slide+alfa>ring"
+	 * @param setup Optional change of the parameters of every animation before it is added
+	 *
+	 * @return The graph
+	 *
+	 * Throws std::invalid_argument for unknown names or empty groups.
+	 */
+	static std::unique_ptr<TransitionGraph> parse(const std::string &description, const std::function<void(AnyAnimation &)> &setup = nullptr);
+
+	/**
+	 * @brief Checks whether a name describes a graph rather than one animation
+	 *
+	 * @param name The name
+	 *
+	 * @return True if the name combines animations with '+' or '>'
+	 */
+	static bool isDescription(const std::string &name);
+
+	/**
+	 * @brief Getter to the amount of stages
+	 *
+	 * @return The amount of object and pixel stages
+	 */
+	std::size_t getStageCount() const;
+
+	/**
+	 * @brief Sets the length of the transition, fitting the stages to their parts
+	 *
+	 * @param seconds Time in seconds
+	 */
+	void setAnimationLength(const float &seconds) override;
+
+	/**
+	 * @brief Writes the frame of the first image, all pixel stages in one pass
+	 *
+	 * @param current_time The current time
+	 * @param output The buffer the frame is written to
+	 */
+	void writeTexture1Frame(const float &current_time, std::vector<unsigned char> &output) const override;
+
+	/**
+	 * @brief Writes the frame of the second image, all pixel stages in one pass
+	 *
+	 * @param current_time The current time
+	 * @param output The buffer the frame is written to
+	 */
+	void writeTexture2Frame(const float &current_time, std::vector<unsigned char> &output) const override;
+
+	/**
+	 * @brief Gets the frame of the first image as an operation running every pixel stage
+	 *
+	 * @param current_time The current time
+	 *
+	 * @return The operation, so graphs may be stages of other graphs
+	 */
+	PixelOperation frameOperation1(const float &current_time) const override;
+
+	/**
+	 * @brief Gets the frame of the second image as an operation running every pixel stage
+	 *
+	 * @param current_time The current time
+	 *
+	 * @return The operation
+	 */
+	PixelOperation frameOperation2(const float &current_time) const override;
+
+	/**
+	 * @brief Tells whether the images are moved
+	 *
+	 * @return True if there is an object stage
+	 */
+	bool hasTransforms() const override;
+
+	/**
+	 * @brief Transform of the first image
+	 *
+	 * @param current_time The current time
+	 *
+	 * @return Product of the transforms of the first image of all object stages
+	 */
+	em::Matrix4f getImage1Transform(const float &current_time) const override;
+
+	/**
+	 * @brief Transform of the second image
+	 *
+	 * @param current_time The current time
+	 *
+	 * @return Product of the transforms of the second image of all object stages
+	 */
+	em::Matrix4f getImage2Transform(const float &current_time) const override;
+
+	/**
+	 * @brief Hash of the length, the stages and their parts
+	 *
+	 * @return The hash
+	 */
+	std::uint64_t getParameterHash() const override;
+
+protected:
+	/**
+	 * @brief Gives the pixels and their alpha mode to every pixel stage
+	 */
+	void pixelsChanged(const unsigned changed) override;
+
+private:
+	template <typename T>
+	struct Stage
+	{
+		std::unique_ptr<T> animation;	///> The animation
+		float begin;					///> Progress of the transition the stage starts at
+		float end;						///> Progress of the transition the stage ends at
+	};
+
+	static void checkPart(const float &begin, const float &end);///> Throws if the part of a stage is not within the transition
+	void fitLength(Animation &stage, const float &begin, const float &end) const;///> Sets the length of the stage to its part of the transition
+	float stageTime(const Animation &stage, const float &begin, const float &end, const float &current_time) const;///> Time of the stage at the time of the transition
+	PixelOperation chain(const float &current_time, const bool first) const;///> Operation running the operations of all pixel stages on one image
+	void writeFrame(const std::vector<unsigned char> &pixels, const PixelOperation &operation, std::vector<unsigned char> &output) const;///> Runs the operation over the pixels, range by range
+
+	std::vector<Stage<ObjectAnimation>> m_objectStages;///> Stages moving the images
+	std::vector<Stage<PixelAnimation>> m_pixelStages;///> Stages changing the pixels, in order they are run
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "FrameSink.h"
+
+#include <cstdio>
+
+/**
+ * @brief Sink piping raw frames to an ffmpeg process encoding them into a video
+ *
+ * Frames are written to the standard input of ffmpeg as raw RGBA, so the video
+ *   is encoded while the animation is rendered and no intermediate files exist.
+ *   The ffmpeg executable has to be available in PATH.
+ */
+class FfmpegSink : public FrameSink
+{
+public:
+	/**
+	 * @brief Constructor storing the settings, ffmpeg is started with the first frame
+	 *
+	 * @param path The path of the video, its extension selects the container
+	 * @param fps Frames per second of the animation
+	 * @param codec Codec arguments given to ffmpeg
+	 * 
+	 * By default H.264 is used, frames of odd size are padded to even one it requires.
+	 */
+	explicit FfmpegSink(
+		const std::string &path,
+		const float &fps,
+		const std::string &codec = "-vf pad=ceil(iw/2)*2:ceil(ih/2)*2 -c:v libx264 -preset medium -crf 18 -pix_fmt yuv420p");
+
+	/**
+	 * @brief Destructor closing the pipe if it was not closed
+	 */
+	~FfmpegSink();
+
+	/**
+	 * @brief Checks whether ffmpeg can be started
+	 *
+	 * @return True if ffmpeg is found in PATH, false otherwise
+	 */
+	static bool isAvailable();
+
+	/**
+	 * @brief Writes the frame to ffmpeg
+	 *
+	 * @param frame The frame, all frames have to be of the size of the first one
+	 */
+	void write(ExportFrame frame) override;
+
+	/**
+	 * @brief Closes the pipe and waits for ffmpeg to finish the video
+	 */
+	void close() override;
+
+private:
+	void open(const sf::Vector2u &size);///> Starts ffmpeg for frames of given size
+
+	std::string m_path;///> The path of the video
+	float m_fps;///> Frames per second
+	std::string m_codec;///> Codec arguments
+	sf::Vector2u m_size;///> Size of the frames
+	std::FILE *m_pipe;///> Standard input of ffmpeg
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "FrameSink.h"
+
+#include <deque>
+
+/**
+ * @brief Saves frames of the animation to files on background threads
+ *
+ * Frames pushed by the rendering thread wait in a bounded queue until one of
+ *   the encoder threads saves them, so encoding of the frame overlaps with
+ *   rendering of the next ones. When the queue is full, push blocks, which
+ *   keeps memory taken by waiting frames bounded.
+ */
+class FrameExporter
+{
+public:
+	/**
+	 * @brief Constructor starting the encoder threads
+	 *
+	 * @param threads Amount of encoder threads, 0 picks one less than the amount of cores
+	 * @param capacity Maximal amount of frames waiting in the queue
+	 */
+	explicit FrameExporter(const unsigned threads = 0u, const std::size_t capacity = 8u);
+
+	FrameExporter(const FrameExporter &) = delete;
+	FrameExporter &operator=(const FrameExporter &) = delete;
+
+	/**
+	 * @brief Destructor waiting for all queued frames to be saved
+	 */
+	~FrameExporter();
+
+	/**
+	 * @brief Queues the frame to be saved
+	 *
+	 * @param frame The frame, ownership is passed to the exporter
+	 * @param path The path of the file, its extension selects the format
+	 *
+	 * Blocks while the queue is full.
+	 */
+	void push(ExportFrame frame, const std::string &path);
+
+	/**
+	 * @brief Waits until all queued frames are saved and stops the encoder threads
+	 *
+	 * Throws std::runtime_error if any of the frames could not be saved.
+	 *   No frame can be pushed afterwards.
+	 */
+	void finish();
+
+	/**
+	 * @brief Getter to the amount of frames already saved
+	 *
+	 * @return The amount of saved frames
+	 */
+	std::size_t getSavedCount() const;
+
+private:
+	struct Job
+	{
+		ExportFrame frame;///> The frame to save
+		std::string path;///> The file the frame is saved to
+		MemoryCharge memory = MemoryCharge(MemorySubsystem::EXPORT);///> The frame accounted to the export until it is saved
+	};
+
+	void work();///> Loop of an encoder thread
+
+	std::deque<Job> m_queue;///> Frames waiting for an encoder
+	std::size_t m_capacity;///> Maximal amount of waiting frames
+	std::vector<std::thread> m_workers;///> Encoder threads
+	std::mutex m_mutex;///> Guards the queue, the closing flag and the error
+	std::condition_variable m_notEmpty;///> Signals encoders about a new frame or closing
+	std::condition_variable m_notFull;///> Signals the producer about room in the queue
+	bool m_closing;///> Flag telling the encoders to stop once the queue is empty
+	std::atomic<std::size_t> m_saved;///> Amount of saved frames
+	std::string m_error;///> Paths of frames which could not be saved
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../util/BufferPool.h"
+
+/**
+ * @brief Exported frame of the animation
+ *
+ * The pixels come from the buffer pool of the renderer and go back to it
+ *   as soon as the sink drops the frame.
+ */
+struct ExportFrame
+{
+	sf::Vector2u size;///> Size of the frame in pixels
+	BufferPool::Buffer pixels;///> RGBA pixels, rows from the top, 4 bytes per pixel
+
+	/**
+	 * @brief Getter to the pixels
+	 *
+	 * @return Pointer to the first byte of the top-left pixel
+	 */
+	const std::uint8_t *data() const { return pixels->data(); }
+};
+
+/**
+ * @brief Base class of every destination the exported frames are written to
+ *
+ * Frames are passed in the order of the animation. The sink may write them
+ *   right away or on its own threads, but the output is complete only after
+ *   close returns.
+ */
+class FrameSink
+{
+public:
+	/**
+	 * @brief Destructor
+	 */
+	virtual ~FrameSink() = default;
+
+	/**
+	 * @brief Passes the next frame of the animation to the sink
+	 *
+	 * @param frame The frame, ownership is passed to the sink
+	 *
+	 * Throws std::runtime_error if the frame cannot be written.
+	 */
+	virtual void write(ExportFrame frame) = 0;
+
+	/**
+	 * @brief Finishes the output
+	 *
+	 * Throws std::runtime_error if any part of the output could not be written.
+	 */
+	virtual void close() = 0;
+};
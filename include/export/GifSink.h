@@ -0,0 +1,60 @@
+#pragma once
+
+#include "FrameSink.h"
+
+#include <fstream>
+
+/**
+ * @brief Sink streaming the frames into a single looping animated GIF
+ *
+ * Every frame is quantized with ordered dithering to a fixed 6x7x6 color cube,
+ *   LZW compressed and appended to the file right away, so no intermediate
+ *   files are written and only one frame is held in memory.
+ */
+class GifSink : public FrameSink
+{
+public:
+	/**
+	 * @brief Constructor opening the file
+	 *
+	 * @param path The path of the GIF file
+	 * @param fps Frames per second of the animation
+	 *
+	 * GIF stores delays in hundredths of a second, so the delay of every frame is
+	 *   rounded, carrying the error over to the next frames.
+	 */
+	explicit GifSink(const std::string &path, const float &fps);
+
+	/**
+	 * @brief Destructor finishing the file if it was not closed
+	 */
+	~GifSink();
+
+	/**
+	 * @brief Appends the frame to the file
+	 *
+	 * @param frame The frame, all frames have to be of the size of the first one
+	 */
+	void write(ExportFrame frame) override;
+
+	/**
+	 * @brief Writes the trailer and closes the file
+	 */
+	void close() override;
+
+private:
+	void writeHeader(const sf::Vector2u &size);///> Writes the header, the palette and the looping extension
+	void quantize(const ExportFrame &frame);///> Maps the pixels of the frame to indices of the palette
+	void writeLzw();///> Writes the indices as LZW compressed image data
+	void writeShort(const unsigned value);///> Writes 16 bit little endian value
+
+	std::string m_path;///> The path of the file
+	std::ofstream m_file;///> The file
+	sf::Vector2u m_size;///> Size of the frames
+	float m_delay;///> Delay between frames in hundredths of a second
+	float m_delayError;///> Delay lost to rounding so far
+	std::vector<std::uint8_t> m_indices;///> Palette indices of the current frame
+	std::vector<std::uint16_t> m_dictionary;///> LZW codes by (prefix code, index), 0 if not assigned
+	bool m_started;///> Whether the header was written
+	MemoryCharge m_memory;///> The indices and the dictionary accounted to the export
+};
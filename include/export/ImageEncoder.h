@@ -0,0 +1,65 @@
+#pragma once
+
+#include "../root/Graphics.h"
+#include "../util/ThreadPool.h"
+
+/**
+ * @brief Fast encoders of exported frames into PNG and QOI files
+ *
+ * Both encode RGBA frames straight from their pixels, without copying them
+ *   into an sf::Image. Frames of at least two bands of ROWS_PER_TASK rows are
+ *   split into bands encoded on the threads of the pool, whose outputs are
+ *   joined into one valid file:
+ * - PNG bands are separate IDAT chunks of one zlib stream, every band a
+ *   deflate block of its own with Huffman codes fitted to it and matches found
+ *   by a single hash probe, the fast level of zlib
+ * - QOI bands continue from the last pixel of the band before them, and refer
+ *   only to colors seen within the band
+ *
+ * Encoding several frames at once, like FrameExporter does, is left to the caller.
+ */
+class ImageEncoder
+{
+public:
+	static constexpr unsigned ROWS_PER_TASK = 64u;///> Rows of a band encoded by one task of the pool
+
+	/**
+	 * @brief Checks whether the file is encoded by ImageEncoder
+	 *
+	 * @param path Path of the file
+	 *
+	 * @return True for the extensions .png and .qoi
+	 */
+	static bool handles(const std::string &path);
+
+	/**
+	 * @brief Encodes the pixels into a file, the format given by its extension
+	 *
+	 * @param pixels RGBA pixels, rows from the top
+	 * @param size Size of the image
+	 * @param path Path of the file, ending with .png or .qoi
+	 *
+	 * Throws std::runtime_error if the extension is not handled or the file cannot be written.
+	 */
+	static void save(const std::uint8_t *pixels, const sf::Vector2u &size, const std::string &path);
+
+	/**
+	 * @brief Encodes the pixels into PNG
+	 *
+	 * @param pixels RGBA pixels, rows from the top
+	 * @param size Size of the image
+	 *
+	 * @return Contents of the PNG file
+	 */
+	static std::vector<std::uint8_t> encodePng(const std::uint8_t *pixels, const sf::Vector2u &size);
+
+	/**
+	 * @brief Encodes the pixels into QOI
+	 *
+	 * @param pixels RGBA pixels, rows from the top
+	 * @param size Size of the image
+	 *
+	 * @return Contents of the QOI file
+	 */
+	static std::vector<std::uint8_t> encodeQoi(const std::uint8_t *pixels, const sf::Vector2u &size);
+};
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "FrameSink.h"
+#include "FrameExporter.h"
+
+/**
+ * @brief Sink saving every frame to its own file (001.bmp, 002.bmp, ...)
+ *
+ * Files are encoded by a FrameExporter on background threads.
+ */
+class ImageSequenceSink : public FrameSink
+{
+public:
+	/**
+	 * @brief Constructor creating the directory the frames are saved to
+	 *
+	 * @param directory The directory
+	 * @param extension Extension of the files selecting their format (bmp, png, qoi, jpg, tga), png and qoi are encoded by ImageEncoder
+	 * @param threads Amount of encoder threads, 0 picks it from the amount of cores
+	 */
+	explicit ImageSequenceSink(const std::string &directory, const std::string &extension = "bmp", const unsigned threads = 0u);
+
+	/**
+	 * @brief Queues the frame to be saved as the next file
+	 *
+	 * @param frame The frame
+	 */
+	void write(ExportFrame frame) override;
+
+	/**
+	 * @brief Waits until all frames are saved
+	 */
+	void close() override;
+
+	/**
+	 * @brief Name of the file of the frame, without the extension
+	 *
+	 * @param number Number of the frame, counted from 1
+	 *
+	 * @return The number padded with zeros to at least 3 digits
+	 */
+	static std::string frameName(const unsigned number);
+
+private:
+	std::string m_directory;///> The directory frames are saved to
+	std::string m_extension;///> Extension of the files
+	unsigned m_count;///> Amount of frames written so far
+	FrameExporter m_exporter;///> Encoder threads
+};
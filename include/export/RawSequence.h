@@ -0,0 +1,93 @@
+#pragma once
+
+#include "../root/System.h"
+#include "../util/MappedFile.h"
+
+#include <ostream>
+
+/**
+ * @brief Exported sequence of raw frames, mapped into memory for playback
+ *
+ * The file starts with a header of HEADER_BYTES bytes: the magic, the width,
+ *   the height, the amount of frames, the pixel format, the frames per second
+ *   and the bytes of a frame, every number in the byte order of the machine.
+ *   The frames follow one after another without any encoding, so a frame is
+ *   shown by handing its mapped pages to the texture upload, and the header
+ *   fills a whole page, so every frame starts page aligned when its size is a
+ *   multiple of the page.
+ *
+ * A file whose writer stopped before writing the amount of frames holds the
+ *   frames written so far, the reader counts them from the size of the file.
+ */
+class RawSequence
+{
+public:
+	static constexpr const char *EXTENSION = ".bcgraw";///> Extension of the files
+	static constexpr std::size_t HEADER_BYTES = 4096u;///> Bytes before the first frame
+	static constexpr std::uint32_t PIXEL_FORMAT_RGBA8 = 1u;///> Pixels of 4 bytes, red first, rows from the top
+
+	/**
+	 * @brief Constructor mapping the file
+	 *
+	 * @param path Path to the file
+	 *
+	 * Throws std::runtime_error if the file cannot be mapped or is not a sequence.
+	 */
+	explicit RawSequence(const std::string &path);
+
+	/**
+	 * @brief Writes the header of a sequence
+	 *
+	 * @param stream Stream positioned at the start of the file
+	 * @param size Size of the frames
+	 * @param frames Amount of frames, 0 while they are being written
+	 * @param fps Frames per second of the animation
+	 */
+	static void writeHeader(std::ostream &stream, const sf::Vector2u &size, const std::uint32_t frames, const float &fps);
+
+	/**
+	 * @brief Checks whether a path names a sequence by its extension
+	 *
+	 * @param path The path
+	 *
+	 * @return True if the path ends with EXTENSION
+	 */
+	static bool isSequencePath(const std::string &path);
+
+	/**
+	 * @brief Getter to the size of the frames
+	 *
+	 * @return The size in pixels
+	 */
+	const sf::Vector2u &getSize() const;
+
+	/**
+	 * @brief Getter to the amount of frames
+	 *
+	 * @return The amount of frames, at least one
+	 */
+	std::size_t getFrameCount() const;
+
+	/**
+	 * @brief Getter to the frames per second the sequence was exported with
+	 *
+	 * @return The frames per second
+	 */
+	float getFps() const;
+
+	/**
+	 * @brief Getter to the pixels of a frame
+	 *
+	 * @param index Index of the frame
+	 *
+	 * @return Pointer to the mapped RGBA pixels, valid as long as the sequence
+	 */
+	const std::uint8_t *getFrame(const std::size_t index) const;
+
+private:
+	MappedFile m_file;///> The mapped file
+	sf::Vector2u m_size;///> Size of the frames
+	std::size_t m_frameCount;///> Amount of complete frames
+	std::size_t m_frameBytes;///> Bytes of a frame
+	float m_fps;///> Frames per second
+};
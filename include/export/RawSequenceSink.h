@@ -0,0 +1,49 @@
+#pragma once
+
+#include "FrameSink.h"
+#include "RawSequence.h"
+
+#include <fstream>
+
+/**
+ * @brief Sink streaming the frames uncompressed into a single RawSequence file
+ *
+ * Frames are appended as they come, with no encoding at all, and the amount
+ *   of frames is written into the header when the sink is closed. The file is
+ *   meant to be played back by mapping it, see RawSequence.
+ */
+class RawSequenceSink : public FrameSink
+{
+public:
+	/**
+	 * @brief Constructor opening the file
+	 *
+	 * @param path The path of the file
+	 * @param fps Frames per second of the animation
+	 */
+	explicit RawSequenceSink(const std::string &path, const float &fps);
+
+	/**
+	 * @brief Destructor finishing the file if it was not closed
+	 */
+	~RawSequenceSink();
+
+	/**
+	 * @brief Appends the frame to the file
+	 *
+	 * @param frame The frame, all frames have to be of the size of the first one
+	 */
+	void write(ExportFrame frame) override;
+
+	/**
+	 * @brief Writes the amount of frames and closes the file
+	 */
+	void close() override;
+
+private:
+	std::string m_path;///> The path of the file
+	std::ofstream m_file;///> The file
+	float m_fps;///> Frames per second
+	sf::Vector2u m_size;///> Size of the frames, (0, 0) before the first one
+	std::uint32_t m_frameCount;///> Amount of written frames
+};
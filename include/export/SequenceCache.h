@@ -0,0 +1,165 @@
+#pragma once
+
+#include "FrameSink.h"
+#include "../util/ContentHash.h"
+
+#include <fstream>
+#include <filesystem>
+#include <map>
+
+/**
+ * @brief Rendered sequences kept on the disk, found again by the hash of their inputs
+ *
+ * Exporting the same images with the same animation, parameters, frames and
+ *   resolution again replays the stored frames instead of rendering them.
+ *   Every sequence is a single file named by its hash: a header followed by one
+ *   chunk per frame, each frame stored as the difference from the previous one
+ *   with runs of unchanged pixels collapsed. Sequences are written to a
+ *   temporary file and renamed once complete, so an interrupted export never
+ *   leaves a sequence behind which would be replayed.
+ *
+ * The cache may be used from any thread. Sequences replayed or stored last are
+ *   kept, the oldest ones are removed once the files exceed the capacity.
+ */
+class SequenceCache
+{
+public:
+	static constexpr std::uintmax_t DEFAULT_CAPACITY = 2ull << 30u;///> Bytes the files of the cache take at most by default
+
+	/**
+	 * @brief Sequence being stored, frames are added as they are rendered
+	 */
+	class Recording
+	{
+	public:
+		Recording(const Recording &) = delete;
+		Recording &operator=(const Recording &) = delete;
+
+		/**
+		 * @brief Destructor dropping the frames unless the recording was committed
+		 */
+		~Recording();
+
+		/**
+		 * @brief Appends the next frame
+		 *
+		 * @param frame The frame, every frame of a sequence has the same size
+		 *
+		 * Throws std::runtime_error if the frame cannot be written.
+		 */
+		void add(const ExportFrame &frame);
+
+		/**
+		 * @brief Finishes the sequence, so the next lookup of its hash finds it
+		 *
+		 * Throws std::runtime_error if the file cannot be finished.
+		 */
+		void commit();
+
+	private:
+		friend class SequenceCache;
+
+		Recording(SequenceCache &cache, const std::uint64_t hash, const std::string &path);
+
+		SequenceCache &m_cache;///> Cache the sequence is stored to
+		std::uint64_t m_hash;///> Hash of the inputs of the sequence
+		std::string m_path;///> Temporary file the frames are written to
+		std::ofstream m_file;///> The temporary file
+		sf::Vector2u m_size;///> Size of the frames, (0, 0) before the first one
+		std::uint32_t m_frameCount;///> Amount of frames written
+		std::vector<std::uint32_t> m_previous;///> Pixels of the previous frame
+		std::vector<std::uint8_t> m_encoded;///> Reused buffer the frame is encoded to
+		MemoryCharge m_memory;///> The previous frame and the encoded one accounted to the export
+		bool m_committed;///> Whether the file was renamed to its final name
+	};
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param directory Directory the sequences are stored in, created when the first one is stored
+	 * @param capacity Bytes the files of the cache take at most
+	 */
+	explicit SequenceCache(const std::string &directory, const std::uintmax_t capacity = DEFAULT_CAPACITY);
+
+	SequenceCache(const SequenceCache &) = delete;
+	SequenceCache &operator=(const SequenceCache &) = delete;
+
+	/**
+	 * @brief Cache shared by the application
+	 *
+	 * @return The cache in BCG_CACHE_DIR, or in a directory of the temporary directory when it is not set
+	 */
+	static SequenceCache &shared();
+
+	/**
+	 * @brief Getter to the directory of the sequences
+	 *
+	 * @return The directory
+	 */
+	const std::string &getDirectory() const;
+
+	/**
+	 * @brief Sets the bytes the files of the cache take at most
+	 *
+	 * @param capacity The bytes, the oldest sequences are removed when the next one is stored
+	 */
+	void setCapacity(const std::uintmax_t capacity);
+
+	/**
+	 * @brief Hash of the contents of an image file
+	 *
+	 * @param path Path to the file or a resource path
+	 *
+	 * @return The hash, computed again only when the size or the time of the last change of the file change
+	 */
+	std::uint64_t hashImage(const std::string &path);
+
+	/**
+	 * @brief Checks whether a sequence is stored
+	 *
+	 * @param hash Hash of the inputs of the sequence
+	 *
+	 * @return True if the sequence would be replayed
+	 */
+	bool contains(const std::uint64_t hash) const;
+
+	/**
+	 * @brief Replays a stored sequence
+	 *
+	 * @param hash Hash of the inputs of the sequence
+	 * @param pool Pool the buffers of the frames come from
+	 * @param consumer Function receiving the frames in order
+	 *
+	 * @return True if the sequence was stored and all its frames were passed, false without passing any if it was not
+	 *
+	 * Files which are not complete sequences are removed and reported as missing.
+	 *   Throws std::runtime_error if a frame turns out damaged after others were passed.
+	 */
+	bool replay(const std::uint64_t hash, BufferPool &pool, const std::function<void(ExportFrame)> &consumer);
+
+	/**
+	 * @brief Starts storing a sequence
+	 *
+	 * @param hash Hash of the inputs of the sequence
+	 *
+	 * @return The recording frames are added to
+	 */
+	std::unique_ptr<Recording> record(const std::uint64_t hash);
+
+private:
+	struct FileHash
+	{
+		std::uintmax_t size;///> Size of the file when it was hashed
+		std::filesystem::file_time_type changed;///> Time of the last change of the file when it was hashed
+		std::uint64_t hash;///> Hash of the contents
+	};
+
+	std::string pathOf(const std::uint64_t hash) const;///> Path of the file of the sequence
+	void trim();///> Removes the oldest sequences until the files fit into the capacity
+
+	std::string m_directory;///> Directory of the sequences
+	std::atomic<std::uintmax_t> m_capacity;///> Bytes the files take at most
+	std::atomic<unsigned> m_recordings;///> Amount of recordings started, makes names of the temporary files unique
+	std::map<std::string, FileHash> m_imageHashes;///> Hashes of the image files, by their path
+	std::mutex m_mutex;///> Guards the image hashes and serializes trimming
+};
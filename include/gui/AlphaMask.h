@@ -0,0 +1,97 @@
+#pragma once
+
+#include "../root/Graphics.h"
+#include "../util/MemoryBudget.h"
+
+/**
+ * @brief Alpha channel of an image kept on the GPU apart from its colors
+ *
+ * Animations changing only alpha upload one byte per pixel instead of four.
+ *   SFML textures are always RGBA, so four neighbouring pixels of a row are
+ *   packed into the channels of one texel, and the shader returned by
+ *   getShaderSource unpacks them while drawing the static color texture.
+ *   That is why only images whose width is a multiple of 4 are supported.
+ */
+class AlphaMask
+{
+public:
+	/**
+	 * @brief Default constructor creating an empty mask
+	 */
+	AlphaMask();
+
+	/**
+	 * @brief Checks whether a mask can hold alpha of an image of the size
+	 *
+	 * @param size Size of the image in pixels
+	 *
+	 * @return True if the width is a non-zero multiple of 4
+	 */
+	static bool fits(const sf::Vector2u &size);
+
+	/**
+	 * @brief Prepares the mask for an image of the size, keeping it if the size is the same
+	 *
+	 * @param size Size of the image in pixels
+	 *
+	 * @return True if the mask is ready, false if the size does not fit or the texture failed
+	 */
+	bool create(const sf::Vector2u &size);
+
+	/**
+	 * @brief Frees the texture of the mask
+	 */
+	void clear();
+
+	/**
+	 * @brief Uploads the whole mask
+	 *
+	 * @param mask Alpha of every pixel of the image, row by row
+	 *
+	 * Only the complete rows the buffer contains are updated.
+	 */
+	void update(const std::vector<unsigned char> &mask);
+
+	/**
+	 * @brief Uploads the rows covering a range of pixels
+	 *
+	 * @param mask Alpha of every pixel of the image, row by row
+	 * @param begin First pixel which changed
+	 * @param end Pixel after the last one which changed
+	 */
+	void update(const std::vector<unsigned char> &mask, const std::size_t begin, const std::size_t end);
+
+	/**
+	 * @brief Getter to the size of the image the mask is for
+	 *
+	 * @return Size in pixels, zero if the mask is empty
+	 */
+	sf::Vector2u getSize() const;
+
+	/**
+	 * @brief Getter to the texture holding packed alpha
+	 *
+	 * @return The texture, a quarter as wide as the image
+	 */
+	const sf::Texture &getTexture() const;
+
+	/**
+	 * @brief Getter of the GLSL fragment shader drawing an image with its mask
+	 *
+	 * @return Source code of the shader
+	 *
+	 * The shader receives following uniforms:
+	 * - source - color texture of the image being drawn,
+	 * - mask   - texture of the mask,
+	 * - width  - width of the image in pixels,
+	 * - premultiplied - true if the color texture has premultiplied alpha.
+	 */
+	static const std::string &getShaderSource();
+
+private:
+	void upload(const std::vector<unsigned char> &mask, const std::size_t first_row, const std::size_t rows);///> Uploads complete rows of the mask
+
+	sf::Texture m_texture;///> Texture holding alpha of 4 pixels in every texel
+	sf::Vector2u m_size;///> Size of the image the mask is for
+	MemoryCharge m_charge;///> Memory of the texture accounted to the images
+};
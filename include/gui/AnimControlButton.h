@@ -33,11 +33,11 @@ public:
 	~AnimControlButton() = default;
 
      /**
-     * @brief Reders instatntion of AnimControlButton on sf::RenderTarget.
+     * @brief Adds instatntion of AnimControlButton with its icon to the batch.
      *
-     * @param RenderTarget The target on which the instatntion is rendered.
+     * @param target The batch which the instatntion is added to.
      */
-	void render(sf::RenderTarget *target) override;
+	void batch(GuiBatch &target) const override;
 
      /**
      * @brief Updates instatntion content
@@ -47,8 +47,14 @@ public:
      */
 	void update(sf::Vector2i mousePos, sf::Event &event) override;
 
+     /**
+     * @brief Getter to a value summarizing the look of the button, including the color of its icon
+     *
+     * @return The look key.
+     */
+	std::size_t getLookKey() const override;
+
 protected:
-	sf::Texture m_texture;
-	sf::Sprite m_sprite;
+	sf::Sprite m_sprite;///> Icon of the button, a part of the icon atlas
 	
 };
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../util/ExtendedMath.h"
+#include "../util/PixelView.h"
+#include "ImageStore.h"
 
 /**
  * @brief Class applying animations on images
@@ -28,10 +30,26 @@ public:
 		std::unique_ptr<sf::Texture> texture,
 		const sf::Vector2f &independent_size = sf::Vector2f());
 
+	/**
+	 * @brief Constructor creating AnimatedImage drawing an image of ImageStore
+	 *
+	 * @param position The position of an image
+	 * @param image The stored image, its texture is shared with others showing it
+	 * @param independent_size Size that is not dependent on texture's size
+	 *
+	 * The shared texture is never modified, so pixelUpdate has no effect on such image.
+	 */
+	explicit AnimatedImage(
+		const sf::Vector3f &position, 
+		ImageStore::Handle image,
+		const sf::Vector2f &independent_size = sf::Vector2f());
+
 	/**
 	 * @brief Copy constructor
 	 *
 	 * @param copy Copied object
+	 *
+	 * An owned texture is copied, a shared one is shared by the copy as well.
 	 */
 	explicit AnimatedImage(const AnimatedImage &copy);
 
@@ -62,6 +80,9 @@ public:
 	 * @brief Get the vector of RGB values of the texture
 	 *
 	 * @return The vector filled with RGB values
+	 *
+	 * Images of ImageStore are copied from their decoded pixels, only textures
+	 *   given by the caller are read back from the GPU.
 	 */
 	std::vector<unsigned char> getRGB() const;
 
@@ -90,8 +111,10 @@ public:
 	 *
 	 * @param transform 4x4 transform matrix
 	 * 
-	 * If transform represents an identity matrix, this methods does nothing.
-	 * It is also expected to be called very frequently (every frame perhaps).
+	 * If transform represents an identity matrix, the image is placed at its initial position.
+	 * It is also expected to be called very frequently (every frame perhaps), so
+	 *   it only stores the transform. Vertices are placed on the CPU once render or
+	 *   the depth getters need them, renderWithDepth leaves them to the vertex shader.
 	 */
 	inline void transformUpdate(const em::Matrix4f &transform = em::Matrix4f());
 
@@ -99,61 +122,174 @@ public:
 	 * @brief Update texture pixels of the AnimatedImage
 	 *
 	 * @param pixels vector of RGBA values of the texture
+	 * 
+	 * Pixels are uploaded straight from the given buffer without copying it.
+	 *   A buffer holding less than the whole texture is copied and padded with
+	 *   transparent black, so the rest of the texture is cleared. Shared textures
+	 *   are never updated.
+	 */
+	inline void pixelUpdate(const std::vector<unsigned char> &pixels = {});
+
+	/**
+	 * @brief Update part of texture pixels of the AnimatedImage
+	 *
+	 * @param pixels vector of RGBA values of the whole texture
+	 * @param begin First pixel which changed
+	 * @param end Pixel after the last one which changed
+	 *
+	 * All rows touching the range are uploaded, the rest of the texture keeps its pixels.
+	 */
+	inline void pixelUpdate(const std::vector<unsigned char> &pixels, const std::size_t begin, const std::size_t end);
+
+	/**
+	 * @brief Update texture pixels of the AnimatedImage from pixels of any channel type
+	 *
+	 * @param pixels View of the pixels, of the size of the texture
+	 *
+	 * Textures are RGBA8, so 16-bit and floating point pixels are converted on the
+	 *   way, after the animation worked on them in their own precision. Views of
+	 *   another size than the texture are ignored, like shared textures.
 	 */
-	inline void pixelUpdate(std::vector<unsigned char> pixels = {});
+	template <typename Channel>
+	void pixelUpdate(const pk::PixelView<Channel> &pixels);
+
+	/**
+	 * @brief Getter to the texture imprinted on the AnimatedImage
+	 *
+	 * @return Pointer to the texture, nullptr if there is none
+	 */
+	const sf::Texture *getTexture() const;
 
 	/**
 	 * @brief Renders contents of the AnimatedImage to the target
 	 *
 	 * @param target Rendering target (ex. window)
+	 * @param shader Shader applied to the texture, nullptr draws it as it is
+	 * @param blend Blending with the target, premultiplied textures need their own
+	 */
+	void render(sf::RenderTarget *target, const sf::Shader *shader = nullptr, const sf::BlendMode &blend = sf::BlendAlpha);
+
+	/**
+	 * @brief Renders the mesh of the AnimatedImage transformed by the depth shader
+	 *
+	 * @param target Rendering target with a depth buffer and the depth test enabled
+	 * @param shader Shader compiled from getDepthVertexShaderSource and getDepthFragmentShaderSource
+	 *
+	 * The transform goes to the shader as it is, so no vertex is transformed on the CPU
+	 *   and every fragment gets its own depth. The caller sets the uniforms of the
+	 *   projection (center, focal and depthRange).
+	 */
+	void renderWithDepth(sf::RenderTarget *target, sf::Shader &shader);
+
+	/**
+	 * @brief Sets the amount of cells the mesh drawn by renderWithDepth is split into
+	 *
+	 * @param cells Amount of cells along every edge, 1 draws the image as two triangles
+	 *
+	 * Affine transforms look the same for any amount, finer meshes are meant for
+	 *   vertex shaders bending the image, like page curls.
+	 */
+	void setSubdivision(const unsigned cells);
+
+	/**
+	 * @brief Getter to the source of the vertex shader placing images with their depth
+	 *
+	 * @return GLSL source of the vertex shader
+	 *
+	 * Uniforms: transform (mat4 of the image in pixels of the target), center (vec2
+	 *   the perspective converges to), focal (distance of the eye from the target in
+	 *   pixels, 0 for orthographic projection) and depthRange (z mapped to the far plane).
 	 */
-	void render(sf::RenderTarget *target);
+	static const std::string &getDepthVertexShaderSource();
+
+	/**
+	 * @brief Getter to the source of the fragment shader drawing images with their depth
+	 *
+	 * @return GLSL source of the fragment shader, sampling the texture given as source
+	 */
+	static const std::string &getDepthFragmentShaderSource();
 
 private:
-	void setToInitPosition();
-	const sf::Vector3f getVertexPosition(const int &index) const;
+	void setToInitPosition() const;
+	void setToTexture(const sf::Vector2f &independent_size);///> Sets the size and the texture coordinates from the texture
+	void placeVertices() const;///> Applies the transform to the vertices if it changed since they were placed
+	void buildMesh();///> Splits the image into the cells of the mesh
+	em::Matrix4f placement() const;///> The transform pivoted around the top-left corner of the image
 	const sf::Vector2f toV2f(const sf::Vector3f &origin) const;
 	const sf::Vector3f toV3f(const sf::Vector2f &origin) const;
 
 	sf::Vector2f m_initSize; ///> Size of the texture set at object definition
 	sf::Vector2f m_initPosition; ///> Position of the top-left corner of the texture set at definition
-	sf::VertexArray m_verticies; ///> Verticies which transformations are appleid to
-	std::unique_ptr<sf::Texture> m_texture; ///> Unique pointer to texture imprinted on verticies
-	std::array<float, 4> m_depths; ///> Depth of an image relevant to window's view
+	mutable sf::VertexArray m_verticies; ///> Verticies which transformations are appleid to
+	mutable bool m_verticesOutdated; ///> Whether the verticies have to be placed with the transform again
+	sf::VertexArray m_mesh; ///> Untransformed triangles drawn by renderWithDepth
+	unsigned m_subdivision; ///> Amount of cells along every edge of the mesh
+	std::shared_ptr<const sf::Texture> m_texture; ///> Pointer to texture imprinted on verticies
+	ImageStore::Handle m_source; ///> Stored image the texture belongs to, nullptr for textures given by the caller
+	sf::Texture *m_ownTexture; ///> The same texture when it is owned by the image, nullptr when it is shared
+	mutable std::array<float, 4> m_depths; ///> Depth of an image relevant to window's view
+	em::Matrix4f m_transform; ///> Transform the verticies are currently placed with
 };
 
 inline void AnimatedImage::transformUpdate(const em::Matrix4f &transform)
 {
-	this->setToInitPosition();
-	if(transform != em::Matrix4f())
+	if(transform == m_transform)
 	{
-		em::Matrix4f current = em::Matrix4f().translate(toV3f(m_initPosition));
-		sf::Vector3f temp_pos;
-
-		temp_pos = ((current * transform * (-current)) * this->getVertexPosition(0));
-		m_verticies[0].position = toV2f(temp_pos);
-		m_depths[0] = temp_pos.z;
-
-		temp_pos = ((current * transform * (-current)) * this->getVertexPosition(1));
-		m_verticies[1].position = toV2f(temp_pos);
-		m_depths[1] = temp_pos.z;
+		return;
+	}
+	m_transform = transform;
+	m_verticesOutdated = true;
+}
 
-		temp_pos = ((current * transform * (-current)) * this->getVertexPosition(2));
-		m_verticies[2].position = toV2f(temp_pos);
-		m_depths[2] = temp_pos.z;
+inline void AnimatedImage::pixelUpdate(const std::vector<unsigned char> &pixels)
+{
+	if(m_ownTexture && (pixels.size() > 0))
+	{
+		const sf::Vector2u size = m_ownTexture->getSize();
+		const std::size_t bytes = static_cast<std::size_t>(size.x) * size.y * 4u;
+		if(bytes == 0u)
+		{
+			return;
+		}
+		if(pixels.size() >= bytes)
+		{
+			m_ownTexture->update(pixels.data());
+			return;
+		}
+		//a short buffer is padded with transparent pixels, nothing of the previous frame is left
+		std::vector<unsigned char> padded(bytes, 0u);
+		std::copy(pixels.begin(), pixels.end(), padded.begin());
+		m_ownTexture->update(padded.data());
+	}
+}
 
-		temp_pos = ((current * transform * (-current)) * this->getVertexPosition(3));
-		m_verticies[3].position = toV2f(temp_pos);
-		m_depths[3] = temp_pos.z;
+inline void AnimatedImage::pixelUpdate(const std::vector<unsigned char> &pixels, const std::size_t begin, const std::size_t end)
+{
+	if(m_ownTexture && (pixels.size() > 0) && (begin < end))
+	{
+		sf::Vector2u size = m_ownTexture->getSize();
+		if(size.x == 0)
+		{
+			return;
+		}
+		const std::size_t available = std::min<std::size_t>(size.y, pixels.size() / (size.x * 4));
+		const std::size_t first = begin / size.x;
+		const std::size_t last = std::min(available, (end + size.x - 1) / size.x);
+		if(last > first)
+		{
+			m_ownTexture->update(pixels.data() + first * size.x * 4, size.x, static_cast<unsigned>(last - first), 0, static_cast<unsigned>(first));
+		}
 	}
 }
 
-inline void AnimatedImage::pixelUpdate(std::vector<unsigned char> pixels)
+template <typename Channel>
+void AnimatedImage::pixelUpdate(const pk::PixelView<Channel> &pixels)
 {
-	if(m_texture && (pixels.size() > 0))
+	if(!m_ownTexture || pixels.getSize() != m_ownTexture->getSize())
 	{
-		sf::Vector2u size = m_texture->getSize();
-		pixels.resize(size.x * size.y * 4);
-		m_texture->update(pixels.data(), size.x, size.y, 0.f, 0.f);
+		return;
 	}
+	std::vector<unsigned char> converted(pixels.getPixelCount() * 4u);
+	pk::convertChannels(pixels, pk::PixelView8(converted, pixels.getSize()));
+	this->pixelUpdate(converted);
 }
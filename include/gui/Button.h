@@ -1,5 +1,7 @@
 #pragma once
 #include "Object.h"
+#include "GuiBatch.h"
+#include "IconAtlas.h"
 
 /**
  * @brief      Class of simple button.
@@ -73,12 +75,26 @@ public:
     void update(sf::Vector2i mousePos, sf::Event &event) override;
     
     /**
-     * @brief      Renders button in target.
+     * @brief      Renders button in target, in as few draw calls as the batch allows.
      *
      * @param      target  The target
      */
     void render(sf::RenderTarget *target) override;
 
+    /**
+     * @brief      Adds everything the button draws to the batch.
+     *
+     * @param      target  The batch, panels collect all their widgets in one
+     */
+    virtual void batch(GuiBatch &target) const;
+
+    /**
+     * @brief      Getter to a value summarizing the look of the button, including its state
+     *
+     * @return     The look key.
+     */
+    std::size_t getLookKey() const override;
+
 protected:
     unsigned short m_state;
 
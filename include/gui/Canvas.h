@@ -1,8 +1,15 @@
 #pragma once
 
 #include "AnimatedImage.h"
-#include "../animation/ObjectAnimation.h"
-#include "../animation/PixelAnimation.h"
+#include "AlphaMask.h"
+#include "FrameCache.h"
+#include "ImageStore.h"
+#include "PlaneReadback.h"
+#include "../util/PlaybackCursor.h"
+#include "../animation/AnimationRegistry.h"
+#include "../export/FrameSink.h"
+#include "../export/SequenceCache.h"
+#include "../export/RawSequence.h"
 
 /**
  * Class handling image drawing and applying animations
@@ -10,6 +17,15 @@
 class Canvas final
 {
 public:
+	/**
+	 * @brief Resolutions the images of the animation are worked on at
+	 */
+	enum class ImageTier
+	{
+		PREVIEW = 0,	///> Images shrunk to the size of the plane, which is all that is ever shown of them
+		FULL = 1		///> Images at their original resolution
+	};
+
 	/**
 	 * Default constructor
 	 */
@@ -32,15 +48,66 @@ public:
 	 * @brief Sets the animation type to deriving of ObjectAnimation
 	 *
 	 * @param new_animation The new animation
+	 * @param use_shader Whether the images should be placed by the depth shader
+	 *
+	 * With the depth shader the transforms go to the GPU as they are and the depth
+	 *   buffer of the plane orders every pixel, so tilted and intersecting images
+	 *   occlude each other correctly. Without shaders or a depth buffer the images
+	 *   are transformed on the CPU and drawn sorted by the depth of their first corner.
 	 */
-	void setAnimation(std::unique_ptr<ObjectAnimation> new_animation);
+	void setAnimation(std::unique_ptr<ObjectAnimation> new_animation, const bool use_shader = true);
 
 	/**
 	 * @brief Sets the animation type to deriving of PixelAnimation
 	 *
 	 * @param new_animation The new animation
+	 * @param use_shader Whether the animation should be computed by its fragment shader
+	 * 
+	 * The shader is used only if the graphics card supports shaders, the animation
+	 *   provides one and it compiles, otherwise the frames are computed on the CPU.
+	 *   Replacing a pixel animation working on the same alpha layout keeps the pixels
+	 *   and textures of the images, only the plan of the new animation is built. Textures
+	 *   the previous animation uploaded its frames into get the images back from the pixels.
+	 */
+	void setAnimation(std::unique_ptr<PixelAnimation> new_animation, const bool use_shader = true);
+
+	/**
+	 * @brief Checks whether the current PixelAnimation is computed by a shader
+	 *
+	 * @return True if the frames are computed on the GPU, false otherwise
+	 */
+	bool isShaderActive() const;
+
+	/**
+	 * @brief Sets any of the animations of the application
+	 *
+	 * @param new_animation The new animation
+	 * @param use_shader Whether animations may be computed and placed by shaders
 	 */
-	void setAnimation(std::unique_ptr<PixelAnimation> new_animation);
+	void setAnimation(AnyAnimation new_animation, const bool use_shader = true);
+
+	/**
+	 * @brief Getter to the keyframes of an image of the ObjectAnimation
+	 *
+	 * @param image 1 for the starting image, 2 for the ending one
+	 *
+	 * @return The track, nullptr if no animation of keyframes is set
+	 */
+	const KeyframeTrack *getKeyframes(const unsigned image) const;
+
+	/**
+	 * @brief Edits the keyframes of an image of the ObjectAnimation
+	 *
+	 * @param image 1 for the starting image, 2 for the ending one
+	 * @param edit Function changing the track
+	 *
+	 * @return False if no animation of keyframes is set, the track is not edited then
+	 *
+	 * Only cached frames whose progress lies between the keyframes around the change
+	 *   are dropped, and prerendered again while the animation is paused. The shown
+	 *   frame is drawn again by the next update if the change reaches it.
+	 */
+	bool editKeyframes(const unsigned image, const std::function<void(KeyframeTrack &)> &edit);
 
 	/**
 	 * @brief Sets the starting image of the animation
@@ -56,6 +123,94 @@ public:
 	 */
 	void setEndingImage(const sf::String &directory_path);
 
+	/**
+	 * @brief Sets the resolution the images are worked on at
+	 *
+	 * @param tier The resolution tier, PREVIEW by default
+	 * 
+	 * Frames are always rendered at the size of the plane, so pixel animations on
+	 *   the PREVIEW tier cost as much as the frames they produce, however big
+	 *   the source images are. Changing the tier reloads both images.
+	 *
+	 * While the memory budget is exceeded, updates give memory back on their own:
+	 *   first cached frames are dropped, then FULL falls back to PREVIEW and PREVIEW
+	 *   images are shrunk further, down to a quarter of the plane. Setting the tier
+	 *   again restores the resolution and the budget of the frame cache.
+	 */
+	void setImageTier(const ImageTier tier);
+
+	/**
+	 * @brief Getter to the resolution the images are worked on at
+	 *
+	 * @return The resolution tier
+	 */
+	ImageTier getImageTier() const;
+
+	/**
+	 * @brief Chooses whether pixel animations computed on the CPU work on premultiplied alpha
+	 *
+	 * @param premultiplied True to premultiply the images, false to keep straight alpha
+	 * 
+	 * Images are premultiplied once when given to the animation, frames are written
+	 *   premultiplied and blended as such, so fades scale all channels by one factor
+	 *   and overlapping layers composite correctly. The plane is opaque either way,
+	 *   so exported frames do not change. Shaders always work on straight alpha.
+	 */
+	void setPremultipliedAlpha(const bool premultiplied);
+
+	/**
+	 * @brief Tells whether pixel animations computed on the CPU work on premultiplied alpha
+	 *
+	 * @return True if they do
+	 */
+	bool isPremultipliedAlpha() const;
+
+	/**
+	 * @brief Sets the perspective of object animations placed by the depth shader
+	 *
+	 * @param focal Distance of the eye from the plane in pixels, 0 for the orthographic projection
+	 *
+	 * Images moved away (higher z) shrink towards the center of the plane. Only the
+	 *   depth shader projects, images drawn sorted stay orthographic.
+	 */
+	void setPerspective(const float focal);
+
+	/**
+	 * @brief Getter to the perspective of object animations
+	 *
+	 * @return Distance of the eye from the plane in pixels, 0 for the orthographic projection
+	 */
+	float getPerspective() const;
+
+	/**
+	 * @brief Loads the image the way the canvas shows it, at the current tier
+	 *
+	 * @param path Path to the image file
+	 *
+	 * @return Handle to the image, never nullptr
+	 * 
+	 * Holding the handle keeps the image in the ImageStore, so setting it as the
+	 *   starting or the ending image later does not decode it again.
+	 */
+	ImageStore::Handle loadImage(const std::string &path) const;
+
+	/**
+	 * @brief Plays an exported sequence instead of the animation
+	 *
+	 * @param sequence The sequence, nullptr shows the animation again
+	 *
+	 * The frame nearest to the current progress is uploaded straight from the
+	 *   mapped file when it is first shown, nothing is decoded or rendered.
+	 */
+	void setSequence(std::shared_ptr<const RawSequence> sequence);
+
+	/**
+	 * @brief Getter to the played sequence
+	 *
+	 * @return The sequence, nullptr if the animation is shown
+	 */
+	const RawSequence *getSequence() const;
+
 	/**
 	 * @brief Sets the current time of the chosen animation
 	 *
@@ -87,10 +242,37 @@ public:
 	/**
 	 * @brief Sets the size of the Canvas
 	 *
-	 * @param new_size The new size
+	 * @param new_size The new size of the area frames are shown in
+	 *
+	 * Frames are scaled into the area keeping their aspect ratio, the plane keeps
+	 *   its render size, so layout changes do not render anything again.
 	 */
 	void setSize(const sf::Vector2f &new_size);
 
+	/**
+	 * @brief Getter to the size of the Canvas
+	 *
+	 * @return Size of the area frames are shown in
+	 */
+	const sf::Vector2f &getSize() const;
+
+	/**
+	 * @brief Sets the resolution frames are rendered and exported at
+	 *
+	 * @param size Size of the plane in pixels, independent of the size of the Canvas
+	 *
+	 * The plane is created again, the images reloaded and cached frames dropped only
+	 *   when the size differs from the current one.
+	 */
+	void setRenderSize(const sf::Vector2u &size);
+
+	/**
+	 * @brief Getter to the resolution frames are rendered at
+	 *
+	 * @return Size of the plane in pixels
+	 */
+	sf::Vector2u getRenderSize() const;
+
 	/**
 	 * @brief Sets the position of the Canvas
 	 *
@@ -98,6 +280,72 @@ public:
 	 */
 	void setPosition(const sf::Vector2f &new_position);
 
+	/**
+	 * @brief Getter to the position of the Canvas
+	 *
+	 * @return Top-left corner of the area frames are shown in
+	 */
+	const sf::Vector2f &getPosition() const;
+
+	/**
+	 * @brief Sets the frames of the timeline the rendered frames are cached by
+	 *
+	 * @param grid Frames of the timeline
+	 * 
+	 * Changing the frames clears the frame cache. While the animation is not played
+	 *   and the cache is enabled, the Canvas shows the frame nearest to the current time.
+	 */
+	void setFrameGrid(const FrameGrid &grid);
+
+	/**
+	 * @brief Sets the frames, the time and the play status at once
+	 *
+	 * @param playback State of playback of the timeline
+	 *
+	 * Only the state of playback is kept by the Canvas, the animation never changes
+	 *   with it, so another view may play the same transition at its own time.
+	 */
+	void setPlayback(const PlaybackCursor &playback);
+
+	/**
+	 * @brief Getter to the state of playback
+	 *
+	 * @return The time, the frames and the play status the Canvas is drawn at
+	 */
+	const PlaybackCursor &getPlayback() const;
+
+	/**
+	 * @brief Chooses whether a pixel animation computed on the CPU works on smaller images
+	 *
+	 * @param scrubbing True while the time is dragged
+	 *
+	 * While scrubbing, the animation works on images of a quarter of the plane in both
+	 *   directions and the GPU stretches its frames over the plane, so every move of the
+	 *   time costs a sixteenth of a frame. These frames are not cached. Afterwards the
+	 *   animation gets the images of its tier back and the full frame is drawn again.
+	 *   setPlayback scrubs along with the timeline.
+	 */
+	void setScrubbing(const bool scrubbing);
+
+	/**
+	 * @brief Sets the amount of instants averaged into every frame of renderSequence
+	 *
+	 * @param subframes The amount, 1 for sharp frames, at most 64
+	 *
+	 * The subframes are spread evenly over the time since the previous frame, up to
+	 *   the time of the frame, like a shutter open between the two. They are averaged
+	 *   on the GPU through one render texture, so a blurred frame costs its subframe
+	 *   draws and a single read back. The preview is never blurred.
+	 */
+	void setMotionBlur(const unsigned subframes);
+
+	/**
+	 * @brief Getter to the amount of instants averaged into every exported frame
+	 *
+	 * @return The amount, 1 for sharp frames
+	 */
+	unsigned getMotionBlur() const;
+
 	/**
 	 * @brief Getter to texture which the animation is rendered to
 	 *
@@ -105,11 +353,40 @@ public:
 	 */
 	sf::RenderTexture& getPlane();
 
+	/**
+	 * @brief Getter to the texture of the frame shown by the last render
+	 *
+	 * @return The rendered plane or the cached frame which replaced it
+	 */
+	const sf::Texture &getFrameTexture() const;
+
+	/**
+	 * @brief Getter to the cache of rendered frames
+	 *
+	 * @return The frame cache, whose budget may be changed
+	 */
+	FrameCache &getFrameCache();
+
+	/**
+	 * @brief Renders one of the frames missing in the frame cache
+	 *
+	 * @return True if a frame was rendered, false if there is nothing to render or no room for it
+	 * 
+	 * Meant to be called while the application is idle. Frames after the current one
+	 *   are rendered first and no cached frame is evicted to make room for them.
+	 */
+	bool prerenderFrame();
+
 	/**
 	 * @brief Updates the animation when it's supposed to be played
 	 *
 	 * @param mousePos The mouse position relative to the window
 	 * @param event The event reference handling all events in the window
+	 * 
+	 * The animation is evaluated only by the next render, so a burst of events
+	 *   computes at most one frame. Unless the time, the animation or the images
+	 *   changed since, neither the images are evaluated nor the plane is drawn again.
+	 *   While the animation is played, another update is requested from Program.
 	 */
 	void update(sf::Vector2i mousePos, sf::Event &event);
 
@@ -120,6 +397,46 @@ public:
 	 */
 	void render(sf::RenderTarget *target);
 
+	/**
+	 * @brief Draws an already rendered frame where the Canvas is placed
+	 *
+	 * @param target The target which the frame is drawn to
+	 * @param frame The frame, usually rendered on another thread
+	 * 
+	 * The frame is scaled into the area of the Canvas keeping its aspect ratio.
+	 *   Touches only the position and the size of the Canvas, so it may be called
+	 *   while another thread renders the animation.
+	 */
+	void present(sf::RenderTarget *target, const sf::Texture &frame) const;
+
+	/**
+	 * @brief Renders the animation only to the plane of the Canvas
+	 * 
+	 * Meant for rendering without any window, the frame is then available
+	 *   through getFrameTexture.
+	 */
+	void renderPlane();
+
+	/**
+	 * @brief Renders frames of the animation at many times in one call
+	 *
+	 * @param times Times of the animation the frames are rendered at
+	 * @param consumer Function receiving the rendered frames in order of the times
+	 * @param cache Optional cache the frames are replayed from when the same sequence was rendered before, and stored to otherwise
+	 * 
+	 * The animation is sampled with a single call for all the times, so exports get
+	 *   it computed in batches. Afterwards the Canvas shows its current time again.
+	 *   Pixels of the frames are read back into recycled buffers, which return to
+	 *   the Canvas once the consumer drops the frames.
+	 *
+	 * The sequence is found in the cache by the contents of both image files, the
+	 *   animation and its parameters, the way it is computed, the times and the
+	 *   size of the plane. A sequence which cannot be stored is still rendered.
+	 *
+	 * With motion blur every frame averages its subframes, see setMotionBlur.
+	 */
+	void renderSequence(const std::vector<float> &times, const std::function<void(ExportFrame)> &consumer, SequenceCache *cache = nullptr);
+
 	/**
 	 * @brief Getter to the total time given to the Canvas
 	 *
@@ -130,12 +447,36 @@ public:
 protected:
 
 private:
+	void createPlane(const sf::Vector2u &size);///> Creates the plane with a depth buffer if the context offers one
 	void clearAnimation();///> Prepares Canvas for the change of animation
 	void clearStartingImage();///> Prepares Canvas for the change of starting image
 	void clearEndingImage();///> Prepares Canvas for the change of finishing image
+	void reloadImages();///> Loads both images again after a change of their resolution
+	std::unique_ptr<AnimatedImage> makePixelImage(const StoredImage &source, const std::vector<unsigned char> &pixels) const;///> Creates image with own texture the frames of PixelAnimation are written to
+	std::vector<unsigned char> animationPixels(const AnimatedImage &image) const;///> Pixels of the image in the layout the PixelAnimation works on
+	bool usesPremultipliedAlpha() const;///> Whether the current PixelAnimation works on premultiplied alpha
+	sf::Shader *findShader(const std::string &source, const std::string &vertex_source = std::string());///> Gets the compiled shader of given fragment (and vertex) source, nullptr if it fails to compile
+	void updatePixelFrames(const float &time);///> Writes frames of the PixelAnimation at the time to the pixel images
+	void placePixelImages(const float &time);///> Moves the pixel images by the transforms of the PixelAnimation, if it has any
+	bool prepareAlphaMasks();///> Fits the alpha masks to the pixel images, false if the frames have to be uploaded whole
+	bool usesAlphaMasks() const;///> Whether pixel images are drawn with their alpha masks
+	void updateImages(const float &time);///> Applies the animation at the time to the images
+	void drawPlane(const float &time);///> Draws the images brought to the time to the plane
+	void drawWithDepth();///> Draws the images of the ObjectAnimation with the depth shader and the depth test
+	void drawSorted();///> Draws the images of the ObjectAnimation transformed on the CPU, the deeper one first
+	bool isFrameCached() const;///> Whether frames are currently shown from the frame cache
+	void invalidateFrames();///> Drops cached frames after a change of the animation or the images
+	void placeFrame(sf::Sprite &body, const sf::Texture &frame) const;///> Scales and centers the sprite of a frame within the area of the Canvas
+	void accountMemory();///> Brings the memory charges to the current plane, textures and buffers
+	void fitIntoBudget();///> Gives memory back while the memory budget is exceeded
+	void accumulateSubframe(const unsigned subframe);///> Averages the plane into the blurred frame as its subframe of given index
+	void showSequenceFrame();///> Uploads the frame of the sequence at the current time if it is not shown yet
+	bool hashSequence(SequenceCache &cache, const std::vector<float> &times, std::uint64_t &hash) const;///> Hashes the inputs of the sequence, false if it cannot be cached
 
 	sf::RenderTexture m_plane;///> Texture which everything is rendered to
+	bool m_hasDepthBuffer;///> Whether the plane was created with a depth buffer
 	sf::Sprite m_planeBody;///> Sprite to which the texture is applied to
+	sf::Vector2f m_size;///> Area the frames are shown in, zero to show them at their own size
 
 	std::unique_ptr<ObjectAnimation> m_objAnim;///> Pointer to ObjectAnimation derived object
 	std::unique_ptr<PixelAnimation> m_pixAnim;///> Pointer to PixelAnimation derived object
@@ -146,12 +487,47 @@ private:
 		PIX_ANIM = 2
 	};
 	unsigned short m_animType;///> Specifier of animation type
+	ImageTier m_imageTier;///> Resolution the images are worked on at
+	unsigned m_previewDivisor;///> Images of the PREVIEW tier are shrunk to the plane divided by it, raised over the memory budget
+	std::string m_startingPath;///> Path to the starting image, empty if there is none
+	std::string m_endingPath;///> Path to the ending image, empty if there is none
+	ImageStore::Handle m_startingSource;///> Decoded starting image
+	ImageStore::Handle m_endingSource;///> Decoded ending image
 	std::unique_ptr<AnimatedImage> m_startingImage;///> Starting image of ObjectAnimations
 	std::unique_ptr<AnimatedImage> m_endingImage;///> Ending image of ObjectAnimations
 	std::unique_ptr<AnimatedImage> m_pixelImageIn;///> Starting image of PixelAnimations
 	std::unique_ptr<AnimatedImage> m_pixelImageOut;///> Ending image of PixelAnimations
+	std::vector<unsigned char> m_pixelFrameIn;///> Reused buffer the frame of the starting image is written to
+	std::vector<unsigned char> m_pixelFrameOut;///> Reused buffer the frame of the ending image is written to
+	std::map<std::string, std::unique_ptr<sf::Shader>> m_shaders;///> Shaders already compiled, by their source
+	sf::Shader *m_pixShader;///> Shader computing current PixelAnimation, nullptr when it is computed on the CPU
+	sf::Shader *m_maskShader;///> Shader drawing pixel images with their alpha masks, nullptr when the animation changes colors
+	sf::Shader *m_depthShader;///> Shader placing images of ObjectAnimations with their depth, nullptr when they are drawn sorted
+	float m_perspective;///> Distance of the eye from the plane for the depth shader, 0 for orthographic projection
+	AlphaMask m_maskIn;///> Alpha of the frame of the starting image, drawn over its original colors
+	AlphaMask m_maskOut;///> Alpha of the frame of the ending image, drawn over its original colors
+	bool m_premultipliedAlpha;///> Whether pixel animations computed on the CPU work on premultiplied alpha
+
+	FrameCache m_frameCache;///> Already rendered frames
+	const sf::Texture *m_cachedFrame;///> Cached frame shown instead of the plane, nullptr if the plane is shown
+	bool m_imagesOutdated;///> Whether the images have to be brought to the current time before drawing
+	float m_evaluatedTime;///> Time the images were last brought to, negative when they have to be brought again
+	float m_drawnTime;///> Time the plane was last drawn at, negative when it has to be drawn again
+	float m_pixelFramesTime;///> Time the textures of pixel images hold the frames of, negative when they have to be uploaded whole
+	MemoryCharge m_imagesCharge;///> The plane and the own textures of the pixel images
+	MemoryCharge m_framesCharge;///> Buffers the frames of the PixelAnimation are written to
+	BufferPool m_bufferPool;///> Recycled buffers of the exported frames
+	std::shared_ptr<const RawSequence> m_sequence;///> Exported sequence played instead of the animation, nullptr if there is none
+	sf::Texture m_sequenceTexture;///> Frame of the sequence currently shown
+	std::size_t m_sequenceFrame;///> Index of the frame the texture holds, the amount of frames if it holds none
 
-	bool m_isAnimPlaying;///> Flag defining whether animation is being played or not
-	float m_currentAnimTime;///> Current animation time
-	float m_totalAnimTime;///> Total animation time
+	PlaybackCursor m_playback;///> Time, frames of the timeline and play status the Canvas is shown at
+	bool m_scrubbing;///> Whether the pixel animation works on the smaller images of scrubbing
+	unsigned m_motionBlur;///> Instants averaged into every exported frame
+	sf::RenderTexture m_blurPlane;///> Exported frame the subframes are averaged into, created by the first blurred sequence
+	PlaneReadback m_readback;///> Reads exported frames back from the GPU while the next ones are drawn
+	std::unique_ptr<AnimatedImage> m_heldImageIn;///> Starting pixel image of the tier, kept aside while scrubbing
+	std::unique_ptr<AnimatedImage> m_heldImageOut;///> Ending pixel image of the tier, kept aside while scrubbing
+	std::vector<unsigned char> m_heldPixels1;///> Pixels of the starting image of the tier, kept aside while scrubbing
+	std::vector<unsigned char> m_heldPixels2;///> Pixels of the ending image of the tier, kept aside while scrubbing
 };
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Canvas.h"
+#include "../util/TripleBuffer.h"
+
+/**
+ * @brief Thread rendering the Canvas, so the window stays responsive while frames are computed
+ *
+ * The thread has its own OpenGL context. It evaluates the animation at the latest
+ *   time given by submit, draws it into the plane of the Canvas and copies the
+ *   result into one of three textures, which the window thread presents without
+ *   ever waiting for a frame in progress. While there is nothing new to render,
+ *   the thread fills the frame cache of the Canvas.
+ *
+ * The Canvas is owned by the render thread while it runs, any other change to it
+ *   has to be made through modify.
+ */
+class CanvasRenderer
+{
+public:
+	/**
+	 * @brief Constructor starting the render thread
+	 *
+	 * @param canvas The Canvas rendered by the thread, it has to outlive the renderer
+	 */
+	explicit CanvasRenderer(Canvas &canvas);
+
+	CanvasRenderer(const CanvasRenderer &) = delete;
+	CanvasRenderer &operator=(const CanvasRenderer &) = delete;
+
+	/**
+	 * @brief Destructor stopping the render thread after the frame in progress
+	 */
+	~CanvasRenderer();
+
+	/**
+	 * @brief Gives the thread the state of the timeline the next frame is rendered at
+	 *
+	 * @param playback Time, frames and play status of the timeline, copied
+	 *
+	 * Never waits for the thread, states submitted while a frame is being rendered
+	 *   are merged and only the last one is rendered.
+	 */
+	void submit(const PlaybackCursor &playback);
+
+	/**
+	 * @brief Changes the Canvas while the render thread does not use it
+	 *
+	 * @param change Function changing the Canvas
+	 *
+	 * Waits for the frame in progress, afterwards a new frame is rendered.
+	 */
+	void modify(const std::function<void(Canvas &)> &change);
+
+	/**
+	 * @brief Checks whether a frame is being rendered or waits to be presented
+	 *
+	 * @return True until the frame of the last submitted state is presented
+	 */
+	bool isBusy() const;
+
+	/**
+	 * @brief Takes the most recently finished frame, meant for the window thread
+	 *
+	 * @return The frame, nullptr if no frame was finished yet
+	 */
+	const sf::Texture *acquireFrame();
+
+private:
+	void run();///> Body of the render thread
+	void renderFrame(const PlaybackCursor &input);///> Renders the Canvas at the state and publishes the frame
+
+	Canvas &m_canvas;///> The rendered Canvas
+	std::mutex m_canvasMutex;///> Held by whoever uses the Canvas
+	mutable std::mutex m_inputMutex;///> Guards the input and the flags below
+	std::condition_variable m_wake;///> Wakes the thread when there is something to render
+	PlaybackCursor m_input;///> Last submitted state
+	bool m_changed;///> Whether the Canvas or the state changed since the last rendered frame
+	bool m_stop;///> Whether the thread has to end
+	std::atomic<bool> m_rendering;///> Whether a frame is being rendered
+	TripleBuffer<std::unique_ptr<sf::Texture>> m_frames;///> Finished frames
+	MemoryCharge m_framesCharge;///> The three frames accounted to the GUI
+	bool m_hasFrame;///> Whether the window thread took any frame yet
+	std::thread m_thread;///> The render thread, started last
+};
@@ -131,11 +131,18 @@ public:
 	void update(sf::Vector2i mousePos, sf::Event &event) override;
 
 	/**
-	 * @brief Renders this instance of the dropdown on sf::RenderTarget.
+	 * @brief Adds this instance of the dropdown to the batch.
 	 *
-	 * @param target The target which the dropdown is rendered on.
+	 * @param target The batch which the dropdown is added to.
 	 */
-	void render(sf::RenderTarget *target) override;
+	void batch(GuiBatch &target) const override;
+
+	/**
+	 * @brief Getter to a value summarizing the look of the dropdown, including its choices while it is dropped.
+	 *
+	 * @return The look key.
+	 */
+	std::size_t getLookKey() const override;
 
 private:
 	sf::RectangleShape m_background;
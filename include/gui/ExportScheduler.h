@@ -0,0 +1,151 @@
+#pragma once
+
+#include "Canvas.h"
+#include "../animation/TransitionGraph.h"
+
+#include <future>
+
+/**
+ * @brief One animation exported by the scheduler
+ */
+struct ExportJob
+{
+	std::string start;///> Path to the starting image
+	std::string end;///> Path to the ending image
+	std::size_t animation = 0u;///> Index of the animation in ANIMATIONS
+	std::string graph;///> Animations combined as described for TransitionGraph::parse, replaces the animation unless empty
+	unsigned frames = 15u;///> Amount of rendered frames
+	float length = 1.f;///> Length of the animation in seconds
+	unsigned subframes = 1u;///> Instants averaged into every frame for motion blur, 1 for sharp frames
+	std::function<void(AnyAnimation &)> setup;///> Optional change of the animation's parameters
+	std::shared_ptr<const RawSequence> sequence;///> Exported sequence played instead of the animation, nullptr for none
+	std::function<std::unique_ptr<FrameSink>()> sink;///> Creates the sink the frames are written to, called when the job starts
+};
+
+/**
+ * @brief State of the export passed to the progress function
+ */
+struct ExportProgress
+{
+	std::size_t job;///> Index of the job the report is about
+	bool jobFinished;///> Whether the job has just been finished, otherwise one of its frames was rendered
+	std::size_t finishedJobs;///> Amount of finished jobs
+	std::size_t jobCount;///> Amount of all jobs
+	std::size_t renderedFrames;///> Amount of frames rendered by all jobs
+	std::size_t frameCount;///> Amount of frames of all jobs
+};
+
+/**
+ * @brief Renders many export jobs at once, every worker with its own Canvas
+ *
+ * Every worker thread owns an offscreen Canvas, so its render texture and OpenGL
+ *   context, and renders whole jobs one after another. Jobs are dealt to the
+ *   workers up front, jobs animating the same images go to the same worker, so
+ *   its canvas keeps the images loaded between them. A worker which runs out
+ *   of jobs steals the last ones of another worker.
+ *
+ * Images shared by several jobs are decoded once: the first worker needing an
+ *   image decodes it while the others wait for it, and the scheduler holds it
+ *   until the last job using it is finished.
+ */
+class ExportScheduler
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param size Size of the rendered frames
+	 */
+	explicit ExportScheduler(const sf::Vector2u &size);
+
+	/**
+	 * @brief Sets the amount of worker threads
+	 *
+	 * @param workers Amount of workers, 0 picks the amount of cores; never more than the amount of jobs run
+	 */
+	void setWorkerCount(const unsigned workers);
+
+	/**
+	 * @brief Sets whether pixel animations are computed by their shaders
+	 *
+	 * @param use_shader True for shaders, false for the CPU
+	 */
+	void setUseShaders(const bool use_shader);
+
+	/**
+	 * @brief Sets whether pixel animations computed on the CPU work on premultiplied alpha
+	 *
+	 * @param premultiplied True for premultiplied alpha
+	 */
+	void setPremultipliedAlpha(const bool premultiplied);
+
+	/**
+	 * @brief Sets the cache the jobs are replayed from and stored to
+	 *
+	 * @param cache The cache, nullptr renders every job; it has to outlive the runs using it
+	 */
+	void setCache(SequenceCache *cache);
+
+	/**
+	 * @brief Adds a job run by the next run
+	 *
+	 * @param job The job
+	 *
+	 * @return Index of the job, the one reported in the progress
+	 */
+	std::size_t addJob(ExportJob job);
+
+	/**
+	 * @brief Getter to the amount of added jobs
+	 *
+	 * @return The amount of jobs
+	 */
+	std::size_t getJobCount() const;
+
+	/**
+	 * @brief Renders all added jobs and forgets them afterwards
+	 *
+	 * @param progress Optional function called after every rendered frame and every finished job,
+	 *   calls never overlap but they come from the worker threads
+	 *
+	 * Returns once every job is finished. A failed job does not stop the others,
+	 *   the first exception is rethrown after all of them end.
+	 */
+	void run(const std::function<void(const ExportProgress &)> &progress = nullptr);
+
+private:
+	struct Queue
+	{
+		std::deque<std::size_t> jobs;///> Indices of the jobs left to this worker
+		std::mutex mutex;///> Guards the jobs
+	};
+
+	struct Source
+	{
+		std::size_t users = 0u;///> Amount of jobs left which show the image
+		std::shared_future<ImageStore::Handle> image;///> The image, valid once its decoding started
+	};
+
+	void work(const std::size_t worker);///> Loop of a worker rendering jobs until none is left to take or steal
+	bool take(const std::size_t worker, std::size_t &job);///> Takes the next job of the worker or steals one of another worker
+	void render(Canvas &canvas, const std::size_t job);///> Renders one job on the canvas of the worker
+	ImageStore::Handle acquire(const Canvas &canvas, const std::string &path);///> Gets the image shared by the jobs, decoding it only once
+	void release(const std::string &path);///> Lets the image go once no job left shows it
+	void report(const std::size_t job, const bool finished);///> Counts the progress and passes it to the progress function
+
+	sf::Vector2u m_size;///> Size of the rendered frames
+	unsigned m_workerCount;///> Requested amount of workers, 0 for the amount of cores
+	bool m_useShaders;///> Whether pixel animations are computed by their shaders
+	bool m_premultiplied;///> Whether pixel animations computed on the CPU work on premultiplied alpha
+	SequenceCache *m_cache;///> Cache of rendered sequences, nullptr if every job is rendered
+	std::vector<ExportJob> m_jobs;///> Added jobs
+
+	std::vector<std::unique_ptr<Queue>> m_queues;///> Jobs left to every worker while running
+	std::map<std::string, Source> m_sources;///> Images shown by the jobs while running, by their path
+	std::mutex m_sourcesMutex;///> Guards the sources
+
+	const std::function<void(const ExportProgress &)> *m_progress;///> Progress function of the run
+	ExportProgress m_state;///> Progress of the run
+	std::mutex m_progressMutex;///> Guards the progress and serializes calls of the progress function
+	std::exception_ptr m_error;///> First exception thrown by a job, guarded by the progress mutex
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "../root/Graphics.h"
+#include "../util/Resources.h"
+
+#include <set>
+
+/**
+ * @brief The font of the GUI, loaded once and shared by all texts
+ *
+ * Glyphs are rasterized by the font into one texture page per character size,
+ *   so texts sharing the font share their glyphs as well. Sizes used by the GUI
+ *   are prepared up front, building or rebuilding menus then only looks glyphs up.
+ */
+class FontCache
+{
+public:
+	FontCache(const FontCache &) = delete;
+	FontCache &operator=(const FontCache &) = delete;
+
+	/**
+	 * @brief Getter to the cache shared by the whole application
+	 *
+	 * @return The cache
+	 */
+	static FontCache &shared();
+
+	/**
+	 * @brief Getter to the font of the GUI, loaded on first use
+	 *
+	 * @return The font, Noir from the resources or the embedded Terminus if Noir fails to load
+	 */
+	std::shared_ptr<sf::Font> getFont();
+
+	/**
+	 * @brief Rasterizes the printable ASCII characters at a size, unless it was done already
+	 *
+	 * @param size The character size in pixels
+	 * @param bold Whether the bold glyphs are rasterized
+	 */
+	void prepare(const unsigned size, const bool bold);
+
+private:
+	FontCache();
+
+	std::shared_ptr<sf::Font> m_font;///> The font, nullptr until first used
+	std::set<std::pair<unsigned, bool>> m_prepared;///> Sizes and styles already rasterized
+};
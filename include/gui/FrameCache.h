@@ -0,0 +1,135 @@
+#pragma once
+
+#include "../root/Graphics.h"
+#include "../util/MemoryBudget.h"
+
+#include <list>
+#include <map>
+
+/**
+ * @brief Cache of already rendered frames of the animation
+ *
+ * Frames are kept as textures, keyed by their index on the timeline, so showing
+ *   a cached frame is just a texture swap. Memory taken by the textures is kept
+ *   under the budget by evicting the least recently used frames.
+ */
+class FrameCache
+{
+public:
+	/**
+	 * @brief Default budget of the cache in bytes
+	 */
+	static constexpr std::size_t DEFAULT_BUDGET = 256u * 1024u * 1024u;
+
+	/**
+	 * @brief Constructor setting the memory budget
+	 *
+	 * @param budget Maximal amount of bytes taken by the cached frames, 0 disables the cache
+	 */
+	explicit FrameCache(const std::size_t budget = FrameCache::DEFAULT_BUDGET);
+
+	/**
+	 * @brief Sets the memory budget, evicting frames which do not fit into it anymore
+	 *
+	 * @param budget Maximal amount of bytes taken by the cached frames, 0 disables the cache
+	 */
+	void setBudget(const std::size_t budget);
+
+	/**
+	 * @brief Getter to the memory budget
+	 *
+	 * @return The budget in bytes
+	 */
+	std::size_t getBudget() const;
+
+	/**
+	 * @brief Getter to the memory taken by cached frames
+	 *
+	 * @return Amount of bytes (4 per pixel)
+	 */
+	std::size_t getUsage() const;
+
+	/**
+	 * @brief Getter to the amount of cached frames
+	 *
+	 * @return The amount of frames
+	 */
+	std::size_t getCount() const;
+
+	/**
+	 * @brief Checks whether the cache is able to hold any frame
+	 *
+	 * @return True if the budget is not 0
+	 */
+	bool isEnabled() const;
+
+	/**
+	 * @brief Checks whether the frame is cached without marking it as used
+	 *
+	 * @param frame Index of the frame
+	 *
+	 * @return True if cached, false otherwise
+	 */
+	bool contains(const unsigned frame) const;
+
+	/**
+	 * @brief Checks whether a frame of given size fits into the budget without evicting any other
+	 *
+	 * @param size Size of the frame in pixels
+	 *
+	 * @return True if it fits, false otherwise
+	 */
+	bool hasRoomFor(const sf::Vector2u &size) const;
+
+	/**
+	 * @brief Finds the frame and marks it as the most recently used one
+	 *
+	 * @param frame Index of the frame
+	 *
+	 * @return Pointer to the cached texture, nullptr if the frame is not cached
+	 *
+	 * The pointer stays valid until the frame is evicted or the cache is cleared.
+	 */
+	const sf::Texture *find(const unsigned frame);
+
+	/**
+	 * @brief Stores copy of the texture as the frame, evicting least recently used frames if needed
+	 *
+	 * @param frame Index of the frame
+	 * @param texture The rendered frame
+	 *
+	 * @return Pointer to the cached texture, nullptr if the frame is bigger than the whole budget
+	 *
+	 * Textures of evicted frames of the same size are reused instead of being reallocated.
+	 */
+	const sf::Texture *store(const unsigned frame, const sf::Texture &texture);
+
+	/**
+	 * @brief Removes a frame from the cache
+	 *
+	 * @param frame Index of the frame, frames which are not cached are ignored
+	 */
+	void erase(const unsigned frame);
+
+	/**
+	 * @brief Removes all frames from the cache
+	 */
+	void clear();
+
+private:
+	struct Entry
+	{
+		unsigned frame;///> Index of the frame
+		std::unique_ptr<sf::Texture> texture;///> Rendered frame
+		std::size_t bytes;///> Memory taken by the texture
+	};
+
+	static std::size_t bytesOf(const sf::Vector2u &size);///> Memory taken by a texture of given size
+	std::unique_ptr<sf::Texture> evictFor(const std::size_t bytes, const sf::Vector2u &size);///> Evicts until bytes fit, returns evicted texture of given size if any
+
+	std::list<Entry> m_entries;///> Cached frames, the most recently used at the front
+	std::map<unsigned, std::list<Entry>::iterator> m_index;///> Cached frames by their index
+	std::size_t m_budget;///> Maximal amount of bytes taken by cached frames
+	std::size_t m_usage;///> Amount of bytes taken by cached frames
+	MemoryCharge m_charge;///> The same bytes accounted to the frame cache
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "../root/Graphics.h"
+
+/**
+ * @brief Collects the shapes, sprites and texts of the GUI and draws them in few draw calls
+ *
+ * Everything added is turned into triangles in one vertex array, in order of adding.
+ *   Consecutive parts using the same texture make a single draw call, so widgets
+ *   drawing from the same texture (an atlas, a font page) are sent together.
+ */
+class GuiBatch
+{
+public:
+	/**
+	 * @brief Default constructor creating an empty batch
+	 */
+	GuiBatch();
+
+	/**
+	 * @brief Removes everything added, the memory is kept for the next batch
+	 */
+	void clear();
+
+	/**
+	 * @brief Sets the texture untextured shapes are drawn from
+	 *
+	 * @param texture The texture, nullptr to draw shapes without any
+	 * @param white_pixel Texture coordinates of a white pixel in the texture
+	 * 
+	 * Shapes drawn from the same texture as the sprites (an atlas) share their
+	 *   draw calls.
+	 */
+	void setSolidTexture(const sf::Texture *texture, const sf::Vector2f &white_pixel);
+
+	/**
+	 * @brief Adds a convex shape with its fill and outline
+	 *
+	 * @param shape The shape, its texture is ignored
+	 */
+	void add(const sf::Shape &shape);
+
+	/**
+	 * @brief Adds a textured quad
+	 *
+	 * @param sprite The sprite, skipped if it has no texture
+	 */
+	void add(const sf::Sprite &sprite);
+
+	/**
+	 * @brief Adds the glyphs of a text in its fill color
+	 *
+	 * @param text The text, skipped if it has no font
+	 * 
+	 * Regular, bold and italic styles are laid out the way sf::Text does it, outlines
+	 *   and lines of underlined or struck out texts are not drawn.
+	 */
+	void add(const sf::Text &text);
+
+	/**
+	 * @brief Draws everything added to the target
+	 *
+	 * @param target The target
+	 * 
+	 * The batch is kept, it may be drawn again or cleared.
+	 */
+	void draw(sf::RenderTarget &target);
+
+	/**
+	 * @brief Getter to the amount of draw calls needed by the batch
+	 *
+	 * @return The amount of the draw calls
+	 */
+	std::size_t getDrawCallCount() const;
+
+private:
+	struct Range
+	{
+		const sf::Texture *texture;
+		std::size_t first;
+		std::size_t count;
+	};
+
+	void addQuad(const sf::Transform &transform, const sf::Vector2f (&corners)[4], const sf::Color &color,
+		const sf::Texture *texture = nullptr, const sf::FloatRect &texture_rect = sf::FloatRect());///> Adds two triangles, corners go clockwise from the top left one
+	void addTriangle(const sf::Transform &transform, const sf::Vector2f &a, const sf::Vector2f &b, const sf::Vector2f &c, const sf::Color &color);///> Adds an untextured triangle
+	void extendRange(const sf::Texture *texture, const std::size_t count);///> Puts the last added vertices into a range of the texture
+
+	std::vector<sf::Vertex> m_vertices;///> Triangles of everything added
+	std::vector<Range> m_ranges;///> Consecutive vertices drawn with the same texture
+	const sf::Texture *m_solidTexture;///> Texture untextured shapes are drawn from, nullptr if none
+	sf::Vector2f m_solidCoords;///> Texture coordinates of untextured shapes
+	sf::VertexBuffer m_buffer;///> Vertices on the GPU, used when vertex buffers are available
+	bool m_uploaded;///> Whether the buffer holds the current vertices
+};
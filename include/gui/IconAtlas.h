@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../root/Graphics.h"
+#include "../util/Resources.h"
+#include "../util/MemoryBudget.h"
+
+/**
+ * @brief Icons of the GUI
+ */
+enum class Icon
+{
+	PLAY = 0,		///> Starts the animation
+	PAUSE = 1,		///> Pauses the animation
+	NEXT = 2,		///> Skips to the next frame
+	PREVIOUS = 3,	///> Skips to the previous frame
+	SAVE = 4		///> Saves the animation
+};
+
+/**
+ * @brief One texture holding all icons of the GUI
+ *
+ * The icons are decoded once from the resources, packed into a single image and uploaded in one call,
+ *   widgets show sub-rectangles of it. Next to the icons there is a block of white
+ *   pixels, so untextured shapes can be drawn from the same texture and a batch
+ *   of the GUI does not break between shapes and icons.
+ */
+class IconAtlas
+{
+public:
+	IconAtlas(const IconAtlas &) = delete;
+	IconAtlas &operator=(const IconAtlas &) = delete;
+
+	/**
+	 * @brief Getter to the atlas shared by the whole application, built on first use
+	 *
+	 * @return The atlas
+	 */
+	static IconAtlas &shared();
+
+	/**
+	 * @brief Getter to the packed texture
+	 *
+	 * @return The texture
+	 */
+	const sf::Texture &getTexture() const;
+
+	/**
+	 * @brief Getter to the place of an icon in the texture
+	 *
+	 * @param icon The icon
+	 *
+	 * @return The rectangle of the icon, empty if it failed to load
+	 */
+	const sf::IntRect &getRect(const Icon icon) const;
+
+	/**
+	 * @brief Getter to texture coordinates of a white pixel
+	 *
+	 * @return The coordinates, in the middle of the white block
+	 */
+	sf::Vector2f getWhitePixel() const;
+
+	/**
+	 * @brief Makes the sprite show the icon
+	 *
+	 * @param sprite The sprite
+	 * @param icon The icon
+	 */
+	void apply(sf::Sprite &sprite, const Icon icon) const;
+
+private:
+	IconAtlas();///> Loads and packs all icons
+
+	static constexpr unsigned ICON_COUNT = 5u;///> Amount of the icons
+	static constexpr unsigned PADDING = 2u;///> Empty pixels between icons, no icon bleeds into another one when scaled
+	static constexpr unsigned WHITE_SIZE = 4u;///> Side of the white block
+
+	sf::Texture m_texture;///> The packed icons
+	std::array<sf::IntRect, ICON_COUNT> m_rects;///> Places of the icons, by their values
+	sf::IntRect m_white;///> Place of the white block
+	MemoryCharge m_memory;///> The texture accounted to the GUI
+};
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "Button.h"
+#include "ImageLoader.h"
+#include "ThumbnailLoader.h"
+
 /**
  * @brief      Class responsible for loading two images selected by the user to the program
  * 			   and displaying those images on auxiliary windows
@@ -36,20 +39,34 @@ public:
 	ImageButton(ImageButton &&source);
 
 	/**
-	 * @brief      Overrided function which renders(draws) the given target.
+	 * @brief      Overrided function which adds the button with its image to the batch.
 	 *
-	 * @param      RenderTarget The target on which the instatntion is rendered
+	 * @param      target The batch which the instatntion is added to
 	 */
-	void render(sf::RenderTarget *target) override;
+	void batch(GuiBatch &target) const override;
 
 	/**
      * @brief Method responsible for chosing the image from user's files, and displaying it on the auxiliary window
      *
      * @param mousePos The current mouse position 
      * @param event The event hedning clicing of the ImageButtion 
+     *
+     * The chosen image is loaded in the background while the placeholder is shown,
+     *   the button reports the change only once the image is loaded. The button
+     *   shows a thumbnail of its size, shrunk on a worker thread.
      */
 	void update(sf::Vector2i mousePos, sf::Event &event) override;
 
+	/**
+	 * @brief      Shows an image without loading it, e.g. the thumbnail of a slide of a project
+	 *
+	 * @param[in]  path       The path to the image
+	 * @param[in]  thumbnail  Image shown on the button, nullptr to make a thumbnail of the image in the background
+	 *
+	 * The button does not report a change, the image is already shown by the canvas.
+	 */
+	void setPreview(const std::string &path, const ImageStore::Handle &thumbnail);
+
 	/**
 	 * @brief      Returns the path to the chosen by user image.
 	 */
@@ -64,12 +81,28 @@ public:
 
 	/**
 	 * @brief     Function setting m_isChange on false, used by another class which uses ImageButton
+	 *
+	 * The loaded image is released, whoever read the change holds it from then on.
 	 */
 	void changeRead();
 
+	/**
+	 * @brief      Getter to a value summarizing the look of the button, including the shown image
+	 *
+	 * @return     The look key.
+	 */
+	std::size_t getLookKey() const override;
+
 private:
+	void showImage(const ImageStore::Handle &image); //shows the image on the button, scaled to its size
+	void requestThumbnail(const std::string &path); //starts making the thumbnail of the image at the size of the button
+
 	sf::Sprite m_spr; //sprite
-	sf::Texture m_texture; //texture
+	ImageStore::Handle m_placeholder; //image shown until the chosen one is loaded
+	ImageStore::Handle m_image; //last loaded image, held until the change is read
+	ImageStore::Handle m_thumbnail; //thumbnail shown on the button, nullptr while the placeholder is shown
+	std::unique_ptr<ImageLoader> m_loader; //loader of the chosen image, nullptr until an image is chosen
+	std::unique_ptr<ThumbnailLoader> m_thumbnailLoader; //loader of the thumbnail, nullptr until one is requested
 	std::string m_path; //string storing path to the image chosen by user
 	bool m_isChanged;	//bool type, true if user has selected a photo, false if user selected nothing
 };	
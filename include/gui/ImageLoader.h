@@ -0,0 +1,83 @@
+#pragma once
+
+#include "ImageStore.h"
+
+#include <future>
+
+/**
+ * @brief Loader decoding an image in the background and uploading it in chunks
+ *
+ * The file is decoded on a worker thread, so the window keeps responding while
+ *   a large photo is being read. Uploading to the GPU has to happen on the thread
+ *   owning the OpenGL context, so it is done by update, a band of rows per call.
+ *   The finished image is put into the ImageStore, loading the same path again
+ *   from anywhere else is then free.
+ */
+class ImageLoader
+{
+public:
+	/**
+	 * @brief Default amount of rows uploaded by one call of update
+	 */
+	static constexpr unsigned DEFAULT_ROWS_PER_UPDATE = 256u;
+
+	/**
+	 * @brief Constructor setting the size of the uploaded chunks
+	 *
+	 * @param rows_per_update Amount of rows uploaded by one call of update, at least 1
+	 * @param store Store the loaded images are put into
+	 */
+	explicit ImageLoader(const unsigned rows_per_update = ImageLoader::DEFAULT_ROWS_PER_UPDATE, ImageStore &store = ImageStore::shared());
+
+	ImageLoader(const ImageLoader &) = delete;
+	ImageLoader &operator=(const ImageLoader &) = delete;
+
+	/**
+	 * @brief Destructor waiting for the decoding still in progress
+	 */
+	~ImageLoader() = default;
+
+	/**
+	 * @brief Starts loading the image, replacing the one loaded so far
+	 *
+	 * @param path Path to the image file
+	 *
+	 * An image already in the store is returned by the next call of update
+	 *   without being decoded again.
+	 */
+	void request(const std::string &path);
+
+	/**
+	 * @brief Checks whether an image is being loaded
+	 *
+	 * @return True from the request until update returns the image
+	 */
+	bool isPending() const;
+
+	/**
+	 * @brief Getter to the path of the last requested image
+	 *
+	 * @return The path
+	 */
+	const std::string &getPath() const;
+
+	/**
+	 * @brief Continues loading, meant to be called every frame on the thread of the window
+	 *
+	 * @return Handle to the loaded image once it is complete, empty image if it failed
+	 *   to load, nullptr while it is still being loaded or when nothing was requested
+	 */
+	ImageStore::Handle update();
+
+private:
+	void dropAbandoned();///> Forgets decodings of replaced requests which already finished
+
+	ImageStore &m_store;///> Store the loaded images are put into
+	unsigned m_rowsPerUpdate;///> Amount of rows uploaded by one call of update
+	std::string m_path;///> Path of the last requested image
+	ImageStore::Handle m_ready;///> Image taken from the store, returned by the next update
+	std::future<sf::Image> m_decoding;///> Decoding of the requested image
+	std::vector<std::future<sf::Image>> m_abandoned;///> Decodings of replaced requests, waited for only when they finish
+	std::shared_ptr<StoredImage> m_uploading;///> Decoded image whose texture is being uploaded
+	unsigned m_uploadedRows;///> Amount of rows of the texture already uploaded
+};
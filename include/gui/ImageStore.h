@@ -0,0 +1,121 @@
+#pragma once
+
+#include "../root/Graphics.h"
+#include "../util/PixelKernels.h"
+#include "../util/ThreadPool.h"
+#include "../util/Resources.h"
+#include "../util/MemoryBudget.h"
+
+#include <map>
+
+/**
+ * @brief Decoded image shared by everything showing it
+ */
+struct StoredImage
+{
+	sf::Image pixels;///> Decoded pixels, kept on the CPU so they never have to be read back from the GPU
+	sf::Texture texture;///> The same pixels uploaded to the GPU
+	mutable MemoryCharge memory = MemoryCharge(MemorySubsystem::IMAGES);///> Memory of both accounted to the images, set when the image is stored
+};
+
+/**
+ * @brief Store of decoded images keyed by their path
+ *
+ * Every image is decoded and uploaded once, however many thumbnails, canvases
+ *   and animations show it. The store hands out shared handles and keeps only
+ *   weak references to the images, so an image is freed as soon as nothing
+ *   holds its handle anymore.
+ *
+ * The store may be used from any thread, canvases exporting in parallel share it.
+ *   Two threads missing the same path at once may both decode it, the first one
+ *   inserted is kept and handed to both.
+ */
+class ImageStore
+{
+public:
+	/**
+	 * @brief Shared handle to a stored image
+	 */
+	using Handle = std::shared_ptr<const StoredImage>;
+
+	/**
+	 * @brief Default constructor creating an empty store
+	 */
+	ImageStore();
+
+	ImageStore(const ImageStore &) = delete;
+	ImageStore &operator=(const ImageStore &) = delete;
+
+	/**
+	 * @brief Store shared by the whole application
+	 *
+	 * @return The shared store
+	 */
+	static ImageStore &shared();
+
+	/**
+	 * @brief Gets the image of given path, decoding it only if it is not stored yet
+	 *
+	 * @param path Path to the image file, or a resource path like "res:images/example1.jpg"
+	 *
+	 * @return Handle to the image, never nullptr
+	 *
+	 * An image which fails to load is returned empty and is not stored, so the
+	 *   next call tries to load it again.
+	 */
+	Handle load(const std::string &path);
+
+	/**
+	 * @brief Gets the image of given path shrunk to fit into the size
+	 *
+	 * @param path Path to the image file
+	 * @param size Size the image is shown at, the original is returned if it is not bigger
+	 *
+	 * @return Handle to the image, never nullptr
+	 *
+	 * Every axis bigger than the size is shrunk to it by averaging blocks of pixels,
+	 *   so animations working on the image cost as much as the frames they produce.
+	 *   Shrunk images are stored separately for every size.
+	 */
+	Handle load(const std::string &path, const sf::Vector2u &size);
+
+	/**
+	 * @brief Gets the image of given path only if it is already stored
+	 *
+	 * @param path Path to the image file
+	 *
+	 * @return Handle to the image, nullptr if it is not stored
+	 */
+	Handle find(const std::string &path);
+
+	/**
+	 * @brief Stores an image decoded elsewhere, for example by ImageLoader
+	 *
+	 * @param path Path to the image file
+	 * @param image The decoded and uploaded image
+	 *
+	 * @return Handle to the stored image, the one stored before if the path was loaded meanwhile
+	 */
+	Handle insert(const std::string &path, Handle image);
+
+	/**
+	 * @brief Getter to the amount of stored images
+	 *
+	 * @return The amount of images somebody holds a handle to
+	 */
+	std::size_t getCount();
+
+	/**
+	 * @brief Getter to the memory taken by stored images
+	 *
+	 * @return Amount of bytes of the decoded pixels and of the textures (4 per pixel each)
+	 */
+	std::size_t getUsage();
+
+private:
+	void purge();///> Forgets images nobody holds a handle to
+	static std::string keyOf(const std::string &path);///> Normalized path the image is stored by
+
+	std::map<std::string, std::weak_ptr<const StoredImage>> m_images;///> Stored images by their normalized path
+	std::mutex m_mutex;///> Guards the stored images, decoding happens outside of it
+};
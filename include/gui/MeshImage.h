@@ -0,0 +1,144 @@
+#pragma once
+
+#include "../util/ExtendedMath.h"
+#include "ImageStore.h"
+
+/**
+ * @brief Points of a MeshImage given to the warp, one array per coordinate
+ *
+ * Points go row by row from the top-left corner, (columns + 1) in a row and
+ *   (rows + 1) rows. The rest position is the undeformed grid in pixels, the
+ *   warp writes the deformed positions, local to the image like the rest ones.
+ */
+struct MeshPoints
+{
+	const float *restX;///> X of the points of the undeformed grid
+	const float *restY;///> Y of the points of the undeformed grid
+	float *x;///> X of the deformed points, filled with the rest ones before the warp
+	float *y;///> Y of the deformed points, filled with the rest ones before the warp
+	float *z;///> Depth of the deformed points, filled with 0 before the warp
+	std::size_t count;///> Amount of points
+	unsigned columns;///> Amount of cells in a row
+	unsigned rows;///> Amount of rows of cells
+};
+
+/**
+ * @brief Image drawn as a grid of cells whose points may be moved one by one
+ *
+ * Meant for ripples, page curls and other per-vertex transitions. Positions are
+ *   kept as arrays of coordinates (structure of arrays), so a frame deforms and
+ *   transforms all points in tight loops the compiler vectorizes, split among
+ *   the threads of the pool for fine meshes. Texture coordinates are set once;
+ *   frames only rewrite the positions of the vertex buffer.
+ *
+ * Like AnimatedImage drawn without shaders, depth only comes along for the warp
+ *   and the getters, points are drawn at their x and y.
+ */
+class MeshImage
+{
+public:
+	/**
+	 * @brief Function deforming the points of the mesh, called once per update
+	 */
+	using Warp = std::function<void(MeshPoints &)>;
+
+	/**
+	 * @brief Constructor creating the mesh of an image with its own texture
+	 *
+	 * @param position The position of the top-left corner of the image
+	 * @param texture Texture of the image
+	 * @param size Size the image is drawn at, the size of the texture if it is (0, 0)
+	 * @param cells Amount of cells along the width and the height, at least one each
+	 */
+	explicit MeshImage(
+		const sf::Vector2f &position,
+		std::unique_ptr<sf::Texture> texture,
+		const sf::Vector2f &size = sf::Vector2f(),
+		const sf::Vector2u &cells = sf::Vector2u(64u, 64u));
+
+	/**
+	 * @brief Constructor creating the mesh of an image of ImageStore
+	 *
+	 * @param position The position of the top-left corner of the image
+	 * @param image The stored image, its texture is shared with others showing it
+	 * @param size Size the image is drawn at, the size of the texture if it is (0, 0)
+	 * @param cells Amount of cells along the width and the height, at least one each
+	 */
+	explicit MeshImage(
+		const sf::Vector2f &position,
+		ImageStore::Handle image,
+		const sf::Vector2f &size = sf::Vector2f(),
+		const sf::Vector2u &cells = sf::Vector2u(64u, 64u));
+
+	MeshImage(const MeshImage &) = delete;
+	MeshImage &operator=(const MeshImage &) = delete;
+
+	/**
+	 * @brief Getter to the amount of cells along the width and the height
+	 *
+	 * @return The amount of cells
+	 */
+	const sf::Vector2u &getCells() const;
+
+	/**
+	 * @brief Getter to the amount of points of the grid
+	 *
+	 * @return (cells.x + 1) * (cells.y + 1)
+	 */
+	std::size_t getPointCount() const;
+
+	/**
+	 * @brief Getter to a point of the mesh as it was placed by the last update
+	 *
+	 * @param index Index of the point, row by row from the top-left corner
+	 *
+	 * @return Position of the point, z being its depth
+	 */
+	sf::Vector3f getPoint(const std::size_t index) const;
+
+	/**
+	 * @brief Places the points of the mesh for the next render
+	 *
+	 * @param transform Transform of the whole image, pivoting around its top-left corner like in AnimatedImage
+	 * @param warp Optional deformation applied to the points before the transform
+	 *
+	 * Without a warp nothing is recomputed while the transform stays the same.
+	 */
+	void update(const em::Matrix4f &transform = em::Matrix4f(), const Warp &warp = nullptr);
+
+	/**
+	 * @brief Renders the mesh to the target
+	 *
+	 * @param target Rendering target
+	 * @param shader Shader applied to the texture, nullptr draws it as it is
+	 * @param blend Blending with the target
+	 *
+	 * Positions changed since the last render are uploaded to the vertex buffer
+	 *   first, without vertex buffers the vertices are drawn from the memory.
+	 */
+	void render(sf::RenderTarget *target, const sf::Shader *shader = nullptr, const sf::BlendMode &blend = sf::BlendAlpha);
+
+private:
+	void build(const sf::Vector2f &position, const sf::Vector2f &size);///> Creates the rest grid, the triangles and their texture coordinates
+	void place(const em::Matrix4f &transform, const Warp &warp);///> Deforms and transforms the points and writes them to the triangles
+
+	std::shared_ptr<const sf::Texture> m_texture;///> Texture drawn on the mesh
+	ImageStore::Handle m_source;///> Stored image the texture belongs to, nullptr for textures given by the caller
+	sf::Vector2u m_cells;///> Amount of cells along the width and the height
+	sf::Vector2f m_position;///> Top-left corner the transform pivots around
+
+	std::vector<float> m_restX;///> X of the points of the undeformed grid
+	std::vector<float> m_restY;///> Y of the points of the undeformed grid
+	std::vector<float> m_x;///> X of the placed points
+	std::vector<float> m_y;///> Y of the placed points
+	std::vector<float> m_z;///> Depth of the placed points
+
+	std::vector<std::uint32_t> m_corners;///> Index of the point of every vertex of the triangles
+	std::vector<sf::Vertex> m_vertices;///> Vertices of the triangles, texture coordinates are set once
+	sf::VertexBuffer m_buffer;///> The vertices on the GPU, unused if vertex buffers are not available
+	bool m_useBuffer;///> Whether the vertex buffer was created
+	bool m_uploaded;///> Whether the vertex buffer holds the current positions
+
+	em::Matrix4f m_transform;///> Transform the points are currently placed with
+	bool m_warped;///> Whether the points were deformed by the last update
+};
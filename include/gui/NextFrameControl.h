@@ -32,12 +32,6 @@ public:
 	 */
 	static NextFrameControl* makePreviousFrameButton(const sf::Vector2f &pos);
 
-	/**
-	 * @brief      Renders button in target
-	 *
-	 * @param      target  The target
-	 */
-	void render(sf::RenderTarget *target) override;
 
 	/**
 	 * @brief      Updates state and look of button 
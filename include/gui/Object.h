@@ -1,6 +1,6 @@
 #pragma once
 
-#include "../root/Root.h"
+#include "../root/Graphics.h"
 
 /**
  * @brief Abstract class describing all objects appearing on the screen
@@ -87,7 +87,27 @@ public:
 	 */
 	virtual void update(sf::Vector2i mousePos, sf::Event &event) = 0;
 
+	/**
+	 * @brief Getter to a value summarizing how the object looks
+	 *
+	 * @return The value, it changes whenever the object would be drawn differently
+	 * 
+	 * Panels compare it to find out whether their cached contents are outdated,
+	 *   deriving classes add everything else their look depends on.
+	 */
+	virtual std::size_t getLookKey() const;
+
 protected:
+	/**
+	 * @brief Mixes a value into a look key
+	 *
+	 * @param key The key
+	 * @param value The value
+	 *
+	 * @return The new key
+	 */
+	static std::size_t combineLook(const std::size_t key, const std::size_t value);
+
 	sf::RectangleShape m_shape;///> Rectangle defining object's shape
 
 private:
@@ -1,8 +1,15 @@
 #pragma once
 #include "Object.h"
+#include "GuiBatch.h"
+#include "../util/MemoryBudget.h"
 
 /**
  * @brief      This class describes base(empty) panel.
+ * 
+ * Deriving panels may keep their static contents in a layer: widgets given to
+ *   track are added by renderStatic to one batch drawn into a texture, which is
+ *   drawn again only when the look key of any of them changes. Otherwise the panel
+ *   costs a single sprite.
  */
 class Panel : public Object
 {
@@ -35,4 +42,34 @@ class Panel : public Object
 	 */
 	void render(sf::RenderTarget *target) override;
 
+	protected:
+	/**
+	 * @brief      Adds a widget, whose changes outdate the layer
+	 *
+	 * @param      widget  The widget, owned by the deriving panel
+	 */
+	void track(const Object *widget);
+
+	/**
+	 * @brief      Draws the static contents of the panel, to the layer when it is outdated
+	 *
+	 * @param      target  The target
+	 */
+	void renderLayer(sf::RenderTarget *target);
+
+	/**
+	 * @brief      Adds contents kept in the layer to the batch, the background of the panel by default
+	 *
+	 * @param      target  The batch, positioned the same way as the window
+	 */
+	virtual void renderStatic(GuiBatch &target) const;
+
+	private:
+	sf::RenderTexture m_layer; ///> Texture the static contents are kept in
+	sf::Sprite m_layerBody; ///> Sprite showing the layer
+	GuiBatch m_batch; ///> Batch of the static contents, reused between drawings of the layer
+	std::vector<std::pair<const Object *, std::size_t>> m_tracked; ///> Tracked widgets with their look keys at the last drawing of the layer
+	bool m_layerOutdated; ///> Whether the layer has to be drawn again
+	MemoryCharge m_layerCharge; ///> The layer accounted to the GUI
+
 };
@@ -69,6 +69,12 @@ public:
 	 * @return     The DropdownList handling frames choices.
 	 */
 	DropdownList* getFramesChoice();
+	/**
+	 * @brief      Getter for the DropdownList handling export format choices
+	 *
+	 * @return     The DropdownList handling export format choices.
+	 */
+	DropdownList* getFormatChoice();
 	/**
 	 * @brief      Function checking if there has been any change in any of the objects,calls the "isChanged()" method for each object
 	 *
@@ -81,12 +87,25 @@ public:
 	void changesRead();
 
 protected:
+	/**
+	 * @brief      Adds the panel with all its widgets to the batch kept in the layer of the panel
+	 *
+	 * @param      target  The batch
+	 */
+	void renderStatic(GuiBatch &target) const override;
+
+	/**
+	 * @brief      Locks the dropdown lists and the save button covered by a dropped list
+	 */
+	void updateLocks();
+
 	ImageButton *m_imageUp; //new ImageButton handling first Image
 	ImageButton *m_imageDown; //new ImageButton handling second Image
 	SaveButton *m_saveButton; //new SaveButton handling saving every frame to file
 
 	DropdownList *m_animationChoice;//new DropdownList handling selection of animation
 	DropdownList *m_framesChoice;//new DropdownList handling selection of quantity of frames
+	DropdownList *m_formatChoice;//new DropdownList handling selection of format the animation is saved in
 	
 	std::shared_ptr<sf::Font> font;
 
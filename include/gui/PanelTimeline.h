@@ -4,7 +4,7 @@
 #include "StartStopControl.h"
 #include "NextFrameControl.h"
 #include "Timeline.h"
-#include "Canvas.h"
+#include "CanvasRenderer.h"
 
 
 /**
@@ -65,10 +65,17 @@ public:
 	/**
 	 * @brief Getter to the canvas.
 	 *
-	 * @return The canvas.
+	 * @return The canvas, it may be changed only through modifyCanvas.
 	 */
 	Canvas* getCanvas();
 
+	/**
+	 * @brief Changes the canvas while its render thread does not use it
+	 *
+	 * @param change Function changing the canvas
+	 */
+	void modifyCanvas(const std::function<void(Canvas &)> &change);
+
 	/**
 	 * @brief updating state and look of whole panel 
 	 *
@@ -83,6 +90,8 @@ public:
 	 * - updating time and animation,
 	 * - updating animation depending of set of timeline cursor 
 	 * 
+	 * The canvas is rendered on its own thread, the panel only hands it the state
+	 *   of the timeline and requests updates until the frame is shown.
 	 */
 	void update(sf::Vector2i mousePos, sf::Event &event, const float &deltaTime);
 	
@@ -93,10 +102,25 @@ public:
 	 */
 	void render(sf::RenderTarget *target) override;
 
+	/**
+	 * @brief Renders only the frame of the canvas, without the panel and the timeline
+	 *
+	 * @param target The target
+	 */
+	void renderCanvas(sf::RenderTarget *target);
+
 protected:
+	/**
+	 * @brief Adds the panel with its buttons to the batch kept in the layer of the panel
+	 *
+	 * @param target The batch
+	 */
+	void renderStatic(GuiBatch &target) const override;
+
 	StartStopControl* m_control;
 	NextFrameControl* m_next;
 	NextFrameControl* m_prev;
 	Canvas* m_canvas;
+	CanvasRenderer* m_renderer;
 	Timeline* m_timeline;
 }; 
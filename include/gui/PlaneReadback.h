@@ -0,0 +1,98 @@
+#pragma once
+
+#include "../root/Graphics.h"
+#include "../export/FrameSink.h"
+
+#include <array>
+
+/**
+ * @brief Reads rendered frames back from the GPU without waiting for each of them
+ *
+ * Reading the pixels of a render texture straight into memory stalls until the
+ *   GPU has drawn them. Reads are issued into a ring of pixel buffer objects
+ *   instead, and a frame is mapped only once DEPTH further reads were issued,
+ *   so the GPU draws the next frames while the earlier ones are copied back.
+ *   Consumers receive the frames in the order they were read, DEPTH of them late.
+ *
+ * Contexts without pixel buffer objects read every frame right away.
+ *   All calls have to be made on the thread the render textures are drawn on.
+ */
+class PlaneReadback : sf::GlResource
+{
+public:
+	static constexpr std::size_t DEPTH = 3u;///> Reads in flight before the oldest one is mapped
+
+	using Consumer = std::function<void(ExportFrame)>;///> Receives frames read back from the GPU
+
+	/**
+	 * @brief Constructor of a readback handing out frames from the pool
+	 *
+	 * @param pool Pool the buffers of the frames are taken from, has to outlive the readback
+	 */
+	explicit PlaneReadback(BufferPool &pool);
+
+	PlaneReadback(const PlaneReadback &) = delete;
+	PlaneReadback &operator=(const PlaneReadback &) = delete;
+
+	/**
+	 * @brief Destructor deleting the pixel buffers, frames still in flight are dropped
+	 */
+	~PlaneReadback();
+
+	/**
+	 * @brief Issues the read of a rendered frame
+	 *
+	 * @param plane Render texture holding the frame, it is activated on the calling thread
+	 * @param consumer Receives the oldest frame in flight once the ring is full, or the
+	 *   frame itself without pixel buffer objects
+	 *
+	 * Throws std::runtime_error if the plane cannot be activated or a frame cannot be mapped.
+	 */
+	void read(sf::RenderTexture &plane, const Consumer &consumer);
+
+	/**
+	 * @brief Hands out all frames in flight
+	 *
+	 * @param consumer Receives the frames, oldest first
+	 *
+	 * Throws std::runtime_error if a frame cannot be mapped.
+	 */
+	void finish(const Consumer &consumer);
+
+	/**
+	 * @brief Drops all frames in flight, after a sequence was abandoned
+	 */
+	void discard();
+
+	/**
+	 * @brief Checks whether frames are read through pixel buffer objects
+	 *
+	 * @return True if reads do not wait for the GPU, known after the first read
+	 */
+	bool isAsynchronous() const;
+
+	/**
+	 * @brief Getter to the memory of the pixel buffers
+	 *
+	 * @return Amount of bytes allocated on the GPU
+	 */
+	std::size_t getBufferBytes() const;
+
+private:
+	struct Slot
+	{
+		unsigned buffer = 0u;///> Name of the pixel buffer object, 0 if it was not created yet
+		std::size_t capacity = 0u;///> Bytes allocated in the pixel buffer
+		sf::Vector2u size;///> Size of the frame read into the buffer
+	};
+
+	void loadFunctions();///> Looks up the functions of pixel buffer objects, once
+	void map(Slot &slot, const Consumer &consumer);///> Copies the frame of the slot into a buffer of the pool and hands it out
+
+	BufferPool &m_pool;///> Pool the frames are taken from
+	bool m_loaded;///> Whether the functions were looked up
+	bool m_asynchronous;///> Whether all functions of pixel buffer objects are available
+	std::array<Slot, DEPTH> m_slots;///> Ring of pixel buffers
+	std::size_t m_next;///> Slot the next read goes to
+	std::size_t m_pending;///> Reads in flight, ending right before the next slot
+};
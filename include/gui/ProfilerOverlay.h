@@ -0,0 +1,51 @@
+#pragma once
+
+#include "GuiBatch.h"
+#include "../util/Profiler.h"
+#include "../util/MemoryBudget.h"
+
+/**
+ * @brief On-screen view of the shared profiler
+ *
+ * Lists the time of every section during the last frame with its moving average
+ *   and draws the recent frame times as a bar graph, with a line at the budget of
+ *   a 60 Hz frame. Below it lists the CPU and GPU memory of every subsystem against
+ *   the memory budget. Everything is drawn in one batch on top of the window.
+ */
+class ProfilerOverlay
+{
+public:
+	/**
+	 * @brief Constructor of a hidden overlay
+	 *
+	 * @param pos Position of the top-left corner in the window
+	 */
+	explicit ProfilerOverlay(const sf::Vector2f &pos = sf::Vector2f(10.f, 10.f));
+
+	/**
+	 * @brief Shows or hides the overlay, collecting of the profiler follows it
+	 *
+	 * @param visible Whether the overlay is shown
+	 */
+	void setVisible(const bool visible);
+
+	/**
+	 * @brief Checks whether the overlay is shown
+	 *
+	 * @return True if shown
+	 */
+	bool isVisible() const;
+
+	/**
+	 * @brief Draws the overlay from the current state of the profiler
+	 *
+	 * @param target Target the overlay is drawn on
+	 */
+	void render(sf::RenderTarget *target);
+
+private:
+	sf::Vector2f m_position;///> Top-left corner of the overlay
+	bool m_visible;///> Whether the overlay is shown
+	std::shared_ptr<sf::Font> m_font;///> Font of the section list
+	GuiBatch m_batch;///> Batch rebuilt every frame the overlay is drawn
+};
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "SlideDeck.h"
+
+/**
+ * @brief Project of the application: the deck, its transitions and export presets, with thumbnails of the slides
+ *
+ * A project is a text file of "key = value" lines, read at once when it is opened:
+ *
+ *   version = 1
+ *   export = "default" 1 15					name, format and frames of an export preset
+ *   slide = "images/a.jpg"						first slide
+ *   thumbnail = 8204-13317 iVBORw0KGgo...		stamp of the file and PNG of the slide before, in base64
+ *   slide = "images/b.jpg" alfa 1.5			slide with the animation and length leading to it
+ *
+ * Relative paths are relative to the project file. Only the text is parsed when a
+ *   project is opened: images are decoded by the deck when they are first shown,
+ *   thumbnails when they are first asked for. A thumbnail is valid while the size
+ *   and the modification time of its image, its stamp, are the same as at saving.
+ *   Saving creates the missing and outdated thumbnails.
+ */
+class Project
+{
+public:
+	static constexpr const char *EXTENSION = ".bcgproj";///> Extension of project files
+	static constexpr unsigned VERSION = 1u;///> Version of the files written, newer ones are not read
+	static constexpr unsigned THUMBNAIL_WIDTH = 256u;///> Biggest width of the thumbnails
+	static constexpr unsigned THUMBNAIL_HEIGHT = 144u;///> Biggest height of the thumbnails
+
+	/**
+	 * @brief Settings of an export, named so a project may keep several of them
+	 */
+	struct ExportPreset
+	{
+		std::string name = "default";	///> Name of the preset
+		unsigned short format = 1u;		///> Format as Settings::getExportFormat gives it
+		unsigned short frames = 15u;	///> Frames of the timeline
+	};
+
+	/**
+	 * @brief Default constructor creating an empty project, not saved yet
+	 */
+	Project();
+
+	/**
+	 * @brief Checks whether the path names a project file
+	 *
+	 * @param path The path
+	 *
+	 * @return True if it ends with EXTENSION
+	 */
+	static bool isProjectPath(const std::string &path);
+
+	/**
+	 * @brief Reads a project file
+	 *
+	 * @param path Path to the file
+	 *
+	 * @return The project, without any image decoded
+	 *
+	 * Throws std::runtime_error if the file cannot be read, is of a newer version,
+	 *   names an unknown animation or holds a broken line.
+	 */
+	static Project load(const std::string &path);
+
+	/**
+	 * @brief Writes the project into a file, creating the missing thumbnails
+	 *
+	 * @param path Path to the file, which the project is saved to from then on
+	 *
+	 * Images are decoded for thumbnails only if they are not stored already, so it has
+	 *   to be called on a thread able to create textures. The file is replaced only once
+	 *   it is completely written. Throws std::runtime_error if it cannot be written.
+	 */
+	void save(const std::string &path);
+
+	/**
+	 * @brief Getter to the file of the project
+	 *
+	 * @return Path the project was read from or saved to, empty for a new project
+	 */
+	const std::string &getPath() const;
+
+	/**
+	 * @brief Takes the slides and transitions of a deck
+	 *
+	 * @param deck The deck
+	 *
+	 * Thumbnails of slides the project already held are kept.
+	 */
+	void setDeck(const SlideDeck &deck);
+
+	/**
+	 * @brief Creates the deck of the project
+	 *
+	 * @return The deck, with no image decoded yet
+	 */
+	SlideDeck createDeck() const;
+
+	/**
+	 * @brief Getter to the amount of slides
+	 *
+	 * @return The amount
+	 */
+	std::size_t getSlideCount() const;
+
+	/**
+	 * @brief Getter to the export presets
+	 *
+	 * @return The presets in order, the first one is applied when the project is opened
+	 */
+	const std::vector<ExportPreset> &getPresets() const;
+
+	/**
+	 * @brief Replaces the preset of the same name, or appends it
+	 *
+	 * @param preset The preset
+	 */
+	void setPreset(const ExportPreset &preset);
+
+	/**
+	 * @brief Gets the thumbnail of a slide, decoding it on the first call
+	 *
+	 * @param slide Index of the slide
+	 *
+	 * @return The thumbnail, nullptr if the project holds none or its image changed since
+	 */
+	ImageStore::Handle getThumbnail(const std::size_t slide);
+
+private:
+	struct Slide
+	{
+		std::string path;///> Path to the image, as the deck takes it
+		SlideTransition transition;///> Transition from the previous slide
+		std::string stamp;///> Size and modification time of the image when the thumbnail was made
+		std::string thumbnail;///> PNG of the thumbnail in base64, empty without one
+		ImageStore::Handle decoded;///> Decoded thumbnail, nullptr until it is asked for
+	};
+
+	static std::string stampOf(const std::string &path);///> Size and modification time of the image, empty if it cannot be read
+	void makeThumbnail(Slide &slide) const;///> Creates the thumbnail of the slide from its image
+
+	std::string m_path;///> File of the project
+	std::vector<Slide> m_slides;///> Slides in order
+	std::vector<ExportPreset> m_presets;///> Export presets in order
+};
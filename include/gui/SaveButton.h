@@ -33,11 +33,11 @@ public:
 	SaveButton(SaveButton &&source);
 
 	/**
-	 * @brief      Renders button in given target.
+	 * @brief      Adds button to the batch.
 	 *
-	 * @param      target  The target
+	 * @param      target  The batch
 	 */
-	void render(sf::RenderTarget *target) override;
+	void batch(GuiBatch &target) const override;
 	
 	/**
      * @brief      Updates state and look of button. 
@@ -49,5 +49,4 @@ public:
 
 private:
 	sf::Sprite m_spr;
-	sf::Texture m_texture;
 };	
\ No newline at end of file
@@ -43,6 +43,12 @@ public:
 	 * @return     m_frames.
 	 */
 	unsigned short getCurrentFrames() const;
+	/**
+	 * @brief      Gets the format the animation is exported to.
+	 *
+	 * @return     m_exportFormat (1 - bmp frames, 2 - gif, 3 - mp4, 4 - raw sequence, 5 - png frames, 6 - qoi frames).
+	 */
+	unsigned short getExportFormat() const;
 	/**
 	 * @brief      Sets m_path1.
 	 *
@@ -67,6 +73,12 @@ public:
 	 * @param[in]  frames  The frames
 	 */
 	void setCurrentFrames(unsigned short frames);
+	/**
+	 * @brief      Sets the format the animation is exported to.
+	 *
+	 * @param[in]  format  The format
+	 */
+	void setExportFormat(unsigned short format);
 
 private:
 	Settings() = default;
@@ -74,6 +86,7 @@ private:
 	std::string m_path2;
 	unsigned short m_anim;
 	unsigned short m_frames;
+	unsigned short m_exportFormat;
 	static Settings* setting;
 
 };
\ No newline at end of file
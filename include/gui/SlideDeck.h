@@ -0,0 +1,188 @@
+#pragma once
+
+#include "Canvas.h"
+#include "ImageLoader.h"
+
+/**
+ * @brief Transition from one slide of a deck to the next one
+ */
+struct SlideTransition
+{
+	std::size_t animation = 0u;	///> Index of the animation in ANIMATIONS
+	float length = 1.f;			///> Length of the transition in seconds
+};
+
+/**
+ * @brief Ordered list of images played as one transition after another
+ *
+ * Only a small window of slides is kept decoded: the two the canvas shows and
+ *   the ones after them, which are decoded in the background while the current
+ *   transition plays. Slides behind the window are released, so the memory does
+ *   not grow with the length of the deck. The deck holds the images the way the
+ *   canvas loads them, so every slide is decoded once however many transitions
+ *   show it.
+ */
+class SlideDeck
+{
+public:
+	/**
+	 * @brief Amount of slides after the starting one of the current transition kept decoded
+	 */
+	static constexpr std::size_t PREFETCH_AHEAD = 2u;
+
+	/**
+	 * @brief Default constructor creating an empty deck
+	 */
+	SlideDeck();
+
+	/**
+	 * @brief Reads a deck from a file, one slide per line
+	 *
+	 * @param path Path to the file
+	 * @param defaults Transition taken where a line does not give the animation or the length
+	 *
+	 * @return The deck
+	 *
+	 * Every line holds the path to the image, optionally followed by the name or
+	 *   the number of the animation leading to it and its length in seconds.
+	 *   Paths with spaces are written in double quotes, empty lines and lines
+	 *   starting with # are skipped.
+	 */
+	static SlideDeck fromFile(const std::string &path, const SlideTransition &defaults = SlideTransition());
+
+	/**
+	 * @brief Appends a slide to the deck
+	 *
+	 * @param path Path to the image of the slide
+	 * @param transition Transition from the previous slide, unused for the first one
+	 */
+	void addSlide(const std::string &path, const SlideTransition &transition = SlideTransition());
+
+	/**
+	 * @brief Removes all slides and releases their images
+	 */
+	void clear();
+
+	/**
+	 * @brief Getter to the amount of slides
+	 *
+	 * @return The amount of slides
+	 */
+	std::size_t getSlideCount() const;
+
+	/**
+	 * @brief Getter to the amount of transitions, one between every two slides
+	 *
+	 * @return The amount of transitions
+	 */
+	std::size_t getTransitionCount() const;
+
+	/**
+	 * @brief Getter to the path of the image of a slide
+	 *
+	 * @param slide Index of the slide
+	 *
+	 * @return The path
+	 */
+	const std::string &getPath(const std::size_t slide) const;
+
+	/**
+	 * @brief Getter to a transition
+	 *
+	 * @param transition Index of the transition, the one from slide transition to slide transition + 1
+	 *
+	 * @return The transition
+	 */
+	const SlideTransition &getTransition(const std::size_t transition) const;
+
+	/**
+	 * @brief Getter to the transition shown last
+	 *
+	 * @return Index of the transition
+	 */
+	std::size_t getCurrent() const;
+
+	/**
+	 * @brief Shows a transition on the canvas and prefetches the slides after it
+	 *
+	 * @param canvas Canvas the transition is shown on
+	 * @param transition Index of the transition
+	 * @param use_shader Whether pixel animations should be computed by their shaders
+	 *
+	 * Slides of the transition still being prefetched are waited for instead of
+	 *   being decoded again.
+	 */
+	void show(Canvas &canvas, const std::size_t transition, const bool use_shader = true);
+
+	/**
+	 * @brief Shows the transition after the current one
+	 *
+	 * @param canvas Canvas the transition is shown on
+	 * @param use_shader Whether pixel animations should be computed by their shaders
+	 *
+	 * @return True if there was a next transition, false if the current one is the last
+	 */
+	bool showNext(Canvas &canvas, const bool use_shader = true);
+
+	/**
+	 * @brief Continues prefetching, meant to be called every frame while isPrefetching
+	 *
+	 * @param canvas Canvas the slides are prefetched for
+	 *
+	 * Decoded slides are uploaded in chunks, so it has to be called on a thread
+	 *   able to create textures, while nobody else modifies the canvas.
+	 */
+	void update(const Canvas &canvas);
+
+	/**
+	 * @brief Checks whether any slide is being prefetched
+	 *
+	 * @return True until all slides of the window are decoded
+	 */
+	bool isPrefetching() const;
+
+	/**
+	 * @brief Checks whether both slides of a transition are decoded
+	 *
+	 * @param transition Index of the transition
+	 *
+	 * @return True if showing the transition does not wait for a slide, false also
+	 *   for indices past the transitions
+	 */
+	bool isReady(const std::size_t transition) const;
+
+	/**
+	 * @brief Getter to the amount of slides whose images the deck holds
+	 *
+	 * @return The amount of slides, never more than PREFETCH_AHEAD + 1
+	 */
+	std::size_t getHeldCount() const;
+
+	/**
+	 * @brief Renders every transition one after another
+	 *
+	 * @param canvas Canvas the transitions are rendered by
+	 * @param frames Amount of frames of every transition
+	 * @param consumer Function receiving the frames in order
+	 * @param use_shader Whether pixel animations should be computed by their shaders
+	 *
+	 * The next slides are decoded in the background while a transition is rendered.
+	 */
+	void render(Canvas &canvas, const unsigned frames, const std::function<void(ExportFrame)> &consumer, const bool use_shader = true);
+
+private:
+	struct Slide
+	{
+		std::string path;
+		SlideTransition transition;
+	};
+
+	void keepWindow(const Canvas &canvas);///> Releases slides outside the window and starts prefetching the missing ones
+	void finish(const Canvas &canvas, const std::size_t slide);///> Waits until the slide is prefetched
+	void hold(const Canvas &canvas, const std::size_t slide);///> Keeps the image of the slide the way the canvas loads it
+
+	std::vector<Slide> m_slides;///> Slides in order
+	std::size_t m_current;///> Transition shown last
+	std::map<std::size_t, ImageStore::Handle> m_held;///> Images of the slides in the window, by index of the slide
+	std::map<std::size_t, std::unique_ptr<ImageLoader>> m_loading;///> Slides of the window being decoded, by index of the slide
+};
@@ -33,15 +33,6 @@ public:
      */
 	void update(sf::Vector2i mousePos, sf::Event &event) override;
     
-    /**
-     * @brief      Renders button in given target
-     *
-     * @param      target  The target
-     * 
-     * Changing texture of button depending to play/pause 
-     * 
-     */
-    void render(sf::RenderTarget *target) override;
 
     /**
      * @brief      Gets information if button is on play.
@@ -65,6 +56,13 @@ public:
      */
     void ON_OFF();
 
+    /**
+     * @brief      Getter to a value summarizing the look of the button, including the shown icon
+     *
+     * @return     The look key.
+     */
+    std::size_t getLookKey() const override;
+
 private:
 	bool m_isPlay;
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Button.h"
+#include "FontCache.h"
 
 class TextButton : public Button
 {
@@ -30,9 +31,8 @@ public:
      * @note Size of the TextButton should not be 0x0 or the default font size
      *       will be undefined.
      * 
-     * If the font parameter is nullptr, there will be a new font constructed in
-     *   it's place. On the other hand, if no actual font was loaded into it, 
-     *   TextButton will attempt to find a replacement in res/fonts directory.
+     * If the font parameter is nullptr or no actual font was loaded into it,
+     *   the font of the GUI shared through FontCache is used instead.
      *   
      * Font size is by default set to 1/3 of TextButton's height. To change it, 
      *   use setFontSize(const unsigned int &pixels).
@@ -103,8 +103,7 @@ public:
      * 
      * If the given new_font parameter is nullptr, this will throw 
      *   an exception. Otherwise, if no actual font was loaded into it, 
-     *   TextButton will attempt to find a replacement in res/fonts 
-     *   directory. 
+     *   the font of the GUI shared through FontCache is used instead.
      */
     virtual void setFont(std::shared_ptr<sf::Font> new_font);
 
@@ -124,17 +123,25 @@ public:
     void update(sf::Vector2i mousePos, sf::Event &event) override;
 
     /**
-     * @brief Renders this instance of the TextButton on sf::RenderTarget.
+     * @brief Adds this instance of the TextButton to the batch.
      *
-     * @param target The target which the TextButton is rendered on.
+     * @param target The batch which the TextButton is added to.
      */
-    void render(sf::RenderTarget *target) override;
+    void batch(GuiBatch &target) const override;
+
+    /**
+     * @brief Getter to a value summarizing the look of the TextButton, including its label
+     *
+     * @return The look key.
+     */
+    std::size_t getLookKey() const override;
 
 protected:
 	std::shared_ptr<sf::Font> m_font;
 	sf::Text m_label;
 
 private:
+	void prepareGlyphs();//rasterizes the glyphs of the label size in the shared font
 	void centerText();
 
 };
\ No newline at end of file
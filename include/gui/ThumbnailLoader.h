@@ -0,0 +1,140 @@
+#pragma once
+
+#include "ImageStore.h"
+
+#include <future>
+#include <list>
+
+/**
+ * @brief Small cache of the thumbnails shown by the buttons, apart from the images of the canvas
+ *
+ * Thumbnails are kept at the size they are shown at, so previews of huge photos
+ *   cost what the buttons show of them. The cache holds the thumbnails used last
+ *   up to its capacity, their textures are accounted to the GUI. It may be used
+ *   from any thread.
+ */
+class ThumbnailCache
+{
+public:
+	static constexpr std::size_t DEFAULT_CAPACITY = std::size_t(16u) << 20;///> Default capacity, in bytes of the textures
+
+	/**
+	 * @brief Constructor of an empty cache
+	 *
+	 * @param capacity Bytes of textures kept, the thumbnail used last is kept even if it is bigger
+	 */
+	explicit ThumbnailCache(const std::size_t capacity = ThumbnailCache::DEFAULT_CAPACITY);
+
+	ThumbnailCache(const ThumbnailCache &) = delete;
+	ThumbnailCache &operator=(const ThumbnailCache &) = delete;
+
+	/**
+	 * @brief Cache shared by the whole application
+	 *
+	 * @return The shared cache
+	 */
+	static ThumbnailCache &shared();
+
+	/**
+	 * @brief Gets a cached thumbnail, marking it as used last
+	 *
+	 * @param path Path to the image
+	 * @param size Size the thumbnail was made for
+	 *
+	 * @return The thumbnail, nullptr if it is not cached
+	 */
+	ImageStore::Handle find(const std::string &path, const sf::Vector2u &size);
+
+	/**
+	 * @brief Caches a thumbnail, dropping the ones used longest ago over the capacity
+	 *
+	 * @param path Path to the image
+	 * @param size Size the thumbnail was made for
+	 * @param thumbnail The thumbnail with its texture uploaded
+	 *
+	 * @return Handle to the cached thumbnail
+	 */
+	ImageStore::Handle insert(const std::string &path, const sf::Vector2u &size, ImageStore::Handle thumbnail);
+
+	/**
+	 * @brief Getter to the memory of the cached thumbnails
+	 *
+	 * @return Bytes of their textures
+	 */
+	std::size_t getUsage();
+
+private:
+	using Entry = std::pair<std::string, ImageStore::Handle>;///> Thumbnail by its path and size
+
+	std::size_t m_capacity;///> Bytes of textures kept
+	std::size_t m_usage;///> Bytes of the cached textures
+	std::list<Entry> m_entries;///> Cached thumbnails, used last first
+	std::map<std::string, std::list<Entry>::iterator> m_index;///> Entries by their path and size
+	std::mutex m_mutex;///> Guards the entries
+};
+
+/**
+ * @brief Loader making thumbnails in the background
+ *
+ * The image is decoded and shrunk to the size of the thumbnail on a worker thread,
+ *   only the shrunk pixels are uploaded, by update on the thread of the window.
+ *   Images already in the ImageStore are shrunk from their pixels instead of
+ *   being decoded again. Finished thumbnails are put into the ThumbnailCache.
+ */
+class ThumbnailLoader
+{
+public:
+	/**
+	 * @brief Constructor of a loader putting the thumbnails into the cache
+	 *
+	 * @param cache Cache of the thumbnails, has to outlive the loader
+	 */
+	explicit ThumbnailLoader(ThumbnailCache &cache = ThumbnailCache::shared());
+
+	ThumbnailLoader(const ThumbnailLoader &) = delete;
+	ThumbnailLoader &operator=(const ThumbnailLoader &) = delete;
+
+	/**
+	 * @brief Destructor waiting for the thumbnails still being made
+	 */
+	~ThumbnailLoader() = default;
+
+	/**
+	 * @brief Starts making the thumbnail, replacing the one requested so far
+	 *
+	 * @param path Path to the image file
+	 * @param size Size the thumbnail is shown at, images are shrunk to it in every axis bigger than it
+	 */
+	void request(const std::string &path, const sf::Vector2u &size);
+
+	/**
+	 * @brief Checks whether a thumbnail is being made
+	 *
+	 * @return True from the request until update returns the thumbnail
+	 */
+	bool isPending() const;
+
+	/**
+	 * @brief Continues loading, meant to be called every frame on the thread of the window
+	 *
+	 * @return The thumbnail once it is made, an empty image if the image failed to load,
+	 *   nullptr while it is still being made or when nothing was requested
+	 */
+	ImageStore::Handle update();
+
+private:
+	struct Work
+	{
+		ImageStore::Handle source;///> Image of the store shrunk by the worker, nullptr if the file is decoded
+		std::future<sf::Image> shrinking;///> Thumbnail being made, destroyed before its source
+	};
+
+	void dropAbandoned();///> Forgets thumbnails of replaced requests which are already made
+
+	ThumbnailCache &m_cache;///> Cache the thumbnails are put into
+	std::string m_path;///> Path of the last requested image
+	sf::Vector2u m_size;///> Size of the last requested thumbnail
+	ImageStore::Handle m_ready;///> Thumbnail taken from the cache, returned by the next update
+	Work m_work;///> Thumbnail of the last request being made
+	std::vector<Work> m_abandoned;///> Thumbnails of replaced requests, waited for only when they are made
+};
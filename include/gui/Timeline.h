@@ -1,5 +1,6 @@
 #pragma once
 #include "Button.h"
+#include "../util/PlaybackCursor.h"
 
 
 /**
@@ -8,6 +9,11 @@
 class Timeline: public Button
 {
 public:
+    /**
+     * @brief      Time the dragged cursor has to rest before frames of full quality are shown, in seconds
+     */
+    static constexpr float SCRUB_IDLE = 0.15f;
+
     /**
      * Default constructor
      */
@@ -73,6 +79,15 @@ public:
      */
     void setCurrentTime(const float currentTime);
     
+    /**
+     * @brief      Jumps to the frame.
+     *
+     * @param      frame  Index of the frame, indices after the last frame give the last one
+     * 
+     * Time of the frame is computed straight from its index, so it costs the same for any frame.
+     */
+    void seekFrame(const unsigned frame);
+
     /**
      * @brief      Jump to time of next frame
      */
@@ -132,6 +147,37 @@ public:
      */
     const unsigned getFrames() const;
 
+    /**
+     * @brief      Getter to the current frame.
+     *
+     * @return     Index of the last frame at or before the current time.
+     */
+    const unsigned getCurrentFrame() const;
+
+    /**
+     * @brief      Getter to the frames of the timeline.
+     *
+     * @return     The grid of frames, shared with the frame cache and exports.
+     */
+    const FrameGrid &getFrameGrid() const;
+
+    /**
+     * @brief      Getter to the clock advancing the played animation.
+     *
+     * @return     The clock, whose mode may be changed.
+     * 
+     * Its step is kept equal to the time between frames, so in the stepped modes
+     *   playback goes through exactly the frames skipNextFrame jumps to.
+     */
+    PlaybackClock &getClock();
+
+    /**
+     * @brief      Getter to the state of playback.
+     *
+     * @return     The cursor, copied to the views rendering the animation at its time.
+     */
+    const PlaybackCursor &getPlayback() const;
+
     /**
      * @brief      Update state and look of timeline
      *
@@ -140,19 +186,20 @@ public:
      * @param      deltaTime  The delta time
      * 
      * Checking if finshed - if true -> pause  
-     * Updateing time
-     * Updateing cursor position set with mouse  
+     * Updateing time by the playback clock
+     * Updateing cursor position set with mouse, the playback is marked as scrubbed
+     *   while the cursor is dragged and moved within SCRUB_IDLE  
      * Updateing covered patr of timeline (after cursor).  
      * 
      */
     void update(sf::Vector2i mousePos, sf::Event &event, const float &deltaTime);
     
     /**
-     * @brief      Renders timeline on target.
+     * @brief      Adds the box, the covered path and the cursor of the timeline to the batch.
      *
-     * @param      target  The target
+     * @param      target  The batch
      */
-    void render(sf::RenderTarget *target);
+    void batch(GuiBatch &target) const override;
 
 
 protected:
@@ -162,9 +209,6 @@ protected:
 
     float m_timelineLength;
     float m_cursorSpeed;
-    bool m_playStatus;
-    float m_totalTime;
-    float m_currentTime;
-    float m_deltaFrame;
-    unsigned short m_frameCount;
+    PlaybackCursor m_playback;
+    float m_scrubIdle;///> Time the dragged cursor has not moved for
 };
@@ -21,6 +21,17 @@
 #include "../gui/Object.h"
 #include "../gui/Canvas.h"
 #include "../gui/Settings.h"
+#include "../gui/SlideDeck.h"
+#include "../gui/Project.h"
+#include "../gui/ProfilerOverlay.h"
+#include "../gui/ExportScheduler.h"
+
+#include "../export/ImageSequenceSink.h"
+#include "../export/GifSink.h"
+#include "../export/FfmpegSink.h"
+#include "../export/RawSequenceSink.h"
+
+#include "../util/FramePacer.h"
 
 /**
  * @brief Class merging everything from the application into one place
@@ -30,8 +41,12 @@ class Program
 public:
 	/**
 	 * Constructor starting the application
+	 *
+	 * @param deck Slides played one transition after another, the example images are shown without two of them
+	 * @param sequence Exported sequence played instead of the animation, nullptr to show the animation
+	 * @param project Project the deck was created from, its first export preset is applied
 	 */
-	Program();
+	Program(SlideDeck deck = SlideDeck(), std::shared_ptr<const RawSequence> sequence = nullptr, Project project = Project());
 
 	/**
 	 * @brief Destructor cleaning up after application's termination
@@ -59,25 +74,31 @@ public:
 	
 	/**
 	 * @brief This member function sets a flag calling Program's update even if there's no event happening at the moment
+	 * 
+	 * The request holds for the next update only, everything which needs to be updated
+	 *   continuously (a played animation, a loading image) requests it in every update.
+	 *   Without requests and events the window is neither updated nor redrawn.
+	 *   May be called from any thread.
 	 */
 	static void requestUpdate();
 
-	/**
-	 * @brief This member function expires the request for calling Program's update
-	 */
-	static void expireRequestUpdate();
-
 
 	/**
 	 * @brief Update of delta time
 	 * 
 	 * Delta time is a time measured from drawing previous frame to generating the next one.
 	 * The faster is the computer (more frames per second) the smaller is the delta time.
+	 * While presenting it is the time between the refreshes the frames are predicted
+	 *   to be shown at instead, so the animation moves by the same amount every refresh.
 	 */
 	void updateDeltaTime();
 
 	/**
 	 * @brief Update all events happening in the application
+	 * 
+	 * Handles every pending event before the next render. When there is neither
+	 *   an event nor a requested update, idle time fills the frame cache and then
+	 *   the thread sleeps until the next event.
 	 */
 	void updateSFMLEvents();
 
@@ -90,12 +111,135 @@ public:
 	void update(sf::Vector2i mousePos, sf::Event &event);
 
 	/**
-	 * @brief Save a sequence of bitmaps from animation into the file on hard drive
+	 * @brief Shows the next transition of the deck once the current one was played to its end
+	 *
+	 * @param wasPlaying Whether the animation was played before the timeline was updated
+	 *
+	 * While presenting the last frame is held until both slides of the next transition
+	 *   are decoded, so the display never waits for a slide.
+	 */
+	void updateDeck(const bool wasPlaying);
+
+	/**
+	 * @brief Shows a transition of the deck on the canvas and the timeline, from its start
+	 *
+	 * @param transition Index of the transition
+	 *
+	 * The image buttons show the thumbnails the project holds of its slides.
+	 */
+	void showTransition(const std::size_t transition);
+
+	/**
+	 * @brief Starts saving the animation on hard drive in the format chosen next to the save button
+	 *
+	 * The shown animation is rendered on its own canvas in the background, the
+	 *   window stays responsive and shows the progress in its title. Nothing is
+	 *   started while another export runs.
+	 */
+	void saveSequence();
+
+	/**
+	 * @brief Follows the export started by saveSequence and tells its result once it is finished
+	 */
+	void updateExport();
+
+	/**
+	 * @brief Creates the sink of the format chosen in application's settings
+	 *
+	 * @param name Name of the output without extension
+	 * @param fps Frames per second of the animation
+	 *
+	 * @return The sink the frames are written to
+	 */
+	std::unique_ptr<FrameSink> makeExportSink(const std::string &name, const float &fps);
+
+	/**
+	 * @brief Handles the keys of the profiler
+	 *
+	 * F3 shows or hides the profiler overlay, F4 writes the collected events into
+	 *   a Chrome trace file in the working directory.
+	 *
+	 * @param event The handled event
+	 */
+	void updateProfilerKeys(const sf::Event &event);
+
+	/**
+	 * @brief Handles the keys of the project
+	 *
+	 * Ctrl+S saves the project, asking for its file the first time.
+	 *
+	 * @param event The handled event
+	 */
+	void updateProjectKeys(const sf::Event &event);
+
+	/**
+	 * @brief Saves the deck with the images chosen for the current transition and the export settings into the project
+	 */
+	void saveProject();
+
+	/**
+	 * @brief Handles the events changing the size of the window
+	 *
+	 * F11 switches between the window and fullscreen.
+	 *
+	 * @param event The handled event
+	 *
+	 * @return True if the layout has to follow a new size of the window
+	 */
+	bool updateWindowEvents(const sf::Event &event);
+
+	/**
+	 * @brief Handles the keys of the presentation
+	 *
+	 * F5 starts presenting the deck from its first transition, F5 or Escape stop it.
+	 *
+	 * @param event The handled event
+	 *
+	 * @return True if the layout has to follow the window of the presentation
+	 */
+	bool updatePresentationKeys(const sf::Event &event);
+
+	/**
+	 * @brief Starts or stops presenting
+	 *
+	 * @param presenting Whether the deck is presented
+	 *
+	 * A presentation shows only the canvas, fullscreen with vertical sync, and is
+	 *   paced by the refreshes of the display instead of sleeping between frames.
+	 *   Its statistics of dropped frames are written on the standard output when it ends.
+	 */
+	void setPresenting(const bool presenting);
+
+	/**
+	 * @brief Writes the statistics of the frames of the presentation on the standard output
+	 */
+	void reportPresentation() const;
+
+	/**
+	 * @brief Creates the window, fullscreen or at its windowed size
+	 *
+	 * Presentations are fullscreen with vertical sync, the window of the editor is
+	 *   limited to 60 frames per second without it.
+	 */
+	void createWindow();
+
+	/**
+	 * @brief Scales the panels to the window and chooses the render size of the canvas
+	 *
+	 * The panels keep their layout and aspect ratio. Frames are rendered at the
+	 *   render size fixed by BCG_RENDER_SIZE=<W>x<H>, e.g. the export resolution
+	 *   previewed scaled down, and otherwise at the pixels the canvas covers. The
+	 *   plane of the canvas is created again only when that size changes.
+	 *   While presenting the canvas alone is scaled to the window.
+	 */
+	void updateLayout();
+
+	/**
+	 * @brief Getter to the mouse position in the coordinates of the panels
 	 *
-	 * @param mousePos The mouse position given to updates of Canvas and Timeline
-	 * @param event The event handler given to updates of Canvas and Timeline
+	 * @return The position relative to the layout of the panels
 	 */
-	void saveSequence(sf::Vector2i mousePos, sf::Event &event);
+	sf::Vector2i getMousePosition() const;
 
 	/**
 	 * @brief Renders everything into the window
@@ -113,9 +257,26 @@ private:
 
 	sf::Clock m_dtClock;///> Clock measuring delta time between frames
 	float m_deltaTime;///> Time between rendered frames
+	bool m_redrawRequested;///> Whether something was updated since the window was rendered
 
 	PanelTimeline *m_timePanel;///> Panel containing applications contents
 	PanelButton *m_buttonPanel;///> Panel containing applications settings
+	SlideDeck m_deck;///> Slides played by the application, empty when only two images are animated
+	Project m_project;///> Project the deck is saved into, with the thumbnails of its slides
+	ProfilerOverlay m_profilerOverlay;///> Times of the frame drawn over the panels, toggled by F3
+	bool m_fullscreen;///> Whether the window covers the screen, toggled by F11
+	sf::Vector2u m_windowedSize;///> Size of the window when it is not fullscreen
+	sf::Vector2u m_renderSize;///> Render size of the canvas fixed by BCG_RENDER_SIZE, zero to follow the window
+	bool m_presenting;///> Whether the deck is presented, toggled by F5
+	bool m_deckWaiting;///> Whether the current transition ended and the next one waits for its slides
+	FramePacer m_pacer;///> Predicts the refreshes the frames of the presentation are shown at
+	sf::Clock m_presentClock;///> Monotonic clock the frames of the presentation are paced by
+	std::size_t m_animation;///> Index of the animation shown on the canvas, the one exported
+	std::shared_ptr<const RawSequence> m_sequence;///> Sequence played instead of the animation, nullptr for none
+	std::atomic<std::size_t> m_exportedFrames;///> Frames rendered by the running export, set by its thread
+	std::size_t m_exportFrames;///> Amount of frames of the running export
+	std::size_t m_titleFrames;///> Rendered frames of the export shown in the title, which is set only when they change
+	std::future<void> m_export;///> Export running in the background, invalid when none runs
 
-	static bool requestedUpdate;///> Flag declaring whether window should be updated without event or not
+	static std::atomic<bool> requestedUpdate;///> Flag declaring whether window should be updated without event on the next iteration, set by any thread
 };
@@ -0,0 +1,10 @@
+#pragma once
+
+/**
+ * Standard library and the windows, textures and shaders of SFML
+ */
+
+#include "Std.h"
+
+#include <SFML/Window.hpp>
+#include <SFML/Graphics.hpp>
@@ -1,24 +1,22 @@
 #pragma once
 
+/**
+ * Everything the GUI and the executables use, compiled once as their precompiled header
+ *
+ * Headers of the modules include the lean Std.h, System.h or Graphics.h instead,
+ *   the libraries without GUI are precompiled with Graphics.h. Dialogs of
+ *   tinyfiledialogs are included only by the sources opening them.
+ */
+
+#include "Graphics.h"
+
 #include <ctime>
-#include <cstdlib>
 #include <iostream>
 #include <fstream>
-#include <vector>
 #include <list>
+#include <deque>
 #include <stack>
 #include <map>
 #include <set>
-#include <string>
-#include <cmath>
-#include <algorithm>
-#include <functional>
-#include <numeric>
-#include <memory>
 #include <filesystem>
-
-#include <SFML/System.hpp>
-#include <SFML/Window.hpp>
-#include <SFML/Graphics.hpp>
-
-#include "../../dep/tinyfiledialogs/tinyfiledialogs.h"
+#include <future>
@@ -0,0 +1,29 @@
+#pragma once
+
+/**
+ * Parts of the standard library used by every module
+ *
+ * Headers include this, System.h or Graphics.h rather than Root.h, so a change
+ *   of one module recompiles only what depends on it and a translation unit
+ *   parses only what it uses. Less common headers are included where they are
+ *   needed.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <array>
+#include <utility>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <stdexcept>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
@@ -0,0 +1,9 @@
+#pragma once
+
+/**
+ * Standard library and the vectors, clocks and strings of SFML, without windows or graphics
+ */
+
+#include "Std.h"
+
+#include <SFML/System.hpp>
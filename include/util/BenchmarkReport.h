@@ -0,0 +1,166 @@
+#pragma once
+
+#include "../root/Std.h"
+
+#include <iosfwd>
+
+/**
+ * @brief Machine-readable results of benchmarks, compared against a stored baseline
+ *
+ * Every result is the average time of one operation of a case: a frame of an
+ *   animation, a plan, an encoded frame. Cases working on pixels also keep the
+ *   pixels of an operation, so their throughput is given in megapixels per second.
+ *   Reports are written as JSON for dashboards and as CSV, which is also the format
+ *   baselines are read from:
+ *
+ *   group,name,size,ns_per_op,ops_per_s,mpix_per_s
+ *   pixel,dimming,1080p,1843201.50,542.534,1124.999
+ *
+ * A case is identified by its group, name and size. Comparing a report with a
+ *   baseline finds the cases which got slower by more than a threshold, so upgrades
+ *   can be gated on them.
+ */
+class BenchmarkReport
+{
+public:
+	static constexpr float DEFAULT_THRESHOLD = 0.1f;///> Share a case may get slower by before it counts as a regression
+
+	/**
+	 * @brief Measured case
+	 */
+	struct Result
+	{
+		std::string group;			///> Group of the case, e.g. pixel, plan or export
+		std::string name;			///> Name of the case within its group
+		std::string size;			///> Resolution or size of the input, may be empty
+		double nanoseconds = 0.0;	///> Average time of one operation
+		double pixels = 0.0;		///> Pixels of one operation, 0 for cases not working on pixels
+
+		/**
+		 * @brief Operations per second
+		 *
+		 * @return The rate, 0 for a result without time
+		 */
+		double perSecond() const;
+
+		/**
+		 * @brief Throughput in megapixels per second
+		 *
+		 * @return The throughput, 0 for cases not working on pixels
+		 */
+		double megapixelsPerSecond() const;
+	};
+
+	/**
+	 * @brief Case slower than in the baseline
+	 */
+	struct Regression
+	{
+		Result baseline;		///> Result of the baseline
+		Result current;			///> Result of the report
+		double slowdown = 0.0;	///> Share of time the current result takes longer, 0.25 for 25 % slower
+	};
+
+	/**
+	 * @brief Constructor of an empty report
+	 */
+	BenchmarkReport();
+
+	/**
+	 * @brief Reads a report written by writeCsv
+	 *
+	 * @param path Path to the CSV file
+	 *
+	 * @return The report
+	 *
+	 * Throws std::runtime_error if the file cannot be read or holds a broken line.
+	 */
+	static BenchmarkReport loadCsv(const std::string &path);
+
+	/**
+	 * @brief Adds a result, replacing the one of the same case
+	 *
+	 * @param result The result
+	 */
+	void add(const Result &result);
+
+	/**
+	 * @brief Setter of a property of the run, e.g. the amount of threads
+	 *
+	 * @param key Name of the property
+	 * @param value Its value
+	 *
+	 * Properties are written into JSON only, they tell apart runs on different machines.
+	 */
+	void setProperty(const std::string &key, const std::string &value);
+
+	/**
+	 * @brief Getter to the results
+	 *
+	 * @return The results in the order they were added
+	 */
+	const std::vector<Result> &getResults() const;
+
+	/**
+	 * @brief Finds the result of a case
+	 *
+	 * @param group Group of the case
+	 * @param name Name of the case
+	 * @param size Size of the case
+	 *
+	 * @return The result, nullptr if the report has none
+	 */
+	const Result *find(const std::string &group, const std::string &name, const std::string &size) const;
+
+	/**
+	 * @brief Finds the cases slower than in the baseline
+	 *
+	 * @param baseline The baseline
+	 * @param threshold Share of time a case may get slower by, e.g. 0.1 for 10 %
+	 *
+	 * @return Regressions of the cases both reports hold, in the order of this report
+	 */
+	std::vector<Regression> compare(const BenchmarkReport &baseline, const float &threshold = BenchmarkReport::DEFAULT_THRESHOLD) const;
+
+	/**
+	 * @brief Compares the report with the baseline and prints the cases slower than in it
+	 *
+	 * @param baseline The baseline
+	 * @param threshold Share of time a case may get slower by
+	 * @param out Stream the comparison is printed to
+	 *
+	 * @return True if no case got slower by more than the threshold
+	 */
+	bool check(const BenchmarkReport &baseline, const float &threshold, std::ostream &out) const;
+
+	/**
+	 * @brief Writes the report as JSON
+	 *
+	 * @param path Path to the file
+	 *
+	 * Throws std::runtime_error if the file cannot be written.
+	 */
+	void writeJson(const std::string &path) const;
+
+	/**
+	 * @brief Writes the report as CSV, which loadCsv reads back
+	 *
+	 * @param path Path to the file
+	 *
+	 * Throws std::runtime_error if the file cannot be written.
+	 */
+	void writeCsv(const std::string &path) const;
+
+	/**
+	 * @brief Writes the report in the format of the extension of the path, ".json" or ".csv"
+	 *
+	 * @param path Path to the file
+	 *
+	 * Throws std::invalid_argument for other extensions, std::runtime_error if the file cannot be written.
+	 */
+	void write(const std::string &path) const;
+
+private:
+	std::vector<Result> m_results;///> Results in the order they were added
+	std::vector<std::pair<std::string, std::string>> m_properties;///> Properties of the run in the order they were set
+};
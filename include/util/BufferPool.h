@@ -0,0 +1,92 @@
+#pragma once
+
+#include "MemoryBudget.h"
+
+/**
+ * @brief Recycler of big byte buffers, so frames do not allocate and free megabytes each
+ *
+ * Buffers handed out go back to the pool when their handle is dropped, on any
+ *   thread, and are handed out again to the next request which fits into their
+ *   capacity. Idle buffers are accounted to the subsystem of the pool, buffers in
+ *   use are accounted by whoever holds them.
+ */
+class BufferPool
+{
+public:
+	static const std::size_t DEFAULT_IDLE_LIMIT = 16u;///> Idle buffers kept at most
+
+private:
+	struct State;
+
+public:
+	/**
+	 * @brief Gives a buffer back to the pool it came from, the deleter of Buffer
+	 */
+	class Recycler
+	{
+	public:
+		Recycler() = default;
+		explicit Recycler(std::shared_ptr<State> state);
+		void operator()(std::vector<std::uint8_t> *buffer) const;
+
+	private:
+		std::shared_ptr<State> m_state;///> Pool the buffer goes back to, kept alive by its buffers
+	};
+
+	/**
+	 * @brief Handle to a buffer of the pool
+	 */
+	using Buffer = std::unique_ptr<std::vector<std::uint8_t>, Recycler>;
+
+	/**
+	 * @brief Constructor of an empty pool
+	 *
+	 * @param subsystem Subsystem the idle buffers are accounted to
+	 * @param idle_limit Idle buffers kept at most, further ones are freed
+	 */
+	explicit BufferPool(const MemorySubsystem subsystem, const std::size_t idle_limit = DEFAULT_IDLE_LIMIT);
+
+	BufferPool(const BufferPool &) = delete;
+	BufferPool &operator=(const BufferPool &) = delete;
+
+	/**
+	 * @brief Destructor freeing the idle buffers, buffers still in use are freed when dropped
+	 */
+	~BufferPool();
+
+	/**
+	 * @brief Hands out a buffer of given size
+	 *
+	 * @param bytes Size of the buffer
+	 *
+	 * @return The buffer, its contents are undefined
+	 */
+	Buffer acquire(const std::size_t bytes);
+
+	/**
+	 * @brief Frees all idle buffers
+	 */
+	void trim();
+
+	/**
+	 * @brief Getter to the memory of the idle buffers
+	 *
+	 * @return Amount of bytes
+	 */
+	std::size_t getIdleBytes() const;
+
+private:
+	struct State
+	{
+		State(const MemorySubsystem subsystem, const std::size_t idle_limit);
+
+		void accountIdle();///> Sets the charge to the idle buffers, the lock has to be held
+
+		std::mutex mutex;///> Guards the idle buffers
+		std::vector<std::unique_ptr<std::vector<std::uint8_t>>> idle;///> Buffers waiting for the next request
+		std::size_t idleLimit;///> Idle buffers kept at most, 0 once the pool is destroyed
+		MemoryCharge charge;///> Memory of the idle buffers
+	};
+
+	std::shared_ptr<State> m_state;///> Idle buffers, shared with the handed out ones
+};
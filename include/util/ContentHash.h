@@ -0,0 +1,98 @@
+#pragma once
+
+#include "../root/Std.h"
+
+#include <cstring>
+#include <type_traits>
+
+/**
+ * @brief 64-bit hash of contents, used to recognize inputs seen before
+ *
+ * Every piece added is hashed by XXH64 and folded into the value, so the value
+ *   depends on the pieces and their order. It tells contents apart, it is no
+ *   protection against anyone crafting collisions.
+ */
+class ContentHash
+{
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param seed Starting value, hashes of different seeds differ for the same contents
+	 */
+	explicit ContentHash(const std::uint64_t seed = 0u);
+
+	/**
+	 * @brief Adds bytes to the hash
+	 *
+	 * @param data The bytes
+	 * @param bytes Amount of bytes
+	 *
+	 * @return Reference to itself, so adds can be chained
+	 */
+	ContentHash &add(const void *data, const std::size_t bytes);
+
+	/**
+	 * @brief Adds a string to the hash, along with its length
+	 *
+	 * @param text The string
+	 *
+	 * @return Reference to itself, so adds can be chained
+	 */
+	ContentHash &add(const std::string &text);
+
+	/**
+	 * @brief Adds the bytes of a value to the hash
+	 *
+	 * @param value Value without padding, like numbers, vectors or matrices of floats
+	 *
+	 * @return Reference to itself, so adds can be chained
+	 */
+	template <typename T>
+	ContentHash &add(const T &value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "ContentHash::add(): only plain values can be hashed by their bytes");
+		return this->add(static_cast<const void *>(&value), sizeof(T));
+	}
+
+	/**
+	 * @brief Getter to the hash of everything added so far
+	 *
+	 * @return The hash
+	 */
+	std::uint64_t getValue() const;
+
+	/**
+	 * @brief XXH64 of bytes
+	 *
+	 * @param data The bytes
+	 * @param bytes Amount of bytes
+	 * @param seed Seed of the hash
+	 *
+	 * @return The hash
+	 */
+	static std::uint64_t hashBytes(const void *data, const std::size_t bytes, const std::uint64_t seed = 0u);
+
+	/**
+	 * @brief Hashes the contents of a file
+	 *
+	 * @param path Path to the file, or a resource path like "res:images/example1.jpg"
+	 *
+	 * @return XXH64 of the contents
+	 *
+	 * Throws std::runtime_error if the file cannot be read.
+	 */
+	static std::uint64_t hashFile(const std::string &path);
+
+	/**
+	 * @brief Writes a hash as 16 hexadecimal digits
+	 *
+	 * @param hash The hash
+	 *
+	 * @return The digits, fit for a file name
+	 */
+	static std::string toHex(const std::uint64_t hash);
+
+private:
+	std::uint64_t m_value;///> Hash of the pieces added so far
+};
@@ -1,6 +1,14 @@
 #pragma once
 
-#include "../root/Root.h"
+#include "../root/System.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#define EM_SSE 1
+	#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#define EM_NEON 1
+	#include <arm_neon.h>
+#endif
 
 namespace em
 {
@@ -8,6 +16,14 @@ namespace em
 	 * @brief Class realizing matrix operations
 	 *
 	 * @tparam T Type of values stored in the matrix
+	 *
+	 * Rows are aligned to 16 bytes, so matrices of floats are multiplied with SSE
+	 *   or NEON a row at a time. Matrices whose last row is (0, 0, 0, 1), which
+	 *   covers every translation, rotation and scaling, are multiplied and inverted
+	 *   as 3x4 affine transforms, skipping the work the projective row would need.
+	 *
+	 * Products and transforms of points are defined in this header so they are
+	 *   inlined, the other operations are compiled once for float, int and unsigned.
 	 */
 	template <typename T>
 	class Matrix4
@@ -18,7 +34,7 @@ namespace em
 		 * 
 		 * By default, it is initialised with identity matrix.
 		 */
-		Matrix4();
+		constexpr Matrix4();
 
 		/**
 		 * @brief Constructor setting particular elements of the matrix
@@ -40,10 +56,10 @@ namespace em
 		 * @param a32 Element of index i=3 j=2
 		 * @param a33 Element of index i=3 j=3
 		 */
-		explicit Matrix4(	T a00, T a01, T a02, T a03,
-							T a10, T a11, T a12, T a13,
-							T a20, T a21, T a22, T a23,
-							T a30, T a31, T a32, T a33 );
+		constexpr explicit Matrix4(	T a00, T a01, T a02, T a03,
+									T a10, T a11, T a12, T a13,
+									T a20, T a21, T a22, T a23,
+									T a30, T a31, T a32, T a33 );
 
 		/**
 		 * @brief Copy constructor and type cast
@@ -55,6 +71,35 @@ namespace em
 		template <typename U>
 		explicit Matrix4(const Matrix4<U> &matrix);
 
+		/**
+		 * @brief Identity matrix
+		 *
+		 * @return The matrix keeping everything in place
+		 */
+		static constexpr Matrix4<T> identity();
+
+		/**
+		 * @brief Translation matrix
+		 *
+		 * @param x Translation in X axis
+		 * @param y Translation in Y axis
+		 * @param z Translation in Z axis
+		 *
+		 * @return The matrix moving points by (x, y, z)
+		 */
+		static constexpr Matrix4<T> translation(const T x, const T y, const T z);
+
+		/**
+		 * @brief Scaling matrix
+		 *
+		 * @param x Scale in X axis
+		 * @param y Scale in Y axis
+		 * @param z Scale in Z axis
+		 *
+		 * @return The matrix scaling points by (x, y, z)
+		 */
+		static constexpr Matrix4<T> scaling(const T x, const T y, const T z);
+
 		/**
 		 * @brief Array index operator.
 		 *
@@ -62,7 +107,7 @@ namespace em
 		 *
 		 * @return The column / element of the matrix
 		 */
-		T *operator[](const unsigned &index);
+		constexpr T *operator[](const unsigned &index);
 
 		/**
 		 * @brief Const array index operator
@@ -71,12 +116,22 @@ namespace em
 		 *
 		 * @return The column / element of the matrix
 		 */
-		const T *operator[](const unsigned &index) const;
+		constexpr const T *operator[](const unsigned &index) const;
+
+		/**
+		 * @brief Checks whether the matrix is an affine transform
+		 *
+		 * @return True if the last row is (0, 0, 0, 1), false otherwise
+		 */
+		constexpr bool isAffine() const;
 
 		/**
 		 * @brief Negation operator
 		 *
 		 * @return Inverted matrix
+		 *
+		 * Affine matrices are inverted as a 3x3 linear part and a translation. Singular
+		 *   matrices have no inverse, identity matrix is returned for them.
 		 */
 		Matrix4<T> operator-() const;
 
@@ -160,6 +215,18 @@ namespace em
 		 * @return The result of the multiplication
 		 */
 		sf::Vector3<T> operator*(const sf::Vector3<T> &right) const;
+
+		/**
+		 * @brief Transforms a batch of points
+		 *
+		 * @param points The points to transform
+		 * @param result The array the transformed points are written to, it may be the same as points
+		 * @param count Amount of points
+		 *
+		 * Elements of the matrix are read once for all points, which makes it the
+		 *   cheaper choice whenever several points share the same transform.
+		 */
+		void transform(const sf::Vector3<T> *points, sf::Vector3<T> *result, const std::size_t count) const;
 		// Matrix4<T> operator+(const sf::Vector3<T> &right) const;
 		// Matrix4<T> operator-(const sf::Vector3<T> &right) const;
 
@@ -244,339 +311,132 @@ namespace em
 		// void print(const std::string &prefix) const;
 
 	private:
-		T m_matrix[4][4];
+		static void multiplyRows(const Matrix4<T> &left, const Matrix4<T> &right, Matrix4<T> &result, const unsigned rows);///> Computes the first rows of left * right
+		Matrix4<T> affineInverse() const;///> Inverse of an affine matrix
+		Matrix4<T> generalInverse() const;///> Inverse of any matrix by cofactors
+
+		alignas(16) T m_matrix[4][4];///> Elements of the matrix, row by row
 	};
 
 	template <typename T>
-	Matrix4<T>::Matrix4()
-	{
-		m_matrix[0][0] = 1;
-		m_matrix[0][1] = 0;
-		m_matrix[0][2] = 0;
-		m_matrix[0][3] = 0;
-		m_matrix[1][0] = 0;
-		m_matrix[1][1] = 1;
-		m_matrix[1][2] = 0;
-		m_matrix[1][3] = 0;
-		m_matrix[2][0] = 0;
-		m_matrix[2][1] = 0;
-		m_matrix[2][2] = 1;
-		m_matrix[2][3] = 0;
-		m_matrix[3][0] = 0;
-		m_matrix[3][1] = 0;
-		m_matrix[3][2] = 0;
-		m_matrix[3][3] = 1;
-	}
+	constexpr Matrix4<T>::Matrix4()
+	:
+	m_matrix{	{1, 0, 0, 0},
+				{0, 1, 0, 0},
+				{0, 0, 1, 0},
+				{0, 0, 0, 1} }
+	{ }
 
 	template <typename T>
-	Matrix4<T>::Matrix4(	T a00, T a01, T a02, T a03,
-						T a10, T a11, T a12, T a13,
-						T a20, T a21, T a22, T a23,
-						T a30, T a31, T a32, T a33 )
-	{
-		m_matrix[0][0] = a00;
-		m_matrix[0][1] = a01;
-		m_matrix[0][2] = a02;
-		m_matrix[0][3] = a03;
-		m_matrix[1][0] = a10;
-		m_matrix[1][1] = a11;
-		m_matrix[1][2] = a12;
-		m_matrix[1][3] = a13;
-		m_matrix[2][0] = a20;
-		m_matrix[2][1] = a21;
-		m_matrix[2][2] = a22;
-		m_matrix[2][3] = a23;
-		m_matrix[3][0] = a30;
-		m_matrix[3][1] = a31;
-		m_matrix[3][2] = a32;
-		m_matrix[3][3] = a33;
-	}
+	constexpr Matrix4<T>::Matrix4(	T a00, T a01, T a02, T a03,
+									T a10, T a11, T a12, T a13,
+									T a20, T a21, T a22, T a23,
+									T a30, T a31, T a32, T a33 )
+	:
+	m_matrix{	{a00, a01, a02, a03},
+				{a10, a11, a12, a13},
+				{a20, a21, a22, a23},
+				{a30, a31, a32, a33} }
+	{ }
 
 	template <typename T>
 	template <typename U>
-	Matrix4<T>::Matrix4(const Matrix4<U> &matrix)
+	inline Matrix4<T>::Matrix4(const Matrix4<U> &matrix)
 	{
 		for(unsigned i = 0; i < 4; i++)
 		{
 			for(unsigned j = 0; j < 4; j++)
 			{
-				m_matrix[i][j] = static_cast<T>(matrix.m_matrix[i][j]);
+				m_matrix[i][j] = static_cast<T>(matrix[i][j]);
 			}
 		}
 	}
 
 	template <typename T>
-	T *Matrix4<T>::operator[](const unsigned &index)
+	constexpr Matrix4<T> Matrix4<T>::identity()
 	{
-		return this->m_matrix[index];
+		return Matrix4<T>();
 	}
 
 	template <typename T>
-	const T *Matrix4<T>::operator[](const unsigned &index) const
+	constexpr Matrix4<T> Matrix4<T>::translation(const T x, const T y, const T z)
 	{
-		return this->m_matrix[index];
+		return Matrix4<T>(	1, 0, 0, x,
+							0, 1, 0, y,
+							0, 0, 1, z,
+							0, 0, 0, 1);
 	}
 
 	template <typename T>
-	Matrix4<T> Matrix4<T>::operator-() const
+	constexpr Matrix4<T> Matrix4<T>::scaling(const T x, const T y, const T z)
 	{
-		Matrix4<T> result;
-	    const Matrix4<T> &m = *this;
-
-	    result[0][0] = m[1][1]  * m[2][2] * m[3][3] - 
-	             m[1][1]  * m[2][3] * m[3][2] - 
-	             m[2][1]  * m[1][2]  * m[3][3] + 
-	             m[2][1]  * m[1][3]  * m[3][2] +
-	             m[3][1] * m[1][2]  * m[2][3] - 
-	             m[3][1] * m[1][3]  * m[2][2];
-
-	    result[1][0] = -m[1][0]  * m[2][2] * m[3][3] + 
-	              m[1][0]  * m[2][3] * m[3][2] + 
-	              m[2][0]  * m[1][2]  * m[3][3] - 
-	              m[2][0]  * m[1][3]  * m[3][2] - 
-	              m[3][0] * m[1][2]  * m[2][3] + 
-	              m[3][0] * m[1][3]  * m[2][2];
-
-	    result[2][0] = m[1][0]  * m[2][1] * m[3][3] - 
-	             m[1][0]  * m[2][3] * m[3][1] - 
-	             m[2][0]  * m[1][1] * m[3][3] + 
-	             m[2][0]  * m[1][3] * m[3][1] + 
-	             m[3][0] * m[1][1] * m[2][3] - 
-	             m[3][0] * m[1][3] * m[2][1];
-
-	    result[3][0] = -m[1][0]  * m[2][1] * m[3][2] + 
-	               m[1][0]  * m[2][2] * m[3][1] +
-	               m[2][0]  * m[1][1] * m[3][2] - 
-	               m[2][0]  * m[1][2] * m[3][1] - 
-	               m[3][0] * m[1][1] * m[2][2] + 
-	               m[3][0] * m[1][2] * m[2][1];
-
-	    result[0][1] = -m[0][1]  * m[2][2] * m[3][3] + 
-	              m[0][1]  * m[2][3] * m[3][2] + 
-	              m[2][1]  * m[0][2] * m[3][3] - 
-	              m[2][1]  * m[0][3] * m[3][2] - 
-	              m[3][1] * m[0][2] * m[2][3] + 
-	              m[3][1] * m[0][3] * m[2][2];
-
-	    result[1][1] = m[0][0]  * m[2][2] * m[3][3] - 
-	             m[0][0]  * m[2][3] * m[3][2] - 
-	             m[2][0]  * m[0][2] * m[3][3] + 
-	             m[2][0]  * m[0][3] * m[3][2] + 
-	             m[3][0] * m[0][2] * m[2][3] - 
-	             m[3][0] * m[0][3] * m[2][2];
-
-	    result[2][1] = -m[0][0]  * m[2][1] * m[3][3] + 
-	              m[0][0]  * m[2][3] * m[3][1] + 
-	              m[2][0]  * m[0][1] * m[3][3] - 
-	              m[2][0]  * m[0][3] * m[3][1] - 
-	              m[3][0] * m[0][1] * m[2][3] + 
-	              m[3][0] * m[0][3] * m[2][1];
-
-	    result[3][1] = m[0][0]  * m[2][1] * m[3][2] - 
-	              m[0][0]  * m[2][2] * m[3][1] - 
-	              m[2][0]  * m[0][1] * m[3][2] + 
-	              m[2][0]  * m[0][2] * m[3][1] + 
-	              m[3][0] * m[0][1] * m[2][2] - 
-	              m[3][0] * m[0][2] * m[2][1];
-
-	    result[0][2] = m[0][1]  * m[1][2] * m[3][3] - 
-	             m[0][1]  * m[1][3] * m[3][2] - 
-	             m[1][1]  * m[0][2] * m[3][3] + 
-	             m[1][1]  * m[0][3] * m[3][2] + 
-	             m[3][1] * m[0][2] * m[1][3] - 
-	             m[3][1] * m[0][3] * m[1][2];
-
-	    result[1][2] = -m[0][0]  * m[1][2] * m[3][3] + 
-	              m[0][0]  * m[1][3] * m[3][2] + 
-	              m[1][0]  * m[0][2] * m[3][3] - 
-	              m[1][0]  * m[0][3] * m[3][2] - 
-	              m[3][0] * m[0][2] * m[1][3] + 
-	              m[3][0] * m[0][3] * m[1][2];
-
-	    result[2][2] = m[0][0]  * m[1][1] * m[3][3] - 
-	              m[0][0]  * m[1][3] * m[3][1] - 
-	              m[1][0]  * m[0][1] * m[3][3] + 
-	              m[1][0]  * m[0][3] * m[3][1] + 
-	              m[3][0] * m[0][1] * m[1][3] - 
-	              m[3][0] * m[0][3] * m[1][1];
-
-	    result[3][2] = -m[0][0]  * m[1][1] * m[3][2] + 
-	               m[0][0]  * m[1][2] * m[3][1] + 
-	               m[1][0]  * m[0][1] * m[3][2] - 
-	               m[1][0]  * m[0][2] * m[3][1] - 
-	               m[3][0] * m[0][1] * m[1][2] + 
-	               m[3][0] * m[0][2] * m[1][1];
-
-	    result[0][3] = -m[0][1] * m[1][2] * m[2][3] + 
-	              m[0][1] * m[1][3] * m[2][2] + 
-	              m[1][1] * m[0][2] * m[2][3] - 
-	              m[1][1] * m[0][3] * m[2][2] - 
-	              m[2][1] * m[0][2] * m[1][3] + 
-	              m[2][1] * m[0][3] * m[1][2];
-
-	    result[1][3] = m[0][0] * m[1][2] * m[2][3] - 
-	             m[0][0] * m[1][3] * m[2][2] - 
-	             m[1][0] * m[0][2] * m[2][3] + 
-	             m[1][0] * m[0][3] * m[2][2] + 
-	             m[2][0] * m[0][2] * m[1][3] - 
-	             m[2][0] * m[0][3] * m[1][2];
-
-	    result[2][3] = -m[0][0] * m[1][1] * m[2][3] + 
-	               m[0][0] * m[1][3] * m[2][1] + 
-	               m[1][0] * m[0][1] * m[2][3] - 
-	               m[1][0] * m[0][3] * m[2][1] - 
-	               m[2][0] * m[0][1] * m[1][3] + 
-	               m[2][0] * m[0][3] * m[1][1];
-
-	    result[3][3] = m[0][0] * m[1][1] * m[2][2] - 
-	              m[0][0] * m[1][2] * m[2][1] - 
-	              m[1][0] * m[0][1] * m[2][2] + 
-	              m[1][0] * m[0][2] * m[2][1] + 
-	              m[2][0] * m[0][1] * m[1][2] - 
-	              m[2][0] * m[0][2] * m[1][1];
-
-		double det;
-	    det = m[0][0] * result[0][0] + m[0][1] * result[1][0] + m[0][2] * result[2][0] + m[0][3] * result[3][0];
-
-	    if(det == 0)
-	    {
-	        return Matrix4<T>();
-	    }
-
-	    det = 1.0 / det;
-
-	    for(unsigned i = 0; i < 4; i++)
-	    {
-	    	for(unsigned j = 0; j < 4; j++)
-	    	{
-	    		result[i][j] *= det;
-	    	}
-	    }
-
-	    return result;
+		return Matrix4<T>(	x, 0, 0, 0,
+							0, y, 0, 0,
+							0, 0, z, 0,
+							0, 0, 0, 1);
 	}
 
 	template <typename T>
-	Matrix4<T> Matrix4<T>::operator*(const Matrix4<T> &right) const
+	constexpr T *Matrix4<T>::operator[](const unsigned &index)
 	{
-		Matrix4<T> result;
-		result[0][0] = (*this)[0][0]*right[0][0] + (*this)[0][1]*right[1][0] + (*this)[0][2]*right[2][0] + (*this)[0][3]*right[3][0];
-		result[0][1] = (*this)[0][0]*right[0][1] + (*this)[0][1]*right[1][1] + (*this)[0][2]*right[2][1] + (*this)[0][3]*right[3][1];
-		result[0][2] = (*this)[0][0]*right[0][2] + (*this)[0][1]*right[1][2] + (*this)[0][2]*right[2][2] + (*this)[0][3]*right[3][2];
-		result[0][3] = (*this)[0][0]*right[0][3] + (*this)[0][1]*right[1][3] + (*this)[0][2]*right[2][3] + (*this)[0][3]*right[3][3];
-
-		result[1][0] = (*this)[1][0]*right[0][0] + (*this)[1][1]*right[1][0] + (*this)[1][2]*right[2][0] + (*this)[1][3]*right[3][0];
-		result[1][1] = (*this)[1][0]*right[0][1] + (*this)[1][1]*right[1][1] + (*this)[1][2]*right[2][1] + (*this)[1][3]*right[3][1];
-		result[1][2] = (*this)[1][0]*right[0][2] + (*this)[1][1]*right[1][2] + (*this)[1][2]*right[2][2] + (*this)[1][3]*right[3][2];
-		result[1][3] = (*this)[1][0]*right[0][3] + (*this)[1][1]*right[1][3] + (*this)[1][2]*right[2][3] + (*this)[1][3]*right[3][3];
-
-		result[2][0] = (*this)[2][0]*right[0][0] + (*this)[2][1]*right[1][0] + (*this)[2][2]*right[2][0] + (*this)[2][3]*right[3][0];
-		result[2][1] = (*this)[2][0]*right[0][1] + (*this)[2][1]*right[1][1] + (*this)[2][2]*right[2][1] + (*this)[2][3]*right[3][1];
-		result[2][2] = (*this)[2][0]*right[0][2] + (*this)[2][1]*right[1][2] + (*this)[2][2]*right[2][2] + (*this)[2][3]*right[3][2];
-		result[2][3] = (*this)[2][0]*right[0][3] + (*this)[2][1]*right[1][3] + (*this)[2][2]*right[2][3] + (*this)[2][3]*right[3][3];
-
-		result[3][0] = (*this)[3][0]*right[0][0] + (*this)[3][1]*right[1][0] + (*this)[3][2]*right[2][0] + (*this)[3][3]*right[3][0];
-		result[3][1] = (*this)[3][0]*right[0][1] + (*this)[3][1]*right[1][1] + (*this)[3][2]*right[2][1] + (*this)[3][3]*right[3][1];
-		result[3][2] = (*this)[3][0]*right[0][2] + (*this)[3][1]*right[1][2] + (*this)[3][2]*right[2][2] + (*this)[3][3]*right[3][2];
-		result[3][3] = (*this)[3][0]*right[0][3] + (*this)[3][1]*right[1][3] + (*this)[3][2]*right[2][3] + (*this)[3][3]*right[3][3];
-		return result;
-	}
-
-	template <typename T>
-	Matrix4<T> Matrix4<T>::operator+(const Matrix4<T> &right) const
-	{
-		Matrix4<T> result;
-		for(unsigned i = 0; i < 4; i++)
-		{
-			for(unsigned j = 0; j < 4; j++)
-			{
-				result[i][j] = m_matrix[i][j] + right[i][j];
-			}
-		}
-		return result;
+		return this->m_matrix[index];
 	}
 
 	template <typename T>
-	Matrix4<T> Matrix4<T>::operator-(const Matrix4<T> &right) const
+	constexpr const T *Matrix4<T>::operator[](const unsigned &index) const
 	{
-		Matrix4<T> result;
-		for(unsigned i = 0; i < 4; i++)
-		{
-			for(unsigned j = 0; j < 4; j++)
-			{
-				result[i][j] = m_matrix[i][j] - right[i][j];
-			}
-		}
-		return result;
+		return this->m_matrix[index];
 	}
 
 	template <typename T>
-	Matrix4<T> &Matrix4<T>::operator*=(const Matrix4<T> &right)
+	constexpr bool Matrix4<T>::isAffine() const
 	{
-		(*this) = (*this) * right;
-		return *this;
+		return m_matrix[3][0] == 0 && m_matrix[3][1] == 0 && m_matrix[3][2] == 0 && m_matrix[3][3] == 1;
 	}
 
 	template <typename T>
-	Matrix4<T> &Matrix4<T>::operator+=(const Matrix4<T> &right)
+	inline Matrix4<T> Matrix4<T>::operator*(const Matrix4<T> &right) const
 	{
-		*this = *this + right;
-		return *this;
+		//product of affine matrices is affine, its last row stays the one of identity
+		Matrix4<T> result;
+		Matrix4<T>::multiplyRows(*this, right, result, (this->isAffine() && right.isAffine()) ? 3u : 4u);
+		return result;
 	}
 
 	template <typename T>
-	Matrix4<T> &Matrix4<T>::operator-=(const Matrix4<T> &right)
+	inline Matrix4<T> &Matrix4<T>::operator*=(const Matrix4<T> &right)
 	{
-		*this = *this - right;
+		(*this) = (*this) * right;
 		return *this;
 	}
 
 	template <typename T>
-	const bool Matrix4<T>::operator!=(const Matrix4<T> &right) const
-	{
-		for(unsigned i = 0; i < 4; i++)
-		{
-			for(unsigned j = 0; j < 4; j++)
-			{
-				if(m_matrix[i][j] != right[i][j])
-					return true;
-			}
-		}
-		return false;
-	}
-
-	template <typename T>
-	const bool Matrix4<T>::operator==(const Matrix4<T> &right) const
+	inline sf::Vector3<T> Matrix4<T>::operator*(const sf::Vector3<T> &right) const
 	{
-		for(unsigned i = 0; i < 4; i++)
-		{
-			for(unsigned j = 0; j < 4; j++)
-			{
-				if(m_matrix[i][j] != right[i][j])
-					return false;
-			}
-		}
-		return true;
+		//the projective row would only give w, which is not a part of the result
+		return sf::Vector3<T>(
+			m_matrix[0][0] * right.x + m_matrix[0][1] * right.y + m_matrix[0][2] * right.z + m_matrix[0][3],
+			m_matrix[1][0] * right.x + m_matrix[1][1] * right.y + m_matrix[1][2] * right.z + m_matrix[1][3],
+			m_matrix[2][0] * right.x + m_matrix[2][1] * right.y + m_matrix[2][2] * right.z + m_matrix[2][3]);
 	}
 
 	template <typename T>
-	sf::Vector3<T> Matrix4<T>::operator*(const sf::Vector3<T> &right) const
+	inline void Matrix4<T>::transform(const sf::Vector3<T> *points, sf::Vector3<T> *result, const std::size_t count) const
 	{
-		T arr[4] = {right.x, right.y, right.z, 1};
-		T res[4] = {0};
-		for(unsigned i = 0; i < 4; i++)
+		const T m00 = m_matrix[0][0], m01 = m_matrix[0][1], m02 = m_matrix[0][2], m03 = m_matrix[0][3];
+		const T m10 = m_matrix[1][0], m11 = m_matrix[1][1], m12 = m_matrix[1][2], m13 = m_matrix[1][3];
+		const T m20 = m_matrix[2][0], m21 = m_matrix[2][1], m22 = m_matrix[2][2], m23 = m_matrix[2][3];
+		for(std::size_t i = 0; i < count; i++)
 		{
-			for(unsigned j = 0; j < 4; j++)
-			{
-				res[i] += m_matrix[i][j] * arr[j];
-			}
+			const T x = points[i].x, y = points[i].y, z = points[i].z;
+			result[i].x = m00 * x + m01 * y + m02 * z + m03;
+			result[i].y = m10 * x + m11 * y + m12 * z + m13;
+			result[i].z = m20 * x + m21 * y + m22 * z + m23;
 		}
-		sf::Vector3<T> result(res[0], res[1], res[2]);
-		return result;
 	}
 
 	template <typename T>
-	Matrix4<T> &Matrix4<T>::translate(const sf::Vector3<T> &translation)
+	inline Matrix4<T> &Matrix4<T>::translate(const sf::Vector3<T> &translation)
 	{
 		m_matrix[0][3] += translation.x;
 		m_matrix[1][3] += translation.y;
@@ -585,101 +445,62 @@ namespace em
 	}
 
 	template <typename T>
-	Matrix4<T> &Matrix4<T>::rotateX(const float &angle)
-	{
-		double emPI = 3.141592654;
-		T rad = fmod(angle * emPI / 180.0, 2.0 * emPI);
-		T cos_x = std::cos(rad);
-		T sin_x = std::sin(rad);
-		
-		(*this) *= Matrix4<T>(	1, 0, 0, 0,
-								0, cos_x, -sin_x, 0,
-								0, sin_x, cos_x, 0,
-								0, 0, 0, 1);
-		return *this;
-	}
-
-	template <typename T>
-	Matrix4<T> &Matrix4<T>::rotateY(const float &angle)
-	{
-		double emPI = 3.141592654;
-		T rad = fmod(angle * emPI / 180.0, 2.0 * emPI);
-		T cos_y = std::cos(rad);
-		T sin_y = std::sin(rad);
-		
-		(*this) *= Matrix4<T>(	cos_y, 0, sin_y, 0,
-								0, 1, 0, 0,
-								-sin_y, 0, cos_y, 0,
-								0, 0, 0, 1);
-		return *this;
-	}
-
-	template <typename T>
-	Matrix4<T> &Matrix4<T>::rotateZ(const float &angle)
+	inline const sf::Vector3<T> Matrix4<T>::toPosition() const
 	{
-		double emPI = 3.141592654;
-		T rad = fmod(angle * emPI / 180.0, 2.0 * emPI);
-		T cos_z = std::cos(rad);
-		T sin_z = std::sin(rad);
-		
-		(*this) *= Matrix4<T>(	cos_z, -sin_z, 0, 0,
-								sin_z, cos_z, 0, 0,
-								0, 0, 1, 0,
-								0, 0, 0, 1);
-		return *this;
+		return sf::Vector3<T>(m_matrix[0][3], m_matrix[1][3], m_matrix[2][3]);
 	}
 
 	template <typename T>
-	Matrix4<T> &Matrix4<T>::scale(const sf::Vector3<T> &scale)
+	inline void Matrix4<T>::multiplyRows(const Matrix4<T> &left, const Matrix4<T> &right, Matrix4<T> &result, const unsigned rows)
 	{
-		(*this) *= Matrix4<T>(	scale.x, 0, 0, 0,
-								0, scale.y, 0, 0, 
-								0, 0, scale.z, 0,
-								0, 0, 0, 1);
-		return *this;
+		for(unsigned i = 0; i < rows; i++)
+		{
+			for(unsigned j = 0; j < 4; j++)
+			{
+				result[i][j] = left[i][0]*right[0][j] + left[i][1]*right[1][j] + left[i][2]*right[2][j] + left[i][3]*right[3][j];
+			}
+		}
 	}
 
-	template <typename T>
-	Matrix4<T> &Matrix4<T>::mirror(const bool xAxis, const bool yAxis, const bool zAxis)
+#if defined(EM_SSE) || defined(EM_NEON)
+	//row i of the product is the sum of rows of right scaled by elements of row i of left
+	template <>
+	inline void Matrix4<float>::multiplyRows(const Matrix4<float> &left, const Matrix4<float> &right, Matrix4<float> &result, const unsigned rows)
 	{
-		Matrix4<T> mirrorMatrix;
-		if(xAxis)
+	#if defined(EM_SSE)
+		const __m128 r0 = _mm_load_ps(right[0]);
+		const __m128 r1 = _mm_load_ps(right[1]);
+		const __m128 r2 = _mm_load_ps(right[2]);
+		const __m128 r3 = _mm_load_ps(right[3]);
+		for(unsigned i = 0; i < rows; i++)
 		{
-			mirrorMatrix[0][0] = -1;
+			__m128 row = _mm_mul_ps(_mm_set1_ps(left[i][0]), r0);
+			row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(left[i][1]), r1));
+			row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(left[i][2]), r2));
+			row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(left[i][3]), r3));
+			_mm_store_ps(result[i], row);
 		}
-		if(yAxis)
+	#else
+		const float32x4_t r0 = vld1q_f32(right[0]);
+		const float32x4_t r1 = vld1q_f32(right[1]);
+		const float32x4_t r2 = vld1q_f32(right[2]);
+		const float32x4_t r3 = vld1q_f32(right[3]);
+		for(unsigned i = 0; i < rows; i++)
 		{
-			mirrorMatrix[1][1] = -1;
+			float32x4_t row = vmulq_n_f32(r0, left[i][0]);
+			row = vaddq_f32(row, vmulq_n_f32(r1, left[i][1]));
+			row = vaddq_f32(row, vmulq_n_f32(r2, left[i][2]));
+			row = vaddq_f32(row, vmulq_n_f32(r3, left[i][3]));
+			vst1q_f32(result[i], row);
 		}
-		if(zAxis)
-		{
-			mirrorMatrix[2][2] = -1;
-		}
-		
-		(*this) *= mirrorMatrix;
-		return *this;
-	}
-
-	template <typename T>
-	const sf::Vector3<T> Matrix4<T>::toPosition() const
-	{
-		return sf::Vector3<T>(m_matrix[0][3], m_matrix[1][3], m_matrix[2][3]);
+	#endif
 	}
+#endif
 
-/*	template <typename T>
-	void Matrix4<T>::print(const std::string &prefix) const
-	{
-		std::cout << prefix << std::endl;
-		for(unsigned i = 0; i < 4; i++)
-		{
-			for(unsigned j = 0; j < 4; j++)
-			{
-				std::cout << m_matrix[i][j] << " ";
-			}
-			std::cout << std::endl;
-		}
-		std::cout << std::endl;
-	}*/
+	//operations not needed per vertex or pixel are compiled once, in ExtendedMath.cpp
+	extern template class Matrix4<float>;
+	extern template class Matrix4<int>;
+	extern template class Matrix4<unsigned>;
 
 	typedef Matrix4<float> Matrix4f;
 	typedef Matrix4<int> Matrix4i;
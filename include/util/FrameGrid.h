@@ -0,0 +1,115 @@
+#pragma once
+
+#include "../root/Std.h"
+
+/**
+ * @brief Frames of an animation of given length, spread evenly from its start to its end
+ *
+ * The first frame is at the start of the animation and the last one at its end,
+ *   moved slightly before it so that it still shows the animation and not what
+ *   comes after. Time of every frame is computed straight from its index, so
+ *   seeking to any frame is O(1) and no error gathers over many frames. Timeline,
+ *   the frame cache of Canvas and exports all place frames by this grid.
+ */
+class FrameGrid
+{
+public:
+	/**
+	 * @brief How much the last frame is placed before the end of the animation, in seconds
+	 */
+	static constexpr float END_MARGIN = 0.0001f;
+
+	/**
+	 * @brief Default constructor creating a grid without frames
+	 */
+	FrameGrid();
+
+	/**
+	 * @brief Constructor spreading the frames over the animation
+	 *
+	 * @param frames Amount of frames
+	 * @param length Length of the animation in seconds
+	 */
+	FrameGrid(const unsigned frames, const float &length);
+
+	/**
+	 * @brief Creates a grid of frames following each other at a rate
+	 *
+	 * @param fps Frames per second, at least one frame is placed after the first
+	 * @param length Length of the animation in seconds
+	 *
+	 * @return Grid from the start to the end of the animation, its time between frames
+	 *   is 1 / fps whenever the length holds a whole amount of frames
+	 */
+	static FrameGrid atRate(const float &fps, const float &length);
+
+	/**
+	 * @brief Getter to the amount of frames
+	 *
+	 * @return The amount of frames
+	 */
+	unsigned getFrames() const;
+
+	/**
+	 * @brief Getter to the length of the animation
+	 *
+	 * @return The length in seconds
+	 */
+	const float &getLength() const;
+
+	/**
+	 * @brief Getter to the time between neighbouring frames
+	 *
+	 * @return The time in seconds, 0 if the grid is not valid
+	 */
+	const float &getDelta() const;
+
+	/**
+	 * @brief Checks whether there are frames to place
+	 *
+	 * @return True if there is at least one frame and the animation has some length
+	 */
+	bool isValid() const;
+
+	/**
+	 * @brief Gets the time of the frame
+	 *
+	 * @param frame Index of the frame, indices after the last frame give the last frame
+	 *
+	 * @return Time of the frame in seconds
+	 */
+	float timeOf(const unsigned frame) const;
+
+	/**
+	 * @brief Gets the last frame at or before the time
+	 *
+	 * @param time Time of the animation in seconds
+	 *
+	 * @return Index of the frame, 0 if the grid is not valid
+	 */
+	unsigned frameAt(const float &time) const;
+
+	/**
+	 * @brief Gets the frame nearest to the time
+	 *
+	 * @param time Time of the animation in seconds
+	 *
+	 * @return Index of the frame, 0 if the grid is not valid
+	 */
+	unsigned nearestFrame(const float &time) const;
+
+	/**
+	 * @brief Gets times of all the frames
+	 *
+	 * @return Time of every frame in order
+	 */
+	std::vector<float> times() const;
+
+	bool operator==(const FrameGrid &other) const;
+	bool operator!=(const FrameGrid &other) const;
+
+private:
+	unsigned m_frames;///> Amount of frames
+	float m_length;///> Length of the animation in seconds
+	float m_delta;///> Time between neighbouring frames
+};
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "../root/Std.h"
+
+/**
+ * @brief Paces frames shown with vertical sync, predicting when each of them reaches the screen
+ *
+ * With vertical sync a frame is shown at a refresh of the display, a whole amount
+ *   of refresh intervals after the previous one. Advancing the animation by the
+ *   measured time between frames makes it jitter by the scheduling of the thread.
+ *   The pacer instead gives every frame the time of the refresh it is expected to
+ *   be shown at: the next one after the previous present which leaves enough time
+ *   for the work a frame took recently. A frame shown later than predicted counts
+ *   as dropped, and the next one catches up, so the animation keeps to real time.
+ *
+ * The refresh interval is learned from the intervals between presents. Times are
+ *   given by the caller in seconds of a monotonic clock.
+ */
+class FramePacer
+{
+public:
+	/**
+	 * @brief Statistics of the frames presented since they were cleared
+	 */
+	struct Statistics
+	{
+		std::size_t frames = 0u;		///> Presented frames
+		std::size_t dropped = 0u;		///> Refreshes frames came late by
+		float refreshInterval = 0.f;	///> Learned time between refreshes in seconds
+		float meanInterval = 0.f;		///> Mean time between presents in seconds
+		float worstInterval = 0.f;		///> Longest time between presents in seconds
+	};
+
+	static constexpr float LATE_SHARE = 0.5f;///> Part of a refresh interval a frame may come late by before it counts as dropped
+	static constexpr unsigned MAX_REFRESHES = 4u;///> Most refreshes a frame is predicted to take
+
+	/**
+	 * @brief Constructor setting the refresh interval assumed until one is learned
+	 *
+	 * @param refresh_interval Time between refreshes in seconds, non-positive values are replaced by 1/60
+	 */
+	explicit FramePacer(const float &refresh_interval = 1.f / 60.f);
+
+	/**
+	 * @brief Forgets the last present, so the next frame starts the pacing again
+	 *
+	 * Called after the frames were not presented continuously, e.g. while the
+	 *   animation was paused. The statistics and the refresh interval are kept.
+	 */
+	void reset();
+
+	/**
+	 * @brief Clears the statistics
+	 */
+	void clearStatistics();
+
+	/**
+	 * @brief Starts a frame and predicts the refresh it is shown at
+	 *
+	 * @param now Current time in seconds
+	 *
+	 * @return Time the animation is advanced by, from the predicted present of the
+	 *   previous frame to the one of this frame, 0 for the first frame after a reset
+	 */
+	float beginFrame(const double &now);
+
+	/**
+	 * @brief Marks the frame as drawn, right before it is handed to the display
+	 *
+	 * @param now Current time in seconds
+	 */
+	void submitted(const double &now);
+
+	/**
+	 * @brief Marks the frame as shown, right after the display returned
+	 *
+	 * @param now Current time in seconds
+	 */
+	void presented(const double &now);
+
+	/**
+	 * @brief Getter to the predicted present of the current frame
+	 *
+	 * @return Time in seconds
+	 */
+	double getPredictedPresent() const;
+
+	/**
+	 * @brief Getter to the statistics
+	 *
+	 * @return Statistics of the frames presented since they were cleared
+	 */
+	Statistics getStatistics() const;
+
+private:
+	float m_refreshInterval;///> Learned time between refreshes
+	float m_work;///> Moving average of the time from the start of a frame until it is drawn
+	bool m_running;///> Whether a frame was presented since the last reset
+	double m_frameBegin;///> Start of the current frame
+	double m_lastPresent;///> Time the previous frame was shown at
+	double m_predicted;///> Predicted present of the current frame
+	Statistics m_statistics;///> Statistics without the mean interval
+	double m_intervalSum;///> Sum of the times between presents
+	std::size_t m_intervalCount;///> Amount of the times between presents, presents after resets start none
+};
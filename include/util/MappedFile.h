@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../root/Std.h"
+
+/**
+ * @brief File mapped into memory for reading
+ *
+ * The contents are read by the operating system when their pages are first
+ *   touched, nothing is copied into buffers of the application. The mapping
+ *   stays valid until the object is destroyed.
+ */
+class MappedFile
+{
+public:
+	/**
+	 * @brief Default constructor of an object mapping no file
+	 */
+	MappedFile();
+
+	/**
+	 * @brief Constructor mapping the whole file
+	 *
+	 * @param path Path to the file
+	 *
+	 * Throws std::runtime_error if the file cannot be opened or mapped.
+	 */
+	explicit MappedFile(const std::string &path);
+
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	MappedFile(MappedFile &&source);
+	MappedFile &operator=(MappedFile &&source);
+
+	/**
+	 * @brief Destructor unmapping the file
+	 */
+	~MappedFile();
+
+	/**
+	 * @brief Getter to the contents
+	 *
+	 * @return Pointer to the first byte, nullptr for empty or no file
+	 */
+	const std::uint8_t *data() const;
+
+	/**
+	 * @brief Getter to the size of the file
+	 *
+	 * @return Amount of mapped bytes
+	 */
+	std::size_t size() const;
+
+private:
+	void unmap();///> Releases the mapping
+
+	const std::uint8_t *m_data;///> First byte of the mapping, nullptr if nothing is mapped
+	std::size_t m_size;///> Amount of mapped bytes
+};
@@ -0,0 +1,183 @@
+#pragma once
+
+#include "../root/System.h"
+
+/**
+ * @brief Parts of the application the memory is accounted to
+ */
+enum class MemorySubsystem
+{
+	ANIMATIONS = 0,		///> Pixels held by animations and the frames computed from them
+	IMAGES = 1,			///> Decoded images, their textures and the plane of the canvas
+	FRAME_CACHE = 2,	///> Frames rendered ahead
+	GUI = 3,			///> Layers of the panels, the icon atlas and the frames handed to the window
+	EXPORT = 4,			///> Frames waiting to be encoded
+	COUNT = 5
+};
+
+/**
+ * @brief Counters of the CPU and GPU memory taken by every subsystem and the budget they share
+ *
+ * Owners of big buffers and textures hold a MemoryCharge sized to them, so the
+ *   counters always match what is alive. The budget itself is not enforced here,
+ *   subsystems which are able to give memory back (lowering the resolution of
+ *   the images, dropping cached frames) check it and degrade on their own.
+ *
+ * The budget is taken from the BCG_MEMORY_BUDGET environment variable in MiB if it is set.
+ */
+class MemoryBudget
+{
+public:
+	static constexpr std::size_t DEFAULT_BUDGET = 1024u * 1024u * 1024u;///> Budget of CPU and GPU memory together in bytes
+
+	MemoryBudget(const MemoryBudget &) = delete;
+	MemoryBudget &operator=(const MemoryBudget &) = delete;
+
+	/**
+	 * @brief Getter to the counters shared by the whole application
+	 *
+	 * @return The counters
+	 */
+	static MemoryBudget &shared();
+
+	/**
+	 * @brief Getter to the name of a subsystem
+	 *
+	 * @param subsystem The subsystem
+	 *
+	 * @return Name shown in the overlay
+	 */
+	static const char *getName(const MemorySubsystem subsystem);
+
+	/**
+	 * @brief Sets the budget
+	 *
+	 * @param bytes Amount of CPU and GPU memory together, 0 means no budget
+	 */
+	void setBudget(const std::size_t bytes);
+
+	/**
+	 * @brief Getter to the budget
+	 *
+	 * @return Amount of bytes, 0 if there is no budget
+	 */
+	std::size_t getBudget() const;
+
+	/**
+	 * @brief Getter to the CPU memory taken by a subsystem
+	 *
+	 * @param subsystem The subsystem
+	 *
+	 * @return Amount of bytes
+	 */
+	std::size_t getCpuUsage(const MemorySubsystem subsystem) const;
+
+	/**
+	 * @brief Getter to the GPU memory taken by a subsystem
+	 *
+	 * @param subsystem The subsystem
+	 *
+	 * @return Amount of bytes
+	 */
+	std::size_t getGpuUsage(const MemorySubsystem subsystem) const;
+
+	/**
+	 * @brief Getter to the memory taken by all subsystems
+	 *
+	 * @return Amount of CPU and GPU bytes together
+	 */
+	std::size_t getTotalUsage() const;
+
+	/**
+	 * @brief Checks whether the subsystems take more than the budget
+	 *
+	 * @return True if over the budget, always false without a budget
+	 */
+	bool isOverBudget() const;
+
+	/**
+	 * @brief Changes the counters, meant to be called by MemoryCharge
+	 *
+	 * @param subsystem Subsystem the memory is accounted to
+	 * @param cpu Change of the CPU memory in bytes
+	 * @param gpu Change of the GPU memory in bytes
+	 */
+	void add(const MemorySubsystem subsystem, const std::ptrdiff_t cpu, const std::ptrdiff_t gpu);
+
+private:
+	MemoryBudget();
+
+	static constexpr std::size_t COUNT = static_cast<std::size_t>(MemorySubsystem::COUNT);
+
+	std::array<std::atomic<std::ptrdiff_t>, COUNT> m_cpu;///> CPU bytes of every subsystem
+	std::array<std::atomic<std::ptrdiff_t>, COUNT> m_gpu;///> GPU bytes of every subsystem
+	std::atomic<std::size_t> m_budget;///> Budget of all subsystems together, 0 if there is none
+};
+
+/**
+ * @brief Memory accounted to a subsystem for as long as its owner lives
+ *
+ * Copies charge the same amount again, as copying the owner copies its buffers too.
+ */
+class MemoryCharge
+{
+public:
+	/**
+	 * @brief Constructor of an empty charge
+	 *
+	 * @param subsystem Subsystem the memory is accounted to
+	 */
+	explicit MemoryCharge(const MemorySubsystem subsystem);
+
+	MemoryCharge(const MemoryCharge &copy);
+	MemoryCharge(MemoryCharge &&source);
+	MemoryCharge &operator=(const MemoryCharge &copy);
+	MemoryCharge &operator=(MemoryCharge &&source);
+
+	/**
+	 * @brief Destructor giving the memory back
+	 */
+	~MemoryCharge();
+
+	/**
+	 * @brief Sets the amount of CPU memory
+	 *
+	 * @param bytes Amount of bytes currently held
+	 */
+	void setCpu(const std::size_t bytes);
+
+	/**
+	 * @brief Sets the amount of GPU memory
+	 *
+	 * @param bytes Amount of bytes currently held
+	 */
+	void setGpu(const std::size_t bytes);
+
+	/**
+	 * @brief Getter to the amount of CPU memory
+	 *
+	 * @return Amount of bytes
+	 */
+	std::size_t getCpu() const;
+
+	/**
+	 * @brief Getter to the amount of GPU memory
+	 *
+	 * @return Amount of bytes
+	 */
+	std::size_t getGpu() const;
+
+	/**
+	 * @brief Computes the memory of a texture or an image
+	 *
+	 * @param size Size in pixels
+	 *
+	 * @return Amount of bytes, 4 per pixel
+	 */
+	static std::size_t bytesOf(const sf::Vector2u &size);
+
+private:
+	MemorySubsystem m_subsystem;///> Subsystem the memory is accounted to
+	std::size_t m_cpu;///> CPU bytes of the charge
+	std::size_t m_gpu;///> GPU bytes of the charge
+};
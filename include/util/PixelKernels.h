@@ -0,0 +1,372 @@
+#pragma once
+
+#include "../root/System.h"
+#include "PixelView.h"
+
+/**
+ * @brief Vectorized kernels working on interleaved RGBA8 pixel buffers
+ *
+ * Kernels taking a PixelView work on the other channel types of PixelView.h
+ *   as well, the raw RGBA8 ones are the fast path of textures and animations.
+ *
+ * Every kernel has a scalar implementation and, depending on the platform,
+ * SSE2, AVX2 and NEON ones. The fastest implementation supported by the CPU
+ * is picked at runtime on the first call.
+ *
+ * Channel scaling uses 8.8 fixed-point factors, where 256 keeps the channel
+ * unchanged and 0 clears it, so it never touches floating point in the loop.
+ * Transforms which are not a plain scaling go through per-channel lookup
+ * tables built once per frame.
+ */
+namespace pk
+{
+	/**
+	 * @brief Instruction sets the kernels can be dispatched to
+	 */
+	enum class Isa
+	{
+		SCALAR = 0,
+		SSE2 = 1,
+		AVX2 = 2,
+		NEON = 3
+	};
+
+	/**
+	 * @brief Fixed-point factors applied to the particular channels of a pixel
+	 *
+	 * Each factor ranges from 0 (channel cleared) to 256 (channel unchanged).
+	 */
+	struct ChannelFactors
+	{
+		std::uint16_t r;
+		std::uint16_t g;
+		std::uint16_t b;
+		std::uint16_t a;
+
+		bool operator==(const ChannelFactors &right) const { return r == right.r && g == right.g && b == right.b && a == right.a; }
+		bool operator!=(const ChannelFactors &right) const { return !(*this == right); }
+	};
+
+	/**
+	 * @brief Lookup tables mapping every 8-bit value of the particular channels of a pixel
+	 *
+	 * Tables are filled once per frame, so any curve, however costly to evaluate,
+	 *   costs one lookup per channel in the loop.
+	 */
+	struct ChannelLut
+	{
+		std::array<std::uint8_t, 256> r;
+		std::array<std::uint8_t, 256> g;
+		std::array<std::uint8_t, 256> b;
+		std::array<std::uint8_t, 256> a;
+	};
+
+	/**
+	 * @brief Differences between two images found by diffImages
+	 */
+	struct DiffStats
+	{
+		std::uint8_t maxDifference = 0u;///> Biggest difference of a channel of any pixel
+		std::size_t differingPixels = 0u;///> Amount of pixels with a channel differing by more than the tolerance
+	};
+
+	/**
+	 * @brief Gets the instruction set the kernels are currently dispatched to
+	 *
+	 * @return The active instruction set
+	 */
+	Isa activeIsa();
+
+	/**
+	 * @brief Forces the kernels to use the given instruction set
+	 *
+	 * @param isa The instruction set
+	 *
+	 * @return True if the instruction set is supported and was selected, false otherwise
+	 *
+	 * Mostly useful to compare implementations against each other. It may be called
+	 *   while pool threads run kernels, every run over a row picks the instruction
+	 *   set once, so a frame computed meanwhile may mix the old and the new one.
+	 */
+	bool setIsa(Isa isa);
+
+	/**
+	 * @brief Checks whether the CPU is able to run kernels of given instruction set
+	 *
+	 * @param isa The instruction set
+	 *
+	 * @return True if supported, false otherwise
+	 */
+	bool isSupported(Isa isa);
+
+	/**
+	 * @brief Gets the printable name of the instruction set
+	 *
+	 * @param isa The instruction set
+	 *
+	 * @return Name of the instruction set
+	 */
+	const char *isaName(Isa isa);
+
+	/**
+	 * @brief Converts the progress to a fixed-point channel factor
+	 *
+	 * @param progress Value ranging from 0 to 1, values outside are clamped
+	 *
+	 * @return Factor ranging from 0 to 256
+	 */
+	inline std::uint16_t toFactor(float progress)
+	{
+		if(!(progress > 0.f))
+		{
+			return 0u;
+		}
+		if(progress >= 1.f)
+		{
+			return 256u;
+		}
+		return static_cast<std::uint16_t>(progress * 256.f + 0.5f);
+	}
+
+	/**
+	 * @brief Converts factors of straight-alpha pixels to ones giving the same picture on premultiplied pixels
+	 *
+	 * @param factors Factors applied on straight-alpha pixels
+	 *
+	 * @return Factors of r, g and b multiplied by the factor of alpha
+	 */
+	inline ChannelFactors premultiplied(const ChannelFactors &factors)
+	{
+		auto times_alpha = [&factors](const std::uint16_t factor)
+		{
+			return static_cast<std::uint16_t>((factor * factors.a + 128u) >> 8);
+		};
+		return { times_alpha(factors.r), times_alpha(factors.g), times_alpha(factors.b), factors.a };
+	}
+
+	/**
+	 * @brief Scales every channel of the pixels by its factor
+	 *
+	 * @param src The source pixels
+	 * @param dst The destination pixels, may be the same as src
+	 * @param pixels Amount of pixels (not bytes) to process
+	 * @param factors Factors of the particular channels
+	 *
+	 * dst = (src * factor + 128) >> 8, done separately for r, g, b and a.
+	 */
+	void scaleChannels(const std::uint8_t *src, std::uint8_t *dst, std::size_t pixels, const ChannelFactors &factors);
+
+	/**
+	 * @brief Scales every channel of the pixels of any channel type by its factor
+	 *
+	 * @param src The source pixels
+	 * @param dst The destination pixels of the same size, may be the same as src
+	 * @param factors Factors of the particular channels
+	 *
+	 * Instantiated for std::uint8_t, std::uint16_t, Half and float. 8-bit pixels take
+	 *   the kernel above, 16-bit ones the same fixed-point scaling with SSE2 and NEON
+	 *   implementations, so fades of 16-bit sources keep 256 times finer steps.
+	 *   Floating point channels are multiplied by factor / 256, SIMD for float and
+	 *   through float for Half. Throws std::invalid_argument if the sizes differ.
+	 */
+	template <typename Channel>
+	void scaleChannels(const SourceView<Channel> &src, const PixelView<Channel> &dst, const ChannelFactors &factors);
+
+	/**
+	 * @brief Builds tables of the same scaling as scaleChannels performs
+	 *
+	 * @param factors Factors of the particular channels
+	 *
+	 * @return The tables
+	 */
+	ChannelLut scalingLut(const ChannelFactors &factors);
+
+	/**
+	 * @brief Builds tables scaling colors in linear light instead of the stored values
+	 *
+	 * @param factors Factors of the particular channels
+	 *
+	 * @return The tables
+	 *
+	 * r, g and b are decoded from sRGB, scaled and encoded back, which keeps fades
+	 *   to black from crushing the shadows before the midtones. Alpha is coverage,
+	 *   so it is scaled as stored.
+	 */
+	ChannelLut linearLightScalingLut(const ChannelFactors &factors);
+
+	/**
+	 * @brief Maps every channel of the pixels through its table
+	 *
+	 * @param src The source pixels
+	 * @param dst The destination pixels, may be the same as src
+	 * @param pixels Amount of pixels (not bytes) to process
+	 * @param lut Tables of the particular channels
+	 */
+	void applyLut(const std::uint8_t *src, std::uint8_t *dst, std::size_t pixels, const ChannelLut &lut);
+
+	/**
+	 * @brief Copies the pixels clearing alpha of those whose mask pixel is bright enough
+	 *
+	 * @param src The source pixels
+	 * @param mask The pixels whose brightness is tested
+	 * @param dst The destination pixels, may be the same as src
+	 * @param pixels Amount of pixels to process
+	 * @param key The brightness threshold
+	 *
+	 * Brightness of a pixel is the average of its r, g and b channels. Alpha
+	 *   of dst is set to 0 wherever brightness of mask is greater or equal to key.
+	 */
+	void maskAlphaByBrightness(const std::uint8_t *src, const std::uint8_t *mask, std::uint8_t *dst, std::size_t pixels, unsigned key);
+
+	/**
+	 * @brief Copies the pixels clearing alpha of those whose precomputed luminance reaches the key
+	 *
+	 * @param src The source pixels
+	 * @param luminance Brightness of every pixel, one byte per pixel (see computeLuminance)
+	 * @param dst The destination pixels, may be the same as src
+	 * @param pixels Amount of pixels to process
+	 * @param key The brightness threshold, values above 255 hide nothing
+	 *
+	 * Gives the same result as maskAlphaByBrightness on the buffer the luminance was
+	 *   computed from, but reads one byte of the mask per pixel instead of four.
+	 */
+	void maskAlphaByLuminance(const std::uint8_t *src, const std::uint8_t *luminance, std::uint8_t *dst, std::size_t pixels, unsigned key);
+
+	/**
+	 * @brief Writes scaled alpha of every pixel as a mask, one byte per pixel
+	 *
+	 * @param src The source pixels
+	 * @param mask The destination, one byte per pixel
+	 * @param pixels Amount of pixels to process
+	 * @param factor Factor of the alpha channel (see toFactor)
+	 *
+	 * Gives the alpha channel scaleChannels writes, without touching r, g and b.
+	 */
+	void scaleAlphaMask(const std::uint8_t *src, std::uint8_t *mask, std::size_t pixels, unsigned factor);
+
+	/**
+	 * @brief Writes alpha of every pixel as a mask, cleared where the luminance reaches the key
+	 *
+	 * @param src The source pixels
+	 * @param luminance Brightness of every pixel, one byte per pixel (see computeLuminance)
+	 * @param mask The destination, one byte per pixel
+	 * @param pixels Amount of pixels to process
+	 * @param key The brightness threshold, values above 255 hide nothing
+	 *
+	 * Gives the alpha channel maskAlphaByLuminance writes, without touching r, g and b.
+	 */
+	void luminanceAlphaMask(const std::uint8_t *src, const std::uint8_t *luminance, std::uint8_t *mask, std::size_t pixels, unsigned key);
+
+	/**
+	 * @brief Copies alpha of every pixel into a plane, one byte per pixel
+	 *
+	 * @param src The source pixels
+	 * @param alpha The destination, one byte per pixel
+	 * @param pixels Amount of pixels to process
+	 */
+	void extractAlpha(const std::uint8_t *src, std::uint8_t *alpha, std::size_t pixels);
+
+	/**
+	 * @brief Scales every byte of a plane
+	 *
+	 * @param src The source plane
+	 * @param dst The destination plane, may be the source
+	 * @param count Amount of bytes to process
+	 * @param factor The factor (see toFactor)
+	 *
+	 * Given the plane of extractAlpha, writes the same mask as scaleAlphaMask while
+	 *   reading a quarter of the bytes.
+	 */
+	void scaleBytes(const std::uint8_t *src, std::uint8_t *dst, std::size_t count, unsigned factor);
+
+	/**
+	 * @brief Copies a plane of alpha as a mask, cleared where the luminance reaches the key
+	 *
+	 * @param alpha Alpha of every pixel, one byte per pixel (see extractAlpha)
+	 * @param luminance Brightness of every pixel, one byte per pixel (see computeLuminance)
+	 * @param mask The destination, one byte per pixel
+	 * @param pixels Amount of pixels to process
+	 * @param key The brightness threshold, values above 255 hide nothing
+	 *
+	 * Given the plane of extractAlpha, writes the same mask as luminanceAlphaMask.
+	 */
+	void maskBytesByLuminance(const std::uint8_t *alpha, const std::uint8_t *luminance, std::uint8_t *mask, std::size_t pixels, unsigned key);
+
+	/**
+	 * @brief Copies the pixels clearing whole premultiplied pixels whose luminance reaches the key
+	 *
+	 * @param src The source pixels, premultiplied
+	 * @param luminance Brightness of every pixel, one byte per pixel (see computeLuminance)
+	 * @param dst The destination pixels, may be the same as src
+	 * @param pixels Amount of pixels to process
+	 * @param key The brightness threshold, values above 255 hide nothing
+	 *
+	 * Premultiplied counterpart of maskAlphaByLuminance, a hidden pixel has no color either.
+	 */
+	void clearByLuminance(const std::uint8_t *src, const std::uint8_t *luminance, std::uint8_t *dst, std::size_t pixels, unsigned key);
+
+	/**
+	 * @brief Multiplies r, g and b of every pixel by its alpha
+	 *
+	 * @param src The straight-alpha pixels
+	 * @param dst The destination pixels, may be the same as src
+	 * @param pixels Amount of pixels to process
+	 */
+	void premultiply(const std::uint8_t *src, std::uint8_t *dst, std::size_t pixels);
+
+	/**
+	 * @brief Divides r, g and b of every pixel by its alpha
+	 *
+	 * @param src The premultiplied pixels
+	 * @param dst The destination pixels, may be the same as src
+	 * @param pixels Amount of pixels to process
+	 *
+	 * Colors of fully transparent pixels are lost, they become black.
+	 */
+	void unpremultiply(const std::uint8_t *src, std::uint8_t *dst, std::size_t pixels);
+
+	/**
+	 * @brief Computes brightness (average of r, g and b) of every pixel
+	 *
+	 * @param src The pixels
+	 * @param luminance The destination, one byte per pixel
+	 * @param pixels Amount of pixels to process
+	 */
+	void computeLuminance(const std::uint8_t *src, std::uint8_t *luminance, std::size_t pixels);
+
+	/**
+	 * @brief Finds the darkest and the brightest pixel of the buffer
+	 *
+	 * @param src The pixels
+	 * @param pixels Amount of pixels to process
+	 * @param darkest Set to the brightness of the darkest pixel (255 if there are no pixels)
+	 * @param brightest Set to the brightness of the brightest pixel (0 if there are no pixels)
+	 */
+	void brightnessRange(const std::uint8_t *src, std::size_t pixels, std::uint8_t &darkest, std::uint8_t &brightest);
+
+	/**
+	 * @brief Compares two images channel by channel
+	 *
+	 * @param first Pixels of the first image
+	 * @param second Pixels of the second image, of the same size
+	 * @param pixels Amount of pixels to compare
+	 * @param tolerance Difference of a channel still counted as equal
+	 *
+	 * @return The biggest difference and the amount of pixels differing by more than the tolerance
+	 */
+	DiffStats diffImages(const std::uint8_t *first, const std::uint8_t *second, std::size_t pixels, unsigned tolerance);
+
+	/**
+	 * @brief Shrinks the pixels by averaging every block of source pixels covered by a destination pixel
+	 *
+	 * @param src The source pixels
+	 * @param src_size Size of the source in pixels
+	 * @param dst The destination pixels, dst_size.x * 4 bytes per row
+	 * @param dst_size Size of the destination, not bigger than src_size in either axis
+	 * @param first_row First row of the destination to compute
+	 * @param rows Amount of rows of the destination to compute
+	 *
+	 * Rows are independent of each other, so ranges of them may be computed in parallel.
+	 */
+	void downscale(const std::uint8_t *src, const sf::Vector2u &src_size, std::uint8_t *dst, const sf::Vector2u &dst_size, unsigned first_row, unsigned rows);
+}//namespace pk
@@ -0,0 +1,267 @@
+#pragma once
+
+#include "../root/System.h"
+
+#include <cstring>
+
+namespace pk
+{
+	/**
+	 * @brief IEEE 754 half precision channel, stored as its 16 bits
+	 *
+	 * C++17 has no half type, so values are converted to float for arithmetic,
+	 *   rounding to the nearest even half on the way back.
+	 */
+	struct Half
+	{
+		std::uint16_t bits = 0u;
+
+		Half() = default;
+		explicit Half(const float value) : bits(fromFloat(value)) { }
+
+		/**
+		 * @brief Converts the half to float, exactly
+		 *
+		 * @return The value
+		 */
+		explicit operator float() const
+		{
+			const std::uint32_t shifted_exponent = 0x7C00u << 13;
+			std::uint32_t bits32 = (bits & 0x7FFFu) << 13;
+			const std::uint32_t exponent = bits32 & shifted_exponent;
+			bits32 += (127u - 15u) << 23;
+			float value;
+			if(exponent == shifted_exponent)//infinity or NaN
+			{
+				bits32 += (128u - 16u) << 23;
+			}
+			else if(exponent == 0u)//subnormal, normalized by the FPU
+			{
+				bits32 += 1u << 23;
+				std::memcpy(&value, &bits32, sizeof(value));
+				value -= SUBNORMAL_MAGIC;
+				std::memcpy(&bits32, &value, sizeof(value));
+			}
+			bits32 |= static_cast<std::uint32_t>(bits & 0x8000u) << 16;
+			std::memcpy(&value, &bits32, sizeof(value));
+			return value;
+		}
+
+		bool operator==(const Half &right) const { return bits == right.bits; }
+		bool operator!=(const Half &right) const { return bits != right.bits; }
+
+	private:
+		static constexpr float SUBNORMAL_MAGIC = 6.103515625e-05f;///> 2^-14, the smallest normal half
+
+		static std::uint16_t fromFloat(const float value)
+		{
+			std::uint32_t bits32;
+			std::memcpy(&bits32, &value, sizeof(bits32));
+			const std::uint16_t sign = static_cast<std::uint16_t>((bits32 >> 16) & 0x8000u);
+			bits32 &= 0x7FFFFFFFu;
+			if(bits32 >= 0x47800000u)//too big for a half, infinity or NaN
+			{
+				return static_cast<std::uint16_t>(sign | (bits32 > 0x7F800000u ? 0x7E00u : 0x7C00u));
+			}
+			if(bits32 < 0x38800000u)//subnormal half, the FPU rounds the mantissa when adding 0.5
+			{
+				float magnitude;
+				std::memcpy(&magnitude, &bits32, sizeof(magnitude));
+				magnitude += 0.5f;
+				std::memcpy(&bits32, &magnitude, sizeof(bits32));
+				return static_cast<std::uint16_t>(sign | (bits32 - 0x3F000000u));
+			}
+			const std::uint32_t odd = (bits32 >> 13) & 1u;
+			bits32 += ((15u - 127u) << 23) + 0xFFFu + odd;//rebias and round to nearest even
+			return static_cast<std::uint16_t>(sign | (bits32 >> 13));
+		}
+	};
+
+	/**
+	 * @brief Range of the channel types pixels are stored in
+	 *
+	 * Integer channels span 0 to their biggest value, floating point ones 0 to 1,
+	 *   and may exceed 1 in high dynamic range images.
+	 */
+	template <typename Channel>
+	struct ChannelTraits;
+
+	template <>
+	struct ChannelTraits<std::uint8_t>
+	{
+		static constexpr float ONE = 255.f;///> Value of a fully lit channel
+		static float toFloat(const std::uint8_t value) { return value / ONE; }
+		static std::uint8_t fromFloat(const float value) { return static_cast<std::uint8_t>(std::clamp(value, 0.f, 1.f) * ONE + 0.5f); }
+	};
+
+	template <>
+	struct ChannelTraits<std::uint16_t>
+	{
+		static constexpr float ONE = 65535.f;///> Value of a fully lit channel
+		static float toFloat(const std::uint16_t value) { return value / ONE; }
+		static std::uint16_t fromFloat(const float value) { return static_cast<std::uint16_t>(std::clamp(value, 0.f, 1.f) * ONE + 0.5f); }
+	};
+
+	template <>
+	struct ChannelTraits<Half>
+	{
+		static constexpr float ONE = 1.f;///> Value of a fully lit channel
+		static float toFloat(const Half value) { return static_cast<float>(value); }
+		static Half fromFloat(const float value) { return Half(value); }
+	};
+
+	template <>
+	struct ChannelTraits<float>
+	{
+		static constexpr float ONE = 1.f;///> Value of a fully lit channel
+		static float toFloat(const float value) { return value; }
+		static float fromFloat(const float value) { return value; }
+	};
+
+	/**
+	 * @brief Typed view of interleaved RGBA pixels owned by someone else
+	 *
+	 * Rows follow each other stride channels apart, which is four times the width
+	 *   for pixels packed without padding. Views of const channels are read by
+	 *   the kernels, the others are written.
+	 */
+	template <typename Channel>
+	class PixelView
+	{
+	public:
+		/**
+		 * @brief Constructor of an empty view
+		 */
+		PixelView() = default;
+
+		/**
+		 * @brief Constructor of a view of pixels
+		 *
+		 * @param data First channel of the top-left pixel
+		 * @param size Size of the image in pixels
+		 * @param stride Channels from the start of one row to the next one, 0 for packed rows
+		 */
+		PixelView(Channel *data, const sf::Vector2u &size, const std::size_t stride = 0u)
+		:
+		m_data(data),
+		m_size(size),
+		m_stride(stride > 0u ? stride : static_cast<std::size_t>(size.x) * 4u)
+		{ }
+
+		/**
+		 * @brief Constructor of a view of packed pixels held by a vector
+		 *
+		 * @param pixels The pixels, holding at least the image
+		 * @param size Size of the image in pixels
+		 *
+		 * Throws std::invalid_argument if the vector is smaller than the image.
+		 */
+		template <typename Vector, typename = decltype(std::declval<Vector &>().data())>
+		PixelView(Vector &pixels, const sf::Vector2u &size)
+		:
+		PixelView(pixels.data(), size)
+		{
+			if(pixels.size() < this->getChannelCount())
+			{
+				throw std::invalid_argument("PixelView::PixelView(): the buffer holds fewer pixels than the image");
+			}
+		}
+
+		/**
+		 * @brief Conversion to a read-only view of the same pixels
+		 */
+		operator PixelView<const Channel>() const
+		{
+			return PixelView<const Channel>(m_data, m_size, m_stride);
+		}
+
+		/**
+		 * @brief Getter to a row of pixels
+		 *
+		 * @param y Row counted from the top
+		 *
+		 * @return First channel of the row
+		 */
+		Channel *row(const unsigned y) const { return m_data + y * m_stride; }
+
+		Channel *getData() const { return m_data; }
+		const sf::Vector2u &getSize() const { return m_size; }
+		std::size_t getStride() const { return m_stride; }
+
+		/**
+		 * @brief Getter to the amount of pixels of the image
+		 *
+		 * @return Width times height
+		 */
+		std::size_t getPixelCount() const { return static_cast<std::size_t>(m_size.x) * m_size.y; }
+
+		/**
+		 * @brief Getter to the amount of channels the image spans, padding included
+		 *
+		 * @return Channels from the first one to the end of the last row
+		 */
+		std::size_t getChannelCount() const { return m_size.y > 0u ? (m_size.y - 1u) * m_stride + m_size.x * 4u : 0u; }
+
+		/**
+		 * @brief Checks whether the rows follow each other without padding
+		 *
+		 * @return True if the whole image can be processed as one run of pixels
+		 */
+		bool isPacked() const { return m_stride == static_cast<std::size_t>(m_size.x) * 4u; }
+
+	private:
+		Channel *m_data = nullptr;///> First channel of the top-left pixel
+		sf::Vector2u m_size;///> Size of the image in pixels
+		std::size_t m_stride = 0u;///> Channels from the start of one row to the next one
+	};
+
+	/**
+	 * @brief Read-only view of the channel type of a writable one
+	 *
+	 * The channel is not deduced from it, so kernels take any view of the
+	 *   channel type their destination has, const or not.
+	 */
+	template <typename Channel>
+	using SourceView = PixelView<const typename std::enable_if<true, Channel>::type>;
+
+		using PixelView8 = PixelView<std::uint8_t>;///> The RGBA8 layout of textures and animations
+	using PixelView16 = PixelView<std::uint16_t>;///> 16-bit sources
+	using PixelViewHalf = PixelView<Half>;///> Half precision high dynamic range images
+	using PixelViewFloat = PixelView<float>;///> Single precision high dynamic range images
+
+	/**
+	 * @brief Converts pixels to another channel type
+	 *
+	 * @param src The source pixels, of any channel type
+	 * @param dst The destination pixels, of the same size
+	 *
+	 * Values are mapped through the range of the channel types, so a fully lit
+	 *   channel stays fully lit. Floating point values beyond 1 are clamped when
+	 *   converted to integers. Throws std::invalid_argument if the sizes differ.
+	 */
+	template <typename From, typename To>
+	void convertChannels(const PixelView<From> &src, const PixelView<To> &dst)
+	{
+		using Source = typename std::remove_const<From>::type;
+		if(src.getSize() != dst.getSize())
+		{
+			throw std::invalid_argument("pk::convertChannels(): the views have to be of the same size");
+		}
+		for(unsigned y = 0; y < src.getSize().y; y++)
+		{
+			const From *in = src.row(y);
+			To *out = dst.row(y);
+			for(std::size_t i = 0; i < static_cast<std::size_t>(src.getSize().x) * 4u; i++)
+			{
+				if constexpr(std::is_same<Source, To>::value)
+				{
+					out[i] = in[i];
+				}
+				else
+				{
+					out[i] = ChannelTraits<To>::fromFloat(ChannelTraits<Source>::toFloat(in[i]));
+				}
+			}
+		}
+	}
+}//namespace pk
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "../root/Std.h"
+
+/**
+ * @brief Clock turning real time between frames into time of the played animation
+ *
+ * Time of the animation is kept as an integer amount of steps plus the time left
+ *   over from the last step, so it never gathers floating point error and a given
+ *   sequence of frame deltas always reaches the same times. With the step set to
+ *   the time between frames of the timeline, the steps are exactly its frames.
+ *
+ * A frame taking long (a hitch) advances the animation by at most the given amount
+ *   of steps in the stepped modes, so the animation slows down instead of skipping.
+ */
+class PlaybackClock
+{
+public:
+	/**
+	 * @brief Ways real time is turned into time of the animation
+	 */
+	enum class Mode
+	{
+		REAL_TIME = 0,		///> Animation time follows real time, hitches skip animation time
+		FIXED_STEP = 1,		///> Animation time moves by whole steps, it is always at a frame
+		INTERPOLATED = 2	///> Steps as FIXED_STEP, time in between is interpolated for smooth playback
+	};
+
+	/**
+	 * @brief Default amount of steps one advance may move the animation by in the stepped modes
+	 */
+	static constexpr unsigned DEFAULT_MAX_STEPS = 4u;
+
+	/**
+	 * @brief Constructor setting the step and the mode
+	 *
+	 * @param step Length of a step in seconds, non-positive values are replaced by 1/60
+	 * @param mode The mode
+	 */
+	explicit PlaybackClock(const float &step = 1.f / 60.f, const Mode mode = Mode::INTERPOLATED);
+
+	/**
+	 * @brief Sets the way real time is turned into time of the animation
+	 *
+	 * @param mode The mode
+	 */
+	void setMode(const Mode mode);
+
+	/**
+	 * @brief Getter to the way real time is turned into time of the animation
+	 *
+	 * @return The mode
+	 */
+	Mode getMode() const;
+
+	/**
+	 * @brief Sets the length of a step, keeping the current time
+	 *
+	 * @param step Length of a step in seconds, non-positive values are ignored
+	 */
+	void setStep(const float &step);
+
+	/**
+	 * @brief Getter to the length of a step
+	 *
+	 * @return The length in seconds
+	 */
+	const float &getStep() const;
+
+	/**
+	 * @brief Sets the amount of steps one advance may move the animation by in the stepped modes
+	 *
+	 * @param steps The amount, at least 1
+	 */
+	void setMaxSteps(const unsigned steps);
+
+	/**
+	 * @brief Moves the clock to the time
+	 *
+	 * @param time Time of the animation in seconds, negative values are clamped to 0
+	 *
+	 * In FIXED_STEP mode the time is rounded down to a whole step.
+	 */
+	void reset(const float &time = 0.f);
+
+	/**
+	 * @brief Advances the animation by the real time which passed
+	 *
+	 * @param real_delta Real time since the last advance in seconds
+	 *
+	 * @return The new time of the animation
+	 */
+	float advance(const float &real_delta);
+
+	/**
+	 * @brief Getter to the time of the animation
+	 *
+	 * @return The time in seconds
+	 */
+	float getTime() const;
+
+	/**
+	 * @brief Getter to the index of the last whole step the animation reached
+	 *
+	 * @return The index, the frame of the timeline if the step is its time between frames
+	 */
+	unsigned getStepIndex() const;
+
+	/**
+	 * @brief Getter to the progress between the last reached step and the next one
+	 *
+	 * @return Value from 0 to 1, always 0 in FIXED_STEP mode
+	 */
+	float getAlpha() const;
+
+private:
+	Mode m_mode;///> Way real time is turned into time of the animation
+	float m_step;///> Length of a step in seconds
+	unsigned m_maxSteps;///> Amount of steps one advance may move by in the stepped modes
+	unsigned m_steps;///> Whole steps the animation reached
+	float m_remainder;///> Time since the last whole step, less than a step
+};
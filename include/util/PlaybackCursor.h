@@ -0,0 +1,186 @@
+#pragma once
+
+#include "PlaybackClock.h"
+#include "FrameGrid.h"
+
+/**
+ * @brief Position of playback within an animation, kept apart from the animation itself
+ *
+ * Animations compute their frames as const functions of their parameters and a time,
+ *   all that changes while a transition is played lives here: the time, the frame of
+ *   the grid it belongs to, the clock advancing it and whether it is played. Every view
+ *   of an animation, the timeline, the canvas or an export, keeps a cursor of its own,
+ *   so they share one animation without locking. Cursors are plain values and may be
+ *   copied to hand the state of playback to another thread.
+ */
+class PlaybackCursor
+{
+public:
+	/**
+	 * @brief Constructor of a paused cursor at the start of the animation
+	 *
+	 * @param length Length of the animation in seconds
+	 * @param frames Amount of frames spread over the animation
+	 */
+	explicit PlaybackCursor(const float &length = 0.f, const unsigned frames = 0u);
+
+	/**
+	 * @brief Starts playback
+	 */
+	void play();
+
+	/**
+	 * @brief Stops playback, keeping the time
+	 */
+	void pause();
+
+	/**
+	 * @brief Starts or stops playback
+	 *
+	 * @param playing Whether the animation is played
+	 */
+	void setPlaying(const bool playing);
+
+	/**
+	 * @brief Getter to the play status
+	 *
+	 * @return True if the animation is played
+	 */
+	bool isPlaying() const;
+
+	/**
+	 * @brief Marks the cursor as being dragged over the animation
+	 *
+	 * @param scrubbing Whether the time is being dragged
+	 *
+	 * Views may show frames of lower quality while the time is dragged, as long as
+	 *   they show the full ones once it stops.
+	 */
+	void setScrubbing(const bool scrubbing);
+
+	/**
+	 * @brief Getter to the scrub status
+	 *
+	 * @return True while the time is being dragged
+	 */
+	bool isScrubbing() const;
+
+	/**
+	 * @brief Sets the length of the animation, keeping the amount of frames and the time
+	 *
+	 * @param seconds Length in seconds, non-positive values are ignored
+	 */
+	void setLength(const float &seconds);
+
+	/**
+	 * @brief Getter to the length of the animation
+	 *
+	 * @return The length in seconds
+	 */
+	const float &getLength() const;
+
+	/**
+	 * @brief Sets the amount of frames spread over the animation
+	 *
+	 * @param frames The amount
+	 */
+	void setFrames(const unsigned frames);
+
+	/**
+	 * @brief Sets the frames, along with the length of the animation they are spread over
+	 *
+	 * @param grid The frames
+	 */
+	void setGrid(const FrameGrid &grid);
+
+	/**
+	 * @brief Getter to the frames of the animation
+	 *
+	 * @return The grid of frames
+	 */
+	const FrameGrid &getGrid() const;
+
+	/**
+	 * @brief Moves the cursor to the time
+	 *
+	 * @param time Time in seconds, negative values are ignored and the ones past the end
+	 *   are moved onto the last frame
+	 */
+	void setTime(const float &time);
+
+	/**
+	 * @brief Getter to the time of the cursor
+	 *
+	 * @return The time in seconds
+	 */
+	const float &getTime() const;
+
+	/**
+	 * @brief Getter to the progress of the cursor
+	 *
+	 * @return Time relative to the length, from 0 to 1
+	 */
+	float getProgress() const;
+
+	/**
+	 * @brief Moves the cursor to the frame
+	 *
+	 * @param frame Index of the frame, indices after the last frame give the last one
+	 */
+	void seekFrame(const unsigned frame);
+
+	/**
+	 * @brief Moves the cursor to the next frame
+	 */
+	void nextFrame();
+
+	/**
+	 * @brief Moves the cursor to the previous frame, from between two frames to the earlier one
+	 */
+	void previousFrame();
+
+	/**
+	 * @brief Getter to the current frame
+	 *
+	 * @return Index of the last frame at or before the time
+	 */
+	unsigned getFrame() const;
+
+	/**
+	 * @brief Checks whether the cursor reached the end of the animation
+	 *
+	 * @return True if it is at the end
+	 */
+	bool isFinished() const;
+
+	/**
+	 * @brief Advances a played cursor by the real time which passed
+	 *
+	 * @param real_delta Real time since the last advance in seconds
+	 *
+	 * The clock turns the real time into time of the animation, which stops before
+	 *   its end. A finished cursor is paused instead.
+	 */
+	void advance(const float &real_delta);
+
+	/**
+	 * @brief Getter to the clock advancing the played animation
+	 *
+	 * @return The clock, whose mode may be changed
+	 *
+	 * Its step is kept equal to the time between frames, so in the stepped modes
+	 *   playback goes through exactly the frames nextFrame jumps to.
+	 */
+	PlaybackClock &getClock();
+
+private:
+	void gridChanged();///> Fits the clock and the frame to a new grid
+
+	bool m_playing;///> Whether the animation is played
+	bool m_scrubbing;///> Whether the time is being dragged
+	float m_length;///> Length of the animation in seconds
+	float m_time;///> Time of the cursor in seconds
+	FrameGrid m_grid;///> Frames of the animation
+	unsigned m_frame;///> Last frame at or before the time
+	PlaybackClock m_clock;///> Clock advancing the played animation
+};
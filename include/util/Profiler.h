@@ -0,0 +1,170 @@
+#pragma once
+
+#include "../root/Std.h"
+
+#include <chrono>
+#include <deque>
+#include <map>
+
+/**
+ * @brief Collects durations of named sections of the frame from any thread
+ *
+ * Sections are timed by ProfileScope, which costs a single check of an atomic
+ *   flag while the profiler is disabled. Enabled, every section is kept as an
+ *   event in a ring buffer, from which a Chrome trace (chrome://tracing, Perfetto)
+ *   can be written, and summed per frame for the overlay.
+ *
+ * The profiler is enabled from the start if the BCG_PROFILE environment variable is set.
+ */
+class Profiler
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	static const std::size_t DEFAULT_EVENT_CAPACITY = 65536u;///> Events kept for the trace, older ones are overwritten
+	static const std::size_t FRAME_HISTORY = 240u;///> Frames kept for the frame time graph
+
+	/**
+	 * @brief Time spent in a section
+	 */
+	struct Section
+	{
+		const char *name;		///> Name of the section
+		float lastMs = 0.f;		///> Time spent in the section during the last frame in milliseconds
+		float averageMs = 0.f;	///> Moving average of the time per frame in milliseconds
+	};
+
+	/**
+	 * @brief Constructor of a disabled profiler
+	 *
+	 * @param capacity Amount of events kept for the trace
+	 */
+	explicit Profiler(const std::size_t capacity = DEFAULT_EVENT_CAPACITY);
+
+	Profiler(const Profiler &) = delete;
+	Profiler &operator=(const Profiler &) = delete;
+
+	/**
+	 * @brief Getter to the profiler shared by the whole application
+	 *
+	 * @return The profiler
+	 */
+	static Profiler &shared();
+
+	/**
+	 * @brief Enables or disables collecting of sections
+	 *
+	 * @param enabled Whether the sections are collected
+	 */
+	void setEnabled(const bool enabled);
+
+	/**
+	 * @brief Checks whether sections are collected
+	 *
+	 * @return True if enabled
+	 */
+	bool isEnabled() const;
+
+	/**
+	 * @brief Records a finished section, meant to be called by ProfileScope
+	 *
+	 * @param name Name of the section, it has to outlive the profiler (a literal)
+	 * @param begin Start of the section
+	 * @param end End of the section
+	 */
+	void record(const char *name, const Clock::time_point &begin, const Clock::time_point &end);
+
+	/**
+	 * @brief Ends the frame, called once per frame presented to the window
+	 *
+	 * Sums the sections recorded since the previous call and stores the frame time.
+	 */
+	void endFrame();
+
+	/**
+	 * @brief Getter to the sections in order of their first appearance
+	 *
+	 * @return Copy of the sections
+	 */
+	std::vector<Section> getSections() const;
+
+	/**
+	 * @brief Getter to the times between ended frames
+	 *
+	 * @return Frame times in milliseconds, oldest first
+	 */
+	std::vector<float> getFrameTimes() const;
+
+	/**
+	 * @brief Writes the collected events as a Chrome trace
+	 *
+	 * @param path Path to the JSON file
+	 */
+	void writeTrace(const std::string &path) const;
+
+private:
+	struct Event
+	{
+		const char *name;
+		Clock::time_point begin;
+		Clock::time_point end;
+		unsigned thread;
+	};
+
+	unsigned threadIndex(const std::thread::id &id);///> Small number of a thread in the trace, the lock has to be held
+
+	std::atomic<bool> m_enabled;///> Whether sections are collected
+	mutable std::mutex m_mutex;///> Guards everything below
+	std::vector<Event> m_events;///> Ring buffer of the events
+	std::size_t m_nextEvent;///> Slot the next event is written to
+	bool m_eventsWrapped;///> Whether the ring buffer was filled at least once
+	std::vector<Section> m_sections;///> Sections by their first appearance
+	std::vector<float> m_frameSums;///> Time of every section during the current frame, by index of the section
+	std::deque<float> m_frameTimes;///> Times between ended frames
+	Clock::time_point m_frameStart;///> End of the previous frame
+	Clock::time_point m_epoch;///> Time the trace is counted from
+	std::map<std::thread::id, unsigned> m_threads;///> Numbers of threads which recorded events
+};
+
+/**
+ * @brief Times the scope it lives in as a section of the shared profiler
+ */
+class ProfileScope
+{
+public:
+	/**
+	 * @brief Constructor starting the section
+	 *
+	 * @param name Name of the section, a literal
+	 */
+	explicit ProfileScope(const char *name)
+	:
+	m_name(Profiler::shared().isEnabled() ? name : nullptr),
+	m_begin(m_name ? Profiler::Clock::now() : Profiler::Clock::time_point())
+	{ }
+
+	ProfileScope(const ProfileScope &) = delete;
+	ProfileScope &operator=(const ProfileScope &) = delete;
+
+	/**
+	 * @brief Destructor recording the section
+	 */
+	~ProfileScope()
+	{
+		if(m_name)
+		{
+			Profiler::shared().record(m_name, m_begin, Profiler::Clock::now());
+		}
+	}
+
+private:
+	const char *m_name;///> Name of the section, nullptr if the profiler was disabled at its start
+	Profiler::Clock::time_point m_begin;///> Start of the section
+};
+
+#define BCG_PROFILE_CONCAT_IMPL(a, b) a##b
+#define BCG_PROFILE_CONCAT(a, b) BCG_PROFILE_CONCAT_IMPL(a, b)
+/**
+ * @brief Times the rest of the enclosing scope as a section of the given name
+ */
+#define BCG_PROFILE_SCOPE(name) ProfileScope BCG_PROFILE_CONCAT(profile_scope_, __LINE__)(name)
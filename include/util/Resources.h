@@ -0,0 +1,70 @@
+#pragma once
+
+#include "../root/Std.h"
+
+/**
+ * @brief File compiled into the executable
+ */
+struct Resource
+{
+	const char *name;			///> Path of the file relative to the res directory, e.g. "images/save_icon.png"
+	const unsigned char *data;	///> Contents of the file
+	std::size_t size;			///> Size of the contents in bytes
+};
+
+/**
+ * @brief Files of the res directory compiled into the executable
+ *
+ * The table is generated at build time by cmake/EmbedResources.cmake, so the
+ *   application finds its icons, fonts and example images wherever it is started
+ *   from and never probes the filesystem for them. Resources are decoded only when
+ *   they are first used, by whoever uses them.
+ *
+ * Anywhere a path to an image is expected, a resource may be given by its name
+ *   prefixed with PREFIX, e.g. "res:images/example1.jpg".
+ */
+class Resources
+{
+public:
+	static constexpr const char *PREFIX = "res:";///> Prefix of paths naming resources
+
+	/**
+	 * @brief Finds a resource by its name
+	 *
+	 * @param name Path of the file relative to the res directory
+	 *
+	 * @return The resource, nullptr if there is no such resource
+	 */
+	static const Resource *find(const std::string &name);
+
+	/**
+	 * @brief Finds a resource by its path
+	 *
+	 * @param path Name of the resource prefixed with PREFIX
+	 *
+	 * @return The resource, nullptr if the path does not name a resource or there is no such resource
+	 */
+	static const Resource *findPath(const std::string &path);
+
+	/**
+	 * @brief Checks whether a path names a resource
+	 *
+	 * @param path The path
+	 *
+	 * @return True if the path starts with PREFIX
+	 */
+	static bool isResourcePath(const std::string &path);
+
+	/**
+	 * @brief Makes the path naming a resource
+	 *
+	 * @param name Path of the file relative to the res directory
+	 *
+	 * @return The path, name prefixed with PREFIX
+	 */
+	static std::string pathOf(const std::string &name);
+
+private:
+	static const Resource ENTRIES[];///> All resources, followed by an empty one, defined by the generated source
+	static const std::size_t ENTRY_COUNT;///> Amount of the resources
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "../root/Std.h"
+
+#include <deque>
+
+/**
+ * @brief Small pool of worker threads splitting loops into chunks
+ *
+ * Loops are split into chunks of fixed size which do not depend on the amount
+ *   of threads nor on their timing. As long as every chunk writes only its own
+ *   elements, the result is the same as of the sequential loop, bit by bit.
+ *
+ * The calling thread takes part in the work too, so a pool with 1 thread runs
+ *   everything sequentially on the caller. Loops started from inside of
+ *   a worker are run sequentially on that worker, which makes nesting safe.
+ */
+class ThreadPool
+{
+public:
+	/**
+	 * @brief Constructor starting the workers
+	 *
+	 * @param threads Amount of threads taking part in loops (including the caller), 0 picks the amount of cores
+	 */
+	explicit ThreadPool(const unsigned threads = 0u);
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+	/**
+	 * @brief Destructor stopping the workers
+	 */
+	~ThreadPool();
+
+	/**
+	 * @brief Pool shared by the whole application
+	 *
+	 * @return The shared pool
+	 *
+	 * Its amount of threads is taken from the BCG_THREADS environment variable
+	 *   if it is set, otherwise from the amount of cores.
+	 */
+	static ThreadPool &shared();
+
+	/**
+	 * @brief Changes the amount of threads taking part in loops
+	 *
+	 * @param threads The amount of threads (including the caller), 0 picks the amount of cores
+	 *
+	 * Must not be called while any loop is running.
+	 */
+	void setThreadCount(const unsigned threads);
+
+	/**
+	 * @brief Getter to the amount of threads taking part in loops
+	 *
+	 * @return The amount of threads including the caller
+	 */
+	unsigned getThreadCount() const;
+
+	/**
+	 * @brief Runs the body over [0, count) split into chunks
+	 *
+	 * @param count Amount of elements
+	 * @param grain Amount of elements in a chunk (the last one may be smaller)
+	 * @param body Function called with [begin, end) of every chunk
+	 *
+	 * Returns once every chunk is done. If any chunk throws, the first exception
+	 *   is rethrown after the remaining chunks finish.
+	 */
+	void parallelFor(const std::size_t count, const std::size_t grain, const std::function<void(std::size_t, std::size_t)> &body);
+
+private:
+	struct Loop;
+
+	void start(const unsigned threads);///> Starts threads - 1 workers
+	void stop();///> Joins all workers
+	void work();///> Loop of a worker
+	static void runChunks(Loop &loop);///> Takes chunks of the loop until none is left
+
+	std::vector<std::thread> m_workers;///> Worker threads
+	std::deque<std::shared_ptr<Loop>> m_loops;///> Loops the workers may help with
+	std::mutex m_mutex;///> Guards the loops and the stopping flag
+	std::condition_variable m_wake;///> Wakes workers up when a loop is added or pool stops
+	bool m_stopping;///> Flag telling the workers to quit
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "../root/Std.h"
+
+/**
+ * @brief Three slots handing values from one producing thread to one consuming thread
+ *
+ * The producer always writes to a slot the consumer does not see and publishes it
+ *   when it is complete, the consumer takes the most recently published slot.
+ *   Neither of them ever waits for the other, a slow consumer only misses values.
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+	/**
+	 * @brief Default constructor with default constructed slots and nothing published
+	 */
+	TripleBuffer()
+	:
+	m_slots(),
+	m_back(0u),
+	m_ready(1u),
+	m_front(2u)
+	{ }
+
+	TripleBuffer(const TripleBuffer &) = delete;
+	TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+	/**
+	 * @brief Getter to the slot the producer writes to
+	 *
+	 * @return The slot, only the producer may touch it
+	 */
+	T &back()
+	{
+		return m_slots[m_back];
+	}
+
+	/**
+	 * @brief Publishes the slot written by the producer, it gets another slot to write to
+	 */
+	void publish()
+	{
+		m_back = m_ready.exchange(m_back | NEW_VALUE) & INDEX;
+	}
+
+	/**
+	 * @brief Checks whether a value was published since the consumer last took one
+	 *
+	 * @return True if acquire would give a new value
+	 */
+	bool hasNew() const
+	{
+		return (m_ready.load() & NEW_VALUE) != 0u;
+	}
+
+	/**
+	 * @brief Takes the most recently published value for the consumer
+	 *
+	 * @return True if a new value was taken, false if front stays the same
+	 */
+	bool acquire()
+	{
+		if(!this->hasNew())
+		{
+			return false;
+		}
+		m_front = m_ready.exchange(m_front) & INDEX;
+		return true;
+	}
+
+	/**
+	 * @brief Getter to the slot the consumer reads
+	 *
+	 * @return The slot taken by the last acquire, only the consumer may touch it
+	 */
+	T &front()
+	{
+		return m_slots[m_front];
+	}
+
+private:
+	static constexpr unsigned INDEX = 3u;///> Bits of the index of a slot
+	static constexpr unsigned NEW_VALUE = 4u;///> Bit set while the ready slot was not taken by the consumer
+
+	std::array<T, 3> m_slots;///> The slots
+	unsigned m_back;///> Slot of the producer
+	std::atomic<unsigned> m_ready;///> Slot published last, with the NEW_VALUE bit
+	unsigned m_front;///> Slot of the consumer
+};
@@ -1,8 +1,45 @@
 #include "include/program/Program.h"
 
-int main()
+#include <iostream>
+
+int main(int argc, char **argv)
 {
-    Program app;
+    //one argument is a project, a deck file or an exported sequence, more of them are the slides in order
+    SlideDeck deck;
+    std::shared_ptr<const RawSequence> sequence;
+    Project project;
+    try
+    {
+        //plugins come first, decks may name their animations
+        AnimationPlugins::shared().discover(AnimationPlugins::DEFAULT_DIRECTORY);
+        if(argc == 2 && RawSequence::isSequencePath(argv[1]))
+        {
+            sequence = std::make_shared<const RawSequence>(argv[1]);
+        }
+        else if(argc == 2 && Project::isProjectPath(argv[1]))
+        {
+            project = Project::load(argv[1]);
+            deck = project.createDeck();
+        }
+        else if(argc == 2)
+        {
+            deck = SlideDeck::fromFile(argv[1]);
+        }
+        else
+        {
+            for(int i = 1; i < argc; i++)
+            {
+                deck.addSlide(argv[i]);
+            }
+        }
+    }
+    catch(const std::exception &error)
+    {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    Program app(std::move(deck), std::move(sequence), std::move(project));
     app.run();
     return 0;
 }
\ No newline at end of file
@@ -14,8 +14,8 @@ AlfaAnimation::AlfaAnimation(
 	std::vector<unsigned char> texture1_pixels, 
 	std::vector<unsigned char> texture2_pixels)
 :
-PixelAnimation(animation_length, animation_speed, texture1_pixels, texture2_pixels)
-{
+PixelAnimation(animation_length, animation_speed, std::move(texture1_pixels), std::move(texture2_pixels))
+{	this->plan();
 }
 
 AlfaAnimation::AlfaAnimation(
@@ -25,7 +25,17 @@ AlfaAnimation::AlfaAnimation(
 	const sf::Texture &texture2)
 :
 PixelAnimation(animation_length, animation_speed, texture1, texture2)
-{
+{	this->plan();
+}
+
+AlfaAnimation::AlfaAnimation(
+	const float &animation_length,
+	const float &animation_speed,
+	const sf::Image &image1,
+	const sf::Image &image2)
+:
+PixelAnimation(animation_length, animation_speed, image1, image2)
+{	this->plan();
 }
 
 AlfaAnimation::~AlfaAnimation()
@@ -34,3 +44,104 @@ AlfaAnimation::~AlfaAnimation()
 	m_pixels2.clear();
 }
 
+std::size_t AlfaAnimation::getPlanBytes() const
+{
+	return m_alpha1.capacity() + m_alpha2.capacity();
+}
+
+const std::string &AlfaAnimation::getShaderSource() const
+{
+	static const std::string source = R"(
+uniform sampler2D source;
+uniform float progress;
+uniform int layer;
+
+void main()
+{
+	vec4 pixel = texture2D(source, gl_TexCoord[0].xy);
+	pixel.a *= (layer == 1) ? 1.0 - progress : progress;
+	gl_FragColor = gl_Color * pixel;
+}
+)";
+	return source;
+}
+
+PixelSpan AlfaAnimation::changedPixels1(const float &from_time, const float &to_time) const
+{
+	return this->factors1(from_time) == this->factors1(to_time) ? PixelSpan() : PixelSpan{0u, m_pixels1.size() / 4u};
+}
+
+PixelSpan AlfaAnimation::changedPixels2(const float &from_time, const float &to_time) const
+{
+	return this->factors2(from_time) == this->factors2(to_time) ? PixelSpan() : PixelSpan{0u, m_pixels2.size() / 4u};
+}
+
+bool AlfaAnimation::hasAlphaMasks() const
+{
+	return true;
+}
+
+void AlfaAnimation::writeAlpha1Mask(const float &current_time, std::vector<unsigned char> &output) const
+{
+	AlfaAnimation::writeMask(m_alpha1, this->factors1(current_time).a, output);
+}
+
+void AlfaAnimation::writeAlpha2Mask(const float &current_time, std::vector<unsigned char> &output) const
+{
+	AlfaAnimation::writeMask(m_alpha2, this->factors2(current_time).a, output);
+}
+
+PixelOperation AlfaAnimation::frameOperation1(const float &current_time) const
+{
+	const pk::ChannelFactors factors = this->factors1(current_time);
+	return [factors](const std::uint8_t *src, std::uint8_t *dst, std::size_t, std::size_t pixels)
+	{
+		pk::scaleChannels(src, dst, pixels, factors);
+	};
+}
+
+PixelOperation AlfaAnimation::frameOperation2(const float &current_time) const
+{
+	const pk::ChannelFactors factors = this->factors2(current_time);
+	return [factors](const std::uint8_t *src, std::uint8_t *dst, std::size_t, std::size_t pixels)
+	{
+		pk::scaleChannels(src, dst, pixels, factors);
+	};
+}
+
+//protected member functions
+void AlfaAnimation::pixelsChanged(const unsigned changed)
+{
+	if(changed & PixelAnimation::PIXELS1)
+	{
+		m_alpha1.resize(m_pixels1.size() / 4u);
+		pk::extractAlpha(m_pixels1.data(), m_alpha1.data(), m_alpha1.size());
+	}
+	if(changed & PixelAnimation::PIXELS2)
+	{
+		m_alpha2.resize(m_pixels2.size() / 4u);
+		pk::extractAlpha(m_pixels2.data(), m_alpha2.data(), m_alpha2.size());
+	}
+}
+
+//private member functions
+void AlfaAnimation::writeMask(const std::vector<std::uint8_t> &alpha, const unsigned factor, std::vector<unsigned char> &output)
+{
+	output.resize(alpha.size());
+	const std::uint8_t *src = alpha.data();
+	std::uint8_t *dst = output.data();
+	forEachPixelRange(alpha.size(), [src, dst, factor](std::size_t begin, std::size_t end)
+	{
+		pk::scaleBytes(src + begin, dst + begin, end - begin, factor);
+	});
+}
+
+pk::ChannelFactors AlfaAnimation::factors1(const float &current_time) const
+{
+	return this->frameFactors({256u, 256u, 256u, pk::toFactor(1.f - this->toProgress(current_time))});
+}
+
+pk::ChannelFactors AlfaAnimation::factors2(const float &current_time) const
+{
+	return this->frameFactors({256u, 256u, 256u, pk::toFactor(this->toProgress(current_time))});
+}
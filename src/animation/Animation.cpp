@@ -1,5 +1,7 @@
 #include "../../include/animation/Animation.h"
 
+#include <typeinfo>
+
 Animation::Animation()
 :
 Animation(0.f, 0.f)
@@ -8,9 +10,11 @@ Animation(0.f, 0.f)
 Animation::Animation(const float &animation_length, const float &animation_speed)
 :
 m_totalTime(animation_length),
-m_currentTime(0.f),
-m_speedFactor(animation_speed)
-{ }
+m_speedFactor(animation_speed),
+m_easing()
+{
+	m_easing.resample(SampledCurve::samplesFor(animation_length));
+}
 
 const float &Animation::getAnimationLength() const
 {
@@ -31,6 +35,7 @@ void Animation::setAnimationLength(const float &seconds)
 	else
 	{
 		m_totalTime = seconds;
+		m_easing.resample(SampledCurve::samplesFor(seconds));
 	}
 }
 
@@ -45,3 +50,24 @@ void Animation::setAnimationSpeed(const float &speed_factor)
 		m_speedFactor = speed_factor;
 	}
 }
+
+void Animation::setEasing(const SampledCurve &easing)
+{
+	m_easing = easing;
+	m_easing.resample(SampledCurve::samplesFor(m_totalTime));
+}
+
+const SampledCurve &Animation::getEasing() const
+{
+	return m_easing;
+}
+
+float Animation::progressAt(const float &current_time) const
+{
+	return this->toProgress(current_time);
+}
+
+std::uint64_t Animation::getParameterHash() const
+{
+	return ContentHash().add(std::string(typeid(*this).name())).add(m_totalTime).add(m_speedFactor).add(m_easing.getHash()).getValue();
+}
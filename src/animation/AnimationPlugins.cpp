@@ -0,0 +1,245 @@
+#include "../../include/animation/AnimationPlugins.h"
+#include "../../include/animation/AnimationRegistry.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#if defined(_WIN32)
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <dlfcn.h>
+#endif
+
+namespace
+{
+	const char *ENTRY_POINT = "bcgAnimationPlugin";//function every plugin exports
+
+	std::string trim(const std::string &text)
+	{
+		const std::size_t begin = text.find_first_not_of(" \t\r");
+		if(begin == std::string::npos)
+		{
+			return std::string();
+		}
+		return text.substr(begin, text.find_last_not_of(" \t\r") - begin + 1u);
+	}
+
+	void *openLibrary(const std::string &path)
+	{
+	#if defined(_WIN32)
+		return reinterpret_cast<void *>(LoadLibraryA(path.c_str()));
+	#else
+		return dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+	#endif
+	}
+
+	void *findSymbol(void *library, const char *name)
+	{
+	#if defined(_WIN32)
+		return reinterpret_cast<void *>(GetProcAddress(reinterpret_cast<HMODULE>(library), name));
+	#else
+		return dlsym(library, name);
+	#endif
+	}
+
+	std::string libraryError()
+	{
+	#if defined(_WIN32)
+		return "error " + std::to_string(GetLastError());
+	#else
+		const char *error = dlerror();
+		return error ? error : "unknown error";
+	#endif
+	}
+}//anonymous namespace
+
+AnimationPlugins &AnimationPlugins::shared()
+{
+	static AnimationPlugins plugins;
+	return plugins;
+}
+
+std::size_t AnimationPlugins::discover(const std::string &directory)
+{
+	std::error_code error;
+	if(!std::filesystem::is_directory(directory, error))
+	{
+		return 0u;
+	}
+	//sorted, so the plugins keep their places in the animation list from run to run
+	std::vector<std::filesystem::path> manifests;
+	for(const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator(directory, error))
+	{
+		if(entry.is_regular_file(error) && entry.path().extension() == AnimationPlugins::MANIFEST_EXTENSION)
+		{
+			manifests.push_back(entry.path());
+		}
+	}
+	std::sort(manifests.begin(), manifests.end());
+
+	std::size_t registered = 0u;
+	for(const std::filesystem::path &manifest : manifests)
+	{
+		try
+		{
+			registered += this->add(manifest.string()) ? 1u : 0u;
+		}
+		catch(const std::runtime_error &failure)
+		{
+			std::cerr << failure.what() << std::endl;
+		}
+	}
+	return registered;
+}
+
+bool AnimationPlugins::add(const std::string &manifest)
+{
+	std::ifstream file(manifest);
+	if(!file)
+	{
+		throw std::runtime_error("AnimationPlugins::add(): cannot open " + manifest);
+	}
+	Plugin plugin;
+	std::string requirements;
+	std::string line;
+	while(std::getline(file, line))
+	{
+		const std::size_t separator = line.find('=');
+		if(trim(line).empty() || trim(line)[0] == '#' || separator == std::string::npos)
+		{
+			continue;
+		}
+		const std::string key = trim(line.substr(0u, separator));
+		const std::string value = trim(line.substr(separator + 1u));
+		if(key == "name")
+		{
+			plugin.name = value;
+		}
+		else if(key == "label")
+		{
+			plugin.label = value;
+		}
+		else if(key == "library")
+		{
+			plugin.library = (std::filesystem::path(manifest).parent_path() / value).string();
+		}
+		else if(key == "requires")
+		{
+			requirements = value;
+		}
+	}
+	if(plugin.name.empty() || plugin.library.empty())
+	{
+		throw std::runtime_error("AnimationPlugins::add(): " + manifest + " has to name the animation and its library");
+	}
+	if(findAnimation(plugin.name) != animationCount())
+	{
+		throw std::runtime_error("AnimationPlugins::add(): there already is an animation " + plugin.name + ", " + manifest + " is skipped");
+	}
+	std::istringstream capabilities(requirements);
+	std::string capability;
+	while(capabilities >> capability)
+	{
+		if(!AnimationPlugins::isCapable(capability))
+		{
+			return false;
+		}
+	}
+	if(plugin.label.empty())
+	{
+		plugin.label = plugin.name;
+	}
+	m_plugins.push_back(std::move(plugin));
+	return true;
+}
+
+std::size_t AnimationPlugins::getCount() const
+{
+	return m_plugins.size();
+}
+
+const char *AnimationPlugins::getName(const std::size_t index) const
+{
+	return m_plugins.at(index).name.c_str();
+}
+
+const char *AnimationPlugins::getLabel(const std::size_t index) const
+{
+	return m_plugins.at(index).label.c_str();
+}
+
+AnimationPointer AnimationPlugins::create(const std::size_t index)
+{
+	if(index >= m_plugins.size())
+	{
+		throw std::out_of_range("AnimationPlugins::create(): there is no plugin of index " + std::to_string(index));
+	}
+	Plugin &plugin = m_plugins[index];
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if(!plugin.entry)
+		{
+			this->open(plugin);
+		}
+	}
+	if(plugin.entry->createPixel)
+	{
+		return std::unique_ptr<PixelAnimation>(plugin.entry->createPixel());
+	}
+	return std::unique_ptr<ObjectAnimation>(plugin.entry->createObject());
+}
+
+bool AnimationPlugins::isCapable(const std::string &capability)
+{
+	if(capability == "sse2")
+	{
+		return pk::isSupported(pk::Isa::SSE2);
+	}
+	if(capability == "avx2")
+	{
+		return pk::isSupported(pk::Isa::AVX2);
+	}
+	if(capability == "neon")
+	{
+		return pk::isSupported(pk::Isa::NEON);
+	}
+	if(capability == "shaders")
+	{
+		return sf::Shader::isAvailable();
+	}
+	return false;
+}
+
+//private member functions
+void AnimationPlugins::open(Plugin &plugin)
+{
+	if(!plugin.handle)
+	{
+		plugin.handle = openLibrary(plugin.library);
+		if(!plugin.handle)
+		{
+			throw std::runtime_error("AnimationPlugins::open(): cannot open " + plugin.library + ": " + libraryError());
+		}
+	}
+	using EntryPoint = const AnimationPluginEntry *(*)();
+	const EntryPoint entry_point = reinterpret_cast<EntryPoint>(findSymbol(plugin.handle, ENTRY_POINT));
+	const AnimationPluginEntry *entry = entry_point ? entry_point() : nullptr;
+	if(!entry)
+	{
+		throw std::runtime_error("AnimationPlugins::open(): " + plugin.library + " exports no " + ENTRY_POINT);
+	}
+	if(entry->abi != BCG_PLUGIN_ABI)
+	{
+		throw std::runtime_error("AnimationPlugins::open(): " + plugin.library + " was built for another version of the application");
+	}
+	if(!entry->name || plugin.name != entry->name || !entry->createObject == !entry->createPixel)
+	{
+		throw std::runtime_error("AnimationPlugins::open(): " + plugin.library + " does not hold the animation " + plugin.name);
+	}
+	plugin.entry = entry;
+}
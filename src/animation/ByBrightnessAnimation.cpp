@@ -3,9 +3,15 @@
 
 ByBrightnessAnimation::ByBrightnessAnimation()
 :
-PixelAnimation()
+PixelAnimation(),
+m_firstOfLevel(),
+m_endOfLevel(),
+m_darkest(255),
+m_brightest(0)
 {
-
+	m_firstOfLevel.fill(0u);
+	m_endOfLevel.fill(0u);
+	m_levelBegin.fill(0u);
 }
 	
 ByBrightnessAnimation::ByBrightnessAnimation(
@@ -14,8 +20,9 @@ ByBrightnessAnimation::ByBrightnessAnimation(
 	std::vector<unsigned char> texture1_pixels, 
 	std::vector<unsigned char> texture2_pixels)
 :
-PixelAnimation(animation_length, animation_speed, texture1_pixels, texture2_pixels)
+PixelAnimation(animation_length, animation_speed, std::move(texture1_pixels), std::move(texture2_pixels))
 {
+	this->plan();
 }
 
 ByBrightnessAnimation::ByBrightnessAnimation(
@@ -26,6 +33,18 @@ ByBrightnessAnimation::ByBrightnessAnimation(
 :
 PixelAnimation(animation_length, animation_speed, texture1, texture2)
 {
+	this->plan();
+}
+
+ByBrightnessAnimation::ByBrightnessAnimation(
+	const float &animation_length,
+	const float &animation_speed,
+	const sf::Image &image1,
+	const sf::Image &image2)
+:
+PixelAnimation(animation_length, animation_speed, image1, image2)
+{
+	this->plan();
 }
 
 ByBrightnessAnimation::~ByBrightnessAnimation()
@@ -34,3 +53,289 @@ ByBrightnessAnimation::~ByBrightnessAnimation()
 	m_pixels2.clear();
 }
 
+const std::string &ByBrightnessAnimation::getShaderSource() const
+{
+	static const std::string source = R"(
+uniform sampler2D source;
+uniform sampler2D other;
+uniform float progress;
+uniform int layer;
+uniform float darkest;
+uniform float brightest;
+
+void main()
+{
+	vec4 pixel = texture2D(source, gl_TexCoord[0].xy);
+	if(layer == 1)
+	{
+		vec3 mask = texture2D(other, gl_TexCoord[0].xy).rgb * 255.0;
+		float key = floor((1.0 - progress) * (brightest - darkest + 1.0) + darkest);
+		if(mask.r + mask.g + mask.b + 0.5 >= key * 3.0)
+			pixel.a = 0.0;
+	}
+	gl_FragColor = gl_Color * pixel;
+}
+)";
+	return source;
+}
+
+void ByBrightnessAnimation::setShaderParameters(sf::Shader &shader, const float &current_time) const
+{
+	PixelAnimation::setShaderParameters(shader, current_time);
+	shader.setUniform("darkest", static_cast<float>(m_darkest));
+	shader.setUniform("brightest", static_cast<float>(m_brightest));
+}
+
+void ByBrightnessAnimation::pixelsChanged(const unsigned changed)
+{
+	if(changed & PixelAnimation::PIXELS1)
+	{
+		//masks of the first image read one byte per pixel instead of the whole pixels
+		m_alpha1.resize(m_pixels1.size() / 4u);
+		pk::extractAlpha(m_pixels1.data(), m_alpha1.data(), m_alpha1.size());
+	}
+
+	const std::size_t pixels = m_pixels2.size() / 4;
+	if(changed & PixelAnimation::PIXELS2)
+	{
+		//brightness is the one of the colors, not of the colors darkened by alpha
+		std::vector<unsigned char> straight;
+		if(m_premultiplied)
+		{
+			straight.resize(m_pixels2.size());
+			pk::unpremultiply(m_pixels2.data(), straight.data(), pixels);
+		}
+		const std::uint8_t *colors = m_premultiplied ? straight.data() : m_pixels2.data();
+
+		m_luminance.resize(pixels);
+		pk::computeLuminance(colors, m_luminance.data(), pixels);
+		m_darkest = 255;
+		m_brightest = 0;
+		pk::brightnessRange(colors, pixels, m_darkest, m_brightest);
+
+		m_firstOfLevel.fill(pixels);
+		m_endOfLevel.fill(0u);
+		for(std::size_t i = 0; i < pixels; i++)
+		{
+			const std::uint8_t level = m_luminance[i];
+			m_firstOfLevel[level] = std::min(m_firstOfLevel[level], i);
+			m_endOfLevel[level] = i + 1u;
+		}
+	}
+
+	//pixels covered by both images sorted by brightness, every frame touches only the levels it reveals or hides
+	const std::size_t common = std::min(m_pixels1.size(), m_pixels2.size()) / 4u;
+	if(!(changed & PixelAnimation::PIXELS2) && m_order.size() == common)
+	{
+		return;//the first image was replaced by one covering the same pixels, the order is still the one of the second image
+	}
+	std::array<std::size_t, 256> counts;
+	counts.fill(0u);
+	for(std::size_t i = 0; i < common; i++)
+	{
+		counts[m_luminance[i]]++;
+	}
+	m_levelBegin[0] = 0u;
+	for(unsigned level = 0; level < 256u; level++)
+	{
+		m_levelBegin[level + 1u] = m_levelBegin[level] + counts[level];
+	}
+	m_order.resize(common);
+	std::array<std::size_t, 256> next;
+	std::copy(m_levelBegin.begin(), m_levelBegin.end() - 1, next.begin());
+	for(std::size_t i = 0; i < common; i++)
+	{
+		m_order[next[m_luminance[i]]++] = static_cast<std::uint32_t>(i);
+	}
+}
+
+std::size_t ByBrightnessAnimation::getPlanBytes() const
+{
+	return m_luminance.capacity() + m_alpha1.capacity() + m_order.capacity() * sizeof(std::uint32_t);
+}
+
+PixelSpan ByBrightnessAnimation::changedPixels1(const float &from_time, const float &to_time) const
+{
+	const unsigned from = this->threshold(from_time), to = this->threshold(to_time);
+	if(from == to)
+	{
+		return PixelSpan();
+	}
+
+	//pixels of the brightness in [lower, upper) are hidden at one time and shown at the other
+	const unsigned lower = std::min(from, to), upper = std::min(std::max(from, to), 256u);
+	PixelSpan span{m_luminance.size(), 0u};
+	for(unsigned level = lower; level < upper; level++)
+	{
+		span.begin = std::min(span.begin, m_firstOfLevel[level]);
+		span.end = std::max(span.end, m_endOfLevel[level]);
+	}
+
+	//the rest of the first image not covered by the second one is hidden only at the threshold 0
+	const std::size_t common = std::min(m_pixels1.size(), m_pixels2.size()) / 4u;
+	if(m_pixels1.size() / 4u > common && (from == 0u) != (to == 0u))
+	{
+		span.begin = std::min(span.begin, common);
+		span.end = m_pixels1.size() / 4u;
+	}
+	return span;
+}
+
+PixelSpan ByBrightnessAnimation::changedPixels2(const float &from_time, const float &to_time) const
+{
+	return PixelSpan();
+}
+
+bool ByBrightnessAnimation::hasAlphaMasks() const
+{
+	return true;
+}
+
+void ByBrightnessAnimation::writeAlpha1Mask(const float &current_time, std::vector<unsigned char> &output) const
+{
+	const std::size_t pixels = m_pixels1.size() / 4u;
+	const std::size_t common = std::min(m_pixels1.size(), m_pixels2.size()) / 4u;
+	output.resize(pixels);
+
+	const unsigned threshold = this->threshold(current_time);
+	const std::uint8_t *alpha = m_alpha1.data();
+	const std::uint8_t *luminance = m_luminance.data();
+	std::uint8_t *dst = output.data();
+	forEachPixelRange(common, [alpha, luminance, dst, threshold](std::size_t begin, std::size_t end)
+	{
+		pk::maskBytesByLuminance(alpha + begin, luminance + begin, dst + begin, end - begin, threshold);
+	});
+
+	//the rest of the first image is not covered by the second one
+	for(std::size_t i = common; i < pixels; i++)
+	{
+		output[i] = (threshold == 0) ? 0u : alpha[i];
+	}
+}
+
+void ByBrightnessAnimation::writeAlpha2Mask(const float &current_time, std::vector<unsigned char> &output) const
+{
+	output.resize(m_pixels2.size() / 4u);
+	for(std::size_t i = 0; i < output.size(); i++)
+	{
+		output[i] = m_pixels2[i * 4u + 3u];
+	}
+}
+
+bool ByBrightnessAnimation::updateTexture1Frame(const float &from_time, const float &to_time, std::vector<unsigned char> &frame) const
+{
+	if(frame.size() != std::max(m_pixels1.size(), m_pixels2.size()))
+	{
+		return false;
+	}
+	const unsigned from = this->threshold(from_time), to = this->threshold(to_time);
+	const std::uint8_t *src = m_pixels1.data();
+	std::uint8_t *dst = frame.data();
+	const bool premultiplied = m_premultiplied;
+	auto write = [src, dst, premultiplied](const std::size_t i, const bool hidden)
+	{
+		const std::uint8_t *pixel = src + i * 4u;
+		std::uint8_t *out = dst + i * 4u;
+		out[0] = (hidden && premultiplied) ? 0u : pixel[0];
+		out[1] = (hidden && premultiplied) ? 0u : pixel[1];
+		out[2] = (hidden && premultiplied) ? 0u : pixel[2];
+		out[3] = hidden ? 0u : pixel[3];
+	};
+	this->updateChanged(from, to, write);
+	return true;
+}
+
+bool ByBrightnessAnimation::updateAlpha1Mask(const float &from_time, const float &to_time, std::vector<unsigned char> &mask) const
+{
+	if(mask.size() != m_alpha1.size())
+	{
+		return false;
+	}
+	const unsigned from = this->threshold(from_time), to = this->threshold(to_time);
+	const std::uint8_t *alpha = m_alpha1.data();
+	std::uint8_t *dst = mask.data();
+	this->updateChanged(from, to, [alpha, dst](const std::size_t i, const bool hidden)
+	{
+		dst[i] = hidden ? 0u : alpha[i];
+	});
+	return true;
+}
+
+PixelOperation ByBrightnessAnimation::frameOperation1(const float &current_time) const
+{
+	const unsigned threshold = this->threshold(current_time);
+	const std::size_t common = std::min(m_pixels1.size(), m_pixels2.size()) / 4u;
+	const std::uint8_t *luminance = m_luminance.data();
+	const bool premultiplied = m_premultiplied;
+	return [threshold, common, luminance, premultiplied](const std::uint8_t *src, std::uint8_t *dst, std::size_t first, std::size_t pixels)
+	{
+		const std::size_t covered = first < common ? std::min(pixels, common - first) : 0u;
+		if(premultiplied)//hidden pixels lose their color as well
+		{
+			pk::clearByLuminance(src, luminance + first, dst, covered, threshold);
+		}
+		else
+		{
+			pk::maskAlphaByLuminance(src, luminance + first, dst, covered, threshold);
+		}
+
+		//pixels not covered by the second image are hidden only at the threshold 0
+		for(std::size_t i = covered * 4u; i < pixels * 4u; i += 4u)
+		{
+			const bool hidden = threshold == 0u;
+			dst[i] = (hidden && premultiplied) ? 0u : src[i];
+			dst[i + 1u] = (hidden && premultiplied) ? 0u : src[i + 1u];
+			dst[i + 2u] = (hidden && premultiplied) ? 0u : src[i + 2u];
+			dst[i + 3u] = hidden ? 0u : src[i + 3u];
+		}
+	};
+}
+
+PixelOperation ByBrightnessAnimation::frameOperation2(const float &current_time) const
+{
+	return PixelAnimation::copyOperation();
+}
+
+//private member functions
+template <typename Write>
+void ByBrightnessAnimation::updateChanged(const unsigned from, const unsigned to, const Write &write) const
+{
+	//pixels of the brightness in [lower, upper) are all hidden at the lower threshold and all shown at the upper one
+	const unsigned lower = std::min(from, to), upper = std::min(std::max(from, to), 256u);
+	if(lower < upper)
+	{
+		const bool hidden = to < from;
+		const std::uint32_t *order = m_order.data() + m_levelBegin[lower];
+		forEachPixelRange(m_levelBegin[upper] - m_levelBegin[lower], [order, hidden, &write](std::size_t begin, std::size_t end)
+		{
+			for(std::size_t k = begin; k < end; k++)
+			{
+				write(order[k], hidden);
+			}
+		});
+	}
+
+	//the rest of the first image not covered by the second one is hidden only at the threshold 0
+	if((from == 0u) != (to == 0u))
+	{
+		for(std::size_t i = m_order.size(); i < m_pixels1.size() / 4u; i++)
+		{
+			write(i, to == 0u);
+		}
+	}
+}
+
+unsigned ByBrightnessAnimation::threshold(const float &current_time) const
+{
+	float key = std::clamp(1.f - this->toProgress(current_time), 0.f, 1.f);
+
+	// brightest and darkest pixel are known since the pixels were set
+	unsigned char darkest = m_darkest;
+	if(m_pixels2.size() < m_pixels1.size())//missing pixels of second image are black
+	{
+		darkest = 0;
+	}
+
+	key = ( key * (m_brightest - darkest + 1) + darkest ) ;
+	return static_cast<unsigned>(key);
+}
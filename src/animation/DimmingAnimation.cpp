@@ -3,7 +3,8 @@
 
 DimmingAnimation::DimmingAnimation()
 :
-PixelAnimation()
+PixelAnimation(),
+m_linearLight(false)
 {
 
 }
@@ -14,7 +15,8 @@ DimmingAnimation::DimmingAnimation(
 	std::vector<unsigned char> texture1_pixels, 
 	std::vector<unsigned char> texture2_pixels)
 :
-PixelAnimation(animation_length, animation_speed, texture1_pixels, texture2_pixels)
+PixelAnimation(animation_length, animation_speed, std::move(texture1_pixels), std::move(texture2_pixels)),
+m_linearLight(false)
 {
 }
 
@@ -24,7 +26,19 @@ DimmingAnimation::DimmingAnimation(
 	const sf::Texture &texture1,
 	const sf::Texture &texture2)
 :
-PixelAnimation(animation_length, animation_speed, texture1, texture2)
+PixelAnimation(animation_length, animation_speed, texture1, texture2),
+m_linearLight(false)
+{
+}
+
+DimmingAnimation::DimmingAnimation(
+	const float &animation_length,
+	const float &animation_speed,
+	const sf::Image &image1,
+	const sf::Image &image2)
+:
+PixelAnimation(animation_length, animation_speed, image1, image2),
+m_linearLight(false)
 {
 }
 
@@ -34,3 +48,145 @@ DimmingAnimation::~DimmingAnimation()
 	m_pixels2.clear();
 }
 
+const std::string &DimmingAnimation::getShaderSource() const
+{
+	static const std::string source = R"(
+uniform sampler2D source;
+uniform float progress;
+uniform int layer;
+uniform bool linearLight;
+
+vec3 dim(vec3 color, float factor)
+{
+	if(!linearLight)
+		return color * factor;
+	vec3 decoded = mix(color / 12.92, pow((color + 0.055) / 1.055, vec3(2.4)), step(0.04045, color)) * factor;
+	return mix(decoded * 12.92, 1.055 * pow(decoded, vec3(1.0 / 2.4)) - 0.055, step(0.0031308, decoded));
+}
+
+void main()
+{
+	vec4 pixel = texture2D(source, gl_TexCoord[0].xy);
+	if(layer == 1)
+	{
+		if(progress <= 0.5)
+			pixel.rgb = dim(pixel.rgb, 1.0 - progress * 2.0);
+		else
+			pixel.a = 0.0;
+	}
+	else
+	{
+		if(progress <= 0.5)
+			pixel.rgb = vec3(0.0);
+		else
+		{
+			pixel.rgb = dim(pixel.rgb, (progress - 0.5) * 2.0);
+			pixel.a *= (progress - 0.5) * 2.0;
+		}
+	}
+	gl_FragColor = gl_Color * pixel;
+}
+)";
+	return source;
+}
+
+void DimmingAnimation::setShaderParameters(sf::Shader &shader, const float &current_time) const
+{
+	PixelAnimation::setShaderParameters(shader, current_time);
+	shader.setUniform("linearLight", m_linearLight);
+}
+
+void DimmingAnimation::setLinearLight(const bool linear_light)
+{
+	m_linearLight = linear_light;
+}
+
+bool DimmingAnimation::isLinearLight() const
+{
+	return m_linearLight;
+}
+
+std::uint64_t DimmingAnimation::getParameterHash() const
+{
+	return ContentHash(PixelAnimation::getParameterHash()).add(m_linearLight).getValue();
+}
+
+PixelOperation DimmingAnimation::frameOperation1(const float &current_time) const
+{
+	return this->scaling(this->factors1(current_time));
+}
+
+PixelOperation DimmingAnimation::frameOperation2(const float &current_time) const
+{
+	return this->scaling(this->factors2(current_time));
+}
+
+PixelSpan DimmingAnimation::changedPixels1(const float &from_time, const float &to_time) const
+{
+	return this->factors1(from_time) == this->factors1(to_time) ? PixelSpan() : PixelSpan{0u, m_pixels1.size() / 4u};
+}
+
+PixelSpan DimmingAnimation::changedPixels2(const float &from_time, const float &to_time) const
+{
+	return this->factors2(from_time) == this->factors2(to_time) ? PixelSpan() : PixelSpan{0u, m_pixels2.size() / 4u};
+}
+
+//private member functions
+void DimmingAnimation::writeScaled(const std::vector<unsigned char> &pixels, const pk::ChannelFactors &factors, std::vector<unsigned char> &output) const
+{
+	output.resize(pixels.size());
+	const std::uint8_t *src = pixels.data();
+	std::uint8_t *dst = output.data();
+	if(!m_linearLight)
+	{
+		forEachPixelRange(pixels.size() / 4, [src, dst, &factors](std::size_t begin, std::size_t end)
+		{
+			pk::scaleChannels(src + begin * 4, dst + begin * 4, end - begin, factors);
+		});
+		return;
+	}
+
+	const pk::ChannelLut lut = pk::linearLightScalingLut(factors);
+	forEachPixelRange(pixels.size() / 4, [src, dst, &lut](std::size_t begin, std::size_t end)
+	{
+		pk::applyLut(src + begin * 4, dst + begin * 4, end - begin, lut);
+	});
+}
+
+PixelOperation DimmingAnimation::scaling(const pk::ChannelFactors &factors) const
+{
+	if(!m_linearLight)
+	{
+		return [factors](const std::uint8_t *src, std::uint8_t *dst, std::size_t, std::size_t pixels)
+		{
+			pk::scaleChannels(src, dst, pixels, factors);
+		};
+	}
+	auto lut = std::make_shared<const pk::ChannelLut>(pk::linearLightScalingLut(factors));
+	return [lut](const std::uint8_t *src, std::uint8_t *dst, std::size_t, std::size_t pixels)
+	{
+		pk::applyLut(src, dst, pixels, *lut);
+	};
+}
+
+pk::ChannelFactors DimmingAnimation::factors1(const float &current_time) const
+{
+	const float progress = this->toProgress(current_time);
+	if(progress <= 0.5f)
+	{
+		const std::uint16_t rgb = pk::toFactor(1.f - progress * 2.f);
+		return this->frameFactors({rgb, rgb, rgb, 256u});
+	}
+	return this->frameFactors({256u, 256u, 256u, 0u});
+}
+
+pk::ChannelFactors DimmingAnimation::factors2(const float &current_time) const
+{
+	const float progress = this->toProgress(current_time);
+	if(progress > 0.5f)
+	{
+		const std::uint16_t rgba = pk::toFactor((progress - 0.5f) * 2.f);
+		return this->frameFactors({rgba, rgba, rgba, rgba});
+	}
+	return this->frameFactors({0u, 0u, 0u, 256u});
+}
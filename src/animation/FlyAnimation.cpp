@@ -4,7 +4,7 @@ FlyAnimation::FlyAnimation()
 :
 ObjectAnimation()
 {
-
+	this->buildTracks();
 }
 
 
@@ -17,5 +17,38 @@ FlyAnimation::FlyAnimation(
 	const em::Matrix4f &image2end)
 :ObjectAnimation(animation_length,animation_speed,image1start,image2start,image1end,image2end)
 {
+	this->buildTracks();
 }
 
+//private member functions
+void FlyAnimation::buildTracks()
+{
+	//in the first half the first image flies away, in the second half the second one flies in
+	TransformComponents away;
+	away.translation = sf::Vector3f(480.f, 340.f, -0.5f);
+	away.scale = sf::Vector3f(0.f, 0.f, 1.f);
+
+	TransformComponents gone;
+	gone.scale = sf::Vector3f(0.f, 0.f, 0.f);
+
+	m_track1.addKeyframe(0.f, TransformComponents());
+	m_track1.addKeyframe(0.5f, away);
+	m_track1.addKeyframe(0.5f, gone);
+	m_track1.addKeyframe(1.f, gone);
+
+	TransformComponents waiting;
+	waiting.translation = sf::Vector3f(500.f, 500.f, 1.f);
+	waiting.scale = sf::Vector3f(0.f, 0.f, 0.f);
+
+	TransformComponents coming;
+	coming.translation = sf::Vector3f(480.f, 340.f, -0.5f);
+	coming.scale = sf::Vector3f(0.f, 0.f, 0.5f);
+
+	TransformComponents arrived;
+	arrived.translation = sf::Vector3f(0.f, 0.f, -1.f);
+
+	m_track2.addKeyframe(0.f, waiting);
+	m_track2.addKeyframe(0.5f, waiting);
+	m_track2.addKeyframe(0.5f, coming);
+	m_track2.addKeyframe(1.f, arrived);
+}
@@ -0,0 +1,214 @@
+#include "../../include/animation/KeyframeTrack.h"
+
+namespace
+{
+	sf::Vector3f lerp(const sf::Vector3f &from, const sf::Vector3f &to, const float &factor)
+	{
+		return from + (to - from) * factor;
+	}
+}//anonymous namespace
+
+KeyframeTrack::KeyframeTrack()
+:
+m_keyframes()
+{ }
+
+void KeyframeTrack::addKeyframe(const float &progress, const TransformComponents &components, const Easing easing)
+{
+	auto position = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), progress,
+		[](const float &value, const Keyframe &keyframe) { return value < keyframe.progress; });
+	m_keyframes.insert(position, Keyframe{progress, components, easing});
+}
+
+std::size_t KeyframeTrack::setKeyframe(const std::size_t index, const Keyframe &keyframe)
+{
+	this->removeKeyframe(index);
+	this->addKeyframe(keyframe.progress, keyframe.components, keyframe.easing);
+	//the keyframe was inserted after all others of its progress
+	auto position = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), keyframe.progress,
+		[](const float &value, const Keyframe &other) { return value < other.progress; });
+	return static_cast<std::size_t>(position - m_keyframes.begin()) - 1u;
+}
+
+void KeyframeTrack::removeKeyframe(const std::size_t index)
+{
+	if(index >= m_keyframes.size())
+	{
+		throw std::out_of_range("KeyframeTrack::removeKeyframe(): there is no keyframe " + std::to_string(index));
+	}
+	m_keyframes.erase(m_keyframes.begin() + static_cast<std::ptrdiff_t>(index));
+}
+
+const KeyframeTrack::Keyframe &KeyframeTrack::getKeyframe(const std::size_t index) const
+{
+	if(index >= m_keyframes.size())
+	{
+		throw std::out_of_range("KeyframeTrack::getKeyframe(): there is no keyframe " + std::to_string(index));
+	}
+	return m_keyframes[index];
+}
+
+void KeyframeTrack::clear()
+{
+	m_keyframes.clear();
+}
+
+std::size_t KeyframeTrack::getKeyframeCount() const
+{
+	return m_keyframes.size();
+}
+
+std::uint64_t KeyframeTrack::getHash() const
+{
+	ContentHash hash(m_keyframes.size());
+	for(const Keyframe &keyframe : m_keyframes)
+	{
+		hash.add(keyframe.progress)
+			.add(keyframe.components.translation)
+			.add(keyframe.components.rotation)
+			.add(keyframe.components.scale)
+			.add(static_cast<int>(keyframe.easing));
+	}
+	return hash.getValue();
+}
+
+ProgressRange KeyframeTrack::changedRange(const KeyframeTrack &other) const
+{
+	const std::vector<Keyframe> &mine = m_keyframes;
+	const std::vector<Keyframe> &theirs = other.m_keyframes;
+	const std::size_t shorter = std::min(mine.size(), theirs.size());
+	std::size_t prefix = 0u;
+	while(prefix < shorter && KeyframeTrack::isSame(mine[prefix], theirs[prefix]))
+	{
+		prefix++;
+	}
+	if(prefix == mine.size() && prefix == theirs.size())
+	{
+		return ProgressRange();
+	}
+	std::size_t suffix = 0u;
+	while(suffix < shorter - prefix && KeyframeTrack::isSame(mine[mine.size() - 1u - suffix], theirs[theirs.size() - 1u - suffix]))
+	{
+		suffix++;
+	}
+
+	//segments ending at the shared keyframe before the differences and starting at the one after them are unchanged
+	ProgressRange range;
+	range.begin = prefix > 0u ? mine[prefix - 1u].progress : -std::numeric_limits<float>::infinity();
+	range.end = suffix > 0u ? mine[mine.size() - suffix].progress : std::numeric_limits<float>::infinity();
+	return range;
+}
+
+TransformComponents KeyframeTrack::evaluate(const float &progress) const
+{
+	if(m_keyframes.empty())
+	{
+		return TransformComponents();
+	}
+
+	//segment ends at the first keyframe at or after the progress
+	auto next = std::lower_bound(m_keyframes.begin(), m_keyframes.end(), progress,
+		[](const Keyframe &keyframe, const float &value) { return keyframe.progress < value; });
+	if(next == m_keyframes.begin())
+	{
+		return next->components;
+	}
+	if(next == m_keyframes.end())
+	{
+		return m_keyframes.back().components;
+	}
+
+	const Keyframe &previous = *(next - 1);
+	const float factor = KeyframeTrack::ease(previous.easing, (progress - previous.progress) / (next->progress - previous.progress));
+
+	TransformComponents result;
+	result.translation = lerp(previous.components.translation, next->components.translation, factor);
+	result.rotation = lerp(previous.components.rotation, next->components.rotation, factor);
+	result.scale = lerp(previous.components.scale, next->components.scale, factor);
+	return result;
+}
+
+em::Matrix4f KeyframeTrack::evaluateMatrix(const float &progress, const em::Matrix4f &base) const
+{
+	return KeyframeTrack::compose(this->evaluate(progress), base);
+}
+
+em::Matrix4f KeyframeTrack::compose(const TransformComponents &components, const em::Matrix4f &base)
+{
+	//linear part is rotation X * rotation Y * rotation Z with columns multiplied by the scale
+	const sf::Vector3f &s = components.scale;
+	float linear[3][3] = {
+		{ s.x, 0.f, 0.f },
+		{ 0.f, s.y, 0.f },
+		{ 0.f, 0.f, s.z } };
+
+	const sf::Vector3f &r = components.rotation;
+	if(r.x != 0.f || r.y != 0.f || r.z != 0.f)
+	{
+		const double to_radians = 3.141592654 / 180.0;
+		const float cx = std::cos(r.x * to_radians), sx = std::sin(r.x * to_radians);
+		const float cy = std::cos(r.y * to_radians), sy = std::sin(r.y * to_radians);
+		const float cz = std::cos(r.z * to_radians), sz = std::sin(r.z * to_radians);
+
+		linear[0][0] = cy * cz * s.x;
+		linear[0][1] = -cy * sz * s.y;
+		linear[0][2] = sy * s.z;
+		linear[1][0] = (cx * sz + sx * sy * cz) * s.x;
+		linear[1][1] = (cx * cz - sx * sy * sz) * s.y;
+		linear[1][2] = -sx * cy * s.z;
+		linear[2][0] = (sx * sz - cx * sy * cz) * s.x;
+		linear[2][1] = (sx * cz + cx * sy * sz) * s.y;
+		linear[2][2] = cx * cy * s.z;
+	}
+
+	em::Matrix4f result;
+	for(unsigned i = 0; i < 3; i++)
+	{
+		for(unsigned j = 0; j < 3; j++)
+		{
+			result[i][j] = base[i][0] * linear[0][j] + base[i][1] * linear[1][j] + base[i][2] * linear[2][j];
+		}
+	}
+	result[0][3] = base[0][3] + components.translation.x;
+	result[1][3] = base[1][3] + components.translation.y;
+	result[2][3] = base[2][3] + components.translation.z;
+	return result;
+}
+
+float KeyframeTrack::ease(const Easing easing, const float &progress)
+{
+	const float p = std::clamp(progress, 0.f, 1.f);
+	switch(easing)
+	{
+		case(Easing::STEP):
+		{
+			return p < 1.f ? 0.f : 1.f;
+		}
+		case(Easing::EASE_IN):
+		{
+			return p * p;
+		}
+		case(Easing::EASE_OUT):
+		{
+			return 1.f - (1.f - p) * (1.f - p);
+		}
+		case(Easing::EASE_IN_OUT):
+		{
+			return p * p * (3.f - 2.f * p);
+		}
+		default:
+		{
+			return p;
+		}
+	}
+}
+
+//private member functions
+bool KeyframeTrack::isSame(const Keyframe &left, const Keyframe &right)
+{
+	return left.progress == right.progress
+		&& left.components.translation == right.components.translation
+		&& left.components.rotation == right.components.rotation
+		&& left.components.scale == right.components.scale
+		&& left.easing == right.easing;
+}
@@ -6,7 +6,9 @@ Animation(),
 m_image1Start(em::Matrix4f()),
 m_image2Start(em::Matrix4f()),
 m_image1End(em::Matrix4f()),
-m_image2End(em::Matrix4f())
+m_image2End(em::Matrix4f()),
+m_track1(),
+m_track2()
 { }
 
 ObjectAnimation::ObjectAnimation(
@@ -21,11 +23,75 @@ Animation(animation_length, animation_speed),
 m_image1Start(image1start),
 m_image2Start(image2start),
 m_image1End(image1end),
-m_image2End(image2end)
+m_image2End(image2end),
+m_track1(),
+m_track2()
 {
 
 }
 
+const em::Matrix4f ObjectAnimation::getImage1Frame(const float &current_time) const
+{
+	return m_track1.evaluateMatrix(this->toProgress(current_time), m_image1Start);
+}
+
+const em::Matrix4f ObjectAnimation::getImage2Frame(const float &current_time) const
+{
+	return m_track2.evaluateMatrix(this->toProgress(current_time), m_image2Start);
+}
+
+void ObjectAnimation::sample(const std::vector<float> &times, const FrameConsumer &consumer) const
+{
+	AnimationFrame frame;
+	for(std::size_t i = 0; i < times.size(); i++)
+	{
+		frame.time = times[i];
+		frame.transform1 = this->getImage1Frame(times[i]);
+		frame.transform2 = this->getImage2Frame(times[i]);
+		consumer(i, frame);
+	}
+}
+
+const KeyframeTrack &ObjectAnimation::getTrack1() const
+{
+	return m_track1;
+}
+
+const KeyframeTrack &ObjectAnimation::getTrack2() const
+{
+	return m_track2;
+}
+
+KeyframeTrack &ObjectAnimation::editTrack(const unsigned image)
+{
+	if(image == 1u)
+	{
+		return m_track1;
+	}
+	if(image == 2u)
+	{
+		return m_track2;
+	}
+	throw std::out_of_range("ObjectAnimation::editTrack(): there is no image " + std::to_string(image));
+}
+
+bool ObjectAnimation::isKeyframed() const
+{
+	return true;
+}
+
+std::uint64_t ObjectAnimation::getParameterHash() const
+{
+	return ContentHash(Animation::getParameterHash())
+		.add(m_image1Start)
+		.add(m_image2Start)
+		.add(m_image1End)
+		.add(m_image2End)
+		.add(m_track1.getHash())
+		.add(m_track2.getHash())
+		.getValue();
+}
+
 const em::Matrix4f &ObjectAnimation::getStartingTransform1() const
 {
 	return m_image1Start;
@@ -4,7 +4,9 @@ PixelAnimation::PixelAnimation()
 :
 Animation(),
 m_pixels1({}),
-m_pixels2({})
+m_pixels2({}),
+m_pixelsCharge(MemorySubsystem::ANIMATIONS),
+m_premultiplied(false)
 { }
 
 PixelAnimation::PixelAnimation(
@@ -14,9 +16,13 @@ PixelAnimation::PixelAnimation(
 	std::vector<unsigned char> texture2_pixels)
 :
 Animation(animation_length, animation_speed),
-m_pixels1(texture1_pixels),
-m_pixels2(texture2_pixels)
-{}
+m_pixels1(std::move(texture1_pixels)),
+m_pixels2(std::move(texture2_pixels)),
+m_pixelsCharge(MemorySubsystem::ANIMATIONS),
+m_premultiplied(false)
+{
+	this->accountPixels();
+}
 
 PixelAnimation::PixelAnimation(
 	const float &animation_length,
@@ -24,56 +30,278 @@ PixelAnimation::PixelAnimation(
 	const sf::Texture &texture1,
 	const sf::Texture &texture2)
 :
-Animation(animation_length, animation_speed)
+PixelAnimation(animation_length, animation_speed, texture1.copyToImage(), texture2.copyToImage())
+{}
+
+PixelAnimation::PixelAnimation(
+	const float &animation_length,
+	const float &animation_speed,
+	const sf::Image &image1,
+	const sf::Image &image2)
+:
+Animation(animation_length, animation_speed),
+m_pixels1(PixelAnimation::toPixels(image1)),
+m_pixels2(PixelAnimation::toPixels(image2)),
+m_pixelsCharge(MemorySubsystem::ANIMATIONS),
+m_premultiplied(false)
+{
+	this->accountPixels();
+}
+
+PixelOperation PixelAnimation::frameOperation1(const float &current_time) const
+{
+	return PixelOperation();
+}
+
+PixelOperation PixelAnimation::frameOperation2(const float &current_time) const
 {
-	if(texture1.getSize() != sf::Vector2u(0u, 0u))
+	return PixelOperation();
+}
+
+bool PixelAnimation::hasTransforms() const
+{
+	return false;
+}
+
+em::Matrix4f PixelAnimation::getImage1Transform(const float &current_time) const
+{
+	return em::Matrix4f();
+}
+
+em::Matrix4f PixelAnimation::getImage2Transform(const float &current_time) const
+{
+	return em::Matrix4f();
+}
+
+const std::vector<unsigned char> PixelAnimation::getTexture1Frame(const float &current_time) const
+{
+	std::vector<unsigned char> result;
+	this->writeTexture1Frame(current_time, result);
+	return result;
+}
+
+const std::vector<unsigned char> PixelAnimation::getTexture2Frame(const float &current_time) const
+{
+	std::vector<unsigned char> result;
+	this->writeTexture2Frame(current_time, result);
+	return result;
+}
+
+void PixelAnimation::writeFrames(const float &current_time, std::vector<unsigned char> &output1, std::vector<unsigned char> &output2) const
+{
+	const PixelOperation operation1 = this->frameOperation1(current_time);
+	const PixelOperation operation2 = this->frameOperation2(current_time);
+	if(!operation1 || !operation2 || m_pixels1.size() != m_pixels2.size())
 	{
-		const sf::Image &temp = texture1.copyToImage();
-		const sf::Uint8 *pix = temp.getPixelsPtr();
-		unsigned size = texture1.getSize().x * texture1.getSize().y * 4;
-		for(unsigned i = 0; i < size; i++)
-		{
-			m_pixels1.push_back(pix[i]);
-		}
+		this->writeTexture1Frame(current_time, output1);
+		this->writeTexture2Frame(current_time, output2);
+		return;
 	}
-	else
+
+	output1.resize(m_pixels1.size());
+	output2.resize(m_pixels2.size());
+	const std::uint8_t *src1 = m_pixels1.data();
+	const std::uint8_t *src2 = m_pixels2.data();
+	std::uint8_t *dst1 = output1.data();
+	std::uint8_t *dst2 = output2.data();
+	forEachPixelRange(m_pixels1.size() / 4u, [&](std::size_t begin, std::size_t end)
 	{
-		m_pixels1 = {};
+		//the same range of both images, so data the operations share by pixel is still cached for the second one
+		operation1(src1 + begin * 4u, dst1 + begin * 4u, begin, end - begin);
+		operation2(src2 + begin * 4u, dst2 + begin * 4u, begin, end - begin);
+	});
+}
+
+const std::string &PixelAnimation::getShaderSource() const
+{
+	static const std::string no_shader;
+	return no_shader;
+}
+
+void PixelAnimation::setShaderParameters(sf::Shader &shader, const float &current_time) const
+{
+	shader.setUniform("progress", this->toProgress(current_time));
+}
+
+const std::vector<unsigned char> &PixelAnimation::getPixels1() const
+{
+	return m_pixels1;
+}
+
+const std::vector<unsigned char> &PixelAnimation::getPixels2() const
+{
+	return m_pixels2;
+}
+
+std::vector<unsigned char> PixelAnimation::toPixels(const sf::Image &image)
+{
+	const sf::Uint8 *pix = image.getPixelsPtr();
+	if(!pix)
+	{
+		return {};
 	}
-	
+	return std::vector<unsigned char>(pix, pix + static_cast<std::size_t>(image.getSize().x) * image.getSize().y * 4u);
+}
 
-	if(texture2.getSize() != sf::Vector2u(0u, 0u))
+void PixelAnimation::setPixels1(std::vector<unsigned char> texture1_pixels)
+{
+	m_pixels1 = std::move(texture1_pixels);
+	this->plan(PixelAnimation::PIXELS1);
+}
+
+void PixelAnimation::setPixels2(std::vector<unsigned char> texture2_pixels)
+{
+	m_pixels2 = std::move(texture2_pixels);
+	this->plan(PixelAnimation::PIXELS2);
+}
+
+void PixelAnimation::takePixels(PixelAnimation &source)
+{
+	m_pixels1 = std::move(source.m_pixels1);
+	m_pixels2 = std::move(source.m_pixels2);
+	source.m_pixels1.clear();
+	source.m_pixels2.clear();
+	source.accountPixels();
+	m_premultiplied = source.m_premultiplied;
+	this->plan();
+}
+
+PixelSpan PixelAnimation::changedPixels1(const float &from_time, const float &to_time) const
+{
+	return PixelSpan{0u, m_pixels1.size() / 4u};
+}
+
+PixelSpan PixelAnimation::changedPixels2(const float &from_time, const float &to_time) const
+{
+	return PixelSpan{0u, m_pixels2.size() / 4u};
+}
+
+void PixelAnimation::setPremultiplied(const bool premultiplied)
+{
+	if(premultiplied != m_premultiplied)
 	{
-		const sf::Image &temp = texture2.copyToImage();
-		const sf::Uint8 *pix = temp.getPixelsPtr();
-		unsigned size = texture2.getSize().x * texture2.getSize().y * 4;
-		for(unsigned i = 0; i < size; i++)
-		{
-			m_pixels2.push_back(pix[i]);
-		}
+		m_premultiplied = premultiplied;
+		this->plan();
+	}
+}
+
+bool PixelAnimation::isPremultiplied() const
+{
+	return m_premultiplied;
+}
+
+void PixelAnimation::plan(const unsigned changed)
+{
+	this->pixelsChanged(changed);
+	this->accountPixels();
+}
+
+std::size_t PixelAnimation::getPlanBytes() const
+{
+	return 0u;
+}
+
+std::uint64_t PixelAnimation::getParameterHash() const
+{
+	return ContentHash(Animation::getParameterHash()).add(m_premultiplied).getValue();
+}
+
+bool PixelAnimation::hasAlphaMasks() const
+{
+	return false;
+}
+
+void PixelAnimation::writeAlpha1Mask(const float &current_time, std::vector<unsigned char> &output) const
+{
+	std::vector<unsigned char> frame;
+	this->writeTexture1Frame(current_time, frame);
+	output.resize(std::min(m_pixels1.size(), frame.size()) / 4u);
+	for(std::size_t i = 0; i < output.size(); i++)
+	{
+		output[i] = frame[i * 4u + 3u];
 	}
-	else
+}
+
+void PixelAnimation::writeAlpha2Mask(const float &current_time, std::vector<unsigned char> &output) const
+{
+	std::vector<unsigned char> frame;
+	this->writeTexture2Frame(current_time, frame);
+	output.resize(std::min(m_pixels2.size(), frame.size()) / 4u);
+	for(std::size_t i = 0; i < output.size(); i++)
 	{
-		m_pixels2 = {};
+		output[i] = frame[i * 4u + 3u];
 	}
 }
 
-std::vector<unsigned char> PixelAnimation::getPixels1() const
+bool PixelAnimation::updateTexture1Frame(const float &from_time, const float &to_time, std::vector<unsigned char> &frame) const
 {
-	return m_pixels1;
+	return false;
 }
 
-std::vector<unsigned char> PixelAnimation::getPixels2() const
+bool PixelAnimation::updateAlpha1Mask(const float &from_time, const float &to_time, std::vector<unsigned char> &mask) const
 {
-	return m_pixels2;
+	return false;
 }
 
-void PixelAnimation::setPixels1(std::vector<unsigned char> texture1_pixels)
+void PixelAnimation::pixelsChanged(const unsigned changed)
+{ }
+
+void PixelAnimation::sample(const std::vector<float> &times, const FrameConsumer &consumer) const
 {
-	m_pixels1 = texture1_pixels;
+	//enough frames for every thread to get a whole frame, as long as they fit in the budget
+	ThreadPool &pool = ThreadPool::shared();
+	const std::size_t frame_bytes = std::max<std::size_t>(m_pixels1.size() + m_pixels2.size(), 1u);
+	const std::size_t batch = std::clamp<std::size_t>(
+		std::min<std::size_t>(pool.getThreadCount(), PixelAnimation::SAMPLE_BUDGET / frame_bytes),
+		1u, std::max<std::size_t>(times.size(), 1u));
+
+	std::vector<AnimationFrame> frames(batch);
+	MemoryCharge frames_charge(MemorySubsystem::ANIMATIONS);//the frames reach their full size in the first batch
+	frames_charge.setCpu(batch * frame_bytes);
+	for(std::size_t first = 0; first < times.size(); first += batch)
+	{
+		const std::size_t count = std::min(batch, times.size() - first);
+		for(std::size_t i = 0; i < count; i++)
+		{
+			frames[i].time = times[first + i];
+		}
+		pool.parallelFor(count, 1u, [&](std::size_t begin, std::size_t end)
+		{
+			for(std::size_t i = begin; i < end; i++)
+			{
+				this->writeFrames(frames[i].time, frames[i].pixels1, frames[i].pixels2);
+			}
+		});
+		for(std::size_t i = 0; i < count; i++)
+		{
+			consumer(first + i, frames[i]);
+		}
+	}
 }
 
-void PixelAnimation::setPixels2(std::vector<unsigned char> texture2_pixels)
+void PixelAnimation::forEachPixelRange(const std::size_t pixels, const std::function<void(std::size_t, std::size_t)> &body)
+{
+	ThreadPool::shared().parallelFor(pixels, PixelAnimation::PIXEL_RANGE, body);
+}
+
+PixelOperation PixelAnimation::copyOperation()
+{
+	return [](const std::uint8_t *src, std::uint8_t *dst, std::size_t, std::size_t pixels)
+	{
+		if(src != dst)
+		{
+			std::copy(src, src + pixels * 4u, dst);
+		}
+	};
+}
+
+pk::ChannelFactors PixelAnimation::frameFactors(const pk::ChannelFactors &factors) const
+{
+	return m_premultiplied ? pk::premultiplied(factors) : factors;
+}
+
+//private member functions
+void PixelAnimation::accountPixels()
 {
-	m_pixels2 = texture2_pixels;
+	m_pixelsCharge.setCpu(m_pixels1.capacity() + m_pixels2.capacity() + this->getPlanBytes());
 }
@@ -1,5 +1,8 @@
 #include "../../include/animation/RingAnimation.h"
 
+const SampledCurve RingAnimation::COSINE_PATH([](const float &progress) { return progress * std::cos(progress); });
+const SampledCurve RingAnimation::WIDE_COSINE_PATH([](const float &progress) { return progress * std::cos(1.14f * progress); });
+
 RingAnimation::RingAnimation()
 :
 ObjectAnimation()
@@ -0,0 +1,177 @@
+#include "../../include/animation/SampledCurve.h"
+
+namespace
+{
+	/**
+	 * Coordinate of a cubic Bezier curve from 0 to 1 with control points a and b
+	 */
+	float bezier(const float &a, const float &b, const float &t)
+	{
+		const float u = 1.f - t;
+		return 3.f * u * u * t * a + 3.f * u * t * t * b + t * t * t;
+	}
+
+	float bezierSlope(const float &a, const float &b, const float &t)
+	{
+		const float u = 1.f - t;
+		return 3.f * u * u * a + 6.f * u * t * (b - a) + 3.f * t * t * (1.f - b);
+	}
+
+	std::vector<float> parseNumbers(const std::string &list)
+	{
+		std::vector<float> numbers;
+		std::size_t start = 0;
+		while(start <= list.size())
+		{
+			const std::size_t end = std::min(list.find(',', start), list.size());
+			numbers.push_back(std::stof(list.substr(start, end - start)));
+			start = end + 1u;
+		}
+		return numbers;
+	}
+}//anonymous namespace
+
+SampledCurve::SampledCurve()
+:
+SampledCurve([](const float &progress) { return progress; }, 2u)
+{ }
+
+SampledCurve::SampledCurve(Function function, const std::size_t samples)
+:
+m_function(std::move(function)),
+m_samples(),
+m_scale(0.f)
+{
+	this->resample(samples);
+}
+
+SampledCurve SampledCurve::fromEasing(const Easing easing)
+{
+	if(easing == Easing::LINEAR)
+	{
+		return SampledCurve();
+	}
+	return SampledCurve([easing](const float &progress) { return KeyframeTrack::ease(easing, progress); });
+}
+
+SampledCurve SampledCurve::cubicBezier(const float &x1, const float &y1, const float &x2, const float &y2)
+{
+	if(!(x1 >= 0.f && x1 <= 1.f && x2 >= 0.f && x2 <= 1.f))
+	{
+		throw std::invalid_argument("SampledCurve::cubicBezier(): progress of the control points has to be from 0 to 1");
+	}
+	return SampledCurve([x1, y1, x2, y2](const float &progress)
+	{
+		//x grows monotonically with t, Newton steps fall back to bisection where the slope is flat
+		float low = 0.f, high = 1.f, t = progress;
+		for(unsigned i = 0; i < 24u; i++)
+		{
+			const float error = bezier(x1, x2, t) - progress;
+			if(std::fabs(error) < 1e-6f)
+			{
+				break;
+			}
+			if(error > 0.f)
+			{
+				high = t;
+			}
+			else
+			{
+				low = t;
+			}
+			const float slope = bezierSlope(x1, x2, t);
+			const float next = slope > 1e-6f ? t - error / slope : low - 1.f;
+			t = (next > low && next < high) ? next : (low + high) / 2.f;
+		}
+		return bezier(y1, y2, t);
+	});
+}
+
+SampledCurve SampledCurve::spring(const float &damping, const float &oscillations)
+{
+	if(!(damping > 0.f && damping < 1.f) || !(oscillations > 0.f))
+	{
+		throw std::invalid_argument("SampledCurve::spring(): damping has to be between 0 and 1 and oscillations positive");
+	}
+	const float frequency = 2.f * 3.14159265f * oscillations;
+	const float decay = damping * frequency / std::sqrt(1.f - damping * damping);
+	auto displacement = [frequency, decay](const float &progress)
+	{
+		return 1.f - std::exp(-decay * progress) * (std::cos(frequency * progress) + decay / frequency * std::sin(frequency * progress));
+	};
+	//what is left of the swing at the end is spread over the animation, so it ends exactly at 1
+	const float rest = 1.f - displacement(1.f);
+	return SampledCurve([displacement, rest](const float &progress) { return displacement(progress) + rest * progress; });
+}
+
+SampledCurve SampledCurve::fromName(const std::string &name)
+{
+	if(name == "linear")
+	{
+		return SampledCurve();
+	}
+	if(name == "ease-in")
+	{
+		return SampledCurve::fromEasing(Easing::EASE_IN);
+	}
+	if(name == "ease-out")
+	{
+		return SampledCurve::fromEasing(Easing::EASE_OUT);
+	}
+	if(name == "ease-in-out")
+	{
+		return SampledCurve::fromEasing(Easing::EASE_IN_OUT);
+	}
+	if(name == "spring")
+	{
+		return SampledCurve::spring();
+	}
+	const std::string prefix = "bezier:";
+	if(name.compare(0, prefix.size(), prefix) == 0)
+	{
+		std::vector<float> points;
+		try
+		{
+			points = parseNumbers(name.substr(prefix.size()));
+		}
+		catch(const std::logic_error &)
+		{
+			points.clear();
+		}
+		if(points.size() == 4u)
+		{
+			return SampledCurve::cubicBezier(points[0], points[1], points[2], points[3]);
+		}
+	}
+	throw std::invalid_argument("SampledCurve::fromName(): unknown curve " + name);
+}
+
+std::size_t SampledCurve::samplesFor(const float &seconds)
+{
+	const float samples = std::ceil(std::max(seconds, 0.f) * SAMPLES_PER_SECOND);
+	return std::clamp(static_cast<std::size_t>(std::min(samples, static_cast<float>(MAX_SAMPLES))), MIN_SAMPLES, MAX_SAMPLES);
+}
+
+void SampledCurve::resample(const std::size_t samples)
+{
+	if(samples < 2u)
+	{
+		throw std::invalid_argument("SampledCurve::resample(): a curve needs at least 2 samples");
+	}
+	m_samples.resize(samples);
+	m_scale = static_cast<float>(samples - 1u);
+	for(std::size_t i = 0; i < samples; i++)
+	{
+		m_samples[i] = m_function(static_cast<float>(i) / m_scale);
+	}
+}
+
+std::size_t SampledCurve::getSampleCount() const
+{
+	return m_samples.size();
+}
+
+std::uint64_t SampledCurve::getHash() const
+{
+	return ContentHash::hashBytes(m_samples.data(), m_samples.size() * sizeof(float));
+}
@@ -4,7 +4,7 @@ ScaleAnimation::ScaleAnimation()
 :
 ObjectAnimation()
 {
-
+	this->buildTracks();
 }
 
 
@@ -17,5 +17,23 @@ ScaleAnimation::ScaleAnimation(
 	const em::Matrix4f &image2end)
 :ObjectAnimation(animation_length,animation_speed,image1start,image2start,image1end,image2end)
 {
+	this->buildTracks();
 }
 
+//private member functions
+void ScaleAnimation::buildTracks()
+{
+	//the first image stays behind while the second one grows from the middle
+	TransformComponents behind;
+	behind.translation = sf::Vector3f(0.f, 0.f, 1.f);
+
+	m_track1.addKeyframe(0.f, TransformComponents());
+	m_track1.addKeyframe(1.f, behind);
+
+	TransformComponents hidden;
+	hidden.translation = sf::Vector3f(480.f, 340.f, 0.f);
+	hidden.scale = sf::Vector3f(0.f, 0.f, 0.f);
+
+	m_track2.addKeyframe(0.f, hidden);
+	m_track2.addKeyframe(1.f, TransformComponents());
+}
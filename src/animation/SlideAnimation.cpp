@@ -4,7 +4,7 @@ SlideAnimation::SlideAnimation()
 :
 ObjectAnimation()
 {
-
+    this->buildTracks();
 }
 
 
@@ -17,4 +17,20 @@ SlideAnimation::SlideAnimation(
     const em::Matrix4f &image2end)
 :ObjectAnimation(animation_length,animation_speed,image1start,image2start,image1end,image2end)
 {
-}
\ No newline at end of file
+    this->buildTracks();
+}
+
+//private member functions
+void SlideAnimation::buildTracks()
+{
+    //the first image leaves to the right while the second one comes from the left
+    TransformComponents left, right;
+    left.translation = sf::Vector3f(-960.f, 0.f, 0.f);
+    right.translation = sf::Vector3f(960.f, 0.f, 0.f);
+
+    m_track1.addKeyframe(0.f, TransformComponents());
+    m_track1.addKeyframe(1.f, right);
+
+    m_track2.addKeyframe(0.f, left);
+    m_track2.addKeyframe(1.f, TransformComponents());
+}
@@ -0,0 +1,306 @@
+#include "../../include/animation/Transition.h"
+
+namespace
+{
+	const std::size_t ROWS_PER_TASK = 16u;///> Rows of a frame blended by one task of the pool
+
+	inline std::uint8_t blendChannel(const unsigned source, const unsigned destination, const unsigned alpha)
+	{
+		return static_cast<std::uint8_t>((source * alpha + destination * (255u - alpha) + 127u) / 255u);
+	}
+
+	/**
+	 * Draws an image covering the frame, moved by the transform, over the frame with alpha blending
+	 *
+	 * An orthographic projection keeps only the affine map of the plane of the transform,
+	 *   so every pixel of the frame is mapped back onto the image and takes the nearest
+	 *   pixel, like the unsmoothed textures of the Canvas do.
+	 */
+	void drawLayer(const std::uint8_t *layer, const sf::Vector2u &size, const em::Matrix4f &transform, std::uint8_t *output)
+	{
+		const float a = transform[0][0], b = transform[0][1], c = transform[0][3];
+		const float d = transform[1][0], e = transform[1][1], f = transform[1][3];
+		const float det = a * e - b * d;
+		if(!layer || std::fabs(det) < 1e-6f)
+		{
+			return;//an image squashed into a line covers no pixel
+		}
+		const float ia = e / det, ib = -b / det, ic = (b * f - e * c) / det;
+		const float id = -d / det, ie = a / det, iff = (d * c - a * f) / det;
+
+		const float width = static_cast<float>(size.x), height = static_cast<float>(size.y);
+		const float ys[4] = { f, d * width + f, d * width + e * height + f, e * height + f };
+		const float top = std::max(*std::min_element(ys, ys + 4), 0.f);
+		const float bottom = std::min(*std::max_element(ys, ys + 4), height);
+		if(!(top < bottom))
+		{
+			return;
+		}
+		const std::size_t first_row = static_cast<std::size_t>(top);
+		const std::size_t rows = static_cast<std::size_t>(std::ceil(bottom)) - first_row;
+
+		ThreadPool::shared().parallelFor(rows, ROWS_PER_TASK, [&](std::size_t begin, std::size_t end)
+		{
+			for(std::size_t row = first_row + begin; row < first_row + end; row++)
+			{
+				const float py = static_cast<float>(row) + 0.5f;
+				std::uint8_t *dst = output + row * size.x * 4u;
+				for(unsigned x = 0; x < size.x; x++, dst += 4)
+				{
+					const float px = static_cast<float>(x) + 0.5f;
+					const float u = ia * px + ib * py + ic;
+					const float v = id * px + ie * py + iff;
+					if(!(u >= 0.f && v >= 0.f && u < width && v < height))
+					{
+						continue;
+					}
+					const std::uint8_t *src = layer + (static_cast<std::size_t>(v) * size.x + static_cast<std::size_t>(u)) * 4u;
+					const unsigned alpha = src[3];
+					if(alpha == 255u)
+					{
+						std::copy(src, src + 4, dst);
+					}
+					else if(alpha > 0u)
+					{
+						dst[0] = blendChannel(src[0], dst[0], alpha);
+						dst[1] = blendChannel(src[1], dst[1], alpha);
+						dst[2] = blendChannel(src[2], dst[2], alpha);
+						dst[3] = blendChannel(255u, dst[3], alpha);
+					}
+				}
+			}
+		});
+	}
+}//anonymous namespace
+
+Transition::Transition(std::unique_ptr<ObjectAnimation> animation, const sf::Image &image1, const sf::Image &image2, const unsigned frames, const float &seconds)
+:
+Transition(image1, image2, frames)
+{
+	this->setAnimation(std::move(animation), seconds);
+}
+
+Transition::Transition(std::unique_ptr<PixelAnimation> animation, const sf::Image &image1, const sf::Image &image2, const unsigned frames, const float &seconds)
+:
+Transition(image1, image2, frames)
+{
+	this->setAnimation(std::move(animation), seconds);
+}
+
+Transition::Transition(AnyAnimation animation, const sf::Image &image1, const sf::Image &image2, const unsigned frames, const float &seconds)
+:
+Transition(image1, image2, frames)
+{
+	std::visit([this, &seconds](auto &&chosen)
+	{
+		this->setAnimation(std::move(chosen), seconds);
+	}, releaseAnimation(std::move(animation)));
+}
+
+std::unique_ptr<Transition> Transition::fromName(const std::string &name, const sf::Image &image1, const sf::Image &image2, const unsigned frames, const float &seconds)
+{
+	if(TransitionGraph::isDescription(name))
+	{
+		return std::make_unique<Transition>(std::unique_ptr<PixelAnimation>(TransitionGraph::parse(name)), image1, image2, frames, seconds);
+	}
+	const std::size_t index = findAnimation(name);
+	if(index == animationCount())
+	{
+		throw std::invalid_argument("Transition::fromName(): unknown animation " + name);
+	}
+	return std::make_unique<Transition>(createAnimation(index), image1, image2, frames, seconds);
+}
+
+unsigned Transition::getFrameCount() const
+{
+	return m_frames;
+}
+
+const sf::Vector2u &Transition::getSize() const
+{
+	return m_size;
+}
+
+std::size_t Transition::getFrameBytes() const
+{
+	return static_cast<std::size_t>(m_size.x) * m_size.y * 4u;
+}
+
+float Transition::timeOf(const unsigned index) const
+{
+	if(index >= m_frames)
+	{
+		throw std::out_of_range("Transition::timeOf(): there is no frame " + std::to_string(index) + " of " + std::to_string(m_frames));
+	}
+	if(m_frames == 1u)
+	{
+		return 0.f;
+	}
+	return this->getAnimation().getAnimationLength() * static_cast<float>(index) / static_cast<float>(m_frames - 1u);
+}
+
+const Animation &Transition::getAnimation() const
+{
+	if(m_objectAnimation)
+	{
+		return *m_objectAnimation;
+	}
+	return *m_pixelAnimation;
+}
+
+Animation &Transition::getAnimation()
+{
+	if(m_objectAnimation)
+	{
+		return *m_objectAnimation;
+	}
+	return *m_pixelAnimation;
+}
+
+void Transition::renderFrame(const unsigned index, std::uint8_t *output) const
+{
+	const float time = this->timeOf(index);
+	const std::size_t bytes = this->getFrameBytes();
+	for(std::size_t i = 0; i < bytes; i += 4u)
+	{
+		output[i] = 0u;
+		output[i + 1u] = 0u;
+		output[i + 2u] = 0u;
+		output[i + 3u] = 255u;
+	}
+
+	if(m_objectAnimation)
+	{
+		//the first corner of both images is their origin, so its depth is the one of the translation
+		const em::Matrix4f transform1 = m_objectAnimation->getImage1Frame(time);
+		const em::Matrix4f transform2 = m_objectAnimation->getImage2Frame(time);
+		if(transform1[2][3] > transform2[2][3])
+		{
+			drawLayer(m_image1.getPixelsPtr(), m_size, transform1, output);
+			drawLayer(m_image2.getPixelsPtr(), m_size, transform2, output);
+		}
+		else
+		{
+			drawLayer(m_image2.getPixelsPtr(), m_size, transform2, output);
+			drawLayer(m_image1.getPixelsPtr(), m_size, transform1, output);
+		}
+	}
+	else
+	{
+		std::vector<unsigned char> frame1, frame2;
+		m_pixelAnimation->writeFrames(time, frame1, frame2);
+		const bool moved = m_pixelAnimation->hasTransforms();
+		drawLayer(frame2.data(), m_size, moved ? m_pixelAnimation->getImage2Transform(time) : em::Matrix4f(), output);
+		drawLayer(frame1.data(), m_size, moved ? m_pixelAnimation->getImage1Transform(time) : em::Matrix4f(), output);
+	}
+}
+
+void Transition::renderFrame(const unsigned index, sf::RenderTarget &target) const
+{
+	const float time = this->timeOf(index);
+	const sf::Vector2f size(m_size);
+
+	if(m_objectAnimation)
+	{
+		this->createTextures();
+		AnimatedImage image1(sf::Vector3f(), m_stored1, size);
+		AnimatedImage image2(sf::Vector3f(), m_stored2, size);
+		image1.transformUpdate(m_objectAnimation->getImage1Frame(time));
+		image2.transformUpdate(m_objectAnimation->getImage2Frame(time));
+		const bool starting_deeper = image1.getVertexDepth(0) > image2.getVertexDepth(0);
+		AnimatedImage &first = starting_deeper ? image1 : image2;
+		AnimatedImage &second = starting_deeper ? image2 : image1;
+		first.render(&target);
+		second.render(&target);
+		return;
+	}
+
+	std::vector<unsigned char> frame1, frame2;
+	m_pixelAnimation->writeFrames(time, frame1, frame2);
+	auto upload = [this, &size](const std::vector<unsigned char> &frame)
+	{
+		auto texture = std::make_unique<sf::Texture>();
+		if(!texture->create(m_size.x, m_size.y))
+		{
+			throw std::runtime_error("Transition::renderFrame(): the texture of a frame could not be created");
+		}
+		auto image = std::make_unique<AnimatedImage>(sf::Vector3f(), std::move(texture), size);
+		image->pixelUpdate(frame);
+		return image;
+	};
+	const std::unique_ptr<AnimatedImage> image1 = upload(frame1);
+	const std::unique_ptr<AnimatedImage> image2 = upload(frame2);
+	if(m_pixelAnimation->hasTransforms())
+	{
+		image1->transformUpdate(m_pixelAnimation->getImage1Transform(time));
+		image2->transformUpdate(m_pixelAnimation->getImage2Transform(time));
+	}
+	image2->render(&target);
+	image1->render(&target);
+}
+
+//private member functions
+Transition::Transition(const sf::Image &image1, const sf::Image &image2, const unsigned frames)
+:
+m_objectAnimation(nullptr),
+m_pixelAnimation(nullptr),
+m_image1(image1),
+m_image2(image2),
+m_size(image1.getSize()),
+m_frames(frames),
+m_texturesCreated(),
+m_stored1(nullptr),
+m_stored2(nullptr)
+{
+	if(m_size.x == 0u || m_size.y == 0u || image2.getSize() != m_size)
+	{
+		throw std::invalid_argument("Transition::Transition(): the images have to be of the same size and not empty");
+	}
+	if(frames == 0u)
+	{
+		throw std::invalid_argument("Transition::Transition(): a transition needs at least 1 frame");
+	}
+}
+
+void Transition::setAnimation(std::unique_ptr<ObjectAnimation> animation, const float &seconds)
+{
+	if(!animation)
+	{
+		throw std::invalid_argument("Transition::setAnimation(): no animation given");
+	}
+	m_objectAnimation = std::move(animation);
+	m_objectAnimation->setAnimationLength(seconds);
+}
+
+void Transition::setAnimation(std::unique_ptr<PixelAnimation> animation, const float &seconds)
+{
+	if(!animation)
+	{
+		throw std::invalid_argument("Transition::setAnimation(): no animation given");
+	}
+	m_pixelAnimation = std::move(animation);
+	m_pixelAnimation->setAnimationLength(seconds);
+	m_pixelAnimation->setPixels1(PixelAnimation::toPixels(m_image1));
+	m_pixelAnimation->setPixels2(PixelAnimation::toPixels(m_image2));
+}
+
+void Transition::createTextures() const
+{
+	std::call_once(m_texturesCreated, [this]()
+	{
+		auto store = [](const sf::Image &pixels)
+		{
+			auto image = std::make_shared<StoredImage>();
+			image->pixels = pixels;
+			if(!image->texture.loadFromImage(image->pixels))
+			{
+				throw std::runtime_error("Transition::renderFrame(): an image could not be uploaded to a texture");
+			}
+			image->memory.setCpu(MemoryCharge::bytesOf(image->pixels.getSize()));
+			image->memory.setGpu(MemoryCharge::bytesOf(image->texture.getSize()));
+			return ImageStore::Handle(std::move(image));
+		};
+		m_stored1 = store(m_image1);
+		m_stored2 = store(m_image2);
+	});
+}
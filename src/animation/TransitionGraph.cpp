@@ -0,0 +1,242 @@
+#include "../../include/animation/TransitionGraph.h"
+
+namespace
+{
+	std::vector<std::string> split(const std::string &text, const char separator)
+	{
+		std::vector<std::string> parts;
+		std::size_t start = 0;
+		while(start <= text.size())
+		{
+			const std::size_t end = std::min(text.find(separator, start), text.size());
+			parts.push_back(text.substr(start, end - start));
+			start = end + 1u;
+		}
+		return parts;
+	}
+}//anonymous namespace
+
+TransitionGraph::TransitionGraph()
+:
+TransitionGraph(0.f)
+{ }
+
+TransitionGraph::TransitionGraph(const float &animation_length)
+:
+PixelAnimation(animation_length, 1.f, std::vector<unsigned char>(), std::vector<unsigned char>()),
+m_objectStages(),
+m_pixelStages()
+{ }
+
+void TransitionGraph::addStage(std::unique_ptr<ObjectAnimation> stage, const float &begin, const float &end)
+{
+	TransitionGraph::checkPart(begin, end);
+	this->fitLength(*stage, begin, end);
+	m_objectStages.push_back(Stage<ObjectAnimation>{std::move(stage), begin, end});
+}
+
+void TransitionGraph::addStage(std::unique_ptr<PixelAnimation> stage, const float &begin, const float &end)
+{
+	TransitionGraph::checkPart(begin, end);
+	if(!stage->frameOperation1(0.f) || !stage->frameOperation2(0.f))
+	{
+		throw std::invalid_argument("TransitionGraph::addStage(): the animation computes frames only of its own pixels");
+	}
+	this->fitLength(*stage, begin, end);
+	stage->setPremultiplied(m_premultiplied);
+	stage->setPixels1(m_pixels1);
+	stage->setPixels2(m_pixels2);
+	m_pixelStages.push_back(Stage<PixelAnimation>{std::move(stage), begin, end});
+}
+
+void TransitionGraph::addStage(AnyAnimation stage, const float &begin, const float &end)
+{
+	std::visit([this, &begin, &end](auto &&animation)
+	{
+		this->addStage(std::move(animation), begin, end);
+	}, releaseAnimation(std::move(stage)));
+}
+
+std::unique_ptr<TransitionGraph> TransitionGraph::parse(const std::string &description, const std::function<void(AnyAnimation &)> &setup)
+{
+	auto graph = std::make_unique<TransitionGraph>();
+	const std::vector<std::string> groups = split(description, '>');
+	for(std::size_t group = 0; group < groups.size(); group++)
+	{
+		const float begin = static_cast<float>(group) / groups.size();
+		const float end = static_cast<float>(group + 1u) / groups.size();
+		for(const std::string &name : split(groups[group], '+'))
+		{
+			const std::size_t index = findAnimation(name);
+			if(index == animationCount())
+			{
+				throw std::invalid_argument("TransitionGraph::parse(): unknown animation \"" + name + "\" in " + description);
+			}
+			AnyAnimation animation = createAnimation(index);
+			if(setup)
+			{
+				setup(animation);
+			}
+			graph->addStage(std::move(animation), begin, end);
+		}
+	}
+	return graph;
+}
+
+bool TransitionGraph::isDescription(const std::string &name)
+{
+	return name.find_first_of("+>") != std::string::npos;
+}
+
+std::size_t TransitionGraph::getStageCount() const
+{
+	return m_objectStages.size() + m_pixelStages.size();
+}
+
+void TransitionGraph::setAnimationLength(const float &seconds)
+{
+	PixelAnimation::setAnimationLength(seconds);
+	for(Stage<ObjectAnimation> &stage : m_objectStages)
+	{
+		this->fitLength(*stage.animation, stage.begin, stage.end);
+	}
+	for(Stage<PixelAnimation> &stage : m_pixelStages)
+	{
+		this->fitLength(*stage.animation, stage.begin, stage.end);
+	}
+}
+
+void TransitionGraph::writeTexture1Frame(const float &current_time, std::vector<unsigned char> &output) const
+{
+	this->writeFrame(m_pixels1, this->chain(current_time, true), output);
+}
+
+void TransitionGraph::writeTexture2Frame(const float &current_time, std::vector<unsigned char> &output) const
+{
+	this->writeFrame(m_pixels2, this->chain(current_time, false), output);
+}
+
+PixelOperation TransitionGraph::frameOperation1(const float &current_time) const
+{
+	return this->chain(current_time, true);
+}
+
+PixelOperation TransitionGraph::frameOperation2(const float &current_time) const
+{
+	return this->chain(current_time, false);
+}
+
+bool TransitionGraph::hasTransforms() const
+{
+	return !m_objectStages.empty();
+}
+
+em::Matrix4f TransitionGraph::getImage1Transform(const float &current_time) const
+{
+	em::Matrix4f transform;
+	for(const Stage<ObjectAnimation> &stage : m_objectStages)
+	{
+		transform = transform * stage.animation->getImage1Frame(this->stageTime(*stage.animation, stage.begin, stage.end, current_time));
+	}
+	return transform;
+}
+
+em::Matrix4f TransitionGraph::getImage2Transform(const float &current_time) const
+{
+	em::Matrix4f transform;
+	for(const Stage<ObjectAnimation> &stage : m_objectStages)
+	{
+		transform = transform * stage.animation->getImage2Frame(this->stageTime(*stage.animation, stage.begin, stage.end, current_time));
+	}
+	return transform;
+}
+
+std::uint64_t TransitionGraph::getParameterHash() const
+{
+	ContentHash hash(PixelAnimation::getParameterHash());
+	for(const Stage<ObjectAnimation> &stage : m_objectStages)
+	{
+		hash.add(stage.animation->getParameterHash()).add(stage.begin).add(stage.end);
+	}
+	for(const Stage<PixelAnimation> &stage : m_pixelStages)
+	{
+		hash.add(stage.animation->getParameterHash()).add(stage.begin).add(stage.end);
+	}
+	return hash.getValue();
+}
+
+//protected member functions
+void TransitionGraph::pixelsChanged(const unsigned changed)
+{
+	for(Stage<PixelAnimation> &stage : m_pixelStages)
+	{
+		stage.animation->setPremultiplied(m_premultiplied);
+		if(changed & PixelAnimation::PIXELS1)
+		{
+			stage.animation->setPixels1(m_pixels1);
+		}
+		if(changed & PixelAnimation::PIXELS2)
+		{
+			stage.animation->setPixels2(m_pixels2);
+		}
+	}
+}
+
+//private member functions
+void TransitionGraph::checkPart(const float &begin, const float &end)
+{
+	if(!(begin >= 0.f && end <= 1.f && begin < end))
+	{
+		throw std::invalid_argument("TransitionGraph::addStage(): the part of the stage has to lie within 0 to 1 and must not be empty");
+	}
+}
+
+void TransitionGraph::fitLength(Animation &stage, const float &begin, const float &end) const
+{
+	stage.setAnimationLength((end - begin) * m_totalTime);
+}
+
+float TransitionGraph::stageTime(const Animation &stage, const float &begin, const float &end, const float &current_time) const
+{
+	const float progress = std::clamp((this->toProgress(current_time) - begin) / (end - begin), 0.f, 1.f);
+	return progress * stage.getAnimationLength();
+}
+
+PixelOperation TransitionGraph::chain(const float &current_time, const bool first) const
+{
+	std::vector<PixelOperation> operations;
+	operations.reserve(m_pixelStages.size());
+	for(const Stage<PixelAnimation> &stage : m_pixelStages)
+	{
+		const float time = this->stageTime(*stage.animation, stage.begin, stage.end, current_time);
+		operations.push_back(first ? stage.animation->frameOperation1(time) : stage.animation->frameOperation2(time));
+	}
+	if(operations.empty())
+	{
+		return PixelAnimation::copyOperation();
+	}
+	if(operations.size() == 1u)
+	{
+		return operations.front();
+	}
+	return [operations](const std::uint8_t *src, std::uint8_t *dst, std::size_t first_pixel, std::size_t pixels)
+	{
+		//the first stage reads the image, the following ones work in place on the range it wrote
+		operations.front()(src, dst, first_pixel, pixels);
+		for(std::size_t i = 1; i < operations.size(); i++)
+		{
+			operations[i](dst, dst, first_pixel, pixels);
+		}
+	};
+}
+
+void TransitionGraph::writeFrame(const std::vector<unsigned char> &pixels, const PixelOperation &operation, std::vector<unsigned char> &output) const
+{
+	output.resize(pixels.size());
+	const std::uint8_t *src = pixels.data();
+	std::uint8_t *dst = output.data();
+	forEachPixelRange(pixels.size() / 4u, [src, dst, &operation](std::size_t begin, std::size_t end)
+	{
+		operation(src + begin * 4u, dst + begin * 4u, begin, end - begin);
+	});
+}
@@ -0,0 +1,180 @@
+#include "../../include/export/FfmpegSink.h"
+
+#include <iostream>
+#include <sstream>
+
+#if defined(_WIN32)
+	#define BCG_POPEN _popen
+	#define BCG_PCLOSE _pclose
+	#define BCG_NULL_DEVICE "NUL"
+#else
+	#include <signal.h>
+	#include <pthread.h>
+	#define BCG_POPEN popen
+	#define BCG_PCLOSE pclose
+	#define BCG_NULL_DEVICE "/dev/null"
+#endif
+
+namespace
+{
+	/**
+	 * Quotes an argument, so the shell passes it to ffmpeg as it is
+	 */
+	std::string quoteArgument(const std::string &argument)
+	{
+#if defined(_WIN32)
+		//cmd expands variables even inside quotes, such arguments cannot be passed safely
+		if(argument.find_first_of("\"%") != std::string::npos)
+		{
+			throw std::invalid_argument("FfmpegSink: quotes and percent signs cannot be passed to ffmpeg: " + argument);
+		}
+		return "\"" + argument + "\"";
+#else
+		std::string quoted = "'";
+		for(const char c : argument)
+		{
+			quoted += c == '\'' ? std::string("'\\''") : std::string(1u, c);
+		}
+		return quoted + "'";
+#endif
+	}
+
+	/**
+	 * Quotes every argument of a list separated by spaces
+	 */
+	std::string quoteArguments(const std::string &arguments)
+	{
+		std::istringstream words(arguments);
+		std::string word, quoted;
+		while(words >> word)
+		{
+			quoted += " " + quoteArgument(word);
+		}
+		return quoted;
+	}
+
+#if !defined(_WIN32)
+	/**
+	 * Holds SIGPIPE back on the calling thread while it writes into the pipe
+	 *
+	 * A crashed ffmpeg makes the writes fail with an error instead of terminating
+	 *   the process, the rest of the process keeps its own handling of the signal.
+	 */
+	class PipeSignalBlock
+	{
+	public:
+		PipeSignalBlock()
+		{
+			sigemptyset(&m_signal);
+			sigaddset(&m_signal, SIGPIPE);
+			sigset_t pending;
+			sigpending(&pending);
+			m_wasPending = sigismember(&pending, SIGPIPE) == 1;
+			pthread_sigmask(SIG_BLOCK, &m_signal, &m_previous);
+		}
+
+		~PipeSignalBlock()
+		{
+			//a signal raised by the writes is taken, so it is not delivered once unblocked
+			sigset_t pending;
+			sigpending(&pending);
+			if(!m_wasPending && sigismember(&pending, SIGPIPE) == 1)
+			{
+				int taken = 0;
+				sigwait(&m_signal, &taken);
+			}
+			pthread_sigmask(SIG_SETMASK, &m_previous, nullptr);
+		}
+
+	private:
+		sigset_t m_signal;
+		sigset_t m_previous;
+		bool m_wasPending;
+	};
+#endif
+}//anonymous namespace
+
+FfmpegSink::FfmpegSink(const std::string &path, const float &fps, const std::string &codec)
+:
+m_path(path),
+m_fps(fps > 0.f ? fps : 25.f),
+m_codec(codec),
+m_size(),
+m_pipe(nullptr)
+{ }
+
+FfmpegSink::~FfmpegSink()
+{
+	try
+	{
+		this->close();
+	}
+	catch(const std::exception &error)
+	{
+		std::cerr << error.what() << std::endl;
+	}
+}
+
+bool FfmpegSink::isAvailable()
+{
+	return std::system("ffmpeg -version > " BCG_NULL_DEVICE " 2>&1") == 0;
+}
+
+void FfmpegSink::write(ExportFrame frame)
+{
+	const sf::Vector2u size = frame.size;
+	if(!m_pipe)
+	{
+		this->open(size);
+	}
+	else if(size != m_size)
+	{
+		throw std::runtime_error("FfmpegSink::write(): frames differ in size");
+	}
+
+	const std::size_t bytes = static_cast<std::size_t>(size.x) * size.y * 4u;
+#if !defined(_WIN32)
+	PipeSignalBlock block;
+#endif
+	if(std::fwrite(frame.data(), 1u, bytes, m_pipe) != bytes)
+	{
+		throw std::runtime_error("FfmpegSink::write(): ffmpeg stopped accepting frames");
+	}
+}
+
+void FfmpegSink::close()
+{
+	if(!m_pipe)
+	{
+		return;
+	}
+#if !defined(_WIN32)
+	PipeSignalBlock block;//the rest of the frames is flushed on closing
+#endif
+	const int status = BCG_PCLOSE(m_pipe);
+	m_pipe = nullptr;
+	if(status != 0)
+	{
+		throw std::runtime_error("FfmpegSink::close(): ffmpeg failed to encode " + m_path);
+	}
+}
+
+//private member functions
+void FfmpegSink::open(const sf::Vector2u &size)
+{
+	m_size = size;
+	//every argument is quoted, the file protocol keeps ffmpeg from reading the path as an option or another protocol
+	const std::string command = "ffmpeg -loglevel error -y -f rawvideo -pix_fmt rgba"
+		" -s " + std::to_string(size.x) + "x" + std::to_string(size.y)
+		+ " -r " + std::to_string(m_fps)
+		+ " -i -" + quoteArguments(m_codec) + " " + quoteArgument("file:" + m_path);
+#if defined(_WIN32)
+	m_pipe = BCG_POPEN(command.c_str(), "wb");
+#else
+	m_pipe = BCG_POPEN(command.c_str(), "w");
+#endif
+	if(!m_pipe)
+	{
+		throw std::runtime_error("FfmpegSink::open(): cannot start ffmpeg");
+	}
+}
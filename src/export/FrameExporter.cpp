@@ -0,0 +1,130 @@
+#include "../../include/export/FrameExporter.h"
+#include "../../include/export/ImageEncoder.h"
+
+#include <iostream>
+
+FrameExporter::FrameExporter(const unsigned threads, const std::size_t capacity)
+:
+m_queue(),
+m_capacity(std::max<std::size_t>(capacity, 1u)),
+m_workers(),
+m_closing(false),
+m_saved(0u),
+m_error()
+{
+	unsigned count = threads;
+	if(count == 0u)
+	{
+		const unsigned cores = std::thread::hardware_concurrency();
+		count = cores > 1u ? cores - 1u : 1u;//the rendering thread keeps one core
+	}
+	for(unsigned i = 0; i < count; i++)
+	{
+		m_workers.emplace_back(&FrameExporter::work, this);
+	}
+}
+
+FrameExporter::~FrameExporter()
+{
+	try
+	{
+		this->finish();
+	}
+	catch(const std::exception &error)
+	{
+		std::cerr << error.what() << std::endl;
+	}
+}
+
+void FrameExporter::push(ExportFrame frame, const std::string &path)
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	if(m_closing)
+	{
+		throw std::runtime_error("FrameExporter::push(): exporter is already finished");
+	}
+	m_notFull.wait(lock, [this]() { return m_queue.size() < m_capacity; });
+	m_queue.push_back(Job{std::move(frame), path});
+	m_queue.back().memory.setCpu(MemoryCharge::bytesOf(m_queue.back().frame.size));
+	lock.unlock();
+	m_notEmpty.notify_one();
+}
+
+void FrameExporter::finish()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_closing = true;
+	}
+	m_notEmpty.notify_all();
+	for(std::thread &worker : m_workers)
+	{
+		if(worker.joinable())
+		{
+			worker.join();
+		}
+	}
+	m_workers.clear();
+
+	if(!m_error.empty())
+	{
+		std::string error;
+		std::swap(error, m_error);
+		throw std::runtime_error("FrameExporter::finish(): cannot save" + error);
+	}
+}
+
+std::size_t FrameExporter::getSavedCount() const
+{
+	return m_saved.load();
+}
+
+//private member functions
+void FrameExporter::work()
+{
+	while(true)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_notEmpty.wait(lock, [this]() { return m_closing || !m_queue.empty(); });
+		if(m_queue.empty())//closing and nothing left to save
+		{
+			return;
+		}
+		Job job = std::move(m_queue.front());
+		m_queue.pop_front();
+		lock.unlock();
+		m_notFull.notify_one();
+
+		bool saved = false;
+		if(ImageEncoder::handles(job.path))
+		{
+			//encoded straight from the buffer, which goes back to the renderer once the file is written
+			try
+			{
+				ImageEncoder::save(job.frame.data(), job.frame.size, job.path);
+				saved = true;
+			}
+			catch(const std::exception &error)
+			{
+				std::cerr << error.what() << std::endl;
+			}
+			job.frame.pixels.reset();
+		}
+		else
+		{
+			sf::Image image;
+			image.create(job.frame.size.x, job.frame.size.y, job.frame.data());
+			job.frame.pixels.reset();//the buffer goes back to the renderer before the file is encoded
+			saved = image.saveToFile(job.path);
+		}
+		if(saved)
+		{
+			m_saved++;
+		}
+		else
+		{
+			std::lock_guard<std::mutex> error_lock(m_mutex);
+			m_error += " " + job.path;
+		}
+	}
+}
@@ -0,0 +1,278 @@
+#include "../../include/export/GifSink.h"
+
+#include <iostream>
+
+namespace
+{
+	const unsigned RED_LEVELS = 6u;
+	const unsigned GREEN_LEVELS = 7u;
+	const unsigned BLUE_LEVELS = 6u;
+
+	const unsigned MIN_CODE_SIZE = 8u;
+	const unsigned CLEAR_CODE = 1u << MIN_CODE_SIZE;
+	const unsigned END_CODE = CLEAR_CODE + 1u;
+	const unsigned MAX_CODE = 4095u;
+
+	const int BAYER[4][4] = {
+		{  0,  8,  2, 10 },
+		{ 12,  4, 14,  6 },
+		{  3, 11,  1,  9 },
+		{ 15,  7, 13,  5 } };
+
+	/**
+	 * Packs codes of variable length into the 255 byte sub-blocks of GIF image data
+	 */
+	class CodeWriter
+	{
+	public:
+		explicit CodeWriter(std::ofstream &file) : m_file(file), m_bits(0u), m_bitCount(0u), m_block() {}
+
+		void write(const unsigned code, const unsigned size)
+		{
+			m_bits |= static_cast<std::uint32_t>(code) << m_bitCount;
+			m_bitCount += size;
+			while(m_bitCount >= 8u)
+			{
+				this->put(static_cast<std::uint8_t>(m_bits & 0xFFu));
+				m_bits >>= 8;
+				m_bitCount -= 8u;
+			}
+		}
+
+		void finish()
+		{
+			if(m_bitCount > 0u)
+			{
+				this->put(static_cast<std::uint8_t>(m_bits & 0xFFu));
+				m_bits = 0u;
+				m_bitCount = 0u;
+			}
+			this->flush();
+			m_file.put(0);//block terminator
+		}
+
+	private:
+		void put(const std::uint8_t byte)
+		{
+			m_block.push_back(byte);
+			if(m_block.size() == 255u)
+			{
+				this->flush();
+			}
+		}
+
+		void flush()
+		{
+			if(!m_block.empty())
+			{
+				m_file.put(static_cast<char>(m_block.size()));
+				m_file.write(reinterpret_cast<const char*>(m_block.data()), m_block.size());
+				m_block.clear();
+			}
+		}
+
+		std::ofstream &m_file;
+		std::uint32_t m_bits;
+		unsigned m_bitCount;
+		std::vector<std::uint8_t> m_block;
+	};
+}//anonymous namespace
+
+GifSink::GifSink(const std::string &path, const float &fps)
+:
+m_path(path),
+m_file(path, std::ios::binary),
+m_size(),
+m_delay(fps > 0.f ? 100.f / fps : 4.f),
+m_delayError(0.f),
+m_indices(),
+m_dictionary((MAX_CODE + 1u) * 256u, 0u),
+m_started(false),
+m_memory(MemorySubsystem::EXPORT)
+{
+	if(!m_file)
+	{
+		throw std::runtime_error("GifSink::GifSink(): cannot open " + path);
+	}
+	m_memory.setCpu(m_dictionary.capacity() * sizeof(std::uint16_t));
+}
+
+GifSink::~GifSink()
+{
+	if(m_file.is_open())
+	{
+		try
+		{
+			this->close();
+		}
+		catch(const std::exception &error)
+		{
+			std::cerr << error.what() << std::endl;
+		}
+	}
+}
+
+void GifSink::write(ExportFrame frame)
+{
+	const sf::Vector2u size = frame.size;
+	if(!m_started)
+	{
+		this->writeHeader(size);
+	}
+	else if(size != m_size)
+	{
+		throw std::runtime_error("GifSink::write(): frames differ in size");
+	}
+
+	//delay of the frame, rounding error is carried over to keep the total length
+	const float exact = m_delay + m_delayError;
+	const unsigned delay = static_cast<unsigned>(std::max(1.f, std::round(exact)));
+	m_delayError = exact - static_cast<float>(delay);
+
+	m_file.put(0x21).put(static_cast<char>(0xF9)).put(4).put(0);//graphic control extension, no transparency
+	this->writeShort(delay);
+	m_file.put(0).put(0);
+
+	m_file.put(0x2C);//image descriptor covering the whole screen, global palette
+	this->writeShort(0u);
+	this->writeShort(0u);
+	this->writeShort(m_size.x);
+	this->writeShort(m_size.y);
+	m_file.put(0);
+
+	this->quantize(frame);
+	this->writeLzw();
+
+	if(!m_file)
+	{
+		throw std::runtime_error("GifSink::write(): cannot write to " + m_path);
+	}
+}
+
+void GifSink::close()
+{
+	if(!m_file.is_open())
+	{
+		return;
+	}
+	if(m_started)
+	{
+		m_file.put(0x3B);//trailer
+	}
+	m_file.close();
+	if(!m_file)
+	{
+		throw std::runtime_error("GifSink::close(): cannot write to " + m_path);
+	}
+}
+
+//private member functions
+void GifSink::writeHeader(const sf::Vector2u &size)
+{
+	if(size.x == 0u || size.y == 0u || size.x > 0xFFFFu || size.y > 0xFFFFu)
+	{
+		throw std::runtime_error("GifSink::writeHeader(): unsupported frame size");
+	}
+	m_size = size;
+	m_started = true;
+
+	m_file.write("GIF89a", 6);
+	this->writeShort(m_size.x);
+	this->writeShort(m_size.y);
+	m_file.put(static_cast<char>(0xF7));//global palette of 256 colors, 8 bits per channel
+	m_file.put(0).put(0);
+
+	for(unsigned i = 0; i < 256u; i++)
+	{
+		if(i < RED_LEVELS * GREEN_LEVELS * BLUE_LEVELS)
+		{
+			m_file.put(static_cast<char>((i / (GREEN_LEVELS * BLUE_LEVELS)) * 255u / (RED_LEVELS - 1u)));
+			m_file.put(static_cast<char>((i / BLUE_LEVELS % GREEN_LEVELS) * 255u / (GREEN_LEVELS - 1u)));
+			m_file.put(static_cast<char>((i % BLUE_LEVELS) * 255u / (BLUE_LEVELS - 1u)));
+		}
+		else//unused entries
+		{
+			m_file.put(0).put(0).put(0);
+		}
+	}
+
+	m_file.put(0x21).put(static_cast<char>(0xFF)).put(11);//application extension looping forever
+	m_file.write("NETSCAPE2.0", 11);
+	m_file.put(3).put(1);
+	this->writeShort(0u);
+	m_file.put(0);
+}
+
+void GifSink::quantize(const ExportFrame &frame)
+{
+	const std::uint8_t *pixels = frame.data();
+	m_indices.resize(static_cast<std::size_t>(m_size.x) * m_size.y);
+	m_memory.setCpu(m_dictionary.capacity() * sizeof(std::uint16_t) + m_indices.capacity());
+
+	auto level = [](const int value, const int dither, const unsigned levels)
+	{
+		//dither spreads value by one step of the level, centered around 0
+		const int step = 255 / static_cast<int>(levels - 1u);
+		const int shifted = value + (dither - 8) * step / 16;
+		return static_cast<unsigned>(std::clamp((shifted * static_cast<int>(levels - 1u) + 127) / 255, 0, static_cast<int>(levels - 1u)));
+	};
+
+	for(unsigned y = 0; y < m_size.y; y++)
+	{
+		for(unsigned x = 0; x < m_size.x; x++)
+		{
+			const std::size_t i = static_cast<std::size_t>(y) * m_size.x + x;
+			const int dither = BAYER[y & 3u][x & 3u];
+			const unsigned r = level(pixels[i*4], dither, RED_LEVELS);
+			const unsigned g = level(pixels[i*4+1], dither, GREEN_LEVELS);
+			const unsigned b = level(pixels[i*4+2], dither, BLUE_LEVELS);
+			m_indices[i] = static_cast<std::uint8_t>((r * GREEN_LEVELS + g) * BLUE_LEVELS + b);
+		}
+	}
+}
+
+void GifSink::writeLzw()
+{
+	m_file.put(static_cast<char>(MIN_CODE_SIZE));
+	CodeWriter writer(m_file);
+
+	std::fill(m_dictionary.begin(), m_dictionary.end(), 0u);
+	unsigned code_size = MIN_CODE_SIZE + 1u;
+	unsigned last_code = END_CODE;
+	writer.write(CLEAR_CODE, code_size);
+
+	unsigned current = m_indices[0];
+	for(std::size_t i = 1; i < m_indices.size(); i++)
+	{
+		const std::size_t key = static_cast<std::size_t>(current) * 256u + m_indices[i];
+		if(m_dictionary[key] != 0u)//the run continues
+		{
+			current = m_dictionary[key];
+			continue;
+		}
+
+		writer.write(current, code_size);
+		m_dictionary[key] = static_cast<std::uint16_t>(++last_code);
+		if(last_code >= (1u << code_size))
+		{
+			code_size++;
+		}
+		if(last_code == MAX_CODE)//dictionary is full, start over
+		{
+			writer.write(CLEAR_CODE, code_size);
+			std::fill(m_dictionary.begin(), m_dictionary.end(), 0u);
+			code_size = MIN_CODE_SIZE + 1u;
+			last_code = END_CODE;
+		}
+		current = m_indices[i];
+	}
+	writer.write(current, code_size);
+	writer.write(END_CODE, code_size);
+	writer.finish();
+}
+
+void GifSink::writeShort(const unsigned value)
+{
+	m_file.put(static_cast<char>(value & 0xFFu));
+	m_file.put(static_cast<char>((value >> 8) & 0xFFu));
+}
@@ -0,0 +1,724 @@
+#include "../../include/export/ImageEncoder.h"
+
+#include <cstring>
+#include <queue>
+#include <fstream>
+
+namespace
+{
+	/**
+	 * Runs the body for every band of rows, on the threads of the pool when there are several bands
+	 */
+	std::size_t forEachBand(const unsigned height, const std::function<void(std::size_t, unsigned, unsigned)> &body)
+	{
+		const std::size_t bands = (height + ImageEncoder::ROWS_PER_TASK - 1u) / ImageEncoder::ROWS_PER_TASK;
+		ThreadPool::shared().parallelFor(bands, 1u, [&body, height](std::size_t begin, std::size_t end)
+		{
+			for(std::size_t band = begin; band < end; band++)
+			{
+				const unsigned first = static_cast<unsigned>(band) * ImageEncoder::ROWS_PER_TASK;
+				body(band, first, std::min(height, first + ImageEncoder::ROWS_PER_TASK));
+			}
+		});
+		return bands;
+	}
+
+	void appendBig32(std::vector<std::uint8_t> &output, const std::uint32_t value)
+	{
+		output.push_back(static_cast<std::uint8_t>(value >> 24u));
+		output.push_back(static_cast<std::uint8_t>(value >> 16u));
+		output.push_back(static_cast<std::uint8_t>(value >> 8u));
+		output.push_back(static_cast<std::uint8_t>(value));
+	}
+
+	std::vector<std::uint8_t> joinBands(const std::vector<std::uint8_t> &header, const std::vector<std::vector<std::uint8_t>> &bands, const std::vector<std::uint8_t> &trailer)
+	{
+		std::size_t bytes = header.size() + trailer.size();
+		for(const std::vector<std::uint8_t> &band : bands)
+		{
+			bytes += band.size();
+		}
+		std::vector<std::uint8_t> output;
+		output.reserve(bytes);
+		output.insert(output.end(), header.begin(), header.end());
+		for(const std::vector<std::uint8_t> &band : bands)
+		{
+			output.insert(output.end(), band.begin(), band.end());
+		}
+		output.insert(output.end(), trailer.begin(), trailer.end());
+		return output;
+	}
+
+	/// PNG ///
+
+	const std::array<std::uint32_t, 256> CRC_TABLE = []()
+	{
+		std::array<std::uint32_t, 256> table{};
+		for(std::uint32_t i = 0; i < 256u; i++)
+		{
+			std::uint32_t crc = i;
+			for(unsigned bit = 0; bit < 8u; bit++)
+			{
+				crc = (crc & 1u) ? 0xEDB88320u ^ (crc >> 1u) : crc >> 1u;
+			}
+			table[i] = crc;
+		}
+		return table;
+	}();
+
+	std::uint32_t crc32(const std::uint8_t *data, const std::size_t bytes, const std::uint32_t previous = 0u)
+	{
+		std::uint32_t crc = ~previous;
+		for(std::size_t i = 0; i < bytes; i++)
+		{
+			crc = CRC_TABLE[(crc ^ data[i]) & 0xFFu] ^ (crc >> 8u);
+		}
+		return ~crc;
+	}
+
+	void appendPngChunk(std::vector<std::uint8_t> &output, const char *type, const std::uint8_t *data, const std::size_t bytes)
+	{
+		appendBig32(output, static_cast<std::uint32_t>(bytes));
+		const std::size_t start = output.size();
+		output.insert(output.end(), type, type + 4);
+		output.insert(output.end(), data, data + bytes);
+		appendBig32(output, crc32(output.data() + start, bytes + 4u));
+	}
+
+	constexpr std::uint32_t ADLER_BASE = 65521u;
+
+	std::uint32_t adler32(const std::uint8_t *data, const std::size_t bytes)
+	{
+		std::uint32_t low = 1u, high = 0u;
+		std::size_t i = 0;
+		while(i < bytes)
+		{
+			//the sums cannot overflow within 5552 bytes
+			const std::size_t end = std::min(bytes, i + 5552u);
+			for(; i < end; i++)
+			{
+				low += data[i];
+				high += low;
+			}
+			low %= ADLER_BASE;
+			high %= ADLER_BASE;
+		}
+		return (high << 16u) | low;
+	}
+
+	std::uint32_t combineAdler32(const std::uint32_t first, const std::uint32_t second, const std::size_t second_bytes)
+	{
+		const std::uint32_t remainder = static_cast<std::uint32_t>(second_bytes % ADLER_BASE);
+		std::uint32_t low = first & 0xFFFFu;
+		std::uint32_t high = static_cast<std::uint32_t>((static_cast<std::uint64_t>(remainder) * low) % ADLER_BASE);
+		low += (second & 0xFFFFu) + ADLER_BASE - 1u;
+		high += (first >> 16u) + (second >> 16u) + ADLER_BASE - remainder;
+		low = low >= ADLER_BASE ? low - ADLER_BASE : low;
+		low = low >= ADLER_BASE ? low - ADLER_BASE : low;
+		high = high >= 2u * ADLER_BASE ? high - 2u * ADLER_BASE : high;
+		high = high >= ADLER_BASE ? high - ADLER_BASE : high;
+		return (high << 16u) | low;
+	}
+
+	/**
+	 * Paeth filter of a row, the row above is nullptr for the first row
+	 */
+	void filterRow(const std::uint8_t *row, const std::uint8_t *above, const std::size_t stride, std::uint8_t *output)
+	{
+		output[0] = 4u;
+		for(std::size_t i = 0; i < stride; i++)
+		{
+			const int left = i >= 4u ? row[i - 4u] : 0;
+			const int up = above ? above[i] : 0;
+			const int up_left = above && i >= 4u ? above[i - 4u] : 0;
+			const int estimate = left + up - up_left;
+			const int to_left = std::abs(estimate - left), to_up = std::abs(estimate - up), to_up_left = std::abs(estimate - up_left);
+			const int predictor = (to_left <= to_up && to_left <= to_up_left) ? left : (to_up <= to_up_left ? up : up_left);
+			output[i + 1u] = static_cast<std::uint8_t>(row[i] - predictor);
+		}
+	}
+
+	/**
+	 * Writer of bits in the order of deflate, the first bit the lowest of a byte
+	 */
+	class BitWriter
+	{
+	public:
+		explicit BitWriter(std::vector<std::uint8_t> &output) : m_output(output), m_bits(0u), m_count(0u) { }
+
+		void write(const std::uint32_t value, const unsigned count)
+		{
+			m_bits |= static_cast<std::uint64_t>(value) << m_count;
+			m_count += count;
+			while(m_count >= 8u)
+			{
+				m_output.push_back(static_cast<std::uint8_t>(m_bits));
+				m_bits >>= 8u;
+				m_count -= 8u;
+			}
+		}
+
+		void alignToByte()
+		{
+			if(m_count > 0u)
+			{
+				this->write(0u, 8u - m_count);
+			}
+		}
+
+	private:
+		std::vector<std::uint8_t> &m_output;
+		std::uint64_t m_bits;
+		unsigned m_count;
+	};
+
+	constexpr unsigned MAX_CODE_LENGTH = 15u;
+	constexpr unsigned MAX_CODE_LENGTH_CODE_LENGTH = 7u;
+	constexpr std::size_t LITERAL_CODES = 286u;
+	constexpr std::size_t DISTANCE_CODES = 30u;
+	constexpr std::uint16_t END_OF_BLOCK = 256u;
+	constexpr unsigned MIN_MATCH = 4u;//shorter matches hardly pay for their codes
+	constexpr unsigned MAX_MATCH = 258u;
+	constexpr std::size_t WINDOW = 32768u;
+	constexpr unsigned HASH_BITS = 15u;
+
+	constexpr std::uint16_t LENGTH_BASE[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+	constexpr std::uint8_t LENGTH_EXTRA[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+	constexpr std::uint16_t DISTANCE_BASE[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+	constexpr std::uint8_t DISTANCE_EXTRA[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+	constexpr std::uint8_t CODE_LENGTH_ORDER[19] = { 16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+	const std::array<std::uint8_t, MAX_MATCH + 1u> LENGTH_CODE = []()
+	{
+		std::array<std::uint8_t, MAX_MATCH + 1u> codes{};
+		for(unsigned code = 0; code < 29u; code++)
+		{
+			const unsigned last = code + 1u < 29u ? LENGTH_BASE[code + 1u] : MAX_MATCH + 1u;
+			for(unsigned length = LENGTH_BASE[code]; length < last; length++)
+			{
+				codes[length] = static_cast<std::uint8_t>(code);
+			}
+		}
+		codes[MAX_MATCH] = 28u;
+		return codes;
+	}();
+
+	unsigned distanceCode(const unsigned distance)
+	{
+		return static_cast<unsigned>(std::upper_bound(std::begin(DISTANCE_BASE), std::end(DISTANCE_BASE), distance) - std::begin(DISTANCE_BASE)) - 1u;
+	}
+
+	/**
+	 * Literal (distance 0) or match found in the band
+	 */
+	struct Token
+	{
+		std::uint16_t value;//the byte of a literal, the length of a match
+		std::uint16_t distance;
+	};
+
+	/**
+	 * Lengths of a Huffman code of the frequencies, none longer than the limit
+	 */
+	std::vector<std::uint8_t> codeLengths(std::vector<std::uint32_t> frequencies, const unsigned limit)
+	{
+		std::vector<std::uint8_t> lengths(frequencies.size(), 0u);
+		while(true)
+		{
+			struct Node
+			{
+				std::uint64_t weight;
+				int left;
+				int right;
+			};
+			std::vector<Node> nodes;
+			using Entry = std::pair<std::uint64_t, int>;
+			std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+			for(std::size_t symbol = 0; symbol < frequencies.size(); symbol++)
+			{
+				if(frequencies[symbol] > 0u)
+				{
+					queue.push(Entry(frequencies[symbol], static_cast<int>(nodes.size())));
+					nodes.push_back(Node{frequencies[symbol], -1, static_cast<int>(symbol)});
+				}
+			}
+			if(nodes.size() == 1u)
+			{
+				lengths[nodes.front().right] = 1u;
+				return lengths;
+			}
+			while(queue.size() > 1u)
+			{
+				const Entry first = queue.top();
+				queue.pop();
+				const Entry second = queue.top();
+				queue.pop();
+				queue.push(Entry(first.first + second.first, static_cast<int>(nodes.size())));
+				nodes.push_back(Node{first.first + second.first, first.second, second.second});
+			}
+
+			//leaves keep their symbol in right, without a left child
+			unsigned longest = 0u;
+			std::vector<std::pair<int, unsigned>> stack = { { static_cast<int>(nodes.size()) - 1, 0u } };
+			while(!stack.empty())
+			{
+				const std::pair<int, unsigned> top = stack.back();
+				stack.pop_back();
+				const Node &node = nodes[top.first];
+				if(node.left < 0)
+				{
+					lengths[node.right] = static_cast<std::uint8_t>(top.second);
+					longest = std::max(longest, top.second);
+				}
+				else
+				{
+					stack.push_back({ node.left, top.second + 1u });
+					stack.push_back({ node.right, top.second + 1u });
+				}
+			}
+			if(longest <= limit)
+			{
+				return lengths;
+			}
+			//flatter frequencies give a shallower tree
+			for(std::uint32_t &frequency : frequencies)
+			{
+				frequency = frequency > 0u ? (frequency >> 1u) | 1u : 0u;
+			}
+		}
+	}
+
+	/**
+	 * Canonical codes of the lengths, bit reversed to be written lowest bit first
+	 */
+	std::vector<std::uint16_t> canonicalCodes(const std::vector<std::uint8_t> &lengths)
+	{
+		unsigned counts[MAX_CODE_LENGTH + 1u] = {};
+		for(const std::uint8_t length : lengths)
+		{
+			counts[length]++;
+		}
+		counts[0] = 0u;
+		unsigned next[MAX_CODE_LENGTH + 1u] = {};
+		unsigned code = 0u;
+		for(unsigned bits = 1; bits <= MAX_CODE_LENGTH; bits++)
+		{
+			code = (code + counts[bits - 1u]) << 1u;
+			next[bits] = code;
+		}
+
+		std::vector<std::uint16_t> codes(lengths.size(), 0u);
+		for(std::size_t symbol = 0; symbol < lengths.size(); symbol++)
+		{
+			const unsigned length = lengths[symbol];
+			if(length == 0u)
+			{
+				continue;
+			}
+			unsigned value = next[length]++, reversed = 0u;
+			for(unsigned bit = 0; bit < length; bit++, value >>= 1u)
+			{
+				reversed = (reversed << 1u) | (value & 1u);
+			}
+			codes[symbol] = static_cast<std::uint16_t>(reversed);
+		}
+		return codes;
+	}
+
+	/**
+	 * Greedy matching with one hash probe per position, matches only within the data
+	 */
+	std::vector<Token> findMatches(const std::vector<std::uint8_t> &data)
+	{
+		std::vector<Token> tokens;
+		tokens.reserve(data.size() / 2u);
+		std::vector<std::int32_t> heads(std::size_t(1) << HASH_BITS, -1);
+		auto read32 = [&data](const std::size_t at)
+		{
+			std::uint32_t value;
+			std::memcpy(&value, data.data() + at, sizeof(value));
+			return value;
+		};
+
+		std::size_t i = 0;
+		while(i < data.size())
+		{
+			if(i + MIN_MATCH <= data.size())
+			{
+				const std::uint32_t word = read32(i);
+				const std::uint32_t hash = (word * 2654435761u) >> (32u - HASH_BITS);
+				const std::int32_t candidate = heads[hash];
+				heads[hash] = static_cast<std::int32_t>(i);
+				if(candidate >= 0 && i - candidate <= WINDOW && read32(candidate) == word)
+				{
+					std::size_t length = MIN_MATCH;
+					const std::size_t longest = std::min<std::size_t>(MAX_MATCH, data.size() - i);
+					while(length < longest && data[candidate + length] == data[i + length])
+					{
+						length++;
+					}
+					tokens.push_back(Token{static_cast<std::uint16_t>(length), static_cast<std::uint16_t>(i - candidate)});
+					i += length;
+					continue;
+				}
+			}
+			tokens.push_back(Token{data[i], 0u});
+			i++;
+		}
+		return tokens;
+	}
+
+	/**
+	 * Writes the tokens as one deflate block with dynamic Huffman codes
+	 */
+	void writeBlock(const std::vector<Token> &tokens, const bool final, BitWriter &bits)
+	{
+		std::vector<std::uint32_t> literal_frequencies(LITERAL_CODES, 0u), distance_frequencies(DISTANCE_CODES, 0u);
+		for(const Token &token : tokens)
+		{
+			if(token.distance == 0u)
+			{
+				literal_frequencies[token.value]++;
+			}
+			else
+			{
+				literal_frequencies[257u + LENGTH_CODE[token.value]]++;
+				distance_frequencies[distanceCode(token.distance)]++;
+			}
+		}
+		literal_frequencies[END_OF_BLOCK] = 1u;
+		literal_frequencies[0] = std::max(literal_frequencies[0], 1u);
+		//complete codes of at least two symbols are accepted by every decoder
+		distance_frequencies[0] = std::max(distance_frequencies[0], 1u);
+		distance_frequencies[1] = std::max(distance_frequencies[1], 1u);
+
+		const std::vector<std::uint8_t> literal_lengths = codeLengths(literal_frequencies, MAX_CODE_LENGTH);
+		const std::vector<std::uint8_t> distance_lengths = codeLengths(distance_frequencies, MAX_CODE_LENGTH);
+		const std::vector<std::uint16_t> literal_codes = canonicalCodes(literal_lengths);
+		const std::vector<std::uint16_t> distance_codes = canonicalCodes(distance_lengths);
+
+		std::size_t literal_count = LITERAL_CODES, distance_count = DISTANCE_CODES;
+		while(literal_count > 257u && literal_lengths[literal_count - 1u] == 0u)
+		{
+			literal_count--;
+		}
+		while(distance_count > 1u && distance_lengths[distance_count - 1u] == 0u)
+		{
+			distance_count--;
+		}
+
+		//lengths of both codes, runs written with the repeat symbols 16, 17 and 18
+		std::vector<std::uint8_t> sequence(literal_lengths.begin(), literal_lengths.begin() + literal_count);
+		sequence.insert(sequence.end(), distance_lengths.begin(), distance_lengths.begin() + distance_count);
+		std::vector<std::pair<std::uint8_t, std::uint8_t>> runs;//symbol and its extra bits
+		for(std::size_t i = 0; i < sequence.size();)
+		{
+			const std::uint8_t length = sequence[i];
+			std::size_t run = 1u;
+			while(i + run < sequence.size() && sequence[i + run] == length)
+			{
+				run++;
+			}
+			i += run;
+			if(length == 0u)
+			{
+				while(run >= 11u)
+				{
+					const std::size_t part = std::min<std::size_t>(run, 138u);
+					runs.push_back({ 18u, static_cast<std::uint8_t>(part - 11u) });
+					run -= part;
+				}
+				if(run >= 3u)
+				{
+					runs.push_back({ 17u, static_cast<std::uint8_t>(run - 3u) });
+					run = 0u;
+				}
+			}
+			else
+			{
+				runs.push_back({ length, 0u });
+				run--;
+				while(run >= 3u)
+				{
+					const std::size_t part = std::min<std::size_t>(run, 6u);
+					runs.push_back({ 16u, static_cast<std::uint8_t>(part - 3u) });
+					run -= part;
+				}
+			}
+			for(; run > 0u; run--)
+			{
+				runs.push_back({ length, 0u });
+			}
+		}
+
+		std::vector<std::uint32_t> length_frequencies(19u, 0u);
+		for(const auto &entry : runs)
+		{
+			length_frequencies[entry.first]++;
+		}
+		const std::vector<std::uint8_t> length_lengths = codeLengths(length_frequencies, MAX_CODE_LENGTH_CODE_LENGTH);
+		const std::vector<std::uint16_t> length_codes = canonicalCodes(length_lengths);
+		std::size_t length_count = 19u;
+		while(length_count > 4u && length_lengths[CODE_LENGTH_ORDER[length_count - 1u]] == 0u)
+		{
+			length_count--;
+		}
+
+		bits.write(final ? 1u : 0u, 1u);
+		bits.write(2u, 2u);//dynamic Huffman codes
+		bits.write(static_cast<std::uint32_t>(literal_count - 257u), 5u);
+		bits.write(static_cast<std::uint32_t>(distance_count - 1u), 5u);
+		bits.write(static_cast<std::uint32_t>(length_count - 4u), 4u);
+		for(std::size_t i = 0; i < length_count; i++)
+		{
+			bits.write(length_lengths[CODE_LENGTH_ORDER[i]], 3u);
+		}
+		static const unsigned REPEAT_BITS[3] = { 2u, 3u, 7u };
+		for(const auto &entry : runs)
+		{
+			bits.write(length_codes[entry.first], length_lengths[entry.first]);
+			if(entry.first >= 16u)
+			{
+				bits.write(entry.second, REPEAT_BITS[entry.first - 16u]);
+			}
+		}
+
+		for(const Token &token : tokens)
+		{
+			if(token.distance == 0u)
+			{
+				bits.write(literal_codes[token.value], literal_lengths[token.value]);
+				continue;
+			}
+			const unsigned length_code = LENGTH_CODE[token.value];
+			bits.write(literal_codes[257u + length_code], literal_lengths[257u + length_code]);
+			bits.write(token.value - LENGTH_BASE[length_code], LENGTH_EXTRA[length_code]);
+			const unsigned distance_code = distanceCode(token.distance);
+			bits.write(distance_codes[distance_code], distance_lengths[distance_code]);
+			bits.write(token.distance - DISTANCE_BASE[distance_code], DISTANCE_EXTRA[distance_code]);
+		}
+		bits.write(literal_codes[END_OF_BLOCK], literal_lengths[END_OF_BLOCK]);
+	}
+
+	/// QOI ///
+
+	constexpr std::uint8_t QOI_OP_INDEX = 0x00u;
+	constexpr std::uint8_t QOI_OP_DIFF = 0x40u;
+	constexpr std::uint8_t QOI_OP_LUMA = 0x80u;
+	constexpr std::uint8_t QOI_OP_RUN = 0xC0u;
+	constexpr std::uint8_t QOI_OP_RGB = 0xFEu;
+	constexpr std::uint8_t QOI_OP_RGBA = 0xFFu;
+	constexpr unsigned QOI_MAX_RUN = 62u;
+
+	/**
+	 * Encodes the pixels continuing from the previous one, using only colors of the index seen in the band
+	 */
+	void encodeQoiBand(const std::uint8_t *pixels, const std::size_t count, const std::uint8_t *previous, std::vector<std::uint8_t> &output)
+	{
+		std::uint8_t index[64][4] = {};
+		bool seen[64] = {};
+		std::uint8_t last[4];
+		std::memcpy(last, previous, 4u);
+		unsigned run = 0u;
+		output.reserve(count * 2u);
+
+		for(std::size_t i = 0; i < count; i++)
+		{
+			const std::uint8_t *pixel = pixels + i * 4u;
+			if(std::memcmp(pixel, last, 4u) == 0)
+			{
+				if(++run == QOI_MAX_RUN)
+				{
+					output.push_back(static_cast<std::uint8_t>(QOI_OP_RUN | (run - 1u)));
+					run = 0u;
+				}
+				continue;
+			}
+			if(run > 0u)
+			{
+				output.push_back(static_cast<std::uint8_t>(QOI_OP_RUN | (run - 1u)));
+				run = 0u;
+			}
+
+			const unsigned slot = (pixel[0] * 3u + pixel[1] * 5u + pixel[2] * 7u + pixel[3] * 11u) % 64u;
+			if(seen[slot] && std::memcmp(index[slot], pixel, 4u) == 0)
+			{
+				output.push_back(static_cast<std::uint8_t>(QOI_OP_INDEX | slot));
+			}
+			else
+			{
+				std::memcpy(index[slot], pixel, 4u);
+				seen[slot] = true;
+				if(pixel[3] == last[3])
+				{
+					const int red = static_cast<std::int8_t>(pixel[0] - last[0]);
+					const int green = static_cast<std::int8_t>(pixel[1] - last[1]);
+					const int blue = static_cast<std::int8_t>(pixel[2] - last[2]);
+					const int red_green = red - green, blue_green = blue - green;
+					if(red >= -2 && red <= 1 && green >= -2 && green <= 1 && blue >= -2 && blue <= 1)
+					{
+						output.push_back(static_cast<std::uint8_t>(QOI_OP_DIFF | ((red + 2) << 4) | ((green + 2) << 2) | (blue + 2)));
+					}
+					else if(green >= -32 && green <= 31 && red_green >= -8 && red_green <= 7 && blue_green >= -8 && blue_green <= 7)
+					{
+						output.push_back(static_cast<std::uint8_t>(QOI_OP_LUMA | (green + 32)));
+						output.push_back(static_cast<std::uint8_t>(((red_green + 8) << 4) | (blue_green + 8)));
+					}
+					else
+					{
+						output.push_back(QOI_OP_RGB);
+						output.insert(output.end(), pixel, pixel + 3);
+					}
+				}
+				else
+				{
+					output.push_back(QOI_OP_RGBA);
+					output.insert(output.end(), pixel, pixel + 4);
+				}
+			}
+			std::memcpy(last, pixel, 4u);
+		}
+		if(run > 0u)
+		{
+			output.push_back(static_cast<std::uint8_t>(QOI_OP_RUN | (run - 1u)));
+		}
+	}
+
+	bool hasExtension(const std::string &path, const char *extension)
+	{
+		const std::size_t length = std::char_traits<char>::length(extension);
+		if(path.size() < length)
+		{
+			return false;
+		}
+		for(std::size_t i = 0; i < length; i++)
+		{
+			if(std::tolower(static_cast<unsigned char>(path[path.size() - length + i])) != extension[i])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void checkSize(const sf::Vector2u &size, const char *method)
+	{
+		if(size.x == 0u || size.y == 0u)
+		{
+			throw std::runtime_error(std::string("ImageEncoder::") + method + "(): the image is empty");
+		}
+	}
+}//anonymous namespace
+
+bool ImageEncoder::handles(const std::string &path)
+{
+	return hasExtension(path, ".png") || hasExtension(path, ".qoi");
+}
+
+void ImageEncoder::save(const std::uint8_t *pixels, const sf::Vector2u &size, const std::string &path)
+{
+	std::vector<std::uint8_t> encoded;
+	if(hasExtension(path, ".png"))
+	{
+		encoded = ImageEncoder::encodePng(pixels, size);
+	}
+	else if(hasExtension(path, ".qoi"))
+	{
+		encoded = ImageEncoder::encodeQoi(pixels, size);
+	}
+	else
+	{
+		throw std::runtime_error("ImageEncoder::save(): unsupported format of " + path);
+	}
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(reinterpret_cast<const char *>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+	file.close();
+	if(!file)
+	{
+		throw std::runtime_error("ImageEncoder::save(): cannot write " + path);
+	}
+}
+
+std::vector<std::uint8_t> ImageEncoder::encodePng(const std::uint8_t *pixels, const sf::Vector2u &size)
+{
+	checkSize(size, "encodePng");
+	const std::size_t stride = static_cast<std::size_t>(size.x) * 4u;
+	const std::size_t band_count = (size.y + ROWS_PER_TASK - 1u) / ROWS_PER_TASK;
+	std::vector<std::vector<std::uint8_t>> bands(band_count);
+	std::vector<std::uint32_t> adlers(band_count, 1u);
+	std::vector<std::size_t> filtered_bytes(band_count, 0u);
+
+	//every band is an IDAT chunk holding a part of the zlib stream
+	forEachBand(size.y, [&](std::size_t band, unsigned first, unsigned end)
+	{
+		std::vector<std::uint8_t> filtered((end - first) * (stride + 1u));
+		for(unsigned row = first; row < end; row++)
+		{
+			const std::uint8_t *above = row > 0u ? pixels + (row - 1u) * stride : nullptr;
+			filterRow(pixels + row * stride, above, stride, filtered.data() + (row - first) * (stride + 1u));
+		}
+		adlers[band] = adler32(filtered.data(), filtered.size());
+		filtered_bytes[band] = filtered.size();
+
+		std::vector<std::uint8_t> stream;
+		stream.reserve(filtered.size() / 2u);
+		if(band == 0u)
+		{
+			stream.push_back(0x78u);//deflate with a 32K window
+			stream.push_back(0x01u);//fastest level, no dictionary
+		}
+		BitWriter bits(stream);
+		const bool last = band + 1u == bands.size();
+		writeBlock(findMatches(filtered), last, bits);
+		if(!last)
+		{
+			//an empty stored block brings the band to a whole byte, so bands are joined as bytes
+			bits.write(0u, 3u);
+			bits.alignToByte();
+			stream.insert(stream.end(), { 0x00u, 0x00u, 0xFFu, 0xFFu });
+		}
+		bits.alignToByte();
+		appendPngChunk(bands[band], "IDAT", stream.data(), stream.size());
+	});
+
+	std::uint32_t adler = adlers[0];
+	for(std::size_t band = 1; band < band_count; band++)
+	{
+		adler = combineAdler32(adler, adlers[band], filtered_bytes[band]);
+	}
+
+	std::vector<std::uint8_t> header = { 0x89u, 'P', 'N', 'G', '\r', '\n', 0x1Au, '\n' };
+	std::vector<std::uint8_t> image_header;
+	appendBig32(image_header, size.x);
+	appendBig32(image_header, size.y);
+	image_header.insert(image_header.end(), { 8u, 6u, 0u, 0u, 0u });//8 bits per channel, RGBA, deflate, no interlacing
+	appendPngChunk(header, "IHDR", image_header.data(), image_header.size());
+
+	std::vector<std::uint8_t> trailer, checksum;
+	appendBig32(checksum, adler);
+	appendPngChunk(trailer, "IDAT", checksum.data(), checksum.size());
+	appendPngChunk(trailer, "IEND", nullptr, 0u);
+	return joinBands(header, bands, trailer);
+}
+
+std::vector<std::uint8_t> ImageEncoder::encodeQoi(const std::uint8_t *pixels, const sf::Vector2u &size)
+{
+	checkSize(size, "encodeQoi");
+	const std::size_t stride = static_cast<std::size_t>(size.x) * 4u;
+	const std::uint8_t start[4] = { 0u, 0u, 0u, 255u };
+	std::vector<std::vector<std::uint8_t>> bands((size.y + ROWS_PER_TASK - 1u) / ROWS_PER_TASK);
+	forEachBand(size.y, [&](std::size_t band, unsigned first, unsigned end)
+	{
+		const std::uint8_t *previous = first > 0u ? pixels + first * stride - 4u : start;
+		encodeQoiBand(pixels + first * stride, (end - first) * static_cast<std::size_t>(size.x), previous, bands[band]);
+	});
+
+	std::vector<std::uint8_t> header = { 'q', 'o', 'i', 'f' };
+	appendBig32(header, size.x);
+	appendBig32(header, size.y);
+	header.push_back(4u);//RGBA
+	header.push_back(0u);//sRGB with linear alpha
+	const std::vector<std::uint8_t> trailer = { 0u, 0u, 0u, 0u, 0u, 0u, 0u, 1u };
+	return joinBands(header, bands, trailer);
+}
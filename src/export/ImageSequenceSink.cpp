@@ -0,0 +1,30 @@
+#include "../../include/export/ImageSequenceSink.h"
+
+#include <filesystem>
+
+ImageSequenceSink::ImageSequenceSink(const std::string &directory, const std::string &extension, const unsigned threads)
+:
+m_directory(directory),
+m_extension(extension),
+m_count(0u),
+m_exporter(threads)
+{
+	std::filesystem::create_directories(m_directory);
+}
+
+void ImageSequenceSink::write(ExportFrame frame)
+{
+	m_count++;
+	m_exporter.push(std::move(frame), m_directory + "/" + ImageSequenceSink::frameName(m_count) + "." + m_extension);
+}
+
+void ImageSequenceSink::close()
+{
+	m_exporter.finish();
+}
+
+std::string ImageSequenceSink::frameName(const unsigned number)
+{
+	const std::string name = std::to_string(number);
+	return std::string(name.size() < 3u ? 3u - name.size() : 0u, '0') + name;
+}
@@ -0,0 +1,100 @@
+#include "../../include/export/RawSequence.h"
+
+#include <cstring>
+
+namespace
+{
+	constexpr char MAGIC[8] = { 'B', 'C', 'G', 'R', 'A', 'W', '\0', '\1' };
+
+	template <typename T>
+	void writeValue(std::ostream &stream, const T &value)
+	{
+		stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+	}
+
+	template <typename T>
+	T readValue(const std::uint8_t *&at)
+	{
+		T value;
+		std::memcpy(&value, at, sizeof(T));
+		at += sizeof(T);
+		return value;
+	}
+}//anonymous namespace
+
+RawSequence::RawSequence(const std::string &path)
+:
+m_file(path),
+m_size(),
+m_frameCount(0u),
+m_frameBytes(0u),
+m_fps(0.f)
+{
+	if(m_file.size() < HEADER_BYTES || !std::equal(MAGIC, MAGIC + sizeof(MAGIC), m_file.data()))
+	{
+		throw std::runtime_error("RawSequence::RawSequence(): " + path + " is not a sequence");
+	}
+	const std::uint8_t *at = m_file.data() + sizeof(MAGIC);
+	m_size.x = readValue<std::uint32_t>(at);
+	m_size.y = readValue<std::uint32_t>(at);
+	const std::uint32_t frames = readValue<std::uint32_t>(at);
+	const std::uint32_t format = readValue<std::uint32_t>(at);
+	m_fps = readValue<float>(at);
+	m_frameBytes = static_cast<std::size_t>(readValue<std::uint64_t>(at));
+	if(format != PIXEL_FORMAT_RGBA8 || m_frameBytes == 0u || m_frameBytes != static_cast<std::size_t>(m_size.x) * m_size.y * 4u)
+	{
+		throw std::runtime_error("RawSequence::RawSequence(): unsupported frames in " + path);
+	}
+
+	//frames of an unfinished file are the ones which are there whole
+	const std::size_t stored = (m_file.size() - HEADER_BYTES) / m_frameBytes;
+	m_frameCount = frames > 0u ? std::min<std::size_t>(frames, stored) : stored;
+	if(m_frameCount == 0u)
+	{
+		throw std::runtime_error("RawSequence::RawSequence(): " + path + " has no frames");
+	}
+}
+
+void RawSequence::writeHeader(std::ostream &stream, const sf::Vector2u &size, const std::uint32_t frames, const float &fps)
+{
+	stream.write(MAGIC, sizeof(MAGIC));
+	writeValue(stream, static_cast<std::uint32_t>(size.x));
+	writeValue(stream, static_cast<std::uint32_t>(size.y));
+	writeValue(stream, frames);
+	writeValue(stream, PIXEL_FORMAT_RGBA8);
+	writeValue(stream, fps);
+	writeValue(stream, static_cast<std::uint64_t>(size.x) * size.y * 4u);
+	const std::size_t written = sizeof(MAGIC) + 5u * sizeof(std::uint32_t) + sizeof(std::uint64_t);
+	const std::vector<char> padding(HEADER_BYTES - written, 0);
+	stream.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+}
+
+bool RawSequence::isSequencePath(const std::string &path)
+{
+	const std::size_t length = std::char_traits<char>::length(EXTENSION);
+	return path.size() > length && path.compare(path.size() - length, length, EXTENSION) == 0;
+}
+
+const sf::Vector2u &RawSequence::getSize() const
+{
+	return m_size;
+}
+
+std::size_t RawSequence::getFrameCount() const
+{
+	return m_frameCount;
+}
+
+float RawSequence::getFps() const
+{
+	return m_fps;
+}
+
+const std::uint8_t *RawSequence::getFrame(const std::size_t index) const
+{
+	if(index >= m_frameCount)
+	{
+		throw std::out_of_range("RawSequence::getFrame(): there is no frame of index " + std::to_string(index));
+	}
+	return m_file.data() + HEADER_BYTES + index * m_frameBytes;
+}
@@ -0,0 +1,75 @@
+#include "../../include/export/RawSequenceSink.h"
+
+#include <iostream>
+
+RawSequenceSink::RawSequenceSink(const std::string &path, const float &fps)
+:
+m_path(path),
+m_file(path, std::ios::binary | std::ios::trunc),
+m_fps(fps),
+m_size(),
+m_frameCount(0u)
+{
+	if(!m_file)
+	{
+		throw std::runtime_error("RawSequenceSink::RawSequenceSink(): cannot open " + path);
+	}
+}
+
+RawSequenceSink::~RawSequenceSink()
+{
+	if(m_file.is_open())
+	{
+		try
+		{
+			this->close();
+		}
+		catch(const std::exception &error)
+		{
+			std::cerr << error.what() << std::endl;
+		}
+	}
+}
+
+void RawSequenceSink::write(ExportFrame frame)
+{
+	if(m_frameCount == 0u)
+	{
+		if(frame.size.x == 0u || frame.size.y == 0u)
+		{
+			throw std::runtime_error("RawSequenceSink::write(): empty frame");
+		}
+		m_size = frame.size;
+		RawSequence::writeHeader(m_file, m_size, 0u, m_fps);
+	}
+	else if(frame.size != m_size)
+	{
+		throw std::runtime_error("RawSequenceSink::write(): frames differ in size");
+	}
+
+	m_file.write(reinterpret_cast<const char *>(frame.data()), static_cast<std::streamsize>(MemoryCharge::bytesOf(m_size)));
+	if(!m_file)
+	{
+		throw std::runtime_error("RawSequenceSink::write(): cannot write to " + m_path);
+	}
+	m_frameCount++;
+}
+
+void RawSequenceSink::close()
+{
+	if(!m_file.is_open())
+	{
+		return;
+	}
+	if(m_frameCount > 0u)
+	{
+		//the header is written again with the amount of frames
+		m_file.seekp(0);
+		RawSequence::writeHeader(m_file, m_size, m_frameCount, m_fps);
+	}
+	m_file.close();
+	if(!m_file)
+	{
+		throw std::runtime_error("RawSequenceSink::close(): cannot write to " + m_path);
+	}
+}
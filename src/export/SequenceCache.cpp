@@ -0,0 +1,392 @@
+#include "../../include/export/SequenceCache.h"
+#include "../../include/util/Resources.h"
+
+#include <chrono>
+
+namespace
+{
+	constexpr char MAGIC[8] = { 'B', 'C', 'G', 'S', 'E', 'Q', '\0', '\1' };
+	constexpr const char *EXTENSION = ".bcgseq";
+	constexpr std::streamoff FRAME_COUNT_OFFSET = sizeof(MAGIC) + 2 * sizeof(std::uint32_t);
+	constexpr std::size_t MIN_UNCHANGED_RUN = 4u;///> Unchanged pixels shorter than this stay in the changed run around them
+
+	/**
+	 * Header of the file of a sequence, written field by field in the byte order of the machine
+	 */
+	struct Header
+	{
+		std::uint32_t width = 0u;
+		std::uint32_t height = 0u;
+		std::uint32_t frames = 0u;
+		std::uint32_t reserved = 0u;
+		std::uint64_t hash = 0u;
+	};
+
+	template <typename T>
+	void writeValue(std::ostream &stream, const T &value)
+	{
+		stream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+	}
+
+	template <typename T>
+	bool readValue(std::istream &stream, T &value)
+	{
+		return static_cast<bool>(stream.read(reinterpret_cast<char *>(&value), sizeof(T)));
+	}
+
+	bool readHeader(std::istream &stream, Header &header)
+	{
+		char magic[sizeof(MAGIC)];
+		return stream.read(magic, sizeof(magic))
+			&& std::equal(magic, magic + sizeof(magic), MAGIC)
+			&& readValue(stream, header.width)
+			&& readValue(stream, header.height)
+			&& readValue(stream, header.frames)
+			&& readValue(stream, header.reserved)
+			&& readValue(stream, header.hash);
+	}
+
+	void appendValue(std::vector<std::uint8_t> &output, const std::uint32_t value)
+	{
+		const std::uint8_t *bytes = reinterpret_cast<const std::uint8_t *>(&value);
+		output.insert(output.end(), bytes, bytes + sizeof(value));
+	}
+
+	/**
+	 * Encodes the pixels as pairs of runs, unchanged pixels followed by changed ones
+	 *   stored XOR the previous frame, and makes them the previous frame
+	 */
+	void encodeFrame(const std::uint32_t *pixels, std::vector<std::uint32_t> &previous, std::vector<std::uint8_t> &output)
+	{
+		const std::size_t count = previous.size();
+		output.clear();
+		std::size_t i = 0;
+		while(i < count)
+		{
+			std::size_t changed = i;
+			while(changed < count && pixels[changed] == previous[changed])
+			{
+				changed++;
+			}
+			std::size_t end = changed;
+			while(end < count)
+			{
+				if(pixels[end] != previous[end])
+				{
+					end++;
+					continue;
+				}
+				std::size_t unchanged = end;
+				while(unchanged < count && unchanged - end < MIN_UNCHANGED_RUN && pixels[unchanged] == previous[unchanged])
+				{
+					unchanged++;
+				}
+				if(unchanged - end >= MIN_UNCHANGED_RUN || unchanged == count)
+				{
+					break;
+				}
+				end = unchanged;
+			}
+
+			appendValue(output, static_cast<std::uint32_t>(changed - i));
+			appendValue(output, static_cast<std::uint32_t>(end - changed));
+			const std::size_t offset = output.size();
+			output.resize(offset + (end - changed) * sizeof(std::uint32_t));
+			std::uint32_t difference;
+			for(std::size_t pixel = changed; pixel < end; pixel++)
+			{
+				difference = pixels[pixel] ^ previous[pixel];
+				std::memcpy(output.data() + offset + (pixel - changed) * sizeof(difference), &difference, sizeof(difference));
+				previous[pixel] = pixels[pixel];
+			}
+			i = end;
+		}
+	}
+
+	/**
+	 * Applies the runs of the encoded frame on the previous frame, false if they do not fit into it
+	 */
+	bool decodeFrame(const std::vector<std::uint8_t> &input, std::vector<std::uint32_t> &previous)
+	{
+		const std::size_t count = previous.size();
+		std::size_t pixel = 0u, at = 0u;
+		std::uint32_t unchanged, changed, difference;
+		while(at < input.size())
+		{
+			if(input.size() - at < 2u * sizeof(std::uint32_t))
+			{
+				return false;
+			}
+			std::memcpy(&unchanged, input.data() + at, sizeof(unchanged));
+			std::memcpy(&changed, input.data() + at + sizeof(unchanged), sizeof(changed));
+			at += 2u * sizeof(std::uint32_t);
+			if(unchanged > count - pixel || changed > count - pixel - unchanged
+				|| (input.size() - at) / sizeof(std::uint32_t) < changed)
+			{
+				return false;
+			}
+			pixel += unchanged;
+			for(std::uint32_t i = 0; i < changed; i++, pixel++, at += sizeof(difference))
+			{
+				std::memcpy(&difference, input.data() + at, sizeof(difference));
+				previous[pixel] ^= difference;
+			}
+		}
+		return true;
+	}
+}//anonymous namespace
+
+SequenceCache::SequenceCache(const std::string &directory, const std::uintmax_t capacity)
+:
+m_directory(directory),
+m_capacity(capacity),
+m_recordings(0u),
+m_imageHashes(),
+m_mutex()
+{ }
+
+SequenceCache &SequenceCache::shared()
+{
+	static SequenceCache cache([]()
+	{
+		if(const char *env = std::getenv("BCG_CACHE_DIR"))
+		{
+			return std::string(env);
+		}
+		std::error_code error;
+		const std::filesystem::path temporary = std::filesystem::temp_directory_path(error);
+		return ((error ? std::filesystem::path(".") : temporary) / "bcg-project-sequences").string();
+	}());
+	return cache;
+}
+
+const std::string &SequenceCache::getDirectory() const
+{
+	return m_directory;
+}
+
+void SequenceCache::setCapacity(const std::uintmax_t capacity)
+{
+	m_capacity = capacity;
+}
+
+std::uint64_t SequenceCache::hashImage(const std::string &path)
+{
+	if(Resources::isResourcePath(path))
+	{
+		return ContentHash::hashFile(path);
+	}
+	const std::uintmax_t size = std::filesystem::file_size(path);
+	const std::filesystem::file_time_type changed = std::filesystem::last_write_time(path);
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto found = m_imageHashes.find(path);
+		if(found != m_imageHashes.end() && found->second.size == size && found->second.changed == changed)
+		{
+			return found->second.hash;
+		}
+	}
+	const std::uint64_t hash = ContentHash::hashFile(path);
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_imageHashes[path] = FileHash{size, changed, hash};
+	return hash;
+}
+
+bool SequenceCache::contains(const std::uint64_t hash) const
+{
+	std::error_code error;
+	return std::filesystem::is_regular_file(this->pathOf(hash), error);
+}
+
+bool SequenceCache::replay(const std::uint64_t hash, BufferPool &pool, const std::function<void(ExportFrame)> &consumer)
+{
+	const std::string path = this->pathOf(hash);
+	std::ifstream file(path, std::ios::binary);
+	if(!file)
+	{
+		return false;
+	}
+
+	//chunks are walked first, so a cut off file is dropped before any frame is passed
+	Header header;
+	std::error_code error;
+	bool complete = readHeader(file, header) && header.hash == hash && header.frames > 0u && header.width > 0u && header.height > 0u;
+	const std::streamoff frames_start = complete ? static_cast<std::streamoff>(file.tellg()) : 0;
+	const std::uintmax_t file_size = std::filesystem::file_size(path, error);
+	std::uintmax_t offset = static_cast<std::uintmax_t>(frames_start);
+	for(std::uint32_t i = 0; complete && i < header.frames; i++)
+	{
+		std::uint32_t bytes = 0u;
+		complete = file.seekg(static_cast<std::streamoff>(offset)) && readValue(file, bytes);
+		offset += sizeof(bytes) + bytes;
+		complete = complete && offset <= file_size;
+	}
+	if(!complete || offset != file_size)
+	{
+		file.close();
+		std::filesystem::remove(path, error);
+		return false;
+	}
+	file.seekg(frames_start);
+
+	const sf::Vector2u size(header.width, header.height);
+	std::vector<std::uint32_t> pixels(static_cast<std::size_t>(size.x) * size.y, 0u);
+	std::vector<std::uint8_t> encoded;
+	MemoryCharge memory(MemorySubsystem::EXPORT);
+	for(std::uint32_t i = 0; i < header.frames; i++)
+	{
+		std::uint32_t bytes = 0u;
+		readValue(file, bytes);
+		encoded.resize(bytes);
+		memory.setCpu(pixels.size() * sizeof(std::uint32_t) + encoded.capacity());
+		if(!file.read(reinterpret_cast<char *>(encoded.data()), bytes) || !decodeFrame(encoded, pixels))
+		{
+			throw std::runtime_error("SequenceCache::replay(): frame " + std::to_string(i + 1u) + " of " + path + " is damaged");
+		}
+		ExportFrame frame{size, pool.acquire(MemoryCharge::bytesOf(size))};
+		std::memcpy(frame.pixels->data(), pixels.data(), MemoryCharge::bytesOf(size));
+		consumer(std::move(frame));
+	}
+	file.close();
+
+	//replayed sequences are the last ones trimmed
+	std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+	return true;
+}
+
+std::unique_ptr<SequenceCache::Recording> SequenceCache::record(const std::uint64_t hash)
+{
+	std::filesystem::create_directories(m_directory);
+	//unique among the recordings of this process and, by the clock, among processes sharing the directory
+	const auto ticks = std::chrono::steady_clock::now().time_since_epoch().count();
+	const std::string path = this->pathOf(hash) + "." + std::to_string(m_recordings++) + "-" + std::to_string(ticks) + ".tmp";
+	return std::unique_ptr<Recording>(new Recording(*this, hash, path));
+}
+
+SequenceCache::Recording::Recording(SequenceCache &cache, const std::uint64_t hash, const std::string &path)
+:
+m_cache(cache),
+m_hash(hash),
+m_path(path),
+m_file(path, std::ios::binary | std::ios::trunc),
+m_size(),
+m_frameCount(0u),
+m_previous(),
+m_encoded(),
+m_memory(MemorySubsystem::EXPORT),
+m_committed(false)
+{
+	if(!m_file)
+	{
+		throw std::runtime_error("SequenceCache::Recording::Recording(): cannot create " + path);
+	}
+}
+
+SequenceCache::Recording::~Recording()
+{
+	if(!m_committed)
+	{
+		m_file.close();
+		std::error_code error;
+		std::filesystem::remove(m_path, error);
+	}
+}
+
+void SequenceCache::Recording::add(const ExportFrame &frame)
+{
+	if(m_frameCount == 0u)
+	{
+		m_size = frame.size;
+		m_previous.assign(static_cast<std::size_t>(m_size.x) * m_size.y, 0u);
+		m_file.write(MAGIC, sizeof(MAGIC));
+		writeValue(m_file, static_cast<std::uint32_t>(m_size.x));
+		writeValue(m_file, static_cast<std::uint32_t>(m_size.y));
+		writeValue(m_file, std::uint32_t(0u));//frame count, written by commit
+		writeValue(m_file, std::uint32_t(0u));
+		writeValue(m_file, m_hash);
+	}
+	else if(frame.size != m_size)
+	{
+		throw std::runtime_error("SequenceCache::Recording::add(): frames of a sequence have to be of the same size");
+	}
+
+	encodeFrame(reinterpret_cast<const std::uint32_t *>(frame.data()), m_previous, m_encoded);
+	writeValue(m_file, static_cast<std::uint32_t>(m_encoded.size()));
+	m_file.write(reinterpret_cast<const char *>(m_encoded.data()), static_cast<std::streamsize>(m_encoded.size()));
+	m_memory.setCpu(m_previous.size() * sizeof(std::uint32_t) + m_encoded.capacity());
+	if(!m_file)
+	{
+		throw std::runtime_error("SequenceCache::Recording::add(): cannot write " + m_path);
+	}
+	m_frameCount++;
+}
+
+void SequenceCache::Recording::commit()
+{
+	if(m_committed)
+	{
+		return;
+	}
+	if(m_frameCount == 0u)
+	{
+		throw std::runtime_error("SequenceCache::Recording::commit(): the sequence has no frames");
+	}
+	m_file.seekp(FRAME_COUNT_OFFSET);
+	writeValue(m_file, m_frameCount);
+	m_file.close();
+	if(!m_file)
+	{
+		throw std::runtime_error("SequenceCache::Recording::commit(): cannot write " + m_path);
+	}
+
+	const std::string final_path = m_cache.pathOf(m_hash);
+	std::error_code error;
+	std::filesystem::remove(final_path, error);//rename does not replace files everywhere
+	std::filesystem::rename(m_path, final_path);
+	m_committed = true;
+	m_previous = std::vector<std::uint32_t>();
+	m_encoded = std::vector<std::uint8_t>();
+	m_memory.setCpu(0u);
+	m_cache.trim();
+}
+
+//private member functions
+std::string SequenceCache::pathOf(const std::uint64_t hash) const
+{
+	return (std::filesystem::path(m_directory) / (ContentHash::toHex(hash) + EXTENSION)).string();
+}
+
+void SequenceCache::trim()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	struct Stored
+	{
+		std::filesystem::path path;
+		std::uintmax_t size;
+		std::filesystem::file_time_type used;
+	};
+	std::vector<Stored> stored;
+	std::uintmax_t total = 0u;
+	std::error_code error;
+	for(const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator(m_directory, error))
+	{
+		if(entry.path().extension() == EXTENSION && entry.is_regular_file(error))
+		{
+			stored.push_back(Stored{entry.path(), entry.file_size(error), entry.last_write_time(error)});
+			total += stored.back().size;
+		}
+	}
+
+	std::sort(stored.begin(), stored.end(), [](const Stored &first, const Stored &second) { return first.used < second.used; });
+	for(const Stored &sequence : stored)
+	{
+		if(total <= m_capacity)
+		{
+			break;
+		}
+		if(std::filesystem::remove(sequence.path, error))
+		{
+			total -= sequence.size;
+		}
+	}
+}
@@ -0,0 +1,105 @@
+#include "../../include/gui/AlphaMask.h"
+
+AlphaMask::AlphaMask()
+:
+m_texture(),
+m_size(0u, 0u),
+m_charge(MemorySubsystem::IMAGES)
+{ }
+
+bool AlphaMask::fits(const sf::Vector2u &size)
+{
+	return size.x > 0u && size.y > 0u && size.x % 4u == 0u;
+}
+
+bool AlphaMask::create(const sf::Vector2u &size)
+{
+	if(size == m_size)
+	{
+		return true;
+	}
+	this->clear();
+	if(!AlphaMask::fits(size) || !m_texture.create(size.x / 4u, size.y))
+	{
+		return false;
+	}
+	m_texture.setSmooth(false);//neighbouring texels hold unrelated pixels
+	m_size = size;
+	m_charge.setGpu(static_cast<std::size_t>(size.x) * size.y);
+	return true;
+}
+
+void AlphaMask::clear()
+{
+	m_texture = sf::Texture();
+	m_size = sf::Vector2u(0u, 0u);
+	m_charge.setGpu(0u);
+}
+
+void AlphaMask::update(const std::vector<unsigned char> &mask)
+{
+	if(m_size.x > 0u)
+	{
+		this->upload(mask, 0u, std::min<std::size_t>(m_size.y, mask.size() / m_size.x));
+	}
+}
+
+void AlphaMask::update(const std::vector<unsigned char> &mask, const std::size_t begin, const std::size_t end)
+{
+	if(m_size.x > 0u && begin < end)
+	{
+		const std::size_t available = std::min<std::size_t>(m_size.y, mask.size() / m_size.x);
+		const std::size_t first = begin / m_size.x;
+		const std::size_t last = std::min(available, (end + m_size.x - 1) / m_size.x);
+		if(last > first)
+		{
+			this->upload(mask, first, last - first);
+		}
+	}
+}
+
+sf::Vector2u AlphaMask::getSize() const
+{
+	return m_size;
+}
+
+const sf::Texture &AlphaMask::getTexture() const
+{
+	return m_texture;
+}
+
+const std::string &AlphaMask::getShaderSource()
+{
+	//pixel x of the image is channel x % 4 of texel x / 4 of the mask
+	static const std::string source = R"(
+uniform sampler2D source;
+uniform sampler2D mask;
+uniform float width;
+uniform bool premultiplied;
+
+void main()
+{
+	vec4 pixel = texture2D(source, gl_TexCoord[0].xy);
+	float x = min(floor(gl_TexCoord[0].x * width), width - 1.0);
+	float texel = floor(x / 4.0);
+	vec4 packed = texture2D(mask, vec2((texel + 0.5) * 4.0 / width, gl_TexCoord[0].y));
+	vec4 channel = vec4(equal(vec4(x - texel * 4.0), vec4(0.0, 1.0, 2.0, 3.0)));
+	float alpha = dot(packed, channel);
+	if(premultiplied)//colors are scaled along with alpha
+		pixel *= (pixel.a > 0.0) ? alpha / pixel.a : 0.0;
+	else
+		pixel.a = alpha;
+	gl_FragColor = gl_Color * pixel;
+}
+)";
+	return source;
+}
+
+//private member functions
+void AlphaMask::upload(const std::vector<unsigned char> &mask, const std::size_t first_row, const std::size_t rows)
+{
+	if(rows > 0u)
+	{
+		m_texture.update(mask.data() + first_row * m_size.x, m_size.x / 4u, static_cast<unsigned>(rows), 0u, static_cast<unsigned>(first_row));
+	}
+}
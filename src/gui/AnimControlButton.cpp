@@ -12,20 +12,24 @@ AnimControlButton::AnimControlButton(const sf::Vector2f &pos)
 Button(pos, sf::Vector2f(40.f, 40.f) )
 {
     m_shape.setOutlineThickness(0);
-	m_texture.loadFromFile("../res/images/play_button.png");
 	m_sprite.setColor( sf::Color(250,250,250) );
-	m_sprite.setTexture(m_texture);
+	IconAtlas::shared().apply(m_sprite, Icon::PLAY);
 	m_sprite.setPosition(pos);
 }
 
 
-void AnimControlButton::render(sf::RenderTarget *target) 
+void AnimControlButton::batch(GuiBatch &target) const
 {
-	Button::render(target);
-	target->draw(this->m_sprite);
+	Button::batch(target);
+	target.add(this->m_sprite);
 }	
 
 void AnimControlButton::update(sf::Vector2i mousePos, sf::Event &event) 
 {
 	Button::update(mousePos, event);
 }
+
+std::size_t AnimControlButton::getLookKey() const
+{
+	return Object::combineLook(Button::getLookKey(), m_sprite.getColor().toInteger());
+}
@@ -1,12 +1,31 @@
 #include "../../include/gui/AnimatedImage.h"
 
+namespace
+{
+	std::vector<unsigned char> toPixels(const sf::Image &image)
+	{
+		const sf::Uint8 *pix = image.getPixelsPtr();
+		if(!pix)
+		{
+			return {};
+		}
+		return std::vector<unsigned char>(pix, pix + static_cast<std::size_t>(image.getSize().x) * image.getSize().y * 4u);
+	}
+}//anonymous namespace
+
 AnimatedImage::AnimatedImage()
 :
 m_initSize(sf::Vector2f()),
 m_initPosition(sf::Vector2f()),
 m_verticies(sf::VertexArray(sf::Quads, 4)),
+m_verticesOutdated(false),
+m_mesh(sf::VertexArray(sf::Triangles)),
+m_subdivision(1u),
 m_texture(nullptr),
-m_depths({})
+m_source(nullptr),
+m_ownTexture(nullptr),
+m_depths({}),
+m_transform()
 {
 
 }
@@ -15,23 +34,33 @@ AnimatedImage::AnimatedImage(const sf::Vector3f &position, std::unique_ptr<sf::T
 :
 m_initPosition(toV2f(position)),
 m_verticies(sf::VertexArray(sf::Quads, 4)),
-m_texture(std::move(texture)),
-m_depths({})
+m_verticesOutdated(false),
+m_mesh(sf::VertexArray(sf::Triangles)),
+m_subdivision(1u),
+m_texture(nullptr),
+m_source(nullptr),
+m_ownTexture(texture.get()),
+m_depths({}),
+m_transform()
 {
-	if(independent_size != sf::Vector2f())
-	{
-		m_initSize = independent_size;
-	}
-	else
-	{
-		m_initSize = static_cast<sf::Vector2f>(m_texture->getSize());
-	}
+	m_texture = std::move(texture);
+	this->setToTexture(independent_size);
+}
 
-	this->setToInitPosition();
-	m_verticies[0].texCoords = sf::Vector2f(0.f, 0.f);
-	m_verticies[1].texCoords = sf::Vector2f(m_texture->getSize().x, 0.f);
-	m_verticies[2].texCoords = static_cast<sf::Vector2f>(m_texture->getSize());
-	m_verticies[3].texCoords = sf::Vector2f(0.f, m_texture->getSize().y);
+AnimatedImage::AnimatedImage(const sf::Vector3f &position, ImageStore::Handle image, const sf::Vector2f &independent_size)
+:
+m_initPosition(toV2f(position)),
+m_verticies(sf::VertexArray(sf::Quads, 4)),
+m_verticesOutdated(false),
+m_mesh(sf::VertexArray(sf::Triangles)),
+m_subdivision(1u),
+m_texture(image, &image->texture),
+m_source(std::move(image)),
+m_ownTexture(nullptr),
+m_depths({}),
+m_transform()
+{
+	this->setToTexture(independent_size);
 }
 
 AnimatedImage::AnimatedImage(const AnimatedImage &copy)
@@ -39,13 +68,26 @@ AnimatedImage::AnimatedImage(const AnimatedImage &copy)
 m_initSize(copy.m_initSize),
 m_initPosition(copy.m_initPosition),
 m_verticies(copy.m_verticies),
-m_texture(std::make_unique<sf::Texture>(*(copy.m_texture.get())))
+m_verticesOutdated(copy.m_verticesOutdated),
+m_mesh(copy.m_mesh),
+m_subdivision(copy.m_subdivision),
+m_texture(copy.m_texture),
+m_source(copy.m_source),
+m_ownTexture(nullptr),
+m_transform(copy.m_transform)
 {
+	if(copy.m_ownTexture)
+	{
+		auto texture = std::make_shared<sf::Texture>(*copy.m_ownTexture);
+		m_ownTexture = texture.get();
+		m_texture = std::move(texture);
+	}
 	std::copy(copy.m_depths.begin(), copy.m_depths.end(), m_depths.begin());
 }
 
 const sf::Vector3f AnimatedImage::getPosition() const
 {
+	this->placeVertices();
 	return toV3f(m_verticies[0].position);
 }
 
@@ -56,19 +98,16 @@ const sf::Vector2f &AnimatedImage::getSize() const
 
 std::vector<unsigned char> AnimatedImage::getRGB() const
 {
-	std::vector<unsigned char> result;
-	const sf::Image &temp = (*(m_texture.get())).copyToImage();
-	const sf::Uint8 *pix = temp.getPixelsPtr();
-	unsigned size = static_cast<unsigned>(temp.getSize().x * temp.getSize().y * 4);
-	for(unsigned i = 0; i < size; i++)
+	if(m_source)
 	{
-		result.push_back(pix[i]);
+		return toPixels(m_source->pixels);
 	}
-	return result;
+	return toPixels(m_texture->copyToImage());
 }
 
 const std::array<float, 4> &AnimatedImage::getDepths() const
 {
+	this->placeVertices();
 	return m_depths;
 }
 
@@ -80,18 +119,179 @@ const float &AnimatedImage::getVertexDepth(const unsigned index) const
 	}
 	else
 	{
+		this->placeVertices();
 		return m_depths[index];
 	}
 }
 
-void AnimatedImage::render(sf::RenderTarget *target)
+const sf::Texture *AnimatedImage::getTexture() const
+{
+	return m_texture.get();
+}
+
+void AnimatedImage::render(sf::RenderTarget *target, const sf::Shader *shader, const sf::BlendMode &blend)
 {
+	this->placeVertices();
 	sf::RenderStates states(m_texture.get());
+	states.shader = shader;
+	states.blendMode = blend;
 	target->draw(m_verticies, states);
 }
 
+void AnimatedImage::renderWithDepth(sf::RenderTarget *target, sf::Shader &shader)
+{
+	//GLSL takes the matrix column by column
+	const em::Matrix4f transform = this->placement();
+	float columns[16];
+	for(unsigned column = 0; column < 4; column++)
+	{
+		for(unsigned row = 0; row < 4; row++)
+		{
+			columns[column * 4 + row] = transform[row][column];
+		}
+	}
+	shader.setUniform("transform", sf::Glsl::Mat4(columns));
+	shader.setUniform("source", sf::Shader::CurrentTexture);
+
+	sf::RenderStates states(m_texture.get());
+	states.shader = &shader;
+	target->draw(m_mesh, states);
+}
+
+void AnimatedImage::setSubdivision(const unsigned cells)
+{
+	const unsigned subdivision = std::max(cells, 1u);
+	if(subdivision != m_subdivision)
+	{
+		m_subdivision = subdivision;
+		this->buildMesh();
+	}
+}
+
+const std::string &AnimatedImage::getDepthVertexShaderSource()
+{
+	static const std::string source = R"(
+		uniform mat4 transform;
+		uniform vec2 center;
+		uniform float focal;
+		uniform float depthRange;
+
+		void main()
+		{
+			vec4 placed = transform * gl_Vertex;
+
+			//the eye looks at the center from the focal distance, w keeps texturing perspective correct
+			float w = focal > 0.0 ? max((focal + placed.z) / focal, 0.001) : 1.0;
+			vec4 projected = gl_ModelViewProjectionMatrix * vec4(center + (placed.xy - center) / w, 0.0, 1.0);
+			gl_Position = vec4(projected.xy * w, placed.z / depthRange * w, w);
+
+			gl_TexCoord[0] = gl_TextureMatrix[0] * gl_MultiTexCoord0;
+			gl_FrontColor = gl_Color;
+		}
+	)";
+	return source;
+}
+
+const std::string &AnimatedImage::getDepthFragmentShaderSource()
+{
+	static const std::string source = R"(
+		uniform sampler2D source;
+
+		void main()
+		{
+			vec4 color = gl_Color * texture2D(source, gl_TexCoord[0].xy);
+			if(color.a == 0.0)
+			{
+				discard;//transparent pixels do not hide what is behind them
+			}
+			gl_FragColor = color;
+		}
+	)";
+	return source;
+}
+
 //private memebr functions
-void AnimatedImage::setToInitPosition()
+void AnimatedImage::setToTexture(const sf::Vector2f &independent_size)
+{
+	if(independent_size != sf::Vector2f())
+	{
+		m_initSize = independent_size;
+	}
+	else
+	{
+		m_initSize = static_cast<sf::Vector2f>(m_texture->getSize());
+	}
+
+	this->setToInitPosition();
+	m_verticies[0].texCoords = sf::Vector2f(0.f, 0.f);
+	m_verticies[1].texCoords = sf::Vector2f(m_texture->getSize().x, 0.f);
+	m_verticies[2].texCoords = static_cast<sf::Vector2f>(m_texture->getSize());
+	m_verticies[3].texCoords = sf::Vector2f(0.f, m_texture->getSize().y);
+	this->buildMesh();
+}
+
+void AnimatedImage::placeVertices() const
+{
+	if(!m_verticesOutdated)
+	{
+		return;
+	}
+	m_verticesOutdated = false;
+
+	this->setToInitPosition();
+	if(m_transform != em::Matrix4f::identity())
+	{
+		const em::Matrix4f composite = this->placement();
+		std::array<sf::Vector3f, 4> corners;
+		for(unsigned i = 0; i < 4; i++)
+		{
+			corners[i] = toV3f(m_verticies[i].position);
+		}
+		composite.transform(corners.data(), corners.data(), corners.size());
+		for(unsigned i = 0; i < 4; i++)
+		{
+			m_verticies[i].position = toV2f(corners[i]);
+			m_depths[i] = corners[i].z;
+		}
+	}
+}
+
+void AnimatedImage::buildMesh()
+{
+	const unsigned cells = m_subdivision;
+	const sf::Vector2f texture_size = m_texture ? static_cast<sf::Vector2f>(m_texture->getSize()) : sf::Vector2f();
+	auto vertex = [this, cells, &texture_size](const unsigned column, const unsigned row)
+	{
+		const sf::Vector2f factor(static_cast<float>(column) / cells, static_cast<float>(row) / cells);
+		return sf::Vertex(
+			m_initPosition + sf::Vector2f(m_initSize.x * factor.x, m_initSize.y * factor.y),
+			sf::Vector2f(texture_size.x * factor.x, texture_size.y * factor.y));
+	};
+
+	m_mesh.clear();
+	for(unsigned row = 0; row < cells; row++)
+	{
+		for(unsigned column = 0; column < cells; column++)
+		{
+			m_mesh.append(vertex(column, row));
+			m_mesh.append(vertex(column + 1u, row));
+			m_mesh.append(vertex(column + 1u, row + 1u));
+			m_mesh.append(vertex(column, row));
+			m_mesh.append(vertex(column + 1u, row + 1u));
+			m_mesh.append(vertex(column, row + 1u));
+		}
+	}
+}
+
+em::Matrix4f AnimatedImage::placement() const
+{
+	//the transform pivots around the top-left corner of the image
+	return em::Matrix4f::translation(m_initPosition.x, m_initPosition.y, 0.f)
+		* m_transform
+		* em::Matrix4f::translation(-m_initPosition.x, -m_initPosition.y, 0.f);
+}
+
+void AnimatedImage::setToInitPosition() const
 {
 	m_verticies[0].position.x = m_initPosition.x;
 	m_verticies[1].position.x = m_initPosition.x + m_initSize.x;
@@ -106,16 +306,6 @@ void AnimatedImage::setToInitPosition()
 	m_depths.fill(0.f);
 }
 
-const sf::Vector3f AnimatedImage::getVertexPosition(const int &index) const
-{
-	int uindex = index % m_verticies.getVertexCount(); //unsigned index
-	sf::Vector3f result;
-	result.x = m_verticies[uindex].position.x;
-	result.y = m_verticies[uindex].position.y;
-	result.z = m_depths[0];
-	return result;
-}
-
 const sf::Vector2f AnimatedImage::toV2f(const sf::Vector3f &origin) const
 {
 	return sf::Vector2f(origin.x, origin.y);
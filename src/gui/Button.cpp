@@ -76,5 +76,18 @@ void Button::update(sf::Vector2i mousePos, sf::Event &event)
 
 void Button::render(sf::RenderTarget *target)
 {
-    target->draw(m_shape);
+    GuiBatch batch;
+    batch.setSolidTexture(&IconAtlas::shared().getTexture(), IconAtlas::shared().getWhitePixel());
+    this->batch(batch);
+    batch.draw(*target);
+}
+
+void Button::batch(GuiBatch &target) const
+{
+    target.add(m_shape);
+}
+
+std::size_t Button::getLookKey() const
+{
+    return Object::combineLook(Object::getLookKey(), m_state);
 }
@@ -1,152 +1,370 @@
 #include "../../include/gui/Canvas.h"
 #include "../../include/program/Program.h"
+#include "../../include/util/Profiler.h"
+
+#include <SFML/OpenGL.hpp>
+
+namespace
+{
+	const unsigned MAX_PREVIEW_DIVISOR = 4u;//images are never shrunk below a quarter of the plane to fit the memory budget
+	const unsigned MAX_SUBFRAMES = 64u;//motion blur of more instants changes nothing an 8 bit frame shows
+	const unsigned SCRUB_DIVISOR = 4u;//images of a scrubbed pixel animation are a quarter of the plane, a sixteenth of its pixels
+	const float NO_TIME = -1.f;//times of the animation are never negative
+	const sf::BlendMode BLEND_PREMULTIPLIED(sf::BlendMode::One, sf::BlendMode::OneMinusSrcAlpha);//colors are already multiplied by alpha
+}//anonymous namespace
 
 Canvas::Canvas()
 :
 m_plane(),
+m_hasDepthBuffer(false),
 m_planeBody(sf::Sprite()),
+m_size(),
 m_objAnim(nullptr),
 m_pixAnim(nullptr),
 m_animType(Canvas::AnimationType::NONE),
+m_imageTier(Canvas::ImageTier::PREVIEW),
+m_previewDivisor(1u),
+m_startingPath(),
+m_endingPath(),
+m_startingSource(nullptr),
+m_endingSource(nullptr),
 m_startingImage(nullptr),
 m_endingImage(nullptr),
 m_pixelImageIn(nullptr),
 m_pixelImageOut(nullptr),
-m_isAnimPlaying(false),
-m_currentAnimTime(0.f),
-m_totalAnimTime(0.f)
+m_pixShader(nullptr),
+m_maskShader(nullptr),
+m_depthShader(nullptr),
+m_perspective(0.f),
+m_maskIn(),
+m_maskOut(),
+m_premultipliedAlpha(false),
+m_frameCache(),
+m_cachedFrame(nullptr),
+m_imagesOutdated(false),
+m_evaluatedTime(NO_TIME),
+m_drawnTime(NO_TIME),
+m_pixelFramesTime(NO_TIME),
+m_imagesCharge(MemorySubsystem::IMAGES),
+m_framesCharge(MemorySubsystem::ANIMATIONS),
+m_bufferPool(MemorySubsystem::EXPORT),
+m_sequence(nullptr),
+m_sequenceTexture(),
+m_sequenceFrame(0u),
+m_playback(),
+m_scrubbing(false),
+m_motionBlur(1u),
+m_blurPlane(),
+m_readback(m_bufferPool),
+m_heldImageIn(nullptr),
+m_heldImageOut(nullptr),
+m_heldPixels1(),
+m_heldPixels2()
 {
-	m_plane.create(1.f, 1.f);
+	this->createPlane(sf::Vector2u(1u, 1u));
+	this->accountMemory();
 }
 
 Canvas::Canvas(const sf::Vector2f &position, const sf::Vector2f &size)
 :
 m_plane(),
+m_hasDepthBuffer(false),
 m_planeBody(sf::Sprite()),
+m_size(),
 m_objAnim(nullptr),
 m_pixAnim(nullptr),
 m_animType(Canvas::AnimationType::NONE),
+m_imageTier(Canvas::ImageTier::PREVIEW),
+m_previewDivisor(1u),
+m_startingPath(),
+m_endingPath(),
+m_startingSource(nullptr),
+m_endingSource(nullptr),
 m_startingImage(nullptr),
 m_endingImage(nullptr),
 m_pixelImageIn(nullptr),
 m_pixelImageOut(nullptr),
-m_isAnimPlaying(false),
-m_currentAnimTime(0.f),
-m_totalAnimTime(0.f)
+m_pixShader(nullptr),
+m_maskShader(nullptr),
+m_depthShader(nullptr),
+m_perspective(0.f),
+m_maskIn(),
+m_maskOut(),
+m_premultipliedAlpha(false),
+m_frameCache(),
+m_cachedFrame(nullptr),
+m_imagesOutdated(false),
+m_evaluatedTime(NO_TIME),
+m_drawnTime(NO_TIME),
+m_pixelFramesTime(NO_TIME),
+m_imagesCharge(MemorySubsystem::IMAGES),
+m_framesCharge(MemorySubsystem::ANIMATIONS),
+m_bufferPool(MemorySubsystem::EXPORT),
+m_sequence(nullptr),
+m_sequenceTexture(),
+m_sequenceFrame(0u),
+m_playback(),
+m_scrubbing(false),
+m_motionBlur(1u),
+m_blurPlane(),
+m_readback(m_bufferPool),
+m_heldImageIn(nullptr),
+m_heldImageOut(nullptr),
+m_heldPixels1(),
+m_heldPixels2()
 {
-	m_plane.create(size.x, size.y);
+	this->createPlane(static_cast<sf::Vector2u>(size));
 	m_planeBody.setPosition(position);
+	m_size = size;
+	this->accountMemory();
 }
 
-void Canvas::setAnimation(std::unique_ptr<ObjectAnimation> new_animation)
+void Canvas::setAnimation(std::unique_ptr<ObjectAnimation> new_animation, const bool use_shader)
 {
 	m_animType = Canvas::AnimationType::OBJ_ANIM;
 	this->clearAnimation();
+	this->invalidateFrames();
 	m_objAnim = std::move(new_animation);
 
+	if(use_shader && m_hasDepthBuffer && sf::Shader::isAvailable())
+	{
+		m_depthShader = this->findShader(AnimatedImage::getDepthFragmentShaderSource(), AnimatedImage::getDepthVertexShaderSource());
+	}
+
 	if(m_startingImage)
 	{
-		m_startingImage->transformUpdate(m_objAnim->getImage1Frame(m_currentAnimTime));
+		m_startingImage->transformUpdate(m_objAnim->getImage1Frame(m_playback.getTime()));
 	}
 	if(m_endingImage)
 	{
-		m_endingImage->transformUpdate(m_objAnim->getImage2Frame(m_currentAnimTime));
+		m_endingImage->transformUpdate(m_objAnim->getImage2Frame(m_playback.getTime()));
 	}
 }
 
-void Canvas::setAnimation(std::unique_ptr<PixelAnimation> new_animation)
+void Canvas::setAnimation(std::unique_ptr<PixelAnimation> new_animation, const bool use_shader)
 {
+	//pixels of the images are kept from the previous pixel animation, not read and uploaded again
+	this->setScrubbing(false);
+	std::unique_ptr<PixelAnimation> previous;
+	if(m_animType == Canvas::AnimationType::PIX_ANIM)
+	{
+		previous = std::move(m_pixAnim);
+	}
+	//frames computed on the CPU were uploaded into the textures in place of the images
+	const bool textures_hold_images = m_pixShader || this->usesAlphaMasks();
 	m_animType = Canvas::AnimationType::PIX_ANIM;
 	this->clearAnimation();
+	this->invalidateFrames();
 	m_pixAnim = std::move(new_animation);
 
-	if(m_startingImage)
+	const std::string &source = m_pixAnim->getShaderSource();
+	if(use_shader && !source.empty() && sf::Shader::isAvailable())
 	{
-		m_startingImage->transformUpdate();
-		m_pixelImageIn = std::make_unique<AnimatedImage>(*(m_startingImage.get()));
-		m_pixAnim->setPixels1(m_startingImage->getRGB());
-		m_pixelImageIn->pixelUpdate(m_pixAnim->getTexture1Frame(m_currentAnimTime));
+		m_pixShader = this->findShader(source);
 	}
-	if(m_endingImage)
+	else if(m_pixAnim->hasAlphaMasks() && sf::Shader::isAvailable())
 	{
-		m_endingImage->transformUpdate();
-		m_pixelImageOut = std::make_unique<AnimatedImage>(*(m_endingImage.get()));
-		m_pixAnim->setPixels2(m_endingImage->getRGB());
-		m_pixelImageOut->pixelUpdate(m_pixAnim->getTexture2Frame(m_currentAnimTime));
+		m_maskShader = this->findShader(AlphaMask::getShaderSource());
 	}
-}
 
-void Canvas::setStartingImage(const sf::String &directory_path)
-{
-	this->clearStartingImage();
-	auto tex = std::make_unique<sf::Texture>();
-	tex->loadFromFile(directory_path);
-	m_startingImage = std::make_unique<AnimatedImage>(sf::Vector3f(), std::move(tex), static_cast<sf::Vector2f>(m_plane.getSize()));
-	if(m_animType == Canvas::AnimationType::OBJ_ANIM)
+	if(previous && previous->isPremultiplied() == this->usesPremultipliedAlpha()
+		&& m_startingImage && m_endingImage && m_pixelImageIn && m_pixelImageOut)
 	{
-		if(m_objAnim)
+		//the same images in the same layout, only the plan of the new animation is built
+		m_startingImage->transformUpdate();
+		m_endingImage->transformUpdate();
+		m_pixAnim->takePixels(*previous);
+		if(!textures_hold_images && (m_pixShader || m_maskShader))//shaders read the images from the textures
 		{
-			m_startingImage->transformUpdate(m_objAnim->getStartingTransform1());
+			m_pixelImageIn->pixelUpdate(m_pixAnim->getPixels1());
+			m_pixelImageOut->pixelUpdate(m_pixAnim->getPixels2());
 		}
-		else
+	}
+	else
+	{
+		m_pixAnim->setPremultiplied(this->usesPremultipliedAlpha());
+		if(m_startingImage)
 		{
 			m_startingImage->transformUpdate();
+			std::vector<unsigned char> pixels = this->animationPixels(*m_startingImage);
+			m_pixelImageIn = this->makePixelImage(*m_startingSource, pixels);
+			m_pixAnim->setPixels1(std::move(pixels));
 		}
-	}
-	else if(m_animType == Canvas::AnimationType::PIX_ANIM)//
-	{
-		if(m_pixAnim)
+		if(m_endingImage)
 		{
-			m_pixelImageIn->pixelUpdate(m_pixAnim->getPixels1());
+			m_endingImage->transformUpdate();
+			std::vector<unsigned char> pixels = this->animationPixels(*m_endingImage);
+			m_pixelImageOut = this->makePixelImage(*m_endingSource, pixels);
+			m_pixAnim->setPixels2(std::move(pixels));
 		}
-		else
+	}
+	previous.reset();
+	this->updatePixelFrames(m_playback.getTime());
+	this->placePixelImages(m_playback.getTime());
+}
+
+void Canvas::setAnimation(AnyAnimation new_animation, const bool use_shader)
+{
+	std::visit([this, use_shader](auto &&animation)
+	{
+		this->setAnimation(std::move(animation), use_shader);
+	}, releaseAnimation(std::move(new_animation)));
+}
+
+const KeyframeTrack *Canvas::getKeyframes(const unsigned image) const
+{
+	if(m_animType != Canvas::AnimationType::OBJ_ANIM || !m_objAnim->isKeyframed())
+	{
+		return nullptr;
+	}
+	return image == 1u ? &m_objAnim->getTrack1() : image == 2u ? &m_objAnim->getTrack2() : nullptr;
+}
+
+bool Canvas::editKeyframes(const unsigned image, const std::function<void(KeyframeTrack &)> &edit)
+{
+	if(m_animType != Canvas::AnimationType::OBJ_ANIM || !m_objAnim->isKeyframed())
+	{
+		return false;
+	}
+	KeyframeTrack &track = m_objAnim->editTrack(image);
+	const KeyframeTrack before = track;
+	edit(track);
+	const ProgressRange changed = track.changedRange(before);
+	if(changed.isEmpty())
+	{
+		return true;
+	}
+
+	//frames are cached by their index, each one shows the progress at the time of its index
+	const FrameGrid &grid = m_playback.getGrid();
+	for(unsigned frame = 0; frame < grid.getFrames(); frame++)
+	{
+		if(changed.contains(m_objAnim->progressAt(grid.timeOf(frame))))
 		{
-			m_pixelImageIn->pixelUpdate();
+			m_frameCache.erase(frame);
 		}
 	}
+	m_cachedFrame = nullptr;
+	if(changed.contains(m_objAnim->progressAt(m_playback.getTime())))
+	{
+		m_evaluatedTime = NO_TIME;
+		m_drawnTime = NO_TIME;
+	}
+	Program::requestUpdate();
+	return true;
+}
+
+bool Canvas::isShaderActive() const
+{
+	return m_animType == Canvas::AnimationType::PIX_ANIM && m_pixShader != nullptr;
+}
+
+void Canvas::setPerspective(const float focal)
+{
+	const float perspective = std::max(focal, 0.f);
+	if(perspective != m_perspective)
+	{
+		m_perspective = perspective;
+		this->invalidateFrames();
+	}
+}
+
+float Canvas::getPerspective() const
+{
+	return m_perspective;
+}
+
+void Canvas::setStartingImage(const sf::String &directory_path)
+{
+	//the held full resolution images would be restored over the new ones
+	this->setScrubbing(false);
+	this->clearStartingImage();
+	this->invalidateFrames();
+	m_startingPath = directory_path;
+	m_startingSource = this->loadImage(m_startingPath);
+	m_startingImage = std::make_unique<AnimatedImage>(sf::Vector3f(), m_startingSource, static_cast<sf::Vector2f>(m_plane.getSize()));
+	//the animation is kept, only the image it works on is replaced
+	if(m_animType == Canvas::AnimationType::OBJ_ANIM && m_objAnim)
+	{
+		m_startingImage->transformUpdate(m_objAnim->getImage1Frame(m_playback.getTime()));
+	}
+	else if(m_animType == Canvas::AnimationType::PIX_ANIM && m_pixAnim)
+	{
+		std::vector<unsigned char> pixels = this->animationPixels(*m_startingImage);
+		m_pixelImageIn = this->makePixelImage(*m_startingSource, pixels);
+		m_pixAnim->setPixels1(std::move(pixels));
+		this->updatePixelFrames(m_playback.getTime());
+		this->placePixelImages(m_playback.getTime());
+	}
 }
 
 void Canvas::setEndingImage(const sf::String &directory_path)
 {
+	this->setScrubbing(false);
 	this->clearEndingImage();
-	auto tex = std::make_unique<sf::Texture>();
-	tex->loadFromFile(directory_path);
-	m_endingImage = std::make_unique<AnimatedImage>(sf::Vector3f(), std::move(tex), static_cast<sf::Vector2f>(m_plane.getSize()));
-	if(m_animType == Canvas::AnimationType::OBJ_ANIM)
+	this->invalidateFrames();
+	m_endingPath = directory_path;
+	m_endingSource = this->loadImage(m_endingPath);
+	m_endingImage = std::make_unique<AnimatedImage>(sf::Vector3f(), m_endingSource, static_cast<sf::Vector2f>(m_plane.getSize()));
+	if(m_animType == Canvas::AnimationType::OBJ_ANIM && m_objAnim)
 	{
-		if(m_objAnim)
-		{
-			m_endingImage->transformUpdate(m_objAnim->getStartingTransform2());
-		}
-		else
-		{
-			m_endingImage->transformUpdate();
-		}
+		m_endingImage->transformUpdate(m_objAnim->getImage2Frame(m_playback.getTime()));
 	}
-	else if(m_animType == Canvas::AnimationType::PIX_ANIM)
+	else if(m_animType == Canvas::AnimationType::PIX_ANIM && m_pixAnim)
 	{
-		if(m_pixAnim)
-		{
-			m_pixelImageOut->pixelUpdate(m_pixAnim->getPixels2());
-		}
-		else
-		{
-			m_pixelImageOut->pixelUpdate();
-		}
+		std::vector<unsigned char> pixels = this->animationPixels(*m_endingImage);
+		m_pixelImageOut = this->makePixelImage(*m_endingSource, pixels);
+		m_pixAnim->setPixels2(std::move(pixels));
+		this->updatePixelFrames(m_playback.getTime());
+		this->placePixelImages(m_playback.getTime());
 	}
 }
 
-void Canvas::setCurrentAnimationTime(const float &current_time)
+void Canvas::setImageTier(const ImageTier tier)
+{
+	m_frameCache.setBudget(std::max(m_frameCache.getBudget(), FrameCache::DEFAULT_BUDGET));
+	if(tier != m_imageTier || m_previewDivisor != 1u)
+	{
+		m_imageTier = tier;
+		m_previewDivisor = 1u;
+		this->reloadImages();
+	}
+}
+
+Canvas::ImageTier Canvas::getImageTier() const
+{
+	return m_imageTier;
+}
+
+void Canvas::setPremultipliedAlpha(const bool premultiplied)
 {
-	if(current_time >= 0.f)
+	if(premultiplied == m_premultipliedAlpha)
+	{
+		return;
+	}
+	this->setScrubbing(false);
+	m_premultipliedAlpha = premultiplied;
+	if(m_animType == Canvas::AnimationType::PIX_ANIM && m_pixAnim)
 	{
-		m_currentAnimTime = current_time;
+		//images given to the animation have to be converted
+		m_pixAnim->setPremultiplied(this->usesPremultipliedAlpha());
+		this->reloadImages();
 	}
 }
 
+bool Canvas::isPremultipliedAlpha() const
+{
+	return m_premultipliedAlpha;
+}
+
+void Canvas::setCurrentAnimationTime(const float &current_time)
+{
+	m_playback.setTime(current_time);
+}
+
 void Canvas::setCurrentAnimationProgress(const float &current_progress)
 {
-	m_currentAnimTime = current_progress * m_totalAnimTime;
+	m_playback.setTime(current_progress * m_playback.getLength());
 }
 
 
@@ -154,7 +372,11 @@ void Canvas::setTotalAnimationTime(const float &seconds)
 {
 	if(seconds > 0.f)
 	{
-		m_totalAnimTime = seconds;
+		if(seconds != m_playback.getLength())
+		{
+			this->invalidateFrames();
+		}
+		m_playback.setLength(seconds);
 
 		if(m_animType == Canvas::AnimationType::OBJ_ANIM)
 		{
@@ -169,13 +391,37 @@ void Canvas::setTotalAnimationTime(const float &seconds)
 
 void Canvas::setAnimationPlayOn(const bool status)
 {
-	m_isAnimPlaying = status;
+	m_playback.setPlaying(status);
 }
 
 void Canvas::setSize(const sf::Vector2f &new_size)
 {
+	m_size = new_size;
+}
+
+const sf::Vector2f &Canvas::getSize() const
+{
+	return m_size;
+}
+
+void Canvas::setRenderSize(const sf::Vector2u &size)
+{
+	if(size == m_plane.getSize() || size.x == 0u || size.y == 0u)
+	{
+		return;
+	}
+	//the held images are of the old size
+	this->setScrubbing(false);
 	m_plane.clear();
-	m_plane.create(new_size.x, new_size.y);
+	this->createPlane(size);
+	this->invalidateFrames();
+	this->reloadImages();
+	this->accountMemory();
+}
+
+sf::Vector2u Canvas::getRenderSize() const
+{
+	return m_plane.getSize();
 }
 
 void Canvas::setPosition(const sf::Vector2f &new_position)
@@ -183,93 +429,355 @@ void Canvas::setPosition(const sf::Vector2f &new_position)
 	m_planeBody.setPosition(new_position);
 }
 
+const sf::Vector2f &Canvas::getPosition() const
+{
+	return m_planeBody.getPosition();
+}
+
+
+void Canvas::setFrameGrid(const FrameGrid &grid)
+{
+	if(grid != m_playback.getGrid())
+	{
+		m_playback.setGrid(grid);
+		this->invalidateFrames();
+	}
+}
+
+void Canvas::setPlayback(const PlaybackCursor &playback)
+{
+	this->setFrameGrid(playback.getGrid());
+	m_playback.setTime(playback.getTime());
+	m_playback.setPlaying(playback.isPlaying());
+	this->setScrubbing(playback.isScrubbing());
+}
+
+const PlaybackCursor &Canvas::getPlayback() const
+{
+	return m_playback;
+}
+
+void Canvas::setScrubbing(const bool scrubbing)
+{
+	const sf::Vector2u size = m_plane.getSize() / SCRUB_DIVISOR;
+	const bool lowered = scrubbing && m_animType == Canvas::AnimationType::PIX_ANIM && m_pixAnim && !m_pixShader
+		&& m_pixelImageIn && m_pixelImageOut && size.x > 0u && size.y > 0u
+		&& m_pixAnim->getPixels1().size() > MemoryCharge::bytesOf(size);
+	if(lowered == m_scrubbing)
+	{
+		return;
+	}
+
+	if(lowered)
+	{
+		//shrunk images stay in the store, so scrubbing the same images again decodes nothing
+		const ImageStore::Handle starting = ImageStore::shared().load(m_startingPath, size);
+		const ImageStore::Handle ending = ImageStore::shared().load(m_endingPath, size);
+		const sf::Vector2f plane_size(m_plane.getSize());
+		std::vector<unsigned char> pixels1 = this->animationPixels(AnimatedImage(sf::Vector3f(), starting, plane_size));
+		std::vector<unsigned char> pixels2 = this->animationPixels(AnimatedImage(sf::Vector3f(), ending, plane_size));
+		m_heldImageIn = std::exchange(m_pixelImageIn, this->makePixelImage(*starting, pixels1));
+		m_heldImageOut = std::exchange(m_pixelImageOut, this->makePixelImage(*ending, pixels2));
+		m_heldPixels1 = m_pixAnim->getPixels1();
+		m_heldPixels2 = m_pixAnim->getPixels2();
+		m_pixAnim->setPixels1(std::move(pixels1));
+		m_pixAnim->setPixels2(std::move(pixels2));
+	}
+	else
+	{
+		m_pixelImageIn = std::move(m_heldImageIn);
+		m_pixelImageOut = std::move(m_heldImageOut);
+		m_pixAnim->setPixels1(std::exchange(m_heldPixels1, std::vector<unsigned char>()));
+		m_pixAnim->setPixels2(std::exchange(m_heldPixels2, std::vector<unsigned char>()));
+	}
+	m_scrubbing = lowered;
+
+	//every pixel of the other resolution has to be written and drawn again
+	m_cachedFrame = nullptr;
+	m_evaluatedTime = NO_TIME;
+	m_drawnTime = NO_TIME;
+	m_pixelFramesTime = NO_TIME;
+	this->placePixelImages(m_playback.getTime());
+	this->accountMemory();
+}
 
 sf::RenderTexture& Canvas::getPlane()
 {
 	return m_plane;
 }
 
-void Canvas::update(sf::Vector2i mousePos, sf::Event &event)
+const sf::Texture &Canvas::getFrameTexture() const
 {
-	if(m_animType == Canvas::AnimationType::OBJ_ANIM)
+	if(m_sequence)
 	{
-		if(m_startingImage)
-		{
-			m_startingImage->transformUpdate(m_objAnim->getImage1Frame(m_currentAnimTime));
-		}
-		if(m_endingImage)
+		return m_sequenceTexture;
+	}
+	return m_cachedFrame ? *m_cachedFrame : m_plane.getTexture();
+}
+
+FrameCache &Canvas::getFrameCache()
+{
+	return m_frameCache;
+}
+
+bool Canvas::prerenderFrame()
+{
+	if(m_sequence || !this->isFrameCached() || m_playback.isPlaying() || m_scrubbing || !m_frameCache.hasRoomFor(m_plane.getSize()))
+	{
+		return false;
+	}
+
+	const FrameGrid &grid = m_playback.getGrid();
+	const unsigned current = grid.nearestFrame(m_playback.getTime());
+	for(unsigned i = 1; i < grid.getFrames(); i++)
+	{
+		const unsigned frame = (current + i) % grid.getFrames();
+		if(!m_frameCache.contains(frame))
 		{
-			m_endingImage->transformUpdate(m_objAnim->getImage2Frame(m_currentAnimTime));
+			//drawn at the time of the frame, the shown time is left as it is
+			this->updateImages(grid.timeOf(frame));
+			this->drawPlane(grid.timeOf(frame));
+			m_frameCache.store(frame, m_plane.getTexture());
+
+			m_cachedFrame = m_frameCache.find(current);
+			if(!m_cachedFrame)//the plane has to be drawn again at the shown time
+			{
+				this->updateImages(m_playback.getTime());
+			}
+			return true;
 		}
 	}
-	else if(m_animType == Canvas::AnimationType::PIX_ANIM && m_pixelImageIn && m_pixelImageOut)
+	return false;
+}
+
+void Canvas::update(sf::Vector2i mousePos, sf::Event &event)
+{
+	BCG_PROFILE_SCOPE("Canvas::update");
+	m_cachedFrame = nullptr;
+	this->fitIntoBudget();
+	if(this->isFrameCached() && !m_playback.isPlaying())
 	{
-		m_pixelImageIn->pixelUpdate(m_pixAnim->getTexture1Frame(m_currentAnimTime));
-		m_pixelImageOut->pixelUpdate(m_pixAnim->getTexture2Frame(m_currentAnimTime));
+		const unsigned frame = m_playback.getGrid().nearestFrame(m_playback.getTime());
+		m_playback.seekFrame(frame);
+		m_cachedFrame = m_frameCache.find(frame);
 	}
 
-	if(m_isAnimPlaying)
+	//images are updated once before drawing, however many updates happen in between, and only when the time moved
+	m_imagesOutdated = !m_cachedFrame && m_playback.getTime() != m_evaluatedTime;
+
+	if(m_playback.isPlaying())
 	{
 		Program::requestUpdate();
 	}
-	else
+}
+
+void Canvas::render(sf::RenderTarget *target)
+{
+	this->renderPlane();
+	m_planeBody.setTexture(this->getFrameTexture(), true);
+	sf::Sprite body(m_planeBody);
+	this->placeFrame(body, this->getFrameTexture());
+	target->draw(body);
+}
+
+void Canvas::present(sf::RenderTarget *target, const sf::Texture &frame) const
+{
+	sf::Sprite body(frame);
+	this->placeFrame(body, frame);
+	target->draw(body);
+}
+
+void Canvas::renderPlane()
+{
+	BCG_PROFILE_SCOPE("Canvas::render");
+	if(m_sequence)
 	{
-		Program::expireRequestUpdate();
+		this->showSequenceFrame();
+	}
+	else if(!m_cachedFrame)
+	{
+		const float &time = m_playback.getTime();
+		if(m_imagesOutdated)
+		{
+			this->updateImages(time);
+		}
+		if(m_drawnTime != time)//a paused animation keeps the plane as it is
+		{
+			this->drawPlane(time);
+		}
+		if(this->isFrameCached() && !m_playback.isPlaying() && !m_scrubbing)
+		{
+			m_cachedFrame = m_frameCache.store(m_playback.getGrid().nearestFrame(time), m_plane.getTexture());
+		}
 	}
 }
 
-void Canvas::render(sf::RenderTarget *target)
+void Canvas::setMotionBlur(const unsigned subframes)
 {
-	m_plane.clear();
+	m_motionBlur = std::clamp(subframes, 1u, MAX_SUBFRAMES);
+}
 
-	bool eI = false, sI = false;
-	if(m_animType == Canvas::AnimationType::OBJ_ANIM)
+unsigned Canvas::getMotionBlur() const
+{
+	return m_motionBlur;
+}
+
+void Canvas::renderSequence(const std::vector<float> &times, const std::function<void(ExportFrame)> &consumer, SequenceCache *cache)
+{
+	this->setScrubbing(false);//exported frames are always of full quality
+	m_readback.discard();//reads of a sequence abandoned by an exception
+	std::unique_ptr<SequenceCache::Recording> recording;
+	std::uint64_t hash = 0u;
+	if(cache && this->hashSequence(*cache, times, hash))
 	{
-		if(m_endingImage)
+		if(cache->replay(hash, m_bufferPool, consumer))
 		{
-			eI = true;
+			return;
 		}
-		if(m_startingImage)
+		try
 		{
-			sI = true;
+			recording = cache->record(hash);
 		}
-		if(m_startingImage->getVertexDepth(0) > m_endingImage->getVertexDepth(0))
+		catch(const std::runtime_error &)
 		{
-			if(sI)
-			{
-				m_startingImage->render(&m_plane);
-			}
-			if(eI)
+			//the sequence is rendered all the same, only without being stored
+		}
+	}
+
+	//subframes lead up to their frame from the previous one, the first frame has nothing before it
+	const unsigned subframes = m_motionBlur;
+	std::vector<float> sampled = times;
+	if(subframes > 1u)
+	{
+		if(m_blurPlane.getSize() != m_plane.getSize() && !m_blurPlane.create(m_plane.getSize().x, m_plane.getSize().y))
+		{
+			throw std::runtime_error("Canvas::renderSequence(): cannot create the texture of blurred frames");
+		}
+		this->accountMemory();
+		sampled.clear();
+		sampled.reserve(times.size() * subframes);
+		for(std::size_t i = 0; i < times.size(); i++)
+		{
+			const float shutter = i > 0u ? times[i] - times[i - 1u] : 0.f;
+			for(unsigned subframe = 0; subframe < subframes; subframe++)
 			{
-				m_endingImage->render(&m_plane);
+				const float before = shutter * static_cast<float>(subframes - 1u - subframe) / static_cast<float>(subframes);
+				sampled.push_back(std::max(times[i] - before, 0.f));
 			}
 		}
-		else
+	}
+
+	//frames are read back while the next ones are drawn, so they reach the consumer a few frames late
+	auto deliver = [&](ExportFrame frame)
+	{
+		if(recording)
 		{
-			if(eI)
+			try
 			{
-				m_endingImage->render(&m_plane);
+				recording->add(frame);
 			}
-			if(sI)
+			catch(const std::runtime_error &)
+			{
+				recording.reset();
+			}
+		}
+		consumer(std::move(frame));
+	};
+
+	//frames are drawn at their own times, the shown time is left as it is
+	std::size_t drawn = 0u;
+	auto draw = [&](const float &time)
+	{
+		this->drawPlane(time);
+		const unsigned subframe = static_cast<unsigned>(drawn++ % subframes);
+		if(subframes > 1u)
+		{
+			this->accumulateSubframe(subframe);
+			if(subframe + 1u < subframes)
 			{
-				m_startingImage->render(&m_plane);
+				return;
 			}
 		}
+		m_readback.read(subframes > 1u ? m_blurPlane : m_plane, deliver);
+	};
+
+	if(m_animType == Canvas::AnimationType::OBJ_ANIM && m_startingImage && m_endingImage)
+	{
+		m_objAnim->sample(sampled, [&](const std::size_t, const AnimationFrame &frame)
+		{
+			m_startingImage->transformUpdate(frame.transform1);
+			m_endingImage->transformUpdate(frame.transform2);
+			draw(frame.time);
+		});
 	}
-	else if(m_animType == Canvas::AnimationType::PIX_ANIM && m_pixelImageIn && m_pixelImageOut)
+	else if(m_animType == Canvas::AnimationType::PIX_ANIM && this->usesAlphaMasks())
+	{
+		//whole frames would overwrite the colors the masks are drawn over
+		for(const float &time : sampled)
+		{
+			this->updatePixelFrames(time);
+			this->placePixelImages(time);
+			draw(time);
+		}
+	}
+	else if(m_animType == Canvas::AnimationType::PIX_ANIM && !m_pixShader && m_pixelImageIn && m_pixelImageOut)
 	{
-		m_pixelImageOut->render(&m_plane);
-		m_pixelImageIn->render(&m_plane);
+		m_pixAnim->sample(sampled, [&](const std::size_t, const AnimationFrame &frame)
+		{
+			m_pixelImageIn->pixelUpdate(frame.pixels1);
+			m_pixelImageOut->pixelUpdate(frame.pixels2);
+			this->placePixelImages(frame.time);
+			draw(frame.time);
+		});
+	}
+	else//shaders compute the frame while drawing
+	{
+		for(const float &time : sampled)
+		{
+			this->placePixelImages(time);
+			draw(time);
+		}
 	}
 
-	m_plane.display();
-	m_planeBody.setTexture(m_plane.getTexture(), true);
-	target->draw(m_planeBody);
+	m_readback.finish(deliver);
+	this->accountMemory();
+
+	m_cachedFrame = nullptr;
+	m_pixelFramesTime = NO_TIME;//textures hold the last frame of the sequence
+	this->updateImages(m_playback.getTime());
+
+	if(recording && !times.empty())
+	{
+		try
+		{
+			recording->commit();
+		}
+		catch(const std::runtime_error &)
+		{
+			//an incomplete sequence is dropped with the recording
+		}
+	}
 }
 
 //private member functions
+void Canvas::createPlane(const sf::Vector2u &size)
+{
+	//contexts without a depth buffer fall back to sorted drawing of object animations
+	m_hasDepthBuffer = m_plane.create(size.x, size.y, sf::ContextSettings(24u));
+	if(!m_hasDepthBuffer)
+	{
+		m_plane.create(size.x, size.y);
+	}
+}
+
 void Canvas::clearAnimation()
 {
+	this->setScrubbing(false);
+	m_pixShader = nullptr;
+	m_maskShader = nullptr;
+	m_depthShader = nullptr;
+	m_maskIn.clear();
+	m_maskOut.clear();
 	if(m_pixAnim != nullptr)
 	{
 		m_pixAnim.reset();
@@ -282,21 +790,523 @@ void Canvas::clearAnimation()
 
 void Canvas::clearStartingImage()
 {
+	this->setScrubbing(false);
 	if(m_startingImage != nullptr)
 	{
 		m_startingImage.reset();
 	}
+	m_startingSource.reset();
 }
 
 void Canvas::clearEndingImage()
 {
+	this->setScrubbing(false);
 	if(m_endingImage != nullptr)
 	{
 		m_endingImage.reset();
 	}
+	m_endingSource.reset();
+}
+
+ImageStore::Handle Canvas::loadImage(const std::string &path) const
+{
+	if(m_imageTier == Canvas::ImageTier::PREVIEW)
+	{
+		return ImageStore::shared().load(path, m_plane.getSize() / m_previewDivisor);
+	}
+	return ImageStore::shared().load(path);
+}
+
+void Canvas::setSequence(std::shared_ptr<const RawSequence> sequence)
+{
+	m_sequence = std::move(sequence);
+	m_sequenceFrame = 0u;
+	if(m_sequence)
+	{
+		const sf::Vector2u size = m_sequence->getSize();
+		if(m_sequenceTexture.getSize() != size && !m_sequenceTexture.create(size.x, size.y))
+		{
+			m_sequence = nullptr;
+			throw std::runtime_error("Canvas::setSequence(): cannot create the texture of the sequence");
+		}
+		m_sequenceFrame = m_sequence->getFrameCount();//no frame uploaded yet
+	}
+	else
+	{
+		m_sequenceTexture = sf::Texture();
+	}
+	this->accountMemory();
+}
+
+const RawSequence *Canvas::getSequence() const
+{
+	return m_sequence.get();
+}
+
+void Canvas::reloadImages()
+{
+	this->setScrubbing(false);
+	//copies, as setting an image assigns its path
+	const std::string starting = m_startingPath, ending = m_endingPath;
+	if(!starting.empty())
+	{
+		this->setStartingImage(starting);
+	}
+	if(!ending.empty())
+	{
+		this->setEndingImage(ending);
+	}
+}
+
+std::unique_ptr<AnimatedImage> Canvas::makePixelImage(const StoredImage &source, const std::vector<unsigned char> &pixels) const
+{
+	//uploaded from the decoded pixels, the shared texture is not copied on the GPU
+	auto texture = std::make_unique<sf::Texture>();
+	const sf::Vector2u size = source.pixels.getSize();
+	if(size != sf::Vector2u(0u, 0u) && this->usesPremultipliedAlpha())
+	{
+		if(texture->create(size.x, size.y) && pixels.size() >= MemoryCharge::bytesOf(size))
+		{
+			texture->update(pixels.data());
+		}
+	}
+	else if(size != sf::Vector2u(0u, 0u))
+	{
+		texture->loadFromImage(source.pixels);
+	}
+	return std::make_unique<AnimatedImage>(sf::Vector3f(), std::move(texture), static_cast<sf::Vector2f>(m_plane.getSize()));
+}
+
+std::vector<unsigned char> Canvas::animationPixels(const AnimatedImage &image) const
+{
+	std::vector<unsigned char> pixels = image.getRGB();
+	if(this->usesPremultipliedAlpha())
+	{
+		pk::premultiply(pixels.data(), pixels.data(), pixels.size() / 4u);
+	}
+	return pixels;
+}
+
+bool Canvas::usesPremultipliedAlpha() const
+{
+	return m_premultipliedAlpha && m_animType == Canvas::AnimationType::PIX_ANIM && !m_pixShader;
+}
+
+sf::Shader *Canvas::findShader(const std::string &source, const std::string &vertex_source)
+{
+	const std::string key = vertex_source + source;
+	auto found = m_shaders.find(key);
+	if(found == m_shaders.end())
+	{
+		auto shader = std::make_unique<sf::Shader>();
+		const bool compiled = vertex_source.empty()
+			? shader->loadFromMemory(source, sf::Shader::Fragment)
+			: shader->loadFromMemory(vertex_source, source);
+		if(!compiled)
+		{
+			shader.reset();
+		}
+		found = m_shaders.emplace(key, std::move(shader)).first;
+	}
+	return found->second.get();
+}
+
+void Canvas::updateImages(const float &time)
+{
+	m_imagesOutdated = false;
+	m_evaluatedTime = time;
+	if(m_animType == Canvas::AnimationType::OBJ_ANIM)
+	{
+		BCG_PROFILE_SCOPE("Canvas::evaluate");
+		if(m_startingImage)
+		{
+			m_startingImage->transformUpdate(m_objAnim->getImage1Frame(time));
+		}
+		if(m_endingImage)
+		{
+			m_endingImage->transformUpdate(m_objAnim->getImage2Frame(time));
+		}
+	}
+	else if(m_animType == Canvas::AnimationType::PIX_ANIM && m_pixelImageIn && m_pixelImageOut)
+	{
+		this->updatePixelFrames(time);
+		this->placePixelImages(time);
+	}
+}
+
+void Canvas::drawPlane(const float &time)
+{
+	m_drawnTime = time;
+	m_plane.clear();
+
+	if(m_animType == Canvas::AnimationType::OBJ_ANIM && m_depthShader)
+	{
+		this->drawWithDepth();
+	}
+	else if(m_animType == Canvas::AnimationType::OBJ_ANIM)
+	{
+		this->drawSorted();
+	}
+	else if(m_animType == Canvas::AnimationType::PIX_ANIM && m_pixelImageIn && m_pixelImageOut)
+	{
+		const sf::BlendMode &blend = this->usesPremultipliedAlpha() ? BLEND_PREMULTIPLIED : sf::BlendAlpha;
+		if(m_pixShader)
+		{
+			m_pixAnim->setShaderParameters(*m_pixShader, time);
+			m_pixShader->setUniform("source", sf::Shader::CurrentTexture);
+
+			m_pixShader->setUniform("other", *m_pixelImageIn->getTexture());
+			m_pixShader->setUniform("layer", 2);
+			m_pixelImageOut->render(&m_plane, m_pixShader);
+
+			m_pixShader->setUniform("other", *m_pixelImageOut->getTexture());
+			m_pixShader->setUniform("layer", 1);
+			m_pixelImageIn->render(&m_plane, m_pixShader);
+		}
+		else if(this->usesAlphaMasks())
+		{
+			m_maskShader->setUniform("source", sf::Shader::CurrentTexture);
+			m_maskShader->setUniform("premultiplied", this->usesPremultipliedAlpha());
+
+			m_maskShader->setUniform("mask", m_maskOut.getTexture());
+			m_maskShader->setUniform("width", static_cast<float>(m_maskOut.getSize().x));
+			m_pixelImageOut->render(&m_plane, m_maskShader, blend);
+
+			m_maskShader->setUniform("mask", m_maskIn.getTexture());
+			m_maskShader->setUniform("width", static_cast<float>(m_maskIn.getSize().x));
+			m_pixelImageIn->render(&m_plane, m_maskShader, blend);
+		}
+		else
+		{
+			m_pixelImageOut->render(&m_plane, nullptr, blend);
+			m_pixelImageIn->render(&m_plane, nullptr, blend);
+		}
+	}
+
+	m_plane.display();
+}
+
+void Canvas::drawWithDepth()
+{
+	const sf::Vector2f size(m_plane.getSize());
+	m_depthShader->setUniform("center", sf::Glsl::Vec2(size / 2.f));
+	m_depthShader->setUniform("focal", m_perspective);
+	m_depthShader->setUniform("depthRange", std::max(size.x, size.y) * 16.f);//far beyond any depth the animations reach
+
+	//states of SFML are set up front, so its drawing does not reset the depth test
+	m_plane.resetGLStates();
+	glDepthMask(GL_TRUE);
+	glClear(GL_DEPTH_BUFFER_BIT);
+	glEnable(GL_DEPTH_TEST);
+	glDepthFunc(GL_LEQUAL);
+
+	//at equal depth the starting image stays on top, like in sorted drawing
+	if(m_endingImage)
+	{
+		m_endingImage->renderWithDepth(&m_plane, *m_depthShader);
+	}
+	if(m_startingImage)
+	{
+		m_startingImage->renderWithDepth(&m_plane, *m_depthShader);
+	}
+	glDisable(GL_DEPTH_TEST);
+}
+
+void Canvas::drawSorted()
+{
+	const bool starting_deeper = m_startingImage && m_endingImage
+		&& m_startingImage->getVertexDepth(0) > m_endingImage->getVertexDepth(0);
+	AnimatedImage *first = starting_deeper ? m_startingImage.get() : m_endingImage.get();
+	AnimatedImage *second = starting_deeper ? m_endingImage.get() : m_startingImage.get();
+	if(first)
+	{
+		first->render(&m_plane);
+	}
+	if(second)
+	{
+		second->render(&m_plane);
+	}
+}
+
+bool Canvas::isFrameCached() const
+{
+	return m_frameCache.isEnabled() && m_playback.getGrid().isValid() && m_animType != Canvas::AnimationType::NONE;
+}
+
+void Canvas::invalidateFrames()
+{
+	m_frameCache.clear();
+	m_cachedFrame = nullptr;
+	m_evaluatedTime = NO_TIME;
+	m_drawnTime = NO_TIME;
+	m_pixelFramesTime = NO_TIME;
+}
+
+void Canvas::updatePixelFrames(const float &time)
+{
+	if(m_pixShader)
+	{
+		return;
+	}
+	//animations changing only alpha write and upload a quarter of the bytes
+	const bool masks = this->prepareAlphaMasks();
+
+	//textures holding a previous frame get only the pixels which differ from it
+	const bool partial = m_pixelFramesTime >= 0.f;
+	PixelSpan span_in, span_out;
+	if(partial)
+	{
+		span_in = m_pixAnim->changedPixels1(m_pixelFramesTime, time);
+		span_out = m_pixAnim->changedPixels2(m_pixelFramesTime, time);
+	}
+	const bool write_in = m_pixelImageIn && !(partial && span_in.isEmpty());
+	const bool write_out = m_pixelImageOut && !(partial && span_out.isEmpty());
+
+	//both frames are computed at the same time, textures are uploaded on this thread afterwards
+	if(!masks && write_in && write_out)
+	{
+		BCG_PROFILE_SCOPE("Canvas::evaluate");
+		m_pixAnim->writeFrames(time, m_pixelFrameIn, m_pixelFrameOut);
+	}
+	else
+	{
+		BCG_PROFILE_SCOPE("Canvas::evaluate");
+		const float previous = m_pixelFramesTime;
+		ThreadPool::shared().parallelFor(2u, 1u, [this, &time, previous, partial, masks, write_in, write_out](std::size_t begin, std::size_t end)
+		{
+			for(std::size_t image = begin; image < end; image++)
+			{
+				if(image == 0u && write_in)
+				{
+					//animations knowing which pixels change bring the previous frame forward instead
+					if(partial && (masks ? m_pixAnim->updateAlpha1Mask(previous, time, m_pixelFrameIn) : m_pixAnim->updateTexture1Frame(previous, time, m_pixelFrameIn)))
+					{
+						continue;
+					}
+					if(masks)
+					{
+						m_pixAnim->writeAlpha1Mask(time, m_pixelFrameIn);
+					}
+					else
+					{
+						m_pixAnim->writeTexture1Frame(time, m_pixelFrameIn);
+					}
+				}
+				else if(image == 1u && write_out)
+				{
+					if(masks)
+					{
+						m_pixAnim->writeAlpha2Mask(time, m_pixelFrameOut);
+					}
+					else
+					{
+						m_pixAnim->writeTexture2Frame(time, m_pixelFrameOut);
+					}
+				}
+			}
+		});
+	}
+	BCG_PROFILE_SCOPE("Canvas::upload");
+	auto upload = [masks, partial](AnimatedImage &image, AlphaMask &mask, const std::vector<unsigned char> &frame, const PixelSpan &span)
+	{
+		if(masks && partial)
+		{
+			mask.update(frame, span.begin, span.end);
+		}
+		else if(masks)
+		{
+			mask.update(frame);
+		}
+		else if(partial)
+		{
+			image.pixelUpdate(frame, span.begin, span.end);
+		}
+		else
+		{
+			image.pixelUpdate(frame);
+		}
+	};
+	if(write_in)
+	{
+		upload(*m_pixelImageIn, m_maskIn, m_pixelFrameIn, span_in);
+	}
+	if(write_out)
+	{
+		upload(*m_pixelImageOut, m_maskOut, m_pixelFrameOut, span_out);
+	}
+	m_pixelFramesTime = time;
+	this->accountMemory();
+}
+
+void Canvas::placePixelImages(const float &time)
+{
+	if(m_animType != Canvas::AnimationType::PIX_ANIM || !m_pixAnim->hasTransforms())
+	{
+		return;
+	}
+	if(m_pixelImageIn)
+	{
+		m_pixelImageIn->transformUpdate(m_pixAnim->getImage1Transform(time));
+	}
+	if(m_pixelImageOut)
+	{
+		m_pixelImageOut->transformUpdate(m_pixAnim->getImage2Transform(time));
+	}
+}
+
+bool Canvas::prepareAlphaMasks()
+{
+	bool ready = m_maskShader && m_pixelImageIn && m_pixelImageOut;
+	ready = ready && m_maskIn.create(m_pixelImageIn->getTexture()->getSize());
+	ready = ready && m_maskOut.create(m_pixelImageOut->getTexture()->getSize());
+	if(!ready)//textures get whole frames, from the next one on as well
+	{
+		m_maskIn.clear();
+		m_maskOut.clear();
+	}
+	return ready;
+}
+
+bool Canvas::usesAlphaMasks() const
+{
+	return m_maskShader && m_pixelImageIn && m_pixelImageOut
+		&& m_maskIn.getSize() != sf::Vector2u(0u, 0u)
+		&& m_maskIn.getSize() == m_pixelImageIn->getTexture()->getSize()
+		&& m_maskOut.getSize() == m_pixelImageOut->getTexture()->getSize();
+}
+
+void Canvas::placeFrame(sf::Sprite &body, const sf::Texture &frame) const
+{
+	const sf::Vector2f frame_size(frame.getSize());
+	if(m_size.x <= 0.f || m_size.y <= 0.f || frame_size.x <= 0.f || frame_size.y <= 0.f)
+	{
+		body.setPosition(m_planeBody.getPosition());
+		return;
+	}
+	//letterboxed, so frames of another aspect ratio than the area are not stretched
+	const float scale = std::min(m_size.x / frame_size.x, m_size.y / frame_size.y);
+	body.setScale(scale, scale);
+	body.setPosition(m_planeBody.getPosition() + (m_size - frame_size * scale) / 2.f);
+}
+
+void Canvas::accountMemory()
+{
+	std::size_t gpu = MemoryCharge::bytesOf(m_plane.getSize());
+	for(const AnimatedImage *image : { m_pixelImageIn.get(), m_pixelImageOut.get(), m_heldImageIn.get(), m_heldImageOut.get() })
+	{
+		if(image && image->getTexture())
+		{
+			gpu += MemoryCharge::bytesOf(image->getTexture()->getSize());
+		}
+	}
+	gpu += MemoryCharge::bytesOf(m_sequenceTexture.getSize());
+	gpu += MemoryCharge::bytesOf(m_blurPlane.getSize());
+	gpu += m_readback.getBufferBytes();
+	m_imagesCharge.setGpu(gpu);
+	m_framesCharge.setCpu(m_pixelFrameIn.capacity() + m_pixelFrameOut.capacity() + m_heldPixels1.capacity() + m_heldPixels2.capacity());
+}
+
+void Canvas::fitIntoBudget()
+{
+	MemoryBudget &budget = MemoryBudget::shared();
+	if(!budget.isOverBudget())
+	{
+		return;
+	}
+
+	//idle export buffers and cached frames are the cheapest to give back, they are only allocated or rendered again
+	m_bufferPool.trim();
+	if(!budget.isOverBudget())
+	{
+		return;
+	}
+	const std::size_t usage = m_frameCache.getUsage();
+	if(usage > 0u)
+	{
+		const std::size_t excess = budget.getTotalUsage() - budget.getBudget();
+		m_frameCache.setBudget(usage > excess ? usage - excess : 0u);
+		if(!budget.isOverBudget())
+		{
+			return;
+		}
+	}
+
+	//then the resolution the images are worked on at, frames keep the size of the plane
+	if(m_imageTier == Canvas::ImageTier::FULL)
+	{
+		m_imageTier = Canvas::ImageTier::PREVIEW;
+		this->reloadImages();
+	}
+	else if(m_previewDivisor < MAX_PREVIEW_DIVISOR)
+	{
+		m_previewDivisor *= 2u;
+		this->reloadImages();
+	}
+}
+
+void Canvas::showSequenceFrame()
+{
+	const std::size_t count = m_sequence->getFrameCount();
+	const float progress = m_playback.getProgress();
+	const std::size_t frame = static_cast<std::size_t>(std::lround(progress * static_cast<float>(count - 1u)));
+	if(frame == m_sequenceFrame)
+	{
+		return;
+	}
+	//the driver reads the pixels right out of the mapped pages
+	m_sequenceTexture.update(m_sequence->getFrame(frame));
+	m_sequenceFrame = frame;
+}
+
+void Canvas::accumulateSubframe(const unsigned subframe)
+{
+	//running mean: the n-th subframe replaces 1/n of what is gathered, so all of them weigh the same
+	sf::Sprite body(m_plane.getTexture());
+	body.setColor(sf::Color(255u, 255u, 255u, static_cast<sf::Uint8>(std::lround(255.f / static_cast<float>(subframe + 1u)))));
+	m_blurPlane.draw(body, subframe == 0u ? sf::BlendNone : sf::BlendAlpha);
+	m_blurPlane.display();
+}
+
+bool Canvas::hashSequence(SequenceCache &cache, const std::vector<float> &times, std::uint64_t &hash) const
+{
+	const Animation *animation = nullptr;
+	if(m_animType == Canvas::AnimationType::OBJ_ANIM)
+	{
+		animation = m_objAnim.get();
+	}
+	else if(m_animType == Canvas::AnimationType::PIX_ANIM)
+	{
+		animation = m_pixAnim.get();
+	}
+	if(!animation || m_startingPath.empty() || m_endingPath.empty() || times.empty())
+	{
+		return false;
+	}
+
+	ContentHash sequence;
+	try
+	{
+		sequence.add(cache.hashImage(m_startingPath)).add(cache.hashImage(m_endingPath));
+	}
+	catch(const std::exception &)
+	{
+		return false;//images which cannot be read back are never found again
+	}
+	sequence.add(animation->getParameterHash())
+		.add(m_pixShader != nullptr)
+		.add(m_depthShader != nullptr)
+		.add(m_premultipliedAlpha)
+		.add(m_perspective)
+		.add(m_imageTier)
+		.add(m_previewDivisor)
+		.add(m_plane.getSize())
+		.add(m_motionBlur)
+		.add(times.data(), times.size() * sizeof(float));
+	hash = sequence.getValue();
+	return true;
 }
 
 const float& Canvas::getTotalTime()
 {
-	return m_totalAnimTime;
+	return m_playback.getLength();
 }  
@@ -0,0 +1,139 @@
+#include "../../include/gui/CanvasRenderer.h"
+
+CanvasRenderer::CanvasRenderer(Canvas &canvas)
+:
+m_canvas(canvas),
+m_canvasMutex(),
+m_inputMutex(),
+m_wake(),
+m_input(),
+m_changed(true),
+m_stop(false),
+m_rendering(false),
+m_frames(),
+m_framesCharge(MemorySubsystem::GUI),
+m_hasFrame(false),
+m_thread()
+{
+	m_thread = std::thread(&CanvasRenderer::run, this);
+}
+
+CanvasRenderer::~CanvasRenderer()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_inputMutex);
+		m_stop = true;
+	}
+	m_wake.notify_one();
+	m_thread.join();
+}
+
+void CanvasRenderer::submit(const PlaybackCursor &playback)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_inputMutex);
+		if(playback.getTime() == m_input.getTime() && playback.isPlaying() == m_input.isPlaying()
+		&& playback.isScrubbing() == m_input.isScrubbing() && playback.getGrid() == m_input.getGrid())
+		{
+			return;
+		}
+		m_input = playback;
+		m_changed = true;
+	}
+	m_wake.notify_one();
+}
+
+void CanvasRenderer::modify(const std::function<void(Canvas &)> &change)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_canvasMutex);
+		change(m_canvas);
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_inputMutex);
+		m_changed = true;
+	}
+	m_wake.notify_one();
+}
+
+bool CanvasRenderer::isBusy() const
+{
+	std::lock_guard<std::mutex> lock(m_inputMutex);
+	return m_changed || m_rendering || m_frames.hasNew();
+}
+
+const sf::Texture *CanvasRenderer::acquireFrame()
+{
+	if(m_frames.acquire())
+	{
+		m_hasFrame = true;
+	}
+	return m_hasFrame ? m_frames.front().get() : nullptr;
+}
+
+//private member functions
+void CanvasRenderer::run()
+{
+	sf::Context context;//textures are shared between contexts, so the frames can be drawn by the window
+	while(true)
+	{
+		PlaybackCursor input;
+		{
+			std::unique_lock<std::mutex> lock(m_inputMutex);
+			if(!m_changed && !m_stop)
+			{
+				//nothing new to show, the time is spent filling the frame cache
+				lock.unlock();
+				bool rendered = false;
+				{
+					std::lock_guard<std::mutex> canvas_lock(m_canvasMutex);
+					rendered = m_canvas.prerenderFrame();
+				}
+				lock.lock();
+				if(!rendered)
+				{
+					m_wake.wait(lock, [this]() { return m_changed || m_stop; });
+				}
+			}
+			if(m_stop)
+			{
+				return;
+			}
+			if(!m_changed)
+			{
+				continue;
+			}
+			input = m_input;
+			m_changed = false;
+			m_rendering = true;
+		}
+		this->renderFrame(input);
+	}
+}
+
+void CanvasRenderer::renderFrame(const PlaybackCursor &input)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_canvasMutex);
+		m_canvas.setPlayback(input);
+		sf::Event event = sf::Event();
+		m_canvas.update(sf::Vector2i(), event);
+		m_canvas.renderPlane();
+
+		//copied on the GPU, the copy is flushed before the frame is published
+		const sf::Texture &frame = m_canvas.getFrameTexture();
+		std::unique_ptr<sf::Texture> &slot = m_frames.back();
+		if(!slot)
+		{
+			slot = std::make_unique<sf::Texture>();
+		}
+		if(slot->getSize() != frame.getSize())
+		{
+			slot->create(frame.getSize().x, frame.getSize().y);
+			m_framesCharge.setGpu(3u * MemoryCharge::bytesOf(frame.getSize()));//all slots end up at the size of the plane
+		}
+		slot->update(frame);
+	}
+	m_frames.publish();
+	m_rendering = false;
+}
@@ -148,16 +148,28 @@ void DropdownList::update(sf::Vector2i mousePos, sf::Event &event)
 	}
 }
 
-void DropdownList::render(sf::RenderTarget *target)
+void DropdownList::batch(GuiBatch &target) const
 {
-	TextButton::render(target);
+	TextButton::batch(target);
 	if(m_dropStatus == DropdownList::DropStatus::DROPPED)
 	{
-		target->draw(m_background);
+		target.add(m_background);
 		for(auto &it : m_choices)
 		{
-			it->render(target);
+			it->batch(target);
 		}
 	}
 }
 
+std::size_t DropdownList::getLookKey() const
+{
+	std::size_t key = Object::combineLook(TextButton::getLookKey(), m_dropStatus);
+	if(m_dropStatus == DropdownList::DropStatus::DROPPED)
+	{
+		for(auto &it : m_choices)
+		{
+			key = Object::combineLook(key, it->getLookKey());
+		}
+	}
+	return key;
+}
@@ -0,0 +1,288 @@
+#include "../../include/gui/ExportScheduler.h"
+
+ExportScheduler::ExportScheduler(const sf::Vector2u &size)
+:
+m_size(size),
+m_workerCount(0u),
+m_useShaders(true),
+m_premultiplied(false),
+m_cache(nullptr),
+m_jobs(),
+m_queues(),
+m_sources(),
+m_sourcesMutex(),
+m_progress(nullptr),
+m_state(),
+m_progressMutex(),
+m_error()
+{ }
+
+void ExportScheduler::setWorkerCount(const unsigned workers)
+{
+	m_workerCount = workers;
+}
+
+void ExportScheduler::setUseShaders(const bool use_shader)
+{
+	m_useShaders = use_shader;
+}
+
+void ExportScheduler::setPremultipliedAlpha(const bool premultiplied)
+{
+	m_premultiplied = premultiplied;
+}
+
+void ExportScheduler::setCache(SequenceCache *cache)
+{
+	m_cache = cache;
+}
+
+std::size_t ExportScheduler::addJob(ExportJob job)
+{
+	if(!job.sink)
+	{
+		throw std::invalid_argument("ExportScheduler::addJob(): the job has no sink");
+	}
+	m_jobs.push_back(std::move(job));
+	return m_jobs.size() - 1u;
+}
+
+std::size_t ExportScheduler::getJobCount() const
+{
+	return m_jobs.size();
+}
+
+void ExportScheduler::run(const std::function<void(const ExportProgress &)> &progress)
+{
+	if(m_jobs.empty())
+	{
+		return;
+	}
+	const unsigned cores = std::max(std::thread::hardware_concurrency(), 1u);
+	const std::size_t workers = std::min<std::size_t>(m_workerCount > 0u ? m_workerCount : cores, m_jobs.size());
+
+	//jobs of the same images stay together, every group goes to the worker with the least frames so far
+	std::vector<std::vector<std::size_t>> groups;
+	std::map<std::pair<std::string, std::string>, std::size_t> group_of;
+	for(std::size_t i = 0; i < m_jobs.size(); i++)
+	{
+		auto found = group_of.emplace(std::make_pair(m_jobs[i].start, m_jobs[i].end), groups.size());
+		if(found.second)
+		{
+			groups.emplace_back();
+		}
+		groups[found.first->second].push_back(i);
+	}
+	m_queues.clear();
+	std::vector<std::size_t> dealt(workers, 0u);
+	for(std::size_t i = 0; i < workers; i++)
+	{
+		m_queues.push_back(std::make_unique<Queue>());
+	}
+	for(const std::vector<std::size_t> &group : groups)
+	{
+		const std::size_t worker = std::min_element(dealt.begin(), dealt.end()) - dealt.begin();
+		for(const std::size_t job : group)
+		{
+			m_queues[worker]->jobs.push_back(job);
+			dealt[worker] += static_cast<std::size_t>(m_jobs[job].frames) * std::max(m_jobs[job].subframes, 1u);//every subframe is drawn
+		}
+	}
+
+	m_sources.clear();
+	m_state = ExportProgress{0u, false, 0u, m_jobs.size(), 0u, 0u};
+	for(const ExportJob &job : m_jobs)
+	{
+		m_sources[job.start].users++;
+		m_sources[job.end].users++;
+		m_state.frameCount += job.frames;
+	}
+	m_progress = progress ? &progress : nullptr;
+	m_error = nullptr;
+
+	//the calling thread is the first worker, like in ThreadPool
+	std::vector<std::thread> threads;
+	for(std::size_t i = 1; i < workers; i++)
+	{
+		threads.emplace_back(&ExportScheduler::work, this, i);
+	}
+	this->work(0u);
+	for(std::thread &thread : threads)
+	{
+		thread.join();
+	}
+
+	m_jobs.clear();
+	m_queues.clear();
+	m_sources.clear();
+	m_progress = nullptr;
+	if(m_error)
+	{
+		std::exception_ptr error = m_error;
+		m_error = nullptr;
+		std::rethrow_exception(error);
+	}
+}
+
+//private member functions
+void ExportScheduler::work(const std::size_t worker)
+{
+	try
+	{
+		//the canvas and its context belong to this thread from creation to destruction
+		const sf::Vector2f size(m_size);
+		Canvas canvas(sf::Vector2f(), size);
+		canvas.setPremultipliedAlpha(m_premultiplied);
+		canvas.getFrameCache().setBudget(0u);//every frame is rendered only once
+
+		std::size_t job = 0u;
+		while(this->take(worker, job))
+		{
+			try
+			{
+				this->render(canvas, job);
+			}
+			catch(...)
+			{
+				std::lock_guard<std::mutex> lock(m_progressMutex);
+				if(!m_error)
+				{
+					m_error = std::current_exception();
+				}
+			}
+			this->release(m_jobs[job].start);
+			this->release(m_jobs[job].end);
+			this->report(job, true);
+		}
+	}
+	catch(...)
+	{
+		//jobs left to a worker without a canvas are stolen by the others
+		std::lock_guard<std::mutex> lock(m_progressMutex);
+		if(!m_error)
+		{
+			m_error = std::current_exception();
+		}
+	}
+}
+
+bool ExportScheduler::take(const std::size_t worker, std::size_t &job)
+{
+	{
+		Queue &own = *m_queues[worker];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if(!own.jobs.empty())
+		{
+			job = own.jobs.front();
+			own.jobs.pop_front();
+			return true;
+		}
+	}
+	//stolen from the back, the owner keeps the jobs sharing images with the one it renders
+	for(std::size_t i = 1; i < m_queues.size(); i++)
+	{
+		Queue &other = *m_queues[(worker + i) % m_queues.size()];
+		std::lock_guard<std::mutex> lock(other.mutex);
+		if(!other.jobs.empty())
+		{
+			job = other.jobs.back();
+			other.jobs.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
+
+void ExportScheduler::render(Canvas &canvas, const std::size_t job)
+{
+	const ExportJob &exported = m_jobs[job];
+	const ImageStore::Handle start = this->acquire(canvas, exported.start);
+	const ImageStore::Handle end = this->acquire(canvas, exported.end);
+
+	canvas.setStartingImage(exported.start);
+	canvas.setEndingImage(exported.end);
+	if(!exported.graph.empty())
+	{
+		canvas.setAnimation(std::unique_ptr<PixelAnimation>(TransitionGraph::parse(exported.graph, exported.setup)), m_useShaders);
+	}
+	else
+	{
+		AnyAnimation animation = createAnimation(exported.animation);
+		if(exported.setup)
+		{
+			exported.setup(animation);
+		}
+		canvas.setAnimation(std::move(animation), m_useShaders);
+	}
+	canvas.setTotalAnimationTime(exported.length);
+	canvas.setMotionBlur(exported.subframes);
+	canvas.setSequence(exported.sequence);
+
+	std::unique_ptr<FrameSink> sink = exported.sink();
+	canvas.renderSequence(FrameGrid(exported.frames, exported.length).times(), [this, job, &sink](ExportFrame frame)
+	{
+		sink->write(std::move(frame));
+		this->report(job, false);
+	}, m_cache);
+	sink->close();
+}
+
+ImageStore::Handle ExportScheduler::acquire(const Canvas &canvas, const std::string &path)
+{
+	std::promise<ImageStore::Handle> decoding;
+	std::shared_future<ImageStore::Handle> image;
+	bool decodes = false;
+	{
+		std::lock_guard<std::mutex> lock(m_sourcesMutex);
+		Source &source = m_sources[path];
+		if(!source.image.valid())
+		{
+			source.image = decoding.get_future().share();
+			decodes = true;
+		}
+		image = source.image;
+	}
+
+	//all canvases have the same size, so the image the first one loads is the one every canvas looks up
+	if(decodes)
+	{
+		try
+		{
+			decoding.set_value(canvas.loadImage(path));
+		}
+		catch(...)
+		{
+			decoding.set_exception(std::current_exception());
+		}
+	}
+	return image.get();
+}
+
+void ExportScheduler::release(const std::string &path)
+{
+	std::lock_guard<std::mutex> lock(m_sourcesMutex);
+	auto found = m_sources.find(path);
+	if(found != m_sources.end() && --found->second.users == 0u)
+	{
+		m_sources.erase(found);
+	}
+}
+
+void ExportScheduler::report(const std::size_t job, const bool finished)
+{
+	std::lock_guard<std::mutex> lock(m_progressMutex);
+	m_state.job = job;
+	m_state.jobFinished = finished;
+	if(finished)
+	{
+		m_state.finishedJobs++;
+	}
+	else
+	{
+		m_state.renderedFrames++;
+	}
+	if(m_progress)
+	{
+		(*m_progress)(m_state);
+	}
+}
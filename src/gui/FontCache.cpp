@@ -0,0 +1,45 @@
+#include "../../include/gui/FontCache.h"
+#include "../../res/fonts/TerminusTTF.h"
+
+FontCache::FontCache()
+:
+m_font(nullptr),
+m_prepared()
+{ }
+
+FontCache &FontCache::shared()
+{
+	static FontCache cache;
+	return cache;
+}
+
+std::shared_ptr<sf::Font> FontCache::getFont()
+{
+	if(!m_font)
+	{
+		auto font = std::make_shared<sf::Font>();
+		const Resource *noir = Resources::find("fonts/Noir_regular.otf");
+		if(!noir || !font->loadFromMemory(noir->data, noir->size))
+		{
+			if(!font->loadFromMemory(font_data, font_data_size))
+			{
+				throw std::runtime_error("FontCache::getFont(): Could not load \"res/fonts/TerminusTTF\" font.");
+			}
+		}
+		m_font = std::move(font);
+	}
+	return m_font;
+}
+
+void FontCache::prepare(const unsigned size, const bool bold)
+{
+	if(size == 0u || !m_prepared.emplace(size, bold).second)
+	{
+		return;
+	}
+	const std::shared_ptr<sf::Font> font = this->getFont();
+	for(sf::Uint32 character = 32u; character < 127u; character++)
+	{
+		font->getGlyph(character, size, bold);
+	}
+}
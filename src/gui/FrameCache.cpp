@@ -0,0 +1,136 @@
+#include "../../include/gui/FrameCache.h"
+
+FrameCache::FrameCache(const std::size_t budget)
+:
+m_entries(),
+m_index(),
+m_budget(budget),
+m_usage(0u),
+m_charge(MemorySubsystem::FRAME_CACHE)
+{ }
+
+void FrameCache::setBudget(const std::size_t budget)
+{
+	m_budget = budget;
+	this->evictFor(0u, sf::Vector2u());
+	m_charge.setGpu(m_usage);
+}
+
+std::size_t FrameCache::getBudget() const
+{
+	return m_budget;
+}
+
+std::size_t FrameCache::getUsage() const
+{
+	return m_usage;
+}
+
+std::size_t FrameCache::getCount() const
+{
+	return m_entries.size();
+}
+
+bool FrameCache::isEnabled() const
+{
+	return m_budget > 0u;
+}
+
+bool FrameCache::contains(const unsigned frame) const
+{
+	return m_index.find(frame) != m_index.end();
+}
+
+bool FrameCache::hasRoomFor(const sf::Vector2u &size) const
+{
+	return m_usage + FrameCache::bytesOf(size) <= m_budget;
+}
+
+const sf::Texture *FrameCache::find(const unsigned frame)
+{
+	auto found = m_index.find(frame);
+	if(found == m_index.end())
+	{
+		return nullptr;
+	}
+	m_entries.splice(m_entries.begin(), m_entries, found->second);
+	return m_entries.front().texture.get();
+}
+
+const sf::Texture *FrameCache::store(const unsigned frame, const sf::Texture &texture)
+{
+	const sf::Vector2u size = texture.getSize();
+	const std::size_t bytes = FrameCache::bytesOf(size);
+	if(bytes > m_budget)
+	{
+		return nullptr;
+	}
+
+	auto found = m_index.find(frame);
+	if(found != m_index.end())//replacing the frame
+	{
+		m_usage -= found->second->bytes;
+		m_entries.erase(found->second);
+		m_index.erase(found);
+	}
+
+	std::unique_ptr<sf::Texture> cached = this->evictFor(bytes, size);
+	if(cached)
+	{
+		cached->update(texture);
+	}
+	else
+	{
+		cached = std::make_unique<sf::Texture>(texture);
+	}
+
+	m_entries.push_front(Entry{frame, std::move(cached), bytes});
+	m_index[frame] = m_entries.begin();
+	m_usage += bytes;
+	m_charge.setGpu(m_usage);
+	return m_entries.front().texture.get();
+}
+
+void FrameCache::erase(const unsigned frame)
+{
+	auto found = m_index.find(frame);
+	if(found == m_index.end())
+	{
+		return;
+	}
+	m_usage -= found->second->bytes;
+	m_charge.setGpu(m_usage);
+	m_entries.erase(found->second);
+	m_index.erase(found);
+}
+
+void FrameCache::clear()
+{
+	m_entries.clear();
+	m_index.clear();
+	m_usage = 0u;
+	m_charge.setGpu(0u);
+}
+
+//private member functions
+std::size_t FrameCache::bytesOf(const sf::Vector2u &size)
+{
+	return static_cast<std::size_t>(size.x) * size.y * 4u;
+}
+
+std::unique_ptr<sf::Texture> FrameCache::evictFor(const std::size_t bytes, const sf::Vector2u &size)
+{
+	std::unique_ptr<sf::Texture> reusable;
+	while(!m_entries.empty() && m_usage + bytes > m_budget)
+	{
+		Entry &last = m_entries.back();
+		if(!reusable && last.texture->getSize() == size)
+		{
+			reusable = std::move(last.texture);
+		}
+		m_usage -= last.bytes;
+		m_index.erase(last.frame);
+		m_entries.pop_back();
+	}
+	return reusable;
+}
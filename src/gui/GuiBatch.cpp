@@ -0,0 +1,242 @@
+#include "../../include/gui/GuiBatch.h"
+
+namespace
+{
+	const float ITALIC_SHEAR = 0.209f;//same slant as sf::Text, 12 degrees
+}//anonymous namespace
+
+GuiBatch::GuiBatch()
+:
+m_vertices(),
+m_ranges(),
+m_solidTexture(nullptr),
+m_solidCoords(0.f, 0.f),
+m_buffer(sf::Triangles, sf::VertexBuffer::Stream),
+m_uploaded(false)
+{ }
+
+void GuiBatch::clear()
+{
+	m_vertices.clear();
+	m_ranges.clear();
+	m_uploaded = false;
+}
+
+void GuiBatch::setSolidTexture(const sf::Texture *texture, const sf::Vector2f &white_pixel)
+{
+	m_solidTexture = texture;
+	m_solidCoords = white_pixel;
+}
+
+void GuiBatch::add(const sf::Shape &shape)
+{
+	const std::size_t count = shape.getPointCount();
+	if(count < 3u)
+	{
+		return;
+	}
+	std::vector<sf::Vector2f> points(count);
+	sf::Vector2f center(0.f, 0.f);
+	for(std::size_t i = 0; i < count; i++)
+	{
+		points[i] = shape.getPoint(i);
+		center += points[i];
+	}
+	center /= static_cast<float>(count);
+	const sf::Transform &transform = shape.getTransform();
+
+	//shapes are convex, the fill is a fan around their center
+	if(shape.getFillColor().a != 0u)
+	{
+		for(std::size_t i = 0; i < count; i++)
+		{
+			this->addTriangle(transform, center, points[i], points[(i + 1u) % count], shape.getFillColor());
+		}
+	}
+
+	//the outline lies between the edge and the edge moved outwards by the thickness, inwards if it is negative
+	const float thickness = shape.getOutlineThickness();
+	if(thickness == 0.f || shape.getOutlineColor().a == 0u)
+	{
+		return;
+	}
+	auto outwards = [&center](const sf::Vector2f &from, const sf::Vector2f &to)
+	{
+		sf::Vector2f normal(from.y - to.y, to.x - from.x);
+		const float length = std::sqrt(normal.x * normal.x + normal.y * normal.y);
+		if(length != 0.f)
+		{
+			normal /= length;
+		}
+		if(normal.x * (center.x - from.x) + normal.y * (center.y - from.y) > 0.f)
+		{
+			normal = -normal;
+		}
+		return normal;
+	};
+	std::vector<sf::Vector2f> moved(count);
+	for(std::size_t i = 0; i < count; i++)
+	{
+		const sf::Vector2f &previous = points[(i + count - 1u) % count], &current = points[i], &next = points[(i + 1u) % count];
+		const sf::Vector2f n1 = outwards(previous, current), n2 = outwards(current, next);
+		const float factor = 1.f + (n1.x * n2.x + n1.y * n2.y);
+		moved[i] = current + (n1 + n2) / factor * thickness;
+	}
+	for(std::size_t i = 0; i < count; i++)
+	{
+		const std::size_t next = (i + 1u) % count;
+		this->addTriangle(transform, points[i], moved[i], moved[next], shape.getOutlineColor());
+		this->addTriangle(transform, points[i], moved[next], points[next], shape.getOutlineColor());
+	}
+}
+
+void GuiBatch::add(const sf::Sprite &sprite)
+{
+	if(!sprite.getTexture())
+	{
+		return;
+	}
+	const sf::IntRect &rect = sprite.getTextureRect();
+	const float width = static_cast<float>(std::abs(rect.width));
+	const float height = static_cast<float>(std::abs(rect.height));
+	const sf::Vector2f corners[4] = {
+		sf::Vector2f(0.f, 0.f),
+		sf::Vector2f(width, 0.f),
+		sf::Vector2f(width, height),
+		sf::Vector2f(0.f, height) };
+	this->addQuad(sprite.getTransform(), corners, sprite.getColor(), sprite.getTexture(),
+		sf::FloatRect(static_cast<float>(rect.left), static_cast<float>(rect.top), static_cast<float>(rect.width), static_cast<float>(rect.height)));
+}
+
+void GuiBatch::add(const sf::Text &text)
+{
+	const sf::Font *font = text.getFont();
+	const sf::String &string = text.getString();
+	if(!font || string.isEmpty())
+	{
+		return;
+	}
+
+	const unsigned size = text.getCharacterSize();
+	const bool bold = (text.getStyle() & sf::Text::Bold) != 0u;
+	const float shear = (text.getStyle() & sf::Text::Italic) != 0u ? ITALIC_SHEAR : 0.f;
+	const float whitespace = font->getGlyph(L' ', size, bold).advance;
+	const float line_spacing = font->getLineSpacing(size);
+	const sf::Transform &transform = text.getTransform();
+
+	//the page of a size stays the same texture when it grows, coordinates of glyphs stay valid
+	const sf::Texture *page = &font->getTexture(size);
+	float x = 0.f, y = static_cast<float>(size);
+	sf::Uint32 previous = 0u;
+	for(std::size_t i = 0; i < string.getSize(); i++)
+	{
+		const sf::Uint32 character = string[i];
+		x += font->getKerning(previous, character, size);
+		previous = character;
+		if(character == L' ')
+		{
+			x += whitespace;
+			continue;
+		}
+		if(character == L'\t')
+		{
+			x += whitespace * 4.f;
+			continue;
+		}
+		if(character == L'\n')
+		{
+			y += line_spacing;
+			x = 0.f;
+			continue;
+		}
+
+		const sf::Glyph &glyph = font->getGlyph(character, size, bold);
+		const float left = glyph.bounds.left, top = glyph.bounds.top;
+		const float right = left + glyph.bounds.width, bottom = top + glyph.bounds.height;
+		const sf::Vector2f corners[4] = {
+			sf::Vector2f(x + left - shear * top, y + top),
+			sf::Vector2f(x + right - shear * top, y + top),
+			sf::Vector2f(x + right - shear * bottom, y + bottom),
+			sf::Vector2f(x + left - shear * bottom, y + bottom) };
+		this->addQuad(transform, corners, text.getFillColor(), page,
+			sf::FloatRect(static_cast<float>(glyph.textureRect.left), static_cast<float>(glyph.textureRect.top),
+				static_cast<float>(glyph.textureRect.width), static_cast<float>(glyph.textureRect.height)));
+		x += glyph.advance;
+	}
+}
+
+void GuiBatch::draw(sf::RenderTarget &target)
+{
+	if(m_vertices.empty())
+	{
+		return;
+	}
+
+	const bool use_buffer = sf::VertexBuffer::isAvailable();
+	if(use_buffer && !m_uploaded)
+	{
+		if(m_buffer.getVertexCount() < m_vertices.size() && !m_buffer.create(m_vertices.size()))
+		{
+			throw std::runtime_error("GuiBatch::draw(): cannot create the vertex buffer");
+		}
+		m_buffer.update(m_vertices.data(), m_vertices.size(), 0u);
+		m_uploaded = true;
+	}
+
+	for(const Range &range : m_ranges)
+	{
+		sf::RenderStates states;
+		states.texture = range.texture;
+		if(use_buffer)
+		{
+			target.draw(m_buffer, range.first, range.count, states);
+		}
+		else
+		{
+			target.draw(m_vertices.data() + range.first, range.count, sf::Triangles, states);
+		}
+	}
+}
+
+std::size_t GuiBatch::getDrawCallCount() const
+{
+	return m_ranges.size();
+}
+
+//private member functions
+void GuiBatch::addQuad(const sf::Transform &transform, const sf::Vector2f (&corners)[4], const sf::Color &color,
+	const sf::Texture *texture, const sf::FloatRect &texture_rect)
+{
+	const sf::Vector2f coords[4] = {
+		sf::Vector2f(texture_rect.left, texture_rect.top),
+		sf::Vector2f(texture_rect.left + texture_rect.width, texture_rect.top),
+		sf::Vector2f(texture_rect.left + texture_rect.width, texture_rect.top + texture_rect.height),
+		sf::Vector2f(texture_rect.left, texture_rect.top + texture_rect.height) };
+	const unsigned order[6] = { 0u, 1u, 2u, 0u, 2u, 3u };
+	for(const unsigned i : order)
+	{
+		m_vertices.emplace_back(transform.transformPoint(corners[i]), color, coords[i]);
+	}
+	this->extendRange(texture, 6u);
+}
+
+void GuiBatch::addTriangle(const sf::Transform &transform, const sf::Vector2f &a, const sf::Vector2f &b, const sf::Vector2f &c, const sf::Color &color)
+{
+	m_vertices.emplace_back(transform.transformPoint(a), color, m_solidCoords);
+	m_vertices.emplace_back(transform.transformPoint(b), color, m_solidCoords);
+	m_vertices.emplace_back(transform.transformPoint(c), color, m_solidCoords);
+	this->extendRange(m_solidTexture, 3u);
+}
+
+void GuiBatch::extendRange(const sf::Texture *texture, const std::size_t count)
+{
+	m_uploaded = false;
+	if(!m_ranges.empty() && m_ranges.back().texture == texture)
+	{
+		m_ranges.back().count += count;
+	}
+	else
+	{
+		m_ranges.push_back(Range{texture, m_vertices.size() - count, count});
+	}
+}
@@ -0,0 +1,113 @@
+#include "../../include/gui/IconAtlas.h"
+
+namespace
+{
+	const char *ICON_NAMES[] = {
+		"images/play_button.png",
+		"images/pause_button.png",
+		"images/next_button.png",
+		"images/previous_button.png",
+		"images/save_icon.png" };
+
+	const unsigned ATLAS_WIDTH = 256u;//wide enough for the widest icon, icons are packed in rows
+}//anonymous namespace
+
+IconAtlas::IconAtlas()
+:
+m_texture(),
+m_rects(),
+m_white(),
+m_memory(MemorySubsystem::GUI)
+{
+	std::array<sf::Image, ICON_COUNT> icons;
+	for(unsigned i = 0; i < ICON_COUNT; i++)
+	{
+		const Resource *resource = Resources::find(ICON_NAMES[i]);
+		if(!resource || !icons[i].loadFromMemory(resource->data, resource->size))
+		{
+			icons[i] = sf::Image();//a missing icon is left empty, as a texture failing to load was
+		}
+	}
+
+	//rows are filled from the tallest icon, the white block goes last
+	std::array<unsigned, ICON_COUNT> order;
+	std::iota(order.begin(), order.end(), 0u);
+	std::stable_sort(order.begin(), order.end(), [&icons](const unsigned a, const unsigned b)
+	{
+		return icons[a].getSize().y > icons[b].getSize().y;
+	});
+
+	sf::Vector2u cursor(0u, 0u);
+	unsigned row_height = 0u;
+	auto place = [&](const sf::Vector2u &size)
+	{
+		if(cursor.x + size.x > ATLAS_WIDTH)
+		{
+			cursor = sf::Vector2u(0u, cursor.y + row_height + PADDING);
+			row_height = 0u;
+		}
+		const sf::IntRect rect(cursor.x, cursor.y, size.x, size.y);
+		cursor.x += size.x + PADDING;
+		row_height = std::max(row_height, size.y);
+		return rect;
+	};
+	for(const unsigned i : order)
+	{
+		const sf::Vector2u size = icons[i].getSize();
+		if(size.x > 0u && size.y > 0u)
+		{
+			m_rects[i] = place(size);
+		}
+	}
+	m_white = place(sf::Vector2u(WHITE_SIZE, WHITE_SIZE));
+
+	sf::Image atlas;
+	atlas.create(ATLAS_WIDTH, cursor.y + row_height, sf::Color::Transparent);
+	for(unsigned i = 0; i < ICON_COUNT; i++)
+	{
+		if(m_rects[i].width > 0)
+		{
+			atlas.copy(icons[i], m_rects[i].left, m_rects[i].top);
+		}
+	}
+	for(int y = 0; y < m_white.height; y++)
+	{
+		for(int x = 0; x < m_white.width; x++)
+		{
+			atlas.setPixel(m_white.left + x, m_white.top + y, sf::Color::White);
+		}
+	}
+
+	if(!m_texture.loadFromImage(atlas))
+	{
+		throw std::runtime_error("IconAtlas::IconAtlas(): cannot upload the atlas");
+	}
+	m_memory.setGpu(MemoryCharge::bytesOf(m_texture.getSize()));
+}
+
+IconAtlas &IconAtlas::shared()
+{
+	static IconAtlas atlas;
+	return atlas;
+}
+
+const sf::Texture &IconAtlas::getTexture() const
+{
+	return m_texture;
+}
+
+const sf::IntRect &IconAtlas::getRect(const Icon icon) const
+{
+	return m_rects[static_cast<unsigned>(icon)];
+}
+
+sf::Vector2f IconAtlas::getWhitePixel() const
+{
+	return sf::Vector2f(m_white.left + m_white.width / 2.f, m_white.top + m_white.height / 2.f);
+}
+
+void IconAtlas::apply(sf::Sprite &sprite, const Icon icon) const
+{
+	sprite.setTexture(m_texture);
+	sprite.setTextureRect(this->getRect(icon));
+}
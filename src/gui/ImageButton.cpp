@@ -1,4 +1,6 @@
 #include "../../include/gui/ImageButton.h"
+#include "../../include/program/Program.h"
+#include "../../dep/tinyfiledialogs/tinyfiledialogs.h"
 
 ImageButton::ImageButton()
 :Button() {}
@@ -9,30 +11,41 @@ ImageButton::ImageButton(const sf::Vector2f &pos, const sf::Vector2f &size)
     m_isChanged = false;
     m_shape.setOutlineThickness(5);
     m_shape.setOutlineColor(sf::Color::White);
-    m_texture.loadFromFile("../res/images/placeholder.png");
-    m_texture.setSmooth(false);
-
-    m_spr.setTexture(m_texture);
-    m_spr.setPosition(m_shape.getPosition().x, m_shape.getPosition().y);
-    m_spr.setScale(static_cast<float>((m_shape.getSize().x) / (m_texture.getSize().x)), 
-            static_cast<float>((m_shape.getSize().y) / (m_texture .getSize().y) ));
+    m_placeholder = ImageStore::shared().load(Resources::pathOf("images/placeholder.png"));
+    this->showImage(m_placeholder);
 }
 
 ImageButton::ImageButton(const ImageButton &copy)
 :
-Button(copy)
+Button(copy),
+m_spr(copy.m_spr),
+m_placeholder(copy.m_placeholder),
+m_image(copy.m_image),
+m_thumbnail(copy.m_thumbnail),
+m_loader(nullptr),
+m_thumbnailLoader(nullptr),
+m_path(copy.m_path),
+m_isChanged(copy.m_isChanged)
 {}
 
 
 ImageButton::ImageButton(ImageButton &&source)
 :
-Button(source)
+Button(source),
+m_spr(source.m_spr),
+m_placeholder(std::move(source.m_placeholder)),
+m_image(std::move(source.m_image)),
+m_thumbnail(std::move(source.m_thumbnail)),
+m_loader(std::move(source.m_loader)),
+m_thumbnailLoader(std::move(source.m_thumbnailLoader)),
+m_path(std::move(source.m_path)),
+m_isChanged(source.m_isChanged)
 {}
 
-void ImageButton::render(sf::RenderTarget *target)
+void ImageButton::batch(GuiBatch &target) const
 {   
-    target->draw(m_shape);
-    target->draw(m_spr);
+    target.add(m_shape);
+    target.add(m_spr);
 }
 
 void ImageButton::update(sf::Vector2i mousePos, sf::Event &event)
@@ -44,16 +57,63 @@ void ImageButton::update(sf::Vector2i mousePos, sf::Event &event)
 
         if(path != nullptr)
         {
-            m_path = std::string(path);
-            m_isChanged = true;
-            m_texture.loadFromFile(m_path);
-
-            m_spr.setTexture(m_texture, true);
-            m_spr.setPosition(m_shape.getPosition().x, m_shape.getPosition().y);
-            m_spr.setScale(static_cast<float>((m_shape.getSize().x) / (m_texture.getSize().x)), 
-                static_cast<float>((m_shape.getSize().y) / (m_texture .getSize().y) ));
+            if(!m_loader)
+            {
+                m_loader = std::make_unique<ImageLoader>();
+            }
+            m_loader->request(std::string(path));
+            this->showImage(m_placeholder);
+        }
+    }
+
+    if(m_loader && m_loader->isPending())
+    {
+        ImageStore::Handle image = m_loader->update();
+        if(image)
+        {
+            //an image which failed to load leaves the previous one chosen
+            if(image->texture.getSize() != sf::Vector2u(0u, 0u))
+            {
+                m_image = std::move(image);
+                m_path = m_loader->getPath();
+                m_isChanged = true;
+                this->requestThumbnail(m_path);//shrunk from the loaded image, not decoded again
+            }
+            else
+            {
+                this->showImage(m_thumbnail ? m_thumbnail : m_placeholder);
+            }
+        }
+        else
+        {
+            Program::requestUpdate();//keeps updating until the image is loaded
         }
-    }      
+    }
+
+    if(m_thumbnailLoader && m_thumbnailLoader->isPending())
+    {
+        ImageStore::Handle thumbnail = m_thumbnailLoader->update();
+        if(thumbnail)
+        {
+            m_thumbnail = thumbnail->texture.getSize() != sf::Vector2u(0u, 0u) ? std::move(thumbnail) : nullptr;
+            this->showImage(m_thumbnail ? m_thumbnail : m_placeholder);
+        }
+        else
+        {
+            Program::requestUpdate();//keeps updating until the thumbnail is made
+        }
+    }
+}
+
+void ImageButton::setPreview(const std::string &path, const ImageStore::Handle &thumbnail)
+{
+    m_path = path;
+    m_thumbnail = thumbnail;
+    if(!m_thumbnail)
+    {
+        this->requestThumbnail(path);
+    }
+    this->showImage(m_thumbnail ? m_thumbnail : m_placeholder);
 }
 
 std::string ImageButton::getPath()
@@ -69,4 +129,33 @@ const bool ImageButton::isChanged() const
 void ImageButton::changeRead()
 {
     m_isChanged = false;
+    m_image.reset();
+}
+
+std::size_t ImageButton::getLookKey() const
+{
+    return Object::combineLook(Button::getLookKey(), std::hash<const sf::Texture *>()(m_spr.getTexture()));
+}
+
+//private member functions
+void ImageButton::showImage(const ImageStore::Handle &image)
+{
+    const sf::Vector2u size = image->texture.getSize();
+    m_spr.setTexture(image->texture, true);
+    m_spr.setPosition(m_shape.getPosition().x, m_shape.getPosition().y);
+    if(size.x > 0u && size.y > 0u)
+    {
+        m_spr.setScale(static_cast<float>((m_shape.getSize().x) / (size.x)), 
+            static_cast<float>((m_shape.getSize().y) / (size.y) ));
+    }
+}
+
+void ImageButton::requestThumbnail(const std::string &path)
+{
+    if(!m_thumbnailLoader)
+    {
+        m_thumbnailLoader = std::make_unique<ThumbnailLoader>();
+    }
+    const sf::Vector2f size = m_shape.getSize();
+    m_thumbnailLoader->request(path, sf::Vector2u(static_cast<unsigned>(size.x), static_cast<unsigned>(size.y)));
 }
@@ -0,0 +1,97 @@
+#include "../../include/gui/ImageLoader.h"
+
+ImageLoader::ImageLoader(const unsigned rows_per_update, ImageStore &store)
+:
+m_store(store),
+m_rowsPerUpdate(std::max(rows_per_update, 1u)),
+m_path(),
+m_ready(nullptr),
+m_decoding(),
+m_abandoned(),
+m_uploading(nullptr),
+m_uploadedRows(0u)
+{ }
+
+void ImageLoader::request(const std::string &path)
+{
+	if(m_decoding.valid())
+	{
+		m_abandoned.push_back(std::move(m_decoding));
+	}
+	m_uploading.reset();
+	m_uploadedRows = 0u;
+	m_path = path;
+
+	m_ready = m_store.find(path);
+	if(!m_ready)
+	{
+		m_decoding = std::async(std::launch::async, [path]()
+		{
+			sf::Image image;
+			if(!image.loadFromFile(path))
+			{
+				return sf::Image();
+			}
+			return image;
+		});
+	}
+}
+
+bool ImageLoader::isPending() const
+{
+	return m_ready || m_decoding.valid() || m_uploading;
+}
+
+const std::string &ImageLoader::getPath() const
+{
+	return m_path;
+}
+
+ImageStore::Handle ImageLoader::update()
+{
+	this->dropAbandoned();
+	if(m_ready)
+	{
+		return std::move(m_ready);
+	}
+
+	if(m_decoding.valid() && m_decoding.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+	{
+		m_uploading = std::make_shared<StoredImage>();
+		m_uploading->pixels = m_decoding.get();
+		m_uploadedRows = 0u;
+
+		const sf::Vector2u size = m_uploading->pixels.getSize();
+		if(size.x == 0u || size.y == 0u || !m_uploading->texture.create(size.x, size.y))
+		{
+			m_uploading.reset();
+			return std::make_shared<const StoredImage>();
+		}
+	}
+
+	if(m_uploading)
+	{
+		const sf::Vector2u size = m_uploading->pixels.getSize();
+		const unsigned rows = std::min(m_rowsPerUpdate, size.y - m_uploadedRows);
+		const sf::Uint8 *pixels = m_uploading->pixels.getPixelsPtr() + static_cast<std::size_t>(m_uploadedRows) * size.x * 4u;
+		m_uploading->texture.update(pixels, size.x, rows, 0u, m_uploadedRows);
+		m_uploadedRows += rows;
+
+		if(m_uploadedRows >= size.y)
+		{
+			ImageStore::Handle image = m_store.insert(m_path, std::move(m_uploading));
+			m_uploading.reset();
+			return image;
+		}
+	}
+	return nullptr;
+}
+
+//private member functions
+void ImageLoader::dropAbandoned()
+{
+	m_abandoned.erase(std::remove_if(m_abandoned.begin(), m_abandoned.end(), [](const std::future<sf::Image> &decoding)
+	{
+		return decoding.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	}), m_abandoned.end());
+}
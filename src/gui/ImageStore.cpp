@@ -0,0 +1,129 @@
+#include "../../include/gui/ImageStore.h"
+
+#include <filesystem>
+
+ImageStore::ImageStore()
+:
+m_images(),
+m_mutex()
+{ }
+
+ImageStore &ImageStore::shared()
+{
+	static ImageStore store;
+	return store;
+}
+
+ImageStore::Handle ImageStore::load(const std::string &path)
+{
+	if(Handle found = this->find(path))
+	{
+		return found;
+	}
+
+	//resources are decoded from the executable, only other paths touch the filesystem
+	auto image = std::make_shared<StoredImage>();
+	const Resource *resource = Resources::findPath(path);
+	const bool decoded = Resources::isResourcePath(path)
+		? resource && image->pixels.loadFromMemory(resource->data, resource->size)
+		: image->pixels.loadFromFile(path);
+	if(!decoded || !image->texture.loadFromImage(image->pixels))
+	{
+		return std::make_shared<const StoredImage>();
+	}
+	return this->insert(path, std::move(image));
+}
+
+ImageStore::Handle ImageStore::load(const std::string &path, const sf::Vector2u &size)
+{
+	const std::string key = path + "@" + std::to_string(size.x) + "x" + std::to_string(size.y);
+	if(Handle found = this->find(key))
+	{
+		return found;
+	}
+
+	Handle original = this->load(path);
+	const sf::Vector2u original_size = original->pixels.getSize();
+	const sf::Vector2u fit(std::min(original_size.x, size.x), std::min(original_size.y, size.y));
+	if(fit == original_size || fit.x == 0u || fit.y == 0u)
+	{
+		return original;
+	}
+
+	std::vector<std::uint8_t> pixels(static_cast<std::size_t>(fit.x) * fit.y * 4u);
+	ThreadPool::shared().parallelFor(fit.y, 16u, [&](std::size_t begin, std::size_t end)
+	{
+		pk::downscale(original->pixels.getPixelsPtr(), original_size, pixels.data(), fit,
+			static_cast<unsigned>(begin), static_cast<unsigned>(end - begin));
+	});
+
+	auto image = std::make_shared<StoredImage>();
+	image->pixels.create(fit.x, fit.y, pixels.data());
+	if(!image->texture.loadFromImage(image->pixels))
+	{
+		return original;
+	}
+	return this->insert(key, std::move(image));
+}
+
+ImageStore::Handle ImageStore::find(const std::string &path)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto found = m_images.find(ImageStore::keyOf(path));
+	return found != m_images.end() ? found->second.lock() : nullptr;
+}
+
+ImageStore::Handle ImageStore::insert(const std::string &path, Handle image)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	const std::string key = ImageStore::keyOf(path);
+	auto found = m_images.find(key);
+	if(found != m_images.end())
+	{
+		if(Handle stored = found->second.lock())
+		{
+			return stored;
+		}
+	}
+	this->purge();
+	image->memory.setCpu(MemoryCharge::bytesOf(image->pixels.getSize()));
+	image->memory.setGpu(MemoryCharge::bytesOf(image->texture.getSize()));
+	m_images[key] = image;
+	return image;
+}
+
+std::size_t ImageStore::getCount()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	this->purge();
+	return m_images.size();
+}
+
+std::size_t ImageStore::getUsage()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::size_t bytes = 0u;
+	for(const auto &entry : m_images)
+	{
+		if(Handle image = entry.second.lock())
+		{
+			const sf::Vector2u size = image->pixels.getSize();
+			bytes += static_cast<std::size_t>(size.x) * size.y * 4u * 2u;
+		}
+	}
+	return bytes;
+}
+
+//private member functions
+void ImageStore::purge()
+{
+	for(auto it = m_images.begin(); it != m_images.end();)
+	{
+		it = it->second.expired() ? m_images.erase(it) : std::next(it);
+	}
+}
+
+std::string ImageStore::keyOf(const std::string &path)
+{
+	return std::filesystem::path(path).lexically_normal().string();
+}
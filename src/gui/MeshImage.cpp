@@ -0,0 +1,196 @@
+#include "../../include/gui/MeshImage.h"
+
+namespace
+{
+	constexpr std::size_t POINT_RANGE = 2048u;///> Points transformed by one task of the pool
+	constexpr std::size_t VERTEX_RANGE = 6u * POINT_RANGE;///> Vertices written by one task of the pool
+}//anonymous namespace
+
+MeshImage::MeshImage(const sf::Vector2f &position, std::unique_ptr<sf::Texture> texture, const sf::Vector2f &size, const sf::Vector2u &cells)
+:
+m_texture(std::move(texture)),
+m_source(nullptr),
+m_cells(cells),
+m_position(position),
+m_restX(),
+m_restY(),
+m_x(),
+m_y(),
+m_z(),
+m_corners(),
+m_vertices(),
+m_buffer(sf::Triangles, sf::VertexBuffer::Stream),
+m_useBuffer(false),
+m_uploaded(false),
+m_transform(),
+m_warped(false)
+{
+	this->build(position, size);
+}
+
+MeshImage::MeshImage(const sf::Vector2f &position, ImageStore::Handle image, const sf::Vector2f &size, const sf::Vector2u &cells)
+:
+m_texture(image, image ? &image->texture : nullptr),
+m_source(std::move(image)),
+m_cells(cells),
+m_position(position),
+m_restX(),
+m_restY(),
+m_x(),
+m_y(),
+m_z(),
+m_corners(),
+m_vertices(),
+m_buffer(sf::Triangles, sf::VertexBuffer::Stream),
+m_useBuffer(false),
+m_uploaded(false),
+m_transform(),
+m_warped(false)
+{
+	this->build(position, size);
+}
+
+const sf::Vector2u &MeshImage::getCells() const
+{
+	return m_cells;
+}
+
+std::size_t MeshImage::getPointCount() const
+{
+	return m_x.size();
+}
+
+sf::Vector3f MeshImage::getPoint(const std::size_t index) const
+{
+	if(index >= m_x.size())
+	{
+		throw std::out_of_range("MeshImage::getPoint(): there is no point of index " + std::to_string(index));
+	}
+	return sf::Vector3f(m_x[index], m_y[index], m_z[index]);
+}
+
+void MeshImage::update(const em::Matrix4f &transform, const Warp &warp)
+{
+	if(!warp && !m_warped && transform == m_transform)
+	{
+		return;
+	}
+	this->place(transform, warp);
+}
+
+void MeshImage::render(sf::RenderTarget *target, const sf::Shader *shader, const sf::BlendMode &blend)
+{
+	sf::RenderStates states(m_texture.get());
+	states.shader = shader;
+	states.blendMode = blend;
+	if(!m_useBuffer)
+	{
+		target->draw(m_vertices.data(), m_vertices.size(), sf::Triangles, states);
+		return;
+	}
+	if(!m_uploaded)
+	{
+		m_buffer.update(m_vertices.data());
+		m_uploaded = true;
+	}
+	target->draw(m_buffer, states);
+}
+
+//private member functions
+void MeshImage::build(const sf::Vector2f &position, const sf::Vector2f &size)
+{
+	if(!m_texture)
+	{
+		throw std::invalid_argument("MeshImage::build(): the image has no texture");
+	}
+	if(m_cells.x == 0u || m_cells.y == 0u)
+	{
+		throw std::invalid_argument("MeshImage::build(): the mesh needs at least one cell along both sides");
+	}
+	const sf::Vector2f texture_size(m_texture->getSize());
+	const sf::Vector2f drawn = size.x > 0.f && size.y > 0.f ? size : texture_size;
+	m_position = position;
+
+	const unsigned columns = m_cells.x + 1u, rows = m_cells.y + 1u;
+	const std::size_t points = static_cast<std::size_t>(columns) * rows;
+	m_restX.resize(points);
+	m_restY.resize(points);
+	for(unsigned row = 0; row < rows; row++)
+	{
+		for(unsigned column = 0; column < columns; column++)
+		{
+			m_restX[row * columns + column] = drawn.x * column / m_cells.x;
+			m_restY[row * columns + column] = drawn.y * row / m_cells.y;
+		}
+	}
+	m_x.assign(points, 0.f);
+	m_y.assign(points, 0.f);
+	m_z.assign(points, 0.f);
+
+	//the same two triangles per cell as the mesh of AnimatedImage
+	const std::size_t cells = static_cast<std::size_t>(m_cells.x) * m_cells.y;
+	m_corners.clear();
+	m_corners.reserve(cells * 6u);
+	m_vertices.resize(cells * 6u);
+	for(unsigned row = 0; row < m_cells.y; row++)
+	{
+		for(unsigned column = 0; column < m_cells.x; column++)
+		{
+			const std::uint32_t top_left = row * columns + column, bottom_left = top_left + columns;
+			for(const std::uint32_t corner : {top_left, top_left + 1u, bottom_left + 1u, top_left, bottom_left + 1u, bottom_left})
+			{
+				m_vertices[m_corners.size()].texCoords = sf::Vector2f(
+					texture_size.x * m_restX[corner] / drawn.x,
+					texture_size.y * m_restY[corner] / drawn.y);
+				m_corners.push_back(corner);
+			}
+		}
+	}
+
+	m_useBuffer = sf::VertexBuffer::isAvailable() && m_buffer.create(m_vertices.size());
+	this->place(m_transform, nullptr);
+}
+
+void MeshImage::place(const em::Matrix4f &transform, const Warp &warp)
+{
+	const std::size_t points = m_x.size();
+	std::copy(m_restX.begin(), m_restX.end(), m_x.begin());
+	std::copy(m_restY.begin(), m_restY.end(), m_y.begin());
+	std::fill(m_z.begin(), m_z.end(), 0.f);
+	if(warp)
+	{
+		MeshPoints mesh{m_restX.data(), m_restY.data(), m_x.data(), m_y.data(), m_z.data(), points, m_cells.x, m_cells.y};
+		warp(mesh);
+	}
+
+	//the transform pivots around the top-left corner of the image, like AnimatedImage::placement
+	const float m00 = transform[0][0], m01 = transform[0][1], m02 = transform[0][2], m03 = transform[0][3] + m_position.x;
+	const float m10 = transform[1][0], m11 = transform[1][1], m12 = transform[1][2], m13 = transform[1][3] + m_position.y;
+	const float m20 = transform[2][0], m21 = transform[2][1], m22 = transform[2][2], m23 = transform[2][3];
+	float *xs = m_x.data(), *ys = m_y.data(), *zs = m_z.data();
+	ThreadPool::shared().parallelFor(points, POINT_RANGE, [=](std::size_t begin, std::size_t end)
+	{
+		//separate arrays without aliasing, so the loop is vectorized
+		for(std::size_t i = begin; i < end; i++)
+		{
+			const float x = xs[i], y = ys[i], z = zs[i];
+			xs[i] = m00 * x + m01 * y + m02 * z + m03;
+			ys[i] = m10 * x + m11 * y + m12 * z + m13;
+			zs[i] = m20 * x + m21 * y + m22 * z + m23;
+		}
+	});
+
+	const std::uint32_t *corners = m_corners.data();
+	sf::Vertex *vertices = m_vertices.data();
+	ThreadPool::shared().parallelFor(m_vertices.size(), VERTEX_RANGE, [=](std::size_t begin, std::size_t end)
+	{
+		for(std::size_t i = begin; i < end; i++)
+		{
+			vertices[i].position = sf::Vector2f(xs[corners[i]], ys[corners[i]]);
+		}
+	});
+
+	m_transform = transform;
+	m_warped = static_cast<bool>(warp);
+	m_uploaded = false;
+}
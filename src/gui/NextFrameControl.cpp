@@ -12,8 +12,7 @@ AnimControlButton(pos)
 NextFrameControl* NextFrameControl::makeNextFrameButton(const sf::Vector2f &pos)
 {
 	NextFrameControl* outObj = new NextFrameControl(pos);
-	outObj->m_texture.loadFromFile("../res/images/next_button.png");
-	outObj->m_sprite.setTexture(outObj->m_texture);
+	IconAtlas::shared().apply(outObj->m_sprite, Icon::NEXT);
 	return outObj;
 }
 
@@ -21,16 +20,11 @@ NextFrameControl* NextFrameControl::makeNextFrameButton(const sf::Vector2f &pos)
 NextFrameControl* NextFrameControl::makePreviousFrameButton(const sf::Vector2f &pos)
 {
 	NextFrameControl* outObj = new NextFrameControl(pos);
-	outObj->m_texture.loadFromFile("../res/images/previous_button.png");
-	outObj->m_sprite.setTexture(outObj->m_texture);
+	IconAtlas::shared().apply(outObj->m_sprite, Icon::PREVIOUS);
 	return outObj;
 }
 
 	
-void NextFrameControl::render(sf::RenderTarget *target)
-{
-	AnimControlButton::render(target);
-}
 
 
 void NextFrameControl::update(sf::Vector2i mousePos, sf::Event &event)
@@ -41,4 +41,19 @@ void Object::setPosition(const sf::Vector2f &pos)
 void Object::setSize(const sf::Vector2f &size) 
 {
 	this->m_shape.setSize(size);
+}
+
+std::size_t Object::getLookKey() const
+{
+	const std::hash<float> hash;
+	std::size_t key = Object::combineLook(hash(m_shape.getPosition().x), hash(m_shape.getPosition().y));
+	key = Object::combineLook(key, hash(m_shape.getSize().x));
+	key = Object::combineLook(key, hash(m_shape.getSize().y));
+	key = Object::combineLook(key, m_shape.getFillColor().toInteger());
+	return Object::combineLook(key, m_shape.getOutlineColor().toInteger());
+}
+
+std::size_t Object::combineLook(const std::size_t key, const std::size_t value)
+{
+	return key ^ (value + 0x9e3779b97f4a7c15ull + (key << 6) + (key >> 2));
 }
\ No newline at end of file
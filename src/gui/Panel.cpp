@@ -1,13 +1,21 @@
 #include "../../include/gui/Panel.h"
+#include "../../include/gui/IconAtlas.h"
 
 
 Panel::Panel(const sf::Vector2f &pos, const sf::Vector2f &size)
 :
-Object(pos, size)
+Object(pos, size),
+m_layer(),
+m_layerBody(),
+m_batch(),
+m_tracked(),
+m_layerOutdated(true),
+m_layerCharge(MemorySubsystem::GUI)
 {
 	m_shape.setFillColor( sf::Color(40,40,40) );
 	m_shape.setOutlineThickness(-3.f);
 	m_shape.setOutlineColor(sf::Color(90,90,90) );
+	m_batch.setSolidTexture(&IconAtlas::shared().getTexture(), IconAtlas::shared().getWhitePixel());
 }
 
 void Panel::update(sf::Vector2i mousePos, sf::Event &event)
@@ -19,3 +27,56 @@ void Panel::render(sf::RenderTarget *target)
 {
 	target->draw(m_shape);
 }
+
+void Panel::track(const Object *widget)
+{
+	m_tracked.emplace_back(widget, widget->getLookKey());
+	m_layerOutdated = true;
+}
+
+void Panel::renderLayer(sf::RenderTarget *target)
+{
+	for(auto &tracked : m_tracked)
+	{
+		const std::size_t key = tracked.first->getLookKey();
+		if(key != tracked.second)
+		{
+			tracked.second = key;
+			m_layerOutdated = true;
+		}
+	}
+
+	//the layer reaches to the end of the target, dropped lists may leave the panel
+	const sf::Vector2f position = m_shape.getPosition();
+	const sf::Vector2u size(
+		static_cast<unsigned>(std::max(static_cast<float>(target->getSize().x) - position.x, 1.f)),
+		static_cast<unsigned>(std::max(static_cast<float>(target->getSize().y) - position.y, 1.f)));
+	if(m_layer.getSize() != size)
+	{
+		if(!m_layer.create(size.x, size.y))
+		{
+			throw std::runtime_error("Panel::renderLayer(): cannot create the layer");
+		}
+		m_layerCharge.setGpu(MemoryCharge::bytesOf(size));
+		m_layerOutdated = true;
+	}
+
+	if(m_layerOutdated)
+	{
+		m_layer.setView(sf::View(sf::FloatRect(position, static_cast<sf::Vector2f>(size))));
+		m_layer.clear(sf::Color::Transparent);
+		m_batch.clear();
+		this->renderStatic(m_batch);
+		m_batch.draw(m_layer);
+		m_layer.display();
+		m_layerBody.setTexture(m_layer.getTexture(), true);
+		m_layerBody.setPosition(position);
+		m_layerOutdated = false;
+	}
+	target->draw(m_layerBody);
+}
+
+void Panel::renderStatic(GuiBatch &target) const
+{
+	target.add(m_shape);
+}
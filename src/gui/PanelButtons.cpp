@@ -1,4 +1,5 @@
 #include "../../include/gui/PanelButtons.h"
+#include "../../include/animation/AnimationRegistry.h"
 
 
 PanelButton::PanelButton(const sf::Vector2f &pos, const sf::Vector2f &size)
@@ -9,16 +10,13 @@ Panel(pos,size)
     m_imageDown = new ImageButton(sf::Vector2f(pos.x + 10 , pos.y + 30 + size.y/4.f), sf::Vector2f(size.x - 20,size.y/4));
     m_saveButton = new SaveButton(sf::Vector2f(pos.x + size.x/2 -50.f, pos.y + size.y - 55.f ), sf::Vector2f(100.f, 50.f) );
 
-    font = std::make_shared<sf::Font>();
+    font = FontCache::shared().getFont();
     
-    m_animationChoice = new DropdownList(sf::Vector2f(pos.x + 20, pos.y + 50 + size.y/2), sf::Vector2f(size.x - 40, size.y/14), font, sf::String("Dimming"));
-    m_animationChoice->addChoice("Dimming");
-    m_animationChoice->addChoice("Fading");
-    m_animationChoice->addChoice("Pixels Brightness");
-    m_animationChoice->addChoice("Slide Left to Right");//or Swipe Right
-    m_animationChoice->addChoice("Scale From Point");
-    m_animationChoice->addChoice("Ring Animation");
-    m_animationChoice->addChoice("Fly Away Animation");
+    m_animationChoice = new DropdownList(sf::Vector2f(pos.x + 20, pos.y + 50 + size.y/2), sf::Vector2f(size.x - 40, size.y/14), font, sf::String(ANIMATIONS.front().label));
+    for(std::size_t i = 0; i < animationCount(); i++)
+    {
+        m_animationChoice->addChoice(animationInfo(i).label);
+    }
     
     m_framesChoice = new DropdownList(sf::Vector2f(pos.x + 20, pos.y + size.y/14 + size.y/2 +70), sf::Vector2f(size.x - 40, size.y/14), font, sf::String("15 frames"));
     m_framesChoice->addChoice("15 frames");
@@ -26,6 +24,20 @@ Panel(pos,size)
     m_framesChoice->addChoice("60 frames");
     m_framesChoice->addChoice("120 frames");
     m_framesChoice->addChoice("Your Choice");
+
+    m_formatChoice = new DropdownList(sf::Vector2f(pos.x + 20, pos.y + size.y - 70.f - size.y/14), sf::Vector2f(size.x - 40, size.y/14), font, sf::String("BMP frames"));
+    m_formatChoice->addChoice("BMP frames");
+    m_formatChoice->addChoice("GIF animation");
+    m_formatChoice->addChoice("MP4 video (ffmpeg)");
+    m_formatChoice->addChoice("Raw sequence (.bcgraw)");
+    m_formatChoice->addChoice("PNG frames");
+    m_formatChoice->addChoice("QOI frames");
+
+    const Object *widgets[] = { m_imageUp, m_imageDown, m_saveButton, m_animationChoice, m_framesChoice, m_formatChoice };
+    for(const Object *widget : widgets)
+    {
+        this->track(widget);
+    }
 }
 
 PanelButton::~PanelButton()
@@ -34,6 +46,7 @@ PanelButton::~PanelButton()
     delete m_imageDown;
     delete m_animationChoice;
     delete m_framesChoice;
+    delete m_formatChoice;
     delete m_saveButton;
 }
 
@@ -42,45 +55,68 @@ void PanelButton::update(sf::Vector2i mousePos, sf::Event &event)
     m_imageUp->update(mousePos, event);
     m_imageDown->update(mousePos, event);
     m_framesChoice->update(mousePos, event);
-    if(m_framesChoice->isDropped())
-    {
-        m_animationChoice->lockButton();
-        m_saveButton->lockButton();
-    }
-    
-    if(m_animationChoice->getState() == Button::state::LOCKED
-        && !m_framesChoice->isDropped()
-        && !m_framesChoice->isChanged())
+    this->updateLocks();
+
+    m_animationChoice->update(mousePos, event);
+    this->updateLocks();
+
+    m_formatChoice->update(mousePos, event);
+    this->updateLocks();
+
+    m_saveButton->update(mousePos, event);
+}
+
+void PanelButton::updateLocks()
+{
+    //a list is locked while any other one is dropped or its choice is not handled yet
+    DropdownList *lists[] = { m_framesChoice, m_animationChoice, m_formatChoice };
+    bool any_busy = false;
+    for(DropdownList *list : lists)
     {
-        m_animationChoice->unlockButton();
-        m_saveButton->unlockButton();
+        bool other_busy = false;
+        for(DropdownList *other : lists)
+        {
+            if(other != list && (other->isDropped() || other->isChanged()))
+            {
+                other_busy = true;
+            }
+        }
+        if(other_busy)
+        {
+            list->lockButton();
+        }
+        else if(list->getState() == Button::state::LOCKED)
+        {
+            list->unlockButton();
+        }
+        any_busy = any_busy || list->isDropped() || list->isChanged();
     }
 
-    m_animationChoice->update(mousePos, event);
-    if(m_animationChoice->isDropped())
+    if(any_busy)
     {
-        m_framesChoice->lockButton();
         m_saveButton->lockButton();
     }
-    
-    if(m_framesChoice->getState() == Button::state::LOCKED
-        && !m_animationChoice->isDropped()
-        && !m_animationChoice->isChanged())
+    else if(m_saveButton->getState() == Button::state::LOCKED)
     {
-        m_framesChoice->unlockButton();
         m_saveButton->unlockButton();
     }
-    m_saveButton->update(mousePos, event);
 }
 
 void PanelButton::render(sf::RenderTarget *target) 
 {   
-    this->Panel::render(target);
-    m_imageUp->render(target);
-    m_imageDown->render(target);
-    m_saveButton->render(target);
-    m_framesChoice->render(target);
-    m_animationChoice->render(target);
+    //the widgets change only on hover and clicks, otherwise the cached layer is drawn
+    this->renderLayer(target);
+}
+
+void PanelButton::renderStatic(GuiBatch &target) const
+{
+    this->Panel::renderStatic(target);
+    m_imageUp->batch(target);
+    m_imageDown->batch(target);
+    m_saveButton->batch(target);
+    m_formatChoice->batch(target);
+    m_framesChoice->batch(target);
+    m_animationChoice->batch(target);
 }
 
 ImageButton* PanelButton::getImageUp()
@@ -108,11 +144,17 @@ DropdownList* PanelButton::getFramesChoice()
     return m_framesChoice;
 }
 
+DropdownList* PanelButton::getFormatChoice()
+{
+    return m_formatChoice;
+}
+
 const bool PanelButton::isChanged() const
 {
     //return m_imageDown->isChanged() || m_imageUp->isChanged() || m_animationChoice->isChanged();
     return m_imageDown->isChanged() || m_imageUp->isChanged() 
-            || m_animationChoice->isChanged() || m_framesChoice->isChanged();
+            || m_animationChoice->isChanged() || m_framesChoice->isChanged()
+            || m_formatChoice->isChanged();
 }
 
 void PanelButton::changesRead()
@@ -121,4 +163,5 @@ void PanelButton::changesRead()
     m_imageDown -> changeRead();
     m_animationChoice -> changeRead();
     m_framesChoice -> changeRead();
+    m_formatChoice -> changeRead();
 }
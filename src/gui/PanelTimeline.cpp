@@ -1,4 +1,6 @@
 #include "../../include/gui/PanelTimeline.h"
+#include "../../include/program/Program.h"
+#include "../../include/util/Profiler.h"
 
 PanelTimeline::PanelTimeline(const sf::Vector2f &pos, const sf::Vector2f &size)
 :
@@ -6,6 +8,7 @@ Panel( sf::Vector2f( pos.x, pos.y ), sf::Vector2f( size.x, size.y) )
 {
 	m_canvas = new Canvas(	pos + sf::Vector2f(6.f, 6.f),
 					sf::Vector2f(size.x - 12.f, size.y * (17.f/20.f)));
+	m_renderer = new CanvasRenderer(*m_canvas);
 
 	m_control = new StartStopControl(sf::Vector2f(
 					pos.x + 6.f + ((size.x - 12.f) / 2.f) - 20.f,
@@ -22,6 +25,10 @@ Panel( sf::Vector2f( pos.x, pos.y ), sf::Vector2f( size.x, size.y) )
 		sf::Vector2f(pos.x + (size.x / 2.f) - (size.x * (9.f/10.f) / 2.f),
 					m_control->getPosition().y + m_control->getSize().y + 15.f),
 		sf::Vector2f(size.x * (9.f/10.f), 5.f));
+
+	this->track(m_control);
+	this->track(m_next);
+	this->track(m_prev);
 }
 
 PanelTimeline::~PanelTimeline()
@@ -30,6 +37,7 @@ PanelTimeline::~PanelTimeline()
 	delete m_next;
 	delete m_prev;
 	delete m_control;
+	delete m_renderer;
 	delete m_canvas;
 }
 
@@ -63,12 +71,17 @@ Canvas* PanelTimeline::getCanvas()
 	return m_canvas;
 }
 
+void PanelTimeline::modifyCanvas(const std::function<void(Canvas &)> &change)
+{
+	m_renderer->modify(change);
+}
+
 void PanelTimeline::update(sf::Vector2i mousePos, sf::Event &event, const float &deltaTime)
 {
+	BCG_PROFILE_SCOPE("PanelTimeline::update");
 	m_control->update(mousePos, event);
 
     m_timeline->setPlayStatusON_OFF(m_control->isPlay());
-    m_canvas->setAnimationPlayOn(m_control->isPlay());
 
     m_next->update(mousePos, event);
     if( m_next->isPressed() )
@@ -91,16 +104,39 @@ void PanelTimeline::update(sf::Vector2i mousePos, sf::Event &event, const float
     	m_control->pause();
     }
 
-    m_canvas->setCurrentAnimationTime(m_timeline->getCurrentTime());
-	m_canvas->update(mousePos, event);
+    //the canvas renders on its own thread, updates continue until its frame is shown
+    PlaybackCursor playback = m_timeline->getPlayback();
+    playback.setPlaying(m_control->isPlay());
+    m_renderer->submit(playback);
+    if(m_control->isPlay() || m_renderer->isBusy() || playback.isScrubbing())//a resting drag ends the scrub on its own
+    {
+        Program::requestUpdate();
+    }
 }
 
 void PanelTimeline::render(sf::RenderTarget *target)
 {
-	Panel::render(target);
-	m_control->render(target);
-   	m_next->render(target);
-   	m_prev->render(target);
+	//the timeline and the canvas change while playing, only the buttons are kept in the layer
+	this->renderLayer(target);
    	m_timeline->render(target);
-   	m_canvas->render(target);
+   	if(const sf::Texture *frame = m_renderer->acquireFrame())
+   	{
+   		m_canvas->present(target, *frame);
+   	}
+}
+
+void PanelTimeline::renderCanvas(sf::RenderTarget *target)
+{
+	if(const sf::Texture *frame = m_renderer->acquireFrame())
+	{
+		m_canvas->present(target, *frame);
+	}
+}
+
+void PanelTimeline::renderStatic(GuiBatch &target) const
+{
+	Panel::renderStatic(target);
+	m_control->batch(target);
+   	m_next->batch(target);
+   	m_prev->batch(target);
 }
@@ -0,0 +1,210 @@
+#include "../../include/gui/PlaneReadback.h"
+
+#include <SFML/OpenGL.hpp>
+
+#include <mutex>
+
+#ifndef APIENTRY
+	#define APIENTRY
+#endif
+
+namespace
+{
+	//OpenGL 1.1 headers of some platforms lack the enums of buffer objects
+	const GLenum PIXEL_PACK_BUFFER = 0x88EB;
+	const GLenum STREAM_READ = 0x88E1;
+	const GLenum READ_ONLY = 0x88B8;
+
+	/**
+	 * Functions of pixel buffer objects, core since OpenGL 2.1 and looked up at runtime like every extension
+	 */
+	struct BufferFunctions
+	{
+		void (APIENTRY *genBuffers)(GLsizei, GLuint *) = nullptr;
+		void (APIENTRY *deleteBuffers)(GLsizei, const GLuint *) = nullptr;
+		void (APIENTRY *bindBuffer)(GLenum, GLuint) = nullptr;
+		void (APIENTRY *bufferData)(GLenum, std::ptrdiff_t, const void *, GLenum) = nullptr;
+		void *(APIENTRY *mapBuffer)(GLenum, GLenum) = nullptr;
+		GLboolean (APIENTRY *unmapBuffer)(GLenum) = nullptr;
+
+		bool isComplete() const
+		{
+			return genBuffers && deleteBuffers && bindBuffer && bufferData && mapBuffer && unmapBuffer;
+		}
+	};
+
+	BufferFunctions gl;
+	std::once_flag glLoaded;
+
+	template<typename Function>
+	void lookUp(Function &function, const std::string &name)
+	{
+		sf::GlFunctionPointer found = sf::Context::getFunction(name.c_str());
+		if(!found)
+		{
+			found = sf::Context::getFunction((name + "ARB").c_str());
+		}
+		function = reinterpret_cast<Function>(found);
+	}
+
+	/**
+	 * Copies rows counted from the bottom, like OpenGL reads them, into a frame with rows from the top
+	 */
+	void copyFlipped(const std::uint8_t *source, const sf::Vector2u &size, std::uint8_t *output)
+	{
+		const std::size_t row = static_cast<std::size_t>(size.x) * 4u;
+		for(unsigned y = 0; y < size.y; y++)
+		{
+			std::copy(source + y * row, source + (y + 1u) * row, output + (size.y - 1u - y) * row);
+		}
+	}
+}//anonymous namespace
+
+PlaneReadback::PlaneReadback(BufferPool &pool)
+:
+m_pool(pool),
+m_loaded(false),
+m_asynchronous(false),
+m_slots(),
+m_next(0u),
+m_pending(0u)
+{ }
+
+PlaneReadback::~PlaneReadback()
+{
+	if(!m_asynchronous)
+	{
+		return;
+	}
+	TransientContextLock lock;
+	for(const Slot &slot : m_slots)
+	{
+		if(slot.buffer != 0u)
+		{
+			gl.deleteBuffers(1, &slot.buffer);
+		}
+	}
+}
+
+void PlaneReadback::read(sf::RenderTexture &plane, const Consumer &consumer)
+{
+	if(!plane.setActive(true))
+	{
+		throw std::runtime_error("PlaneReadback::read(): cannot activate the plane");
+	}
+	this->loadFunctions();
+	const sf::Vector2u size = plane.getSize();
+	const std::size_t bytes = MemoryCharge::bytesOf(size);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+	if(!m_asynchronous)
+	{
+		ExportFrame frame{size, m_pool.acquire(bytes)};
+		glReadPixels(0, 0, static_cast<GLsizei>(size.x), static_cast<GLsizei>(size.y), GL_RGBA, GL_UNSIGNED_BYTE, frame.pixels->data());
+		const std::size_t row = static_cast<std::size_t>(size.x) * 4u;
+		std::uint8_t *pixels = frame.pixels->data();
+		for(unsigned y = 0; y < size.y / 2u; y++)
+		{
+			std::swap_ranges(pixels + y * row, pixels + (y + 1u) * row, pixels + (size.y - 1u - y) * row);
+		}
+		consumer(std::move(frame));
+		return;
+	}
+
+	if(m_pending == DEPTH)
+	{
+		//the ring is full, its oldest read has had DEPTH frames of time to finish
+		m_pending--;
+		this->map(m_slots[m_next], consumer);
+	}
+
+	Slot &slot = m_slots[m_next];
+	if(slot.buffer == 0u)
+	{
+		gl.genBuffers(1, &slot.buffer);
+	}
+	gl.bindBuffer(PIXEL_PACK_BUFFER, slot.buffer);
+	if(slot.capacity != bytes)
+	{
+		gl.bufferData(PIXEL_PACK_BUFFER, static_cast<std::ptrdiff_t>(bytes), nullptr, STREAM_READ);
+		slot.capacity = bytes;
+	}
+	//with a pack buffer bound the pointer is an offset into it, and the call returns without waiting
+	glReadPixels(0, 0, static_cast<GLsizei>(size.x), static_cast<GLsizei>(size.y), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	gl.bindBuffer(PIXEL_PACK_BUFFER, 0u);
+	slot.size = size;
+	m_next = (m_next + 1u) % DEPTH;
+	m_pending++;
+}
+
+void PlaneReadback::finish(const Consumer &consumer)
+{
+	if(m_pending == 0u)
+	{
+		return;
+	}
+	TransientContextLock lock;
+	while(m_pending > 0u)
+	{
+		Slot &oldest = m_slots[(m_next + DEPTH - m_pending) % DEPTH];
+		m_pending--;
+		this->map(oldest, consumer);
+	}
+}
+
+void PlaneReadback::discard()
+{
+	m_pending = 0u;
+}
+
+bool PlaneReadback::isAsynchronous() const
+{
+	return m_asynchronous;
+}
+
+std::size_t PlaneReadback::getBufferBytes() const
+{
+	std::size_t bytes = 0u;
+	for(const Slot &slot : m_slots)
+	{
+		bytes += slot.capacity;
+	}
+	return bytes;
+}
+
+//private member functions
+void PlaneReadback::loadFunctions()
+{
+	if(m_loaded)
+	{
+		return;
+	}
+	std::call_once(glLoaded, []()
+	{
+		lookUp(gl.genBuffers, "glGenBuffers");
+		lookUp(gl.deleteBuffers, "glDeleteBuffers");
+		lookUp(gl.bindBuffer, "glBindBuffer");
+		lookUp(gl.bufferData, "glBufferData");
+		lookUp(gl.mapBuffer, "glMapBuffer");
+		lookUp(gl.unmapBuffer, "glUnmapBuffer");
+	});
+	m_asynchronous = gl.isComplete();
+	m_loaded = true;
+}
+
+void PlaneReadback::map(Slot &slot, const Consumer &consumer)
+{
+	gl.bindBuffer(PIXEL_PACK_BUFFER, slot.buffer);
+	const std::uint8_t *mapped = static_cast<const std::uint8_t *>(gl.mapBuffer(PIXEL_PACK_BUFFER, READ_ONLY));
+	if(!mapped)
+	{
+		gl.bindBuffer(PIXEL_PACK_BUFFER, 0u);
+		m_pending = 0u;
+		throw std::runtime_error("PlaneReadback::map(): cannot map the pixels read from the GPU");
+	}
+	ExportFrame frame{slot.size, m_pool.acquire(MemoryCharge::bytesOf(slot.size))};
+	copyFlipped(mapped, slot.size, frame.pixels->data());
+	gl.unmapBuffer(PIXEL_PACK_BUFFER);
+	gl.bindBuffer(PIXEL_PACK_BUFFER, 0u);
+	consumer(std::move(frame));
+}
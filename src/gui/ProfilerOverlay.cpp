@@ -0,0 +1,122 @@
+#include "../../include/gui/ProfilerOverlay.h"
+#include "../../include/gui/FontCache.h"
+#include "../../include/gui/IconAtlas.h"
+
+#include <cstdio>
+
+namespace
+{
+	const unsigned FONT_SIZE = 12u;
+	const float LINE_HEIGHT = 15.f;
+	const float PADDING = 6.f;
+	const float WIDTH = 300.f;
+	const float GRAPH_HEIGHT = 60.f;
+	const float GRAPH_RANGE_MS = 50.f;//frame time at the top of the graph
+	const float FRAME_BUDGET_MS = 1000.f / 60.f;
+
+	std::string formatMs(const float ms)
+	{
+		char buffer[16];
+		std::snprintf(buffer, sizeof(buffer), "%6.2f", ms);
+		return buffer;
+	}
+
+	std::string formatMiB(const std::size_t bytes)
+	{
+		char buffer[16];
+		std::snprintf(buffer, sizeof(buffer), "%7.1f", bytes / (1024.0 * 1024.0));
+		return buffer;
+	}
+}//anonymous namespace
+
+ProfilerOverlay::ProfilerOverlay(const sf::Vector2f &pos)
+:
+m_position(pos),
+m_visible(false),
+m_font(FontCache::shared().getFont()),
+m_batch()
+{
+	FontCache::shared().prepare(FONT_SIZE, false);
+	m_batch.setSolidTexture(&IconAtlas::shared().getTexture(), IconAtlas::shared().getWhitePixel());
+}
+
+void ProfilerOverlay::setVisible(const bool visible)
+{
+	m_visible = visible;
+	Profiler::shared().setEnabled(visible);
+}
+
+bool ProfilerOverlay::isVisible() const
+{
+	return m_visible;
+}
+
+void ProfilerOverlay::render(sf::RenderTarget *target)
+{
+	if(!m_visible)
+	{
+		return;
+	}
+
+	const std::vector<Profiler::Section> sections = Profiler::shared().getSections();
+	const std::vector<float> frame_times = Profiler::shared().getFrameTimes();
+	const float text_height = (sections.size() + 1u) * LINE_HEIGHT;
+	const std::size_t memory_lines = static_cast<std::size_t>(MemorySubsystem::COUNT) + 1u;
+	const float memory_height = memory_lines * LINE_HEIGHT;
+
+	m_batch.clear();
+	sf::RectangleShape box(sf::Vector2f(WIDTH, text_height + GRAPH_HEIGHT + memory_height + 4.f * PADDING));
+	box.setPosition(m_position);
+	box.setFillColor(sf::Color(0, 0, 0, 180));
+	m_batch.add(box);
+
+	sf::Text line("", *m_font, FONT_SIZE);
+	line.setFillColor(sf::Color(230, 230, 230));
+	const float last_frame = frame_times.empty() ? 0.f : frame_times.back();
+	line.setString("frame " + formatMs(last_frame) + " ms   last / avg");
+	line.setPosition(m_position + sf::Vector2f(PADDING, PADDING));
+	m_batch.add(line);
+	for(std::size_t i = 0; i < sections.size(); i++)
+	{
+		line.setString(formatMs(sections[i].lastMs) + " " + formatMs(sections[i].averageMs) + "  " + sections[i].name);
+		line.setPosition(m_position + sf::Vector2f(PADDING, PADDING + (i + 1u) * LINE_HEIGHT));
+		m_batch.add(line);
+	}
+
+	//one bar per frame, newest on the right, red when over the budget
+	const sf::Vector2f graph(m_position.x + PADDING, m_position.y + 2.f * PADDING + text_height);
+	const float graph_width = WIDTH - 2.f * PADDING;
+	const float bar_width = graph_width / Profiler::FRAME_HISTORY;
+	sf::RectangleShape bar;
+	for(std::size_t i = 0; i < frame_times.size(); i++)
+	{
+		const float height = std::min(frame_times[i] / GRAPH_RANGE_MS, 1.f) * GRAPH_HEIGHT;
+		bar.setSize(sf::Vector2f(std::max(bar_width - 0.5f, 0.5f), height));
+		bar.setPosition(graph.x + graph_width - (frame_times.size() - i) * bar_width, graph.y + GRAPH_HEIGHT - height);
+		bar.setFillColor(frame_times[i] > FRAME_BUDGET_MS ? sf::Color(220, 80, 60) : sf::Color(90, 200, 90));
+		m_batch.add(bar);
+	}
+	sf::RectangleShape budget(sf::Vector2f(graph_width, 1.f));
+	budget.setPosition(graph.x, graph.y + GRAPH_HEIGHT * (1.f - FRAME_BUDGET_MS / GRAPH_RANGE_MS));
+	budget.setFillColor(sf::Color(255, 255, 255, 160));
+	m_batch.add(budget);
+
+	//memory of the subsystems in MiB, red when over the budget
+	const MemoryBudget &memory = MemoryBudget::shared();
+	const sf::Vector2f listing(m_position.x + PADDING, graph.y + GRAPH_HEIGHT + PADDING);
+	line.setString("memory " + formatMiB(memory.getTotalUsage()) + " / " + formatMiB(memory.getBudget()) + " MiB");
+	line.setFillColor(memory.isOverBudget() ? sf::Color(220, 80, 60) : sf::Color(230, 230, 230));
+	line.setPosition(listing);
+	m_batch.add(line);
+	line.setFillColor(sf::Color(230, 230, 230));
+	for(std::size_t i = 0; i + 1u < memory_lines; i++)
+	{
+		const MemorySubsystem subsystem = static_cast<MemorySubsystem>(i);
+		line.setString("cpu" + formatMiB(memory.getCpuUsage(subsystem)) + " gpu" + formatMiB(memory.getGpuUsage(subsystem))
+			+ "  " + MemoryBudget::getName(subsystem));
+		line.setPosition(listing + sf::Vector2f(0.f, (i + 1u) * LINE_HEIGHT));
+		m_batch.add(line);
+	}
+
+	m_batch.draw(*target);
+}
@@ -0,0 +1,343 @@
+#include "../../include/gui/Project.h"
+#include "../../include/gui/ThumbnailLoader.h"
+#include "../../include/export/ImageEncoder.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+	const char *BASE64 = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	std::string trim(const std::string &text)
+	{
+		const std::size_t begin = text.find_first_not_of(" \t\r");
+		if(begin == std::string::npos)
+		{
+			return std::string();
+		}
+		return text.substr(begin, text.find_last_not_of(" \t\r") - begin + 1u);
+	}
+
+	std::string encodeBase64(const std::vector<std::uint8_t> &bytes)
+	{
+		std::string text;
+		text.reserve((bytes.size() + 2u) / 3u * 4u);
+		for(std::size_t i = 0; i < bytes.size(); i += 3u)
+		{
+			const std::size_t left = std::min<std::size_t>(bytes.size() - i, 3u);
+			std::uint32_t group = static_cast<std::uint32_t>(bytes[i]) << 16;
+			group |= left > 1u ? static_cast<std::uint32_t>(bytes[i + 1u]) << 8 : 0u;
+			group |= left > 2u ? static_cast<std::uint32_t>(bytes[i + 2u]) : 0u;
+			for(std::size_t c = 0; c < 4u; c++)
+			{
+				text += c <= left ? BASE64[(group >> (18u - 6u * c)) & 0x3Fu] : '=';
+			}
+		}
+		return text;
+	}
+
+	std::vector<std::uint8_t> decodeBase64(const std::string &text)
+	{
+		std::array<int, 256> values;
+		values.fill(-1);
+		for(int i = 0; i < 64; i++)
+		{
+			values[static_cast<unsigned char>(BASE64[i])] = i;
+		}
+		std::vector<std::uint8_t> bytes;
+		bytes.reserve(text.size() / 4u * 3u);
+		std::uint32_t group = 0u;
+		unsigned bits = 0u;
+		for(const char c : text)
+		{
+			const int value = values[static_cast<unsigned char>(c)];
+			if(value < 0)//padding
+			{
+				break;
+			}
+			group = (group << 6) | static_cast<std::uint32_t>(value);
+			bits += 6u;
+			if(bits >= 8u)
+			{
+				bits -= 8u;
+				bytes.push_back(static_cast<std::uint8_t>(group >> bits));
+			}
+		}
+		return bytes;
+	}
+
+	/**
+	 * Reads a slide line: the quoted path, optionally the animation and the length leading to it
+	 */
+	void readSlide(const std::string &value, std::string &path, SlideTransition &transition, const std::string &file)
+	{
+		std::istringstream fields(value);
+		std::string animation;
+		if(!(fields >> std::quoted(path)) || path.empty())
+		{
+			throw std::runtime_error("Project::load(): slide without a path in " + file);
+		}
+		if(fields >> animation)
+		{
+			transition.animation = findAnimation(animation);
+			if(transition.animation == animationCount())
+			{
+				throw std::runtime_error("Project::load(): unknown animation " + animation + " in " + file);
+			}
+		}
+		if(fields >> transition.length && !(transition.length > 0.f))
+		{
+			throw std::runtime_error("Project::load(): length has to be positive in " + file);
+		}
+	}
+}//anonymous namespace
+
+Project::Project()
+:
+m_path(),
+m_slides(),
+m_presets()
+{ }
+
+bool Project::isProjectPath(const std::string &path)
+{
+	return std::filesystem::path(path).extension() == Project::EXTENSION;
+}
+
+Project Project::load(const std::string &path)
+{
+	std::ifstream file(path);
+	if(!file)
+	{
+		throw std::runtime_error("Project::load(): cannot open " + path);
+	}
+	const std::filesystem::path directory = std::filesystem::path(path).parent_path();
+
+	Project project;
+	project.m_path = path;
+	std::string line;
+	while(std::getline(file, line))
+	{
+		const std::size_t separator = line.find('=');
+		if(trim(line).empty() || trim(line)[0] == '#' || separator == std::string::npos)
+		{
+			continue;
+		}
+		const std::string key = trim(line.substr(0u, separator));
+		const std::string value = trim(line.substr(separator + 1u));
+		if(key == "version")
+		{
+			if(std::strtoul(value.c_str(), nullptr, 10) > Project::VERSION)
+			{
+				throw std::runtime_error("Project::load(): " + path + " was saved by a newer version of the application");
+			}
+		}
+		else if(key == "export")
+		{
+			ExportPreset preset;
+			std::istringstream fields(value);
+			if(!(fields >> std::quoted(preset.name) >> preset.format >> preset.frames))
+			{
+				throw std::runtime_error("Project::load(): broken export preset in " + path);
+			}
+			project.setPreset(preset);
+		}
+		else if(key == "slide")
+		{
+			Slide slide;
+			readSlide(value, slide.path, slide.transition, path);
+			if(!Resources::isResourcePath(slide.path) && std::filesystem::path(slide.path).is_relative())
+			{
+				slide.path = (directory / slide.path).lexically_normal().string();
+			}
+			project.m_slides.push_back(std::move(slide));
+		}
+		else if(key == "thumbnail" && !project.m_slides.empty())
+		{
+			//kept encoded, most thumbnails of a big deck are never shown
+			std::istringstream fields(value);
+			Slide &slide = project.m_slides.back();
+			fields >> slide.stamp >> slide.thumbnail;
+		}
+	}
+	return project;
+}
+
+void Project::save(const std::string &path)
+{
+	std::error_code error;
+	const std::filesystem::path directory = std::filesystem::absolute(std::filesystem::path(path).parent_path(), error);
+	std::ostringstream text;
+	text << "version = " << Project::VERSION << "\n";
+	for(const ExportPreset &preset : m_presets)
+	{
+		text << "export = " << std::quoted(preset.name) << " " << preset.format << " " << preset.frames << "\n";
+	}
+	for(std::size_t i = 0; i < m_slides.size(); i++)
+	{
+		Slide &slide = m_slides[i];
+		std::string written = slide.path;
+		if(!Resources::isResourcePath(written))
+		{
+			//images next to the project stay found when the project is moved with them
+			const std::filesystem::path relative = std::filesystem::absolute(written, error).lexically_relative(directory);
+			if(!relative.empty() && *relative.begin() != "..")
+			{
+				written = relative.generic_string();
+			}
+		}
+		text << "slide = " << std::quoted(written);
+		if(i > 0u)
+		{
+			text << " " << animationInfo(slide.transition.animation).name << " " << slide.transition.length;
+		}
+		text << "\n";
+
+		if(slide.thumbnail.empty() || slide.stamp != Project::stampOf(slide.path))
+		{
+			this->makeThumbnail(slide);
+		}
+		if(!slide.thumbnail.empty())
+		{
+			text << "thumbnail = " << slide.stamp << " " << slide.thumbnail << "\n";
+		}
+	}
+
+	const std::string temporary = path + ".tmp";
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		file << text.str();
+		if(!file.flush())
+		{
+			throw std::runtime_error("Project::save(): cannot write " + temporary);
+		}
+	}
+	std::filesystem::rename(temporary, path, error);
+	if(error)
+	{
+		std::filesystem::remove(temporary, error);
+		throw std::runtime_error("Project::save(): cannot replace " + path);
+	}
+	m_path = path;
+}
+
+const std::string &Project::getPath() const
+{
+	return m_path;
+}
+
+void Project::setDeck(const SlideDeck &deck)
+{
+	std::vector<Slide> slides(deck.getSlideCount());
+	for(std::size_t i = 0; i < slides.size(); i++)
+	{
+		slides[i].path = deck.getPath(i);
+		if(i > 0u)
+		{
+			slides[i].transition = deck.getTransition(i - 1u);
+		}
+		auto kept = std::find_if(m_slides.begin(), m_slides.end(), [&slides, i](const Slide &slide) { return slide.path == slides[i].path; });
+		if(kept != m_slides.end())
+		{
+			slides[i].stamp = kept->stamp;
+			slides[i].thumbnail = kept->thumbnail;
+			slides[i].decoded = kept->decoded;
+		}
+	}
+	m_slides = std::move(slides);
+}
+
+SlideDeck Project::createDeck() const
+{
+	SlideDeck deck;
+	for(const Slide &slide : m_slides)
+	{
+		deck.addSlide(slide.path, slide.transition);
+	}
+	return deck;
+}
+
+std::size_t Project::getSlideCount() const
+{
+	return m_slides.size();
+}
+
+const std::vector<Project::ExportPreset> &Project::getPresets() const
+{
+	return m_presets;
+}
+
+void Project::setPreset(const ExportPreset &preset)
+{
+	auto found = std::find_if(m_presets.begin(), m_presets.end(), [&preset](const ExportPreset &kept) { return kept.name == preset.name; });
+	if(found != m_presets.end())
+	{
+		*found = preset;
+	}
+	else
+	{
+		m_presets.push_back(preset);
+	}
+}
+
+ImageStore::Handle Project::getThumbnail(const std::size_t slide)
+{
+	if(slide >= m_slides.size())
+	{
+		throw std::out_of_range("Project::getThumbnail(): there is no slide of index " + std::to_string(slide));
+	}
+	Slide &shown = m_slides[slide];
+	if(!shown.decoded && !shown.thumbnail.empty() && shown.stamp == Project::stampOf(shown.path))
+	{
+		const std::vector<std::uint8_t> png = decodeBase64(shown.thumbnail);
+		auto image = std::make_shared<StoredImage>();
+		if(image->pixels.loadFromMemory(png.data(), png.size()) && image->texture.loadFromImage(image->pixels))
+		{
+			image->pixels = sf::Image();//the buttons only show the texture
+			shown.decoded = ThumbnailCache::shared().insert(m_path + "#" + shown.path, sf::Vector2u(THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT), std::move(image));
+		}
+	}
+	return shown.decoded;
+}
+
+//private member functions
+std::string Project::stampOf(const std::string &path)
+{
+	if(Resources::isResourcePath(path))
+	{
+		return "resource";//resources change only with the executable
+	}
+	std::error_code error;
+	const std::uintmax_t size = std::filesystem::file_size(path, error);
+	if(error)
+	{
+		return std::string();
+	}
+	const auto modified = std::filesystem::last_write_time(path, error);
+	if(error)
+	{
+		return std::string();
+	}
+	return std::to_string(size) + "-" + std::to_string(modified.time_since_epoch().count());
+}
+
+void Project::makeThumbnail(Slide &slide) const
+{
+	slide.stamp = Project::stampOf(slide.path);
+	slide.thumbnail.clear();
+	slide.decoded = nullptr;
+	if(slide.stamp.empty())
+	{
+		return;
+	}
+	const ImageStore::Handle image = ImageStore::shared().load(slide.path, sf::Vector2u(THUMBNAIL_WIDTH, THUMBNAIL_HEIGHT));
+	const sf::Vector2u size = image->pixels.getSize();
+	if(size.x == 0u || size.y == 0u)
+	{
+		return;
+	}
+	slide.thumbnail = encodeBase64(ImageEncoder::encodePng(image->pixels.getPixelsPtr(), size));
+}
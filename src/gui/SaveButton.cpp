@@ -7,11 +7,14 @@ SaveButton::SaveButton(const sf::Vector2f &pos, const sf::Vector2f &size)
 {
     m_shape.setOutlineThickness(0.f);
     m_shape.setOutlineColor( sf::Color::Black );
-    m_texture.loadFromFile("../res/images/save_icon.png");
-    m_spr.setTexture(m_texture);
+    IconAtlas::shared().apply(m_spr, Icon::SAVE);
+    const sf::IntRect &icon = IconAtlas::shared().getRect(Icon::SAVE);
     m_spr.setPosition(m_shape.getPosition().x, m_shape.getPosition().y);
-    m_spr.setScale(static_cast<float>((m_shape.getSize().x) / (m_texture.getSize().x)), 
-            static_cast<float>((m_shape.getSize().y) / (m_texture .getSize().y) ));
+    if(icon.width > 0 && icon.height > 0)
+    {
+        m_spr.setScale(static_cast<float>((m_shape.getSize().x) / (icon.width)), 
+            static_cast<float>((m_shape.getSize().y) / (icon.height) ));
+    }
             
 }
 
@@ -26,10 +29,10 @@ SaveButton::SaveButton(SaveButton &&source)
 Button(source)
 {}
 
-void SaveButton::render(sf::RenderTarget *target)
+void SaveButton::batch(GuiBatch &target) const
 {   
-    target->draw(m_shape);
-    target->draw(m_spr);
+    target.add(m_shape);
+    target.add(m_spr);
 }
 
 void SaveButton::update(sf::Vector2i mousePos, sf::Event &event)
@@ -18,6 +18,10 @@ unsigned short Settings::getCurrentFrames() const
 {
 	return m_frames;
 }
+unsigned short Settings::getExportFormat() const
+{
+	return m_exportFormat;
+}
 
 void Settings::setPath1(const std::string &path1)
 {
@@ -35,6 +39,10 @@ void Settings::setCurrentFrames(unsigned short frames)
 {
 	m_frames = frames;
 }
+void Settings::setExportFormat(unsigned short format)
+{
+	m_exportFormat = format;
+}
 
 Settings* Settings::getInstance()
 {
@@ -0,0 +1,230 @@
+#include "../../include/gui/SlideDeck.h"
+
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+SlideDeck::SlideDeck()
+:
+m_slides(),
+m_current(0u),
+m_held(),
+m_loading()
+{ }
+
+SlideDeck SlideDeck::fromFile(const std::string &path, const SlideTransition &defaults)
+{
+	std::ifstream file(path);
+	if(!file)
+	{
+		throw std::runtime_error("SlideDeck::fromFile(): cannot open " + path);
+	}
+
+	SlideDeck deck;
+	std::string line;
+	while(std::getline(file, line))
+	{
+		std::istringstream fields(line);
+		std::string image;
+		if(!(fields >> std::quoted(image)) || image.empty() || image[0] == '#')
+		{
+			continue;
+		}
+
+		SlideTransition transition = defaults;
+		std::string animation;
+		if(fields >> animation)
+		{
+			transition.animation = findAnimation(animation);
+			if(transition.animation == animationCount())
+			{
+				throw std::runtime_error("SlideDeck::fromFile(): unknown animation " + animation + " in " + path);
+			}
+		}
+		if(fields >> transition.length && !(transition.length > 0.f))
+		{
+			throw std::runtime_error("SlideDeck::fromFile(): length has to be positive in " + path);
+		}
+		deck.addSlide(image, transition);
+	}
+	return deck;
+}
+
+void SlideDeck::addSlide(const std::string &path, const SlideTransition &transition)
+{
+	m_slides.push_back(Slide{path, transition});
+}
+
+void SlideDeck::clear()
+{
+	m_loading.clear();
+	m_held.clear();
+	m_slides.clear();
+	m_current = 0u;
+}
+
+std::size_t SlideDeck::getSlideCount() const
+{
+	return m_slides.size();
+}
+
+std::size_t SlideDeck::getTransitionCount() const
+{
+	return m_slides.empty() ? 0u : m_slides.size() - 1u;
+}
+
+const std::string &SlideDeck::getPath(const std::size_t slide) const
+{
+	if(slide >= m_slides.size())
+	{
+		throw std::out_of_range("SlideDeck::getPath(): there is no slide of index " + std::to_string(slide));
+	}
+	return m_slides[slide].path;
+}
+
+const SlideTransition &SlideDeck::getTransition(const std::size_t transition) const
+{
+	if(transition >= this->getTransitionCount())
+	{
+		throw std::out_of_range("SlideDeck::getTransition(): there is no transition of index " + std::to_string(transition));
+	}
+	return m_slides[transition + 1u].transition;
+}
+
+std::size_t SlideDeck::getCurrent() const
+{
+	return m_current;
+}
+
+void SlideDeck::show(Canvas &canvas, const std::size_t transition, const bool use_shader)
+{
+	const SlideTransition &shown = this->getTransition(transition);
+	m_current = transition;
+	this->keepWindow(canvas);
+	this->finish(canvas, transition);
+	this->finish(canvas, transition + 1u);
+
+	canvas.setStartingImage(m_slides[transition].path);
+	canvas.setEndingImage(m_slides[transition + 1u].path);
+	canvas.setAnimation(createAnimation(shown.animation), use_shader);
+	canvas.setTotalAnimationTime(shown.length);
+	canvas.setCurrentAnimationTime(0.f);
+}
+
+bool SlideDeck::showNext(Canvas &canvas, const bool use_shader)
+{
+	if(m_current + 1u >= this->getTransitionCount())
+	{
+		return false;
+	}
+	this->show(canvas, m_current + 1u, use_shader);
+	return true;
+}
+
+void SlideDeck::update(const Canvas &canvas)
+{
+	for(auto it = m_loading.begin(); it != m_loading.end();)
+	{
+		if(ImageStore::Handle image = it->second->update())
+		{
+			//the decoded original is released once the canvas variant is derived from it
+			const std::size_t slide = it->first;
+			it = m_loading.erase(it);
+			this->hold(canvas, slide);
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
+bool SlideDeck::isPrefetching() const
+{
+	return !m_loading.empty();
+}
+
+bool SlideDeck::isReady(const std::size_t transition) const
+{
+	if(transition >= this->getTransitionCount())
+	{
+		return false;
+	}
+	for(const std::size_t slide : { transition, transition + 1u })
+	{
+		if(m_loading.count(slide) || !m_held.count(slide))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+std::size_t SlideDeck::getHeldCount() const
+{
+	return m_held.size();
+}
+
+void SlideDeck::render(Canvas &canvas, const unsigned frames, const std::function<void(ExportFrame)> &consumer, const bool use_shader)
+{
+	for(std::size_t transition = 0; transition < this->getTransitionCount(); transition++)
+	{
+		this->show(canvas, transition, use_shader);
+		canvas.renderSequence(FrameGrid(frames, this->getTransition(transition).length).times(), consumer);
+		this->update(canvas);
+	}
+}
+
+//private member functions
+void SlideDeck::keepWindow(const Canvas &canvas)
+{
+	const std::size_t first = m_current, last = std::min(m_current + PREFETCH_AHEAD, m_slides.size() - 1u);
+	auto outside = [first, last](const std::size_t slide) { return slide < first || slide > last; };
+	for(auto it = m_held.begin(); it != m_held.end();)
+	{
+		it = outside(it->first) ? m_held.erase(it) : std::next(it);
+	}
+	for(auto it = m_loading.begin(); it != m_loading.end();)
+	{
+		it = outside(it->first) ? m_loading.erase(it) : std::next(it);
+	}
+
+	for(std::size_t slide = first; slide <= last; slide++)
+	{
+		if(m_held.count(slide) || m_loading.count(slide))
+		{
+			continue;
+		}
+		//resources are decoded from memory at once, the loader reads only files
+		if(Resources::isResourcePath(m_slides[slide].path))
+		{
+			this->hold(canvas, slide);
+			continue;
+		}
+		auto loader = std::make_unique<ImageLoader>();
+		loader->request(m_slides[slide].path);
+		m_loading.emplace(slide, std::move(loader));
+	}
+}
+
+void SlideDeck::finish(const Canvas &canvas, const std::size_t slide)
+{
+	auto found = m_loading.find(slide);
+	if(found == m_loading.end())
+	{
+		return;
+	}
+	ImageStore::Handle image = found->second->update();
+	while(!image)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		image = found->second->update();
+	}
+	m_loading.erase(found);
+	this->hold(canvas, slide);//derived from the original while it is still held
+}
+
+void SlideDeck::hold(const Canvas &canvas, const std::size_t slide)
+{
+	m_held[slide] = canvas.loadImage(m_slides[slide].path);
+}
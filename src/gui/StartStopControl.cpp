@@ -5,7 +5,7 @@ StartStopControl::StartStopControl()
 AnimControlButton(),
 m_isPlay(false)
 {
-	m_texture.loadFromFile("../res/images/play_button.png");
+	IconAtlas::shared().apply(m_sprite, Icon::PLAY);
 } 
 
 StartStopControl::StartStopControl(const sf::Vector2f &pos)
@@ -13,8 +13,7 @@ StartStopControl::StartStopControl(const sf::Vector2f &pos)
 AnimControlButton(pos),
 m_isPlay(false)
 {
-	m_texture.loadFromFile("../res/images/play_button.png");
-	m_sprite.setTexture(m_texture);
+	IconAtlas::shared().apply(m_sprite, Icon::PLAY);
 } 
 
 bool StartStopControl::isPlay() const
@@ -25,15 +24,13 @@ bool StartStopControl::isPlay() const
 void StartStopControl::play()
 {
 	m_isPlay = true;
-	m_texture.loadFromFile("../res/images/pause_button.png");
-	m_sprite.setTexture(m_texture);
+	IconAtlas::shared().apply(m_sprite, Icon::PAUSE);
 }
 
 void StartStopControl::pause()
 {
 	m_isPlay = false;
-	m_texture.loadFromFile("../res/images/play_button.png");
-	m_sprite.setTexture(m_texture);
+	IconAtlas::shared().apply(m_sprite, Icon::PLAY);
 }
 
 void StartStopControl::update(sf::Vector2i mousePos, sf::Event &event) 
@@ -62,20 +59,20 @@ void StartStopControl::update(sf::Vector2i mousePos, sf::Event &event)
 	}
 }
 
-void StartStopControl::render(sf::RenderTarget *target) 
-{
-	AnimControlButton::render(target);
-}
-
 void StartStopControl::ON_OFF()
 {
 	m_isPlay = !m_isPlay;
 	if(m_isPlay)
 	{
-		m_texture.loadFromFile("../res/images/pause_button.png");
+		IconAtlas::shared().apply(m_sprite, Icon::PAUSE);
 	}
 	else
 	{
-		m_texture.loadFromFile("../res/images/play_button.png");
+		IconAtlas::shared().apply(m_sprite, Icon::PLAY);
 	}
 }
+
+std::size_t StartStopControl::getLookKey() const
+{
+	return Object::combineLook(AnimControlButton::getLookKey(), m_isPlay);
+}
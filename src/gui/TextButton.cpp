@@ -1,5 +1,4 @@
 #include "../../include/gui/TextButton.h"
-#include "../../res/fonts/TerminusTTF.h"
 
 TextButton::TextButton()
 :
@@ -19,26 +18,16 @@ Button(pos, size),
 m_font(font),
 m_label(sf::Text())
 {
-	if(m_font == nullptr)//if font wasn't given as parameter
+	//without a loaded font the one of the GUI is shared, its glyphs are rasterized only once
+	if(m_font == nullptr || m_font->getInfo().family.empty())
 	{
-		m_font = std::make_shared<sf::Font>();
-	}
-	
-	if(m_font->getInfo().family.empty())//if font was given, but without loading actual font
-	{
-		if(!m_font->loadFromFile("../res/fonts/Noir_regular.otf"))
-		{
-			//throw std::runtime_error("TextButton: Could not load \"res/fonts/Noir_regular.otf\" font.");
-			if(!m_font->loadFromMemory(font_data, font_data_size))
-			{
-				throw std::runtime_error("TextButton: Could not load \"res/fonts/TerminusTTF\" font.");
-			}
-		}
+		m_font = FontCache::shared().getFont();
 	}
 
 	m_label.setFont(*m_font);
 	m_label.setStyle(sf::Text::Bold);
 	m_label.setCharacterSize(m_shape.getSize().y / 3.f);
+	this->prepareGlyphs();
 	if(!label.isEmpty())
 	{
 		m_label.setString(label);
@@ -90,15 +79,11 @@ void TextButton::setFont(std::shared_ptr<sf::Font> new_font)
 	}
 	else
 	{
-		if(new_font->getInfo().family.empty())//if font was given, but without loading actual font
-		{
-			m_font = new_font;
-			if(!m_font->loadFromFile("../res/fonts/Noir_regular.otf"))
-			{
-				throw std::runtime_error("TextButton: Could not load \"res/fonts/Noir_regular.otf\" font.");
-			}
-			this->centerText();
-		}
+		//a font given without loading actual font is replaced by the font of the GUI
+		m_font = new_font->getInfo().family.empty() ? FontCache::shared().getFont() : new_font;
+		m_label.setFont(*m_font);
+		this->prepareGlyphs();
+		this->centerText();
 	}
 }
 
@@ -112,6 +97,7 @@ void TextButton::setFontSize(const unsigned int &pixels)
 	{
 		m_label.setCharacterSize(pixels);
 	}
+	this->prepareGlyphs();
 	this->centerText();
 }
 
@@ -120,18 +106,31 @@ void TextButton::update(sf::Vector2i mousePos, sf::Event &event)
 	Button::update(mousePos, event);
 }
 
-void TextButton::render(sf::RenderTarget *target)
+void TextButton::batch(GuiBatch &target) const
 {
-	Button::render(target);
+	Button::batch(target);
 	if( (m_font != nullptr) &&
 		!m_label.getString().isEmpty() &&
 		(m_label.getFont() != nullptr) )
 	{
-		target->draw(m_label);
+		target.add(m_label);
 	}
 }
 
+std::size_t TextButton::getLookKey() const
+{
+	return Object::combineLook(Button::getLookKey(), std::hash<std::string>()(m_label.getString().toAnsiString()));
+}
+
 //private member functions
+void TextButton::prepareGlyphs()
+{
+	if(m_font == FontCache::shared().getFont())
+	{
+		FontCache::shared().prepare(m_label.getCharacterSize(), (m_label.getStyle() & sf::Text::Bold) != 0u);
+	}
+}
+
 void TextButton::centerText()
 {
 	m_label.setPosition(
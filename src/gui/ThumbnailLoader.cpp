@@ -0,0 +1,165 @@
+#include "../../include/gui/ThumbnailLoader.h"
+
+namespace
+{
+	/**
+	 * Shrinks the image into the size in every axis bigger than it, a copy if it fits already
+	 */
+	sf::Image shrink(const sf::Image &image, const sf::Vector2u &size)
+	{
+		const sf::Vector2u original = image.getSize();
+		const sf::Vector2u fit(std::min(original.x, std::max(size.x, 1u)), std::min(original.y, std::max(size.y, 1u)));
+		if(fit == original || original.x == 0u || original.y == 0u)
+		{
+			return image;
+		}
+		std::vector<std::uint8_t> pixels(static_cast<std::size_t>(fit.x) * fit.y * 4u);
+		pk::downscale(image.getPixelsPtr(), original, pixels.data(), fit, 0u, fit.y);
+		sf::Image shrunk;
+		shrunk.create(fit.x, fit.y, pixels.data());
+		return shrunk;
+	}
+}//anonymous namespace
+
+ThumbnailCache::ThumbnailCache(const std::size_t capacity)
+:
+m_capacity(capacity),
+m_usage(0u),
+m_entries(),
+m_index(),
+m_mutex()
+{ }
+
+ThumbnailCache &ThumbnailCache::shared()
+{
+	static ThumbnailCache cache;
+	return cache;
+}
+
+ImageStore::Handle ThumbnailCache::find(const std::string &path, const sf::Vector2u &size)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto found = m_index.find(path + "@" + std::to_string(size.x) + "x" + std::to_string(size.y));
+	if(found == m_index.end())
+	{
+		return nullptr;
+	}
+	m_entries.splice(m_entries.begin(), m_entries, found->second);
+	return found->second->second;
+}
+
+ImageStore::Handle ThumbnailCache::insert(const std::string &path, const sf::Vector2u &size, ImageStore::Handle thumbnail)
+{
+	const std::string key = path + "@" + std::to_string(size.x) + "x" + std::to_string(size.y);
+	thumbnail->memory = MemoryCharge(MemorySubsystem::GUI);
+	thumbnail->memory.setCpu(MemoryCharge::bytesOf(thumbnail->pixels.getSize()));
+	thumbnail->memory.setGpu(MemoryCharge::bytesOf(thumbnail->texture.getSize()));
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	auto found = m_index.find(key);
+	if(found != m_index.end())
+	{
+		m_usage -= found->second->second->memory.getGpu();
+		m_entries.erase(found->second);
+		m_index.erase(found);
+	}
+	m_entries.emplace_front(key, thumbnail);
+	m_index[key] = m_entries.begin();
+	m_usage += thumbnail->memory.getGpu();
+
+	//buttons still showing a dropped thumbnail keep it until they show another one
+	while(m_usage > m_capacity && m_entries.size() > 1u)
+	{
+		m_usage -= m_entries.back().second->memory.getGpu();
+		m_index.erase(m_entries.back().first);
+		m_entries.pop_back();
+	}
+	return thumbnail;
+}
+
+std::size_t ThumbnailCache::getUsage()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_usage;
+}
+
+ThumbnailLoader::ThumbnailLoader(ThumbnailCache &cache)
+:
+m_cache(cache),
+m_path(),
+m_size(),
+m_ready(nullptr),
+m_work(),
+m_abandoned()
+{ }
+
+void ThumbnailLoader::request(const std::string &path, const sf::Vector2u &size)
+{
+	if(m_work.shrinking.valid())
+	{
+		m_abandoned.push_back(std::move(m_work));
+	}
+	m_work = Work();
+	m_path = path;
+	m_size = size;
+
+	m_ready = m_cache.find(path, size);
+	if(m_ready)
+	{
+		return;
+	}
+	//the source is released by the window thread, which owns its texture
+	m_work.source = ImageStore::shared().find(path);
+	const sf::Image *source = m_work.source ? &m_work.source->pixels : nullptr;
+	m_work.shrinking = std::async(std::launch::async, [path, size, source]()
+	{
+		if(source)
+		{
+			return shrink(*source, size);
+		}
+		//resources are decoded from the executable, only other paths touch the filesystem
+		sf::Image image;
+		const Resource *resource = Resources::findPath(path);
+		const bool decoded = Resources::isResourcePath(path)
+			? resource && image.loadFromMemory(resource->data, resource->size)
+			: image.loadFromFile(path);
+		return decoded ? shrink(image, size) : sf::Image();
+	});
+}
+
+bool ThumbnailLoader::isPending() const
+{
+	return m_ready || m_work.shrinking.valid();
+}
+
+ImageStore::Handle ThumbnailLoader::update()
+{
+	this->dropAbandoned();
+	if(m_ready)
+	{
+		return std::move(m_ready);
+	}
+	if(!m_work.shrinking.valid() || m_work.shrinking.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+	{
+		return nullptr;
+	}
+
+	const sf::Image shrunk = m_work.shrinking.get();
+	m_work = Work();
+	//only the texture is kept, the buttons never read the pixels of a thumbnail
+	auto thumbnail = std::make_shared<StoredImage>();
+	if(shrunk.getSize().x == 0u || shrunk.getSize().y == 0u || !thumbnail->texture.loadFromImage(shrunk))
+	{
+		return std::make_shared<const StoredImage>();
+	}
+	return m_cache.insert(m_path, m_size, std::move(thumbnail));
+}
+
+//private member functions
+void ThumbnailLoader::dropAbandoned()
+{
+	m_abandoned.erase(std::remove_if(m_abandoned.begin(), m_abandoned.end(), [](const Work &work)
+	{
+		return work.shrinking.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	}), m_abandoned.end());
+}
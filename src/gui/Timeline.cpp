@@ -8,10 +8,8 @@ m_box(),
 m_covered(),
 m_timelineLength(0.f),
 m_cursorSpeed(0.f),
-m_playStatus(false),
-m_totalTime(0.f),
-m_currentTime(0.f),
-m_frameCount(0u)
+m_playback(),
+m_scrubIdle(0.f)
 {
     m_shape.setOutlineThickness(1);
     m_shape.setOutlineColor(sf::Color::White);
@@ -21,9 +19,8 @@ Timeline::Timeline(sf::Vector2f pos, sf::Vector2f size, const float totalTime, c
 :
 Button(pos,size),
 m_timelineLength(size.x - size.y*2.f - 2.f),
-m_playStatus(false),
-m_totalTime(totalTime),
-m_currentTime(0.f)
+m_playback(totalTime, static_cast<unsigned>(frames * totalTime)),
+m_scrubIdle(0.f)
 {
     m_cursor = sf::CircleShape(size.y + 1.f);
     m_cursor.setFillColor(sf::Color::White);
@@ -38,25 +35,21 @@ m_currentTime(0.f)
     m_covered.setPosition(pos);
     m_covered.setFillColor(sf::Color(60,220,60));
     m_covered.setSize(sf::Vector2f(m_cursor.getPosition().x - m_covered.getPosition().x, size.y));
-
-    m_playStatus = false;
-    m_frameCount = frames* m_totalTime;
-    m_deltaFrame = m_totalTime/static_cast<float>(m_frameCount);
 }
 
 const bool Timeline::getPlayStatus() const
 {
-    return m_playStatus;
+    return m_playback.isPlaying();
 }
 
 void Timeline::play()
 {
-    m_playStatus = true;
+    m_playback.play();
 }
 
 void Timeline::pause()
 {
-    m_playStatus = false;
+    m_playback.pause();
 }
 
 void Timeline::setCursorPosition(float localX)
@@ -75,42 +68,33 @@ void Timeline::setCursorPosition(float localX)
 
 void Timeline::setPlayStatusON_OFF(const bool on)
 {
-    m_playStatus = on;
+    m_playback.setPlaying(on);
 }
 
 const bool Timeline::isFinished() const
 {
-    if ( m_currentTime >= m_totalTime - 0.0002f) //-0.0002f is a correction because of IEEE754
-    {
-        return true;
-    }
-    else
-    {
-        return false;   
-    }
+    return m_playback.isFinished();
 }
 
 void Timeline::setTotalTime(const float totalTime)
 {
-    if (totalTime > 0.f)
-    {
-        m_totalTime = totalTime;
-        m_deltaFrame = m_totalTime/static_cast<float>(m_frameCount);
-    }
+    m_playback.setLength(totalTime);
 } 
 
 void Timeline::setFrames(const unsigned short frames)
 {
-    m_frameCount = frames;
-    m_deltaFrame = m_totalTime/static_cast<float>(m_frameCount - 1);
+    m_playback.setFrames(frames);
 }
 
 void Timeline::setCurrentTime(const float currentTime)
 {
-    if(currentTime >= 0.f && currentTime < m_totalTime)
-    {
-        m_currentTime = currentTime;
-    }
+    m_playback.setTime(currentTime);
+}
+
+void Timeline::seekFrame(const unsigned frame)
+{
+    m_playback.seekFrame(frame);
+    this->setCursorPosition(m_playback.getProgress() * m_timelineLength);
 }
 
 const float Timeline::getCursorProgress() const
@@ -120,62 +104,62 @@ const float Timeline::getCursorProgress() const
 
 const float Timeline::getTotalTime() const
 {
-    return m_totalTime;
+    return m_playback.getLength();
 }
 
 const float Timeline::getCurrentTime() const
 {
-    return m_currentTime;
+    return m_playback.getTime();
+}
+
+const float Timeline::getDeltaFrame() const
+{
+    return m_playback.getGrid().getDelta();
 }
 
 const unsigned Timeline::getFrames() const
 {
-    return m_frameCount;
+    return m_playback.getGrid().getFrames();
 }
 
-void Timeline::skipNextFrame()
+const unsigned Timeline::getCurrentFrame() const
 {
-    float toJump = 0.f;
-    while( toJump <= m_currentTime )
-    {
-        toJump += m_deltaFrame;
-    }
-    toJump >= m_totalTime ? toJump = m_totalTime - 0.0001 : 1 ;
+    return m_playback.getFrame();
+}
 
-    this->setCurrentTime( toJump );
-    this->setCursorPosition(m_currentTime/m_totalTime * (m_timelineLength));
+const FrameGrid &Timeline::getFrameGrid() const
+{
+    return m_playback.getGrid();
 }
 
+PlaybackClock &Timeline::getClock()
+{
+    return m_playback.getClock();
+}
 
-void Timeline::skipPrevFrame()
+const PlaybackCursor &Timeline::getPlayback() const
 {
-    float toJump = m_totalTime;
-    while( toJump >= m_currentTime )
-    {
-        toJump -= m_deltaFrame;
-    }
-    toJump <= 0.f ? toJump = 0.f : 1 ;
+    return m_playback;
+}
 
-    this->setCurrentTime( toJump );
-    this->setCursorPosition(m_currentTime/m_totalTime * (m_timelineLength));
+void Timeline::skipNextFrame()
+{
+    m_playback.nextFrame();
+    this->setCursorPosition(m_playback.getProgress() * m_timelineLength);
+}
+
+
+void Timeline::skipPrevFrame()
+{
+    m_playback.previousFrame();
+    this->setCursorPosition(m_playback.getProgress() * m_timelineLength);
 }
 
 void Timeline::update(sf::Vector2i mousePos, sf::Event &event, const float &deltaTime)
 {   
-    if(this->isFinished())
-    {
-        this->pause();
-    }
-    else if(m_playStatus && !this->isFinished()) //animation is being played
-    {
-        m_currentTime += deltaTime;
-        if(m_currentTime > m_totalTime)
-        {
-            m_currentTime = m_totalTime - 0.0001f;
-        }
-    }
+    m_playback.advance(deltaTime);//pauses a finished animation
     //adjust cursor's position
-    this->setCursorPosition(m_currentTime/m_totalTime * (m_timelineLength));
+    this->setCursorPosition(m_playback.getProgress() * m_timelineLength);
     //color the path behind the cursor
     m_covered.setSize(sf::Vector2f(m_cursor.getPosition().x - m_covered.getPosition().x, this->getSize().y));
 
@@ -185,6 +169,7 @@ void Timeline::update(sf::Vector2i mousePos, sf::Event &event, const float &delt
         && (event.mouseButton.button == sf::Mouse::Left))
         {
             m_state = Button::state::ACTIVE;
+            m_scrubIdle = 0.f;
             this->pause();
         }
     }
@@ -196,14 +181,22 @@ void Timeline::update(sf::Vector2i mousePos, sf::Event &event, const float &delt
         {
             m_state = Button::state::IDLE;
         }
+        const float dragged_from = m_playback.getTime();
         this->setCursorPosition(mousePos.x - m_box.getPosition().x);
-        this->setCurrentTime((m_cursor.getPosition() - this->getPosition()).x / m_timelineLength * m_totalTime);
+        this->setCurrentTime((m_cursor.getPosition() - this->getPosition()).x / m_timelineLength * m_playback.getLength());
+        //the views show quick frames while the cursor moves and full ones once it rests or is released
+        m_scrubIdle = m_playback.getTime() != dragged_from ? 0.f : m_scrubIdle + deltaTime;
+        m_playback.setScrubbing(m_state == Button::state::ACTIVE && m_scrubIdle < Timeline::SCRUB_IDLE);
+    }
+    else
+    {
+        m_playback.setScrubbing(false);
     }
 }
 
-void Timeline::render(sf::RenderTarget *target) 
+void Timeline::batch(GuiBatch &target) const
 {
-    target->draw(this->m_box);
-    target->draw(this->m_covered);
-    target->draw(this->m_cursor);
+    target.add(this->m_box);
+    target.add(this->m_covered);
+    target.add(this->m_cursor);
 }
@@ -1,39 +1,124 @@
 #include "../../include/program/Program.h"
+#include "../../dep/tinyfiledialogs/tinyfiledialogs.h"
 
-bool Program::requestedUpdate = false;
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
 
-Program::Program()
+namespace
 {
-    std::string title = "BCG - SlidesAnimations";
-    sf::VideoMode window_bounds(1280, 720);
-    window_bounds.bitsPerPixel = sf::VideoMode::getDesktopMode().bitsPerPixel;
-    unsigned fps_limit = 60;
-    bool vertical_sync_enabled = 0;
-
-    m_window = new sf::RenderWindow(window_bounds, title, sf::Style::Close | sf::Style::Titlebar);
-    m_window->setFramerateLimit(fps_limit);
-    m_window->setVerticalSyncEnabled(vertical_sync_enabled);
-    m_window->setKeyRepeatEnabled(false);
+    const sf::Vector2f GUI_SIZE(1280.f, 720.f);//the panels are laid out for this size and scaled to the window
+    const float DESKTOP_SHARE = 0.9f;//part of the desktop the window takes at most when it opens
+    const char *TITLE = "BCG - SlidesAnimations";
+    const sf::Time EXPORT_POLL_INTERVAL = sf::milliseconds(10);//sleep between polls of events while an export runs, nothing is rendered meanwhile
+
+    /**
+     * Reads the render size fixed by BCG_RENDER_SIZE as <W>x<H>, zero to follow the window
+     */
+    sf::Vector2u fixedRenderSize()
+    {
+        unsigned width = 0u, height = 0u;
+        const char *env = std::getenv("BCG_RENDER_SIZE");
+        if(!env || std::sscanf(env, "%ux%u", &width, &height) != 2 || width == 0u || height == 0u)
+        {
+            return sf::Vector2u();
+        }
+        return sf::Vector2u(width, height);
+    }
+
+    double secondsOf(const sf::Clock &clock)
+    {
+        return static_cast<double>(clock.getElapsedTime().asMicroseconds()) / 1e6;
+    }
+}//anonymous namespace
+
+std::atomic<bool> Program::requestedUpdate(false);
+
+Program::Program(SlideDeck deck, std::shared_ptr<const RawSequence> sequence, Project project)
+:
+m_deltaTime(0.f),
+m_redrawRequested(true),
+m_deck(std::move(deck)),
+m_project(std::move(project)),
+m_profilerOverlay(sf::Vector2f(20.f, 20.f)),
+m_fullscreen(false),
+m_windowedSize(),
+m_renderSize(fixedRenderSize()),
+m_presenting(false),
+m_deckWaiting(false),
+m_pacer(),
+m_presentClock(),
+m_animation(0u),
+m_sequence(sequence),
+m_exportedFrames(0u),
+m_exportFrames(0u),
+m_titleFrames(0u),
+m_export()
+{
+    //high density screens get the layout at a whole multiple of its size instead of a tiny window
+    const sf::VideoMode desktop = sf::VideoMode::getDesktopMode();
+    const float scale = std::max(1.f, std::floor(std::min(
+        desktop.width * DESKTOP_SHARE / GUI_SIZE.x, desktop.height * DESKTOP_SHARE / GUI_SIZE.y)));
+    m_windowedSize = sf::Vector2u(GUI_SIZE * scale);
+
+    m_window = new sf::RenderWindow();
+    this->createWindow();
     
     m_timePanel = new PanelTimeline(sf::Vector2f(10.f, 10.f), sf::Vector2f(960.f, 700.f) );
     m_buttonPanel = new PanelButton(sf::Vector2f(980.f, 10.f), sf::Vector2f(290.f, 700.f));
 
-    m_timePanel->getCanvas()->setStartingImage("../res/images/example1.jpg");
-    m_timePanel->getCanvas()->setEndingImage("../res/images/example2.jpg");
-    m_timePanel->getCanvas()->setAnimation(std::make_unique<DimmingAnimation>());
-    m_timePanel->getTimeline()->setTotalTime(1.f);
+    if(m_deck.getTransitionCount() == 0u)
+    {
+        m_deck.clear();
+        m_deck.addSlide(Resources::pathOf("images/example1.jpg"));
+        m_deck.addSlide(Resources::pathOf("images/example2.jpg"));
+    }
     m_timePanel->getTimeline()->setFrames(15);
-    m_timePanel->getCanvas()->setTotalAnimationTime( m_timePanel->getTimeline()->getTotalTime() );
+    this->updateLayout();
+    this->showTransition(0u);
+    if(sequence)
+    {
+        //the timeline steps through the frames of the sequence at the rate it was exported with
+        const std::size_t frames = sequence->getFrameCount();
+        if(frames > 1u && sequence->getFps() > 0.f)
+        {
+            m_timePanel->getTimeline()->setTotalTime(static_cast<float>(frames - 1u) / sequence->getFps());
+        }
+        m_timePanel->getTimeline()->setFrames(static_cast<unsigned short>(std::min<std::size_t>(frames, 0xFFFFu)));
+        const float length = m_timePanel->getTimeline()->getTotalTime();
+        m_timePanel->modifyCanvas([&sequence, length](Canvas &canvas)
+        {
+            canvas.setTotalAnimationTime(length);
+            canvas.setSequence(std::move(sequence));
+        });
+    }
 
     Settings* sets = Settings::getInstance();
-    sets->setPath1("../res/images/example1.jpg");
-    sets->setPath2("../res/images/example2.jpg");
+    sets->setPath1(m_deck.getPath(0u));
+    sets->setPath2(m_deck.getPath(1u));
     sets->setCurrentAnim(1u);
     sets->setCurrentFrames(1);
+    sets->setExportFormat(1);
+    if(!m_project.getPresets().empty())
+    {
+        const Project::ExportPreset &preset = m_project.getPresets().front();
+        sets->setExportFormat(preset.format);
+        m_timePanel->getTimeline()->setFrames(preset.frames);
+    }
 }
 
 Program::~Program()
 {
+    if(m_export.valid())
+    {
+        m_export.wait();//the export reports its progress into the members
+    }
+    if(m_presenting)
+    {
+        this->reportPresentation();
+    }
     delete m_window;
     delete m_timePanel;
     delete m_buttonPanel;
@@ -46,49 +131,21 @@ void Program::endApp()
 
 void Program::setAnimationFromSettings(Settings* settings)
 {
-    switch( settings->getCurrentAnim() )
+    //settings count animations from 1 in order of the registry
+    const std::size_t index = static_cast<std::size_t>(settings->getCurrentAnim()) - 1u;
+    const float total_time = m_timePanel->getTimeline()->getTotalTime();
+    m_timePanel->modifyCanvas([index, total_time](Canvas &canvas)
     {
-        case(1u):
-        {
-            m_timePanel->getCanvas()->setAnimation( std::make_unique<DimmingAnimation>() );
-            break;
-        }
-        case(2u):
-        {
-            m_timePanel->getCanvas()->setAnimation( std::make_unique<AlfaAnimation>() );
-            break;
-        }
-        case(3u):
+        if(index < animationCount())
         {
-            m_timePanel->getCanvas()->setAnimation( std::make_unique<ByBrightnessAnimation>() );
-            break;
-        }
-        case(4u):
-        {
-            m_timePanel->getCanvas()->setAnimation( std::make_unique<SlideAnimation>() );
-            break;
-        }
-        case(5u):
-        {
-            m_timePanel->getCanvas()->setAnimation( std::make_unique<ScaleAnimation>() );
-            break;
-        }
-        case(6u):
-        {
-            m_timePanel->getCanvas()->setAnimation( std::make_unique<RingAnimation>() );
-            break;
-        }
-        case(7u):
-        {
-            m_timePanel->getCanvas()->setAnimation( std::make_unique<FlyAnimation>() );
-            break;
-        }
-        default:
-        {
-            break;
+            canvas.setAnimation( createAnimation(index) );
         }
+        canvas.setTotalAnimationTime(total_time);
+    });
+    if(index < animationCount())
+    {
+        m_animation = index;
     }
-    m_timePanel->getCanvas()->setTotalAnimationTime( m_timePanel->getTimeline()->getTotalTime() );
     m_buttonPanel->getAnimationChoice()->changeRead();
 }
 
@@ -151,7 +208,11 @@ void Program::setFramesFromSettings(Settings* settings)
         }
 
     }
-    m_timePanel->getCanvas()->setTotalAnimationTime( m_timePanel->getTimeline()->getTotalTime() );
+    const float total_time = m_timePanel->getTimeline()->getTotalTime();
+    m_timePanel->modifyCanvas([total_time](Canvas &canvas)
+    {
+        canvas.setTotalAnimationTime(total_time);
+    });
     m_buttonPanel->getFramesChoice()->changeRead();
 }
 
@@ -162,83 +223,266 @@ void Program::requestUpdate()
     requestedUpdate = true;
 }
 
-void Program::expireRequestUpdate()
-{
-    requestedUpdate = false;
-}
-
 void Program::updateDeltaTime()
 {
     /*Updates the deltaTime variable with the time it takes to update and render one frame*/
    m_deltaTime = m_dtClock.restart().asSeconds();
+    if(m_presenting)
+    {
+        m_deltaTime = m_pacer.beginFrame(secondsOf(m_presentClock));
+    }
 }
 
-void Program::saveSequence(sf::Vector2i mousePos, sf::Event &event)
+std::unique_ptr<FrameSink> Program::makeExportSink(const std::string &name, const float &fps)
 {
-    m_timePanel->getTimeline()->setCurrentTime(0.f);
-
-    std::string name;
-    time_t now = time(0);
-    char* date = ctime(&now);
-    std::string dir(date);
-    std::replace( dir.begin(), dir.end(), ' ', '_');
-    std::replace( dir.begin(), dir.end(), ':', '-');
-    dir.pop_back();
-    std::filesystem::create_directory(dir);
-
-    int amount = static_cast<int> (m_timePanel->getTimeline()->getFrames());
-    for (int i = 1; i <= amount; ++i)
+    switch( Settings::getInstance()->getExportFormat() )
     {
-        name = "";  
-        if(i>99)
+        case(2u):
         {
-            name += std::to_string(i); 
+            return std::make_unique<GifSink>(name + ".gif", fps);
         }
-        else if(i>9)
+        case(3u):
         {
-            name += "0" + std::to_string(i);
+            if(!FfmpegSink::isAvailable())
+            {
+                throw std::runtime_error("Program::makeExportSink(): ffmpeg was not found in PATH");
+            }
+            return std::make_unique<FfmpegSink>(name + ".mp4", fps);
         }
-        else
+        case(4u):
+        {
+            return std::make_unique<RawSequenceSink>(name + RawSequence::EXTENSION, fps);
+        }
+        case(5u):
         {
-            name += "00" + std::to_string(i);
+            return std::make_unique<ImageSequenceSink>(name, "png");
         }
+        case(6u):
+        {
+            return std::make_unique<ImageSequenceSink>(name, "qoi");
+        }
+        default:
+        {
+            return std::make_unique<ImageSequenceSink>(name, "bmp");
+        }
+    }
+}
 
-        m_timePanel->update(mousePos,event,m_deltaTime);
-        m_timePanel->getCanvas()->render(m_window);
-        m_timePanel->getCanvas()->getPlane().getTexture().copyToImage().saveToFile(dir+"/"+name+".bmp");
-        m_timePanel->getTimeline()->skipNextFrame();
+void Program::updateDeck(const bool wasPlaying)
+{
+    //the timeline stops the control at its end, the deck continues with the next transition
+    const std::size_t next = m_deck.getCurrent() + 1u;
+    const bool ended = !m_timePanel->getControl()->isPlay() && m_timePanel->isFinished() && next < m_deck.getTransitionCount();
+    if(wasPlaying && ended)
+    {
+        m_deckWaiting = true;
+    }
+    else if(!ended)//played again or moved on the timeline
+    {
+        m_deckWaiting = false;
     }
 
+    //a presentation holds the last frame rather than stalling the display until the slides are decoded
+    if(m_deckWaiting && (!m_presenting || m_deck.isReady(next)))
+    {
+        m_deckWaiting = false;
+        this->showTransition(next);
+        m_timePanel->getControl()->play();
+        Program::requestUpdate();
+    }
+
+    if(m_deck.isPrefetching())
+    {
+        m_timePanel->modifyCanvas([this](Canvas &canvas) { m_deck.update(canvas); });
+        Program::requestUpdate();
+    }
+}
+
+void Program::showTransition(const std::size_t transition)
+{
+    m_timePanel->modifyCanvas([this, transition](Canvas &canvas) { m_deck.show(canvas, transition); });
+    m_animation = m_deck.getTransition(transition).animation;
+    m_timePanel->getTimeline()->setTotalTime(m_deck.getTransition(transition).length);
     m_timePanel->getTimeline()->setCurrentTime(0.f);
-    m_timePanel->update(mousePos, event, m_deltaTime);
-    m_timePanel->render(m_window);
-    tinyfd_messageBox("Message", "The animation has been saved!", "ok", "info", 1);
+
+    Settings* sets = Settings::getInstance();
+    sets->setPath1(m_deck.getPath(transition));
+    sets->setPath2(m_deck.getPath(transition + 1u));
+
+    //thumbnails of a project are decoded when first shown, the others are made in the background
+    //outside of presentations, whose frames the workers are kept for
+    if(!m_presenting)
+    {
+        const bool stored = transition + 1u < m_project.getSlideCount();
+        m_buttonPanel->getImageUp()->setPreview(m_deck.getPath(transition), stored ? m_project.getThumbnail(transition) : nullptr);
+        m_buttonPanel->getImageDown()->setPreview(m_deck.getPath(transition + 1u), stored ? m_project.getThumbnail(transition + 1u) : nullptr);
+    }
+}
+
+void Program::saveSequence()
+{
+    if(m_export.valid())
+    {
+        return;//one export runs at a time
+    }
+
+    time_t now = time(0);
+    char* date = ctime(&now);
+    std::string name(date);
+    std::replace( name.begin(), name.end(), ' ', '_');
+    std::replace( name.begin(), name.end(), ':', '-');
+    name.pop_back();
+
+    //the shown state is copied, so the animation can be changed while it is exported
+    Settings* sets = Settings::getInstance();
+    Timeline *timeline = m_timePanel->getTimeline();
+    ExportJob job;
+    job.start = sets->getPath1();
+    job.end = sets->getPath2();
+    job.animation = m_animation;
+    job.frames = timeline->getFrames();
+    job.length = timeline->getTotalTime();
+    job.sequence = m_sequence;
+    sf::Vector2u size;
+    bool premultiplied = false;
+    m_timePanel->modifyCanvas([&job, &size, &premultiplied](Canvas &canvas)
+    {
+        job.subframes = canvas.getMotionBlur();
+        size = canvas.getRenderSize();
+        premultiplied = canvas.isPremultipliedAlpha();
+    });
+
+    //the sink is made here, the format may be changed while it is written
+    auto sink = std::make_shared<std::unique_ptr<FrameSink>>();
+    try
+    {
+        *sink = this->makeExportSink(name, 1.f / timeline->getDeltaFrame());
+    }
+    catch(const std::exception &error)
+    {
+        std::cerr << error.what() << std::endl;
+        tinyfd_messageBox("Error", "The animation could not be saved!", "ok", "error", 1);
+        return;
+    }
+    job.sink = [sink]() { return std::move(*sink); };
+
+    //the export renders on its own canvas, so the window and its canvas keep running
+    auto scheduler = std::make_shared<ExportScheduler>(size);
+    scheduler->setWorkerCount(1u);
+    scheduler->setPremultipliedAlpha(premultiplied);
+    //exporting the same animation again replays it from the cache instead of rendering it
+    scheduler->setCache(&SequenceCache::shared());
+    scheduler->addJob(std::move(job));
+
+    m_exportedFrames = 0u;
+    m_exportFrames = timeline->getFrames();
+    m_titleFrames = std::numeric_limits<std::size_t>::max();
+    m_export = std::async(std::launch::async, [this, scheduler]()
+    {
+        //every rendered frame and the end of the export update the window once
+        scheduler->run([this](const ExportProgress &progress)
+        {
+            m_exportedFrames = progress.renderedFrames;
+            Program::requestUpdate();
+        });
+    });
+    Program::requestUpdate();
+}
+
+void Program::updateExport()
+{
+    if(!m_export.valid())
+    {
+        return;
+    }
+    if(m_export.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        const std::size_t exported = m_exportedFrames;
+        if(exported != m_titleFrames)
+        {
+            m_titleFrames = exported;
+            m_window->setTitle(std::string(TITLE) + " - saving frame " + std::to_string(exported) + " of " + std::to_string(m_exportFrames));
+        }
+        return;
+    }
+
+    bool saved = true;
+    try
+    {
+        m_export.get();
+    }
+    catch(const std::exception &error)
+    {
+        std::cerr << error.what() << std::endl;
+        saved = false;
+    }
+    m_window->setTitle(TITLE);
+    if(saved)
+    {
+        tinyfd_messageBox("Message", "The animation has been saved!", "ok", "info", 1);
+    }
+    else
+    {
+        tinyfd_messageBox("Error", "The animation could not be saved!", "ok", "error", 1);
+    }
 }
 
 
 void Program::updateSFMLEvents()
 {
-    this->updateDeltaTime();
-    if(m_window->pollEvent(m_event))
+    bool has_event = m_window->pollEvent(m_event);
+    if(!has_event && !requestedUpdate)
     {
-        switch(m_event.type)
+        //the frame cache is filled by the render thread of the canvas, this one sleeps until an event comes
+        if(m_export.valid())
         {
-            case sf::Event::Closed:
-            {
-                m_window->close();
-                break;
-            }
-            default: 
+            //the export requests updates from its thread, which cannot wake waitEvent, so events are polled in slices
+            while(!requestedUpdate && !(has_event = m_window->pollEvent(m_event)))
             {
-                this->update(sf::Mouse::getPosition(*m_window), m_event);
-                break;
+                sf::sleep(EXPORT_POLL_INTERVAL);
             }
-        }//switch
+        }
+        else
+        {
+            has_event = m_window->waitEvent(m_event);
+        }
+        m_dtClock.restart();//time spent sleeping does not advance the animation
+        m_pacer.reset();
     }
-    else if(requestedUpdate)
+    BCG_PROFILE_SCOPE("Program::updateSFMLEvents");
+
+    this->updateDeltaTime();
+    requestedUpdate = false;//updates which need another one request it again
+    m_redrawRequested = true;
+    if(!has_event)
     {
         m_event = sf::Event();
-        this->update(sf::Mouse::getPosition(*m_window), m_event);
+        this->update(this->getMousePosition(), m_event);
+        return;
+    }
+
+    //all pending events are handled before the next render, the frame delta is applied only once
+    bool layout_outdated = false;
+    do
+    {
+        if(m_event.type == sf::Event::Closed)
+        {
+            m_window->close();
+            return;
+        }
+        layout_outdated = this->updateWindowEvents(m_event) || layout_outdated;
+        layout_outdated = this->updatePresentationKeys(m_event) || layout_outdated;
+        this->updateProfilerKeys(m_event);
+        this->updateProjectKeys(m_event);
+        this->update(this->getMousePosition(), m_event);
+        m_deltaTime = 0.f;
+    }
+    while(m_window->pollEvent(m_event));
+
+    //a drag of the window border sends many sizes, only the last one is laid out
+    if(layout_outdated)
+    {
+        this->updateLayout();
     }
 }
 
@@ -248,8 +492,10 @@ void Program::update(sf::Vector2i mousePos, sf::Event &event)
 
     if(m_window->isOpen())
     {
+        const bool was_playing = m_timePanel->getControl()->isPlay();
         m_timePanel->update(mousePos, event, m_deltaTime );
         m_buttonPanel->update(mousePos, event);
+        this->updateDeck(was_playing);
     }
     else//Applications end
     {
@@ -260,8 +506,8 @@ void Program::update(sf::Vector2i mousePos, sf::Event &event)
     {
         sets->setPath1( m_buttonPanel->getImageUp()->getPath() );
         //std::cout << sets->getPath1() <<std::endl;
-        m_timePanel->getCanvas()->setStartingImage( sets->getPath1() );
-        this->setAnimationFromSettings(sets);
+        const std::string path = sets->getPath1();
+        m_timePanel->modifyCanvas([&path](Canvas &canvas) { canvas.setStartingImage(path); });
         m_buttonPanel->getImageUp()->changeRead();
     }
 
@@ -269,8 +515,8 @@ void Program::update(sf::Vector2i mousePos, sf::Event &event)
     {
         sets->setPath2( m_buttonPanel->getImageDown()->getPath() );
         //std::cout << sets->getPath2() <<std::endl;
-        m_timePanel->getCanvas()->setEndingImage( sets->getPath2() );
-        this->setAnimationFromSettings(sets);
+        const std::string path = sets->getPath2();
+        m_timePanel->modifyCanvas([&path](Canvas &canvas) { canvas.setEndingImage(path); });
         m_buttonPanel->getImageDown()->changeRead();
     }
 
@@ -286,20 +532,253 @@ void Program::update(sf::Vector2i mousePos, sf::Event &event)
         this->setFramesFromSettings(sets);
     }
 
+    if ( m_buttonPanel->getFormatChoice()->isChanged() )
+    {
+        sets->setExportFormat( m_buttonPanel->getFormatChoice()->getCurrentChoice() );
+        m_buttonPanel->getFormatChoice()->changeRead();
+    }
+
     if (m_buttonPanel->getSaveButton()->isPressed() )
     {
-        this->saveSequence(mousePos, event);
+        this->saveSequence();
     }
+    this->updateExport();
+}
+
+void Program::updateProfilerKeys(const sf::Event &event)
+{
+    if(event.type != sf::Event::KeyPressed)
+    {
+        return;
+    }
+    if(event.key.code == sf::Keyboard::F3)
+    {
+        m_profilerOverlay.setVisible(!m_profilerOverlay.isVisible());
+    }
+    else if(event.key.code == sf::Keyboard::F4)
+    {
+        const std::string path = "trace_" + std::to_string(time(0)) + ".json";
+        try
+        {
+            Profiler::shared().writeTrace(path);
+            std::cout << "Trace written to " << path << std::endl;
+        }
+        catch(const std::exception &error)
+        {
+            std::cerr << error.what() << std::endl;
+        }
+    }
+}
+
+void Program::updateProjectKeys(const sf::Event &event)
+{
+    if(event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::S && event.key.control)
+    {
+        this->saveProject();
+    }
+}
+
+void Program::saveProject()
+{
+    //the image buttons may have replaced the slides of the current transition
+    Settings* sets = Settings::getInstance();
+    const std::size_t current = m_deck.getCurrent();
+    SlideDeck deck;
+    for(std::size_t slide = 0; slide < m_deck.getSlideCount(); slide++)
+    {
+        const std::string path = slide == current ? sets->getPath1() : slide == current + 1u ? sets->getPath2() : m_deck.getPath(slide);
+        deck.addSlide(path, slide > 0u ? m_deck.getTransition(slide - 1u) : SlideTransition());
+    }
+    m_project.setDeck(deck);
+
+    Project::ExportPreset preset;
+    preset.format = sets->getExportFormat();
+    preset.frames = static_cast<unsigned short>(m_timePanel->getTimeline()->getFrames());
+    m_project.setPreset(preset);
+
+    std::string path = m_project.getPath();
+    if(path.empty())
+    {
+        char const *patterns[1] = { "*.bcgproj" };
+        const char *chosen = tinyfd_saveFileDialog("Save project", "project.bcgproj", 1, patterns, "BCG projects");
+        if(!chosen)
+        {
+            return;
+        }
+        path = chosen;
+    }
+    try
+    {
+        m_project.save(path);
+        std::cout << "Project saved to " << path << std::endl;
+    }
+    catch(const std::exception &error)
+    {
+        std::cerr << error.what() << std::endl;
+        tinyfd_messageBox("Error", "The project could not be saved!", "ok", "error", 1);
+    }
+}
+
+bool Program::updateWindowEvents(const sf::Event &event)
+{
+    if(event.type == sf::Event::Resized)
+    {
+        return true;
+    }
+    if(event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F11)
+    {
+        m_fullscreen = !m_fullscreen;
+        this->createWindow();
+        return true;
+    }
+    return false;
+}
+
+bool Program::updatePresentationKeys(const sf::Event &event)
+{
+    if(event.type != sf::Event::KeyPressed)
+    {
+        return false;
+    }
+    if(event.key.code == sf::Keyboard::F5 || (m_presenting && event.key.code == sf::Keyboard::Escape))
+    {
+        this->setPresenting(!m_presenting);
+        return true;
+    }
+    return false;
+}
+
+void Program::setPresenting(const bool presenting)
+{
+    if(presenting == m_presenting)
+    {
+        return;
+    }
+    if(!presenting)
+    {
+        this->reportPresentation();
+    }
+    m_presenting = presenting;
+    this->createWindow();
+    m_pacer.reset();
+    m_pacer.clearStatistics();
+    if(presenting)
+    {
+        m_deckWaiting = false;
+        this->showTransition(0u);
+        m_timePanel->getControl()->play();
+        Program::requestUpdate();
+    }
+}
+
+void Program::reportPresentation() const
+{
+    const FramePacer::Statistics statistics = m_pacer.getStatistics();
+    if(statistics.frames == 0u)
+    {
+        return;
+    }
+    //formatted apart, the precision is not left on std::cout
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(2) << "Presentation: " << statistics.frames << " frames, "
+        << statistics.dropped << " dropped (" << 100.0 * statistics.dropped / (statistics.frames + statistics.dropped)
+        << " %), refresh " << statistics.refreshInterval * 1e3f << " ms, mean " << statistics.meanInterval * 1e3f
+        << " ms, worst " << statistics.worstInterval * 1e3f << " ms";
+    std::cout << report.str() << std::endl;
+}
+
+void Program::createWindow()
+{
+    //leaving fullscreen restores the size the window was left at
+    sf::VideoMode mode(m_windowedSize.x, m_windowedSize.y, sf::VideoMode::getDesktopMode().bitsPerPixel);
+    sf::Uint32 style = sf::Style::Default;
+    if(m_fullscreen || m_presenting)
+    {
+        mode = sf::VideoMode::getDesktopMode();
+        style = sf::Style::Fullscreen;
+    }
+    m_window->create(mode, TITLE, style);
+    //presentations wait for the refreshes of the display, the editor sleeps between frames
+    m_window->setFramerateLimit(m_presenting ? 0u : 60u);
+    m_window->setVerticalSyncEnabled(m_presenting);
+    m_window->setMouseCursorVisible(!m_presenting);
+    m_window->setKeyRepeatEnabled(false);
+}
+
+void Program::updateLayout()
+{
+    //the layout keeps its aspect ratio, the rest of the window is left black
+    const sf::Vector2f window(m_window->getSize());
+    if(window.x <= 0.f || window.y <= 0.f)
+    {
+        return;
+    }
+    if(!m_fullscreen && !m_presenting)
+    {
+        m_windowedSize = m_window->getSize();
+    }
+    //a presentation shows the area of the canvas only
+    sf::FloatRect area(sf::Vector2f(), GUI_SIZE);
+    if(m_presenting)
+    {
+        area = sf::FloatRect(m_timePanel->getCanvas()->getPosition(), m_timePanel->getCanvas()->getSize());
+    }
+    const float scale = std::min(window.x / area.width, window.y / area.height);
+    const sf::Vector2f shown = sf::Vector2f(area.width, area.height) * scale;
+    sf::View view(area);
+    view.setViewport(sf::FloatRect((window.x - shown.x) / 2.f / window.x, (window.y - shown.y) / 2.f / window.y,
+        shown.x / window.x, shown.y / window.y));
+    m_window->setView(view);
+
+    //without a fixed render size frames are rendered at the pixels the canvas covers, so they are never scaled up
+    sf::Vector2u render_size = m_renderSize;
+    if(render_size == sf::Vector2u())
+    {
+        const sf::Vector2f canvas = m_timePanel->getCanvas()->getSize() * scale;
+        render_size = sf::Vector2u(static_cast<unsigned>(std::lround(canvas.x)), static_cast<unsigned>(std::lround(canvas.y)));
+    }
+    m_timePanel->modifyCanvas([render_size](Canvas &canvas) { canvas.setRenderSize(render_size); });
+    m_redrawRequested = true;
+}
+
+sf::Vector2i Program::getMousePosition() const
+{
+    return sf::Vector2i(m_window->mapPixelToCoords(sf::Mouse::getPosition(*m_window)));
 }
 
 void Program::render()
 {
-   m_window->clear();
+    {
+        BCG_PROFILE_SCOPE("Program::render");
+        m_window->clear();
 
-   m_timePanel->render(m_window);
-   m_buttonPanel->render(m_window);
+        if(m_presenting)
+        {
+            m_timePanel->renderCanvas(m_window);
+        }
+        else
+        {
+            m_timePanel->render(m_window);
+            m_buttonPanel->render(m_window);
+        }
+        m_profilerOverlay.render(m_window);
+    }
 
-   m_window->display();
+    //only frames of a played animation are paced, the others are drawn when something changes
+    const bool paced = m_presenting && m_timePanel->getControl()->isPlay();
+    if(paced)
+    {
+        m_pacer.submitted(secondsOf(m_presentClock));
+    }
+    m_window->display();
+    if(paced)
+    {
+        m_pacer.presented(secondsOf(m_presentClock));
+    }
+    else
+    {
+        m_pacer.reset();
+    }
 }
 
 void Program::run()
@@ -307,6 +786,11 @@ void Program::run()
     while(m_window->isOpen())
     {
        this->updateSFMLEvents();
-       this->render();
+       if(m_redrawRequested && m_window->isOpen())
+       {
+           this->render();
+           m_redrawRequested = false;
+           Profiler::shared().endFrame();
+       }
     }
 }
@@ -0,0 +1,295 @@
+#include "../../include/util/BenchmarkReport.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <locale>
+#include <sstream>
+
+namespace
+{
+	const char *CSV_HEADER = "group,name,size,ns_per_op,ops_per_s,mpix_per_s";
+
+	std::string escapeJson(const std::string &text)
+	{
+		std::string escaped;
+		for(const char c : text)
+		{
+			if(c == '"' || c == '\\')
+			{
+				escaped += '\\';
+			}
+			escaped += c;
+		}
+		return escaped;
+	}
+
+	std::string quoteCsv(const std::string &text)
+	{
+		if(text.find_first_of(",\"\n") == std::string::npos)
+		{
+			return text;
+		}
+		std::string quoted = "\"";
+		for(const char c : text)
+		{
+			quoted += c == '"' ? "\"\"" : std::string(1u, c);
+		}
+		return quoted + "\"";
+	}
+
+	/**
+	 * Splits a line of CSV into its fields, quoted fields may hold commas and doubled quotes
+	 */
+	std::vector<std::string> splitCsv(const std::string &line)
+	{
+		std::vector<std::string> fields(1u);
+		bool quoted = false;
+		for(std::size_t i = 0; i < line.size(); i++)
+		{
+			const char c = line[i];
+			if(quoted && c == '"' && i + 1u < line.size() && line[i + 1u] == '"')
+			{
+				fields.back() += '"';
+				i++;
+			}
+			else if(c == '"')
+			{
+				quoted = !quoted;
+			}
+			else if(c == ',' && !quoted)
+			{
+				fields.emplace_back();
+			}
+			else if(c != '\r')
+			{
+				fields.back() += c;
+			}
+		}
+		return fields;
+	}
+
+	//numbers are written the same on every locale, so baselines move between machines
+	std::string formatNumber(const double value, const int precision)
+	{
+		std::ostringstream text;
+		text.imbue(std::locale::classic());
+		text << std::fixed << std::setprecision(precision) << value;
+		return text.str();
+	}
+}//anonymous namespace
+
+double BenchmarkReport::Result::perSecond() const
+{
+	return nanoseconds > 0.0 ? 1e9 / nanoseconds : 0.0;
+}
+
+double BenchmarkReport::Result::megapixelsPerSecond() const
+{
+	return nanoseconds > 0.0 ? pixels * 1e3 / nanoseconds : 0.0;
+}
+
+BenchmarkReport::BenchmarkReport()
+:
+m_results(),
+m_properties()
+{ }
+
+BenchmarkReport BenchmarkReport::loadCsv(const std::string &path)
+{
+	std::ifstream file(path);
+	if(!file)
+	{
+		throw std::runtime_error("BenchmarkReport::loadCsv(): cannot open " + path);
+	}
+
+	BenchmarkReport report;
+	std::string line;
+	std::size_t number = 0u;
+	while(std::getline(file, line))
+	{
+		number++;
+		if(line.empty() || line == "\r" || line.rfind("group,", 0u) == 0u)
+		{
+			continue;
+		}
+		const std::vector<std::string> fields = splitCsv(line);
+		Result result;
+		char *end = nullptr;
+		if(fields.size() >= 4u)
+		{
+			result.group = fields[0];
+			result.name = fields[1];
+			result.size = fields[2];
+			result.nanoseconds = std::strtod(fields[3].c_str(), &end);
+		}
+		if(fields.size() < 4u || end == fields[3].c_str() || !(result.nanoseconds > 0.0))
+		{
+			throw std::runtime_error("BenchmarkReport::loadCsv(): broken line " + std::to_string(number) + " in " + path);
+		}
+		//the pixels are not written, the throughput gives them back
+		if(fields.size() >= 6u)
+		{
+			result.pixels = std::strtod(fields[5].c_str(), nullptr) * result.nanoseconds * 1e-3;
+		}
+		report.add(result);
+	}
+	return report;
+}
+
+void BenchmarkReport::add(const Result &result)
+{
+	auto found = std::find_if(m_results.begin(), m_results.end(), [&result](const Result &kept)
+	{
+		return kept.group == result.group && kept.name == result.name && kept.size == result.size;
+	});
+	if(found != m_results.end())
+	{
+		*found = result;
+	}
+	else
+	{
+		m_results.push_back(result);
+	}
+}
+
+void BenchmarkReport::setProperty(const std::string &key, const std::string &value)
+{
+	auto found = std::find_if(m_properties.begin(), m_properties.end(), [&key](const auto &property) { return property.first == key; });
+	if(found != m_properties.end())
+	{
+		found->second = value;
+	}
+	else
+	{
+		m_properties.emplace_back(key, value);
+	}
+}
+
+const std::vector<BenchmarkReport::Result> &BenchmarkReport::getResults() const
+{
+	return m_results;
+}
+
+const BenchmarkReport::Result *BenchmarkReport::find(const std::string &group, const std::string &name, const std::string &size) const
+{
+	auto found = std::find_if(m_results.begin(), m_results.end(), [&](const Result &result)
+	{
+		return result.group == group && result.name == name && result.size == size;
+	});
+	return found != m_results.end() ? &*found : nullptr;
+}
+
+std::vector<BenchmarkReport::Regression> BenchmarkReport::compare(const BenchmarkReport &baseline, const float &threshold) const
+{
+	if(!(threshold >= 0.f))
+	{
+		throw std::invalid_argument("BenchmarkReport::compare(): threshold must not be negative");
+	}
+	std::vector<Regression> regressions;
+	for(const Result &result : m_results)
+	{
+		const Result *before = baseline.find(result.group, result.name, result.size);
+		if(!before)
+		{
+			continue;//new cases have nothing to regress from
+		}
+		const double slowdown = result.nanoseconds / before->nanoseconds - 1.0;
+		if(slowdown > threshold)
+		{
+			regressions.push_back(Regression{*before, result, slowdown});
+		}
+	}
+	return regressions;
+}
+
+bool BenchmarkReport::check(const BenchmarkReport &baseline, const float &threshold, std::ostream &out) const
+{
+	const std::vector<Regression> regressions = this->compare(baseline, threshold);
+	std::size_t compared = 0u;
+	for(const Result &result : m_results)
+	{
+		compared += baseline.find(result.group, result.name, result.size) ? 1u : 0u;
+	}
+	out << "\nCompared " << compared << " of " << m_results.size() << " cases with the baseline, threshold "
+		<< formatNumber(threshold * 100.f, 1) << " %\n";
+	for(const Regression &regression : regressions)
+	{
+		const Result &current = regression.current;
+		out << "  slower: " << current.group << " " << current.name << (current.size.empty() ? "" : " " + current.size)
+			<< " " << formatNumber(regression.baseline.nanoseconds, 2) << " -> " << formatNumber(current.nanoseconds, 2)
+			<< " ns/op (+" << formatNumber(regression.slowdown * 100.0, 1) << " %)\n";
+	}
+	out << (regressions.empty() ? std::string("No regressions")
+		: std::to_string(regressions.size()) + (regressions.size() == 1u ? " regression" : " regressions")) << std::endl;
+	return regressions.empty();
+}
+
+void BenchmarkReport::writeJson(const std::string &path) const
+{
+	std::ofstream file(path, std::ios::trunc);
+	if(!file)
+	{
+		throw std::runtime_error("BenchmarkReport::writeJson(): cannot open " + path);
+	}
+	file << "{\n\t\"version\": 1";
+	for(const auto &property : m_properties)
+	{
+		file << ",\n\t\"" << escapeJson(property.first) << "\": \"" << escapeJson(property.second) << "\"";
+	}
+	file << ",\n\t\"results\": [";
+	for(std::size_t i = 0; i < m_results.size(); i++)
+	{
+		const Result &result = m_results[i];
+		file << (i == 0u ? "\n" : ",\n")
+			<< "\t\t{\"group\": \"" << escapeJson(result.group)
+			<< "\", \"name\": \"" << escapeJson(result.name)
+			<< "\", \"size\": \"" << escapeJson(result.size)
+			<< "\", \"ns_per_op\": " << formatNumber(result.nanoseconds, 2)
+			<< ", \"ops_per_s\": " << formatNumber(result.perSecond(), 3)
+			<< ", \"mpix_per_s\": " << formatNumber(result.megapixelsPerSecond(), 3) << "}";
+	}
+	file << "\n\t]\n}\n";
+	if(!file)
+	{
+		throw std::runtime_error("BenchmarkReport::writeJson(): cannot write " + path);
+	}
+}
+
+void BenchmarkReport::writeCsv(const std::string &path) const
+{
+	std::ofstream file(path, std::ios::trunc);
+	if(!file)
+	{
+		throw std::runtime_error("BenchmarkReport::writeCsv(): cannot open " + path);
+	}
+	file << CSV_HEADER << "\n";
+	for(const Result &result : m_results)
+	{
+		file << quoteCsv(result.group) << "," << quoteCsv(result.name) << "," << quoteCsv(result.size) << ","
+			<< formatNumber(result.nanoseconds, 2) << ","
+			<< formatNumber(result.perSecond(), 3) << ","
+			<< formatNumber(result.megapixelsPerSecond(), 3) << "\n";
+	}
+	if(!file)
+	{
+		throw std::runtime_error("BenchmarkReport::writeCsv(): cannot write " + path);
+	}
+}
+
+void BenchmarkReport::write(const std::string &path) const
+{
+	const std::string extension = std::filesystem::path(path).extension().string();
+	if(extension == ".json")
+	{
+		this->writeJson(path);
+	}
+	else if(extension == ".csv")
+	{
+		this->writeCsv(path);
+	}
+	else
+	{
+		throw std::invalid_argument("BenchmarkReport::write(): reports are written as .json or .csv, not " + path);
+	}
+}
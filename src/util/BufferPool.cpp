@@ -0,0 +1,98 @@
+#include "../../include/util/BufferPool.h"
+
+BufferPool::State::State(const MemorySubsystem subsystem, const std::size_t idle_limit)
+:
+mutex(),
+idle(),
+idleLimit(idle_limit),
+charge(subsystem)
+{ }
+
+void BufferPool::State::accountIdle()
+{
+	std::size_t bytes = 0u;
+	for(const auto &buffer : idle)
+	{
+		bytes += buffer->capacity();
+	}
+	charge.setCpu(bytes);
+}
+
+BufferPool::Recycler::Recycler(std::shared_ptr<State> state)
+:
+m_state(std::move(state))
+{ }
+
+void BufferPool::Recycler::operator()(std::vector<std::uint8_t> *buffer) const
+{
+	std::unique_ptr<std::vector<std::uint8_t>> owned(buffer);
+	if(!m_state)
+	{
+		return;
+	}
+	std::lock_guard<std::mutex> lock(m_state->mutex);
+	if(m_state->idle.size() < m_state->idleLimit)
+	{
+		m_state->idle.push_back(std::move(owned));
+		m_state->accountIdle();
+	}
+}
+
+BufferPool::BufferPool(const MemorySubsystem subsystem, const std::size_t idle_limit)
+:
+m_state(std::make_shared<State>(subsystem, idle_limit))
+{ }
+
+BufferPool::~BufferPool()
+{
+	std::lock_guard<std::mutex> lock(m_state->mutex);
+	m_state->idleLimit = 0u;
+	m_state->idle.clear();
+	m_state->accountIdle();
+}
+
+BufferPool::Buffer BufferPool::acquire(const std::size_t bytes)
+{
+	std::unique_ptr<std::vector<std::uint8_t>> buffer;
+	{
+		//the smallest idle buffer which fits, so big ones stay for big requests
+		std::lock_guard<std::mutex> lock(m_state->mutex);
+		auto best = m_state->idle.end();
+		for(auto it = m_state->idle.begin(); it != m_state->idle.end(); it++)
+		{
+			if((*it)->capacity() >= bytes && (best == m_state->idle.end() || (*it)->capacity() < (*best)->capacity()))
+			{
+				best = it;
+			}
+		}
+		if(best == m_state->idle.end() && !m_state->idle.empty())//none fits, the oldest one grows
+		{
+			best = m_state->idle.begin();
+		}
+		if(best != m_state->idle.end())
+		{
+			buffer = std::move(*best);
+			m_state->idle.erase(best);
+			m_state->accountIdle();
+		}
+	}
+	if(!buffer)
+	{
+		buffer = std::make_unique<std::vector<std::uint8_t>>();
+	}
+	buffer->resize(bytes);
+	return Buffer(buffer.release(), Recycler(m_state));
+}
+
+void BufferPool::trim()
+{
+	std::lock_guard<std::mutex> lock(m_state->mutex);
+	m_state->idle.clear();
+	m_state->accountIdle();
+}
+
+std::size_t BufferPool::getIdleBytes() const
+{
+	std::lock_guard<std::mutex> lock(m_state->mutex);
+	return m_state->charge.getCpu();
+}
@@ -0,0 +1,154 @@
+#include "../../include/util/ContentHash.h"
+#include "../../include/util/Resources.h"
+
+#include <fstream>
+
+namespace
+{
+	constexpr std::uint64_t PRIME1 = 11400714785074694791ull;
+	constexpr std::uint64_t PRIME2 = 14029467366897019727ull;
+	constexpr std::uint64_t PRIME3 = 1609587929392839161ull;
+	constexpr std::uint64_t PRIME4 = 9650029242287828579ull;
+	constexpr std::uint64_t PRIME5 = 2870177450012600261ull;
+
+	inline std::uint64_t rotate(const std::uint64_t value, const unsigned bits)
+	{
+		return (value << bits) | (value >> (64u - bits));
+	}
+
+	//little-endian reads, every platform the application builds on is little-endian
+	inline std::uint64_t read64(const unsigned char *bytes)
+	{
+		std::uint64_t value;
+		std::memcpy(&value, bytes, sizeof(value));
+		return value;
+	}
+
+	inline std::uint64_t read32(const unsigned char *bytes)
+	{
+		std::uint32_t value;
+		std::memcpy(&value, bytes, sizeof(value));
+		return value;
+	}
+
+	inline std::uint64_t round(std::uint64_t accumulator, const std::uint64_t input)
+	{
+		accumulator += input * PRIME2;
+		return rotate(accumulator, 31u) * PRIME1;
+	}
+
+	inline std::uint64_t merge(const std::uint64_t hash, const std::uint64_t accumulator)
+	{
+		return (hash ^ round(0u, accumulator)) * PRIME1 + PRIME4;
+	}
+}//anonymous namespace
+
+ContentHash::ContentHash(const std::uint64_t seed)
+:
+m_value(seed)
+{ }
+
+ContentHash &ContentHash::add(const void *data, const std::size_t bytes)
+{
+	//the value so far seeds the hash of the piece
+	m_value = ContentHash::hashBytes(data, bytes, m_value);
+	return *this;
+}
+
+ContentHash &ContentHash::add(const std::string &text)
+{
+	this->add(static_cast<std::uint64_t>(text.size()));
+	return this->add(text.data(), text.size());
+}
+
+std::uint64_t ContentHash::getValue() const
+{
+	return m_value;
+}
+
+std::uint64_t ContentHash::hashBytes(const void *data, const std::size_t bytes, const std::uint64_t seed)
+{
+	const unsigned char *input = static_cast<const unsigned char *>(data);
+	const unsigned char *const end = input + bytes;
+	std::uint64_t hash;
+
+	if(bytes >= 32u)
+	{
+		//four independent lanes keep the multipliers busy
+		std::uint64_t lane1 = seed + PRIME1 + PRIME2, lane2 = seed + PRIME2, lane3 = seed, lane4 = seed - PRIME1;
+		const unsigned char *const last_stripe = end - 32u;
+		do
+		{
+			lane1 = round(lane1, read64(input));
+			lane2 = round(lane2, read64(input + 8u));
+			lane3 = round(lane3, read64(input + 16u));
+			lane4 = round(lane4, read64(input + 24u));
+			input += 32u;
+		}
+		while(input <= last_stripe);
+		hash = rotate(lane1, 1u) + rotate(lane2, 7u) + rotate(lane3, 12u) + rotate(lane4, 18u);
+		hash = merge(hash, lane1);
+		hash = merge(hash, lane2);
+		hash = merge(hash, lane3);
+		hash = merge(hash, lane4);
+	}
+	else
+	{
+		hash = seed + PRIME5;
+	}
+	hash += static_cast<std::uint64_t>(bytes);
+
+	for(; input + 8u <= end; input += 8u)
+	{
+		hash ^= round(0u, read64(input));
+		hash = rotate(hash, 27u) * PRIME1 + PRIME4;
+	}
+	if(input + 4u <= end)
+	{
+		hash ^= read32(input) * PRIME1;
+		hash = rotate(hash, 23u) * PRIME2 + PRIME3;
+		input += 4u;
+	}
+	for(; input < end; input++)
+	{
+		hash ^= *input * PRIME5;
+		hash = rotate(hash, 11u) * PRIME1;
+	}
+
+	hash ^= hash >> 33u;
+	hash *= PRIME2;
+	hash ^= hash >> 29u;
+	hash *= PRIME3;
+	hash ^= hash >> 32u;
+	return hash;
+}
+
+std::uint64_t ContentHash::hashFile(const std::string &path)
+{
+	if(const Resource *resource = Resources::findPath(path))
+	{
+		return ContentHash::hashBytes(resource->data, resource->size);
+	}
+	std::ifstream file(path, std::ios::binary);
+	if(!file)
+	{
+		throw std::runtime_error("ContentHash::hashFile(): cannot open " + path);
+	}
+	const std::vector<char> contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	if(file.bad())
+	{
+		throw std::runtime_error("ContentHash::hashFile(): cannot read " + path);
+	}
+	return ContentHash::hashBytes(contents.data(), contents.size());
+}
+
+std::string ContentHash::toHex(const std::uint64_t hash)
+{
+	static const char DIGITS[] = "0123456789abcdef";
+	std::string hex(16u, '0');
+	for(unsigned i = 0; i < 16u; i++)
+	{
+		hex[15u - i] = DIGITS[(hash >> (4u * i)) & 0xfu];
+	}
+	return hex;
+}
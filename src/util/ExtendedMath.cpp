@@ -0,0 +1,348 @@
+#include "../../include/util/ExtendedMath.h"
+
+namespace em
+{
+	template <typename T>
+	Matrix4<T> Matrix4<T>::operator-() const
+	{
+		return this->isAffine() ? this->affineInverse() : this->generalInverse();
+	}
+
+	template <typename T>
+	Matrix4<T> Matrix4<T>::operator+(const Matrix4<T> &right) const
+	{
+		Matrix4<T> result;
+		for(unsigned i = 0; i < 4; i++)
+		{
+			for(unsigned j = 0; j < 4; j++)
+			{
+				result[i][j] = m_matrix[i][j] + right[i][j];
+			}
+		}
+		return result;
+	}
+
+	template <typename T>
+	Matrix4<T> Matrix4<T>::operator-(const Matrix4<T> &right) const
+	{
+		Matrix4<T> result;
+		for(unsigned i = 0; i < 4; i++)
+		{
+			for(unsigned j = 0; j < 4; j++)
+			{
+				result[i][j] = m_matrix[i][j] - right[i][j];
+			}
+		}
+		return result;
+	}
+
+	template <typename T>
+	Matrix4<T> &Matrix4<T>::operator+=(const Matrix4<T> &right)
+	{
+		*this = *this + right;
+		return *this;
+	}
+
+	template <typename T>
+	Matrix4<T> &Matrix4<T>::operator-=(const Matrix4<T> &right)
+	{
+		*this = *this - right;
+		return *this;
+	}
+
+	template <typename T>
+	const bool Matrix4<T>::operator!=(const Matrix4<T> &right) const
+	{
+		for(unsigned i = 0; i < 4; i++)
+		{
+			for(unsigned j = 0; j < 4; j++)
+			{
+				if(m_matrix[i][j] != right[i][j])
+					return true;
+			}
+		}
+		return false;
+	}
+
+	template <typename T>
+	const bool Matrix4<T>::operator==(const Matrix4<T> &right) const
+	{
+		for(unsigned i = 0; i < 4; i++)
+		{
+			for(unsigned j = 0; j < 4; j++)
+			{
+				if(m_matrix[i][j] != right[i][j])
+					return false;
+			}
+		}
+		return true;
+	}
+
+	template <typename T>
+	Matrix4<T> &Matrix4<T>::rotateX(const float &angle)
+	{
+		double emPI = 3.141592654;
+		T rad = fmod(angle * emPI / 180.0, 2.0 * emPI);
+		T cos_x = std::cos(rad);
+		T sin_x = std::sin(rad);
+		
+		(*this) *= Matrix4<T>(	1, 0, 0, 0,
+								0, cos_x, -sin_x, 0,
+								0, sin_x, cos_x, 0,
+								0, 0, 0, 1);
+		return *this;
+	}
+
+	template <typename T>
+	Matrix4<T> &Matrix4<T>::rotateY(const float &angle)
+	{
+		double emPI = 3.141592654;
+		T rad = fmod(angle * emPI / 180.0, 2.0 * emPI);
+		T cos_y = std::cos(rad);
+		T sin_y = std::sin(rad);
+		
+		(*this) *= Matrix4<T>(	cos_y, 0, sin_y, 0,
+								0, 1, 0, 0,
+								-sin_y, 0, cos_y, 0,
+								0, 0, 0, 1);
+		return *this;
+	}
+
+	template <typename T>
+	Matrix4<T> &Matrix4<T>::rotateZ(const float &angle)
+	{
+		double emPI = 3.141592654;
+		T rad = fmod(angle * emPI / 180.0, 2.0 * emPI);
+		T cos_z = std::cos(rad);
+		T sin_z = std::sin(rad);
+		
+		(*this) *= Matrix4<T>(	cos_z, -sin_z, 0, 0,
+								sin_z, cos_z, 0, 0,
+								0, 0, 1, 0,
+								0, 0, 0, 1);
+		return *this;
+	}
+
+	template <typename T>
+	Matrix4<T> &Matrix4<T>::scale(const sf::Vector3<T> &scale)
+	{
+		(*this) *= Matrix4<T>(	scale.x, 0, 0, 0,
+								0, scale.y, 0, 0, 
+								0, 0, scale.z, 0,
+								0, 0, 0, 1);
+		return *this;
+	}
+
+	template <typename T>
+	Matrix4<T> &Matrix4<T>::mirror(const bool xAxis, const bool yAxis, const bool zAxis)
+	{
+		Matrix4<T> mirrorMatrix;
+		if(xAxis)
+		{
+			mirrorMatrix[0][0] = -1;
+		}
+		if(yAxis)
+		{
+			mirrorMatrix[1][1] = -1;
+		}
+		if(zAxis)
+		{
+			mirrorMatrix[2][2] = -1;
+		}
+		
+		(*this) *= mirrorMatrix;
+		return *this;
+	}
+
+	template <typename T>
+	Matrix4<T> Matrix4<T>::affineInverse() const
+	{
+		//inverse of [A t] is [A^-1 -A^-1*t], A^-1 is computed from cofactors of A
+		const Matrix4<T> &m = *this;
+		const T c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+		const T c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+		const T c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+
+		double det = static_cast<double>(m[0][0]) * c00 + static_cast<double>(m[0][1]) * c01 + static_cast<double>(m[0][2]) * c02;
+		if(det == 0)
+		{
+			return Matrix4<T>();
+		}
+		det = 1.0 / det;
+
+		Matrix4<T> result;
+		result[0][0] = c00 * det;
+		result[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * det;
+		result[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * det;
+		result[1][0] = c01 * det;
+		result[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * det;
+		result[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * det;
+		result[2][0] = c02 * det;
+		result[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * det;
+		result[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * det;
+
+		for(unsigned i = 0; i < 3; i++)
+		{
+			result[i][3] = -(result[i][0] * m[0][3] + result[i][1] * m[1][3] + result[i][2] * m[2][3]);
+		}
+		return result;
+	}
+
+	template <typename T>
+	Matrix4<T> Matrix4<T>::generalInverse() const
+	{
+		Matrix4<T> result;
+	    const Matrix4<T> &m = *this;
+
+	    result[0][0] = m[1][1]  * m[2][2] * m[3][3] - 
+	             m[1][1]  * m[2][3] * m[3][2] - 
+	             m[2][1]  * m[1][2]  * m[3][3] + 
+	             m[2][1]  * m[1][3]  * m[3][2] +
+	             m[3][1] * m[1][2]  * m[2][3] - 
+	             m[3][1] * m[1][3]  * m[2][2];
+
+	    result[1][0] = -m[1][0]  * m[2][2] * m[3][3] + 
+	              m[1][0]  * m[2][3] * m[3][2] + 
+	              m[2][0]  * m[1][2]  * m[3][3] - 
+	              m[2][0]  * m[1][3]  * m[3][2] - 
+	              m[3][0] * m[1][2]  * m[2][3] + 
+	              m[3][0] * m[1][3]  * m[2][2];
+
+	    result[2][0] = m[1][0]  * m[2][1] * m[3][3] - 
+	             m[1][0]  * m[2][3] * m[3][1] - 
+	             m[2][0]  * m[1][1] * m[3][3] + 
+	             m[2][0]  * m[1][3] * m[3][1] + 
+	             m[3][0] * m[1][1] * m[2][3] - 
+	             m[3][0] * m[1][3] * m[2][1];
+
+	    result[3][0] = -m[1][0]  * m[2][1] * m[3][2] + 
+	               m[1][0]  * m[2][2] * m[3][1] +
+	               m[2][0]  * m[1][1] * m[3][2] - 
+	               m[2][0]  * m[1][2] * m[3][1] - 
+	               m[3][0] * m[1][1] * m[2][2] + 
+	               m[3][0] * m[1][2] * m[2][1];
+
+	    result[0][1] = -m[0][1]  * m[2][2] * m[3][3] + 
+	              m[0][1]  * m[2][3] * m[3][2] + 
+	              m[2][1]  * m[0][2] * m[3][3] - 
+	              m[2][1]  * m[0][3] * m[3][2] - 
+	              m[3][1] * m[0][2] * m[2][3] + 
+	              m[3][1] * m[0][3] * m[2][2];
+
+	    result[1][1] = m[0][0]  * m[2][2] * m[3][3] - 
+	             m[0][0]  * m[2][3] * m[3][2] - 
+	             m[2][0]  * m[0][2] * m[3][3] + 
+	             m[2][0]  * m[0][3] * m[3][2] + 
+	             m[3][0] * m[0][2] * m[2][3] - 
+	             m[3][0] * m[0][3] * m[2][2];
+
+	    result[2][1] = -m[0][0]  * m[2][1] * m[3][3] + 
+	              m[0][0]  * m[2][3] * m[3][1] + 
+	              m[2][0]  * m[0][1] * m[3][3] - 
+	              m[2][0]  * m[0][3] * m[3][1] - 
+	              m[3][0] * m[0][1] * m[2][3] + 
+	              m[3][0] * m[0][3] * m[2][1];
+
+	    result[3][1] = m[0][0]  * m[2][1] * m[3][2] - 
+	              m[0][0]  * m[2][2] * m[3][1] - 
+	              m[2][0]  * m[0][1] * m[3][2] + 
+	              m[2][0]  * m[0][2] * m[3][1] + 
+	              m[3][0] * m[0][1] * m[2][2] - 
+	              m[3][0] * m[0][2] * m[2][1];
+
+	    result[0][2] = m[0][1]  * m[1][2] * m[3][3] - 
+	             m[0][1]  * m[1][3] * m[3][2] - 
+	             m[1][1]  * m[0][2] * m[3][3] + 
+	             m[1][1]  * m[0][3] * m[3][2] + 
+	             m[3][1] * m[0][2] * m[1][3] - 
+	             m[3][1] * m[0][3] * m[1][2];
+
+	    result[1][2] = -m[0][0]  * m[1][2] * m[3][3] + 
+	              m[0][0]  * m[1][3] * m[3][2] + 
+	              m[1][0]  * m[0][2] * m[3][3] - 
+	              m[1][0]  * m[0][3] * m[3][2] - 
+	              m[3][0] * m[0][2] * m[1][3] + 
+	              m[3][0] * m[0][3] * m[1][2];
+
+	    result[2][2] = m[0][0]  * m[1][1] * m[3][3] - 
+	              m[0][0]  * m[1][3] * m[3][1] - 
+	              m[1][0]  * m[0][1] * m[3][3] + 
+	              m[1][0]  * m[0][3] * m[3][1] + 
+	              m[3][0] * m[0][1] * m[1][3] - 
+	              m[3][0] * m[0][3] * m[1][1];
+
+	    result[3][2] = -m[0][0]  * m[1][1] * m[3][2] + 
+	               m[0][0]  * m[1][2] * m[3][1] + 
+	               m[1][0]  * m[0][1] * m[3][2] - 
+	               m[1][0]  * m[0][2] * m[3][1] - 
+	               m[3][0] * m[0][1] * m[1][2] + 
+	               m[3][0] * m[0][2] * m[1][1];
+
+	    result[0][3] = -m[0][1] * m[1][2] * m[2][3] + 
+	              m[0][1] * m[1][3] * m[2][2] + 
+	              m[1][1] * m[0][2] * m[2][3] - 
+	              m[1][1] * m[0][3] * m[2][2] - 
+	              m[2][1] * m[0][2] * m[1][3] + 
+	              m[2][1] * m[0][3] * m[1][2];
+
+	    result[1][3] = m[0][0] * m[1][2] * m[2][3] - 
+	             m[0][0] * m[1][3] * m[2][2] - 
+	             m[1][0] * m[0][2] * m[2][3] + 
+	             m[1][0] * m[0][3] * m[2][2] + 
+	             m[2][0] * m[0][2] * m[1][3] - 
+	             m[2][0] * m[0][3] * m[1][2];
+
+	    result[2][3] = -m[0][0] * m[1][1] * m[2][3] + 
+	               m[0][0] * m[1][3] * m[2][1] + 
+	               m[1][0] * m[0][1] * m[2][3] - 
+	               m[1][0] * m[0][3] * m[2][1] - 
+	               m[2][0] * m[0][1] * m[1][3] + 
+	               m[2][0] * m[0][3] * m[1][1];
+
+	    result[3][3] = m[0][0] * m[1][1] * m[2][2] - 
+	              m[0][0] * m[1][2] * m[2][1] - 
+	              m[1][0] * m[0][1] * m[2][2] + 
+	              m[1][0] * m[0][2] * m[2][1] + 
+	              m[2][0] * m[0][1] * m[1][2] - 
+	              m[2][0] * m[0][2] * m[1][1];
+
+		double det;
+	    det = m[0][0] * result[0][0] + m[0][1] * result[1][0] + m[0][2] * result[2][0] + m[0][3] * result[3][0];
+
+	    if(det == 0)
+	    {
+	        return Matrix4<T>();
+	    }
+
+	    det = 1.0 / det;
+
+	    for(unsigned i = 0; i < 4; i++)
+	    {
+	    	for(unsigned j = 0; j < 4; j++)
+	    	{
+	    		result[i][j] *= det;
+	    	}
+	    }
+
+	    return result;
+	}
+
+/*	template <typename T>
+	void Matrix4<T>::print(const std::string &prefix) const
+	{
+		std::cout << prefix << std::endl;
+		for(unsigned i = 0; i < 4; i++)
+		{
+			for(unsigned j = 0; j < 4; j++)
+			{
+				std::cout << m_matrix[i][j] << " ";
+			}
+			std::cout << std::endl;
+		}
+		std::cout << std::endl;
+	}*/
+
+	template class Matrix4<float>;
+	template class Matrix4<int>;
+	template class Matrix4<unsigned>;
+}//namespace em
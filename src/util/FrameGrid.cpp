@@ -0,0 +1,102 @@
+#include "../../include/util/FrameGrid.h"
+
+FrameGrid::FrameGrid()
+:
+m_frames(0u),
+m_length(0.f),
+m_delta(0.f)
+{ }
+
+FrameGrid::FrameGrid(const unsigned frames, const float &length)
+:
+m_frames(frames),
+m_length(std::max(length, 0.f)),
+m_delta(0.f)
+{
+	if(m_frames > 0u && m_length > 0.f)
+	{
+		m_delta = m_frames > 1u ? m_length / static_cast<float>(m_frames - 1u) : m_length;
+	}
+}
+
+FrameGrid FrameGrid::atRate(const float &fps, const float &length)
+{
+	const float intervals = std::round(std::max(fps, 0.f) * std::max(length, 0.f));
+	return FrameGrid(static_cast<unsigned>(std::max(intervals, 1.f)) + 1u, length);
+}
+
+unsigned FrameGrid::getFrames() const
+{
+	return m_frames;
+}
+
+const float &FrameGrid::getLength() const
+{
+	return m_length;
+}
+
+const float &FrameGrid::getDelta() const
+{
+	return m_delta;
+}
+
+bool FrameGrid::isValid() const
+{
+	return m_frames > 0u && m_delta > 0.f;
+}
+
+float FrameGrid::timeOf(const unsigned frame) const
+{
+	if(!this->isValid())
+	{
+		return 0.f;
+	}
+	const unsigned clamped = std::min(frame, m_frames - 1u);
+	return std::max(std::min(clamped * m_delta, m_length - FrameGrid::END_MARGIN), 0.f);
+}
+
+unsigned FrameGrid::frameAt(const float &time) const
+{
+	if(!this->isValid() || !(time > 0.f))
+	{
+		return 0u;
+	}
+	//the last frame is moved before the end, so everything from it on belongs to it
+	if(time >= this->timeOf(m_frames - 1u))
+	{
+		return m_frames - 1u;
+	}
+	//a time lying on a frame up to rounding error counts as that frame
+	const float frame = std::floor(time / m_delta + 1e-4f);
+	return std::min(static_cast<unsigned>(frame), m_frames - 1u);
+}
+
+unsigned FrameGrid::nearestFrame(const float &time) const
+{
+	if(!this->isValid() || !(time > 0.f))
+	{
+		return 0u;
+	}
+	const float frame = std::round(time / m_delta);
+	return std::min(static_cast<unsigned>(frame), m_frames - 1u);
+}
+
+std::vector<float> FrameGrid::times() const
+{
+	std::vector<float> result(this->isValid() ? m_frames : 0u);
+	for(unsigned i = 0; i < result.size(); i++)
+	{
+		result[i] = this->timeOf(i);
+	}
+	return result;
+}
+
+bool FrameGrid::operator==(const FrameGrid &other) const
+{
+	return m_frames == other.m_frames && m_length == other.m_length;
+}
+
+bool FrameGrid::operator!=(const FrameGrid &other) const
+{
+	return !(*this == other);
+}
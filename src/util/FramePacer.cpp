@@ -0,0 +1,99 @@
+#include "../../include/util/FramePacer.h"
+
+namespace
+{
+	const float WORK_SMOOTHING = 0.1f;//weight of the last frame in the average work of a frame
+	const float REFRESH_SMOOTHING = 0.05f;//weight of the last interval in the learned refresh interval
+	const float MIN_REFRESH_SHARE = 0.2f;//intervals shorter than this part of the refresh are not learned from
+	const float MAX_REFRESH_SHARE = 1.5f;//intervals longer than this part of the refresh span more refreshes
+}//anonymous namespace
+
+FramePacer::FramePacer(const float &refresh_interval)
+:
+m_refreshInterval(refresh_interval > 0.f ? refresh_interval : 1.f / 60.f),
+m_work(0.f),
+m_running(false),
+m_frameBegin(0.0),
+m_lastPresent(0.0),
+m_predicted(0.0),
+m_statistics(),
+m_intervalSum(0.0),
+m_intervalCount(0u)
+{ }
+
+void FramePacer::reset()
+{
+	m_running = false;
+}
+
+void FramePacer::clearStatistics()
+{
+	m_statistics = Statistics();
+	m_intervalSum = 0.0;
+	m_intervalCount = 0u;
+}
+
+float FramePacer::beginFrame(const double &now)
+{
+	m_frameBegin = now;
+	if(!m_running)
+	{
+		return 0.f;
+	}
+	//the frame is shown at the first refresh after its work is done
+	const double refresh = m_refreshInterval;
+	const double ready = now - m_lastPresent + m_work;
+	const double refreshes = std::clamp(std::ceil(ready / refresh), 1.0, static_cast<double>(MAX_REFRESHES));
+	const double predicted = std::max(m_lastPresent + refreshes * refresh, m_predicted);
+	//a late previous frame makes the delta longer, so the animation catches up with real time
+	const double delta = predicted - m_predicted;
+	m_predicted = predicted;
+	return static_cast<float>(delta);
+}
+
+void FramePacer::submitted(const double &now)
+{
+	m_work += (static_cast<float>(now - m_frameBegin) - m_work) * WORK_SMOOTHING;
+}
+
+void FramePacer::presented(const double &now)
+{
+	m_statistics.frames++;
+	if(!m_running)
+	{
+		//the first frame is shown at whatever time it is, the animation is paced from there
+		m_predicted = now;
+		m_lastPresent = now;
+		m_running = true;
+		return;
+	}
+
+	const float interval = static_cast<float>(now - m_lastPresent);
+	m_intervalSum += interval;
+	m_intervalCount++;
+	m_statistics.worstInterval = std::max(m_statistics.worstInterval, interval);
+
+	const float late = static_cast<float>(now - m_predicted);
+	if(late > m_refreshInterval * LATE_SHARE)
+	{
+		m_statistics.dropped += std::max<std::size_t>(static_cast<std::size_t>(std::lround(late / m_refreshInterval)), 1u);
+	}
+	else if(interval > m_refreshInterval * MIN_REFRESH_SHARE && interval < m_refreshInterval * MAX_REFRESH_SHARE)
+	{
+		m_refreshInterval += (interval - m_refreshInterval) * REFRESH_SMOOTHING;
+	}
+	m_lastPresent = now;
+}
+
+double FramePacer::getPredictedPresent() const
+{
+	return m_predicted;
+}
+
+FramePacer::Statistics FramePacer::getStatistics() const
+{
+	Statistics statistics = m_statistics;
+	statistics.refreshInterval = m_refreshInterval;
+	statistics.meanInterval = m_intervalCount > 0u ? static_cast<float>(m_intervalSum / m_intervalCount) : 0.f;
+	return statistics;
+}
@@ -0,0 +1,132 @@
+#include "../../include/util/MappedFile.h"
+
+#ifdef _WIN32
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+:
+m_data(nullptr),
+m_size(0u)
+{ }
+
+MappedFile::MappedFile(const std::string &path)
+:
+m_data(nullptr),
+m_size(0u)
+{
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if(file == INVALID_HANDLE_VALUE)
+	{
+		throw std::runtime_error("MappedFile::MappedFile(): cannot open " + path);
+	}
+	LARGE_INTEGER size;
+	if(!GetFileSizeEx(file, &size))
+	{
+		CloseHandle(file);
+		throw std::runtime_error("MappedFile::MappedFile(): cannot get the size of " + path);
+	}
+	m_size = static_cast<std::size_t>(size.QuadPart);
+	if(m_size > 0u)
+	{
+		//the view keeps the mapping alive after both handles are closed
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if(mapping)
+		{
+			m_data = static_cast<const std::uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+			CloseHandle(mapping);
+		}
+	}
+	CloseHandle(file);
+#else
+	const int file = open(path.c_str(), O_RDONLY);
+	if(file < 0)
+	{
+		throw std::runtime_error("MappedFile::MappedFile(): cannot open " + path);
+	}
+	struct stat status;
+	if(fstat(file, &status) != 0)
+	{
+		close(file);
+		throw std::runtime_error("MappedFile::MappedFile(): cannot get the size of " + path);
+	}
+	m_size = static_cast<std::size_t>(status.st_size);
+	if(m_size > 0u)
+	{
+		//the mapping stays valid after the descriptor is closed
+		void *mapped = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+		if(mapped != MAP_FAILED)
+		{
+			madvise(mapped, m_size, MADV_SEQUENTIAL);
+			m_data = static_cast<const std::uint8_t *>(mapped);
+		}
+	}
+	close(file);
+#endif
+	if(m_size > 0u && !m_data)
+	{
+		m_size = 0u;
+		throw std::runtime_error("MappedFile::MappedFile(): cannot map " + path);
+	}
+}
+
+MappedFile::MappedFile(MappedFile &&source)
+:
+m_data(source.m_data),
+m_size(source.m_size)
+{
+	source.m_data = nullptr;
+	source.m_size = 0u;
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&source)
+{
+	if(this != &source)
+	{
+		this->unmap();
+		m_data = source.m_data;
+		m_size = source.m_size;
+		source.m_data = nullptr;
+		source.m_size = 0u;
+	}
+	return *this;
+}
+
+MappedFile::~MappedFile()
+{
+	this->unmap();
+}
+
+const std::uint8_t *MappedFile::data() const
+{
+	return m_data;
+}
+
+std::size_t MappedFile::size() const
+{
+	return m_size;
+}
+
+//private member functions
+void MappedFile::unmap()
+{
+	if(m_data)
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(m_data);
+#else
+		munmap(const_cast<std::uint8_t *>(m_data), m_size);
+#endif
+	}
+	m_data = nullptr;
+	m_size = 0u;
+}
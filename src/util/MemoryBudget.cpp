@@ -0,0 +1,181 @@
+#include "../../include/util/MemoryBudget.h"
+
+namespace
+{
+	const char *const NAMES[] = { "animations", "images", "frame cache", "gui", "export" };
+
+	std::size_t index(const MemorySubsystem subsystem)
+	{
+		return static_cast<std::size_t>(subsystem);
+	}
+}//anonymous namespace
+
+MemoryBudget::MemoryBudget()
+:
+m_cpu(),
+m_gpu(),
+m_budget(MemoryBudget::DEFAULT_BUDGET)
+{
+	for(std::size_t i = 0; i < COUNT; i++)
+	{
+		m_cpu[i] = 0;
+		m_gpu[i] = 0;
+	}
+	if(const char *env = std::getenv("BCG_MEMORY_BUDGET"))
+	{
+		m_budget = static_cast<std::size_t>(std::max(0ll, std::strtoll(env, nullptr, 10))) * 1024u * 1024u;
+	}
+}
+
+MemoryBudget &MemoryBudget::shared()
+{
+	static MemoryBudget budget;
+	return budget;
+}
+
+const char *MemoryBudget::getName(const MemorySubsystem subsystem)
+{
+	return index(subsystem) < COUNT ? NAMES[index(subsystem)] : "";
+}
+
+void MemoryBudget::setBudget(const std::size_t bytes)
+{
+	m_budget = bytes;
+}
+
+std::size_t MemoryBudget::getBudget() const
+{
+	return m_budget;
+}
+
+std::size_t MemoryBudget::getCpuUsage(const MemorySubsystem subsystem) const
+{
+	return static_cast<std::size_t>(std::max<std::ptrdiff_t>(m_cpu.at(index(subsystem)), 0));
+}
+
+std::size_t MemoryBudget::getGpuUsage(const MemorySubsystem subsystem) const
+{
+	return static_cast<std::size_t>(std::max<std::ptrdiff_t>(m_gpu.at(index(subsystem)), 0));
+}
+
+std::size_t MemoryBudget::getTotalUsage() const
+{
+	std::size_t total = 0u;
+	for(std::size_t i = 0; i < COUNT; i++)
+	{
+		total += this->getCpuUsage(static_cast<MemorySubsystem>(i)) + this->getGpuUsage(static_cast<MemorySubsystem>(i));
+	}
+	return total;
+}
+
+bool MemoryBudget::isOverBudget() const
+{
+	const std::size_t budget = m_budget;
+	return budget != 0u && this->getTotalUsage() > budget;
+}
+
+void MemoryBudget::add(const MemorySubsystem subsystem, const std::ptrdiff_t cpu, const std::ptrdiff_t gpu)
+{
+	if(index(subsystem) >= COUNT)
+	{
+		throw std::out_of_range("MemoryBudget::add(): there is no such subsystem");
+	}
+	m_cpu[index(subsystem)] += cpu;
+	m_gpu[index(subsystem)] += gpu;
+}
+
+MemoryCharge::MemoryCharge(const MemorySubsystem subsystem)
+:
+m_subsystem(subsystem),
+m_cpu(0u),
+m_gpu(0u)
+{ }
+
+MemoryCharge::MemoryCharge(const MemoryCharge &copy)
+:
+m_subsystem(copy.m_subsystem),
+m_cpu(0u),
+m_gpu(0u)
+{
+	this->setCpu(copy.m_cpu);
+	this->setGpu(copy.m_gpu);
+}
+
+MemoryCharge::MemoryCharge(MemoryCharge &&source)
+:
+m_subsystem(source.m_subsystem),
+m_cpu(source.m_cpu),
+m_gpu(source.m_gpu)
+{
+	source.m_cpu = 0u;
+	source.m_gpu = 0u;
+}
+
+MemoryCharge &MemoryCharge::operator=(const MemoryCharge &copy)
+{
+	if(this != &copy)
+	{
+		this->setCpu(0u);
+		this->setGpu(0u);
+		m_subsystem = copy.m_subsystem;
+		this->setCpu(copy.m_cpu);
+		this->setGpu(copy.m_gpu);
+	}
+	return *this;
+}
+
+MemoryCharge &MemoryCharge::operator=(MemoryCharge &&source)
+{
+	if(this != &source)
+	{
+		this->setCpu(0u);
+		this->setGpu(0u);
+		m_subsystem = source.m_subsystem;
+		m_cpu = source.m_cpu;
+		m_gpu = source.m_gpu;
+		source.m_cpu = 0u;
+		source.m_gpu = 0u;
+	}
+	return *this;
+}
+
+MemoryCharge::~MemoryCharge()
+{
+	if(m_cpu != 0u || m_gpu != 0u)
+	{
+		MemoryBudget::shared().add(m_subsystem, -static_cast<std::ptrdiff_t>(m_cpu), -static_cast<std::ptrdiff_t>(m_gpu));
+	}
+}
+
+void MemoryCharge::setCpu(const std::size_t bytes)
+{
+	if(bytes != m_cpu)
+	{
+		MemoryBudget::shared().add(m_subsystem, static_cast<std::ptrdiff_t>(bytes) - static_cast<std::ptrdiff_t>(m_cpu), 0);
+		m_cpu = bytes;
+	}
+}
+
+void MemoryCharge::setGpu(const std::size_t bytes)
+{
+	if(bytes != m_gpu)
+	{
+		MemoryBudget::shared().add(m_subsystem, 0, static_cast<std::ptrdiff_t>(bytes) - static_cast<std::ptrdiff_t>(m_gpu));
+		m_gpu = bytes;
+	}
+}
+
+std::size_t MemoryCharge::getCpu() const
+{
+	return m_cpu;
+}
+
+std::size_t MemoryCharge::getGpu() const
+{
+	return m_gpu;
+}
+
+std::size_t MemoryCharge::bytesOf(const sf::Vector2u &size)
+{
+	return static_cast<std::size_t>(size.x) * size.y * 4u;
+}
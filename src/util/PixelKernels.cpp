@@ -0,0 +1,929 @@
+#include "../../include/util/PixelKernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define PK_X86 1
+	#include <emmintrin.h>
+	#include <immintrin.h>
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#endif
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+	#define PK_NEON 1
+	#include <arm_neon.h>
+#endif
+
+#if defined(PK_X86) && (defined(__GNUC__) || defined(__clang__))
+	#define PK_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+	#define PK_TARGET_AVX2
+#endif
+
+namespace pk
+{
+	namespace
+	{
+		//////////////////////////////////////////////////////////////////////////// scalar
+
+		void scaleChannelsScalar(const std::uint8_t *src, std::uint8_t *dst, std::size_t pixels, const ChannelFactors &f)
+		{
+			for(std::size_t i = 0; i < pixels * 4; i += 4)
+			{
+				dst[i] = static_cast<std::uint8_t>((src[i] * f.r + 128u) >> 8);
+				dst[i+1] = static_cast<std::uint8_t>((src[i+1] * f.g + 128u) >> 8);
+				dst[i+2] = static_cast<std::uint8_t>((src[i+2] * f.b + 128u) >> 8);
+				dst[i+3] = static_cast<std::uint8_t>((src[i+3] * f.a + 128u) >> 8);
+			}
+		}
+
+		void scaleChannels16Scalar(const std::uint16_t *src, std::uint16_t *dst, std::size_t pixels, const ChannelFactors &f)
+		{
+			for(std::size_t i = 0; i < pixels * 4; i += 4)
+			{
+				dst[i] = static_cast<std::uint16_t>((src[i] * static_cast<std::uint32_t>(f.r) + 128u) >> 8);
+				dst[i+1] = static_cast<std::uint16_t>((src[i+1] * static_cast<std::uint32_t>(f.g) + 128u) >> 8);
+				dst[i+2] = static_cast<std::uint16_t>((src[i+2] * static_cast<std::uint32_t>(f.b) + 128u) >> 8);
+				dst[i+3] = static_cast<std::uint16_t>((src[i+3] * static_cast<std::uint32_t>(f.a) + 128u) >> 8);
+			}
+		}
+
+		void scaleChannelsFloatScalar(const float *src, float *dst, std::size_t pixels, const ChannelFactors &f)
+		{
+			const float r = f.r / 256.f, g = f.g / 256.f, b = f.b / 256.f, a = f.a / 256.f;
+			for(std::size_t i = 0; i < pixels * 4; i += 4)
+			{
+				dst[i] = src[i] * r;
+				dst[i+1] = src[i+1] * g;
+				dst[i+2] = src[i+2] * b;
+				dst[i+3] = src[i+3] * a;
+			}
+		}
+
+		void maskAlphaScalar(const std::uint8_t *src, const std::uint8_t *mask, std::uint8_t *dst, std::size_t pixels, unsigned key)
+		{
+			const unsigned threshold = key * 3u; //avg >= key <=> sum >= 3*key for integer average
+			for(std::size_t i = 0; i < pixels * 4; i += 4)
+			{
+				const unsigned sum = mask[i] + mask[i+1] + mask[i+2];
+				dst[i] = src[i];
+				dst[i+1] = src[i+1];
+				dst[i+2] = src[i+2];
+				dst[i+3] = (sum >= threshold) ? 0u : src[i+3];
+			}
+		}
+
+		void maskLuminanceScalar(const std::uint8_t *src, const std::uint8_t *luminance, std::uint8_t *dst, std::size_t pixels, unsigned key)
+		{
+			for(std::size_t i = 0; i < pixels; i++)
+			{
+				dst[i*4] = src[i*4];
+				dst[i*4+1] = src[i*4+1];
+				dst[i*4+2] = src[i*4+2];
+				dst[i*4+3] = (luminance[i] >= key) ? 0u : src[i*4+3];
+			}
+		}
+
+		void brightnessRangeScalar(const std::uint8_t *src, std::size_t pixels, unsigned &lowest_sum, unsigned &highest_sum)
+		{
+			for(std::size_t i = 0; i < pixels * 4; i += 4)
+			{
+				const unsigned sum = src[i] + src[i+1] + src[i+2];
+				lowest_sum = std::min(lowest_sum, sum);
+				highest_sum = std::max(highest_sum, sum);
+			}
+		}
+
+		void diffImagesScalar(const std::uint8_t *first, const std::uint8_t *second, std::size_t pixels, unsigned tolerance, DiffStats &stats)
+		{
+			for(std::size_t i = 0; i < pixels * 4; i += 4)
+			{
+				unsigned biggest = 0u;
+				for(unsigned c = 0; c < 4u; c++)
+				{
+					const unsigned difference = first[i+c] > second[i+c] ? first[i+c] - second[i+c] : second[i+c] - first[i+c];
+					biggest = std::max(biggest, difference);
+				}
+				stats.maxDifference = std::max<std::uint8_t>(stats.maxDifference, static_cast<std::uint8_t>(biggest));
+				stats.differingPixels += biggest > tolerance ? 1u : 0u;
+			}
+		}
+
+#if defined(PK_X86)
+		//////////////////////////////////////////////////////////////////////////// SSE2
+
+		inline __m128i scale4SSE2(__m128i v, __m128i factors)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i half = _mm_set1_epi16(128);
+			__m128i lo = _mm_unpacklo_epi8(v, zero);
+			__m128i hi = _mm_unpackhi_epi8(v, zero);
+			lo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(lo, factors), half), 8);
+			hi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(hi, factors), half), 8);
+			return _mm_packus_epi16(lo, hi);
+		}
+
+		inline __m128i sum4SSE2(__m128i v)
+		{
+			const __m128i byte = _mm_set1_epi32(0xFF);
+			__m128i sum = _mm_and_si128(v, byte);
+			sum = _mm_add_epi32(sum, _mm_and_si128(_mm_srli_epi32(v, 8), byte));
+			return _mm_add_epi32(sum, _mm_and_si128(_mm_srli_epi32(v, 16), byte));
+		}
+
+		void scaleChannelsSSE2(const std::uint8_t *src, std::uint8_t *dst, std::size_t pixels, const ChannelFactors &f)
+		{
+			const __m128i factors = _mm_setr_epi16(f.r, f.g, f.b, f.a, f.r, f.g, f.b, f.a);
+			std::size_t i = 0;
+			for(; i + 16 <= pixels; i += 16)//16 pixels per iteration
+			{
+				const std::uint8_t *s = src + i * 4;
+				std::uint8_t *d = dst + i * 4;
+				for(unsigned k = 0; k < 4; k++)
+				{
+					__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + k * 16));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(d + k * 16), scale4SSE2(v, factors));
+				}
+			}
+			scaleChannelsScalar(src + i * 4, dst + i * 4, pixels - i, f);
+		}
+
+		void scaleChannels16SSE2(const std::uint16_t *src, std::uint16_t *dst, std::size_t pixels, const ChannelFactors &f)
+		{
+			const __m128i factors = _mm_setr_epi16(f.r, f.g, f.b, f.a, f.r, f.g, f.b, f.a);
+			const __m128i half = _mm_set1_epi32(128);
+			const __m128i bias32 = _mm_set1_epi32(32768);
+			const __m128i bias16 = _mm_set1_epi16(static_cast<short>(0x8000));
+			std::size_t i = 0;
+			for(; i + 2 <= pixels; i += 2)//2 pixels per iteration
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+				//the products need 24 bits, their halves are put back together to 32 bits
+				const __m128i low = _mm_mullo_epi16(v, factors);
+				const __m128i high = _mm_mulhi_epu16(v, factors);
+				__m128i first = _mm_srli_epi32(_mm_add_epi32(_mm_unpacklo_epi16(low, high), half), 8);
+				__m128i second = _mm_srli_epi32(_mm_add_epi32(_mm_unpackhi_epi16(low, high), half), 8);
+				//SSE2 packs only signed, so the values are shifted into its range and back
+				first = _mm_sub_epi32(first, bias32);
+				second = _mm_sub_epi32(second, bias32);
+				const __m128i packed = _mm_xor_si128(_mm_packs_epi32(first, second), bias16);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), packed);
+			}
+			scaleChannels16Scalar(src + i * 4, dst + i * 4, pixels - i, f);
+		}
+
+		void scaleChannelsFloatSSE2(const float *src, float *dst, std::size_t pixels, const ChannelFactors &f)
+		{
+			const __m128 factors = _mm_setr_ps(f.r / 256.f, f.g / 256.f, f.b / 256.f, f.a / 256.f);
+			for(std::size_t i = 0; i < pixels; i++)//a pixel fills a register
+			{
+				_mm_storeu_ps(dst + i * 4, _mm_mul_ps(_mm_loadu_ps(src + i * 4), factors));
+			}
+		}
+
+		void maskAlphaSSE2(const std::uint8_t *src, const std::uint8_t *mask, std::uint8_t *dst, std::size_t pixels, unsigned key)
+		{
+			const __m128i threshold = _mm_set1_epi32(static_cast<int>(key * 3u) - 1);
+			const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+			std::size_t i = 0;
+			for(; i + 16 <= pixels; i += 16)
+			{
+				for(unsigned k = 0; k < 4; k++)
+				{
+					const std::size_t offset = (i + k * 4) * 4;
+					__m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask + offset));
+					__m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + offset));
+					__m128i hidden = _mm_and_si128(_mm_cmpgt_epi32(sum4SSE2(m), threshold), alpha);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + offset), _mm_andnot_si128(hidden, s));
+				}
+			}
+			maskAlphaScalar(src + i * 4, mask + i * 4, dst + i * 4, pixels - i, key);
+		}
+
+		void maskLuminanceSSE2(const std::uint8_t *src, const std::uint8_t *luminance, std::uint8_t *dst, std::size_t pixels, unsigned key)
+		{
+			const __m128i threshold = _mm_set1_epi8(static_cast<char>(key));
+			const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+			std::size_t i = 0;
+			for(; i + 16 <= pixels; i += 16)
+			{
+				__m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(luminance + i));
+				__m128i hidden = _mm_cmpeq_epi8(_mm_max_epu8(l, threshold), l);//l >= key
+				__m128i lo = _mm_unpacklo_epi8(hidden, hidden);
+				__m128i hi = _mm_unpackhi_epi8(hidden, hidden);
+				const __m128i spread[4] = {
+					_mm_unpacklo_epi16(lo, lo), _mm_unpackhi_epi16(lo, lo),
+					_mm_unpacklo_epi16(hi, hi), _mm_unpackhi_epi16(hi, hi) };
+				for(unsigned k = 0; k < 4; k++)
+				{
+					const std::size_t offset = (i + k * 4) * 4;
+					__m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + offset));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + offset), _mm_andnot_si128(_mm_and_si128(spread[k], alpha), s));
+				}
+			}
+			maskLuminanceScalar(src + i * 4, luminance + i, dst + i * 4, pixels - i, key);
+		}
+
+		void brightnessRangeSSE2(const std::uint8_t *src, std::size_t pixels, unsigned &lowest_sum, unsigned &highest_sum)
+		{
+			__m128i low = _mm_set1_epi32(static_cast<int>(lowest_sum));
+			__m128i high = _mm_set1_epi32(static_cast<int>(highest_sum));
+			std::size_t i = 0;
+			for(; i + 4 <= pixels; i += 4)
+			{
+				__m128i sum = sum4SSE2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4)));
+				__m128i lower = _mm_cmplt_epi32(sum, low);
+				__m128i higher = _mm_cmpgt_epi32(sum, high);
+				low = _mm_or_si128(_mm_and_si128(lower, sum), _mm_andnot_si128(lower, low));
+				high = _mm_or_si128(_mm_and_si128(higher, sum), _mm_andnot_si128(higher, high));
+			}
+			alignas(16) std::int32_t lows[4], highs[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(lows), low);
+			_mm_store_si128(reinterpret_cast<__m128i*>(highs), high);
+			for(unsigned k = 0; k < 4; k++)
+			{
+				lowest_sum = std::min(lowest_sum, static_cast<unsigned>(lows[k]));
+				highest_sum = std::max(highest_sum, static_cast<unsigned>(highs[k]));
+			}
+			brightnessRangeScalar(src + i * 4, pixels - i, lowest_sum, highest_sum);
+		}
+
+		void diffImagesSSE2(const std::uint8_t *first, const std::uint8_t *second, std::size_t pixels, unsigned tolerance, DiffStats &stats)
+		{
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i allowed = _mm_set1_epi8(static_cast<char>(std::min(tolerance, 255u)));
+			__m128i biggest = zero;
+			std::size_t i = 0;
+			for(; i + 4 <= pixels; i += 4)
+			{
+				const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i * 4));
+				const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i * 4));
+				const __m128i difference = _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));
+				biggest = _mm_max_epu8(biggest, difference);
+				//a pixel is equal if none of its channels is over the tolerance
+				const __m128i equal = _mm_cmpeq_epi32(_mm_subs_epu8(difference, allowed), zero);
+				const int equal_mask = _mm_movemask_ps(_mm_castsi128_ps(equal));
+				stats.differingPixels += 4u - ((equal_mask & 1) + ((equal_mask >> 1) & 1) + ((equal_mask >> 2) & 1) + ((equal_mask >> 3) & 1));
+			}
+			alignas(16) std::uint8_t lanes[16];
+			_mm_store_si128(reinterpret_cast<__m128i*>(lanes), biggest);
+			stats.maxDifference = std::max(stats.maxDifference, *std::max_element(lanes, lanes + 16));
+			diffImagesScalar(first + i * 4, second + i * 4, pixels - i, tolerance, stats);
+		}
+
+		//////////////////////////////////////////////////////////////////////////// AVX2
+
+		PK_TARGET_AVX2 inline __m256i scale8AVX2(__m256i v, __m256i factors)
+		{
+			const __m256i zero = _mm256_setzero_si256();
+			const __m256i half = _mm256_set1_epi16(128);
+			__m256i lo = _mm256_unpacklo_epi8(v, zero);
+			__m256i hi = _mm256_unpackhi_epi8(v, zero);
+			lo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(lo, factors), half), 8);
+			hi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(hi, factors), half), 8);
+			return _mm256_packus_epi16(lo, hi);
+		}
+
+		PK_TARGET_AVX2 inline __m256i sum8AVX2(__m256i v)
+		{
+			const __m256i byte = _mm256_set1_epi32(0xFF);
+			__m256i sum = _mm256_and_si256(v, byte);
+			sum = _mm256_add_epi32(sum, _mm256_and_si256(_mm256_srli_epi32(v, 8), byte));
+			return _mm256_add_epi32(sum, _mm256_and_si256(_mm256_srli_epi32(v, 16), byte));
+		}
+
+		PK_TARGET_AVX2 void scaleChannelsAVX2(const std::uint8_t *src, std::uint8_t *dst, std::size_t pixels, const ChannelFactors &f)
+		{
+			const __m256i factors = _mm256_setr_epi16(
+				f.r, f.g, f.b, f.a, f.r, f.g, f.b, f.a,
+				f.r, f.g, f.b, f.a, f.r, f.g, f.b, f.a);
+			std::size_t i = 0;
+			for(; i + 32 <= pixels; i += 32)//32 pixels per iteration
+			{
+				const std::uint8_t *s = src + i * 4;
+				std::uint8_t *d = dst + i * 4;
+				for(unsigned k = 0; k < 4; k++)
+				{
+					__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + k * 32));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(d + k * 32), scale8AVX2(v, factors));
+				}
+			}
+			scaleChannelsSSE2(src + i * 4, dst + i * 4, pixels - i, f);
+		}
+
+		PK_TARGET_AVX2 void maskAlphaAVX2(const std::uint8_t *src, const std::uint8_t *mask, std::uint8_t *dst, std::size_t pixels, unsigned key)
+		{
+			const __m256i threshold = _mm256_set1_epi32(static_cast<int>(key * 3u) - 1);
+			const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+			std::size_t i = 0;
+			for(; i + 32 <= pixels; i += 32)
+			{
+				for(unsigned k = 0; k < 4; k++)
+				{
+					const std::size_t offset = (i + k * 8) * 4;
+					__m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mask + offset));
+					__m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + offset));
+					__m256i hidden = _mm256_and_si256(_mm256_cmpgt_epi32(sum8AVX2(m), threshold), alpha);
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + offset), _mm256_andnot_si256(hidden, s));
+				}
+			}
+			maskAlphaSSE2(src + i * 4, mask + i * 4, dst + i * 4, pixels - i, key);
+		}
+
+		PK_TARGET_AVX2 void maskLuminanceAVX2(const std::uint8_t *src, const std::uint8_t *luminance, std::uint8_t *dst, std::size_t pixels, unsigned key)
+		{
+			const __m128i threshold = _mm_set1_epi8(static_cast<char>(key));
+			const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+			std::size_t i = 0;
+			for(; i + 32 <= pixels; i += 32)
+			{
+				for(unsigned half = 0; half < 2; half++)
+				{
+					__m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(luminance + i + half * 16));
+					__m128i hidden = _mm_cmpeq_epi8(_mm_max_epu8(l, threshold), l);
+					const __m256i spread[2] = { _mm256_cvtepi8_epi32(hidden), _mm256_cvtepi8_epi32(_mm_srli_si128(hidden, 8)) };
+					for(unsigned k = 0; k < 2; k++)
+					{
+						const std::size_t offset = (i + half * 16 + k * 8) * 4;
+						__m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + offset));
+						_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + offset), _mm256_andnot_si256(_mm256_and_si256(spread[k], alpha), s));
+					}
+				}
+			}
+			maskLuminanceSSE2(src + i * 4, luminance + i, dst + i * 4, pixels - i, key);
+		}
+
+		PK_TARGET_AVX2 void brightnessRangeAVX2(const std::uint8_t *src, std::size_t pixels, unsigned &lowest_sum, unsigned &highest_sum)
+		{
+			__m256i low = _mm256_set1_epi32(static_cast<int>(lowest_sum));
+			__m256i high = _mm256_set1_epi32(static_cast<int>(highest_sum));
+			std::size_t i = 0;
+			for(; i + 8 <= pixels; i += 8)
+			{
+				__m256i sum = sum8AVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * 4)));
+				low = _mm256_min_epi32(low, sum);
+				high = _mm256_max_epi32(high, sum);
+			}
+			alignas(32) std::int32_t lows[8], highs[8];
+			_mm256_store_si256(reinterpret_cast<__m256i*>(lows), low);
+			_mm256_store_si256(reinterpret_cast<__m256i*>(highs), high);
+			for(unsigned k = 0; k < 8; k++)
+			{
+				lowest_sum = std::min(lowest_sum, static_cast<unsigned>(lows[k]));
+				highest_sum = std::max(highest_sum, static_cast<unsigned>(highs[k]));
+			}
+			brightnessRangeScalar(src + i * 4, pixels - i, lowest_sum, highest_sum);
+		}
+
+		PK_TARGET_AVX2 void diffImagesAVX2(const std::uint8_t *first, const std::uint8_t *second, std::size_t pixels, unsigned tolerance, DiffStats &stats)
+		{
+			const __m256i zero = _mm256_setzero_si256();
+			const __m256i allowed = _mm256_set1_epi8(static_cast<char>(std::min(tolerance, 255u)));
+			__m256i biggest = zero;
+			std::size_t i = 0;
+			for(; i + 8 <= pixels; i += 8)
+			{
+				const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(first + i * 4));
+				const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second + i * 4));
+				const __m256i difference = _mm256_or_si256(_mm256_subs_epu8(a, b), _mm256_subs_epu8(b, a));
+				biggest = _mm256_max_epu8(biggest, difference);
+				const __m256i equal = _mm256_cmpeq_epi32(_mm256_subs_epu8(difference, allowed), zero);
+				unsigned equal_mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(equal)));
+				unsigned equal_pixels = 0u;
+				for(; equal_mask != 0u; equal_mask &= equal_mask - 1u)
+				{
+					equal_pixels++;
+				}
+				stats.differingPixels += 8u - equal_pixels;
+			}
+			alignas(32) std::uint8_t lanes[32];
+			_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), biggest);
+			stats.maxDifference = std::max(stats.maxDifference, *std::max_element(lanes, lanes + 32));
+			diffImagesScalar(first + i * 4, second + i * 4, pixels - i, tolerance, stats);
+		}
+#endif//PK_X86
+
+#if defined(PK_NEON)
+		//////////////////////////////////////////////////////////////////////////// NEON
+
+		inline uint8x16_t scale16NEON(uint8x16_t v, std::uint16_t factor)
+		{
+			uint16x8_t lo = vmulq_n_u16(vmovl_u8(vget_low_u8(v)), factor);
+			uint16x8_t hi = vmulq_n_u16(vmovl_u8(vget_high_u8(v)), factor);
+			return vcombine_u8(vrshrn_n_u16(lo, 8), vrshrn_n_u16(hi, 8));
+		}
+
+		inline uint16x8_t sum8NEON(uint8x8_t r, uint8x8_t g, uint8x8_t b)
+		{
+			return vaddw_u8(vaddl_u8(r, g), b);
+		}
+
+		void scaleChannelsNEON(const std::uint8_t *src, std::uint8_t *dst, std::size_t pixels, const ChannelFactors &f)
+		{
+			std::size_t i = 0;
+			for(; i + 16 <= pixels; i += 16)//16 pixels per iteration, de-interleaved
+			{
+				uint8x16x4_t v = vld4q_u8(src + i * 4);
+				v.val[0] = scale16NEON(v.val[0], f.r);
+				v.val[1] = scale16NEON(v.val[1], f.g);
+				v.val[2] = scale16NEON(v.val[2], f.b);
+				v.val[3] = scale16NEON(v.val[3], f.a);
+				vst4q_u8(dst + i * 4, v);
+			}
+			scaleChannelsScalar(src + i * 4, dst + i * 4, pixels - i, f);
+		}
+
+		void scaleChannels16NEON(const std::uint16_t *src, std::uint16_t *dst, std::size_t pixels, const ChannelFactors &f)
+		{
+			const std::uint16_t lanes[4] = { f.r, f.g, f.b, f.a };
+			const uint16x4_t factors = vld1_u16(lanes);
+			std::size_t i = 0;
+			for(; i + 2 <= pixels; i += 2)//2 pixels per iteration, the rounding shift adds the 128
+			{
+				const uint16x8_t v = vld1q_u16(src + i * 4);
+				const uint16x4_t first = vrshrn_n_u32(vmull_u16(vget_low_u16(v), factors), 8);
+				const uint16x4_t second = vrshrn_n_u32(vmull_u16(vget_high_u16(v), factors), 8);
+				vst1q_u16(dst + i * 4, vcombine_u16(first, second));
+			}
+			scaleChannels16Scalar(src + i * 4, dst + i * 4, pixels - i, f);
+		}
+
+		void scaleChannelsFloatNEON(const float *src, float *dst, std::size_t pixels, const ChannelFactors &f)
+		{
+			const float lanes[4] = { f.r / 256.f, f.g / 256.f, f.b / 256.f, f.a / 256.f };
+			const float32x4_t factors = vld1q_f32(lanes);
+			for(std::size_t i = 0; i < pixels; i++)
+			{
+				vst1q_f32(dst + i * 4, vmulq_f32(vld1q_f32(src + i * 4), factors));
+			}
+		}
+
+		void maskAlphaNEON(const std::uint8_t *src, const std::uint8_t *mask, std::uint8_t *dst, std::size_t pixels, unsigned key)
+		{
+			const uint16x8_t threshold = vdupq_n_u16(static_cast<std::uint16_t>(key * 3u));
+			std::size_t i = 0;
+			for(; i + 16 <= pixels; i += 16)
+			{
+				uint8x16x4_t m = vld4q_u8(mask + i * 4);
+				uint8x16x4_t s = vld4q_u8(src + i * 4);
+				uint16x8_t lo = sum8NEON(vget_low_u8(m.val[0]), vget_low_u8(m.val[1]), vget_low_u8(m.val[2]));
+				uint16x8_t hi = sum8NEON(vget_high_u8(m.val[0]), vget_high_u8(m.val[1]), vget_high_u8(m.val[2]));
+				uint8x16_t hidden = vcombine_u8(vmovn_u16(vcgeq_u16(lo, threshold)), vmovn_u16(vcgeq_u16(hi, threshold)));
+				s.val[3] = vbicq_u8(s.val[3], hidden);
+				vst4q_u8(dst + i * 4, s);
+			}
+			maskAlphaScalar(src + i * 4, mask + i * 4, dst + i * 4, pixels - i, key);
+		}
+
+		void maskLuminanceNEON(const std::uint8_t *src, const std::uint8_t *luminance, std::uint8_t *dst, std::size_t pixels, unsigned key)
+		{
+			const uint8x16_t threshold = vdupq_n_u8(static_cast<std::uint8_t>(key));
+			std::size_t i = 0;
+			for(; i + 16 <= pixels; i += 16)
+			{
+				uint8x16x4_t s = vld4q_u8(src + i * 4);
+				s.val[3] = vbicq_u8(s.val[3], vcgeq_u8(vld1q_u8(luminance + i), threshold));
+				vst4q_u8(dst + i * 4, s);
+			}
+			maskLuminanceScalar(src + i * 4, luminance + i, dst + i * 4, pixels - i, key);
+		}
+
+		void brightnessRangeNEON(const std::uint8_t *src, std::size_t pixels, unsigned &lowest_sum, unsigned &highest_sum)
+		{
+			uint16x8_t low = vdupq_n_u16(static_cast<std::uint16_t>(lowest_sum));
+			uint16x8_t high = vdupq_n_u16(static_cast<std::uint16_t>(highest_sum));
+			std::size_t i = 0;
+			for(; i + 8 <= pixels; i += 8)
+			{
+				uint8x8x4_t v = vld4_u8(src + i * 4);
+				uint16x8_t sum = sum8NEON(v.val[0], v.val[1], v.val[2]);
+				low = vminq_u16(low, sum);
+				high = vmaxq_u16(high, sum);
+			}
+			std::uint16_t lows[8], highs[8];
+			vst1q_u16(lows, low);
+			vst1q_u16(highs, high);
+			for(unsigned k = 0; k < 8; k++)
+			{
+				lowest_sum = std::min<unsigned>(lowest_sum, lows[k]);
+				highest_sum = std::max<unsigned>(highest_sum, highs[k]);
+			}
+			brightnessRangeScalar(src + i * 4, pixels - i, lowest_sum, highest_sum);
+		}
+
+		void diffImagesNEON(const std::uint8_t *first, const std::uint8_t *second, std::size_t pixels, unsigned tolerance, DiffStats &stats)
+		{
+			const uint8x16_t allowed = vdupq_n_u8(static_cast<std::uint8_t>(std::min(tolerance, 255u)));
+			uint8x16_t biggest = vdupq_n_u8(0u);
+			uint32x4_t differing = vdupq_n_u32(0u);
+			std::size_t i = 0;
+			for(; i + 4 <= pixels; i += 4)
+			{
+				const uint8x16_t difference = vabdq_u8(vld1q_u8(first + i * 4), vld1q_u8(second + i * 4));
+				biggest = vmaxq_u8(biggest, difference);
+				const uint32x4_t over = vreinterpretq_u32_u8(vqsubq_u8(difference, allowed));
+				differing = vaddq_u32(differing, vshrq_n_u32(vtstq_u32(over, over), 31));
+			}
+			std::uint8_t lanes[16];
+			std::uint32_t counts[4];
+			vst1q_u8(lanes, biggest);
+			vst1q_u32(counts, differing);
+			stats.maxDifference = std::max(stats.maxDifference, *std::max_element(lanes, lanes + 16));
+			stats.differingPixels += counts[0] + counts[1] + counts[2] + counts[3];
+			diffImagesScalar(first + i * 4, second + i * 4, pixels - i, tolerance, stats);
+		}
+#endif//PK_NEON
+
+		//////////////////////////////////////////////////////////////////////////// dispatch
+
+		struct KernelTable
+		{
+			Isa isa;
+			void (*scaleChannels)(const std::uint8_t*, std::uint8_t*, std::size_t, const ChannelFactors&);
+			void (*scaleChannels16)(const std::uint16_t*, std::uint16_t*, std::size_t, const ChannelFactors&);
+			void (*scaleChannelsFloat)(const float*, float*, std::size_t, const ChannelFactors&);
+			void (*maskAlpha)(const std::uint8_t*, const std::uint8_t*, std::uint8_t*, std::size_t, unsigned);
+			void (*maskLuminance)(const std::uint8_t*, const std::uint8_t*, std::uint8_t*, std::size_t, unsigned);
+			void (*brightnessRange)(const std::uint8_t*, std::size_t, unsigned&, unsigned&);
+			void (*diffImages)(const std::uint8_t*, const std::uint8_t*, std::size_t, unsigned, DiffStats&);
+		};
+
+		KernelTable tableFor(Isa isa)
+		{
+			switch(isa)
+			{
+#if defined(PK_X86)
+				case Isa::SSE2: return { Isa::SSE2, scaleChannelsSSE2, scaleChannels16SSE2, scaleChannelsFloatSSE2, maskAlphaSSE2, maskLuminanceSSE2, brightnessRangeSSE2, diffImagesSSE2 };
+				case Isa::AVX2: return { Isa::AVX2, scaleChannelsAVX2, scaleChannels16SSE2, scaleChannelsFloatSSE2, maskAlphaAVX2, maskLuminanceAVX2, brightnessRangeAVX2, diffImagesAVX2 };
+#endif
+#if defined(PK_NEON)
+				case Isa::NEON: return { Isa::NEON, scaleChannelsNEON, scaleChannels16NEON, scaleChannelsFloatNEON, maskAlphaNEON, maskLuminanceNEON, brightnessRangeNEON, diffImagesNEON };
+#endif
+				default: return { Isa::SCALAR, scaleChannelsScalar, scaleChannels16Scalar, scaleChannelsFloatScalar, maskAlphaScalar, maskLuminanceScalar, brightnessRangeScalar, diffImagesScalar };
+			}
+		}
+
+		bool cpuHasAvx2()
+		{
+#if defined(PK_X86) && (defined(__GNUC__) || defined(__clang__))
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("avx2");
+#elif defined(PK_X86) && defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 0);
+			if(info[0] < 7)
+			{
+				return false;
+			}
+			__cpuid(info, 1);
+			const bool os_saves_ymm = (info[2] & (1 << 27)) && ((_xgetbv(0) & 0x6) == 0x6);
+			__cpuidex(info, 7, 0);
+			return os_saves_ymm && (info[1] & (1 << 5));
+#else
+			return false;
+#endif
+		}
+
+		//every instruction set has one table which never changes, switching only swaps the pointer to it
+		const KernelTable &tableOf(Isa isa)
+		{
+			static const KernelTable tables[] = { tableFor(Isa::SCALAR), tableFor(Isa::SSE2), tableFor(Isa::AVX2), tableFor(Isa::NEON) };
+			for(const KernelTable &table : tables)
+			{
+				if(table.isa == isa)
+				{
+					return table;
+				}
+			}
+			return tables[0];
+		}
+
+		std::atomic<const KernelTable *> &selectedTable()
+		{
+			static std::atomic<const KernelTable *> table([]()
+			{
+				if(isSupported(Isa::AVX2))
+				{
+					return &tableOf(Isa::AVX2);
+				}
+				if(isSupported(Isa::NEON))
+				{
+					return &tableOf(Isa::NEON);
+				}
+				if(isSupported(Isa::SSE2))
+				{
+					return &tableOf(Isa::SSE2);
+				}
+				return &tableOf(Isa::SCALAR);
+			}());
+			return table;
+		}
+
+		const KernelTable &activeTable()
+		{
+			return *selectedTable().load(std::memory_order_acquire);
+		}
+	}//anonymous namespace
+
+	Isa activeIsa()
+	{
+		return activeTable().isa;
+	}
+
+	bool setIsa(Isa isa)
+	{
+		if(!isSupported(isa))
+		{
+			return false;
+		}
+		selectedTable().store(&tableOf(isa), std::memory_order_release);
+		return true;
+	}
+
+	bool isSupported(Isa isa)
+	{
+		switch(isa)
+		{
+			case Isa::SCALAR: return true;
+#if defined(PK_X86)
+			case Isa::SSE2: return true; //baseline of every x86-64 CPU and of builds this file is compiled with
+			case Isa::AVX2:
+			{
+				static const bool has_avx2 = cpuHasAvx2();
+				return has_avx2;
+			}
+#endif
+#if defined(PK_NEON)
+			case Isa::NEON: return true;
+#endif
+			default: return false;
+		}
+	}
+
+	const char *isaName(Isa isa)
+	{
+		switch(isa)
+		{
+			case Isa::SSE2: return "SSE2";
+			case Isa::AVX2: return "AVX2";
+			case Isa::NEON: return "NEON";
+			default: return "scalar";
+		}
+	}
+
+	void scaleChannels(const std::uint8_t *src, std::uint8_t *dst, std::size_t pixels, const ChannelFactors &factors)
+	{
+		activeTable().scaleChannels(src, dst, pixels, factors);
+	}
+
+	template <typename Channel>
+	void scaleChannels(const SourceView<Channel> &src, const PixelView<Channel> &dst, const ChannelFactors &factors)
+	{
+		if(src.getSize() != dst.getSize())
+		{
+			throw std::invalid_argument("pk::scaleChannels(): the views have to be of the same size");
+		}
+		auto run = [&factors](const Channel *in, Channel *out, const std::size_t pixels)
+		{
+			if constexpr(std::is_same<Channel, std::uint8_t>::value)
+			{
+				activeTable().scaleChannels(in, out, pixels, factors);
+			}
+			else if constexpr(std::is_same<Channel, std::uint16_t>::value)
+			{
+				activeTable().scaleChannels16(in, out, pixels, factors);
+			}
+			else if constexpr(std::is_same<Channel, float>::value)
+			{
+				activeTable().scaleChannelsFloat(in, out, pixels, factors);
+			}
+			else
+			{
+				const float scale[4] = { factors.r / 256.f, factors.g / 256.f, factors.b / 256.f, factors.a / 256.f };
+				for(std::size_t i = 0; i < pixels * 4; i++)
+				{
+					out[i] = ChannelTraits<Channel>::fromFloat(ChannelTraits<Channel>::toFloat(in[i]) * scale[i & 3u]);
+				}
+			}
+		};
+		if(src.isPacked() && dst.isPacked())
+		{
+			run(src.getData(), dst.getData(), src.getPixelCount());
+			return;
+		}
+		for(unsigned y = 0; y < src.getSize().y; y++)
+		{
+			run(src.row(y), dst.row(y), src.getSize().x);
+		}
+	}
+
+	template void scaleChannels<std::uint8_t>(const SourceView<std::uint8_t> &, const PixelView<std::uint8_t> &, const ChannelFactors &);
+	template void scaleChannels<std::uint16_t>(const SourceView<std::uint16_t> &, const PixelView<std::uint16_t> &, const ChannelFactors &);
+	template void scaleChannels<Half>(const SourceView<Half> &, const PixelView<Half> &, const ChannelFactors &);
+	template void scaleChannels<float>(const SourceView<float> &, const PixelView<float> &, const ChannelFactors &);
+
+	void maskAlphaByBrightness(const std::uint8_t *src, const std::uint8_t *mask, std::uint8_t *dst, std::size_t pixels, unsigned key)
+	{
+		activeTable().maskAlpha(src, mask, dst, pixels, key);
+	}
+
+	void maskAlphaByLuminance(const std::uint8_t *src, const std::uint8_t *luminance, std::uint8_t *dst, std::size_t pixels, unsigned key)
+	{
+		if(key > 255u)
+		{
+			if(src != dst)
+			{
+				std::copy(src, src + pixels * 4, dst);
+			}
+			return;
+		}
+		activeTable().maskLuminance(src, luminance, dst, pixels, key);
+	}
+
+	ChannelLut scalingLut(const ChannelFactors &factors)
+	{
+		ChannelLut lut;
+		for(unsigned value = 0; value < 256u; value++)
+		{
+			lut.r[value] = static_cast<std::uint8_t>((value * factors.r + 128u) >> 8);
+			lut.g[value] = static_cast<std::uint8_t>((value * factors.g + 128u) >> 8);
+			lut.b[value] = static_cast<std::uint8_t>((value * factors.b + 128u) >> 8);
+			lut.a[value] = static_cast<std::uint8_t>((value * factors.a + 128u) >> 8);
+		}
+		return lut;
+	}
+
+	ChannelLut linearLightScalingLut(const ChannelFactors &factors)
+	{
+		ChannelLut lut = scalingLut(factors);
+		auto decode = [](const double value)
+		{
+			return value <= 0.04045 ? value / 12.92 : std::pow((value + 0.055) / 1.055, 2.4);
+		};
+		auto encode = [](const double value)
+		{
+			return value <= 0.0031308 ? value * 12.92 : 1.055 * std::pow(value, 1.0 / 2.4) - 0.055;
+		};
+		auto fill = [&decode, &encode](std::array<std::uint8_t, 256> &table, const std::uint16_t factor)
+		{
+			for(unsigned value = 0; value < 256u; value++)
+			{
+				const double scaled = encode(decode(value / 255.0) * factor / 256.0);
+				table[value] = static_cast<std::uint8_t>(std::clamp(scaled * 255.0 + 0.5, 0.0, 255.0));
+			}
+		};
+		fill(lut.r, factors.r);
+		fill(lut.g, factors.g);
+		fill(lut.b, factors.b);
+		return lut;
+	}
+
+	void applyLut(const std::uint8_t *src, std::uint8_t *dst, std::size_t pixels, const ChannelLut &lut)
+	{
+		for(std::size_t i = 0; i < pixels * 4; i += 4)
+		{
+			dst[i] = lut.r[src[i]];
+			dst[i+1] = lut.g[src[i+1]];
+			dst[i+2] = lut.b[src[i+2]];
+			dst[i+3] = lut.a[src[i+3]];
+		}
+	}
+
+	void scaleAlphaMask(const std::uint8_t *src, std::uint8_t *mask, std::size_t pixels, unsigned factor)
+	{
+		for(std::size_t i = 0; i < pixels; i++)
+		{
+			mask[i] = static_cast<std::uint8_t>((src[i*4+3] * factor + 128u) >> 8);
+		}
+	}
+
+	void luminanceAlphaMask(const std::uint8_t *src, const std::uint8_t *luminance, std::uint8_t *mask, std::size_t pixels, unsigned key)
+	{
+		for(std::size_t i = 0; i < pixels; i++)
+		{
+			mask[i] = (luminance[i] >= key) ? 0u : src[i*4+3];
+		}
+	}
+
+	void extractAlpha(const std::uint8_t *src, std::uint8_t *alpha, std::size_t pixels)
+	{
+		for(std::size_t i = 0; i < pixels; i++)
+		{
+			alpha[i] = src[i*4+3];
+		}
+	}
+
+	void scaleBytes(const std::uint8_t *src, std::uint8_t *dst, std::size_t count, unsigned factor)
+	{
+		for(std::size_t i = 0; i < count; i++)
+		{
+			dst[i] = static_cast<std::uint8_t>((src[i] * factor + 128u) >> 8);
+		}
+	}
+
+	void maskBytesByLuminance(const std::uint8_t *alpha, const std::uint8_t *luminance, std::uint8_t *mask, std::size_t pixels, unsigned key)
+	{
+		for(std::size_t i = 0; i < pixels; i++)
+		{
+			mask[i] = (luminance[i] >= key) ? 0u : alpha[i];
+		}
+	}
+
+	void clearByLuminance(const std::uint8_t *src, const std::uint8_t *luminance, std::uint8_t *dst, std::size_t pixels, unsigned key)
+	{
+		for(std::size_t i = 0; i < pixels; i++)
+		{
+			const bool hidden = luminance[i] >= key;
+			for(std::size_t channel = i * 4; channel < i * 4 + 4; channel++)
+			{
+				dst[channel] = hidden ? 0u : src[channel];
+			}
+		}
+	}
+
+	void premultiply(const std::uint8_t *src, std::uint8_t *dst, std::size_t pixels)
+	{
+		for(std::size_t i = 0; i < pixels * 4; i += 4)
+		{
+			const unsigned alpha = src[i+3];
+			dst[i] = static_cast<std::uint8_t>((src[i] * alpha + 127u) / 255u);
+			dst[i+1] = static_cast<std::uint8_t>((src[i+1] * alpha + 127u) / 255u);
+			dst[i+2] = static_cast<std::uint8_t>((src[i+2] * alpha + 127u) / 255u);
+			dst[i+3] = static_cast<std::uint8_t>(alpha);
+		}
+	}
+
+	void unpremultiply(const std::uint8_t *src, std::uint8_t *dst, std::size_t pixels)
+	{
+		for(std::size_t i = 0; i < pixels * 4; i += 4)
+		{
+			const unsigned alpha = src[i+3];
+			for(std::size_t channel = i; channel < i + 3; channel++)
+			{
+				dst[channel] = alpha ? static_cast<std::uint8_t>(std::min(255u, (src[channel] * 255u + alpha / 2u) / alpha)) : 0u;
+			}
+			dst[i+3] = static_cast<std::uint8_t>(alpha);
+		}
+	}
+
+	void computeLuminance(const std::uint8_t *src, std::uint8_t *luminance, std::size_t pixels)
+	{
+		for(std::size_t i = 0; i < pixels; i++)
+		{
+			luminance[i] = static_cast<std::uint8_t>((src[i*4] + src[i*4+1] + src[i*4+2]) / 3u);
+		}
+	}
+
+	DiffStats diffImages(const std::uint8_t *first, const std::uint8_t *second, std::size_t pixels, unsigned tolerance)
+	{
+		DiffStats stats;
+		activeTable().diffImages(first, second, pixels, tolerance, stats);
+		return stats;
+	}
+
+	void brightnessRange(const std::uint8_t *src, std::size_t pixels, std::uint8_t &darkest, std::uint8_t &brightest)
+	{
+		unsigned lowest_sum = 765u, highest_sum = 0u;
+		activeTable().brightnessRange(src, pixels, lowest_sum, highest_sum);
+		darkest = static_cast<std::uint8_t>(lowest_sum / 3u);
+		brightest = static_cast<std::uint8_t>(highest_sum / 3u);
+	}
+
+	void downscale(const std::uint8_t *src, const sf::Vector2u &src_size, std::uint8_t *dst, const sf::Vector2u &dst_size, unsigned first_row, unsigned rows)
+	{
+		//destination pixel x covers source columns [x * src / dst, (x + 1) * src / dst)
+		std::vector<unsigned> columns(dst_size.x + 1u);
+		for(unsigned x = 0; x <= dst_size.x; x++)
+		{
+			columns[x] = static_cast<unsigned>(static_cast<std::uint64_t>(x) * src_size.x / dst_size.x);
+		}
+
+		const unsigned last_row = std::min(first_row + rows, dst_size.y);
+		for(unsigned y = first_row; y < last_row; y++)
+		{
+			const unsigned top = static_cast<unsigned>(static_cast<std::uint64_t>(y) * src_size.y / dst_size.y);
+			const unsigned bottom = static_cast<unsigned>(static_cast<std::uint64_t>(y + 1u) * src_size.y / dst_size.y);
+			std::uint8_t *out = dst + static_cast<std::size_t>(y) * dst_size.x * 4u;
+			for(unsigned x = 0; x < dst_size.x; x++)
+			{
+				std::uint32_t sum[4] = { 0u, 0u, 0u, 0u };
+				for(unsigned sy = top; sy < bottom; sy++)
+				{
+					const std::uint8_t *in = src + (static_cast<std::size_t>(sy) * src_size.x + columns[x]) * 4u;
+					for(unsigned sx = columns[x]; sx < columns[x + 1u]; sx++, in += 4)
+					{
+						sum[0] += in[0];
+						sum[1] += in[1];
+						sum[2] += in[2];
+						sum[3] += in[3];
+					}
+				}
+				const std::uint32_t count = (bottom - top) * (columns[x + 1u] - columns[x]);
+				for(unsigned c = 0; c < 4; c++)
+				{
+					out[x * 4u + c] = static_cast<std::uint8_t>((sum[c] + count / 2u) / count);
+				}
+			}
+		}
+	}
+}//namespace pk
@@ -0,0 +1,89 @@
+#include "../../include/util/PlaybackClock.h"
+
+PlaybackClock::PlaybackClock(const float &step, const Mode mode)
+:
+m_mode(mode),
+m_step(step > 0.f ? step : 1.f / 60.f),
+m_maxSteps(PlaybackClock::DEFAULT_MAX_STEPS),
+m_steps(0u),
+m_remainder(0.f)
+{ }
+
+void PlaybackClock::setMode(const Mode mode)
+{
+	m_mode = mode;
+}
+
+PlaybackClock::Mode PlaybackClock::getMode() const
+{
+	return m_mode;
+}
+
+void PlaybackClock::setStep(const float &step)
+{
+	if(step > 0.f && step != m_step)
+	{
+		const float time = this->getTime();
+		m_step = step;
+		this->reset(time);
+	}
+}
+
+const float &PlaybackClock::getStep() const
+{
+	return m_step;
+}
+
+void PlaybackClock::setMaxSteps(const unsigned steps)
+{
+	m_maxSteps = std::max(steps, 1u);
+}
+
+void PlaybackClock::reset(const float &time)
+{
+	const double clamped = std::max(static_cast<double>(time), 0.0);
+	//a time lying on a step up to rounding error of the caller counts as that step
+	m_steps = static_cast<unsigned>(std::floor(clamped / m_step + 1e-4));
+	m_remainder = m_mode == Mode::FIXED_STEP
+		? 0.f
+		: static_cast<float>(std::max(clamped - static_cast<double>(m_steps) * m_step, 0.0));
+}
+
+float PlaybackClock::advance(const float &real_delta)
+{
+	if(!(real_delta > 0.f))
+	{
+		return this->getTime();
+	}
+
+	const double pending = static_cast<double>(m_remainder) + real_delta;
+	double steps = std::floor(pending / m_step);
+	double remainder = pending - steps * m_step;
+	if(m_mode != Mode::REAL_TIME && steps > m_maxSteps)
+	{
+		//the hitch is dropped, the animation continues from the last allowed step
+		steps = m_maxSteps;
+		remainder = 0.0;
+	}
+
+	//in FIXED_STEP mode the remainder is carried to the next advance, but it is never shown
+	m_steps += static_cast<unsigned>(steps);
+	m_remainder = static_cast<float>(std::min(remainder, static_cast<double>(m_step)));
+	return this->getTime();
+}
+
+float PlaybackClock::getTime() const
+{
+	const double time = static_cast<double>(m_steps) * m_step;
+	return static_cast<float>(m_mode == Mode::FIXED_STEP ? time : time + m_remainder);
+}
+
+unsigned PlaybackClock::getStepIndex() const
+{
+	return m_steps;
+}
+
+float PlaybackClock::getAlpha() const
+{
+	return m_mode == Mode::FIXED_STEP ? 0.f : m_remainder / m_step;
+}
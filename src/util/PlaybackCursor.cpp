@@ -0,0 +1,161 @@
+#include "../../include/util/PlaybackCursor.h"
+
+PlaybackCursor::PlaybackCursor(const float &length, const unsigned frames)
+:
+m_playing(false),
+m_scrubbing(false),
+m_length(std::max(length, 0.f)),
+m_time(0.f),
+m_grid(frames, m_length),
+m_frame(0u),
+m_clock()
+{
+	m_clock.setStep(m_grid.getDelta());
+}
+
+void PlaybackCursor::play()
+{
+	m_playing = true;
+}
+
+void PlaybackCursor::pause()
+{
+	m_playing = false;
+}
+
+void PlaybackCursor::setPlaying(const bool playing)
+{
+	m_playing = playing;
+}
+
+bool PlaybackCursor::isPlaying() const
+{
+	return m_playing;
+}
+
+void PlaybackCursor::setScrubbing(const bool scrubbing)
+{
+	m_scrubbing = scrubbing;
+}
+
+bool PlaybackCursor::isScrubbing() const
+{
+	return m_scrubbing;
+}
+
+void PlaybackCursor::setLength(const float &seconds)
+{
+	if(seconds > 0.f)
+	{
+		m_length = seconds;
+		m_grid = FrameGrid(m_grid.getFrames(), m_length);
+		this->gridChanged();
+	}
+}
+
+const float &PlaybackCursor::getLength() const
+{
+	return m_length;
+}
+
+void PlaybackCursor::setFrames(const unsigned frames)
+{
+	m_grid = FrameGrid(frames, m_length);
+	this->gridChanged();
+}
+
+void PlaybackCursor::setGrid(const FrameGrid &grid)
+{
+	m_grid = grid;
+	if(grid.getLength() > 0.f)
+	{
+		m_length = grid.getLength();
+	}
+	this->gridChanged();
+}
+
+const FrameGrid &PlaybackCursor::getGrid() const
+{
+	return m_grid;
+}
+
+void PlaybackCursor::setTime(const float &time)
+{
+	if(time >= 0.f)
+	{
+		m_time = std::min(time, std::max(m_length - FrameGrid::END_MARGIN, 0.f));
+		m_frame = m_grid.frameAt(m_time);
+		m_clock.reset(m_time);
+	}
+}
+
+const float &PlaybackCursor::getTime() const
+{
+	return m_time;
+}
+
+float PlaybackCursor::getProgress() const
+{
+	return m_length > 0.f ? std::clamp(m_time / m_length, 0.f, 1.f) : 0.f;
+}
+
+void PlaybackCursor::seekFrame(const unsigned frame)
+{
+	if(!m_grid.isValid())
+	{
+		return;
+	}
+	m_frame = std::min(frame, m_grid.getFrames() - 1u);
+	m_time = m_grid.timeOf(m_frame);
+	m_clock.reset(m_time);
+}
+
+void PlaybackCursor::nextFrame()
+{
+	this->seekFrame(m_frame + 1u);
+}
+
+void PlaybackCursor::previousFrame()
+{
+	const bool on_frame = m_time <= m_grid.timeOf(m_frame) + FrameGrid::END_MARGIN;
+	this->seekFrame(on_frame && m_frame > 0u ? m_frame - 1u : m_frame);
+}
+
+unsigned PlaybackCursor::getFrame() const
+{
+	return m_frame;
+}
+
+bool PlaybackCursor::isFinished() const
+{
+	return m_time >= m_length - 0.0002f;//-0.0002f is a correction because of IEEE754
+}
+
+void PlaybackCursor::advance(const float &real_delta)
+{
+	if(this->isFinished())
+	{
+		this->pause();
+	}
+	else if(m_playing)
+	{
+		m_time = m_clock.advance(real_delta);
+		if(m_time > m_length)
+		{
+			m_time = m_length - FrameGrid::END_MARGIN;
+		}
+		m_frame = m_grid.frameAt(m_time);
+	}
+}
+
+PlaybackClock &PlaybackCursor::getClock()
+{
+	return m_clock;
+}
+
+//private member functions
+void PlaybackCursor::gridChanged()
+{
+	m_clock.setStep(m_grid.getDelta());
+	m_frame = m_grid.frameAt(m_time);
+}
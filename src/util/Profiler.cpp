@@ -0,0 +1,165 @@
+#include "../../include/util/Profiler.h"
+
+#include <fstream>
+
+namespace
+{
+	const float AVERAGE_WEIGHT = 0.05f;//weight of the last frame in the moving averages
+
+	float toMs(const Profiler::Clock::duration &duration)
+	{
+		return std::chrono::duration<float, std::milli>(duration).count();
+	}
+
+	long long toUs(const Profiler::Clock::duration &duration)
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+	}
+
+	std::string escape(const char *name)
+	{
+		std::string escaped;
+		for(const char *c = name; *c; c++)
+		{
+			if(*c == '"' || *c == '\\')
+			{
+				escaped += '\\';
+			}
+			escaped += *c;
+		}
+		return escaped;
+	}
+}//anonymous namespace
+
+Profiler::Profiler(const std::size_t capacity)
+:
+m_enabled(false),
+m_mutex(),
+m_events(std::max<std::size_t>(capacity, 1u)),
+m_nextEvent(0u),
+m_eventsWrapped(false),
+m_sections(),
+m_frameSums(),
+m_frameTimes(),
+m_frameStart(Clock::now()),
+m_epoch(m_frameStart),
+m_threads()
+{ }
+
+Profiler &Profiler::shared()
+{
+	static Profiler profiler;
+	static const bool from_environment = [](){
+		if(std::getenv("BCG_PROFILE"))
+		{
+			profiler.setEnabled(true);
+		}
+		return true;
+	}();
+	(void)from_environment;
+	return profiler;
+}
+
+void Profiler::setEnabled(const bool enabled)
+{
+	m_enabled = enabled;
+}
+
+bool Profiler::isEnabled() const
+{
+	return m_enabled;
+}
+
+void Profiler::record(const char *name, const Clock::time_point &begin, const Clock::time_point &end)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_events[m_nextEvent] = Event{name, begin, end, this->threadIndex(std::this_thread::get_id())};
+	m_nextEvent++;
+	if(m_nextEvent == m_events.size())
+	{
+		m_nextEvent = 0u;
+		m_eventsWrapped = true;
+	}
+
+	//sections are few, a linear search by the address of the literal is enough
+	std::size_t index = 0u;
+	while(index < m_sections.size() && m_sections[index].name != name)
+	{
+		index++;
+	}
+	if(index == m_sections.size())
+	{
+		m_sections.push_back(Section{name});
+		m_frameSums.push_back(0.f);
+	}
+	m_frameSums[index] += toMs(end - begin);
+}
+
+void Profiler::endFrame()
+{
+	const Clock::time_point now = Clock::now();
+	std::lock_guard<std::mutex> lock(m_mutex);
+	for(std::size_t i = 0; i < m_sections.size(); i++)
+	{
+		m_sections[i].lastMs = m_frameSums[i];
+		m_sections[i].averageMs += (m_frameSums[i] - m_sections[i].averageMs) * AVERAGE_WEIGHT;
+		m_frameSums[i] = 0.f;
+	}
+	m_frameTimes.push_back(toMs(now - m_frameStart));
+	if(m_frameTimes.size() > FRAME_HISTORY)
+	{
+		m_frameTimes.pop_front();
+	}
+	m_frameStart = now;
+}
+
+std::vector<Profiler::Section> Profiler::getSections() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_sections;
+}
+
+std::vector<float> Profiler::getFrameTimes() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return std::vector<float>(m_frameTimes.begin(), m_frameTimes.end());
+}
+
+void Profiler::writeTrace(const std::string &path) const
+{
+	std::ofstream file(path);
+	if(!file)
+	{
+		throw std::runtime_error("Profiler::writeTrace(): cannot open " + path);
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	file << "{\"traceEvents\":[";
+	const std::size_t count = m_eventsWrapped ? m_events.size() : m_nextEvent;
+	const std::size_t first = m_eventsWrapped ? m_nextEvent : 0u;
+	for(std::size_t i = 0; i < count; i++)
+	{
+		const Event &event = m_events[(first + i) % m_events.size()];
+		file << (i == 0u ? "\n" : ",\n")
+			<< "{\"name\":\"" << escape(event.name) << "\",\"ph\":\"X\",\"pid\":1"
+			<< ",\"tid\":" << event.thread
+			<< ",\"ts\":" << toUs(event.begin - m_epoch)
+			<< ",\"dur\":" << toUs(event.end - event.begin) << "}";
+	}
+	file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+	if(!file)
+	{
+		throw std::runtime_error("Profiler::writeTrace(): cannot write " + path);
+	}
+}
+
+//private member functions
+unsigned Profiler::threadIndex(const std::thread::id &id)
+{
+	auto found = m_threads.find(id);
+	if(found == m_threads.end())
+	{
+		found = m_threads.emplace(id, static_cast<unsigned>(m_threads.size()) + 1u).first;
+	}
+	return found->second;
+}
@@ -0,0 +1,32 @@
+#include "../../include/util/Resources.h"
+
+const Resource *Resources::find(const std::string &name)
+{
+	for(std::size_t i = 0; i < ENTRY_COUNT; i++)
+	{
+		if(name == ENTRIES[i].name)
+		{
+			return &ENTRIES[i];
+		}
+	}
+	return nullptr;
+}
+
+const Resource *Resources::findPath(const std::string &path)
+{
+	if(!Resources::isResourcePath(path))
+	{
+		return nullptr;
+	}
+	return Resources::find(path.substr(std::char_traits<char>::length(PREFIX)));
+}
+
+bool Resources::isResourcePath(const std::string &path)
+{
+	return path.compare(0u, std::char_traits<char>::length(PREFIX), PREFIX) == 0;
+}
+
+std::string Resources::pathOf(const std::string &name)
+{
+	return PREFIX + name;
+}
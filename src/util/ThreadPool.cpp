@@ -0,0 +1,198 @@
+#include "../../include/util/ThreadPool.h"
+
+namespace
+{
+	thread_local bool t_isWorker = false;///> Set on threads of any pool
+
+	unsigned defaultThreadCount()
+	{
+		const unsigned cores = std::thread::hardware_concurrency();
+		return cores > 0u ? cores : 1u;
+	}
+}//anonymous namespace
+
+struct ThreadPool::Loop
+{
+	std::size_t count;///> Amount of elements
+	std::size_t grain;///> Amount of elements in a chunk
+	std::size_t chunks;///> Amount of chunks
+	const std::function<void(std::size_t, std::size_t)> *body;///> Body of the loop, owned by the caller
+	std::atomic<std::size_t> next;///> Index of the next chunk to take
+	std::atomic<std::size_t> done;///> Amount of finished chunks
+	std::mutex mutex;///> Guards the exception and signals the end
+	std::condition_variable finished;///> Signals the caller that all chunks are done
+	std::exception_ptr error;///> First exception thrown by the body
+};
+
+ThreadPool::ThreadPool(const unsigned threads)
+:
+m_workers(),
+m_loops(),
+m_stopping(false)
+{
+	this->start(threads);
+}
+
+ThreadPool::~ThreadPool()
+{
+	this->stop();
+}
+
+ThreadPool &ThreadPool::shared()
+{
+	static ThreadPool pool([]()
+	{
+		const char *env = std::getenv("BCG_THREADS");
+		return env ? static_cast<unsigned>(std::max(0l, std::strtol(env, nullptr, 10))) : 0u;
+	}());
+	return pool;
+}
+
+void ThreadPool::setThreadCount(const unsigned threads)
+{
+	this->stop();
+	this->start(threads);
+}
+
+unsigned ThreadPool::getThreadCount() const
+{
+	return static_cast<unsigned>(m_workers.size()) + 1u;
+}
+
+void ThreadPool::parallelFor(const std::size_t count, const std::size_t grain, const std::function<void(std::size_t, std::size_t)> &body)
+{
+	if(count == 0u)
+	{
+		return;
+	}
+	const std::size_t step = std::max<std::size_t>(grain, 1u);
+	const std::size_t chunks = (count + step - 1u) / step;
+	if(chunks == 1u || m_workers.empty() || t_isWorker)
+	{
+		for(std::size_t begin = 0; begin < count; begin += step)
+		{
+			body(begin, std::min(count, begin + step));
+		}
+		return;
+	}
+
+	auto loop = std::make_shared<Loop>();
+	loop->count = count;
+	loop->grain = step;
+	loop->chunks = chunks;
+	loop->body = &body;
+	loop->next = 0u;
+	loop->done = 0u;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_loops.push_back(loop);
+	}
+	if(chunks - 1u < m_workers.size())
+	{
+		for(std::size_t i = 0; i < chunks - 1u; i++)
+		{
+			m_wake.notify_one();
+		}
+	}
+	else
+	{
+		m_wake.notify_all();
+	}
+
+	ThreadPool::runChunks(*loop);
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto found = std::find(m_loops.begin(), m_loops.end(), loop);
+		if(found != m_loops.end())
+		{
+			m_loops.erase(found);
+		}
+	}
+	{
+		std::unique_lock<std::mutex> lock(loop->mutex);
+		loop->finished.wait(lock, [&loop]() { return loop->done.load() == loop->chunks; });
+	}
+	if(loop->error)
+	{
+		std::rethrow_exception(loop->error);
+	}
+}
+
+//private member functions
+void ThreadPool::start(const unsigned threads)
+{
+	const unsigned count = threads > 0u ? threads : defaultThreadCount();
+	m_stopping = false;
+	for(unsigned i = 1; i < count; i++)
+	{
+		m_workers.emplace_back(&ThreadPool::work, this);
+	}
+}
+
+void ThreadPool::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_wake.notify_all();
+	for(std::thread &worker : m_workers)
+	{
+		worker.join();
+	}
+	m_workers.clear();
+}
+
+void ThreadPool::work()
+{
+	t_isWorker = true;
+	while(true)
+	{
+		std::shared_ptr<Loop> loop;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_wake.wait(lock, [this]() { return m_stopping || !m_loops.empty(); });
+			if(m_stopping)
+			{
+				return;
+			}
+			loop = m_loops.front();
+			if(loop->next.load() >= loop->chunks)//nothing left to take, let the caller remove it
+			{
+				m_loops.pop_front();
+				continue;
+			}
+		}
+		ThreadPool::runChunks(*loop);
+	}
+}
+
+void ThreadPool::runChunks(Loop &loop)
+{
+	while(true)
+	{
+		const std::size_t chunk = loop.next++;
+		if(chunk >= loop.chunks)
+		{
+			return;
+		}
+		const std::size_t begin = chunk * loop.grain;
+		try
+		{
+			(*loop.body)(begin, std::min(loop.count, begin + loop.grain));
+		}
+		catch(...)
+		{
+			std::lock_guard<std::mutex> lock(loop.mutex);
+			if(!loop.error)
+			{
+				loop.error = std::current_exception();
+			}
+		}
+		if(++loop.done == loop.chunks)
+		{
+			std::lock_guard<std::mutex> lock(loop.mutex);
+			loop.finished.notify_all();
+		}
+	}
+}